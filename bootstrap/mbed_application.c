@@ -19,22 +19,29 @@
 #include "device.h"
 #include "mbed_application.h"
 #include "mbed_mpu_mgmt.h"
+#include "hal/flash_api.h"
+#include "hal/image_verify_api.h"
 
 #if MBED_APPLICATION_SUPPORT
 
 #if defined(__CORTEX_A9)
 
-static void powerdown_gic(void);
+static void powerdown_gic(uint32_t keep);
 
 void mbed_start_application(uintptr_t address)
+{
+    mbed_start_application_handover(address, 0);
+}
+
+void mbed_start_application_handover(uintptr_t address, uint32_t keep)
 {
     __disable_irq();
-    powerdown_gic();
+    powerdown_gic(keep);
     __enable_irq();
     ((void(*)())address)();
 }
 
-static void powerdown_gic()
+static void powerdown_gic(uint32_t keep)
 {
     int i;
     int j;
@@ -45,6 +52,9 @@ static void powerdown_gic()
         if (i < 4) {
             GICDistributor->CPENDSGIR[i] = 0xFFFFFFFF;
         }
+        if (keep & MBED_APPLICATION_KEEP_PRIORITIES) {
+            continue;
+        }
         for (j = 0; j < 8; j++) {
             GICDistributor->IPRIORITYR[i * 8 + j] = 0x00000000;
         }
@@ -53,11 +63,16 @@ static void powerdown_gic()
 
 #else
 
-static void powerdown_nvic(void);
-static void powerdown_scb(uint32_t vtor);
+static void powerdown_nvic(uint32_t keep);
+static void powerdown_scb(uint32_t vtor, uint32_t keep);
 static void start_new_application(void *sp, void *pc);
 
 void mbed_start_application(uintptr_t address)
+{
+    mbed_start_application_handover(address, 0);
+}
+
+void mbed_start_application_handover(uintptr_t address, uint32_t keep)
 {
     void *sp;
     void *pc;
@@ -65,17 +80,56 @@ void mbed_start_application(uintptr_t address)
     // Interrupts are re-enabled in start_new_application
     __disable_irq();
 
-    SysTick->CTRL = 0x00000000;
-    powerdown_nvic();
-    powerdown_scb(address);
-    mbed_mpu_manager_deinit();
+    if (!(keep & MBED_APPLICATION_KEEP_SYSTICK)) {
+        SysTick->CTRL = 0x00000000;
+    }
+    powerdown_nvic(keep);
+    powerdown_scb(address, keep);
+    if (!(keep & MBED_APPLICATION_KEEP_MPU)) {
+        mbed_mpu_manager_deinit();
+    }
 
     sp = *((void **)address + 0);
     pc = *((void **)address + 1);
     start_new_application(sp, pc);
 }
 
-static void powerdown_nvic()
+#if DEVICE_FLASH
+int mbed_start_swapped_application(void)
+{
+    flash_t flash;
+
+    if (flash_init(&flash) != 0) {
+        return -1;
+    }
+
+    // Nothing may run from the flash between the swap and the reset
+    __disable_irq();
+    if (flash_bank_swap(&flash) == 0) {
+        NVIC_SystemReset();
+    }
+    __enable_irq();
+
+    flash_free(&flash);
+    return -1;
+}
+#endif
+
+#if DEVICE_HASH
+int mbed_start_verified_application(uintptr_t address, uint32_t size, const uint8_t *digest)
+{
+    const image_verify_source_t mapped = { NULL, NULL };
+
+    if (image_verify(&mapped, (uint32_t)address, size, HAL_HASH_SHA256, digest) != 0) {
+        return -1;
+    }
+
+    mbed_start_application(address);
+    return -1;
+}
+#endif
+
+static void powerdown_nvic(uint32_t keep)
 {
     int i;
     int j;
@@ -93,6 +147,9 @@ static void powerdown_nvic()
     for (i = 0; i < isr_groups_32; i++) {
         NVIC->ICER[i] = 0xFFFFFFFF;
         NVIC->ICPR[i] = 0xFFFFFFFF;
+        if (keep & MBED_APPLICATION_KEEP_PRIORITIES) {
+            continue;
+        }
         for (j = 0; j < 8; j++) {
 #if defined(__CORTEX_M23) || defined(__CORTEX_M33)
             NVIC->IPR[i * 8 + j] = 0x00000000;
@@ -103,7 +160,7 @@ static void powerdown_nvic()
     }
 }
 
-static void powerdown_scb(uint32_t vtor)
+static void powerdown_scb(uint32_t vtor, uint32_t keep)
 {
     int i;
 
@@ -119,6 +176,9 @@ static void powerdown_scb(uint32_t vtor)
 #else
     num_pri_reg = 12;
 #endif
+    if (keep & MBED_APPLICATION_KEEP_PRIORITIES) {
+        num_pri_reg = 0;
+    }
     for (i = 0; i < num_pri_reg; i++) {
 #if defined(__CORTEX_M7) || defined(__CORTEX_M23) || defined(__CORTEX_M33)
         SCB->SHPR[i] = 0x00;
@@ -27,6 +27,15 @@
 #endif
 
 #if MBED_APPLICATION_SUPPORT
+
+/** Flags of ::mbed_start_application_handover */
+/** Leave the SysTick timer running */
+#define MBED_APPLICATION_KEEP_SYSTICK     (1UL << 0)
+/** Leave the MPU regions, for instance of an XIP mapping, enabled */
+#define MBED_APPLICATION_KEEP_MPU         (1UL << 1)
+/** Leave the interrupt priorities, which the application sets anyway, as they are */
+#define MBED_APPLICATION_KEEP_PRIORITIES  (1UL << 2)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,6 +53,47 @@ extern "C" {
  */
 void mbed_start_application(uintptr_t address);
 
+/**
+ *  Start the application at the given address, handing over some of the
+ *  system state. Same as mbed_start_application, which tears everything
+ *  down, but skips the teardown selected by keep. Interrupts are always
+ *  disabled and their pending state cleared. The clocks and the
+ *  peripherals, such as a QSPI flash mapped for XIP, are never touched.
+ *
+ *  @param address    Starting address of next application to run
+ *  @param keep       MBED_APPLICATION_KEEP_ flags
+ */
+void mbed_start_application_handover(uintptr_t address, uint32_t keep);
+
+#if DEVICE_FLASH && !defined(__CORTEX_A9)
+/**
+ *  Swap the flash banks and start the application of the bank which
+ *  does not contain the running code, with a system reset. This
+ *  function does not return unless the flash does not support it, see
+ *  flash_bank_swap. As for mbed_start_application, external components
+ *  must be flushed or powered down before calling it.
+ *
+ *  @return -1 if the banks cannot be swapped
+ */
+int mbed_start_swapped_application(void);
+#endif
+
+#if DEVICE_HASH && !defined(__CORTEX_A9)
+/**
+ *  Start the application at the given address, as mbed_start_application,
+ *  if its SHA-256 digest matches. The image is hashed where it is mapped,
+ *  see image_verify. This function does not return unless the image
+ *  does not match.
+ *
+ *  @param address    Starting address of the application, and of its image
+ *  @param size       Size of the image in bytes
+ *  @param digest     Expected SHA-256 digest of the image, 32 bytes
+ *
+ *  @return -1 if the image does not match
+ */
+int mbed_start_verified_application(uintptr_t address, uint32_t size, const uint8_t *digest);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,6 +20,17 @@
 #include <assert.h>
 #include "bootstrap/mbed_toolchain.h"
 
+/* Record the numeric error code and the address of the caller only.
+ *
+ * With MBED_CONF_PLATFORM_ERROR_COMPACT, MBED_ASSERT, MBED_ERROR and
+ * MBED_WARNING do not embed the expression, message or file name strings in
+ * the image. The address recorded in the error context is decoded on the host
+ * with tools/error_decode/error_decode.py and the ELF of the image.
+ */
+#ifndef MBED_CONF_PLATFORM_ERROR_COMPACT
+#define MBED_CONF_PLATFORM_ERROR_COMPACT 0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,6 +53,16 @@ extern "C" {
  */
 MBED_NORETURN void mbed_assert_internal(const char *expr, const char *file, int line);
 
+/** Internal mbed assert function invoked when MBED_ASSERT fails with
+ *  MBED_CONF_PLATFORM_ERROR_COMPACT.
+ *
+ *  The error recorded is MBED_ERROR_ASSERTION_FAILED, with the address the
+ *  function was called from and the line number as its value.
+ *  @param line Failing assertation line number, which also keeps the
+ *              compiler from merging the calls of different assertions.
+ */
+MBED_NORETURN void mbed_assert_compact(int line);
+
 #ifdef __cplusplus
 }
 #endif
@@ -62,6 +83,14 @@ MBED_NORETURN void mbed_assert_internal(const char *expr, const char *file, int
 #ifdef NDEBUG
 #define MBED_ASSERT(expr) ((void)0)
 
+#elif MBED_CONF_PLATFORM_ERROR_COMPACT
+#define MBED_ASSERT(expr)                                \
+do {                                                     \
+    if (!(expr)) {                                       \
+        mbed_assert_compact(__LINE__);                   \
+    }                                                    \
+} while (0)
+
 #else
 #define MBED_ASSERT(expr)                                \
 do {                                                     \
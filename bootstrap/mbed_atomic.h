@@ -631,6 +631,35 @@ MBED_FORCEINLINE int64_t core_util_atomic_incr_s64(volatile int64_t *valuePtr, i
 /** \copydoc core_util_atomic_incr_u8 */
 inline void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta);
 
+/** \copydoc core_util_atomic_incr_u8
+ * @param order memory ordering constraint
+ */
+MBED_FORCEINLINE uint8_t core_util_atomic_incr_explicit_u8(volatile uint8_t *valuePtr, uint8_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE uint16_t core_util_atomic_incr_explicit_u16(volatile uint16_t *valuePtr, uint16_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE uint32_t core_util_atomic_incr_explicit_u32(volatile uint32_t *valuePtr, uint32_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE uint64_t core_util_atomic_incr_explicit_u64(volatile uint64_t *valuePtr, uint64_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE int8_t core_util_atomic_incr_explicit_s8(volatile int8_t *valuePtr, int8_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE int16_t core_util_atomic_incr_explicit_s16(volatile int16_t *valuePtr, int16_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE int32_t core_util_atomic_incr_explicit_s32(volatile int32_t *valuePtr, int32_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE int64_t core_util_atomic_incr_explicit_s64(volatile int64_t *valuePtr, int64_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_incr_explicit_u8 */
+MBED_FORCEINLINE void *core_util_atomic_incr_explicit_ptr(void *volatile *valuePtr, ptrdiff_t delta, mbed_memory_order order);
+
 /**
  * Atomic decrement.
  * @param  valuePtr Target memory location being decremented.
@@ -663,6 +692,35 @@ MBED_FORCEINLINE int64_t core_util_atomic_decr_s64(volatile int64_t *valuePtr, i
 /** \copydoc core_util_atomic_decr_u8 */
 inline void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta);
 
+/** \copydoc core_util_atomic_decr_u8
+ * @param order memory ordering constraint
+ */
+MBED_FORCEINLINE uint8_t core_util_atomic_decr_explicit_u8(volatile uint8_t *valuePtr, uint8_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE uint16_t core_util_atomic_decr_explicit_u16(volatile uint16_t *valuePtr, uint16_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE uint32_t core_util_atomic_decr_explicit_u32(volatile uint32_t *valuePtr, uint32_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE uint64_t core_util_atomic_decr_explicit_u64(volatile uint64_t *valuePtr, uint64_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE int8_t core_util_atomic_decr_explicit_s8(volatile int8_t *valuePtr, int8_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE int16_t core_util_atomic_decr_explicit_s16(volatile int16_t *valuePtr, int16_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE int32_t core_util_atomic_decr_explicit_s32(volatile int32_t *valuePtr, int32_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE int64_t core_util_atomic_decr_explicit_s64(volatile int64_t *valuePtr, int64_t delta, mbed_memory_order order);
+
+/** \copydoc core_util_atomic_decr_explicit_u8 */
+MBED_FORCEINLINE void *core_util_atomic_decr_explicit_ptr(void *volatile *valuePtr, ptrdiff_t delta, mbed_memory_order order);
+
 /**
  * Atomic add.
  * @param  valuePtr Target memory location being modified.
@@ -878,6 +936,70 @@ uint64_t core_util_atomic_fetch_xor_u64(volatile uint64_t *valuePtr, uint64_t ar
 /** \copydoc core_util_atomic_fetch_xor_explicit_u8 */
 MBED_FORCEINLINE uint64_t core_util_atomic_fetch_xor_explicit_u64(volatile uint64_t *valuePtr, uint64_t arg, mbed_memory_order order);
 
+/**
+ * Atomic bitmap allocation: claim the lowest clear bit and set it.
+ *
+ * Each bit of the bitmap stands for a resource, such as a DMA channel or a
+ * buffer of a pool, which is in use when the bit is set.
+ *
+ * Claiming has acquire semantics, so the claimer sees the writes made by the
+ * previous owner before it released the bit.
+ *
+ * @param  bitmap Target bitmap.
+ * @return        The index of the bit claimed, or -1 if all bits are set.
+ */
+MBED_FORCEINLINE int core_util_atomic_bitmap_claim_u32(volatile uint32_t *bitmap);
+
+/**
+ * Atomic bitmap allocation: claim a given bit.
+ *
+ * @param  bitmap Target bitmap.
+ * @param  index  The index of the bit, from 0 to 31.
+ * @return        true if the bit was clear and has been claimed, false if it was already set.
+ */
+MBED_FORCEINLINE bool core_util_atomic_bitmap_claim_bit_u32(volatile uint32_t *bitmap, unsigned index);
+
+/**
+ * Atomic bitmap allocation: release a claimed bit.
+ *
+ * Releasing has release semantics, so the next claimer sees the writes made
+ * before the bit was released.
+ *
+ * @param  bitmap Target bitmap.
+ * @param  index  The index of the bit, as returned when claiming it.
+ */
+MBED_FORCEINLINE void core_util_atomic_bitmap_release_u32(volatile uint32_t *bitmap, unsigned index);
+
+/**
+ * Atomic reference count: take a reference to an object already referenced.
+ *
+ * @param  count  Reference count of the object.
+ * @return        The new reference count.
+ */
+MBED_FORCEINLINE uint32_t core_util_atomic_refcount_acquire_u32(volatile uint32_t *count);
+
+/**
+ * Atomic reference count: take a reference to an object unless it is being freed.
+ *
+ * This is for objects that can be found without holding a reference, such
+ * as entries in a table, and whose count may drop to zero at any time.
+ *
+ * @param  count  Reference count of the object.
+ * @return        true if a reference was taken, false if the count was zero.
+ */
+MBED_FORCEINLINE bool core_util_atomic_refcount_try_acquire_u32(volatile uint32_t *count);
+
+/**
+ * Atomic reference count: drop a reference.
+ *
+ * The writes made to the object while holding any reference are visible to
+ * the caller which drops the last reference, so it can free the object.
+ *
+ * @param  count  Reference count of the object.
+ * @return        true if this was the last reference, false otherwise.
+ */
+MBED_FORCEINLINE bool core_util_atomic_refcount_release_u32(volatile uint32_t *count);
+
 #ifdef __cplusplus
 } // extern "C"
 
@@ -879,6 +879,8 @@ DO_MBED_SIGNED_FETCH_OPS(fetch_add)
 DO_MBED_SIGNED_FETCH_OPS(fetch_sub)
 
 DO_MBED_SIGNED_EXPLICIT_FETCH_OPS(exchange)
+DO_MBED_SIGNED_EXPLICIT_FETCH_OPS(incr)
+DO_MBED_SIGNED_EXPLICIT_FETCH_OPS(decr)
 DO_MBED_SIGNED_EXPLICIT_FETCH_OPS(fetch_add)
 DO_MBED_SIGNED_EXPLICIT_FETCH_OPS(fetch_sub)
 
@@ -919,6 +921,15 @@ inline void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta
 #endif
 }
 
+MBED_FORCEINLINE void *core_util_atomic_incr_explicit_ptr(void *volatile *valuePtr, ptrdiff_t delta, mbed_memory_order order)
+{
+#if MBED_ATOMIC_PTR_SIZE == 32
+    return (void *)core_util_atomic_incr_explicit_u32((volatile uint32_t *)valuePtr, (uint32_t)delta, order);
+#else
+    return (void *)core_util_atomic_incr_explicit_u64((volatile uint64_t *)valuePtr, (uint64_t)delta, order);
+#endif
+}
+
 inline void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
@@ -928,6 +939,15 @@ inline void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta
 #endif
 }
 
+MBED_FORCEINLINE void *core_util_atomic_decr_explicit_ptr(void *volatile *valuePtr, ptrdiff_t delta, mbed_memory_order order)
+{
+#if MBED_ATOMIC_PTR_SIZE == 32
+    return (void *)core_util_atomic_decr_explicit_u32((volatile uint32_t *)valuePtr, (uint32_t)delta, order);
+#else
+    return (void *)core_util_atomic_decr_explicit_u64((volatile uint64_t *)valuePtr, (uint64_t)delta, order);
+#endif
+}
+
 MBED_FORCEINLINE void *core_util_atomic_fetch_add_ptr(void *volatile *valuePtr, ptrdiff_t arg)
 {
 #if MBED_ATOMIC_PTR_SIZE == 32
@@ -1009,6 +1029,8 @@ MBED_FORCEINLINE bool core_util_atomic_##name##_explicit_##fn_suffix(
 }
 
 DO_MBED_LOCKED_FETCH_OP_ORDERINGS(exchange)
+DO_MBED_LOCKED_FETCH_OP_ORDERINGS(incr)
+DO_MBED_LOCKED_FETCH_OP_ORDERINGS(decr)
 DO_MBED_LOCKED_FETCH_OP_ORDERINGS(fetch_add)
 DO_MBED_LOCKED_FETCH_OP_ORDERINGS(fetch_sub)
 DO_MBED_LOCKED_FETCH_OP_ORDERINGS(fetch_and)
@@ -1017,6 +1039,66 @@ DO_MBED_LOCKED_FETCH_OP_ORDERINGS(fetch_xor)
 DO_MBED_LOCKED_CAS_ORDERINGS(cas)
 DO_MBED_LOCKED_CAS_ORDERINGS(compare_exchange_weak)
 
+/********************* BITMAP AND REFERENCE COUNT OPS  *********************/
+
+MBED_FORCEINLINE int core_util_atomic_bitmap_claim_u32(volatile uint32_t *bitmap)
+{
+    uint32_t value = core_util_atomic_load_explicit_u32(bitmap, mbed_memory_order_relaxed);
+    uint32_t lowest_clear;
+    do {
+        if (value == UINT32_MAX) {
+            return -1;
+        }
+        /* Isolate the lowest clear bit, then CLZ gives its index on every core */
+        lowest_clear = ~value & (value + 1);
+    } while (!core_util_atomic_compare_exchange_weak_explicit_u32(bitmap, &value, value | lowest_clear,
+                                                                  mbed_memory_order_acquire, mbed_memory_order_relaxed));
+    return 31 - (int)__CLZ(lowest_clear);
+}
+
+MBED_FORCEINLINE bool core_util_atomic_bitmap_claim_bit_u32(volatile uint32_t *bitmap, unsigned index)
+{
+    MBED_ASSERT(index < 32);
+    const uint32_t bit = 1UL << index;
+    return (core_util_atomic_fetch_or_explicit_u32(bitmap, bit, mbed_memory_order_acquire) & bit) == 0;
+}
+
+MBED_FORCEINLINE void core_util_atomic_bitmap_release_u32(volatile uint32_t *bitmap, unsigned index)
+{
+    MBED_ASSERT(index < 32);
+    core_util_atomic_fetch_and_explicit_u32(bitmap, ~(1UL << index), mbed_memory_order_release);
+}
+
+MBED_FORCEINLINE uint32_t core_util_atomic_refcount_acquire_u32(volatile uint32_t *count)
+{
+    /* The caller already holds a reference, so nothing to order against */
+    return core_util_atomic_incr_explicit_u32(count, 1, mbed_memory_order_relaxed);
+}
+
+MBED_FORCEINLINE bool core_util_atomic_refcount_try_acquire_u32(volatile uint32_t *count)
+{
+    uint32_t value = core_util_atomic_load_explicit_u32(count, mbed_memory_order_relaxed);
+    do {
+        if (value == 0) {
+            return false;
+        }
+    } while (!core_util_atomic_compare_exchange_weak_explicit_u32(count, &value, value + 1,
+                                                                  mbed_memory_order_acquire, mbed_memory_order_relaxed));
+    return true;
+}
+
+MBED_FORCEINLINE bool core_util_atomic_refcount_release_u32(volatile uint32_t *count)
+{
+    const uint32_t value = core_util_atomic_decr_explicit_u32(count, 1, mbed_memory_order_release);
+    MBED_ASSERT(value != UINT32_MAX);
+    if (value != 0) {
+        return false;
+    }
+    /* Order the freeing of the object after the accesses made through other references */
+    MBED_BARRIER();
+    return true;
+}
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
@@ -57,12 +57,19 @@
 //#include "hal/us_ticker_api.h"
 //#include "mbed_toolchain.h"
 #include <stdlib.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include "mbed_boot.h"
+#include "mbed_boot_profile.h"
 #include "cmsis.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "mbed_pgo.h"
+#include "mbed_stack_stats.h"
+#include "mbed_warm_boot.h"
 #include "mbed_assert.h"
+#include "mbed_critical.h"
 
 /* This startup is for baremetal. There is no RTOS in baremetal,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT.
@@ -111,19 +118,33 @@ static void mbed_cpy_nvic(void)
     */
 #if !defined(__CORTEX_M0) && !defined(__CORTEX_A9)
 #ifdef NVIC_RAM_VECTOR_ADDRESS
-    uint32_t *old_vectors = (uint32_t *)SCB->VTOR;
-    uint32_t *vectors = (uint32_t *)NVIC_RAM_VECTOR_ADDRESS;
-    for (int i = 0; i < NVIC_NUM_VECTORS; i++) {
-        vectors[i] = old_vectors[i];
-    }
+    // Both tables are word aligned, the library memcpy moves them a block at a time
+    memcpy((void *)NVIC_RAM_VECTOR_ADDRESS, (const void *)SCB->VTOR, NVIC_NUM_VECTORS * sizeof(uint32_t));
     SCB->VTOR = (uint32_t)NVIC_RAM_VECTOR_ADDRESS;
 #endif /* NVIC_RAM_VECTOR_ADDRESS */
 #endif /* !defined(__CORTEX_M0) && !defined(__CORTEX_A9) */
 }
 
+#if MBED_CONF_PLATFORM_LAZY_RAM_VECTORS
+static bool nvic_in_ram = false;
+
+void mbed_nvic_set_vector(IRQn_Type IRQn, uint32_t vector)
+{
+    core_util_critical_section_enter();
+    if (!nvic_in_ram) {
+        mbed_cpy_nvic();
+        nvic_in_ram = true;
+    }
+    __NVIC_SetVector(IRQn, vector);
+    core_util_critical_section_exit();
+}
+#endif
+
 
 void mbed_init(void)
 {
+    MBED_STACK_PAINT();
+
     // Configs to make debugging easier
 #ifdef SCnSCB_ACTLR_DISDEFWBUF_Msk
     // Disable write buffer to make BusFaults (eg write to ROM via NULL pointer) precise.
@@ -132,11 +153,18 @@ void mbed_init(void)
     // precise MemManage exception.
     SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 #endif
+#if !MBED_CONF_PLATFORM_LAZY_RAM_VECTORS
     mbed_cpy_nvic(); // Copy NVIC to RAM
+#endif
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_NVIC_COPY);
+    // Before the target initialization, which can reuse the calibrations of the previous boot
+    mbed_warm_boot_init();
     mbed_sdk_init(); // Vendor specific init
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_SDK_INIT);
 #if DEVICE_MPU && MBED_CONF_PLATFORM_USE_MPU
     mbed_mpu_manager_init();
 #endif
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_MPU_INIT);
 }
 
 #if defined (__ARMCC_VERSION)
@@ -155,8 +183,10 @@ int $Super$$main(void);
   * run time library so this one is called instead of the original main()
   * unpatched main() function.
   */
-int $Sub$$main(void)
+MBED_USED int $Sub$$main(void)
 {
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_DATA_INIT);
+
     // Record the base addresses and sizes of the stack and heap as defined
     // in the scatter file.
     mbed_stack_isr_start = (unsigned char *) Image$$ARM_LIB_STACK$$ZI$$Base;
@@ -166,6 +196,7 @@ int $Sub$$main(void)
 
     mbed_init();
     mbed_main();
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_MAIN);
     return $Super$$main();
 }
 
@@ -189,8 +220,10 @@ extern int __real_main(void);
   * @details A strongly-linked definition of GCC's software_init_hook() function so
   * it is called at startup prior to main().
   */
-void software_init_hook(void)
+MBED_USED void software_init_hook(void)
 {
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_DATA_INIT);
+
     // Record the base addresses and sizes of the stack and heap as defined
     // in the linker file.
     mbed_stack_isr_start = (unsigned char *) &__StackLimit;
@@ -206,20 +239,25 @@ void software_init_hook(void)
  * @details Ensures main() called from the C run time library is linked to __wrap_main().
  * __real_main() refers to the user application's main().
  */
-int __wrap_main(void)
+MBED_USED int __wrap_main(void)
 {
     mbed_main();
     //mbed_error_initialize();
+    MBED_BOOT_PROFILE_STAMP(MBED_BOOT_STAGE_MAIN);
     return __real_main();
 }
 
 /**
  * @brief Retarget of exit for GCC.
  * @details Unlike the standard version, this function doesn't call any function
- * registered with atexit before calling _exit.
+ * registered with atexit before calling _exit. The PGO profile counters are
+ * sent first in instrumented images.
  */
-void __wrap_exit(int return_code)
+MBED_USED void __wrap_exit(int return_code)
 {
+#if MBED_PGO_GENERATE
+    mbed_pgo_dump();
+#endif
     _exit(return_code);
 }
 
@@ -228,7 +266,7 @@ void __wrap_exit(int return_code)
  * @details This function will always fail and never register any handler to be
  * called at exit.
  */
-int __wrap_atexit(void (*func)())
+MBED_USED int __wrap_atexit(void (*func)())
 {
     return 1;
 }
@@ -54,6 +54,11 @@ extern "C" {
  * @{
  */
 
+/* Copy the vector table to RAM on the first NVIC_SetVector() call instead of at boot */
+#ifndef MBED_CONF_PLATFORM_LAZY_RAM_VECTORS
+#define MBED_CONF_PLATFORM_LAZY_RAM_VECTORS 0
+#endif
+
 /* Heap limits - only used if set */
 extern unsigned char *mbed_heap_start;
 extern uint32_t mbed_heap_size;
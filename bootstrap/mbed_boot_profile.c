@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_boot_profile.h"
+
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER
+
+#if DEVICE_ITM
+#include "hal/itm_api.h"
+#endif
+
+static uint32_t boot_stamps[MBED_BOOT_STAGE_COUNT];
+
+void mbed_boot_profile_start(void)
+{
+    hal_cycle_counter_init();
+    DWT->CYCCNT = 0;
+}
+
+void mbed_boot_profile_stamp(mbed_boot_stage_t stage)
+{
+    if (stage == MBED_BOOT_STAGE_DATA_INIT && !(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        // The reset handler did not start the profile
+        mbed_boot_profile_start();
+    }
+    boot_stamps[stage] = hal_cycle_counter_read();
+}
+
+uint32_t mbed_boot_profile_cycles(mbed_boot_stage_t stage)
+{
+    return boot_stamps[stage];
+}
+
+#if DEVICE_ITM
+void mbed_boot_profile_send_itm(uint32_t port)
+{
+    mbed_itm_send_block(port, boot_stamps, sizeof(boot_stamps));
+}
+#endif
+
+#endif // MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER
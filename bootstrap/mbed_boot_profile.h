@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_BOOT_PROFILE_H
+#define MBED_BOOT_PROFILE_H
+
+#include <stdint.h>
+#include "hal/cycle_counter_api.h"
+
+/** Record cycle counter stamps at each boot stage */
+#ifndef MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED
+#define MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup boot_profile Boot profile
+ * Cycle counter stamps of the boot sequence
+ *
+ * Each stamp is the number of core clock cycles from ::mbed_boot_profile_start
+ * to the end of the stage. The stamps count cycles at whatever clock each
+ * stage ran at, so a target switching clocks in mbed_sdk_init() should account
+ * for it when converting them to time.
+ *
+ * Enabled by MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED on cores with the DWT
+ * cycle counter.
+ *
+ * @{
+ */
+
+/** Boot stages, in boot order */
+typedef enum {
+    MBED_BOOT_STAGE_RESET,     /**< ::mbed_boot_profile_start, 0 by definition */
+    MBED_BOOT_STAGE_DATA_INIT, /**< Startup code done, including .data and .bss initialization */
+    MBED_BOOT_STAGE_NVIC_COPY, /**< Vector table copied to RAM */
+    MBED_BOOT_STAGE_SDK_INIT,  /**< mbed_sdk_init() returned */
+    MBED_BOOT_STAGE_MPU_INIT,  /**< MPU manager initialized */
+    MBED_BOOT_STAGE_MAIN,      /**< mbed_main() returned, main() is next */
+    MBED_BOOT_STAGE_COUNT
+} mbed_boot_stage_t;
+
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER
+
+/**
+ * Start the boot profile
+ *
+ * Resets the cycle counter. Uses no RAM so the target's reset handler can call
+ * it before initializing .data and .bss, to include the startup code in the
+ * profile. Otherwise the profile starts when the startup code is done.
+ */
+void mbed_boot_profile_start(void);
+
+/**
+ * Record the end of a boot stage
+ *
+ * Called by the boot sequence.
+ *
+ * @param stage The stage that has just completed
+ */
+void mbed_boot_profile_stamp(mbed_boot_stage_t stage);
+
+/**
+ * Get the stamp of a boot stage
+ *
+ * @param stage The boot stage
+ * @return Cycles from ::mbed_boot_profile_start to the end of stage
+ */
+uint32_t mbed_boot_profile_cycles(mbed_boot_stage_t stage);
+
+#if DEVICE_ITM
+/**
+ * Send the boot profile over ITM
+ *
+ * Sends the MBED_BOOT_STAGE_COUNT stamps as 32-bit words in stage order.
+ * ITM must have been initialized with mbed_itm_init().
+ *
+ * @param port The ITM stimulus port to send the stamps on
+ */
+void mbed_boot_profile_send_itm(uint32_t port);
+#endif
+
+#define MBED_BOOT_PROFILE_STAMP(stage) mbed_boot_profile_stamp(stage)
+
+#else
+
+#define MBED_BOOT_PROFILE_STAMP(stage) ((void)0)
+
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_BOOT_PROFILE_H
@@ -20,10 +20,66 @@
 
 #include "cmsis.h"
 #include "mbed_assert.h"
+#include "mbed_atomic.h"
 #include "mbed_critical.h"
+#include "mbed_toolchain.h"
+#include "hal/cycle_counter_api.h"
+
+#include <string.h>
 
 static uint32_t critical_section_reentrancy_counter = 0;
 
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+
+#if !DEVICE_CYCLE_COUNTER
+#error "MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED requires the DWT cycle counter"
+#endif
+
+static mbed_critical_section_stats_t critical_section_stats;
+static bool critical_section_stats_enabled = false;
+// Set when the start of the ongoing outermost critical section was recorded
+static bool critical_section_stats_timing = false;
+static uint32_t critical_section_stats_start;
+static const void *critical_section_stats_caller;
+
+MBED_RAMFUNC static void critical_section_stats_record(uint32_t cycles)
+{
+    critical_section_stats.count++;
+    if (cycles > critical_section_stats.max_cycles) {
+        critical_section_stats.max_cycles = cycles;
+        critical_section_stats.max_caller = critical_section_stats_caller;
+    }
+
+    uint32_t bucket = (cycles < 2) ? 0 : 31 - __CLZ(cycles);
+    if (bucket >= MBED_CRITICAL_SECTION_STATS_BUCKETS) {
+        bucket = MBED_CRITICAL_SECTION_STATS_BUCKETS - 1;
+    }
+    critical_section_stats.histogram[bucket]++;
+}
+
+void mbed_critical_section_stats_reset(void)
+{
+    hal_cycle_counter_init();
+
+    core_util_critical_section_enter();
+    memset(&critical_section_stats, 0, sizeof(critical_section_stats));
+    critical_section_stats_enabled = true;
+    core_util_critical_section_exit();
+}
+
+void mbed_critical_section_stats_get(mbed_critical_section_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    *stats = critical_section_stats;
+    if (critical_section_reentrancy_counter == 1) {
+        // Don't record this section
+        critical_section_stats_timing = false;
+    }
+    core_util_critical_section_exit();
+}
+
+#endif // MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+
 bool core_util_are_interrupts_enabled(void)
 {
 #if defined(__CORTEX_A9)
@@ -54,7 +110,7 @@ bool core_util_in_critical_section(void)
     return hal_in_critical_section();
 }
 
-void core_util_critical_section_enter(void)
+MBED_RAMFUNC void core_util_critical_section_enter(void)
 {
     hal_critical_section_enter();
 
@@ -62,9 +118,17 @@ void core_util_critical_section_enter(void)
     MBED_ASSERT(critical_section_reentrancy_counter < UINT32_MAX);
 
     ++critical_section_reentrancy_counter;
+
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+    if (critical_section_reentrancy_counter == 1 && critical_section_stats_enabled) {
+        critical_section_stats_timing = true;
+        critical_section_stats_caller = MBED_CALLER_ADDR();
+        critical_section_stats_start = hal_cycle_counter_read();
+    }
+#endif
 }
 
-void core_util_critical_section_exit(void)
+MBED_RAMFUNC void core_util_critical_section_exit(void)
 {
 
     // If critical_section_enter has not previously been called, do nothing
@@ -75,6 +139,60 @@ void core_util_critical_section_exit(void)
     --critical_section_reentrancy_counter;
 
     if (critical_section_reentrancy_counter == 0) {
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+        if (critical_section_stats_timing) {
+            critical_section_stats_timing = false;
+            critical_section_stats_record(hal_cycle_counter_read() - critical_section_stats_start);
+        }
+#endif
         hal_critical_section_exit();
     }
 }
+
+#if MBED_EXCLUSIVE_ACCESS
+/* Claim the lock, the compare and exchange has the barriers which make the
+ * writes of the previous owner visible. */
+static bool spin_claim(core_util_spinlock_t *lock)
+{
+    uint32_t expected = 0;
+    return core_util_atomic_cas_u32(&lock->locked, &expected, 1);
+}
+#endif
+
+void core_util_spin_lock(core_util_spinlock_t *lock)
+{
+    core_util_critical_section_enter();
+#if MBED_EXCLUSIVE_ACCESS
+    while (!spin_claim(lock)) {
+        // Spin on plain loads, not on exclusive stores which take the bus
+        while (core_util_atomic_load_explicit_u32(&lock->locked, mbed_memory_order_relaxed)) {
+        }
+    }
+#else
+    (void)lock;
+#endif
+}
+
+bool core_util_spin_trylock(core_util_spinlock_t *lock)
+{
+    core_util_critical_section_enter();
+#if MBED_EXCLUSIVE_ACCESS
+    if (!spin_claim(lock)) {
+        core_util_critical_section_exit();
+        return false;
+    }
+#else
+    (void)lock;
+#endif
+    return true;
+}
+
+void core_util_spin_unlock(core_util_spinlock_t *lock)
+{
+#if MBED_EXCLUSIVE_ACCESS
+    core_util_atomic_store_u32(&lock->locked, 0);
+#else
+    (void)lock;
+#endif
+    core_util_critical_section_exit();
+}
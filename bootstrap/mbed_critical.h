@@ -18,6 +18,12 @@
 #define __MBED_UTIL_CRITICAL_H__
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/** Record how long critical sections keep interrupts masked, see ::mbed_critical_section_stats_get */
+#ifndef MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+#define MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED 0
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -85,6 +91,88 @@ void core_util_critical_section_exit(void);
  */
 bool core_util_in_critical_section(void);
 
+/** Lock shared by the cores of a multi-core target
+ *
+ * The critical sections above mask the interrupts of the calling core only,
+ * the other cores keep running. Data shared between cores is protected by a
+ * spinlock taken along with the critical section. The lock must be in memory
+ * shared by the cores and covered by the global exclusive monitor, which
+ * the target documents. On targets whose shared memory has no global
+ * exclusive monitor, use the hardware semaphores of ::hal_ipc_hsem_try_lock
+ * instead.
+ *
+ * On cores without exclusive access instructions (Cortex-M0 and M0+), the
+ * spinlock is the critical section alone, which is only correct on a single
+ * core.
+ */
+typedef struct {
+    volatile uint32_t locked; /**< 1 while a core holds the lock */
+} core_util_spinlock_t;
+
+/** Initializer of a ::core_util_spinlock_t */
+#define CORE_UTIL_SPINLOCK_INIT { 0 }
+
+/** Enter a critical section and take a spinlock
+ *
+ * Waits for the other cores to release the lock. The calling core must not
+ * hold the lock already.
+ *
+ * @param lock The lock
+ */
+void core_util_spin_lock(core_util_spinlock_t *lock);
+
+/** Enter a critical section and take a spinlock if it is free
+ *
+ * @param lock The lock
+ * @return true if the lock was taken, false if another core holds it, with
+ *         the critical section exited
+ */
+bool core_util_spin_trylock(core_util_spinlock_t *lock);
+
+/** Release a spinlock and exit the critical section
+ *
+ * The writes made while holding the lock are visible to the core which
+ * takes it next.
+ *
+ * @param lock The lock taken with ::core_util_spin_lock or ::core_util_spin_trylock
+ */
+void core_util_spin_unlock(core_util_spinlock_t *lock);
+
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED || defined(DOXYGEN_ONLY)
+
+/** Number of buckets of the critical section duration histogram */
+#define MBED_CRITICAL_SECTION_STATS_BUCKETS 16
+
+/** Durations of the outermost critical sections, in core clock cycles */
+typedef struct {
+    uint32_t count;         /**< Number of critical sections recorded */
+    uint32_t max_cycles;    /**< Longest critical section */
+    const void *max_caller; /**< Return address of the core_util_critical_section_enter() call which started the longest one */
+    /** Bucket 0 counts the sections shorter than 2 cycles, bucket i the
+     *  sections of 2^i to 2^(i+1) - 1 cycles, and the last bucket all the
+     *  longer ones */
+    uint32_t histogram[MBED_CRITICAL_SECTION_STATS_BUCKETS];
+} mbed_critical_section_stats_t;
+
+/**
+ * Reset the critical section statistics and start recording
+ *
+ * Enables the DWT cycle counter. Critical sections are only recorded once
+ * this has been called.
+ */
+void mbed_critical_section_stats_reset(void);
+
+/**
+ * Get the critical section statistics
+ *
+ * Sections shorter than a few cycles include the recording overhead.
+ *
+ * @param stats Filled with the statistics recorded since the last reset
+ */
+void mbed_critical_section_stats_get(mbed_critical_section_stats_t *stats);
+
+#endif // MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+
 /**@}*/
 
 /**@}*/
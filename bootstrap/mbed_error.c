@@ -16,12 +16,19 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
-// #include "device.h"
+#include "device.h"
+#include "cmsis.h"
 // #include "platform/source/mbed_crash_data_offsets.h"
-// #include "platform/mbed_atomic.h"
-// #include "platform/mbed_critical.h"
+#include "mbed_atomic.h"
+#include "mbed_critical.h"
 #include "mbed_error.h"
+#include "mbed_trace.h"
+#include "hal/utils/critical_section_api.h"
+#if DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#endif
 // #include "platform/mbed_interface.h"
 // #include "platform/mbed_power_mgmt.h"
 // #include "platform/mbed_stats.h"
@@ -45,6 +52,18 @@
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #endif
 
+#ifndef MBED_CONF_PLATFORM_ERROR_HIST_SIZE
+#define MBED_CONF_PLATFORM_ERROR_HIST_SIZE 4
+#endif
+
+#ifndef MBED_CONF_PLATFORM_ERROR_REBOOT_MAX
+#define MBED_CONF_PLATFORM_ERROR_REBOOT_MAX 1
+#endif
+
+#if MBED_CONF_PLATFORM_ERROR_HIST_SIZE & (MBED_CONF_PLATFORM_ERROR_HIST_SIZE - 1)
+#error "MBED_CONF_PLATFORM_ERROR_HIST_SIZE must be a power of two"
+#endif
+
 #ifndef NDEBUG
 #define ERROR_REPORT(ctx, error_msg, error_filename, error_line) print_error_report(ctx, error_msg, error_filename, error_line)
 //static void print_error_report(const mbed_error_ctx *ctx, const char *, const char *error_filename, int error_line);
@@ -54,23 +73,126 @@
 
 //bool mbed_error_in_progress;
 //static core_util_atomic_flag halt_in_progress = CORE_UTIL_ATOMIC_FLAG_INIT;
-//static int error_count = 0;
-//static mbed_error_ctx first_error_ctx = {0};
-//static mbed_error_ctx last_error_ctx = {0};
+static volatile uint32_t error_count;
+static volatile uint32_t first_error_status = MBED_SUCCESS;
+static volatile uint32_t last_error_status = MBED_SUCCESS;
+static mbed_error_ctx first_error_ctx;
+static mbed_error_ctx last_error_ctx;
 //static mbed_error_hook_t error_hook = NULL;
 
 static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller);
 
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+/* Entries are claimed by incrementing error_hist_claimed, so warnings are
+ * recorded from any context without a critical section. An entry is valid
+ * while its sequence is its claim number plus one; it is 0 while it is being
+ * written. */
+typedef struct {
+    volatile uint32_t sequence;
+    volatile uint32_t repeat_count;
+    mbed_error_ctx ctx;
+} error_hist_entry_t;
+
+static error_hist_entry_t error_hist[MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
+static volatile uint32_t error_hist_claimed;
+#endif
+
 #if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
-//#define report_error_ctx MBED_CRASH_DATA.error.context
-//static bool is_reboot_error_valid = false;
+#define CRASH_RECORD_MAGIC 0x43525348UL
+
+// Top of the stack in the CMSIS GCC linker scripts, bounds the stack snippet
+extern uint32_t __StackTop[] __attribute__((weak));
+
+MBED_NOINIT static mbed_crash_record_t crash_record;
+static bool is_reboot_error_valid = false;
+
+static uint32_t crash_record_crc32(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    while (size--) {
+        crc ^= *bytes++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void crash_record_seal(void)
+{
+    crash_record.error.crc_error_ctx = crash_record_crc32(&crash_record.error, offsetof(mbed_error_ctx, crc_error_ctx));
+    crash_record.crc = crash_record_crc32(&crash_record, offsetof(mbed_crash_record_t, crc));
+}
+
+static bool crash_record_is_valid(void)
+{
+    return crash_record.magic == CRASH_RECORD_MAGIC &&
+           crash_record.length == sizeof(crash_record) &&
+           crash_record.crc == crash_record_crc32(&crash_record, offsetof(mbed_crash_record_t, crc));
+}
+
+//Write the crash record, without printing anything so the reboot isn't delayed
+static void crash_record_save(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    const int32_t reboot_count = crash_record_is_valid() ? crash_record.error.error_reboot_count : 0;
+
+    memset(&crash_record, 0, sizeof(crash_record));
+    crash_record.magic = CRASH_RECORD_MAGIC;
+    crash_record.length = sizeof(crash_record);
+    crash_record.error.error_status = error_status;
+    crash_record.error.error_address = (uint32_t)caller;
+    crash_record.error.error_value = error_value;
+    if (filename != NULL) {
+        strncpy(crash_record.error.error_filename, filename, MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN - 1);
+    }
+    crash_record.error.error_line_number = line_number;
+    crash_record.error.error_reboot_count = reboot_count + 1;
+
+#if DEVICE_USTICKER
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    // Fault handlers, and interrupts above the critical section priority, can't read the ticker
+    if (ticker->queue->initialized && hal_critical_section_masks_caller()) {
+        crash_record.timestamp_us = ticker_read_us(ticker);
+    }
+#endif
+
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3U)
+    crash_record.cfsr = SCB->CFSR;
+    crash_record.hfsr = SCB->HFSR;
+    crash_record.mmfar = SCB->MMFAR;
+    crash_record.bfar = SCB->BFAR;
+#endif
+
+    const uint32_t *sp = (const uint32_t *)__get_MSP();
+    crash_record.stack_pointer = (uint32_t)sp;
+    for (int i = 0; i < MBED_CONF_PLATFORM_CRASH_CAPTURE_STACK_WORDS; i++) {
+        if (__StackTop && &sp[i] >= __StackTop) {
+            break;
+        }
+        crash_record.stack[i] = sp[i];
+    }
+
+    const char *last_trace = mbed_trace_last();
+    if (last_trace != NULL) {
+        strncpy(crash_record.last_trace, last_trace, MBED_CONF_PLATFORM_CRASH_CAPTURE_TRACE_LEN - 1);
+    }
+
+    crash_record_seal();
+}
 #endif
 
 //Helper function to halt the system
 static MBED_NORETURN void mbed_halt_system(void)
 {
-    // Prevent recursion if halt is called again during halt attempt - try
-    // something simple instead.
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED && MBED_CONF_PLATFORM_FATAL_ERROR_AUTO_REBOOT_ENABLED
+    // The crash record has been written, reboot right away unless the error
+    // keeps happening after each reboot
+    if (crash_record.error.error_reboot_count <= MBED_CONF_PLATFORM_ERROR_REBOOT_MAX) {
+        NVIC_SystemReset();
+    }
+#endif
 
     // In normal context, try orderly exit(1), which eventually calls mbed_die
     exit(1);
@@ -93,6 +215,74 @@ WEAK MBED_NORETURN void error(const char *format, ...)
     return 0;
 } */
 
+static void error_ctx_fill(mbed_error_ctx *ctx, mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->error_status = error_status;
+    ctx->error_address = (uint32_t)caller;
+    ctx->error_value = error_value;
+    if (filename != NULL) {
+        strncpy(ctx->error_filename, filename, MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN - 1);
+    }
+    ctx->error_line_number = line_number;
+}
+
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+static bool error_hist_is_repeat(const error_hist_entry_t *entry, uint32_t sequence, mbed_error_status_t error_status, unsigned int error_value, int line_number, void *caller)
+{
+    return core_util_atomic_load_u32(&entry->sequence) == sequence &&
+           entry->ctx.error_status == error_status &&
+           entry->ctx.error_value == error_value &&
+           entry->ctx.error_address == (uint32_t)caller &&
+           entry->ctx.error_line_number == (uint32_t)line_number;
+}
+
+//Add an entry to the error history, or count a repeat of the latest entry
+static void error_hist_record(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    const uint32_t claimed = core_util_atomic_load_u32(&error_hist_claimed);
+    if (claimed != 0) {
+        error_hist_entry_t *latest = &error_hist[(claimed - 1) % MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
+        if (error_hist_is_repeat(latest, claimed, error_status, error_value, line_number, caller)) {
+            core_util_atomic_incr_u32(&latest->repeat_count, 1);
+            return;
+        }
+    }
+
+    const uint32_t index = core_util_atomic_fetch_add_u32(&error_hist_claimed, 1);
+    error_hist_entry_t *entry = &error_hist[index % MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
+    core_util_atomic_store_u32(&entry->sequence, 0);
+    error_ctx_fill(&entry->ctx, error_status, error_value, filename, line_number, caller);
+    entry->repeat_count = 1;
+    core_util_atomic_store_u32(&entry->sequence, index + 1);
+}
+#endif
+
+//Record a non-fatal error, from any context
+static void record_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    uint32_t no_error = MBED_SUCCESS;
+
+    core_util_atomic_incr_u32(&error_count, 1);
+    const bool first = core_util_atomic_cas_u32(&first_error_status, &no_error, (uint32_t)error_status);
+    core_util_atomic_store_u32(&last_error_status, (uint32_t)error_status);
+
+    // Fault handlers, and interrupts above the critical section priority, only set the statuses
+    if (hal_critical_section_masks_caller()) {
+        mbed_error_ctx ctx;
+        error_ctx_fill(&ctx, error_status, error_value, filename, line_number, caller);
+        core_util_critical_section_enter();
+        if (first) {
+            memcpy(&first_error_ctx, &ctx, sizeof(ctx));
+        }
+        memcpy(&last_error_ctx, &ctx, sizeof(ctx));
+        core_util_critical_section_exit();
+    }
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+    error_hist_record(error_status, error_value, filename, line_number, caller);
+#endif
+}
+
 //Set an error status with the error handling system
 static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
 {
@@ -114,6 +304,17 @@ WEAK void mbed_error_reboot_callback(mbed_error_ctx *error_context)
 //Initialize Error handling system and report any errors detected on rebooted
 mbed_error_status_t mbed_error_initialize(void)
 {
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+    is_reboot_error_valid = crash_record_is_valid();
+    if (!is_reboot_error_valid) {
+        // Power-on, or a record from another firmware
+        memset(&crash_record, 0, sizeof(crash_record));
+    } else if (!crash_record.error.is_error_processed) {
+        crash_record.error.is_error_processed = 1;
+        crash_record_seal();
+        mbed_error_reboot_callback(&crash_record.error);
+    }
+#endif
     return MBED_SUCCESS;
 }
 
@@ -121,21 +322,21 @@ mbed_error_status_t mbed_error_initialize(void)
 mbed_error_status_t mbed_get_first_error(void)
 {
     //return the first error recorded
-    return 0;
+    return (mbed_error_status_t)core_util_atomic_load_u32(&first_error_status);
 }
 
 //Return the last error
 mbed_error_status_t mbed_get_last_error(void)
 {
     //return the last error recorded
-    return 0;
+    return (mbed_error_status_t)core_util_atomic_load_u32(&last_error_status);
 }
 
 //Gets the current error count
 int mbed_get_error_count(void)
 {
     //return the current error count
-    return 0;
+    return (int)core_util_atomic_load_u32(&error_count);
 }
 
 //Reads the fatal error occurred" flag
@@ -147,14 +348,40 @@ bool mbed_get_error_in_progress(void)
 //Sets a non-fatal error
 mbed_error_status_t mbed_warning(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
 {
-    return 0;
+    (void)error_msg;
+
+    //Error status should always be < 0, record the call site anyway
+    if (error_status >= 0) {
+        record_error(MBED_ERROR_INVALID_ARGUMENT, error_value, filename, line_number, MBED_CALLER_ADDR());
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    record_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+    return MBED_SUCCESS;
+}
+
+//Record a fatal error and halt
+static MBED_NORETURN void fatal_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    core_util_critical_section_enter();
+    record_error(error_status, error_value, filename, line_number, caller);
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+    crash_record_save(error_status, error_value, filename, line_number, caller);
+#endif
+    mbed_halt_system();
 }
 
 //Sets a fatal error, this function is marked WEAK to be able to override this for some tests
 WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
-{ 
-    // TODO: re-implement
-    while(1);
+{
+    (void)error_msg;
+
+    fatal_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+}
+
+//Failed assertion without strings, the caller address locates it
+MBED_NORETURN void mbed_assert_compact(int line)
+{
+    fatal_error(MBED_ERROR_ASSERTION_FAILED, (unsigned int)line, NULL, line, MBED_CALLER_ADDR());
 }
 
 //Register an application defined callback with error handling
@@ -167,35 +394,77 @@ mbed_error_status_t mbed_set_error_hook(mbed_error_hook_t error_hook_in)
 //Reset the reboot error context
 mbed_error_status_t mbed_reset_reboot_error_info()
 {
-  // TODO
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+    memset(&crash_record, 0, sizeof(crash_record));
+    is_reboot_error_valid = false;
+#endif
     return MBED_SUCCESS;
 }
 
 //Reset the reboot error context
 mbed_error_status_t mbed_reset_reboot_count()
 {
-  // TODO
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+    if (is_reboot_error_valid) {
+        crash_record.error.error_reboot_count = 0;
+        crash_record_seal();
+        return MBED_SUCCESS;
+    }
+#endif
     return MBED_ERROR_ITEM_NOT_FOUND;
 }
 
 //Retrieve the reboot error context
 mbed_error_status_t mbed_get_reboot_error_info(mbed_error_ctx *error_info)
 {
-   // TODO
-    return 0;
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+    if (error_info == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (is_reboot_error_valid) {
+        memcpy(error_info, &crash_record.error, sizeof(*error_info));
+        return MBED_SUCCESS;
+    }
+#endif
+    return MBED_ERROR_ITEM_NOT_FOUND;
+}
+
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+//Retrieve the whole crash record
+mbed_error_status_t mbed_get_crash_record(mbed_crash_record_t *record)
+{
+    if (record == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (!is_reboot_error_valid) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    memcpy(record, &crash_record, sizeof(*record));
+    return MBED_SUCCESS;
 }
+#endif
 
 //Retrieve the first error context from error log
 mbed_error_status_t mbed_get_first_error_info(mbed_error_ctx *error_info)
 {
-    // TODO
+    if (error_info == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    core_util_critical_section_enter();
+    memcpy(error_info, &first_error_ctx, sizeof(*error_info));
+    core_util_critical_section_exit();
     return MBED_SUCCESS;
 }
 
 //Retrieve the last error context from error log
 mbed_error_status_t mbed_get_last_error_info(mbed_error_ctx *error_info)
 {
-    // TODO
+    if (error_info == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    core_util_critical_section_enter();
+    memcpy(error_info, &last_error_ctx, sizeof(*error_info));
+    core_util_critical_section_exit();
     return MBED_SUCCESS;
 }
 
@@ -213,7 +482,17 @@ mbed_error_status_t mbed_make_error(mbed_error_type_t error_type, mbed_module_ty
  */
 mbed_error_status_t mbed_clear_all_errors(void)
 {
-    return 0;
+    core_util_atomic_store_u32(&error_count, 0);
+    core_util_atomic_store_u32(&first_error_status, MBED_SUCCESS);
+    core_util_atomic_store_u32(&last_error_status, MBED_SUCCESS);
+    core_util_critical_section_enter();
+    memset(&first_error_ctx, 0, sizeof(first_error_ctx));
+    memset(&last_error_ctx, 0, sizeof(last_error_ctx));
+    core_util_critical_section_exit();
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+    core_util_atomic_store_u32(&error_hist_claimed, 0);
+#endif
+    return MBED_SUCCESS;
 }
 
 
@@ -262,13 +541,31 @@ static void print_threads_info(const osRtxThread_t *threads)
 //Retrieve the error context from error log at the specified index
 mbed_error_status_t mbed_get_error_hist_info(int index, mbed_error_ctx *error_info)
 {
-        // TODO
+    const uint32_t claimed = core_util_atomic_load_u32(&error_hist_claimed);
+    const uint32_t count = claimed < MBED_CONF_PLATFORM_ERROR_HIST_SIZE ? claimed : MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
+    if (index < 0 || (uint32_t)index >= count || error_info == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    // The entry is copied then checked again, in case it was overwritten meanwhile
+    const uint32_t sequence = claimed - count + index + 1;
+    const error_hist_entry_t *entry = &error_hist[(sequence - 1) % MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
+    if (core_util_atomic_load_u32(&entry->sequence) != sequence) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    memcpy(error_info, &entry->ctx, sizeof(*error_info));
+    error_info->error_repeat_count = core_util_atomic_load_u32(&entry->repeat_count);
+    if (core_util_atomic_load_u32(&entry->sequence) != sequence) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    return MBED_SUCCESS;
 }
 
 //Retrieve the error log count
 int mbed_get_error_hist_count(void)
 {
-        // TODO
+    const uint32_t claimed = core_util_atomic_load_u32(&error_hist_claimed);
+    return claimed < MBED_CONF_PLATFORM_ERROR_HIST_SIZE ? (int)claimed : MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
 }
 
 mbed_error_status_t mbed_save_error_hist(const char *path)
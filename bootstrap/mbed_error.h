@@ -18,6 +18,7 @@
 #define MBED_ERROR_H
 
 #include <stdbool.h>
+#include "bootstrap/mbed_assert.h"
 #include "bootstrap/mbed_retarget.h"
 #include "bootstrap/mbed_toolchain.h"
 
@@ -41,6 +42,10 @@ extern "C" {
  *  MBED_PLATFORM_CONF_ERROR_HIST_ENABLED
  */
 
+/** Define this macro to record numeric error codes and caller addresses only, without strings
+ *  MBED_CONF_PLATFORM_ERROR_COMPACT
+ */
+
 #ifndef MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN
 #define MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN            16
 #else //MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN
@@ -157,10 +162,10 @@ typedef int mbed_error_status_t;
  *        Since this macro is a wrapper for mbed_warning API callers should process the return value from this macro which is the return value from calling mbed_error API.
  *
  */
-#ifdef NDEBUG
+#if defined(NDEBUG) || MBED_CONF_PLATFORM_ERROR_COMPACT
 #define MBED_WARNING1( error_status, error_msg, error_value )         mbed_warning( error_status, (const char *)NULL, (uint32_t)error_value, NULL, 0 )
 #define MBED_WARNING( error_status, error_msg )                       mbed_warning( error_status, (const char *)NULL, (uint32_t)0,           NULL, 0 )
-#else //NDEBUG
+#else //NDEBUG || MBED_CONF_PLATFORM_ERROR_COMPACT
 #if MBED_CONF_PLATFORM_ERROR_FILENAME_CAPTURE_ENABLED
 #define MBED_WARNING1( error_status, error_msg, error_value )     mbed_warning( error_status, (const char *)error_msg, (uint32_t)error_value, (const char *)MBED_FILENAME, __LINE__ )
 #define MBED_WARNING( error_status, error_msg )                   mbed_warning( error_status, (const char *)error_msg, (uint32_t)0          , (const char *)MBED_FILENAME, __LINE__ )
@@ -188,10 +193,10 @@ typedef int mbed_error_status_t;
  *       Since this macro is a wrapper for mbed_error API callers should process the return value from this macro which is the return value from calling mbed_error API.
  *
  */
-#ifdef NDEBUG
+#if defined(NDEBUG) || MBED_CONF_PLATFORM_ERROR_COMPACT
 #define MBED_ERROR1( error_status, error_msg, error_value )           mbed_error( error_status, (const char *)NULL, (uint32_t)error_value, NULL, 0 )
 #define MBED_ERROR( error_status, error_msg )                         mbed_error( error_status, (const char *)NULL, (uint32_t)0          , NULL, 0 )
-#else //NDEBUG
+#else //NDEBUG || MBED_CONF_PLATFORM_ERROR_COMPACT
 #if MBED_CONF_PLATFORM_ERROR_FILENAME_CAPTURE_ENABLED
 #define MBED_ERROR1( error_status, error_msg, error_value )       mbed_error( error_status, (const char *)error_msg, (uint32_t)error_value, (const char *)MBED_FILENAME, __LINE__ )
 #define MBED_ERROR( error_status, error_msg )                     mbed_error( error_status, (const char *)error_msg, (uint32_t)0          , (const char *)MBED_FILENAME, __LINE__ )
@@ -844,6 +849,9 @@ typedef struct _mbed_error_ctx {
     char error_filename[MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN];
     uint32_t error_line_number;
 #endif
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+    uint32_t error_repeat_count;//number of times the error was reported in a row from the same place, only set for error history entries
+#endif
 #if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
     int32_t error_reboot_count;//everytime we write this struct we increment this value by 1, irrespective of time between reboots. Note that the data itself might change, but everytime we reboot due to error we update this count by 1
     int32_t is_error_processed;//once this error is processed set this value to 1
@@ -851,6 +859,37 @@ typedef struct _mbed_error_ctx {
 #endif
 } mbed_error_ctx;
 
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+#ifndef MBED_CONF_PLATFORM_CRASH_CAPTURE_STACK_WORDS
+#define MBED_CONF_PLATFORM_CRASH_CAPTURE_STACK_WORDS        16
+#endif
+
+#ifndef MBED_CONF_PLATFORM_CRASH_CAPTURE_TRACE_LEN
+#define MBED_CONF_PLATFORM_CRASH_CAPTURE_TRACE_LEN          64
+#endif
+
+/** Record of a fatal error, kept over the reboot in retained RAM
+ *
+ * The record is written by mbed_error() without printing anything, so the
+ * system reboots right away, and is checked by mbed_error_initialize() after
+ * the reboot. It is plain binary data which can be sent as it is to a server.
+ */
+typedef struct _mbed_crash_record {
+    uint32_t magic;                 //identifies a record written by mbed_error()
+    uint32_t length;                //size of the record, catches firmware updates changing its layout
+    mbed_error_ctx error;           //error context, with the reboot count
+    uint64_t timestamp_us;          //us ticker time of the error, 0 if the ticker wasn't running or the error was raised by a fault handler
+    uint32_t cfsr;                  //fault status registers, 0 on cores without them
+    uint32_t hfsr;
+    uint32_t mmfar;
+    uint32_t bfar;
+    uint32_t stack_pointer;         //stack pointer in mbed_error()
+    uint32_t stack[MBED_CONF_PLATFORM_CRASH_CAPTURE_STACK_WORDS];   //words from the stack pointer up
+    char last_trace[MBED_CONF_PLATFORM_CRASH_CAPTURE_TRACE_LEN];    //last trace line, truncated
+    uint32_t crc;                   //CRC-32 of the record, crc should always be the last member in this struct
+} mbed_crash_record_t;
+#endif
+
 /** To generate a fatal compile-time error, you can use the pre-processor #error directive.
  *
  * @param format    C string that contains data stream to be printed.
@@ -995,6 +1034,18 @@ mbed_error_status_t mbed_error_initialize(void);
  */
 mbed_error_status_t mbed_get_reboot_error_info(mbed_error_ctx *error_info);
 
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+/**
+ * Call this function to retrieve the whole crash record after a fatal error which triggered a system reboot, for example to send it to a server.
+ * @param  record               Pointer to mbed_crash_record_t struct allocated by the caller.
+ * @return                      0 or MBED_SUCCESS on success.
+ *                              MBED_ERROR_INVALID_ARGUMENT in case of invalid record pointer
+ *                              MBED_ERROR_ITEM_NOT_FOUND if no reboot context is currently captured by the system
+ *
+ */
+mbed_error_status_t mbed_get_crash_record(mbed_crash_record_t *record);
+#endif
+
 /**
  * Calling this function resets the current reboot context captured by the system(stored in special crash data RAM region).
  * @return                  MBED_SUCCESS on success.
@@ -1028,6 +1079,7 @@ mbed_error_status_t mbed_reset_reboot_count(void);
  * @endcode
  *
  * @note See MBED_WARNING/MBED_ERROR macros which provides a wrapper on this API
+ * @note This function doesn't block and is safe to call from interrupt handlers.
  */
 mbed_error_status_t mbed_warning(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number);
 
@@ -1107,8 +1159,10 @@ mbed_error_status_t mbed_set_error_hook(mbed_error_hook_t custom_error_hook);
  * Reads the first error context information captured.
  * @param  error_info           This is the mbed_error_context info captured as part of the first mbed_error call. The caller should pass a pointer to mbed_error_context struct allocated by the caller.
  * @return                      0 or MBED_SUCCESS on success.
- *                              MBED_ERROR_INVALID_ARGUMENT in case of invalid index
+ *                              MBED_ERROR_INVALID_ARGUMENT if error_info is NULL
  *
+ * @note The context is all zeros before the first error, and if the first error was raised by a fault handler or
+ *       an interrupt above the critical section priority, which only set the error status.
  */
 mbed_error_status_t mbed_get_first_error_info(mbed_error_ctx *error_info);
 
@@ -1116,8 +1170,10 @@ mbed_error_status_t mbed_get_first_error_info(mbed_error_ctx *error_info);
  * Reads the last error context information captured.
  * @param  error_info           This is the mbed_error_context info captured as part of the last mbed_error call. The caller should pass a pointer to mbed_error_context struct allocated by the caller.
  * @return                      0 or MBED_ERROR_SUCCESS on success.
- *                              MBED_ERROR_INVALID_ARGUMENT in case of invalid index
+ *                              MBED_ERROR_INVALID_ARGUMENT if error_info is NULL
  *
+ * @note The context is all zeros before the first error. An error raised by a fault handler or an interrupt above
+ *       the critical section priority only sets the error status, the context stays the one of the error before.
  */
 mbed_error_status_t mbed_get_last_error_info(mbed_error_ctx *error_info);
 
@@ -1154,7 +1210,10 @@ int mbed_get_error_hist_count(void);
  * @param  error_info           This is the mbed_error_context info captured as part of the error history. The caller should pass a pointer to mbed_error_context struct allocated by the caller.
  * @return                      0 or MBED_SUCCESS on success.
  *                              MBED_ERROR_INVALID_ARGUMENT in case of invalid index
+ *                              MBED_ERROR_ITEM_NOT_FOUND if the entry is being overwritten by a new error
  *
+ * @note Warnings repeated in a row from the same place, with the same status and value, are counted in
+ *       error_repeat_count of a single entry instead of filling the history.
  */
 mbed_error_status_t mbed_get_error_hist_info(int index, mbed_error_ctx *error_info);
 
@@ -0,0 +1,398 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_FORMAT_H
+#define MBED_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bootstrap/mbed_printf_implementation.h"
+
+#ifdef __cplusplus
+
+#include <type_traits>
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_format Compile-time format strings
+ * snprintf() with the format string parsed by the compiler
+ *
+ * The format string is split into literal text and conversions at compile
+ * time, so each call only runs the formatters of its conversions, which are
+ * those of minimal printf. The types of the arguments are checked against
+ * the conversions, and a mismatch, or a wrong number of arguments, is a
+ * build error.
+ *
+ * @code
+ * char line[64];
+ * mbed::format(line, sizeof(line), MBED_FORMAT_STRING("rx %u bytes from %p\n"), count, address);
+ * @endcode
+ *
+ * The conversions are those of minimal printf without floating point: d, i,
+ * u, x, X, c, s, p and %%, with the length modifiers hh, h, l, ll, j, z and
+ * t. As in minimal printf, flags and widths are accepted and ignored, and
+ * the precision only applies to strings.
+ *
+ * @{
+ */
+
+/** Wrap a string literal for ::mbed::format
+ *
+ * @param string The format string, a string literal
+ */
+#define MBED_FORMAT_STRING(string) \
+    ([] { \
+        struct mbed_format_string { \
+            static constexpr const char *str() \
+            { \
+                return string; \
+            } \
+        }; \
+        return mbed_format_string(); \
+    }())
+
+namespace mbed {
+
+namespace format_impl {
+
+enum class Length { none, hh, h, l, ll, j, z, t };
+
+/* A conversion, from the '%' to the conversion character */
+struct Spec {
+    size_t end;
+    char conversion;
+    Length length;
+    bool width_arg;
+    bool precision_arg;
+    int precision;
+};
+
+struct Output {
+    char *buffer;
+    size_t length;
+    int result;
+};
+
+template<char C, Length L, bool WidthArg, bool PrecisionArg>
+struct Conversion {
+};
+
+constexpr bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/* Position of the next '%', or of the terminator */
+constexpr size_t next_spec(const char *format, size_t pos)
+{
+    while (format[pos] != '\0' && format[pos] != '%') {
+        pos++;
+    }
+    return pos;
+}
+
+/* Parse the conversion at pos, the same way as mbed_minimal_formatted_string */
+constexpr Spec parse(const char *format, size_t pos)
+{
+    Spec spec = { 0, '\0', Length::none, false, false, -1 };
+    size_t i = pos + 1;
+
+    if (format[i] == '-' || format[i] == '+' || format[i] == ' ' || format[i] == '#' || format[i] == '0') {
+        i++;
+    }
+
+    if (format[i] == '*') {
+        spec.width_arg = true;
+        i++;
+    } else {
+        while (is_digit(format[i])) {
+            i++;
+        }
+    }
+
+    if (format[i] == '.') {
+        i++;
+        if (format[i] == '*') {
+            spec.precision_arg = true;
+            i++;
+        } else {
+            spec.precision = 0;
+            while (is_digit(format[i])) {
+                spec.precision = spec.precision * 10 + (format[i] - '0');
+                i++;
+            }
+        }
+    }
+
+    if (format[i] == 'h' && format[i + 1] == 'h') {
+        spec.length = Length::hh;
+        i += 2;
+    } else if (format[i] == 'l' && format[i + 1] == 'l') {
+        spec.length = Length::ll;
+        i += 2;
+    } else if (format[i] == 'h') {
+        spec.length = Length::h;
+        i++;
+    } else if (format[i] == 'l') {
+        spec.length = Length::l;
+        i++;
+    } else if (format[i] == 'j') {
+        spec.length = Length::j;
+        i++;
+    } else if (format[i] == 'z') {
+        spec.length = Length::z;
+        i++;
+    } else if (format[i] == 't') {
+        spec.length = Length::t;
+        i++;
+    }
+
+    spec.conversion = format[i];
+    spec.end = format[i] == '\0' ? i : i + 1;
+    return spec;
+}
+
+constexpr size_t arguments_needed(const Spec &spec)
+{
+    return (spec.width_arg ? 1 : 0) + (spec.precision_arg ? 1 : 0) + (spec.conversion != '%' ? 1 : 0);
+}
+
+/* Largest integer, after promotion, a length modifier accepts */
+constexpr size_t max_size(Length length)
+{
+    return length == Length::l ? sizeof(long) :
+           length == Length::ll ? sizeof(long long) :
+           length == Length::j ? sizeof(intmax_t) :
+           length == Length::z ? sizeof(size_t) :
+           length == Length::t ? sizeof(ptrdiff_t) :
+           sizeof(int);
+}
+
+/* Truncate a value to the type of the length modifier, as a vararg read would */
+constexpr intmax_t constrain_signed(Length length, intmax_t value)
+{
+    return length == Length::hh ? (signed char)value :
+           length == Length::h ? (short)value :
+           length == Length::l ? (long)value :
+           length == Length::ll ? (long long)value :
+           length == Length::j ? value :
+           length == Length::z ? (intmax_t)(std::make_signed<size_t>::type)value :
+           length == Length::t ? (ptrdiff_t)value :
+           (int)value;
+}
+
+constexpr uintmax_t constrain_unsigned(Length length, uintmax_t value)
+{
+    return length == Length::hh ? (unsigned char)value :
+           length == Length::h ? (unsigned short)value :
+           length == Length::l ? (unsigned long)value :
+           length == Length::ll ? (unsigned long long)value :
+           length == Length::j ? value :
+           length == Length::z ? (size_t)value :
+           length == Length::t ? (uintmax_t)(std::make_unsigned<ptrdiff_t>::type)value :
+           (unsigned int)value;
+}
+
+template<typename T>
+struct dependent_false : std::false_type {
+};
+
+template<char C, Length L, typename T>
+void format_value(Output &, Conversion<C, L, false, false>, int, T)
+{
+    static_assert(dependent_false<T>::value, "Unsupported conversion in the format string");
+}
+
+template<Length L, typename T>
+void format_signed(Output &out, T value)
+{
+    static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "%d and %i expect a signed integer");
+    static_assert(sizeof(+value) <= max_size(L), "Integer too large for the length modifier of %d or %i");
+    mbed_minimal_format_signed(out.buffer, out.length, &out.result, constrain_signed(L, value));
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'d', L, false, false>, int, T value)
+{
+    format_signed<L>(out, value);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'i', L, false, false>, int, T value)
+{
+    format_signed<L>(out, value);
+}
+
+/* The value of an integer converted to unsigned after promotion, as C does */
+template<Length L, typename T>
+uintmax_t unsigned_value(T value)
+{
+    static_assert(std::is_integral<T>::value, "%u, %x and %X expect an integer");
+    static_assert(sizeof(+value) <= max_size(L), "Integer too large for the length modifier of %u, %x or %X");
+    typedef typename std::make_unsigned<decltype(+value)>::type promoted;
+    return constrain_unsigned(L, (promoted)value);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'u', L, false, false>, int, T value)
+{
+    mbed_minimal_format_unsigned(out.buffer, out.length, &out.result, unsigned_value<L>(value));
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'x', L, false, false>, int, T value)
+{
+    mbed_minimal_format_hexadecimal(out.buffer, out.length, &out.result, unsigned_value<L>(value), false);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'X', L, false, false>, int, T value)
+{
+    mbed_minimal_format_hexadecimal(out.buffer, out.length, &out.result, unsigned_value<L>(value), true);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'c', L, false, false>, int, T value)
+{
+    static_assert(std::is_integral<T>::value, "%c expects a character");
+    static_assert(L == Length::none, "Wide characters are not supported");
+    mbed_minimal_format_char(out.buffer, out.length, &out.result, (char)value);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'s', L, false, false>, int precision, T value)
+{
+    static_assert(std::is_convertible<T, const char *>::value, "%s expects a string");
+    static_assert(L == Length::none, "Wide strings are not supported");
+    mbed_minimal_format_string(out.buffer, out.length, &out.result, value, precision < 0 ? SIZE_MAX : (size_t)precision);
+}
+
+template<Length L, typename T>
+void format_value(Output &out, Conversion<'p', L, false, false>, int, T value)
+{
+    static_assert(std::is_pointer<T>::value || std::is_same<T, std::nullptr_t>::value, "%p expects a pointer");
+    static_assert(L == Length::none, "%p takes no length modifier");
+    mbed_minimal_format_pointer(out.buffer, out.length, &out.result, (const void *)value);
+}
+
+template<typename Format, size_t Pos, typename... Args>
+void format_from(Output &out, Args... args);
+
+/* '*' width, read and ignored */
+template<typename Format, size_t Pos, char C, Length L, bool PrecisionArg, typename T, typename... Args>
+void convert(Output &out, Conversion<C, L, true, PrecisionArg>, int precision, T width, Args... args)
+{
+    static_assert(std::is_integral<T>::value, "A '*' width expects an int");
+    (void)width;
+    convert<Format, Pos>(out, Conversion<C, L, false, PrecisionArg>(), precision, args...);
+}
+
+/* '*' precision */
+template<typename Format, size_t Pos, char C, Length L, typename T, typename... Args>
+void convert(Output &out, Conversion<C, L, false, true>, int, T precision, Args... args)
+{
+    static_assert(std::is_integral<T>::value, "A '*' precision expects an int");
+    convert<Format, Pos>(out, Conversion<C, L, false, false>(), (int)precision, args...);
+}
+
+template<typename Format, size_t Pos, char C, Length L, typename T, typename... Args>
+void convert(Output &out, Conversion<C, L, false, false> conversion, int precision, T value, Args... args)
+{
+    format_value(out, conversion, precision, value);
+    format_from<Format, Pos>(out, args...);
+}
+
+/* %% */
+template<typename Format, size_t Pos, typename Conv, typename... Args>
+void format_conversion(Output &out, std::true_type, Conv, int, Args... args)
+{
+    mbed_minimal_format_char(out.buffer, out.length, &out.result, '%');
+    format_from<Format, Pos>(out, args...);
+}
+
+template<typename Format, size_t Pos, typename Conv, typename... Args>
+void format_conversion(Output &out, std::false_type, Conv conversion, int precision, Args... args)
+{
+    convert<Format, Pos>(out, conversion, precision, args...);
+}
+
+/* End of the format string */
+template<typename Format, size_t Pos, typename... Args>
+void format_spec(Output &, std::true_type, Args...)
+{
+    static_assert(sizeof...(Args) == 0, "Too many arguments for the format string");
+}
+
+template<typename Format, size_t Pos, typename... Args>
+void format_spec(Output &out, std::false_type, Args... args)
+{
+    constexpr Spec spec = parse(Format::str(), Pos);
+    static_assert(spec.conversion != '\0', "Incomplete conversion at the end of the format string");
+    static_assert(sizeof...(Args) >= arguments_needed(spec), "Too few arguments for the format string");
+
+    format_conversion<Format, spec.end>(out, std::integral_constant<bool, spec.conversion == '%'>(),
+                                        Conversion<spec.conversion, spec.length, spec.width_arg, spec.precision_arg>(),
+                                        spec.precision, args...);
+}
+
+template<typename Format, size_t Pos, typename... Args>
+void format_from(Output &out, Args... args)
+{
+    constexpr size_t spec_pos = next_spec(Format::str(), Pos);
+    if (spec_pos != Pos) {
+        mbed_minimal_format_string(out.buffer, out.length, &out.result, Format::str() + Pos, spec_pos - Pos);
+    }
+    format_spec<Format, spec_pos>(out, std::integral_constant<bool, Format::str()[spec_pos] == '\0'>(), args...);
+}
+
+} // namespace format_impl
+
+/** Format a string, like snprintf() with a format string checked at compile time
+ *
+ * @param buffer The buffer to write to, always terminated if size is not 0
+ * @param size   The size of the buffer
+ * @param format The format string, wrapped with ::MBED_FORMAT_STRING
+ * @param args   The values of the conversions
+ *
+ * @return The number of characters of the output, excluding the terminator,
+ *   even if it didn't fit in the buffer
+ */
+template<typename Format, typename... Args>
+int format(char *buffer, size_t size, Format format, Args... args)
+{
+    (void)format;
+    format_impl::Output out = { buffer, size > 0 ? size - 1 : 0, 0 };
+
+    format_impl::format_from<Format, 0>(out, args...);
+
+    if (size > 0) {
+        buffer[(size_t)out.result < out.length ? (size_t)out.result : out.length] = '\0';
+    }
+    return out.result;
+}
+
+} // namespace mbed
+
+/**@}*/
+
+/**@}*/
+
+#endif // __cplusplus
+
+#endif // MBED_FORMAT_H
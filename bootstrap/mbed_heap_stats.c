@@ -0,0 +1,204 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_heap_stats.h"
+
+#if MBED_CONF_PLATFORM_HEAP_STATS_ENABLED && defined(__GNUC__) && !defined(__ARMCC_VERSION)
+
+#include <malloc.h>
+#include <reent.h>
+#include <string.h>
+#include "mbed_boot.h"
+#include "mbed_critical.h"
+#include "mbed_toolchain.h"
+
+static mbed_stats_heap_t heap_stats;
+static mbed_stats_heap_site_t heap_sites[MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES];
+
+void *__real__malloc_r(struct _reent *r, size_t size);
+void __real__free_r(struct _reent *r, void *ptr);
+void *__real__realloc_r(struct _reent *r, void *ptr, size_t size);
+void *__real__calloc_r(struct _reent *r, size_t nmemb, size_t size);
+
+static void heap_stats_add(void *ptr, const void *caller)
+{
+    const uint32_t size = _malloc_usable_size_r(_REENT, ptr);
+
+    heap_stats.current_size += size;
+    heap_stats.total_size += size;
+    heap_stats.alloc_cnt++;
+    heap_stats.total_alloc_cnt++;
+    if (heap_stats.current_size > heap_stats.max_size) {
+        heap_stats.max_size = heap_stats.current_size;
+    }
+
+    for (size_t i = 0; i < MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES; i++) {
+        if (heap_sites[i].caller == caller || heap_sites[i].caller == NULL) {
+            heap_sites[i].caller = caller;
+            heap_sites[i].alloc_cnt++;
+            heap_sites[i].total_size += size;
+            break;
+        }
+    }
+}
+
+static void heap_stats_remove(void *ptr)
+{
+    heap_stats.current_size -= _malloc_usable_size_r(_REENT, ptr);
+    heap_stats.alloc_cnt--;
+}
+
+static void *heap_alloc(struct _reent *r, size_t nmemb, size_t size, bool clear, const void *caller)
+{
+    core_util_critical_section_enter();
+    void *ptr = clear ? __real__calloc_r(r, nmemb, size) : __real__malloc_r(r, size);
+    if (ptr != NULL) {
+        heap_stats_add(ptr, caller);
+    } else {
+        heap_stats.alloc_fail_cnt++;
+    }
+    core_util_critical_section_exit();
+    return ptr;
+}
+
+static void heap_free(struct _reent *r, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    core_util_critical_section_enter();
+    heap_stats_remove(ptr);
+    __real__free_r(r, ptr);
+    core_util_critical_section_exit();
+}
+
+static void *heap_realloc(struct _reent *r, void *ptr, size_t size, const void *caller)
+{
+    core_util_critical_section_enter();
+    // The old block is kept when the reallocation fails
+    const uint32_t old_size = (ptr != NULL) ? _malloc_usable_size_r(r, ptr) : 0;
+    void *new_ptr = __real__realloc_r(r, ptr, size);
+    if (new_ptr != NULL) {
+        if (ptr != NULL) {
+            heap_stats.current_size -= old_size;
+            heap_stats.alloc_cnt--;
+        }
+        heap_stats_add(new_ptr, caller);
+    } else if (size > 0) {
+        heap_stats.alloc_fail_cnt++;
+    } else if (ptr != NULL) {
+        // realloc(ptr, 0) freed the block
+        heap_stats.current_size -= old_size;
+        heap_stats.alloc_cnt--;
+    }
+    core_util_critical_section_exit();
+    return new_ptr;
+}
+
+void *__wrap__malloc_r(struct _reent *r, size_t size)
+{
+    return heap_alloc(r, 1, size, false, MBED_CALLER_ADDR());
+}
+
+void __wrap__free_r(struct _reent *r, void *ptr)
+{
+    heap_free(r, ptr);
+}
+
+void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    return heap_realloc(r, ptr, size, MBED_CALLER_ADDR());
+}
+
+void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
+{
+    return heap_alloc(r, nmemb, size, true, MBED_CALLER_ADDR());
+}
+
+/* The standard functions are wrapped too, so the call sites are their callers
+ * rather than the C library functions calling the reentrant versions.
+ */
+void *__wrap_malloc(size_t size)
+{
+    return heap_alloc(_REENT, 1, size, false, MBED_CALLER_ADDR());
+}
+
+void __wrap_free(void *ptr)
+{
+    heap_free(_REENT, ptr);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    return heap_realloc(_REENT, ptr, size, MBED_CALLER_ADDR());
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    return heap_alloc(_REENT, nmemb, size, true, MBED_CALLER_ADDR());
+}
+
+void mbed_stats_heap_get(mbed_stats_heap_t *stats)
+{
+    const struct mallinfo info = _mallinfo_r(_REENT);
+
+    core_util_critical_section_enter();
+    *stats = heap_stats;
+    core_util_critical_section_exit();
+    stats->reserved_size = mbed_heap_size;
+    stats->fragmented_size = info.fordblks;
+}
+
+size_t mbed_stats_heap_sites_get(mbed_stats_heap_site_t *sites, size_t count)
+{
+    mbed_stats_heap_site_t all[MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES];
+    size_t found = 0;
+
+    core_util_critical_section_enter();
+    memcpy(all, heap_sites, sizeof(all));
+    core_util_critical_section_exit();
+
+    // Selection of the largest sites, there are few of them
+    while (found < count) {
+        size_t largest = MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES;
+        for (size_t i = 0; i < MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES; i++) {
+            if (all[i].caller != NULL &&
+                    (largest == MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES || all[i].total_size > all[largest].total_size)) {
+                largest = i;
+            }
+        }
+        if (largest == MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES) {
+            break;
+        }
+        sites[found++] = all[largest];
+        all[largest].caller = NULL;
+    }
+
+    return found;
+}
+
+void mbed_stats_heap_reset(void)
+{
+    core_util_critical_section_enter();
+    heap_stats.max_size = heap_stats.current_size;
+    heap_stats.total_size = 0;
+    heap_stats.total_alloc_cnt = 0;
+    heap_stats.alloc_fail_cnt = 0;
+    memset(heap_sites, 0, sizeof(heap_sites));
+    core_util_critical_section_exit();
+}
+
+#endif // MBED_CONF_PLATFORM_HEAP_STATS_ENABLED && defined(__GNUC__) && !defined(__ARMCC_VERSION)
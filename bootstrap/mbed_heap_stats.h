@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HEAP_STATS_H
+#define MBED_HEAP_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Wrap the allocator to gather heap statistics, GCC_ARM only */
+#ifndef MBED_CONF_PLATFORM_HEAP_STATS_ENABLED
+#define MBED_CONF_PLATFORM_HEAP_STATS_ENABLED 0
+#endif
+
+/** Number of allocation call sites recorded */
+#ifndef MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES
+#define MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup heap_stats Heap statistics
+ * Usage of the heap and allocation call sites
+ *
+ * With MBED_CONF_PLATFORM_HEAP_STATS_ENABLED, the build wraps malloc(),
+ * free(), realloc() and calloc(), and their reentrant versions called by the
+ * C library, with the linker --wrap option. Sizes are the usable sizes of the
+ * blocks given by the allocator, so they include its rounding but not its
+ * headers, and blocks of memalign() are counted when they are freed or
+ * reallocated only.
+ *
+ * The call sites are the return addresses of the allocations, the first
+ * MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES ones seen since the last reset;
+ * the allocations of the other sites are only counted in the totals.
+ *
+ * @{
+ */
+
+/** Heap statistics */
+typedef struct {
+    uint32_t current_size;    /**< Bytes allocated now */
+    uint32_t max_size;        /**< Most bytes allocated at once */
+    uint32_t total_size;      /**< Bytes allocated, freed or not */
+    uint32_t reserved_size;   /**< Size of the heap region */
+    uint32_t fragmented_size; /**< Free bytes the allocator holds between allocated blocks */
+    uint32_t alloc_cnt;       /**< Allocations now */
+    uint32_t total_alloc_cnt; /**< Allocations, freed or not */
+    uint32_t alloc_fail_cnt;  /**< Failed allocations */
+} mbed_stats_heap_t;
+
+/** Allocations of a call site */
+typedef struct {
+    const void *caller;  /**< Return address of the allocation */
+    uint32_t alloc_cnt;  /**< Allocations */
+    uint32_t total_size; /**< Bytes allocated */
+} mbed_stats_heap_site_t;
+
+#if MBED_CONF_PLATFORM_HEAP_STATS_ENABLED
+
+/**
+ * Get the heap statistics
+ *
+ * @param stats The statistics
+ */
+void mbed_stats_heap_get(mbed_stats_heap_t *stats);
+
+/**
+ * Get the call sites which allocated the most bytes
+ *
+ * @param sites The call sites, by total size allocated
+ * @param count The largest number of call sites to get
+ * @return The number of call sites written
+ */
+size_t mbed_stats_heap_sites_get(mbed_stats_heap_site_t *sites, size_t count);
+
+/**
+ * Reset the peak, totals and call sites to the current usage
+ *
+ * The current size and number of allocations are kept.
+ */
+void mbed_stats_heap_reset(void);
+
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_HEAP_STATS_H
@@ -0,0 +1,152 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_irq_profile.h"
+
+#if MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER && defined(NVIC_RAM_VECTOR_ADDRESS)
+
+#include <string.h>
+#include "mbed_critical.h"
+
+#define TRACE_GROUP "irqp"
+#include "mbed_trace.h"
+
+#if DEVICE_ITM
+#include "hal/itm_api.h"
+#endif
+
+#define IRQ_COUNT (NVIC_NUM_VECTORS - NVIC_USER_IRQ_OFFSET)
+#define NO_IRQ    (-1)
+
+typedef void (*irq_handler_t)(void);
+
+static irq_handler_t irq_handlers[IRQ_COUNT];
+static mbed_irq_profile_t irq_profiles[IRQ_COUNT];
+
+static volatile int32_t latency_irq = NO_IRQ;
+static uint32_t latency_start;
+static uint32_t latency_cycles;
+
+/* Each interrupt only updates its own profile, and cannot preempt itself */
+static void irq_profile_handler(void)
+{
+    const uint32_t entry = hal_cycle_counter_read();
+    const uint32_t index = __get_IPSR() - NVIC_USER_IRQ_OFFSET;
+
+    if (latency_irq == (int32_t)index) {
+        latency_cycles = entry - latency_start;
+        latency_irq = NO_IRQ;
+    }
+
+    irq_handlers[index]();
+
+    const uint32_t cycles = hal_cycle_counter_read() - entry;
+    mbed_irq_profile_t *profile = &irq_profiles[index];
+    profile->count++;
+    profile->total_cycles += cycles;
+    if (cycles > profile->max_cycles) {
+        profile->max_cycles = cycles;
+    }
+}
+
+void mbed_irq_profile_start(void)
+{
+    hal_cycle_counter_init();
+
+    core_util_critical_section_enter();
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        const uint32_t vector = NVIC_GetVector((IRQn_Type)i);
+        if (vector != (uint32_t)irq_profile_handler) {
+            irq_handlers[i] = (irq_handler_t)vector;
+            NVIC_SetVector((IRQn_Type)i, (uint32_t)irq_profile_handler);
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_irq_profile_stop(void)
+{
+    core_util_critical_section_enter();
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        if (NVIC_GetVector((IRQn_Type)i) == (uint32_t)irq_profile_handler) {
+            NVIC_SetVector((IRQn_Type)i, (uint32_t)irq_handlers[i]);
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_irq_profile_get(IRQn_Type irq, mbed_irq_profile_t *profile)
+{
+    core_util_critical_section_enter();
+    *profile = irq_profiles[irq];
+    core_util_critical_section_exit();
+}
+
+void mbed_irq_profile_reset(void)
+{
+    core_util_critical_section_enter();
+    memset(irq_profiles, 0, sizeof(irq_profiles));
+    core_util_critical_section_exit();
+}
+
+uint32_t mbed_irq_profile_latency(IRQn_Type irq)
+{
+    latency_start = hal_cycle_counter_read();
+    latency_irq = irq;
+    NVIC_SetPendingIRQ(irq);
+
+    while (latency_irq != NO_IRQ) {
+    }
+
+    return latency_cycles;
+}
+
+void mbed_irq_profile_trace(void)
+{
+    mbed_irq_profile_t profile;
+
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        mbed_irq_profile_get((IRQn_Type)i, &profile);
+        if (profile.count) {
+            tr_info("IRQ %d: %lu calls, %lu cycles average, %lu cycles max", i,
+                    (unsigned long)profile.count, (unsigned long)(profile.total_cycles / profile.count),
+                    (unsigned long)profile.max_cycles);
+        }
+    }
+}
+
+#if DEVICE_ITM
+void mbed_irq_profile_send_itm(uint32_t port)
+{
+    mbed_irq_profile_t profile;
+
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        mbed_irq_profile_get((IRQn_Type)i, &profile);
+        if (profile.count) {
+            const uint32_t record[5] = {
+                (uint32_t)i,
+                profile.count,
+                profile.max_cycles,
+                (uint32_t)profile.total_cycles,
+                (uint32_t)(profile.total_cycles >> 32),
+            };
+            mbed_itm_send_block(port, record, sizeof(record));
+        }
+    }
+}
+#endif
+
+#endif // MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER && defined(NVIC_RAM_VECTOR_ADDRESS)
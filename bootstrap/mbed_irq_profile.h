@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_IRQ_PROFILE_H
+#define MBED_IRQ_PROFILE_H
+
+#include <stdint.h>
+#include "hal/cycle_counter_api.h"
+
+/** Interpose the profiler between the RAM vector table and the interrupt handlers */
+#ifndef MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED
+#define MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup irq_profile Interrupt profile
+ * Cycles spent in each interrupt handler
+ *
+ * ::mbed_irq_profile_start points every interrupt vector of the RAM vector
+ * table to a stub which stamps the cycle counter around a call to the
+ * handler it replaced. The durations include the interrupts of higher
+ * priority preempting the handler, and exclude the exception entry and exit
+ * of the core, about 12 cycles each.
+ *
+ * Handlers set with NVIC_SetVector() after ::mbed_irq_profile_start are not
+ * profiled until ::mbed_irq_profile_start is called again.
+ *
+ * Enabled by MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED on cores with the DWT
+ * cycle counter whose target has a RAM vector table (NVIC_RAM_VECTOR_ADDRESS).
+ *
+ * @{
+ */
+
+/** Profile of an interrupt */
+typedef struct {
+    uint32_t count;        /**< Calls of the handler */
+    uint32_t max_cycles;   /**< Longest call of the handler */
+    uint64_t total_cycles; /**< Cycles of all the calls */
+} mbed_irq_profile_t;
+
+#if MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED && DEVICE_CYCLE_COUNTER && defined(NVIC_RAM_VECTOR_ADDRESS)
+
+/**
+ * Start profiling the interrupts
+ *
+ * Moves the vector table to RAM first if MBED_CONF_PLATFORM_LAZY_RAM_VECTORS
+ * left it in flash. Calling it again keeps the profiles and picks up the
+ * handlers set since.
+ */
+void mbed_irq_profile_start(void);
+
+/**
+ * Stop profiling the interrupts
+ *
+ * Restores the handlers to the vector table and keeps the profiles.
+ */
+void mbed_irq_profile_stop(void);
+
+/**
+ * Get the profile of an interrupt
+ *
+ * @param irq The interrupt number
+ * @param profile The profile
+ */
+void mbed_irq_profile_get(IRQn_Type irq, mbed_irq_profile_t *profile);
+
+/** Clear the profiles of all the interrupts */
+void mbed_irq_profile_reset(void);
+
+/**
+ * Measure the entry latency of an interrupt
+ *
+ * Pends the interrupt from software and counts the cycles until its handler
+ * is called, including the exception entry and the time the interrupt waits
+ * for the handlers of higher or equal priority running. Waits for the handler
+ * to be called, so interrupts must be enabled.
+ * The handler runs as if its peripheral had requested it, so the interrupt
+ * should be one whose handler checks the status of its peripheral.
+ *
+ * @param irq The interrupt number, enabled and profiled
+ * @return The cycles from pending the interrupt to calling its handler
+ */
+uint32_t mbed_irq_profile_latency(IRQn_Type irq);
+
+/**
+ * Print the profiles of the interrupts called
+ *
+ * One line per interrupt with tr_info(), with the number of calls and the
+ * average and longest durations in cycles.
+ */
+void mbed_irq_profile_trace(void);
+
+#if DEVICE_ITM
+/**
+ * Send the profiles of the interrupts called over ITM
+ *
+ * Sends a record of 5 words per interrupt called: the interrupt number, then
+ * the ::mbed_irq_profile_t fields in order, the total cycles least
+ * significant word first. ITM must have been initialized with mbed_itm_init().
+ *
+ * @param port The ITM stimulus port to send the profiles on
+ */
+void mbed_irq_profile_send_itm(uint32_t port);
+#endif
+
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_IRQ_PROFILE_H
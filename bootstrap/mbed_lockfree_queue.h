@@ -0,0 +1,315 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_LOCKFREE_QUEUE_H
+#define MBED_LOCKFREE_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+
+#ifdef __cplusplus
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_lockfree_queue Lock-free queues
+ * Bounded queues to pass items between interrupt handlers and threads
+ *
+ * The capacity is a compile time power of two, and the items are copied in
+ * and out of static storage, so T should be small and trivially copyable.
+ * Push and pop never block: they return false when the queue is full or
+ * empty.
+ *
+ * @{
+ */
+
+/** Queue with a single producer and a single consumer
+ *
+ * The producer and the consumer can be in different contexts, for
+ * instance an interrupt handler pushing received bytes and a thread popping
+ * them. Only loads, stores and barriers are used, so the queue is lock-free
+ * on every core, including Cortex-M0 which has no exclusive access
+ * instructions.
+ *
+ * @tparam T Type of the items
+ * @tparam N Capacity, a power of two
+ */
+template<typename T, size_t N>
+class SPSCQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SPSCQueue capacity must be a power of two");
+    static_assert(N <= UINT32_MAX / 2, "SPSCQueue capacity too large");
+
+public:
+    constexpr SPSCQueue() noexcept : _items{}, _head(0), _tail(0)
+    {
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    /** Get the capacity of the queue */
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    /** Add an item at the back of the queue, from the producer only
+     *
+     * @param item Item to copy in the queue
+     * @return true if the item was added, false if the queue is full
+     */
+    bool push(const T &item) noexcept
+    {
+        const uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_relaxed);
+        const uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        if (head - tail == N) {
+            return false;
+        }
+        _items[head & (N - 1)] = item;
+        core_util_atomic_store_explicit_u32(&_head, head + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Take the item at the front of the queue, from the consumer only
+     *
+     * @param item Set to the item taken
+     * @return true if an item was taken, false if the queue is empty
+     */
+    bool pop(T &item) noexcept
+    {
+        const uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_relaxed);
+        const uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        item = _items[tail & (N - 1)];
+        core_util_atomic_store_explicit_u32(&_tail, tail + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Get the number of items in the queue
+     *
+     * The count can be out of date as soon as it is returned if the other side
+     * is running concurrently.
+     */
+    size_t size() const noexcept
+    {
+        const uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        const uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        return head - tail;
+    }
+
+    /** Check if the queue is empty */
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /** Check if the queue is full */
+    bool full() const noexcept
+    {
+        return size() == N;
+    }
+
+private:
+    T _items[N];
+    // Free-running counts of items pushed and popped
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+/** Queue with any number of producers and consumers
+ *
+ * Producers and consumers can be in any number of threads and interrupt
+ * handlers. Each slot has a sequence number telling whether it is free for
+ * the next push or holds the item for the next pop, and producers and
+ * consumers claim slots with compare-and-swap.
+ *
+ * Without exclusive access instructions, on Cortex-M0 and ARMv8-M baseline,
+ * compare-and-swap is implemented with critical sections, so push and pop
+ * use a single critical section each instead.
+ *
+ * @note A push or pop interrupted by a handler using the same queue may make
+ * the handler see the queue as full or empty until it completes.
+ *
+ * @tparam T Type of the items
+ * @tparam N Capacity, a power of two
+ */
+template<typename T, size_t N>
+class MPMCQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "MPMCQueue capacity must be a power of two");
+    static_assert(N <= UINT32_MAX / 2, "MPMCQueue capacity too large");
+
+public:
+    MPMCQueue() noexcept : _push_pos(0), _pop_pos(0)
+    {
+        for (uint32_t i = 0; i < N; i++) {
+            _slots[i].sequence = i;
+        }
+    }
+
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+    /** Get the capacity of the queue */
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+
+#if MBED_EXCLUSIVE_ACCESS
+    /** Add an item at the back of the queue
+     *
+     * @param item Item to copy in the queue
+     * @return true if the item was added, false if the queue is full
+     */
+    bool push(const T &item) noexcept
+    {
+        uint32_t pos = core_util_atomic_load_explicit_u32(&_push_pos, mbed_memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &_slots[pos & (N - 1)];
+            const uint32_t sequence = core_util_atomic_load_explicit_u32(&slot->sequence, mbed_memory_order_acquire);
+            const int32_t diff = (int32_t)(sequence - pos);
+            if (diff == 0) {
+                // The slot is free, claim it
+                if (core_util_atomic_compare_exchange_weak_explicit_u32(&_push_pos, &pos, pos + 1,
+                                                                        mbed_memory_order_relaxed, mbed_memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The slot still holds the item pushed N positions ago
+                return false;
+            } else {
+                // Another producer claimed the slot
+                pos = core_util_atomic_load_explicit_u32(&_push_pos, mbed_memory_order_relaxed);
+            }
+        }
+
+        slot->item = item;
+        core_util_atomic_store_explicit_u32(&slot->sequence, pos + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Take the item at the front of the queue
+     *
+     * @param item Set to the item taken
+     * @return true if an item was taken, false if the queue is empty
+     */
+    bool pop(T &item) noexcept
+    {
+        uint32_t pos = core_util_atomic_load_explicit_u32(&_pop_pos, mbed_memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &_slots[pos & (N - 1)];
+            const uint32_t sequence = core_util_atomic_load_explicit_u32(&slot->sequence, mbed_memory_order_acquire);
+            const int32_t diff = (int32_t)(sequence - (pos + 1));
+            if (diff == 0) {
+                // The slot holds an item, claim it
+                if (core_util_atomic_compare_exchange_weak_explicit_u32(&_pop_pos, &pos, pos + 1,
+                                                                        mbed_memory_order_relaxed, mbed_memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The slot hasn't been pushed to yet
+                return false;
+            } else {
+                // Another consumer claimed the slot
+                pos = core_util_atomic_load_explicit_u32(&_pop_pos, mbed_memory_order_relaxed);
+            }
+        }
+
+        item = slot->item;
+        // Free the slot for the push N positions later
+        core_util_atomic_store_explicit_u32(&slot->sequence, pos + N, mbed_memory_order_release);
+        return true;
+    }
+#else
+    bool push(const T &item) noexcept
+    {
+        bool pushed = false;
+        core_util_critical_section_enter();
+        Slot *slot = &_slots[_push_pos & (N - 1)];
+        if (slot->sequence == _push_pos) {
+            slot->item = item;
+            slot->sequence = _push_pos + 1;
+            _push_pos++;
+            pushed = true;
+        }
+        core_util_critical_section_exit();
+        return pushed;
+    }
+
+    bool pop(T &item) noexcept
+    {
+        bool popped = false;
+        core_util_critical_section_enter();
+        Slot *slot = &_slots[_pop_pos & (N - 1)];
+        if (slot->sequence == _pop_pos + 1) {
+            item = slot->item;
+            slot->sequence = _pop_pos + N;
+            _pop_pos++;
+            popped = true;
+        }
+        core_util_critical_section_exit();
+        return popped;
+    }
+#endif // MBED_EXCLUSIVE_ACCESS
+
+    /** Get the number of items in the queue, including those being pushed or popped
+     *
+     * The count can be out of date as soon as it is returned.
+     */
+    size_t size() const noexcept
+    {
+        const uint32_t pop_pos = core_util_atomic_load_explicit_u32(&_pop_pos, mbed_memory_order_acquire);
+        const uint32_t push_pos = core_util_atomic_load_explicit_u32(&_push_pos, mbed_memory_order_acquire);
+        const int32_t count = (int32_t)(push_pos - pop_pos);
+        return count < 0 ? 0 : (size_t)count;
+    }
+
+    /** Check if the queue is empty */
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    struct Slot {
+        volatile uint32_t sequence;
+        T item;
+    };
+
+    Slot _slots[N];
+    volatile uint32_t _push_pos;
+    volatile uint32_t _pop_pos;
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif // __cplusplus
+
+#endif // MBED_LOCKFREE_QUEUE_H
@@ -0,0 +1,57 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_mem_pool.h"
+#include "mbed_assert.h"
+#include "mbed_atomic.h"
+
+void *mbed_mem_pool_alloc(mbed_mem_pool_t *pool)
+{
+    for (size_t word = 0; word < MBED_MEM_POOL_BITMAP_WORDS(pool->block_count); word++) {
+        const int bit = core_util_atomic_bitmap_claim_u32(&pool->bitmap[word]);
+        if (bit < 0) {
+            continue;
+        }
+        const size_t index = word * 32 + bit;
+        if (index >= pool->block_count) {
+            // The lower bits of the last word are all claimed. The bit past
+            // the end is left set, it stands for no block.
+            break;
+        }
+        return pool->start + index * pool->block_size;
+    }
+
+    return NULL;
+}
+
+void mbed_mem_pool_free(mbed_mem_pool_t *pool, void *block)
+{
+    if (block == NULL) {
+        return;
+    }
+
+    const size_t offset = (uint8_t *)block - pool->start;
+    MBED_ASSERT((uint8_t *)block >= pool->start && offset < pool->block_count * pool->block_size);
+    MBED_ASSERT(offset % pool->block_size == 0);
+
+    const size_t index = offset / pool->block_size;
+    core_util_atomic_bitmap_release_u32(&pool->bitmap[index / 32], index % 32);
+}
+
+mbed_mem_region_t mbed_mem_pool_region(const mbed_mem_pool_t *pool)
+{
+    return pool->region;
+}
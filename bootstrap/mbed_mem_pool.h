@@ -0,0 +1,169 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_MEM_POOL_H
+#define MBED_MEM_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbed_toolchain.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_mem_pool Memory pools
+ * Fixed-size block pools with storage in a chosen memory region
+ *
+ * The storage of a pool is a static array placed with the attributes of its
+ * region, so blocks allocated from a DTCM pool are in DTCM and blocks
+ * allocated from a DMA pool can be handed to the DMA controllers.
+ *
+ * Allocation and free are lock-free, built on
+ * ::core_util_atomic_bitmap_claim_u32, so they can be used from interrupt
+ * handlers and never wait for a thread preempted while using the pool.
+ * Allocation scans the bitmap a word, that is 32 blocks, at a time.
+ *
+ * @code
+ * #include "mbed_mem_pool.h"
+ *
+ * MBED_DMA_POOL_DEFINE(rx_pool, 64, 8);
+ *
+ * void start_rx(void)
+ * {
+ *     uint8_t *buffer = mbed_mem_pool_alloc(&rx_pool);
+ *     ...
+ *     mbed_mem_pool_free(&rx_pool, buffer);
+ * }
+ * @endcode
+ *
+ * @{
+ */
+
+/** Memory region of a pool */
+typedef enum {
+    MBED_MEM_REGION_DEFAULT,    /**< Default RAM */
+    MBED_MEM_REGION_DTCM,       /**< Data tightly coupled memory, see ::MBED_DTCM_BSS */
+    MBED_MEM_REGION_DMA,        /**< DMA reachable buffers, see ::MBED_DMA_BUFFER */
+    MBED_MEM_REGION_EXTRAM      /**< External RAM, see ::MBED_EXTRAM_BSS */
+} mbed_mem_region_t;
+
+/** Pool of fixed-size blocks
+ *
+ * Each block has a bit in the bitmap, set while the block is allocated, so
+ * the pool needs no initialization and allocation and free are lock-free.
+ */
+typedef struct {
+    volatile uint32_t *bitmap;  /**< Allocated blocks, one bit per block */
+    uint8_t *start;             /**< Start of the storage */
+    size_t block_size;          /**< Size of a block, rounded up to its alignment */
+    size_t block_count;         /**< Number of blocks */
+    mbed_mem_region_t region;   /**< Region of the storage */
+} mbed_mem_pool_t;
+
+/** Alignment of the blocks of default and DTCM pools */
+#define MBED_MEM_POOL_ALIGNMENT 8
+
+/** Round a block size up to an alignment */
+#define MBED_MEM_POOL_BLOCK_SIZE(block_size, alignment) \
+    (((block_size) + (alignment) - 1) / (alignment) * (alignment))
+
+/** Number of bitmap words for a number of blocks */
+#define MBED_MEM_POOL_BITMAP_WORDS(count) (((count) + 31) / 32)
+
+/** Define a pool with its static storage
+ *
+ * @param name       Name of the mbed_mem_pool_t
+ * @param block_size Size of a block in bytes
+ * @param count      Number of blocks
+ * @param alignment  Alignment of the storage and the blocks
+ * @param placement  Section attribute of the storage
+ * @param mem_region mbed_mem_region_t of the storage
+ */
+#define MBED_MEM_POOL_DEFINE_IN(name, block_size, count, alignment, placement, mem_region) \
+    placement MBED_ALIGN(alignment) static uint8_t name##_storage[MBED_MEM_POOL_BLOCK_SIZE(block_size, alignment) * (count)]; \
+    static volatile uint32_t name##_bitmap[MBED_MEM_POOL_BITMAP_WORDS(count)]; \
+    static mbed_mem_pool_t name = { \
+        name##_bitmap, \
+        name##_storage, \
+        MBED_MEM_POOL_BLOCK_SIZE(block_size, alignment), \
+        (count), \
+        mem_region \
+    }
+
+/** Define a pool in the default RAM */
+#define MBED_MEM_POOL_DEFINE(name, block_size, count) \
+    MBED_MEM_POOL_DEFINE_IN(name, block_size, count, MBED_MEM_POOL_ALIGNMENT, , MBED_MEM_REGION_DEFAULT)
+
+/** Define a pool in the data tightly coupled memory */
+#define MBED_DTCM_POOL_DEFINE(name, block_size, count) \
+    MBED_MEM_POOL_DEFINE_IN(name, block_size, count, MBED_MEM_POOL_ALIGNMENT, MBED_DTCM_BSS, MBED_MEM_REGION_DTCM)
+
+/** Define a pool of DMA buffers
+ *
+ * Each block is rounded up to MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT so cache
+ * maintenance on one block doesn't affect its neighbours.
+ */
+#define MBED_DMA_POOL_DEFINE(name, block_size, count) \
+    MBED_MEM_POOL_DEFINE_IN(name, block_size, count, MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT, MBED_DMA_BUFFER, MBED_MEM_REGION_DMA)
+
+/** Define a pool in external RAM
+ *
+ * For large buffers such as frame buffers, which are usually moved by DMA, so
+ * each block is rounded up to MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT. Blocks
+ * must not be used before the target has mapped the external RAM.
+ */
+#define MBED_EXTRAM_POOL_DEFINE(name, block_size, count) \
+    MBED_MEM_POOL_DEFINE_IN(name, block_size, count, MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT, MBED_EXTRAM_BSS, MBED_MEM_REGION_EXTRAM)
+
+/**
+ * Allocate a block
+ *
+ * @param pool Pool to allocate from
+ * @return Block of pool->block_size bytes, or NULL if the pool is exhausted
+ */
+void *mbed_mem_pool_alloc(mbed_mem_pool_t *pool);
+
+/**
+ * Free a block
+ *
+ * @param pool  Pool the block was allocated from
+ * @param block Block to free, NULL is ignored
+ */
+void mbed_mem_pool_free(mbed_mem_pool_t *pool, void *block);
+
+/**
+ * Get the region of a pool
+ *
+ * @param pool Pool
+ * @return Region of the storage
+ */
+mbed_mem_region_t mbed_mem_pool_region(const mbed_mem_pool_t *pool);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_MEM_POOL_H
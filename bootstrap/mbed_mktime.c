@@ -0,0 +1,154 @@
+/* Copyright (c) 2017-2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_mktime.h"
+#include <stdint.h>
+
+#define SECONDS_PER_DAY 86400UL
+
+/* Days from the 1st of January 1968, the leap year before the epoch, to the epoch */
+#define DAYS_1968_TO_EPOCH  731UL
+
+/* Days of a cycle of four years, the first one a leap year */
+#define DAYS_PER_4_YEARS    1461UL
+
+/* Days from the epoch to the 1st of March 2100, the day after the 28th of
+ * February 2100 with full leap year support, the 29th with partial support.
+ */
+#define DAYS_EPOCH_TO_MARCH_2100  47541UL
+
+/* Lowest and highest value of tm_year */
+#define FIRST_YEAR  70
+#define LAST_YEAR   206
+
+/*
+ * Days elapsed in the year before the first day of a month. The first index
+ * is the leap year status of the year.
+ */
+static const uint16_t days_before_month[2][12] = {
+    { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 },
+    { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 }
+};
+
+bool _rtc_is_leap_year(int year, rtc_leap_year_support_t leap_year_support)
+{
+    /*
+     * The values manipulated by this algorithm lie in the range [70 : 206],
+     * where the Gregorian rule reduces to year % 4, with the exception of 200:
+     * 2100 is a leap year only for RTCs with partial leap year support.
+     */
+    if (leap_year_support == RTC_FULL_LEAP_YEAR_SUPPORT && year == 200) {
+        return false;
+    }
+
+    return (year % 4) ? false : true;
+}
+
+bool _rtc_maketime(const struct tm *time, time_t *seconds, rtc_leap_year_support_t leap_year_support)
+{
+    if (seconds == NULL || time == NULL) {
+        return false;
+    }
+
+    if ((time->tm_year < FIRST_YEAR) || (time->tm_year > LAST_YEAR) ||
+            (time->tm_mon < 0) || (time->tm_mon > 11)) {
+        return false;
+    }
+
+    const uint32_t years = (uint32_t)(time->tm_year - FIRST_YEAR);
+    const bool leap = _rtc_is_leap_year(time->tm_year, leap_year_support);
+
+    /* Leap years from 1972 up to the year before, in 1968-based cycles of four years */
+    uint32_t leap_days = (years + 1) / 4;
+    if (leap_year_support == RTC_FULL_LEAP_YEAR_SUPPORT && time->tm_year > 200) {
+        leap_days--;
+    }
+
+    const uint32_t days = years * 365 + leap_days + days_before_month[leap][time->tm_mon] + (uint32_t)(time->tm_mday - 1);
+    const uint64_t result = (uint64_t)days * SECONDS_PER_DAY + (uint32_t)time->tm_hour * 3600UL +
+                            (uint32_t)time->tm_min * 60UL + (uint32_t)time->tm_sec;
+
+    /* The calendar time must be representable as a 32-bit timestamp */
+    if (result > UINT32_MAX) {
+        return false;
+    }
+
+    *seconds = (time_t)result;
+
+    return true;
+}
+
+bool _rtc_localtime(time_t timestamp, struct tm *time_info, rtc_leap_year_support_t leap_year_support)
+{
+    if (time_info == NULL) {
+        return false;
+    }
+
+    if ((timestamp < 0) || ((uint64_t)timestamp > UINT32_MAX)) {
+        return false;
+    }
+
+    uint32_t seconds = (uint32_t)timestamp;
+
+    time_info->tm_sec = seconds % 60;
+    seconds = seconds / 60;   // timestamp in minutes
+    time_info->tm_min = seconds % 60;
+    seconds = seconds / 60;  // timestamp in hours
+    time_info->tm_hour = seconds % 24;
+    uint32_t days = seconds / 24;
+
+    /* The first of January 1970 was a Thursday */
+    time_info->tm_wday = (days + 4) % 7;
+
+    /* Count the days as an RTC treating every fourth year as a leap year, for
+     * which the years are cycles of four years from 1968. With full leap year
+     * support, there is no 29th of February 2100 to count.
+     */
+    if (leap_year_support == RTC_FULL_LEAP_YEAR_SUPPORT && days >= DAYS_EPOCH_TO_MARCH_2100) {
+        days++;
+    }
+    days += DAYS_1968_TO_EPOCH;
+
+    const uint32_t cycles = days / DAYS_PER_4_YEARS;
+    uint32_t yday = days % DAYS_PER_4_YEARS;
+    uint32_t year_of_cycle = 0;
+    if (yday >= 366) {
+        year_of_cycle = (yday - 1) / 365;
+        yday -= 366 + (year_of_cycle - 1) * 365;
+    }
+
+    time_info->tm_year = 68 + cycles * 4 + year_of_cycle;
+
+    const bool leap = _rtc_is_leap_year(time_info->tm_year, leap_year_support);
+
+    /* The 29th of February 2100 was counted above, and is the 1st of March */
+    if (leap_year_support == RTC_FULL_LEAP_YEAR_SUPPORT && time_info->tm_year == 200 && yday > 59) {
+        yday--;
+    }
+    time_info->tm_yday = yday;
+
+    /* Estimate the month from the average month length, then correct it by
+     * at most one with the table.
+     */
+    uint32_t month = yday / 31;
+    if (month < 11 && yday >= days_before_month[leap][month + 1]) {
+        month++;
+    }
+    time_info->tm_mon = month;
+    time_info->tm_mday = yday - days_before_month[leap][month] + 1;
+
+    return true;
+}
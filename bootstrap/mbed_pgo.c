@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_pgo.h"
+
+#if MBED_PGO_GENERATE
+
+#include <gcov.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Provided by the linker for the section of the gcov_info pointers */
+extern const struct gcov_info *const __start_mbed_gcov_info[];
+extern const struct gcov_info *const __stop_mbed_gcov_info[];
+
+static char pgo_line[MBED_PGO_LINE_LENGTH + 1];
+static unsigned pgo_line_length;
+
+static void pgo_flush(void)
+{
+    if (pgo_line_length) {
+        pgo_line[pgo_line_length] = '\0';
+        printf("#pgo %s\n", pgo_line);
+        pgo_line_length = 0;
+    }
+}
+
+static void pgo_write(const void *data, unsigned length, void *arg)
+{
+    static const char digits[] = "0123456789abcdef";
+    const unsigned char *bytes = (const unsigned char *)data;
+    (void)arg;
+
+    for (unsigned i = 0; i < length; i++) {
+        pgo_line[pgo_line_length++] = digits[bytes[i] >> 4];
+        pgo_line[pgo_line_length++] = digits[bytes[i] & 0xF];
+        if (pgo_line_length == MBED_PGO_LINE_LENGTH) {
+            pgo_flush();
+        }
+    }
+}
+
+/* The data of a file is sent after its name */
+static void pgo_filename(const char *filename, void *arg)
+{
+    (void)arg;
+    pgo_flush();
+    printf("#pgo file %s\n", filename ? filename : "");
+}
+
+/* Only used to merge counters, which the dump does not do, so nothing is freed */
+static void *pgo_allocate(unsigned length, void *arg)
+{
+    (void)arg;
+    return malloc(length);
+}
+
+void mbed_pgo_dump(void)
+{
+    printf("#pgo begin\n");
+    for (const struct gcov_info *const *info = __start_mbed_gcov_info; info < __stop_mbed_gcov_info; info++) {
+        __gcov_info_to_gcda(*info, pgo_filename, pgo_write, pgo_allocate, NULL);
+    }
+    pgo_flush();
+    printf("#pgo end\n");
+    fflush(stdout);
+}
+
+#endif // MBED_PGO_GENERATE
@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_PGO_H
+#define MBED_PGO_H
+
+/** Set by the PGO build profile in its generate stage */
+#ifndef MBED_PGO_GENERATE
+#define MBED_PGO_GENERATE 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_pgo Profile-guided optimization
+ * Counters of the images instrumented by the PGO build profile
+ *
+ * The counters are sent on the console as the name of each .gcda file,
+ * followed by lines of hexadecimal digits of its content:
+ *
+ *     #pgo begin
+ *     #pgo file /path/to/build/CMakeFiles/app.dir/main.cpp.gcda
+ *     #pgo 67636461...
+ *     #pgo end
+ *
+ * tools/pgo_collect/pgo_collect.py reads them from the serial port, or from a
+ * log of the console, and writes the .gcda files.
+ *
+ * @{
+ */
+
+/** Hexadecimal digits of the file content sent on each line */
+#define MBED_PGO_LINE_LENGTH 64
+
+#if MBED_PGO_GENERATE
+
+/**
+ * Send the counters on the console
+ *
+ * Called on exit. Firmware which does not return from main() calls it at the
+ * end of its workload. The counters keep counting, so calling it again sends
+ * the counts since the start.
+ */
+void mbed_pgo_dump(void);
+
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_PGO_H
@@ -20,7 +20,9 @@
 #include <limits.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
+/* Defaults of the minimal printf options of mbed_lib.json, for builds without the configuration */
 #ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
 #define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
 #endif
@@ -29,10 +31,22 @@
 #define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
 #endif
 
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST 0
+#endif
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST && MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS > 9
+#error "The fast floating point path prints at most 9 decimals"
+#endif
+
 #ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
 #define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
 #endif
 
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE 64
+#endif
+
 /**
  * Check architecture and choose storage data type.
  * On 32 bit machines, the default storage type is 32 bit wide
@@ -63,6 +77,16 @@
  */
 #define PRECISION_DEFAULT (INT_MAX)
 
+/**
+ * Stream output, written with a single fwrite per format call unless it
+ * overflows the buffer.
+ */
+typedef struct {
+    FILE *file;
+    size_t count;
+    char buffer[MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE];
+} mbed_minimal_stream_t;
+
 /**
  * Enum for storing width modifier.
  */
@@ -81,13 +105,28 @@ typedef enum {
 /**
  * Prototypes
  */
-static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream);
-static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream);
-static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper);
-static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream);
-static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream);
+static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, mbed_minimal_stream_t *stream);
+static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, mbed_minimal_stream_t *stream);
+static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, mbed_minimal_stream_t *stream, bool upper);
+static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, mbed_minimal_stream_t *stream);
+static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, mbed_minimal_stream_t *stream);
 
 
+/**
+ * @brief      Write the buffered stream output.
+ *
+ * @param      stream  The stream.
+ *
+ * @return     true if all of it was written.
+ */
+static bool mbed_minimal_flush(mbed_minimal_stream_t *stream)
+{
+    const size_t count = stream->count;
+
+    stream->count = 0;
+    return fwrite(stream->buffer, 1, count, stream->file) == count;
+}
+
 /**
  * @brief      Print a single character, checking for buffer and size overflows.
  *
@@ -96,14 +135,15 @@ static void mbed_minimal_formatted_string_string(char *buffer, size_t length, in
  * @param      result  The current output location.
  * @param[in]  data    The char to be printed.
  */
-static void mbed_minimal_putchar(char *buffer, size_t length, int *result, char data, FILE *stream)
+static void mbed_minimal_putchar(char *buffer, size_t length, int *result, char data, mbed_minimal_stream_t *stream)
 {
     /* only continue if 'result' doesn't overflow */
     if ((*result >= 0) && (*result <= INT_MAX - 1)) {
         if (stream) {
-            if (fputc(data, stream) == EOF) {
+            if (stream->count == sizeof(stream->buffer) && !mbed_minimal_flush(stream)) {
                 *result = EOF;
             } else {
+                stream->buffer[stream->count++] = data;
                 *result += 1;
             }
         } else {
@@ -129,7 +169,7 @@ static void mbed_minimal_putchar(char *buffer, size_t length, int *result, char
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream)
+static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, mbed_minimal_stream_t *stream)
 {
     MBED_UNSIGNED_STORAGE new_value = 0;
 
@@ -148,6 +188,22 @@ static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, in
     mbed_minimal_formatted_string_unsigned(buffer, length, result, new_value, stream);
 }
 
+/**
+ * Decimal digits of 0 to 99, two characters each.
+ */
+static const char digit_pairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
+};
+
 /**
  * @brief      Print unsigned integer.
  *
@@ -156,24 +212,37 @@ static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, in
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream)
+static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, mbed_minimal_stream_t *stream)
 {
     /* treat 0 as a corner case */
     if (value == 0) {
         mbed_minimal_putchar(buffer, length, result, '0', stream);
     } else {
         /* allocate 3 digits per byte */
-        char scratch[sizeof(MBED_UNSIGNED_STORAGE) * 3] = { 0 };
+        char scratch[sizeof(MBED_UNSIGNED_STORAGE) * 3];
 
         size_t index = 0;
 
-        /* write numbers in reverse order to scratch pad */
-        for (; value > 0; index++) {
-            /* use '0' as base and add digit */
-            scratch[index] = '0' + (value % 10);
+        /* write numbers in reverse order to scratch pad, two digits per
+           division as divisions are library calls on some cores */
+        for (; value > UINT32_MAX; index += 2) {
+            unsigned int pair = (value % 100) * 2;
+            value = value / 100;
+            scratch[index] = digit_pairs[pair + 1];
+            scratch[index + 1] = digit_pairs[pair];
+        }
 
-            /* shift value one decimal position */
-            value = value / 10;
+        /* the rest fits in 32 bits, avoid 64 bit divisions */
+        uint32_t short_value = value;
+
+        for (; short_value >= 10; index += 2) {
+            unsigned int pair = (short_value % 100) * 2;
+            short_value = short_value / 100;
+            scratch[index] = digit_pairs[pair + 1];
+            scratch[index + 1] = digit_pairs[pair];
+        }
+        if (short_value > 0) {
+            scratch[index++] = '0' + short_value;
         }
 
         /* write scratch pad to buffer or output */
@@ -192,7 +261,7 @@ static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length,
  * @param[in]  value   The value to be printed.
  * @param      upper   Flag to print the hexadecimal in upper or lower case.
  */
-static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper)
+static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, mbed_minimal_stream_t *stream, bool upper)
 {
     bool print_leading_zero = false;
 
@@ -232,7 +301,7 @@ static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t lengt
  * @param      result  The current output location.
  * @param[in]  value   The pointer to be printed.
  */
-static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream)
+static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, mbed_minimal_stream_t *stream)
 {
     /* write leading 0x */
     mbed_minimal_putchar(buffer, length, result, '0', stream);
@@ -251,7 +320,7 @@ static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t leng
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_double(char *buffer, size_t length, int *result, double value, FILE *stream)
+static void mbed_minimal_formatted_string_double(char *buffer, size_t length, int *result, double value, mbed_minimal_stream_t *stream)
 {
     /* get integer part */
     MBED_SIGNED_STORAGE integer = value;
@@ -303,6 +372,117 @@ static void mbed_minimal_formatted_string_double(char *buffer, size_t length, in
     /* write decimal part */
     mbed_minimal_formatted_string_unsigned(buffer, length, result, decimal, stream);
 }
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST
+/**
+ * Powers of ten up to the largest number of decimals of the fast path.
+ */
+static const uint32_t powers_of_ten[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * @brief      Write double with integer arithmetic only.
+ *
+ * The value is rounded to the 24 bit mantissa of a float, and its integer
+ * and decimal parts are taken from its IEEE 754 representation, so no
+ * software emulated double arithmetic is needed. Values of 2^31 and above,
+ * infinities and NaNs are written by the double path.
+ *
+ * @param      buffer     The buffer to store output (NULL for stdout).
+ * @param[in]  length     The length of the buffer.
+ * @param      result     The current output location.
+ * @param[in]  value      The value to be printed.
+ * @param[in]  precision  The number of decimals, up to 9, the configured
+ *                        maximum otherwise.
+ */
+static void mbed_minimal_formatted_string_float(char *buffer, size_t length, int *result, double value, int precision, mbed_minimal_stream_t *stream)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    /* round the 53 bit mantissa to 24 bits, to nearest even as a conversion
+       to float does, subnormals are taken as 0 */
+    int exponent = (int)((bits >> 52) & 0x7FF) - 1023;
+    uint32_t mantissa = 0;
+
+    if (exponent > -1023) {
+        const uint64_t mantissa53 = (bits & 0xFFFFFFFFFFFFFULL) | (1ULL << 52);
+        mantissa = (uint32_t)(mantissa53 >> 29);
+        if (((mantissa53 >> 28) & 1) && ((mantissa53 & 0xFFFFFFFULL) || (mantissa & 1))) {
+            mantissa++;
+        }
+        if (mantissa == (1UL << 24)) {
+            mantissa >>= 1;
+            exponent++;
+        }
+    }
+
+    if (exponent >= 31) {
+        mbed_minimal_formatted_string_double(buffer, length, result, value, stream);
+        return;
+    }
+
+    const int decimals = ((precision >= 0) && (precision <= 9)) ? precision : MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS;
+    const uint32_t scale = powers_of_ten[decimals];
+
+    /* the value is mantissa * 2^-shift */
+    const int shift = 23 - exponent;
+    uint32_t integer;
+    uint32_t decimal = 0;
+
+    if (shift <= 0) {
+        integer = mantissa << -shift;
+    } else {
+        uint32_t fraction = mantissa;
+
+        if (shift < 24) {
+            integer = mantissa >> shift;
+            fraction &= (1UL << shift) - 1;
+        } else {
+            integer = 0;
+        }
+
+        /* fraction * scale is below 2^54, rounded to nearest even as the
+           standard printf does */
+        if (shift < 64) {
+            const uint64_t scaled = (uint64_t)fraction * scale;
+            const uint64_t half = 1ULL << (shift - 1);
+            const uint64_t remainder = scaled & ((half << 1) - 1);
+            decimal = (uint32_t)(scaled >> shift);
+            if ((remainder > half) || ((remainder == half) && ((decimals ? decimal : integer) & 1))) {
+                decimal++;
+            }
+        }
+        if (decimal >= scale) {
+            integer++;
+            decimal -= scale;
+        }
+    }
+
+    if (bits >> 63) {
+        mbed_minimal_putchar(buffer, length, result, '-', stream);
+    }
+
+    mbed_minimal_formatted_string_unsigned(buffer, length, result, integer, stream);
+
+    if (decimals > 0) {
+        char scratch[9];
+
+        mbed_minimal_putchar(buffer, length, result, '.', stream);
+
+        /* write the decimals with their leading zeros */
+        for (int index = decimals - 1; index >= 0; index--) {
+            scratch[index] = '0' + (decimal % 10);
+            decimal /= 10;
+        }
+        for (int index = 0; index < decimals; index++) {
+            mbed_minimal_putchar(buffer, length, result, scratch[index], stream);
+        }
+    }
+}
+#endif
 #endif
 
 /**
@@ -314,7 +494,7 @@ static void mbed_minimal_formatted_string_double(char *buffer, size_t length, in
  * @param[in]  value      The string to be printed.
  * @param[in]  precision  The maximum number of characters to be printed.
  */
-static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream)
+static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, mbed_minimal_stream_t *stream)
 {
     while ((*string != '\0') && (precision)) {
         mbed_minimal_putchar(buffer, length, result, *string, stream);
@@ -333,10 +513,18 @@ static void mbed_minimal_formatted_string_string(char *buffer, size_t length, in
  *
  * @return     Number of characters written.
  */
-int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream)
+int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *file)
 {
     int result = 0;
     bool empty_buffer = false;
+    mbed_minimal_stream_t output;
+    mbed_minimal_stream_t *stream = NULL;
+
+    if (file) {
+        output.file = file;
+        output.count = 0;
+        stream = &output;
+    }
 
     /* ensure that function wasn't called with an empty buffer, or with or with
        a buffer size that is larger than the maximum 'int' value, or with
@@ -581,7 +769,11 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
                     double value = va_arg(arguments, double);
                     index = next_index;
 
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST
+                    mbed_minimal_formatted_string_float(buffer, length, &result, value, precision, stream);
+#else
                     mbed_minimal_formatted_string_double(buffer, length, &result, value, stream);
+#endif
                 }
 #endif
                 /* character */
@@ -622,6 +814,10 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
             }
         }
 
+        if (stream && result >= 0 && !mbed_minimal_flush(stream)) {
+            result = EOF;
+        }
+
         if (buffer && !empty_buffer) {
             /* NULL-terminate the buffer no matter what. We use '<=' to compare instead of '<'
                because we know that we initially reserved space for '\0' by decrementing length */
@@ -636,3 +832,32 @@ int mbed_minimal_formatted_string(char *buffer, size_t length, const char *forma
     return result;
 }
 
+void mbed_minimal_format_char(char *buffer, size_t length, int *result, char value)
+{
+    mbed_minimal_putchar(buffer, length, result, value, NULL);
+}
+
+void mbed_minimal_format_signed(char *buffer, size_t length, int *result, intmax_t value)
+{
+    mbed_minimal_formatted_string_signed(buffer, length, result, value, NULL);
+}
+
+void mbed_minimal_format_unsigned(char *buffer, size_t length, int *result, uintmax_t value)
+{
+    mbed_minimal_formatted_string_unsigned(buffer, length, result, value, NULL);
+}
+
+void mbed_minimal_format_hexadecimal(char *buffer, size_t length, int *result, uintmax_t value, bool upper)
+{
+    mbed_minimal_formatted_string_hexadecimal(buffer, length, result, value, NULL, upper);
+}
+
+void mbed_minimal_format_pointer(char *buffer, size_t length, int *result, const void *value)
+{
+    mbed_minimal_formatted_string_void_pointer(buffer, length, result, value, NULL);
+}
+
+void mbed_minimal_format_string(char *buffer, size_t length, int *result, const char *string, size_t precision)
+{
+    mbed_minimal_formatted_string_string(buffer, length, result, string, precision, NULL);
+}
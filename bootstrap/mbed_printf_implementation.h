@@ -19,6 +19,30 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream);
+
+/* Formatters of single conversions, used by the format strings parsed at
+ * compile time in mbed_format.h. They write to the buffer while 'result' is
+ * below 'length', and add the number of characters of the conversion to
+ * 'result'. 64-bit values are truncated when
+ * MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT is disabled.
+ */
+void mbed_minimal_format_char(char *buffer, size_t length, int *result, char value);
+void mbed_minimal_format_signed(char *buffer, size_t length, int *result, intmax_t value);
+void mbed_minimal_format_unsigned(char *buffer, size_t length, int *result, uintmax_t value);
+void mbed_minimal_format_hexadecimal(char *buffer, size_t length, int *result, uintmax_t value, bool upper);
+void mbed_minimal_format_pointer(char *buffer, size_t length, int *result, const void *value);
+void mbed_minimal_format_string(char *buffer, size_t length, int *result, const char *string, size_t precision);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
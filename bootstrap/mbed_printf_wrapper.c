@@ -17,6 +17,7 @@
 #ifdef MBED_MINIMAL_PRINTF
 
 #include "mbed_printf_implementation.h"
+#include "mbed_toolchain.h"
 
 #include <limits.h>
 
@@ -29,7 +30,7 @@
 #warning "This compiler is not yet supported."
 #endif
 
-int PREFIX(printf)(const char *format, ...)
+MBED_USED int PREFIX(printf)(const char *format, ...)
 {
     va_list arguments;
     va_start(arguments, format);
@@ -39,7 +40,7 @@ int PREFIX(printf)(const char *format, ...)
     return result;
 }
 
-int PREFIX(sprintf)(char *buffer, const char *format, ...)
+MBED_USED int PREFIX(sprintf)(char *buffer, const char *format, ...)
 {
     va_list arguments;
     va_start(arguments, format);
@@ -49,7 +50,7 @@ int PREFIX(sprintf)(char *buffer, const char *format, ...)
     return result;
 }
 
-int PREFIX(snprintf)(char *buffer, size_t length, const char *format, ...)
+MBED_USED int PREFIX(snprintf)(char *buffer, size_t length, const char *format, ...)
 {
     va_list arguments;
     va_start(arguments, format);
@@ -59,22 +60,22 @@ int PREFIX(snprintf)(char *buffer, size_t length, const char *format, ...)
     return result;
 }
 
-int PREFIX(vprintf)(const char *format, va_list arguments)
+MBED_USED int PREFIX(vprintf)(const char *format, va_list arguments)
 {
     return mbed_minimal_formatted_string(NULL, LONG_MAX, format, arguments, stdout);
 }
 
-int PREFIX(vsprintf)(char *buffer, const char *format, va_list arguments)
+MBED_USED int PREFIX(vsprintf)(char *buffer, const char *format, va_list arguments)
 {
     return mbed_minimal_formatted_string(buffer, LONG_MAX, format, arguments, NULL);
 }
 
-int PREFIX(vsnprintf)(char *buffer, size_t length, const char *format, va_list arguments)
+MBED_USED int PREFIX(vsnprintf)(char *buffer, size_t length, const char *format, va_list arguments)
 {
     return mbed_minimal_formatted_string(buffer, length, format, arguments, NULL);
 }
 
-int PREFIX(fprintf)(FILE *stream, const char *format, ...)
+MBED_USED int PREFIX(fprintf)(FILE *stream, const char *format, ...)
 {
     va_list arguments;
     va_start(arguments, format);
@@ -84,7 +85,7 @@ int PREFIX(fprintf)(FILE *stream, const char *format, ...)
     return result;
 }
 
-int PREFIX(vfprintf)(FILE *stream, const char *format, va_list arguments)
+MBED_USED int PREFIX(vfprintf)(FILE *stream, const char *format, va_list arguments)
 {
     return mbed_minimal_formatted_string(NULL, LONG_MAX, format, arguments, stream);
 }
@@ -0,0 +1,126 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_scatter_load.h"
+#include "mbed_toolchain.h"
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+
+typedef struct {
+    const uint32_t *src;
+    uint32_t *dst;
+    uint32_t words;
+} copy_table_entry_t;
+
+typedef struct {
+    uint32_t *dst;
+    uint32_t words;
+} zero_table_entry_t;
+
+extern const copy_table_entry_t __copy_table_start__[];
+extern const copy_table_entry_t __copy_table_end__[];
+extern const zero_table_entry_t __zero_table_start__[];
+extern const zero_table_entry_t __zero_table_end__[];
+extern uint32_t __noinit_start__[] __attribute__((weak));
+extern uint32_t __noinit_end__[] __attribute__((weak));
+
+MBED_WEAK bool mbed_scatter_load_dma_start(uint32_t *dst, const uint32_t *src, uint32_t words)
+{
+    (void)dst;
+    (void)src;
+    (void)words;
+    return false;
+}
+
+MBED_WEAK void mbed_scatter_load_dma_wait(void)
+{
+}
+
+static void copy_words(uint32_t *dst, const uint32_t *src, uint32_t words)
+{
+#if defined(__arm__)
+    // r4-r7 are low registers, so this also assembles for ARMv6-M
+    __asm volatile(
+        "1:                     \n"
+        "    cmp   %[n], #4     \n"
+        "    blo   2f           \n"
+        "    ldmia %[s]!, {r4-r7} \n"
+        "    stmia %[d]!, {r4-r7} \n"
+        "    subs  %[n], #4     \n"
+        "    b     1b           \n"
+        "2:                     \n"
+        : [s] "+l"(src), [d] "+l"(dst), [n] "+l"(words)
+        :
+        : "r4", "r5", "r6", "r7", "cc", "memory");
+#endif
+    while (words--) {
+        *dst++ = *src++;
+    }
+}
+
+static void zero_words(uint32_t *dst, uint32_t words)
+{
+#if defined(__arm__)
+    __asm volatile(
+        "    movs  r4, #0       \n"
+        "    movs  r5, #0       \n"
+        "    movs  r6, #0       \n"
+        "    movs  r7, #0       \n"
+        "1:                     \n"
+        "    cmp   %[n], #4     \n"
+        "    blo   2f           \n"
+        "    stmia %[d]!, {r4-r7} \n"
+        "    subs  %[n], #4     \n"
+        "    b     1b           \n"
+        "2:                     \n"
+        : [d] "+l"(dst), [n] "+l"(words)
+        :
+        : "r4", "r5", "r6", "r7", "cc", "memory");
+#endif
+    while (words--) {
+        *dst++ = 0;
+    }
+}
+
+void mbed_scatter_load(void)
+{
+    bool dma_pending = false;
+
+    for (const copy_table_entry_t *entry = __copy_table_start__; entry < __copy_table_end__; entry++) {
+        if (!dma_pending && entry->words * sizeof(uint32_t) >= MBED_CONF_PLATFORM_SCATTER_LOAD_DMA_THRESHOLD &&
+                mbed_scatter_load_dma_start(entry->dst, entry->src, entry->words)) {
+            dma_pending = true;
+            continue;
+        }
+        copy_words(entry->dst, entry->src, entry->words);
+    }
+
+    for (const zero_table_entry_t *entry = __zero_table_start__; entry < __zero_table_end__; entry++) {
+        uint32_t *start = entry->dst;
+        uint32_t *end = entry->dst + entry->words;
+        if (__noinit_start__ && __noinit_start__ >= start && __noinit_end__ <= end) {
+            zero_words(start, __noinit_start__ - start);
+            start = __noinit_end__;
+        }
+        zero_words(start, end - start);
+    }
+
+    if (dma_pending) {
+        mbed_scatter_load_dma_wait();
+    }
+}
+
+#endif // defined(__GNUC__) && !defined(__ARMCC_VERSION)
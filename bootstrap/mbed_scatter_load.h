@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_SCATTER_LOAD_H
+#define MBED_SCATTER_LOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Smallest copy table region, in bytes, offered to ::mbed_scatter_load_dma_start */
+#ifndef MBED_CONF_PLATFORM_SCATTER_LOAD_DMA_THRESHOLD
+#define MBED_CONF_PLATFORM_SCATTER_LOAD_DMA_THRESHOLD 1024
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup scatter_load RAM initialization
+ * Initialization of .data and .bss for GCC_ARM startup code
+ *
+ * The regions come from the CMSIS-Core linker script tables:
+ * - `__copy_table_start__` to `__copy_table_end__`: entries of
+ *   {load address, execution address, size in words}
+ * - `__zero_table_start__` to `__zero_table_end__`: entries of
+ *   {address, size in words}
+ *
+ * The range from `__noinit_start__` to `__noinit_end__`, when the linker
+ * script defines these symbols, is left as it is inside the zeroed regions.
+ *
+ * The Arm toolchain initializes RAM with its own scatter-loading in `__main`.
+ *
+ * @{
+ */
+
+/**
+ * Initialize .data and .bss
+ *
+ * Called by the target reset handler, before any C code that uses RAM.
+ * Copies and zeroes with 4-word load/store multiple bursts. A copy region of
+ * at least MBED_CONF_PLATFORM_SCATTER_LOAD_DMA_THRESHOLD bytes is offered to
+ * the target's DMA so it is copied while the CPU zeroes.
+ */
+void mbed_scatter_load(void);
+
+/**
+ * Start copying a region with DMA
+ *
+ * Runs before .data and .bss are initialized so it must not use RAM variables.
+ * The default implementation returns false.
+ *
+ * @param dst   Word aligned destination
+ * @param src   Word aligned source
+ * @param words Size in words
+ * @return true if the transfer was started, false to copy with the CPU
+ */
+bool mbed_scatter_load_dma_start(uint32_t *dst, const uint32_t *src, uint32_t words);
+
+/**
+ * Wait for the transfer started by ::mbed_scatter_load_dma_start to complete
+ */
+void mbed_scatter_load_dma_wait(void);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_SCATTER_LOAD_H
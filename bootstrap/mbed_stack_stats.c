@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_stack_stats.h"
+
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+
+#include "cmsis.h"
+#include "mbed_boot.h"
+#include "mbed_critical.h"
+
+void mbed_stack_paint(void)
+{
+    core_util_critical_section_enter();
+
+    // Volatile so that the loop is not turned into a memset() call, whose
+    // frame would be below the stack pointer
+    volatile uint32_t *word = (volatile uint32_t *)mbed_stack_isr_start;
+    volatile uint32_t *const end = (volatile uint32_t *)__get_MSP();
+    while (word < end) {
+        *word++ = MBED_STACK_PAINT_PATTERN;
+    }
+
+    core_util_critical_section_exit();
+}
+
+uint32_t mbed_stack_high_water(void)
+{
+    const uint32_t *word = (const uint32_t *)mbed_stack_isr_start;
+    const uint32_t *const end = (const uint32_t *)(mbed_stack_isr_start + mbed_stack_isr_size);
+
+    while ((word < end) && (*word == MBED_STACK_PAINT_PATTERN)) {
+        word++;
+    }
+
+    return (uint32_t)((const unsigned char *)end - (const unsigned char *)word);
+}
+
+#endif // MBED_CONF_PLATFORM_STACK_STATS_ENABLED
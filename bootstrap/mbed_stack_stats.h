@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_STACK_STATS_H
+#define MBED_STACK_STATS_H
+
+#include <stdint.h>
+
+/** Paint the interrupt stack at boot to measure its usage */
+#ifndef MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+#define MBED_CONF_PLATFORM_STACK_STATS_ENABLED 0
+#endif
+
+/** Word the unused part of the stack is painted with */
+#define MBED_STACK_PAINT_PATTERN 0xE25A2EA5UL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup stack_stats Stack statistics
+ * High-water mark of the interrupt stack
+ *
+ * The part of the stack between mbed_stack_isr_start and the stack pointer is
+ * painted with MBED_STACK_PAINT_PATTERN at boot. The high-water mark is the
+ * size of the stack minus the painted words that are left at its bottom, so
+ * it is the most the stack was used since it was painted.
+ *
+ * Without an RTOS, the interrupt stack is also the stack of main(). Painting
+ * again with ::mbed_stack_paint measures the usage from then on, of a test
+ * case for instance.
+ *
+ * Enabled by MBED_CONF_PLATFORM_STACK_STATS_ENABLED.
+ *
+ * @{
+ */
+
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+
+/**
+ * Paint the unused part of the interrupt stack
+ *
+ * Paints below the current main stack pointer, in a critical section so that
+ * interrupt handlers using the stack meanwhile are not overwritten. Called by
+ * the boot sequence.
+ */
+void mbed_stack_paint(void);
+
+/**
+ * Get the high-water mark of the interrupt stack
+ *
+ * @return The largest number of bytes used since the stack was painted
+ */
+uint32_t mbed_stack_high_water(void);
+
+#define MBED_STACK_PAINT() mbed_stack_paint()
+
+#else
+
+#define MBED_STACK_PAINT() ((void)0)
+
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_STACK_STATS_H
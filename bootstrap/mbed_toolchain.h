@@ -455,6 +455,138 @@
 #endif
 #endif
 
+/** MBED_RAMFUNC
+ *  Declare a function to be executed from RAM, clear of flash wait states.
+ *
+ *  With MBED_CONF_PLATFORM_RAMFUNC_ENABLED, the function is placed in the
+ *  `.ramfunc` section, which the linker script places in RAM (or TCM) and
+ *  copies along with `.data` at startup. Otherwise this expands to nothing
+ *  and the function stays in flash.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_RAMFUNC void foo() {
+ *
+ *  }
+ *  @endcode
+ */
+#ifndef MBED_RAMFUNC
+#if defined(MBED_CONF_PLATFORM_RAMFUNC_ENABLED) && MBED_CONF_PLATFORM_RAMFUNC_ENABLED
+#if defined(__GNUC__) || defined(__clang__)
+#define MBED_RAMFUNC __attribute__((section(".ramfunc")))
+#elif defined(__ICCARM__)
+#define MBED_RAMFUNC __ramfunc
+#else
+#define MBED_RAMFUNC
+#endif
+#else
+#define MBED_RAMFUNC
+#endif
+#endif
+
+/** MBED_DTCM_DATA and MBED_DTCM_BSS
+ *  Declare a variable to be placed in the data tightly coupled memory.
+ *
+ *  Use MBED_DTCM_DATA for initialized variables, copied at startup, and
+ *  MBED_DTCM_BSS for zero-initialized ones. The variables are placed in the
+ *  `.dtcm_data` and `.dtcm_bss` sections when the target linker script
+ *  provides them, as indicated by MBED_CONF_TARGET_DTCM_SECTIONS. Otherwise
+ *  they stay in the default RAM.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_DTCM_DATA static uint32_t gain = 3;
+ *  MBED_DTCM_BSS static uint32_t samples[64];
+ *  @endcode
+ */
+#ifndef MBED_DTCM_DATA
+#if defined(MBED_CONF_TARGET_DTCM_SECTIONS) && MBED_CONF_TARGET_DTCM_SECTIONS
+#define MBED_DTCM_DATA MBED_SECTION(".dtcm_data")
+#else
+#define MBED_DTCM_DATA
+#endif
+#endif
+
+#ifndef MBED_DTCM_BSS
+#if defined(MBED_CONF_TARGET_DTCM_SECTIONS) && MBED_CONF_TARGET_DTCM_SECTIONS
+#define MBED_DTCM_BSS MBED_SECTION(".dtcm_bss")
+#else
+#define MBED_DTCM_BSS
+#endif
+#endif
+
+/** MBED_DMA_BUFFER
+ *  Declare a zero-initialized buffer to be accessed by DMA.
+ *
+ *  The buffer is aligned on MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT bytes, the
+ *  data cache line size, so cache maintenance on it doesn't affect other
+ *  variables. It is placed in the `.dma_buffer` section when the target
+ *  linker script provides it, as indicated by
+ *  MBED_CONF_TARGET_DMA_BUFFER_SECTION, for example in a non-cacheable SRAM
+ *  that the DMA controllers can reach.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_DMA_BUFFER static uint8_t rx_buffer[256];
+ *  @endcode
+ */
+#ifndef MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT
+#define MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT 32
+#endif
+
+#ifndef MBED_DMA_BUFFER
+#if defined(MBED_CONF_TARGET_DMA_BUFFER_SECTION) && MBED_CONF_TARGET_DMA_BUFFER_SECTION
+#define MBED_DMA_BUFFER MBED_SECTION(".dma_buffer") MBED_ALIGN(MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT)
+#else
+#define MBED_DMA_BUFFER MBED_ALIGN(MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT)
+#endif
+#endif
+
+/** MBED_EXTRAM_BSS
+ *  Declare a buffer to be placed in external RAM, such as an OSPI PSRAM.
+ *
+ *  The buffer is placed in the `.extram_bss` section when the target linker
+ *  script provides it, as indicated by MBED_CONF_TARGET_EXTRAM_SECTION.
+ *  Otherwise it stays in the default RAM. The startup code neither copies nor
+ *  zeroes the external RAM, which is only usable once the target has mapped
+ *  it, so the buffer must be initialized before it is used.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_EXTRAM_BSS static uint16_t frame_buffer[480 * 272];
+ *  @endcode
+ */
+#ifndef MBED_EXTRAM_BSS
+#if defined(MBED_CONF_TARGET_EXTRAM_SECTION) && MBED_CONF_TARGET_EXTRAM_SECTION
+#define MBED_EXTRAM_BSS MBED_SECTION(".extram_bss") MBED_ALIGN(MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT)
+#else
+#define MBED_EXTRAM_BSS MBED_ALIGN(MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT)
+#endif
+#endif
+
+/** MBED_NOINIT
+ *  Declare a variable which keeps its value over a reset.
+ *
+ *  The variable is placed in the `.noinit` section, which the startup code
+ *  neither copies nor zeroes when the linker script places it between
+ *  `__noinit_start__` and `__noinit_end__`. Its value is undefined after a
+ *  power-on, so it should be checked, for example with a magic number and a
+ *  CRC, before it is used.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_NOINIT static uint32_t boot_count;
+ *  @endcode
+ */
+#ifndef MBED_NOINIT
+#define MBED_NOINIT MBED_SECTION(".noinit")
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
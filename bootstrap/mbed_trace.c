@@ -25,6 +25,18 @@
 
 #include "mbed_trace.h"
 
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1 || MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+#define MBED_TRACE_RING 1
+#include "mbed_atomic.h"
+#include "mbed_critical.h"
+#else
+#define MBED_TRACE_RING 0
+#endif
+
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+#include "mbed_critical.h"
+#endif
+
 #if defined(YOTTA_CFG_MBED_TRACE_MEM)
 #define MBED_TRACE_MEM_INCLUDE      YOTTA_CFG_MBED_TRACE_MEM_INCLUDE
 #define MBED_TRACE_MEM_ALLOC        YOTTA_CFG_MBED_TRACE_MEM_ALLOC
@@ -79,6 +91,23 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** max group names in a filter, one character names separated by commas */
+#define TRACE_FILTER_MAX_GROUPS           ((DEFAULT_TRACE_FILTER_LENGTH + 1) / 2)
+
+/** default max binary trace record size in bytes, multiple of 4 */
+#ifdef MBED_TRACE_BINARY_RECORD_LENGTH
+#define DEFAULT_TRACE_BINARY_RECORD_LENGTH MBED_TRACE_BINARY_RECORD_LENGTH
+#else
+#define DEFAULT_TRACE_BINARY_RECORD_LENGTH 128
+#endif
+
+/** default max trace line size in bytes when tracing from interrupt with output buffer */
+#ifdef MBED_TRACE_ISR_LINE_LENGTH
+#define DEFAULT_TRACE_ISR_LINE_LENGTH     MBED_TRACE_ISR_LINE_LENGTH
+#else
+#define DEFAULT_TRACE_ISR_LINE_LENGTH     128
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -87,9 +116,45 @@
 #endif
 
 /** default print function, just redirect str to printf */
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 0
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
+#endif
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_mutex_release_all(void);
+
+#if MBED_TRACE_RING
+/** Lock-free ring buffer of variable length entries, many writers and a single reader.
+ *  Every entry starts with a header word, which is written last when the entry is complete.
+ *  Entries never wrap; a padding entry fills the end of the buffer instead.
+ *  The reader clears consumed entries, so free space is always zero. */
+typedef struct trace_ring_s {
+    /** buffer, NULL when not in use */
+    uint8_t *buffer;
+    /** buffer size in bytes, power of two */
+    uint32_t size;
+    /** position reserved by writers, free running */
+    uint32_t head;
+    /** position of the reader, free running */
+    uint32_t tail;
+    /** number of entries dropped because the buffer was full */
+    uint32_t dropped;
+} trace_ring_t;
+#endif
+
+/** Filter compiled from the filter string when it is set.
+ *  Group names up to 4 characters are packed in a word and matched by comparing words. */
+typedef struct trace_filter_s {
+    /** bit set for the hash of each packed group name */
+    uint32_t hashes;
+    /** packed group names */
+    uint32_t groups[TRACE_FILTER_MAX_GROUPS];
+    /** number of packed group names */
+    uint8_t count;
+    /** the filter string has group names longer than 4 characters */
+    bool long_names;
+} trace_filter_t;
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -98,6 +163,10 @@ typedef struct trace_s {
     char *filters_exclude;
     /** include filters list, related group name */
     char *filters_include;
+    /** compiled exclude filters */
+    trace_filter_t exclude;
+    /** compiled include filters */
+    trace_filter_t include;
     /** Filters length */
     int filters_length;
     /** trace line */
@@ -117,6 +186,8 @@ typedef struct trace_s {
     char *(*suffix_f)(void);
     /** print out function. Can be redirect to flash for example. */
     void (*printf)(const char *);
+    /** print out function, which gets the trace level too. Used instead of printf when set. */
+    void (*level_printf)(uint8_t, const char *);
     /** print out function for TRACE_LEVEL_CMD */
     void (*cmd_printf)(const char *);
     /** mutex wait function which can be called to lock against a mutex. */
@@ -125,6 +196,16 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+    /** binary mode records, binary mode is off when there is no buffer */
+    trace_ring_t binary;
+    /** timestamp function, which is used to put time to binary records */
+    uint32_t (*timestamp_f)(void);
+#endif
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+    /** formatted trace lines waiting for the print function */
+    trace_ring_t output;
+#endif
 } trace_t;
 
 static trace_t m_trace = {
@@ -140,14 +221,41 @@ static trace_t m_trace = {
     .prefix_f = 0,
     .suffix_f = 0,
     .printf  = mbed_trace_default_print,
+    .level_printf = 0,
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
     .mutex_lock_count = 0
 };
 
+uint8_t mbed_trace_active_levels = (DEFAULT_TRACE_CONFIG) & TRACE_MASK_LEVEL;
+
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+/* Buffers of the thread context, used under the mutex */
+static char trace_line[DEFAULT_TRACE_LINE_LENGTH];
+static char trace_tmp_data[DEFAULT_TRACE_TMP_LINE_LEN];
+static char trace_filters_exclude[DEFAULT_TRACE_FILTER_LENGTH];
+static char trace_filters_include[DEFAULT_TRACE_FILTER_LENGTH];
+/* Buffers of the interrupt context, which can not wait for the mutex */
+static char trace_isr_line[DEFAULT_TRACE_ISR_LINE_LENGTH];
+static char trace_isr_tmp_data[DEFAULT_TRACE_TMP_LINE_LEN];
+static char *trace_isr_tmp_data_ptr = trace_isr_tmp_data;
+static void mbed_trace_reset_isr_tmp(void);
+#endif
+
 int mbed_trace_init(void)
 {
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+    if (m_trace.line == NULL) {
+        m_trace.line = trace_line;
+    }
+    if (m_trace.tmp_data == NULL) {
+        m_trace.tmp_data = trace_tmp_data;
+    }
+    m_trace.filters_exclude = trace_filters_exclude;
+    m_trace.filters_include = trace_filters_include;
+    mbed_trace_reset_isr_tmp();
+#else
     if (m_trace.line == NULL) {
         m_trace.line = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
     }
@@ -155,7 +263,6 @@ int mbed_trace_init(void)
     if (m_trace.tmp_data == NULL) {
         m_trace.tmp_data = MBED_TRACE_MEM_ALLOC(m_trace.tmp_data_length);
     }
-    m_trace.tmp_data_ptr = m_trace.tmp_data;
 
     if (m_trace.filters_exclude == NULL) {
         m_trace.filters_exclude = MBED_TRACE_MEM_ALLOC(m_trace.filters_length);
@@ -163,6 +270,8 @@ int mbed_trace_init(void)
     if (m_trace.filters_include == NULL) {
         m_trace.filters_include = MBED_TRACE_MEM_ALLOC(m_trace.filters_length);
     }
+#endif
+    m_trace.tmp_data_ptr = m_trace.tmp_data;
 
     if (m_trace.line == NULL ||
             m_trace.tmp_data == NULL ||
@@ -175,20 +284,25 @@ int mbed_trace_init(void)
     memset(m_trace.tmp_data, 0, m_trace.tmp_data_length);
     memset(m_trace.filters_exclude, 0, m_trace.filters_length);
     memset(m_trace.filters_include, 0, m_trace.filters_length);
+    memset(&m_trace.exclude, 0, sizeof(m_trace.exclude));
+    memset(&m_trace.include, 0, sizeof(m_trace.include));
     memset(m_trace.line, 0, m_trace.line_length);
 
     return 0;
 }
 void mbed_trace_free(void)
 {
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 0
     // release memory
     MBED_TRACE_MEM_FREE(m_trace.line);
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
     MBED_TRACE_MEM_FREE(m_trace.filters_include);
+#endif
 
     // reset to default values
     m_trace.trace_config = DEFAULT_TRACE_CONFIG;
+    mbed_trace_active_levels = m_trace.trace_config & TRACE_MASK_LEVEL;
     m_trace.filters_exclude = 0;
     m_trace.filters_include = 0;
     m_trace.filters_length = DEFAULT_TRACE_FILTER_LENGTH;
@@ -199,19 +313,39 @@ void mbed_trace_free(void)
     m_trace.prefix_f = 0;
     m_trace.suffix_f = 0;
     m_trace.printf  = mbed_trace_default_print;
+    m_trace.level_printf = 0;
     m_trace.cmd_printf = 0;
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+    memset(&m_trace.binary, 0, sizeof(m_trace.binary));
+    m_trace.timestamp_f = 0;
+#endif
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+    memset(&m_trace.output, 0, sizeof(m_trace.output));
+#endif
 }
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 0
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
     MBED_TRACE_MEM_FREE(*buffer);
     *buffer  = MBED_TRACE_MEM_ALLOC(new_length);
     *length_ptr = new_length;
 }
+#endif
 void mbed_trace_buffer_sizes(int lineLength, int tmpLength)
 {
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+    // the static buffers stay in place, only the length used is changed
+    if (lineLength > 0) {
+        m_trace.line_length = lineLength < (int)sizeof(trace_line) ? lineLength : (int)sizeof(trace_line);
+    }
+    if (tmpLength > 0) {
+        m_trace.tmp_data_length = tmpLength < (int)sizeof(trace_tmp_data) ? tmpLength : (int)sizeof(trace_tmp_data);
+        mbed_trace_reset_tmp();
+    }
+#else
     if (lineLength > 0) {
         mbed_trace_realloc(&(m_trace.line), &m_trace.line_length, lineLength);
     }
@@ -219,10 +353,12 @@ void mbed_trace_buffer_sizes(int lineLength, int tmpLength)
         mbed_trace_realloc(&(m_trace.tmp_data), &m_trace.tmp_data_length, tmpLength);
         mbed_trace_reset_tmp();
     }
+#endif
 }
 void mbed_trace_config_set(uint8_t config)
 {
     m_trace.trace_config = config;
+    mbed_trace_active_levels = config & TRACE_MASK_LEVEL;
 }
 uint8_t mbed_trace_config_get(void)
 {
@@ -240,6 +376,10 @@ void mbed_trace_print_function_set(void (*printf)(const char *))
 {
     m_trace.printf = printf;
 }
+void mbed_trace_level_print_function_set(void (*print_f)(uint8_t, const char *))
+{
+    m_trace.level_printf = print_f;
+}
 void mbed_trace_cmdprint_function_set(void (*printf)(const char *))
 {
     m_trace.cmd_printf = printf;
@@ -252,6 +392,87 @@ void mbed_trace_mutex_release_function_set(void (*mutex_release_f)(void))
 {
     m_trace.mutex_release_f = mutex_release_f;
 }
+static bool mbed_trace_filter_separator(char c)
+{
+    return c == ',' || c == ' ';
+}
+static uint32_t mbed_trace_filter_hash(uint32_t group)
+{
+    return 1UL << ((uint32_t)(group * 2654435761U) >> 27);
+}
+/** pack a group name of up to 4 characters in a word */
+static uint32_t mbed_trace_filter_pack(const char *name, size_t length)
+{
+    uint32_t group = 0;
+    for (size_t i = 0; i < length; i++) {
+        group |= (uint32_t)(uint8_t)name[i] << (8 * i);
+    }
+    return group;
+}
+static void mbed_trace_filter_compile(trace_filter_t *filter, const char *filters)
+{
+    memset(filter, 0, sizeof(*filter));
+    for (int i = 0; i < m_trace.filters_length && filters[i] != '\0';) {
+        if (mbed_trace_filter_separator(filters[i])) {
+            i++;
+            continue;
+        }
+        int length = 0;
+        while (i + length < m_trace.filters_length && filters[i + length] != '\0' &&
+                !mbed_trace_filter_separator(filters[i + length])) {
+            length++;
+        }
+        if (length > 4) {
+            filter->long_names = true;
+        } else if (filter->count < TRACE_FILTER_MAX_GROUPS) {
+            const uint32_t group = mbed_trace_filter_pack(&filters[i], length);
+            filter->groups[filter->count++] = group;
+            filter->hashes |= mbed_trace_filter_hash(group);
+        }
+        i += length;
+    }
+}
+/** find a group name longer than 4 characters in the filter string */
+static bool mbed_trace_filter_find_long(const char *filters, const char *grp, size_t grp_length)
+{
+    for (int i = 0; i < m_trace.filters_length && filters[i] != '\0';) {
+        if (mbed_trace_filter_separator(filters[i])) {
+            i++;
+            continue;
+        }
+        int length = 0;
+        while (i + length < m_trace.filters_length && filters[i + length] != '\0' &&
+                !mbed_trace_filter_separator(filters[i + length])) {
+            length++;
+        }
+        if ((size_t)length == grp_length && memcmp(&filters[i], grp, length) == 0) {
+            return true;
+        }
+        i += length;
+    }
+    return false;
+}
+static bool mbed_trace_filter_match(const trace_filter_t *filter, const char *filters, const char *grp)
+{
+    size_t length = 0;
+    while (length <= 4 && grp[length] != '\0') {
+        length++;
+    }
+    if (length > 4) {
+        return filter->long_names && mbed_trace_filter_find_long(filters, grp, strlen(grp));
+    }
+
+    const uint32_t group = mbed_trace_filter_pack(grp, length);
+    if ((filter->hashes & mbed_trace_filter_hash(group)) == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < filter->count; i++) {
+        if (filter->groups[i] == group) {
+            return true;
+        }
+    }
+    return false;
+}
 void mbed_trace_exclude_filters_set(char *filters)
 {
     if (filters) {
@@ -259,6 +480,7 @@ void mbed_trace_exclude_filters_set(char *filters)
     } else {
         m_trace.filters_exclude[0] = 0;
     }
+    mbed_trace_filter_compile(&m_trace.exclude, m_trace.filters_exclude);
 }
 const char *mbed_trace_exclude_filters_get(void)
 {
@@ -275,21 +497,20 @@ void mbed_trace_include_filters_set(char *filters)
     } else {
         m_trace.filters_include[0] = 0;
     }
+    mbed_trace_filter_compile(&m_trace.include, m_trace.filters_include);
 }
 static int8_t mbed_trace_skip(int8_t dlevel, const char *grp)
 {
     if (dlevel >= 0 && grp != 0) {
         // filter debug prints only when dlevel is >0 and grp is given
-
-        /// @TODO this could be much better..
         if (m_trace.filters_exclude[0] != '\0' &&
-                strstr(m_trace.filters_exclude, grp) != 0) {
+                mbed_trace_filter_match(&m_trace.exclude, m_trace.filters_exclude, grp)) {
             //grp was in exclude list
             return 1;
         }
         if (m_trace.filters_include[0] != '\0' &&
-                strstr(m_trace.filters_include, grp) == 0) {
-            //grp was in include list
+                !mbed_trace_filter_match(&m_trace.include, m_trace.filters_include, grp)) {
+            //grp was not in include list
             return 1;
         }
     }
@@ -299,6 +520,172 @@ static void mbed_trace_default_print(const char *str)
 {
     puts(str);
 }
+#if MBED_TRACE_RING
+/* Ring buffer */
+#define RING_ALIGN(len)         (((len) + 3u) & ~3u)
+#define RING_ENTRY_READY        0x80000000u
+#define RING_ENTRY_PADDING      0x40000000u
+#define RING_ENTRY_LENGTH_MASK  0x0000FFFFu
+
+static int mbed_trace_ring_init(trace_ring_t *ring, void *buffer, size_t size)
+{
+    if (buffer != NULL && (((uintptr_t)buffer & 3) != 0 || size < sizeof(uint32_t) ||
+                           (size & (size - 1)) != 0 || size > 0x80000000u)) {
+        return -1;
+    }
+    if (buffer != NULL) {
+        memset(buffer, 0, size);
+    }
+    core_util_critical_section_enter();
+    ring->buffer = buffer;
+    ring->size = buffer ? size : 0;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    core_util_critical_section_exit();
+    return 0;
+}
+/* Reserve space for an entry of length bytes (header excluded). Safe from any context.
+ * Returns pointer to the entry data, or NULL when the entry does not fit. */
+static void *mbed_trace_ring_reserve(trace_ring_t *ring, uint32_t length, uint32_t **header)
+{
+    uint32_t size = ring->size;
+    uint32_t head = core_util_atomic_load_u32(&ring->head);
+    uint32_t offset, pad;
+
+    length = RING_ALIGN(length) + sizeof(uint32_t);
+    if (ring->buffer == NULL || length > size || length > RING_ENTRY_LENGTH_MASK) {
+        return NULL;
+    }
+    do {
+        offset = head & (size - 1);
+        pad = (offset + length > size) ? size - offset : 0;
+        if (size - (head - core_util_atomic_load_u32(&ring->tail)) < pad + length) {
+            core_util_atomic_incr_u32(&ring->dropped, 1);
+            return NULL;
+        }
+    } while (!core_util_atomic_cas_u32(&ring->head, &head, head + pad + length));
+
+    if (pad) {
+        core_util_atomic_store_u32((uint32_t *)(ring->buffer + offset), RING_ENTRY_READY | RING_ENTRY_PADDING | pad);
+        offset = 0;
+    }
+    *header = (uint32_t *)(ring->buffer + offset);
+    **header = length;
+    return ring->buffer + offset + sizeof(uint32_t);
+}
+/* Make a reserved entry visible to the reader */
+static void mbed_trace_ring_commit(uint32_t *header)
+{
+    core_util_atomic_store_u32(header, *header | RING_ENTRY_READY);
+}
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+static bool mbed_trace_ring_write(trace_ring_t *ring, const void *data, uint32_t length)
+{
+    uint32_t *header;
+    void *entry = mbed_trace_ring_reserve(ring, length, &header);
+    if (entry == NULL) {
+        return false;
+    }
+    memcpy(entry, data, length);
+    mbed_trace_ring_commit(header);
+    return true;
+}
+#endif
+/* Get the oldest complete entry, single reader only.
+ * Entries are delivered in reservation order; an unfinished entry holds back the later ones. */
+static void *mbed_trace_ring_peek(trace_ring_t *ring, uint32_t *length)
+{
+    while (ring->buffer != NULL && ring->tail != core_util_atomic_load_u32(&ring->head)) {
+        uint32_t offset = ring->tail & (ring->size - 1);
+        uint32_t header = core_util_atomic_load_u32((uint32_t *)(ring->buffer + offset));
+        if (!(header & RING_ENTRY_READY)) {
+            break;
+        }
+        if (!(header & RING_ENTRY_PADDING)) {
+            *length = (header & RING_ENTRY_LENGTH_MASK) - sizeof(uint32_t);
+            return ring->buffer + offset + sizeof(uint32_t);
+        }
+        memset(ring->buffer + offset, 0, header & RING_ENTRY_LENGTH_MASK);
+        core_util_atomic_store_u32(&ring->tail, ring->tail + (header & RING_ENTRY_LENGTH_MASK));
+    }
+    return NULL;
+}
+/* Release the entry returned by mbed_trace_ring_peek() */
+static void mbed_trace_ring_consume(trace_ring_t *ring)
+{
+    uint32_t offset = ring->tail & (ring->size - 1);
+    uint32_t length = *(uint32_t *)(ring->buffer + offset) & RING_ENTRY_LENGTH_MASK;
+    memset(ring->buffer + offset, 0, length);
+    core_util_atomic_store_u32(&ring->tail, ring->tail + length);
+}
+#endif /* MBED_TRACE_RING */
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+int mbed_trace_output_buffer_set(void *buffer, size_t size)
+{
+    return mbed_trace_ring_init(&m_trace.output, buffer, size);
+}
+int mbed_trace_output_drain(void)
+{
+    uint32_t length;
+    const char *entry;
+    int count = 0;
+
+    while ((entry = mbed_trace_ring_peek(&m_trace.output, &length)) != NULL) {
+        // entry is the trace level followed by the line
+        if (m_trace.level_printf) {
+            m_trace.level_printf((uint8_t)entry[0], entry + 1);
+        } else if (m_trace.printf) {
+            m_trace.printf(entry + 1);
+        }
+        mbed_trace_ring_consume(&m_trace.output);
+        count++;
+    }
+    return count;
+}
+uint32_t mbed_trace_output_dropped(void)
+{
+    return core_util_atomic_load_u32(&m_trace.output.dropped);
+}
+#endif
+/* End the line with its newline, so that it is printed by a single call which other
+ * output can not be interleaved with. A line which fills the buffer loses its last character. */
+static void mbed_trace_newline(char *line, int line_length)
+{
+    size_t length = strlen(line);
+    if (line_length < 2) {
+        return;
+    }
+    if (length > (size_t)line_length - 2) {
+        length = line_length - 2;
+    }
+    line[length] = '\n';
+    line[length + 1] = 0;
+}
+static void mbed_trace_output(uint8_t dlevel, char *line, int line_length)
+{
+    if (m_trace.level_printf) {
+        mbed_trace_newline(line, line_length);
+    }
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+    if (m_trace.output.buffer != NULL) {
+        uint32_t length = strlen(line) + 1;
+        uint32_t *header;
+        char *entry = mbed_trace_ring_reserve(&m_trace.output, length + 1, &header);
+        if (entry != NULL) {
+            entry[0] = (char)dlevel;
+            memcpy(entry + 1, line, length);
+            mbed_trace_ring_commit(header);
+        }
+        return;
+    }
+#endif
+    if (m_trace.level_printf) {
+        m_trace.level_printf(dlevel, line);
+    } else {
+        m_trace.printf(line);
+    }
+}
 void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
 {
     va_list ap;
@@ -306,40 +693,52 @@ void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
     mbed_vtracef(dlevel, grp, fmt, ap);
     va_end(ap);
 }
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+static void mbed_trace_binary_vrecord(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#endif
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1 || MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+static void mbed_trace_isr_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#endif
+static void mbed_trace_vprint_line(char *line, int line_length, uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
 void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
-    if (m_trace.mutex_wait_f) {
-        m_trace.mutex_wait_f();
-        m_trace.mutex_lock_count++;
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+    if (m_trace.binary.buffer != NULL && dlevel != TRACE_LEVEL_CMD) {
+        mbed_trace_binary_vrecord(dlevel, grp, fmt, ap);
+        return;
     }
-
-    if (NULL == m_trace.line) {
-        goto end;
+#endif
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+    if (core_util_is_isr_active()) {
+        mbed_trace_isr_vprint(dlevel, grp, fmt, ap);
+        return;
     }
-
-    m_trace.line[0] = 0; //by default trace is empty
-
-    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
-        //return tmp data pointer back to the beginning
-        mbed_trace_reset_tmp();
-        goto end;
+#elif MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+    if (m_trace.output.buffer != NULL && core_util_is_isr_active()) {
+        mbed_trace_isr_vprint(dlevel, grp, fmt, ap);
+        return;
     }
+#endif
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+}
+static void mbed_trace_vprint_line(char *line, int line_length, uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
     if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
 
-        int retval = 0, bLeft = m_trace.line_length;
-        char *ptr = m_trace.line;
+        int retval = 0, bLeft = line_length;
+        char *ptr = line;
         if (plain == true || dlevel == TRACE_LEVEL_CMD) {
             //add trace data
             retval = vsnprintf(ptr, bLeft, fmt, ap);
             if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
-                m_trace.cmd_printf(m_trace.line);
-                m_trace.cmd_printf("\n");
+                mbed_trace_newline(line, line_length);
+                m_trace.cmd_printf(line);
             } else {
                 //print out whole data
-                m_trace.printf(m_trace.line);
+                mbed_trace_output(dlevel, line, line_length);
             }
         } else {
             if (color) {
@@ -464,13 +863,96 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
                 }
             }
             //print out whole data
-            m_trace.printf(m_trace.line);
+            mbed_trace_output(dlevel, line, line_length);
         }
+    }
+}
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+/* Interrupts can not wait for the mutex, so they have their own line and tmp
+ * buffers, and the ones of the threads are left alone. */
+static void mbed_trace_isr_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    trace_isr_line[0] = 0;
+    if (NULL != m_trace.line && !mbed_trace_skip(dlevel, grp) && fmt != 0 && grp != 0 &&
+            (m_trace.printf || m_trace.level_printf)) {
+        mbed_trace_vprint_line(trace_isr_line, sizeof(trace_isr_line), dlevel, grp, fmt, ap);
+    }
+    mbed_trace_reset_isr_tmp();
+}
+static void mbed_trace_reset_isr_tmp(void)
+{
+    trace_isr_tmp_data_ptr = trace_isr_tmp_data;
+}
+#elif MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+/* Interrupts can not wait for the mutex, so the line is formatted on the stack
+ * and the tmp buffer used by the helper functions is left alone. */
+static void mbed_trace_isr_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    char line[DEFAULT_TRACE_ISR_LINE_LENGTH];
+
+    line[0] = 0;
+    if (NULL == m_trace.line || mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0) {
+        return;
+    }
+    mbed_trace_vprint_line(line, sizeof(line), dlevel, grp, fmt, ap);
+}
+#endif
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+        m_trace.mutex_lock_count++;
+    }
+
+    if (NULL == m_trace.line) {
+        goto end;
+    }
+
+    m_trace.line[0] = 0; //by default trace is empty
+
+    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || (!m_trace.printf && !m_trace.level_printf)) {
         //return tmp data pointer back to the beginning
         mbed_trace_reset_tmp();
+        goto end;
     }
+    mbed_trace_vprint_line(m_trace.line, m_trace.line_length, dlevel, grp, fmt, ap);
+    //return tmp data pointer back to the beginning
+    mbed_trace_reset_tmp();
 
 end:
+    mbed_trace_mutex_release_all();
+}
+static const char hex_digits[] = "0123456789abcdef";
+/* Write buf to str as "xx:xx:xx", with a table lookup rather than a snprintf per byte.
+ * If it does not fit in bLeft bytes, the last character written is '*'.
+ * Returns pointer past the null terminator. */
+static char *mbed_trace_hex(char *str, int bLeft, const uint8_t *buf, uint16_t len)
+{
+    char *wptr = str;
+    uint16_t i;
+    for (i = 0; i < len && bLeft > 3; i++) {
+        *wptr++ = hex_digits[buf[i] >> 4];
+        *wptr++ = hex_digits[buf[i] & 0x0f];
+        *wptr++ = ':';
+        bLeft -= 3;
+    }
+    if (wptr == str) {
+        *wptr = 0;
+        return wptr;
+    }
+    if (i < len) {
+        // replace last character as 'star',
+        // which indicate buffer len is not enough
+        *(wptr - 1) = '*';
+        *wptr = 0;
+        return wptr + 1;
+    }
+    //null to replace last ':' character
+    *(wptr - 1) = 0;
+    return wptr;
+}
+static void mbed_trace_mutex_release_all(void)
+{
     if (m_trace.mutex_release_f) {
         // Store the mutex lock count to temp variable so that it won't get
         // clobbered during last loop iteration when mutex gets released
@@ -496,50 +978,515 @@ const char *mbed_trace_last(void)
 {
     return m_trace.line;
 }
-/* Helping functions */
-#define tmp_data_left()  m_trace.tmp_data_length-(m_trace.tmp_data_ptr-m_trace.tmp_data)
-char *mbed_trace_array(const uint8_t *buf, uint16_t len)
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+/* Binary mode */
+#define BINARY_ALIGN(len)   (((len) + 3u) & ~3u)
+/** max length of a single conversion specification when formatting binary records */
+#define BINARY_SPEC_LENGTH  32
+
+typedef enum {
+    BINARY_ARG_NONE,
+    BINARY_ARG_INT,
+    BINARY_ARG_LONG,
+    BINARY_ARG_LLONG,
+    BINARY_ARG_INTMAX,
+    BINARY_ARG_SIZE,
+    BINARY_ARG_PTRDIFF,
+    BINARY_ARG_DOUBLE,
+    BINARY_ARG_PTR,
+    BINARY_ARG_STR,
+    BINARY_ARG_COUNT
+} binary_arg_t;
+
+/* Parse one conversion specification, fmt points after the '%'.
+ * Returns pointer past the specification, the type of its argument
+ * and the number of '*' width/precision arguments in front of it. */
+static const char *mbed_trace_binary_spec(const char *fmt, binary_arg_t *arg, int *stars)
 {
-    /** Acquire mutex. It is released before returning from mbed_vtracef. */
-    if (m_trace.mutex_wait_f) {
+    binary_arg_t length = BINARY_ARG_INT;
+
+    *stars = 0;
+    *arg = BINARY_ARG_NONE;
+    while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') {
+        fmt++;
+    }
+    if (*fmt == '*') {
+        (*stars)++;
+        fmt++;
+    }
+    while (*fmt >= '0' && *fmt <= '9') {
+        fmt++;
+    }
+    if (*fmt == '.') {
+        fmt++;
+        if (*fmt == '*') {
+            (*stars)++;
+            fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9') {
+            fmt++;
+        }
+    }
+    switch (*fmt) {
+        case 'h':
+            fmt += (fmt[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            length = (fmt[1] == 'l') ? BINARY_ARG_LLONG : BINARY_ARG_LONG;
+            fmt += (fmt[1] == 'l') ? 2 : 1;
+            break;
+        case 'j':
+            length = BINARY_ARG_INTMAX;
+            fmt++;
+            break;
+        case 'z':
+            length = BINARY_ARG_SIZE;
+            fmt++;
+            break;
+        case 't':
+            length = BINARY_ARG_PTRDIFF;
+            fmt++;
+            break;
+        case 'L':
+            fmt++;
+            break;
+        default:
+            break;
+    }
+    switch (*fmt) {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            *arg = length;
+            break;
+        case 'c':
+            *arg = BINARY_ARG_INT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            *arg = BINARY_ARG_DOUBLE;
+            break;
+        case 's':
+            *arg = BINARY_ARG_STR;
+            break;
+        case 'p':
+            *arg = BINARY_ARG_PTR;
+            break;
+        case 'n':
+            *arg = BINARY_ARG_COUNT;
+            break;
+        case '\0':
+            return fmt;
+        default:
+            break;
+    }
+    return fmt + 1;
+}
+static bool mbed_trace_binary_put(uint8_t *record, uint32_t *pos, const void *value, uint32_t len)
+{
+    if (*pos + BINARY_ALIGN(len) > DEFAULT_TRACE_BINARY_RECORD_LENGTH) {
+        return false;
+    }
+    memcpy(record + *pos, value, len);
+    *pos += BINARY_ALIGN(len);
+    return true;
+}
+/* unlike vsnprintf this only walks fmt once and copies the raw arguments */
+static uint32_t mbed_trace_binary_encode(uint8_t *record, const char *fmt, va_list ap, uint8_t *flags)
+{
+    uint32_t pos = sizeof(mbed_trace_binary_record_t);
+    bool fit = true;
+
+#define BINARY_PUT_ARG(type) do { \
+        type value = va_arg(ap, type); \
+        fit = mbed_trace_binary_put(record, &pos, &value, sizeof(value)); \
+    } while (0)
+
+    while (*fmt && fit) {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        binary_arg_t arg;
+        int stars;
+        fmt = mbed_trace_binary_spec(fmt, &arg, &stars);
+        while (stars-- > 0 && fit) {
+            BINARY_PUT_ARG(int);
+        }
+        if (!fit) {
+            break;
+        }
+        switch (arg) {
+            case BINARY_ARG_INT:
+                BINARY_PUT_ARG(int);
+                break;
+            case BINARY_ARG_LONG:
+                BINARY_PUT_ARG(long);
+                break;
+            case BINARY_ARG_LLONG:
+                BINARY_PUT_ARG(long long);
+                break;
+            case BINARY_ARG_INTMAX:
+                BINARY_PUT_ARG(intmax_t);
+                break;
+            case BINARY_ARG_SIZE:
+                BINARY_PUT_ARG(size_t);
+                break;
+            case BINARY_ARG_PTRDIFF:
+                BINARY_PUT_ARG(ptrdiff_t);
+                break;
+            case BINARY_ARG_DOUBLE:
+                // long double is stored as double
+                if (fmt[-2] == 'L') {
+                    double value = (double)va_arg(ap, long double);
+                    fit = mbed_trace_binary_put(record, &pos, &value, sizeof(value));
+                } else {
+                    BINARY_PUT_ARG(double);
+                }
+                break;
+            case BINARY_ARG_PTR:
+                BINARY_PUT_ARG(void *);
+                break;
+            case BINARY_ARG_STR: {
+                const char *str = va_arg(ap, const char *);
+                uint32_t len, room;
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                room = DEFAULT_TRACE_BINARY_RECORD_LENGTH - pos;
+                room = room > sizeof(uint32_t) ? room - sizeof(uint32_t) : 0;
+                for (len = 0; len < room && str[len] != '\0'; len++);
+                if (str[len] != '\0') {
+                    *flags |= MBED_TRACE_BINARY_FLAG_TRUNCATED;
+                }
+                fit = mbed_trace_binary_put(record, &pos, &len, sizeof(len)) &&
+                      mbed_trace_binary_put(record, &pos, str, len);
+                break;
+            }
+            case BINARY_ARG_COUNT:
+                (void)va_arg(ap, void *);
+                break;
+            default:
+                break;
+        }
+    }
+#undef BINARY_PUT_ARG
+    if (!fit) {
+        *flags |= MBED_TRACE_BINARY_FLAG_TRUNCATED;
+    }
+    return pos;
+}
+static void mbed_trace_binary_vrecord(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    bool isr = core_util_is_isr_active();
+    // the mutex is only held to release the mutex taken by helper functions,
+    // which can not be used from interrupts
+    if (m_trace.mutex_wait_f && !isr) {
         m_trace.mutex_wait_f();
         m_trace.mutex_lock_count++;
     }
-    int i, bLeft = tmp_data_left();
-    char *str, *wptr;
-    str = m_trace.tmp_data_ptr;
-    if (len == 0 || str == NULL || bLeft == 0) {
-        return "";
+    if (fmt != 0 && grp != 0 && ((m_trace.trace_config & TRACE_MASK_LEVEL) & dlevel) &&
+            !mbed_trace_skip(dlevel, grp)) {
+        uint32_t data[DEFAULT_TRACE_BINARY_RECORD_LENGTH / sizeof(uint32_t)];
+        mbed_trace_binary_record_t *record = (mbed_trace_binary_record_t *)data;
+        record->level = dlevel;
+        record->flags = 0;
+        record->timestamp = m_trace.timestamp_f ? m_trace.timestamp_f() : 0;
+        record->grp = grp;
+        record->fmt = fmt;
+        record->length = mbed_trace_binary_encode((uint8_t *)data, fmt, ap, &record->flags);
+        (void)mbed_trace_ring_write(&m_trace.binary, data, record->length);
     }
-    if (buf == NULL) {
-        return "<null>";
+    if (!isr) {
+        mbed_trace_reset_tmp();
+        mbed_trace_mutex_release_all();
+    }
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+    else {
+        mbed_trace_reset_isr_tmp();
+    }
+#endif
+}
+/* the bytes are stored as they are, and only converted to hex when the record is formatted */
+static void mbed_trace_binary_array(uint8_t dlevel, const char *grp, const char *label, const uint8_t *buf, uint16_t len)
+{
+    if (grp != 0 && ((m_trace.trace_config & TRACE_MASK_LEVEL) & dlevel) && !mbed_trace_skip(dlevel, grp)) {
+        uint32_t data[DEFAULT_TRACE_BINARY_RECORD_LENGTH / sizeof(uint32_t)];
+        mbed_trace_binary_record_t *record = (mbed_trace_binary_record_t *)data;
+        uint32_t pos = sizeof(mbed_trace_binary_record_t);
+        uint32_t room = DEFAULT_TRACE_BINARY_RECORD_LENGTH - pos - sizeof(uint32_t);
+        uint32_t length = buf != NULL ? len : 0;
+        record->level = dlevel;
+        record->flags = MBED_TRACE_BINARY_FLAG_ARRAY;
+        if (length > room) {
+            length = room;
+            record->flags |= MBED_TRACE_BINARY_FLAG_TRUNCATED;
+        }
+        record->timestamp = m_trace.timestamp_f ? m_trace.timestamp_f() : 0;
+        record->grp = grp;
+        record->fmt = label;
+        (void)mbed_trace_binary_put((uint8_t *)data, &pos, &length, sizeof(length));
+        (void)mbed_trace_binary_put((uint8_t *)data, &pos, buf, length);
+        record->length = pos;
+        (void)mbed_trace_ring_write(&m_trace.binary, data, record->length);
+    }
+}
+static const mbed_trace_binary_record_t *mbed_trace_binary_peek(void)
+{
+    uint32_t length;
+    return mbed_trace_ring_peek(&m_trace.binary, &length);
+}
+static bool mbed_trace_binary_get(const mbed_trace_binary_record_t *record, uint32_t *pos, void *value, uint32_t len)
+{
+    if (*pos + BINARY_ALIGN(len) > record->length) {
+        return false;
+    }
+    memcpy(value, (const uint8_t *)record + *pos, len);
+    *pos += BINARY_ALIGN(len);
+    return true;
+}
+/* format record body to str, one conversion specification at a time */
+static void mbed_trace_binary_format(const mbed_trace_binary_record_t *record, char *str, int bLeft)
+{
+    uint32_t pos = sizeof(mbed_trace_binary_record_t);
+    const char *fmt = record->fmt;
+    int retval = 0;
+
+    if (m_trace.timestamp_f) {
+        retval = snprintf(str, bLeft, "[%" PRIu32 "] ", record->timestamp);
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        if (retval > 0) {
+            str += retval;
+            bLeft -= retval;
+        }
+    }
+    if (record->flags & MBED_TRACE_BINARY_FLAG_ARRAY) {
+        uint32_t len;
+        retval = snprintf(str, bLeft, "%s", fmt);
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        str += retval;
+        bLeft -= retval;
+        // the bytes are converted in place, the record stays in the ring until it is formatted
+        if (mbed_trace_binary_get(record, &pos, &len, sizeof(len)) && pos + len <= record->length) {
+            mbed_trace_hex(str, bLeft, (const uint8_t *)record + pos, len);
+        } else {
+            *str = 0;
+        }
+        return;
     }
-    wptr = str;
-    wptr[0] = 0;
-    const uint8_t *ptr = buf;
-    char overflow = 0;
-    for (i = 0; i < len; i++) {
-        if (bLeft <= 3) {
-            overflow = 1;
+    while (*fmt && bLeft > 1) {
+        if (*fmt != '%') {
+            *str++ = *fmt++;
+            bLeft--;
+            continue;
+        }
+        const char *start = fmt;
+        char spec[BINARY_SPEC_LENGTH];
+        int speclen = 0;
+        binary_arg_t arg;
+        int stars;
+        bool ok = true;
+        fmt = mbed_trace_binary_spec(fmt + 1, &arg, &stars);
+        if (arg == BINARY_ARG_NONE || arg == BINARY_ARG_COUNT) {
+            if (fmt[-1] == '%' && fmt - start == 2) {
+                *str++ = '%';
+                bLeft--;
+            }
+            continue;
+        }
+        // copy the specification, replacing '*' with the recorded value
+        for (; start < fmt && ok; start++) {
+            if (*start == '*') {
+                int value;
+                ok = mbed_trace_binary_get(record, &pos, &value, sizeof(value));
+                retval = ok ? snprintf(spec + speclen, sizeof(spec) - speclen, "%d", value) : 0;
+            } else if (*start == 'L' || (*start == 'l' && arg == BINARY_ARG_STR)) {
+                // long double is stored as double, wide strings are not supported
+                retval = 0;
+            } else {
+                spec[speclen] = *start;
+                retval = 1;
+            }
+            speclen += retval;
+            ok = ok && speclen < (int)sizeof(spec) - 1;
+        }
+        if (!ok) {
             break;
         }
-        int retval = snprintf(wptr, bLeft, "%02x:", *ptr++);
-        if (retval <= 0 || retval > bLeft) {
+        spec[speclen] = 0;
+
+#define BINARY_FORMAT_ARG(type) do { \
+            type value; \
+            ok = mbed_trace_binary_get(record, &pos, &value, sizeof(value)); \
+            retval = ok ? snprintf(str, bLeft, spec, value) : 0; \
+        } while (0)
+
+        switch (arg) {
+            case BINARY_ARG_INT:
+                BINARY_FORMAT_ARG(int);
+                break;
+            case BINARY_ARG_LONG:
+                BINARY_FORMAT_ARG(long);
+                break;
+            case BINARY_ARG_LLONG:
+                BINARY_FORMAT_ARG(long long);
+                break;
+            case BINARY_ARG_INTMAX:
+                BINARY_FORMAT_ARG(intmax_t);
+                break;
+            case BINARY_ARG_SIZE:
+                BINARY_FORMAT_ARG(size_t);
+                break;
+            case BINARY_ARG_PTRDIFF:
+                BINARY_FORMAT_ARG(ptrdiff_t);
+                break;
+            case BINARY_ARG_DOUBLE:
+                BINARY_FORMAT_ARG(double);
+                break;
+            case BINARY_ARG_PTR:
+                BINARY_FORMAT_ARG(void *);
+                break;
+            case BINARY_ARG_STR: {
+                uint32_t len;
+                char value[DEFAULT_TRACE_BINARY_RECORD_LENGTH];
+                ok = mbed_trace_binary_get(record, &pos, &len, sizeof(len)) &&
+                     len < sizeof(value) &&
+                     mbed_trace_binary_get(record, &pos, value, len);
+                if (ok) {
+                    value[len] = 0;
+                    retval = snprintf(str, bLeft, spec, value);
+                }
+                break;
+            }
+            default:
+                retval = 0;
+                break;
+        }
+#undef BINARY_FORMAT_ARG
+        if (!ok) {
             break;
         }
-        bLeft -= retval;
-        wptr += retval;
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        if (retval > 0) {
+            str += retval;
+            bLeft -= retval;
+        }
     }
-    if (wptr > str) {
-        if (overflow) {
-            // replace last character as 'star',
-            // which indicate buffer len is not enough
-            *(wptr - 1) = '*';
-        } else {
-            //null to replace last ':' character
-            *(wptr - 1) = 0;
+    *str = 0;
+}
+static void mbed_trace_print(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+int mbed_trace_binary_buffer_set(void *buffer, size_t size)
+{
+    if (buffer != NULL && (m_trace.line == NULL || size < DEFAULT_TRACE_BINARY_RECORD_LENGTH + sizeof(uint32_t))) {
+        return -1;
+    }
+    return mbed_trace_ring_init(&m_trace.binary, buffer, size);
+}
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void))
+{
+    m_trace.timestamp_f = timestamp_f;
+}
+int mbed_trace_binary_drain(void)
+{
+    const mbed_trace_binary_record_t *record;
+    int count = 0;
+
+    while ((record = mbed_trace_binary_peek()) != NULL) {
+        /** Acquire mutex for the tmp buffer. It is released before returning from mbed_trace_vprint. */
+        if (m_trace.mutex_wait_f) {
+            m_trace.mutex_wait_f();
+            m_trace.mutex_lock_count++;
+        }
+        uint8_t dlevel = record->level;
+        const char *grp = record->grp;
+        if (m_trace.tmp_data != NULL) {
+            mbed_trace_binary_format(record, m_trace.tmp_data, m_trace.tmp_data_length);
         }
+        // the record is no longer needed, give the space back to writers before printing
+        mbed_trace_ring_consume(&m_trace.binary);
+        mbed_trace_print(dlevel, grp, "%s", m_trace.tmp_data ? m_trace.tmp_data : "");
+        count++;
+    }
+    return count;
+}
+size_t mbed_trace_binary_read(void *data, size_t size)
+{
+    const mbed_trace_binary_record_t *record;
+    size_t copied = 0;
+
+    while ((record = mbed_trace_binary_peek()) != NULL && copied + record->length <= size) {
+        memcpy((uint8_t *)data + copied, record, record->length);
+        copied += record->length;
+        mbed_trace_ring_consume(&m_trace.binary);
+    }
+    return copied;
+}
+uint32_t mbed_trace_binary_dropped(void)
+{
+    return core_util_atomic_load_u32(&m_trace.binary.dropped);
+}
+#endif /* MBED_CONF_MBED_TRACE_FEA_BINARY */
+void mbed_trace_hexdump(uint8_t dlevel, const char *grp, const char *label, const uint8_t *buf, uint16_t len)
+{
+    if (label == NULL) {
+        label = "";
+    }
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+    if (m_trace.binary.buffer != NULL && dlevel != TRACE_LEVEL_CMD) {
+        mbed_trace_binary_array(dlevel, grp, label, buf, len);
+        return;
+    }
+#endif
+    mbed_tracef(dlevel, grp, "%s%s", label, mbed_trace_array(buf, len));
+}
+/* Helping functions */
+#define tmp_data_left()  m_trace.tmp_data_length-(m_trace.tmp_data_ptr-m_trace.tmp_data)
+char *mbed_trace_array(const uint8_t *buf, uint16_t len)
+{
+    char **tmp_data_ptr = &m_trace.tmp_data_ptr;
+    int bLeft;
+#if MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS == 1
+    if (core_util_is_isr_active()) {
+        // the interrupt tmp buffer is reset by mbed_vtracef
+        tmp_data_ptr = &trace_isr_tmp_data_ptr;
+        bLeft = sizeof(trace_isr_tmp_data) - (trace_isr_tmp_data_ptr - trace_isr_tmp_data);
+    } else
+#endif
+    {
+        /** Acquire mutex. It is released before returning from mbed_vtracef. */
+        if (m_trace.mutex_wait_f) {
+            m_trace.mutex_wait_f();
+            m_trace.mutex_lock_count++;
+        }
+        bLeft = tmp_data_left();
+    }
+    char *str = *tmp_data_ptr;
+    if (len == 0 || str == NULL || bLeft == 0) {
+        return "";
+    }
+    if (buf == NULL) {
+        return "<null>";
     }
-    m_trace.tmp_data_ptr = wptr;
+    *tmp_data_ptr = mbed_trace_hex(str, bLeft, buf, len);
     return str;
 }
@@ -39,6 +39,7 @@
  * Activate with compiler flag: YOTTA_CFG_MBED_TRACE
  * Configure trace line buffer size with compiler flag: YOTTA_CFG_MBED_TRACE_LINE_LENGTH. Default length: 1024.
  * Limit the size of flash by setting MBED_TRACE_MAX_LEVEL value. Default is TRACE_LEVEL_DEBUG (all included)
+ * Set the maximum level of the traces of one file by defining TRACE_GROUP_MAX_LEVEL before including this header.
  *
  */
 #ifndef MBED_TRACE_H_
@@ -73,6 +74,18 @@ extern "C" {
 #define MBED_CONF_MBED_TRACE_FEA_IPV6 1
 #endif
 
+#ifndef MBED_CONF_MBED_TRACE_FEA_BINARY
+#define MBED_CONF_MBED_TRACE_FEA_BINARY 0
+#endif
+
+#ifndef MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER
+#define MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER 0
+#endif
+
+#ifndef MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS
+#define MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS 0
+#endif
+
 /** 3 upper bits are trace modes related,
     and 5 lower bits are trace level configuration */
 
@@ -118,36 +131,51 @@ extern "C" {
 #define MBED_TRACE_MAX_LEVEL TRACE_LEVEL_INFO
 #endif
 
+/**
+ * Maximum level of the tr_* macros in the including file, MBED_TRACE_MAX_LEVEL by default
+ * Define it before including this header to compile out the verbose traces of a group,
+ * or to keep the debug traces of the group being worked on, e.g.:
+ *  #define TRACE_GROUP             "rf"
+ *  #define TRACE_GROUP_MAX_LEVEL   TRACE_LEVEL_WARN
+ *  #include "mbed_trace.h"
+ */
+#ifndef TRACE_GROUP_MAX_LEVEL
+#define TRACE_GROUP_MAX_LEVEL MBED_TRACE_MAX_LEVEL
+#endif
+
+/** Evaluate a trace call, and its arguments, only when its level is active */
+#define MBED_TRACE_LEVEL_CALL(dlevel, call)     (mbed_trace_level_active(dlevel) ? (call) : (void) 0)
+
 //usage macros:
-#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_DEBUG
-#define tr_debug(...)           mbed_tracef(TRACE_LEVEL_DEBUG,   TRACE_GROUP, __VA_ARGS__)   //!< Print debug message
+#if TRACE_GROUP_MAX_LEVEL >= TRACE_LEVEL_DEBUG
+#define tr_debug(...)           MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_DEBUG, mbed_tracef(TRACE_LEVEL_DEBUG,   TRACE_GROUP, __VA_ARGS__))   //!< Print debug message
 #else
 #define tr_debug(...)
 #endif
 
-#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_INFO
-#define tr_info(...)            mbed_tracef(TRACE_LEVEL_INFO,    TRACE_GROUP, __VA_ARGS__)   //!< Print info message
+#if TRACE_GROUP_MAX_LEVEL >= TRACE_LEVEL_INFO
+#define tr_info(...)            MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_INFO, mbed_tracef(TRACE_LEVEL_INFO,    TRACE_GROUP, __VA_ARGS__))   //!< Print info message
 #else
 #define tr_info(...)
 #endif
 
-#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_WARN
-#define tr_warning(...)         mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Print warning message
-#define tr_warn(...)            mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Alternative warning message
+#if TRACE_GROUP_MAX_LEVEL >= TRACE_LEVEL_WARN
+#define tr_warning(...)         MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_WARN, mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__))   //!< Print warning message
+#define tr_warn(...)            MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_WARN, mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__))   //!< Alternative warning message
 #else
 #define tr_warning(...)
 #define tr_warn(...)
 #endif
 
-#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_ERROR
-#define tr_error(...)           mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Print Error Message
-#define tr_err(...)             mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Alternative error message
+#if TRACE_GROUP_MAX_LEVEL >= TRACE_LEVEL_ERROR
+#define tr_error(...)           MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_ERROR, mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__))   //!< Print Error Message
+#define tr_err(...)             MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_ERROR, mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__))   //!< Alternative error message
 #else
 #define tr_error(...)
 #define tr_err(...)
 #endif
 
-#define tr_cmdline(...)         mbed_tracef(TRACE_LEVEL_CMD,     TRACE_GROUP, __VA_ARGS__)   //!< Special print for cmdline. See more from TRACE_LEVEL_CMD -level
+#define tr_cmdline(...)         MBED_TRACE_LEVEL_CALL(TRACE_LEVEL_CMD, mbed_tracef(TRACE_LEVEL_CMD,     TRACE_GROUP, __VA_ARGS__))   //!< Special print for cmdline. See more from TRACE_LEVEL_CMD -level
 
 //aliases for the most commonly used functions and the helper functions
 #define tracef(dlevel, grp, ...)                mbed_tracef(dlevel, grp, __VA_ARGS__)       //!< Alias for mbed_tracef()
@@ -174,6 +202,11 @@ extern "C" {
 
 /**
  * Initialize trace functionality
+ * With MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS the buffers are static, sized by
+ * MBED_TRACE_LINE_LENGTH, MBED_TRACE_TMP_LINE_LENGTH and MBED_TRACE_FILTER_LENGTH,
+ * and nothing is allocated from the heap. Interrupts then trace to their own line
+ * and tmp buffers, without the mutex: the print function must be safe to call
+ * from interrupts, and interrupts which trace must not preempt each other.
  * @return 0 when all success, otherwise non zero
  */
 int mbed_trace_init(void);
@@ -183,6 +216,7 @@ int mbed_trace_init(void);
 void mbed_trace_free(void);
 /**
  * Resize buffers (line / tmp ) sizes
+ * With static buffers, the buffers can only be shrunk.
  * @param lineLength    new maximum length for trace line (0 = do no resize)
  * @param tmpLength     new maximum length for trace tmp buffer (used for trace_array, etc) (0 = do no resize)
  */
@@ -239,8 +273,17 @@ void mbed_trace_suffix_function_set(char *(*suffix_f)(void));
  * for e.g. to other IO device.
  */
 void mbed_trace_print_function_set(void (*print_f)(const char *));
+/**
+ * Set trace print function, which also gets the trace level of the line
+ * When set, it is used instead of the function set with mbed_trace_print_function_set(),
+ * for e.g. to route each trace level to its own output channel.
+ * Unlike with mbed_trace_print_function_set(), the line ends with its newline.
+ * Set to NULL to use the normal print function again.
+ */
+void mbed_trace_level_print_function_set(void (*print_f)(uint8_t dlevel, const char *str));
 /**
  * Set trace print function for tr_cmdline()
+ * The line ends with its newline.
  */
 void mbed_trace_cmdprint_function_set(void (*printf)(const char *));
 /**
@@ -259,9 +302,22 @@ void mbed_trace_mutex_wait_function_set(void (*mutex_wait_f)(void));
  * be acquired from a single thread repeatedly.
  */
 void mbed_trace_mutex_release_function_set(void (*mutex_release_f)(void));
+/** active trace levels of the configuration, internal to mbed_trace_level_active() */
+extern uint8_t mbed_trace_active_levels;
 /**
- * When trace group contains text in filters,
+ * Check if a trace level is active in the trace configuration
+ * This is what the tr_* macros check before evaluating their arguments.
+ * @param dlevel trace level
+ * @return true when traces of this level are printed
+ */
+static inline bool mbed_trace_level_active(uint8_t dlevel)
+{
+    return (mbed_trace_active_levels & dlevel) != 0;
+}
+/**
+ * When trace group is one of the group names in filters,
  * trace print will be ignored.
+ * Group names are separated by commas or spaces, and are matched exactly.
  * e.g.:
  *  mbed_trace_exclude_filters_set("mygr");
  *  mbed_tracef(TRACE_ACTIVE_LEVEL_DEBUG, "ougr", "This is not printed");
@@ -271,8 +327,9 @@ void mbed_trace_exclude_filters_set(char *filters);
  */
 const char *mbed_trace_exclude_filters_get(void);
 /**
- * When trace group contains text in filter,
+ * When trace group is one of the group names in filters,
  * trace will be printed.
+ * Group names are separated by commas or spaces, and are matched exactly.
  * e.g.:
  *  set_trace_include_filters("mygr");
  *  mbed_tracef(TRACE_ACTIVE_LEVEL_DEBUG, "mygr", "Hi There");
@@ -361,6 +418,126 @@ char *mbed_trace_ipv6_prefix(const uint8_t *prefix, uint8_t prefix_len);
  * which indicate that buffer is too small for array.
  */
 char *mbed_trace_array(const uint8_t *buf, uint16_t len);
+/**
+ * Trace a buffer as hex, prefixed by a label.
+ * In binary mode the bytes are copied to the record as they are, up to the record length,
+ * and only converted to hex by mbed_trace_binary_drain(). Otherwise this is
+ * mbed_tracef(dlevel, grp, "%s%s", label, mbed_trace_array(buf, len)).
+ *
+ * @param dlevel  trace level
+ * @param grp     trace group
+ * @param label   text printed before the bytes, which must outlive binary records
+ * @param buf     bytes to trace
+ * @param len     number of bytes
+ */
+void mbed_trace_hexdump(uint8_t dlevel, const char *grp, const char *label, const uint8_t *buf, uint16_t len);
+
+#if MBED_CONF_MBED_TRACE_FEA_BINARY == 1
+/** Binary record flag: arguments did not fit in the record and were cut short */
+#define MBED_TRACE_BINARY_FLAG_TRUNCATED    0x01
+/** Binary record flag: the record holds the bytes of mbed_trace_hexdump(), fmt is its label */
+#define MBED_TRACE_BINARY_FLAG_ARRAY        0x02
+
+/**
+ * Header of a binary trace record.
+ *
+ * The header is followed by the raw arguments in the order they appear in fmt.
+ * Each argument is stored in native byte order and padded to a multiple of 4 bytes.
+ * A "%s" argument is stored as a 32-bit byte count followed by the characters,
+ * without the null terminator. "*" width and precision arguments are stored as int.
+ *
+ * fmt and grp are addresses in the application image; a host side decoder
+ * resolves them from the ELF file.
+ */
+typedef struct {
+    uint16_t length;        /**< Record length in bytes, header included, multiple of 4 */
+    uint8_t level;          /**< Trace level of the record */
+    uint8_t flags;          /**< MBED_TRACE_BINARY_FLAG_xxx bits */
+    uint32_t timestamp;     /**< Value of the timestamp function when the record was written */
+    const char *grp;        /**< Trace group */
+    const char *fmt;        /**< Format string */
+} mbed_trace_binary_record_t;
+
+/**
+ * Switch tracing to binary mode
+ * In binary mode mbed_tracef() does not format anything. It only stores the format string pointer,
+ * a timestamp and the raw arguments to the given lock-free ring buffer, so traces can also be
+ * written from interrupts. Only interrupts skip the trace mutex: in thread context mbed_tracef()
+ * still waits for it, as set with mbed_trace_mutex_wait_function_set().
+ * The records are formatted later with mbed_trace_binary_drain() or read out with
+ * mbed_trace_binary_read() for decoding on a host.
+ * TRACE_LEVEL_CMD traces are always formatted immediately.
+ *
+ * Pointers passed to "%p" are stored as is; strings passed to "%s" are copied.
+ * "%n" is not supported and its argument is ignored.
+ *
+ * Must be called after mbed_trace_init(). mbed_trace_free() switches binary mode off.
+ *
+ * @param buffer  ring buffer, 4 byte aligned, or NULL to switch binary mode off.
+ *                Each record takes 4 bytes of the buffer in addition to its length.
+ * @param size    size of the buffer in bytes, must be a power of two
+ * @return 0 when success, -1 when the trace library is not initialized or buffer is invalid
+ */
+int mbed_trace_binary_buffer_set(void *buffer, size_t size);
+/**
+ * Set binary trace timestamp function
+ * timestamp_f is called for every binary record, for example to read a free running timer.
+ * Without a timestamp function records have timestamp 0.
+ */
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void));
+/**
+ * Format and print out all pending binary records
+ * The records are printed through the print function like normal traces, prefixed by the
+ * timestamp when a timestamp function is set. Intended to be called from a low priority context.
+ * Only one thread may drain or read the records.
+ *
+ * @return number of printed records
+ */
+int mbed_trace_binary_drain(void);
+/**
+ * Read pending binary records
+ * Copies as many complete records as fit to data and removes them from the ring buffer.
+ *
+ * @param data  destination buffer, 4 byte aligned
+ * @param size  size of the destination buffer in bytes
+ * @return number of bytes copied
+ */
+size_t mbed_trace_binary_read(void *data, size_t size);
+/**
+ * Get number of binary records dropped because the ring buffer was full
+ */
+uint32_t mbed_trace_binary_dropped(void);
+#endif
+
+#if MBED_CONF_MBED_TRACE_FEA_OUTPUT_BUFFER == 1
+/**
+ * Set trace output buffer
+ * When set, formatted trace lines are queued to the buffer instead of calling the print function,
+ * so writers never wait for the output device. The queue is lock-free and can be written from
+ * interrupts; traces from interrupts are formatted on the stack, limited to MBED_TRACE_ISR_LINE_LENGTH
+ * bytes, and must not use the helper functions (mbed_trace_array etc.) unless
+ * MBED_CONF_MBED_TRACE_FEA_STATIC_BUFFERS is set.
+ * Lines that do not fit to the buffer are dropped and counted.
+ * TRACE_LEVEL_CMD traces are always printed immediately.
+ *
+ * @param buffer  ring buffer, 4 byte aligned, or NULL to print directly again
+ * @param size    size of the buffer in bytes, must be a power of two
+ * @return 0 when success, -1 when buffer is invalid
+ */
+int mbed_trace_output_buffer_set(void *buffer, size_t size);
+/**
+ * Print out all queued trace lines
+ * Calls the print function for every line in the output buffer. Intended to be called from
+ * the idle loop or a low priority thread. Only one thread may drain the output buffer.
+ *
+ * @return number of printed lines
+ */
+int mbed_trace_output_drain(void);
+/**
+ * Get number of trace lines dropped because the output buffer was full
+ */
+uint32_t mbed_trace_output_dropped(void);
+#endif
 
 #ifdef __cplusplus
 }
@@ -384,9 +561,11 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_buffer_sizes
 #undef mbed_trace_config_set
 #undef mbed_trace_config_get
+#undef mbed_trace_level_active
 #undef mbed_trace_prefix_function_set
 #undef mbed_trace_suffix_function_set
 #undef mbed_trace_print_function_set
+#undef mbed_trace_level_print_function_set
 #undef mbed_trace_cmdprint_function_set
 #undef mbed_trace_mutex_wait_function_set
 #undef mbed_trace_mutex_release_function_set
@@ -400,6 +579,15 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
+#undef mbed_trace_hexdump
+#undef mbed_trace_binary_buffer_set
+#undef mbed_trace_timestamp_function_set
+#undef mbed_trace_binary_drain
+#undef mbed_trace_binary_read
+#undef mbed_trace_binary_dropped
+#undef mbed_trace_output_buffer_set
+#undef mbed_trace_output_drain
+#undef mbed_trace_output_dropped
 
 #elif !defined(MBED_TRACE_DUMMIES_DEFINED)
 // define dummies, hiding the real functions
@@ -409,9 +597,11 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_buffer_sizes(...)                ((void) 0)
 #define mbed_trace_config_set(...)                  ((void) 0)
 #define mbed_trace_config_get(...)                  ((uint8_t) 0)
+#define mbed_trace_level_active(...)                ((bool) 0)
 #define mbed_trace_prefix_function_set(...)         ((void) 0)
 #define mbed_trace_suffix_function_set(...)         ((void) 0)
 #define mbed_trace_print_function_set(...)          ((void) 0)
+#define mbed_trace_level_print_function_set(...)    ((void) 0)
 #define mbed_trace_cmdprint_function_set(...)       ((void) 0)
 #define mbed_trace_mutex_wait_function_set(...)     ((void) 0)
 #define mbed_trace_mutex_release_function_set(...)  ((void) 0)
@@ -422,6 +612,15 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_last(...)                        ((const char *) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
+#define mbed_trace_hexdump(...)                     ((void) 0)
+#define mbed_trace_binary_buffer_set(...)           ((int) 0)
+#define mbed_trace_timestamp_function_set(...)      ((void) 0)
+#define mbed_trace_binary_drain(...)                ((int) 0)
+#define mbed_trace_binary_read(...)                 ((size_t) 0)
+#define mbed_trace_binary_dropped(...)              ((uint32_t) 0)
+#define mbed_trace_output_buffer_set(...)           ((int) 0)
+#define mbed_trace_output_drain(...)                ((int) 0)
+#define mbed_trace_output_dropped(...)              ((uint32_t) 0)
 /**
  * These helper functions accumulate strings in a buffer that is only flushed by actual trace calls. Using these
  * functions outside trace calls could cause the buffer to overflow.
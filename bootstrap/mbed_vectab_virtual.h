@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_VECTAB_VIRTUAL_H
+#define MBED_VECTAB_VIRTUAL_H
+
+/* Included by the CMSIS-Core headers in place of their NVIC_SetVector() and
+ * NVIC_GetVector() definitions when MBED_CONF_PLATFORM_LAZY_RAM_VECTORS is set.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Set an interrupt vector, moving the vector table to RAM first if it is not there yet
+ *
+ * @param IRQn   The interrupt number
+ * @param vector The address of the interrupt handler
+ */
+void mbed_nvic_set_vector(IRQn_Type IRQn, uint32_t vector);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NVIC_SetVector mbed_nvic_set_vector
+#define NVIC_GetVector __NVIC_GetVector
+
+#endif // MBED_VECTAB_VIRTUAL_H
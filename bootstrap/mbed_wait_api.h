@@ -104,6 +104,26 @@ void wait_us(int us);
  */
 void wait_ns(unsigned int ns);
 
+/** Measure the speed of the wait_ns() loop.
+ *
+ * The loop takes a known number of cycles per iteration on the cores listed
+ * in mbed_wait_api_no_rtos.c, as long as it runs without wait states. This
+ * measures it against the DWT cycle counter, or the us ticker, instead. It is
+ * done on the first call to wait_ns() from a thread on other Cortex-M cores,
+ * calls from interrupt handlers before it assume one cycle per iteration,
+ * so they wait longer than asked.
+ *
+ * wait_ns() follows changes of SystemCoreClock, but call this function after
+ * changing the core clock if that also changes the flash wait states.
+ *
+ * On a warm boot, see mbed_warm_boot.h, the speed measured by the previous
+ * boot at the same SystemCoreClock is reused instead of measured again.
+ *
+ * @note This masks interrupts for about 100 microseconds, plus a probe of
+ *   10 to 60 microseconds, when it uses the us ticker.
+ */
+void wait_ns_calibrate(void);
+
 /* Optimize if we know the rate */
 #if DEVICE_USTICKER && defined US_TICKER_PERIOD_NUM
 void _wait_us_ticks(uint32_t ticks);
@@ -15,9 +15,13 @@
  */
 
 #include "cmsis.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
 #include "bootstrap/mbed_toolchain.h"
 #include "bootstrap/mbed_wait_api.h"
+#include "bootstrap/mbed_warm_boot.h"
 
+#include "hal/cycle_counter_api.h"
 #include "hal/lp_ticker_api.h"
 #include "hal/us_ticker_api.h"
 #include "hal/ticker_api.h"
@@ -27,6 +31,46 @@
 
 #if DEVICE_USTICKER
 
+#if MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
+#define us_ticker_is_initialized() true
+#else
+extern bool _us_ticker_initialized;
+#define us_ticker_is_initialized() core_util_atomic_load_bool(&_us_ticker_initialized)
+#endif
+
+/* Wait without the scaling and widening of ticker_read() in the loop, by
+ * converting the time to cycles or ticks once and spinning on the raw
+ * counter. Returns false if the time is too long to be counted that way.
+ */
+static bool wait_us_raw(const ticker_data_t *const ticker, uint32_t us)
+{
+#if DEVICE_CYCLE_COUNTER
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    if (cycles_per_us != 0 && us < UINT32_MAX / 2 / cycles_per_us) {
+        hal_cycle_counter_init();
+        const uint32_t cycles = us * cycles_per_us;
+        const uint32_t start = hal_cycle_counter_read();
+        while ((hal_cycle_counter_read() - start) < cycles);
+        return true;
+    }
+#endif
+
+    if (!us_ticker_is_initialized()) {
+        return false;
+    }
+    const ticker_info_t *info = ticker->interface->get_info();
+    const uint32_t mask = info->bits >= 32 ? UINT32_MAX : (1UL << info->bits) - 1;
+    // Round up, so the wait is not shorter than requested
+    const uint64_t ticks = ((uint64_t)us * info->frequency + 999999) / 1000000;
+    if (ticks > mask / 2) {
+        return false;
+    }
+
+    const uint32_t start = ticker->interface->read();
+    while (((ticker->interface->read() - start) & mask) < ticks);
+    return true;
+}
+
 #if defined US_TICKER_PERIOD_NUM
 /* Real definition for binary compatibility with binaries not using the new macro */
 void (wait_us)(int us)
@@ -48,8 +92,12 @@ void _wait_us_generic(unsigned int us)
 void wait_us(int us)
 #endif
 {
-    // Generic version using full ticker, allowing for initialization, scaling and widening of timer
     const ticker_data_t *const ticker = get_us_ticker_data();
+    if (wait_us_raw(ticker, (uint32_t)us)) {
+        return;
+    }
+
+    // Generic version using full ticker, allowing for initialization, scaling and widening of timer
     const uint32_t start = ticker_read(ticker);
     while ((ticker_read(ticker) - start) < (uint32_t)us);
 }
@@ -96,6 +144,11 @@ void wait_us(int us)
 #endif
 #endif
 
+#if !defined LOOP_SCALER && defined __CORTEX_M
+// Other Cortex-M cores run the same Thumb loop, measured by wait_ns_calibrate()
+#define LOOP_SCALER 0
+#endif
+
 /* We only define the function if we've identified the CPU. If we haven't,
  * rather than a compile-time error, leave it undefined, rather than faulting
  * with an immediate #error. This leaves the door open to non-ARM
@@ -108,7 +161,13 @@ void wait_us(int us)
  * functions well. So sidestep that by hand-assembling the code. Also avoids
  * the hassle of handling multiple toolchains with different assembler
  * syntax.
+ *
+ * With MBED_CONF_PLATFORM_RAMFUNC_ENABLED, the loop is copied to RAM with the
+ * MBED_RAMFUNC functions, so its timing doesn't depend on flash wait states.
  */
+#if MBED_CONF_PLATFORM_RAMFUNC_ENABLED
+MBED_SECTION(".ramfunc.delay_loop")
+#endif
 MBED_ALIGN(16)
 static const uint16_t delay_loop_code[] = {
     0x1E40, // SUBS R0,R0,#1
@@ -121,16 +180,81 @@ static const uint16_t delay_loop_code[] = {
 /* Take the address of the code, set LSB to indicate Thumb, and cast to void() function pointer */
 #define delay_loop ((void(*)()) ((uintptr_t) delay_loop_code + 1))
 
+// 1000 times the cycles per loop iteration, 0 until measured on unidentified cores
+static uint32_t loop_scaler = LOOP_SCALER;
+
+void wait_ns_calibrate(void)
+{
+    uint32_t scaler = 0;
+
+    // The previous boot measured the loop at the same clock, with the same wait states
+    uint32_t clock;
+    if (mbed_warm_boot_is_warm() && mbed_warm_boot_get(MBED_WARM_BOOT_WAIT_NS_CLOCK, &clock) &&
+            clock == SystemCoreClock && mbed_warm_boot_get(MBED_WARM_BOOT_WAIT_NS_SCALER, &scaler) && scaler != 0) {
+        loop_scaler = scaler;
+        return;
+    }
+
+    core_util_critical_section_enter();
+#if DEVICE_CYCLE_COUNTER
+    {
+        const uint32_t iterations = 1000;
+        hal_cycle_counter_init();
+        const uint32_t start = hal_cycle_counter_read();
+        delay_loop(iterations);
+        scaler = hal_cycle_counter_read() - start;
+    }
+#elif DEVICE_USTICKER
+    {
+        // A probe of at least 10us sizes a measurement of about 100us, timed to
+        // 1%, so that the interrupts stay masked for well under a millisecond
+        const uint32_t cycles_per_us = SystemCoreClock / 1000000;
+        const ticker_data_t *const ticker = get_us_ticker_data();
+        uint32_t iterations = 10 * cycles_per_us;
+        us_timestamp_t start = ticker_read_us(ticker);
+        delay_loop(iterations);
+        us_timestamp_t elapsed = ticker_read_us(ticker) - start;
+
+        iterations = (uint32_t)(iterations * 100 / (elapsed != 0 ? elapsed : 1));
+        start = ticker_read_us(ticker);
+        delay_loop(iterations);
+        elapsed = ticker_read_us(ticker) - start;
+        scaler = iterations != 0 ? (uint32_t)(elapsed * cycles_per_us * 1000 / iterations) : 0;
+    }
+#endif
+    core_util_critical_section_exit();
+
+    if (scaler != 0) {
+        mbed_warm_boot_set(MBED_WARM_BOOT_WAIT_NS_CLOCK, SystemCoreClock);
+        mbed_warm_boot_set(MBED_WARM_BOOT_WAIT_NS_SCALER, scaler);
+    }
+
+    // Without a timer, assume one cycle per iteration, which can only wait longer
+    loop_scaler = scaler != 0 ? scaler : 1000;
+}
+
 /* Some targets may not provide zero-wait-state flash performance. Export this function
  * to be overridable for targets to provide more accurate implementation like locating
  * 'delay_loop_code' in SRAM. */
-MBED_WEAK void wait_ns(unsigned int ns)
+MBED_WEAK MBED_RAMFUNC void wait_ns(unsigned int ns)
 {
+    uint32_t scaler = loop_scaler;
+    if (scaler == 0) {
+        // An interrupt handler can't afford the measurement, it assumes one
+        // cycle per iteration, which can only wait longer, until a thread measures
+        if (core_util_is_isr_active()) {
+            scaler = 1000;
+        } else {
+            wait_ns_calibrate();
+            scaler = loop_scaler;
+        }
+    }
+
     uint32_t cycles_per_us = SystemCoreClock / 1000000;
     // Note that this very calculation, plus call overhead, will take multiple
     // cycles. Could well be 100ns on its own... So round down here, startup is
     // worth at least one loop iteration.
-    uint32_t count = (cycles_per_us * ns) / LOOP_SCALER;
+    uint32_t count = (cycles_per_us * ns) / scaler;
 
     delay_loop(count);
 }
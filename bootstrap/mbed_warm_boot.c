@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_warm_boot.h"
+
+#if MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+
+#include <stddef.h>
+#include <string.h>
+#include "device.h"
+#include "mbed_assert.h"
+#include "mbed_critical.h"
+
+#if DEVICE_RESET_REASON
+#include "hal/reset_reason_api.h"
+#endif
+
+#define WARM_BOOT_MAGIC 0x57524D42UL // "WRMB"
+
+MBED_STATIC_ASSERT(MBED_WARM_BOOT_VALUES <= 32, "The warm boot record holds 32 values at most");
+
+typedef struct {
+    uint32_t magic;
+    uint32_t set;                           // Bit n set if value n is valid
+    uint32_t values[MBED_WARM_BOOT_VALUES];
+    uint32_t check;
+} warm_boot_record_t;
+
+MBED_NOINIT static warm_boot_record_t record;
+static bool warm;
+
+// Not weak, a linker script without the bracket fails to link instead of
+// leaving the MBED_WARM_RETAINED variables with garbage after a power-on
+#if defined(__ARMCC_VERSION)
+extern uint32_t Image$$RW_WARM_RETAINED$$ZI$$Base[];
+extern uint32_t Image$$RW_WARM_RETAINED$$ZI$$Limit[];
+#define RETAINED_START Image$$RW_WARM_RETAINED$$ZI$$Base
+#define RETAINED_END Image$$RW_WARM_RETAINED$$ZI$$Limit
+#else
+extern uint32_t __warm_retained_start__[];
+extern uint32_t __warm_retained_end__[];
+#define RETAINED_START __warm_retained_start__
+#define RETAINED_END __warm_retained_end__
+#endif
+
+// Checked at each read, so a stray write to the record only costs a measurement
+static uint32_t record_check(void)
+{
+    const uint32_t *word = (const uint32_t *)&record;
+    uint32_t check = WARM_BOOT_MAGIC;
+
+    for (size_t i = 0; i < offsetof(warm_boot_record_t, check) / sizeof(uint32_t); i++) {
+        check = ((check << 7) | (check >> 25)) ^ word[i];
+    }
+    return ~check;
+}
+
+static bool record_is_valid(void)
+{
+    return record.magic == WARM_BOOT_MAGIC && record.check == record_check();
+}
+
+static void record_reset(void)
+{
+    memset(&record, 0, sizeof(record));
+    record.magic = WARM_BOOT_MAGIC;
+    record.check = record_check();
+}
+
+void mbed_warm_boot_init(void)
+{
+#if DEVICE_RESET_REASON
+    const reset_reason_t reason = hal_reset_reason_get();
+    warm = (reason == RESET_REASON_WATCHDOG || reason == RESET_REASON_SOFTWARE || reason == RESET_REASON_LOCKUP) &&
+           record_is_valid();
+#endif
+
+    if (!warm) {
+        record_reset();
+        memset(RETAINED_START, 0, (uintptr_t)RETAINED_END - (uintptr_t)RETAINED_START);
+    }
+}
+
+bool mbed_warm_boot_is_warm(void)
+{
+    return warm;
+}
+
+bool mbed_warm_boot_get(mbed_warm_boot_value_t id, uint32_t *value)
+{
+    bool found = false;
+
+    core_util_critical_section_enter();
+    if (id < MBED_WARM_BOOT_VALUES && record_is_valid() && (record.set & (1UL << id))) {
+        *value = record.values[id];
+        found = true;
+    }
+    core_util_critical_section_exit();
+
+    return found;
+}
+
+void mbed_warm_boot_set(mbed_warm_boot_value_t id, uint32_t value)
+{
+    MBED_ASSERT(id < MBED_WARM_BOOT_VALUES);
+
+    core_util_critical_section_enter();
+    if (!record_is_valid()) {
+        record_reset();
+    }
+    record.values[id] = value;
+    record.set |= 1UL << id;
+    record.check = record_check();
+    core_util_critical_section_exit();
+}
+
+#endif // MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
@@ -0,0 +1,167 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_WARM_BOOT_H
+#define MBED_WARM_BOOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mbed_toolchain.h"
+
+/* Keep calibration values and MBED_WARM_RETAINED variables over watchdog, software and lockup resets */
+#ifndef MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+#define MBED_CONF_PLATFORM_WARM_BOOT_ENABLED 0
+#endif
+
+/* Number of values the target keeps in the warm boot record, from MBED_WARM_BOOT_TARGET on */
+#ifndef MBED_CONF_PLATFORM_WARM_BOOT_TARGET_VALUES
+#define MBED_CONF_PLATFORM_WARM_BOOT_TARGET_VALUES 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup rtos-internal-api */
+/** @{*/
+
+/**
+ * \defgroup warm_boot Warm boot
+ * Boot fast path after a reset which kept the RAM content
+ *
+ * A watchdog, software or lockup reset, as reported by
+ * ::hal_reset_reason_get, leaves the RAM as it was. With
+ * MBED_CONF_PLATFORM_WARM_BOOT_ENABLED, ::mbed_init checks the reset reason
+ * and a record in `.noinit` so that the boot after such a reset can skip
+ * the work done by the previous boot:
+ * - Values measured at boot, such as the speed of the wait_ns() loop or the
+ *   trims of the oscillators, are kept in the record with
+ *   ::mbed_warm_boot_set and read back with ::mbed_warm_boot_get instead
+ *   of being measured again.
+ * - Variables declared with MBED_WARM_RETAINED are only zeroed after the
+ *   other resets.
+ *
+ * Any other reset reason, a target without DEVICE_RESET_REASON, or a record
+ * which doesn't match its magic number and checksum, makes a cold boot,
+ * which forgets the values.
+ *
+ * @code
+ * void mbed_sdk_init(void)
+ * {
+ *     uint32_t trim;
+ *     if (!mbed_warm_boot_get(MBED_WARM_BOOT_TARGET, &trim)) {
+ *         trim = measure_hsi_trim();
+ *         mbed_warm_boot_set(MBED_WARM_BOOT_TARGET, trim);
+ *     }
+ *     set_hsi_trim(trim);
+ * }
+ * @endcode
+ *
+ * @{
+ */
+
+/** MBED_WARM_RETAINED
+ *  Declare a variable which keeps its value over a warm boot.
+ *
+ *  The variable is placed in the `.noinit.warm_retained` section, which the
+ *  linker script places between `__warm_retained_start__` and
+ *  `__warm_retained_end__`, inside the range the startup code doesn't
+ *  zero. ::mbed_init zeroes it on a cold boot, so it reads as 0 after a
+ *  power-on, as a `.bss` variable does. With
+ *  MBED_CONF_PLATFORM_WARM_BOOT_ENABLED, the link fails if the linker
+ *  script doesn't define these symbols, see docs/porting/startup.md.
+ *
+ *  Without MBED_CONF_PLATFORM_WARM_BOOT_ENABLED, the variable is zeroed at
+ *  each boot.
+ *
+ *  @code
+ *  #include "mbed_warm_boot.h"
+ *
+ *  MBED_WARM_RETAINED static uint32_t reboot_count;
+ *  @endcode
+ */
+#ifndef MBED_WARM_RETAINED
+#if MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+#define MBED_WARM_RETAINED MBED_SECTION(".noinit.warm_retained")
+#else
+#define MBED_WARM_RETAINED
+#endif
+#endif
+
+/** Values of the warm boot record */
+typedef enum {
+    MBED_WARM_BOOT_WAIT_NS_CLOCK,  /**< SystemCoreClock the wait_ns() loop was measured at */
+    MBED_WARM_BOOT_WAIT_NS_SCALER, /**< Core cycles taken by 1000 iterations of the wait_ns() loop */
+    MBED_WARM_BOOT_TARGET,         /**< First of the MBED_CONF_PLATFORM_WARM_BOOT_TARGET_VALUES values of the target */
+    MBED_WARM_BOOT_VALUES = MBED_WARM_BOOT_TARGET + MBED_CONF_PLATFORM_WARM_BOOT_TARGET_VALUES
+} mbed_warm_boot_value_t;
+
+#if MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+
+/**
+ * Decide between a warm and a cold boot
+ *
+ * Called by ::mbed_init before ::mbed_sdk_init. A cold boot forgets the
+ * values of the record and zeroes the MBED_WARM_RETAINED variables.
+ * The reset reason isn't cleared, the application still reads it with
+ * ::hal_reset_reason_get.
+ */
+void mbed_warm_boot_init(void);
+
+/**
+ * Check if this boot is a warm boot
+ *
+ * @return true after a watchdog, software or lockup reset which kept a valid
+ *   record, false otherwise
+ */
+bool mbed_warm_boot_is_warm(void);
+
+/**
+ * Read a value of the record
+ *
+ * @param id    The value
+ * @param value Receives the value
+ * @return true if the value was set since the last cold boot, false otherwise
+ */
+bool mbed_warm_boot_get(mbed_warm_boot_value_t id, uint32_t *value);
+
+/**
+ * Set a value of the record, kept until the next cold boot
+ *
+ * @param id    The value
+ * @param value The value
+ */
+void mbed_warm_boot_set(mbed_warm_boot_value_t id, uint32_t value);
+
+#else
+
+#define mbed_warm_boot_init() ((void)0)
+#define mbed_warm_boot_is_warm() false
+#define mbed_warm_boot_get(id, value) ((void)(id), (void)(value), false)
+#define mbed_warm_boot_set(id, value) ((void)(id), (void)(value))
+
+#endif // MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_WARM_BOOT_H
@@ -48,7 +48,7 @@ int main()
     ret = flash_erase_sector(&test_flash, erase_sector_boundary);
     //TEST_ASSERT_EQUAL_INT32(0, ret);
 
-    ret = flash_program_page(&test_flash, address, data, test_size);
+    ret = flash_program(&test_flash, address, data, test_size);
     //TEST_ASSERT_EQUAL_INT32(0, ret);
 
     ret = flash_read(&test_flash, address, data_flashed, test_size);
@@ -63,7 +63,7 @@ int main()
     // write another data to be certain we are re-flashing
     memset(data, 0xAC, test_size);
     
-    ret = flash_program_page(&test_flash, address, data, test_size);
+    ret = flash_program(&test_flash, address, data, test_size);
     //TEST_ASSERT_EQUAL_INT32(0, ret);
 
     ret = flash_read(&test_flash, address, data_flashed, test_size);
@@ -0,0 +1,243 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_AES_API_H
+#define MBED_AES_API_H
+
+#include "device.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Size of the AES blocks, in bytes */
+#define HAL_AES_BLOCK_SIZE 16
+
+/** Largest key size, in bytes */
+#define HAL_AES_MAX_KEY_SIZE 32
+
+/* Blocks processed per critical section by hal_aes_ctx_update(), which
+ * bounds the interrupt latency it adds. Large buffers should use
+ * hal_aes_ctx_update_async().
+ */
+#ifndef MBED_CONF_TARGET_AES_SECTION_BLOCKS
+#define MBED_CONF_TARGET_AES_SECTION_BLOCKS 16
+#endif
+
+/** AES block cipher mode
+ */
+typedef enum hal_aes_mode {
+    HAL_AES_MODE_ECB, ///< Electronic codebook, no initialization vector
+    HAL_AES_MODE_CBC, ///< Cipher block chaining
+    HAL_AES_MODE_CTR  ///< Counter, the initialization vector is the first counter block
+} hal_aes_mode_t;
+
+typedef struct aes_mbed_config {
+    /** Block cipher mode */
+    hal_aes_mode_t mode;
+    /** Key size in bits: 128, 192 or 256 */
+    uint32_t key_bits;
+    /** Decrypt rather than encrypt, CTR mode does both the same way */
+    bool decrypt;
+} aes_mbed_config_t;
+
+/** AES computation context
+ *
+ * Holds the configuration, the key and the chaining value of one
+ * computation, so several computations can share the AES module.
+ */
+typedef struct hal_aes_ctx {
+    /** Configuration given to hal_aes_ctx_start() */
+    aes_mbed_config_t config;
+    /** Key, config.key_bits / 8 bytes are used */
+    uint8_t key[HAL_AES_MAX_KEY_SIZE];
+    /** Last ciphertext block in CBC mode, next counter block in CTR mode */
+    uint8_t iv[HAL_AES_BLOCK_SIZE];
+} hal_aes_ctx_t;
+
+/** Handler called when an asynchronous AES operation completes
+ * @param id The id given to the asynchronous function
+ */
+typedef void (*hal_aes_async_handler)(uint32_t id);
+
+#if DEVICE_AES
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_aes Hardware AES
+ *
+ * The hardware AES HAL API provides a low-level interface to the AES
+ * accelerator of a target platform.
+ *
+ * Targets implement the block functions: hal_aes_crypt_partial_start() loads
+ * the key and the chaining value, hal_aes_crypt_partial() encrypts or
+ * decrypts complete blocks and hal_aes_get_iv() reads the chaining value
+ * back. The context functions are built upon them and keep the state of each
+ * computation in a hal_aes_ctx_t, so that computations can be interleaved.
+ * Targets with DMA override hal_aes_crypt_partial_async().
+ *
+ * # Defined behaviour
+ *
+ * * Macro HAL_AES_IS_SUPPORTED() evaluates true for 128 bit keys in ECB, CBC
+ *   and CTR modes - verified by test ::aes_is_supported_test.
+ * * The FIPS 197 and SP 800-38A examples are encrypted and decrypted for every
+ *   supported mode and key size - verified by test ::aes_crypt_test.
+ * * Function hal_aes_ctx_update() can be called multiple times in succession
+ *   - verified by test ::aes_crypt_multi_test.
+ * * Function hal_aes_ctx_update() returns -1 if the data size is not a
+ *   multiple of HAL_AES_BLOCK_SIZE - verified by test ::aes_crypt_multi_test.
+ * * Computations in different hal_aes_ctx_t contexts can be interleaved
+ *   - verified by test ::aes_ctx_interleave_test.
+ * * Function hal_aes_ctx_update_async() calls its handler once the data is
+ *   processed - verified by test ::aes_ctx_interleave_test.
+ *
+ * # Undefined behaviour
+ *
+ * * Calling hal_aes_ctx_start() with an unsupported mode or key size.
+ * * Calling hal_aes_ctx_update() while an asynchronous update is in progress.
+ * * Modifying the data or the context of an asynchronous update before its
+ *   handler is called.
+ *
+ * # Macros
+ *
+ * Platform support for AES modes is indicated by the macro
+ * HAL_AES_IS_SUPPORTED(mode, key_bits), which must be defined in device.h, or
+ * a file included from there. It must evaluate to a constant boolean
+ * expression when given constant parameters.
+ *
+ * Example:
+ *
+ *    #define HAL_AES_IS_SUPPORTED(mode, key_bits) ((key_bits) != 192)
+ * @{
+ */
+
+/** Load the key and the chaining value into the AES module
+ *
+ * This function must be called with a mode and key size supported by the
+ * platform.
+ *
+ * \param config The configuration
+ * \param key    The key, config->key_bits / 8 bytes
+ * \param iv     The chaining value, ignored in ECB mode
+ */
+void hal_aes_crypt_partial_start(const aes_mbed_config_t *config, const uint8_t *key, const uint8_t *iv);
+
+/** Encrypt or decrypt complete blocks
+ *
+ * The chaining value is kept in the AES module so that more blocks can be
+ * processed. The input and output may be the same buffer.
+ *
+ * \param input  Input data, count * HAL_AES_BLOCK_SIZE bytes
+ * \param output Output data, count * HAL_AES_BLOCK_SIZE bytes
+ * \param count  Number of blocks
+ */
+void hal_aes_crypt_partial(const uint8_t *input, uint8_t *output, size_t count);
+
+/** Encrypt or decrypt complete blocks without blocking
+ *
+ * Targets feed the AES module with DMA where available and call the handler
+ * from interrupt context once done. The buffers must stay valid until then.
+ * The default implementation calls hal_aes_crypt_partial() and the handler
+ * before returning.
+ *
+ * \param input   Input data, count * HAL_AES_BLOCK_SIZE bytes
+ * \param output  Output data, count * HAL_AES_BLOCK_SIZE bytes
+ * \param count   Number of blocks
+ * \param handler The completion handler
+ * \param id      The id passed to the handler
+ */
+void hal_aes_crypt_partial_async(const uint8_t *input, uint8_t *output, size_t count,
+                                 hal_aes_async_handler handler, uint32_t id);
+
+/** Read the chaining value back from the AES module
+ *
+ * This is the last ciphertext block in CBC mode and the next counter block
+ * in CTR mode. It is not called in ECB mode.
+ *
+ * \param iv The chaining value, HAL_AES_BLOCK_SIZE bytes
+ */
+void hal_aes_get_iv(uint8_t *iv);
+
+/** Start a computation in a context
+ *
+ * The AES module is not touched; computations in different contexts can be
+ * interleaved with each other.
+ *
+ * \param ctx    The context to initialize
+ * \param config The configuration, checked for support with HAL_AES_IS_SUPPORTED()
+ * \param key    The key, config->key_bits / 8 bytes
+ * \param iv     The initialization vector, HAL_AES_BLOCK_SIZE bytes, NULL in ECB mode
+ */
+void hal_aes_ctx_start(hal_aes_ctx_t *ctx, const aes_mbed_config_t *config, const uint8_t *key, const uint8_t *iv);
+
+/** Encrypt or decrypt data in a context
+ *
+ * The AES module is loaded with the context state, fed with the data and its
+ * chaining value is saved back to the context. This is done in critical
+ * sections of up to MBED_CONF_TARGET_AES_SECTION_BLOCKS blocks, so contexts
+ * can be used from different threads and interrupts.
+ *
+ * A last CTR block shorter than HAL_AES_BLOCK_SIZE is processed by padding it
+ * to a complete block and keeping the start of the output.
+ *
+ * \param ctx    The context
+ * \param input  Input data
+ * \param output Output data, may be the input buffer
+ * \param size   Size of the data in bytes, a multiple of HAL_AES_BLOCK_SIZE
+ * \return 0 on success, -1 if the size is not a multiple of HAL_AES_BLOCK_SIZE
+ */
+int hal_aes_ctx_update(hal_aes_ctx_t *ctx, const uint8_t *input, uint8_t *output, size_t size);
+
+/** Encrypt or decrypt data in a context without blocking
+ *
+ * The blocks are fed with hal_aes_crypt_partial_async(), the handler is
+ * called from interrupt context once done. The buffers and the context must
+ * stay valid until then.
+ *
+ * \param ctx     The context
+ * \param input   Input data
+ * \param output  Output data, may be the input buffer
+ * \param size    Size of the data in bytes, a multiple of HAL_AES_BLOCK_SIZE
+ * \param handler The completion handler
+ * \param id      The id passed to the handler
+ * \return 0 if the update was started, -1 if the size is not a multiple of
+ *         HAL_AES_BLOCK_SIZE or the AES module is busy with another
+ *         asynchronous update, the handler is not called then
+ */
+int hal_aes_ctx_update_async(hal_aes_ctx_t *ctx, const uint8_t *input, uint8_t *output, size_t size,
+                             hal_aes_async_handler handler, uint32_t id);
+
+/** Clear the key and the chaining value of a context
+ *
+ * \param ctx The context
+ */
+void hal_aes_ctx_free(hal_aes_ctx_t *ctx);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_AES
+#endif // MBED_AES_API_H
+
+/**@}*/
@@ -22,6 +22,9 @@
 
 #include "device.h"
 #include "pinmap.h"
+#include "pwmout_api.h"
+
+#include <stddef.h>
 
 #if DEVICE_ANALOGIN
 
@@ -33,6 +36,61 @@ extern "C" {
  */
 typedef struct analogin_s analogin_t;
 
+/** Analogin capabilities structure
+ */
+typedef struct {
+    uint32_t resolutions;          /**< Each bit n set for a supported resolution of n + 1 bits, 0 if the resolution is fixed */
+    uint16_t max_oversampling;     /**< Highest hardware oversampling ratio, a power of 2, 1 without hardware oversampling */
+    uint32_t min_sampling_time_ns; /**< Shortest sampling time, 0 if the sampling time is fixed */
+    uint32_t max_sampling_time_ns; /**< Longest sampling time, 0 if the sampling time is fixed */
+} analogin_capabilities_t;
+
+/** Analogin conversion configuration
+ */
+typedef struct {
+    uint8_t resolution;            /**< Resolution in bits, 0 for the default */
+    uint16_t oversampling;         /**< Conversions averaged in hardware per result, a power of 2, 1 for none */
+    uint32_t sampling_time_ns;     /**< Shortest sampling time, rounded up to the next supported one, 0 for the default */
+} analogin_config_t;
+
+/** Analogin watchdog events
+ */
+typedef enum {
+    ANALOGIN_WATCHDOG_LOW,  /**< A conversion was below the low threshold */
+    ANALOGIN_WATCHDOG_HIGH, /**< A conversion was above the high threshold */
+} analogin_watchdog_event_t;
+
+/** Analogin watchdog handler
+ *
+ * @param id    The id given to ::analogin_watchdog_set
+ * @param event The threshold crossed
+ * @param value The conversion out of the window, normalized as for ::analogin_read_u16
+ */
+typedef void (*analogin_watchdog_handler)(uint32_t id, analogin_watchdog_event_t event, uint16_t value);
+
+/** Analogin scan handler
+ *
+ * @param id      The id given to ::analogin_scan_init
+ * @param samples The completed half of the scan buffer
+ * @param count   The number of samples in the completed half
+ */
+typedef void (*analogin_scan_handler)(uint32_t id, const uint16_t *samples, size_t count);
+
+/** Analogin scan structure
+ */
+typedef struct {
+    analogin_t *const *channels;   /**< Channels converted in each frame */
+    size_t channel_count;          /**< Number of channels */
+    uint16_t *buffer;              /**< Double buffer of frames */
+    size_t length;                 /**< Size of the buffer in samples */
+    size_t pos;                    /**< Position of the next sample */
+    analogin_scan_handler handler; /**< Called when a half of the buffer is full */
+    uint32_t id;                   /**< Id passed to the handler */
+#if DEVICE_PWMOUT
+    pwmout_t *pwm;                 /**< PWM output triggering the scan, or NULL */
+#endif
+} analogin_scan_t;
+
 /**
  * \defgroup hal_analogin Analogin hal functions
  *
@@ -43,6 +101,19 @@ typedef struct analogin_s analogin_t;
  * * The function ::analogin_read_u16 reads the value from analogin pin, represented as an unsigned 16bit value [0.0 (GND), MAX_UINT16 (VCC)]
  * * The accuracy of the ADC is +/- 10%
  * * The ADC operations ::analogin_read, ::analogin_read_u16 take less than 20us to complete
+ * * The function ::analogin_get_capabilities fills the given `analogin_capabilities_t` instance - TBD (basic test)
+ * * The function ::analogin_configure sets the resolution, the oversampling ratio and the sampling time of the following conversions, or returns -1 if not supported - TBD (basic test)
+ * * ::analogin_read_u16 returns oversampled results normalized to 16 bits, as for single conversions - TBD (basic test)
+ * * The function ::analogin_read_average_u16 returns the average of `count` results of ::analogin_read_u16 - TBD (basic test)
+ * * The function ::analogin_watchdog_set converts the channel continuously in hardware, or returns -1 if not supported - TBD (basic test)
+ * * The watchdog handler is called once, from interrupt context, by the first conversion out of the window - TBD (basic test)
+ * * The function ::analogin_watchdog_clear stops the watchdog - TBD (basic test)
+ * * The function ::analogin_scan_init returns -1 if the buffer does not hold a whole number of frames in each half - TBD (basic test)
+ * * The function ::analogin_scan_start converts all the channels of the scan at `sample_rate_hz` frames per second, or returns -1 if not supported - TBD (basic test)
+ * * The function ::analogin_scan_frame converts one frame, as with ::analogin_read_u16 - TBD (basic test)
+ * * The scan handler is called, with the first half and then with the second half, each time a half of the buffer is full - TBD (basic test)
+ * * The function ::analogin_scan_start_pwm converts one frame per PWM period, `offset_us` after the start of the period, or returns -1 if not supported - TBD (basic test)
+ * * The function ::analogin_scan_stop stops the conversions started by ::analogin_scan_start or ::analogin_scan_start_pwm - TBD (basic test)
  *
  * # Undefined behaviour
  *
@@ -98,6 +169,133 @@ uint16_t analogin_read_u16(analogin_t *obj);
  */
 const PinMap *analogin_pinmap(void);
 
+/** Get the conversion capabilities of the analogin peripheral
+ *
+ * The default implementation reports a fixed resolution and sampling time,
+ * without hardware oversampling.
+ *
+ * @param obj The initialized analogin object
+ * @param cap The capabilities to fill
+ */
+void analogin_get_capabilities(analogin_t *obj, analogin_capabilities_t *cap);
+
+/** Configure the conversions of the analogin peripheral
+ *
+ * Hardware oversampling averages `oversampling` conversions per result of
+ * ::analogin_read_u16 and of the scans, the extra precision showing in the
+ * lower bits of the 16-bit result. The default implementation only accepts
+ * the default configuration.
+ *
+ * @param obj    The initialized analogin object
+ * @param config The configuration, within the capabilities
+ * @return 0 on success, -1 if the configuration is not supported
+ */
+int analogin_configure(analogin_t *obj, const analogin_config_t *config);
+
+/** Read the average of several conversions by software
+ *
+ * For averaging ratios above the hardware oversampling.
+ *
+ * @param obj   The analogin object
+ * @param count The number of results of ::analogin_read_u16 to average, at least 1
+ * @return The average, rounded to nearest
+ */
+uint16_t analogin_read_average_u16(analogin_t *obj, uint16_t count);
+
+/** Watch the channel for conversions out of a window
+ *
+ * The peripheral converts the channel continuously and compares the results
+ * with the thresholds in hardware, interrupting the CPU only when one of
+ * them is crossed. The watchdog stops after calling the handler, so that a
+ * channel out of the window does not interrupt the CPU on every conversion;
+ * calling this function again rearms it, from the handler or later.
+ *
+ * Conversions of ::analogin_read_u16 and of the scans may be refused while
+ * the watchdog runs, depending on the peripheral. The default implementation
+ * returns -1.
+ *
+ * @param obj     The initialized analogin object
+ * @param low     The low threshold, normalized as for ::analogin_read_u16
+ * @param high    The high threshold, normalized as for ::analogin_read_u16
+ * @param handler Called from interrupt context when a threshold is crossed
+ * @param id      The id passed to the handler
+ * @return 0 on success, -1 if the watchdog is not supported for the channel
+ */
+int analogin_watchdog_set(analogin_t *obj, uint16_t low, uint16_t high, analogin_watchdog_handler handler, uint32_t id);
+
+/** Stop the watchdog started by ::analogin_watchdog_set
+ *
+ * @param obj The analogin object
+ */
+void analogin_watchdog_clear(analogin_t *obj);
+
+/** Initialize a multi-channel scan
+ *
+ * Each frame of the scan holds one sample of every channel, in the order of
+ * `channels`. Frames are stored one after another to `buffer`, which is used
+ * as a double buffer: the handler is called with one half while the other
+ * half is filled.
+ *
+ * @param scan          The scan object to initialize
+ * @param channels      The initialized analogin objects to convert
+ * @param channel_count The number of channels
+ * @param buffer        The buffer for the samples
+ * @param length        The size of the buffer in samples, a multiple of 2 * `channel_count`
+ * @param handler       Called from interrupt context when a half of the buffer is full
+ * @param id            The id passed to the handler
+ * @return 0 on success, -1 if the parameters are invalid
+ */
+int analogin_scan_init(analogin_scan_t *scan, analogin_t *const *channels, size_t channel_count, uint16_t *buffer, size_t length, analogin_scan_handler handler, uint32_t id);
+
+/** Start converting the scan at a fixed rate
+ *
+ * Targets should implement this with a hardware trigger and DMA into the
+ * scan buffer, calling the handler on the half and full transfer complete
+ * interrupts. The default implementation returns -1; the scan can then be
+ * driven from a timer interrupt with ::analogin_scan_frame.
+ *
+ * @param scan           The initialized scan object
+ * @param sample_rate_hz The number of frames per second
+ * @return 0 on success, -1 if the rate or the channels are not supported
+ */
+int analogin_scan_start(analogin_scan_t *scan, uint32_t sample_rate_hz);
+
+#if DEVICE_PWMOUT
+/** Start converting the scan synchronized to a PWM output
+ *
+ * One frame is converted per PWM period, `offset_us` after the start of the
+ * period, for example in the middle of the pulse to sample the motor current.
+ * A buffer of two frames makes the handler stream every frame as soon as
+ * it is converted.
+ *
+ * Targets should implement this by routing the PWM timer to the ADC hardware
+ * trigger, so the sampling point does not depend on interrupt latency. The
+ * default implementation supports only an offset of 0 and converts the frame
+ * with ::analogin_scan_frame from the interrupt set with ::pwmout_period_irq_set.
+ *
+ * @param scan      The initialized scan object
+ * @param pwm       The initialized pwmout object
+ * @param offset_us The sampling point from the start of the PWM period in microseconds
+ * @return 0 on success, -1 if the PWM output or the offset is not supported
+ */
+int analogin_scan_start_pwm(analogin_scan_t *scan, pwmout_t *pwm, int offset_us);
+#endif
+
+/** Stop the conversions started by ::analogin_scan_start or ::analogin_scan_start_pwm
+ *
+ * @param scan The scan object
+ */
+void analogin_scan_stop(analogin_scan_t *scan);
+
+/** Convert one frame of the scan by software
+ *
+ * Reads every channel with ::analogin_read_u16 to the next frame of the
+ * buffer and calls the handler when a half of the buffer is full.
+ *
+ * @param scan The initialized scan object
+ */
+void analogin_scan_frame(analogin_scan_t *scan);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -23,6 +23,8 @@
 #include "device.h"
 #include "pinmap.h"
 
+#include <stddef.h>
+
 #if DEVICE_ANALOGOUT
 
 #ifdef __cplusplus
@@ -33,6 +35,25 @@ extern "C" {
  */
 typedef struct dac_s dac_t;
 
+/** Analogout stream handler
+ *
+ * @param id      The id given to ::analogout_stream_init
+ * @param samples The half of the stream buffer which was output, to refill
+ * @param count   The number of samples in the half
+ */
+typedef void (*analogout_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/** Analogout stream structure
+ */
+typedef struct {
+    dac_t *dac;                      /**< DAC the samples are output to */
+    uint16_t *buffer;                /**< Double buffer of samples */
+    size_t length;                   /**< Size of the buffer in samples */
+    size_t pos;                      /**< Position of the next sample */
+    analogout_stream_handler handler; /**< Called when a half of the buffer was output */
+    uint32_t id;                     /**< Id passed to the handler */
+} analogout_stream_t;
+
 /**
  * \defgroup hal_analogout Analogout hal functions
  *
@@ -45,6 +66,11 @@ typedef struct dac_s dac_t;
  * * The accuracy of the DAC is +/- 10%
  * * The DAC operations ::analogout_write, ::analogout_write_u16, ::analogout_read, ::analogout_read_u16 take less than 20us to complete
  * * The function ::analogout_free releases the analogout object
+ * * The function ::analogout_stream_init returns -1 if the buffer does not hold a whole number of samples in each half - TBD (basic test)
+ * * The function ::analogout_stream_start outputs the samples of the buffer at `sample_rate_hz` samples per second, circularly, or returns -1 if not supported - TBD (basic test)
+ * * The function ::analogout_stream_sample outputs one sample, as with ::analogout_write_u16 - TBD (basic test)
+ * * The stream handler is called, with the first half and then with the second half, each time a half of the buffer was output - TBD (basic test)
+ * * The function ::analogout_stream_stop stops the output started by ::analogout_stream_start, and the DAC keeps the last sample - TBD (basic test)
  *
  * # Undefined behaviour
  *
@@ -113,6 +139,55 @@ uint16_t analogout_read_u16(dac_t *obj);
  */
 const PinMap *analogout_pinmap(void);
 
+/** Initialize a stream of samples
+ *
+ * Samples are output one after another from `buffer`, which is used as a
+ * circular double buffer: the handler is called with one half to refill
+ * while the other half is output.
+ *
+ * @param stream  The stream object to initialize
+ * @param dac     The initialized analogout object
+ * @param buffer  The samples, as for ::analogout_write_u16
+ * @param length  The size of the buffer in samples, a multiple of 2
+ * @param handler Called from interrupt context when a half of the buffer was output
+ * @param id      The id passed to the handler
+ * @return 0 on success, -1 if the parameters are invalid
+ */
+int analogout_stream_init(analogout_stream_t *stream, dac_t *dac, uint16_t *buffer, size_t length, analogout_stream_handler handler, uint32_t id);
+
+/** Start outputting the stream at a fixed rate
+ *
+ * Targets should implement this with a timer triggering the DAC and a
+ * circular DMA transfer from the stream buffer, calling the handler on the
+ * half and full transfer complete interrupts, so the sample period does not
+ * depend on interrupt latency. The default implementation returns -1; the
+ * stream can then be driven from a timer interrupt with ::analogout_stream_sample.
+ *
+ * @note An implementation using DMA cleans each half of the buffer from the
+ * data cache with hal_dma_tx_prepare() once the handler refilled it. See
+ * hal/cache_api.h.
+ *
+ * @param stream         The initialized stream object
+ * @param sample_rate_hz The number of samples per second
+ * @return 0 on success, -1 if the rate or the DAC are not supported
+ */
+int analogout_stream_start(analogout_stream_t *stream, uint32_t sample_rate_hz);
+
+/** Stop the output started by ::analogout_stream_start
+ *
+ * @param stream The stream object
+ */
+void analogout_stream_stop(analogout_stream_t *stream);
+
+/** Output one sample of the stream by software
+ *
+ * Writes the next sample of the buffer with ::analogout_write_u16 and calls
+ * the handler when a half of the buffer was output.
+ *
+ * @param stream The initialized stream object
+ */
+void analogout_stream_sample(analogout_stream_t *stream);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,227 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CACHE_API_H
+#define MBED_CACHE_API_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cmsis.h"
+#include "device.h"
+#include "bootstrap/mbed_toolchain.h"
+
+/* The data cache is an option of the Cortex-M7 and Cortex-M55 cores, reported
+ * by the CMSIS device header.
+ */
+#ifndef DEVICE_DCACHE
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define DEVICE_DCACHE 1
+#else
+#define DEVICE_DCACHE 0
+#endif
+#endif
+
+/* The DMA RAM, from MBED_CONF_TARGET_DMA_RAM_START and of
+ * MBED_CONF_TARGET_DMA_RAM_SIZE bytes, is where the linker script places the
+ * buffers declared with ::MBED_DMA_BUFFER. When the MPU is used, ::mbed_mpu_init
+ * configures it as non-cacheable with MBED_CONF_TARGET_DMA_RAM_NON_CACHEABLE,
+ * or as write-through with MBED_CONF_TARGET_DMA_RAM_WRITE_THROUGH.
+ */
+#if DEVICE_DCACHE && DEVICE_MPU && MBED_CONF_PLATFORM_USE_MPU && \
+    defined(MBED_CONF_TARGET_DMA_RAM_START) && defined(MBED_CONF_TARGET_DMA_RAM_SIZE)
+#if defined(MBED_CONF_TARGET_DMA_RAM_NON_CACHEABLE) && MBED_CONF_TARGET_DMA_RAM_NON_CACHEABLE
+#define HAL_DMA_RAM_NON_CACHEABLE 1
+#elif defined(MBED_CONF_TARGET_DMA_RAM_WRITE_THROUGH) && MBED_CONF_TARGET_DMA_RAM_WRITE_THROUGH
+#define HAL_DMA_RAM_WRITE_THROUGH 1
+#endif
+#endif
+
+#ifndef HAL_DMA_RAM_NON_CACHEABLE
+#define HAL_DMA_RAM_NON_CACHEABLE 0
+#endif
+#ifndef HAL_DMA_RAM_WRITE_THROUGH
+#define HAL_DMA_RAM_WRITE_THROUGH 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_cache Data cache maintenance
+ * Coherency of DMA buffers with the data cache
+ *
+ * A driver that transfers a buffer with DMA calls:
+ * * ::hal_dma_tx_prepare on a transmit buffer before starting the transfer,
+ *   so the DMA reads the data written by the CPU
+ * * ::hal_dma_rx_prepare on a receive buffer before starting the transfer,
+ *   so no dirty line is written back over the received data
+ * * ::hal_dma_rx_complete on a receive buffer once the transfer is complete,
+ *   so the CPU reads the received data rather than stale lines
+ *
+ * The functions do nothing on cores without data cache, or when the cache is
+ * disabled. They also skip the maintenance that buffers in the DMA RAM don't
+ * need when it is configured as non-cacheable or write-through: none at all
+ * for non-cacheable DMA RAM, and all but ::hal_dma_rx_complete for
+ * write-through DMA RAM.
+ *
+ * # Defined behavior
+ * * Cleaning a range writes back every dirty line holding part of it
+ * * Invalidating a range discards every line holding only bytes of the range
+ * * The lines partly covered at either end of an invalidated range are
+ *   cleaned and invalidated, so that variables sharing them are not lost
+ *
+ * # Undefined behavior
+ * * The content of a receive buffer that doesn't start and end on
+ *   HAL_DCACHE_LINE_SIZE boundaries, if the CPU accesses the lines it
+ *   shares with other variables while the transfer is ongoing. Declare
+ *   receive buffers with ::HAL_DMA_BUFFER to avoid this.
+ *
+ * @{
+ */
+
+/** Size of a data cache line, in bytes */
+#define HAL_DCACHE_LINE_SIZE MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT
+
+/** Size rounded up to a whole number of data cache lines */
+#define HAL_DMA_BUFFER_SIZE(size) \
+    (((size) + HAL_DCACHE_LINE_SIZE - 1) / HAL_DCACHE_LINE_SIZE * HAL_DCACHE_LINE_SIZE)
+
+/** Declare a byte buffer for DMA transfers
+ *
+ * The buffer starts on a cache line and fills its last cache line, so cache
+ * maintenance on it doesn't affect other variables. It is placed with
+ * ::MBED_DMA_BUFFER.
+ *
+ * @code
+ * HAL_DMA_BUFFER(static, rx_buffer, 100);
+ * @endcode
+ *
+ * @param storage Storage class of the buffer, static or empty
+ * @param name    Name of the buffer
+ * @param size    Size of the buffer, in bytes
+ */
+#define HAL_DMA_BUFFER(storage, name, size) \
+    MBED_DMA_BUFFER storage uint8_t name[HAL_DMA_BUFFER_SIZE(size)]
+
+/** Check that a buffer starts and ends on data cache line boundaries
+ *
+ * @param addr Start of the buffer
+ * @param size Size of the buffer, in bytes
+ * @return true if the buffer shares no cache line with other variables
+ */
+static inline bool hal_dcache_is_aligned(const void *addr, size_t size)
+{
+    return (((uintptr_t)addr | size) & (HAL_DCACHE_LINE_SIZE - 1)) == 0;
+}
+
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+/** Check that a buffer is in the DMA RAM
+ *
+ * @param addr Start of the buffer
+ * @param size Size of the buffer, in bytes
+ * @return true if the buffer is entirely in the DMA RAM
+ */
+static inline bool hal_dma_ram_contains(const void *addr, size_t size)
+{
+    const uintptr_t offset = (uintptr_t)addr - MBED_CONF_TARGET_DMA_RAM_START;
+    return offset < MBED_CONF_TARGET_DMA_RAM_SIZE && size <= MBED_CONF_TARGET_DMA_RAM_SIZE - offset;
+}
+#endif
+
+/** Write back the dirty cache lines holding a range
+ *
+ * @param addr Start of the range
+ * @param size Size of the range, in bytes
+ */
+void hal_dcache_clean_range(const void *addr, size_t size);
+
+/** Discard the cache lines holding a range
+ *
+ * @param addr Start of the range
+ * @param size Size of the range, in bytes
+ */
+void hal_dcache_invalidate_range(void *addr, size_t size);
+
+/** Write back then discard the cache lines holding a range
+ *
+ * @param addr Start of the range
+ * @param size Size of the range, in bytes
+ */
+void hal_dcache_clean_invalidate_range(void *addr, size_t size);
+
+/** Prepare a buffer to be read by DMA
+ *
+ * @param tx   Transmit buffer
+ * @param size Size of the buffer, in bytes
+ */
+static inline void hal_dma_tx_prepare(const void *tx, size_t size)
+{
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+    // No line of the DMA RAM is dirty
+    if (hal_dma_ram_contains(tx, size)) {
+        return;
+    }
+#endif
+    hal_dcache_clean_range(tx, size);
+}
+
+/** Prepare a buffer to be written by DMA
+ *
+ * @param rx   Receive buffer
+ * @param size Size of the buffer, in bytes
+ */
+static inline void hal_dma_rx_prepare(void *rx, size_t size)
+{
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+    if (hal_dma_ram_contains(rx, size)) {
+        return;
+    }
+#endif
+    hal_dcache_clean_invalidate_range(rx, size);
+}
+
+/** Make the data written by DMA in a buffer visible to the CPU
+ *
+ * Lines may have been refilled by speculative reads during the transfer, so
+ * this is needed even after ::hal_dma_rx_prepare.
+ *
+ * @param rx   Receive buffer
+ * @param size Number of bytes received
+ */
+static inline void hal_dma_rx_complete(void *rx, size_t size)
+{
+#if HAL_DMA_RAM_NON_CACHEABLE
+    if (hal_dma_ram_contains(rx, size)) {
+        return;
+    }
+#endif
+    hal_dcache_invalidate_range(rx, size);
+}
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_CACHE_API_H
+
+/** @}*/
@@ -28,6 +28,17 @@
 #include "PinNames.h"
 #include "PeripheralNames.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE
+#define MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE 32
+#endif
+
+#ifndef MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE
+#define MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE 16
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -70,9 +81,71 @@ struct CAN_Message {
     unsigned char  len;                // Length of data field in bytes
     CANFormat      format;             // Format ::CANFormat
     CANType        type;               // Type ::CANType
+    uint32_t       timestamp;          // Reception time of received messages, see ::can_timestamp_to_us
 };
 typedef struct CAN_Message CAN_Message;
 
+#define CAN_FD_MAX_DATA_LENGTH 64
+
+/**
+ *
+ * \enum    CANFDFlags
+ *
+ * \brief   Values that represent CAN FD frame flags
+**/
+enum CANFDFlags {
+    CANFDNone          = 0,
+    CANFDFrame         = (1 << 0),   // FD frame, classic frame otherwise
+    CANFDBitrateSwitch = (1 << 1),   // Data phase sent at the data bitrate
+    CANFDErrorPassive  = (1 << 2)    // Transmitter was error passive (ESI)
+};
+typedef enum CANFDFlags CANFDFlags;
+
+/**
+ *
+ * \struct  CANFD_Message
+ *
+ * \brief   Holder for single CAN FD or classic CAN message.
+ *
+**/
+struct CANFD_Message {
+    unsigned int   id;                             // 29 bit identifier
+    unsigned char  data[CAN_FD_MAX_DATA_LENGTH];   // Data field
+    unsigned char  len;                            // Length of data field in bytes: 0-8, 12, 16, 20, 24, 32, 48 or 64
+    CANFormat      format;                         // Format ::CANFormat
+    CANType        type;                           // Type ::CANType, FD frames are always data frames
+    unsigned char  flags;                          // Logical OR of ::CANFDFlags
+    uint32_t       timestamp;                      // Reception time of received messages, see ::can_timestamp_to_us
+};
+typedef struct CANFD_Message CANFD_Message;
+
+/**
+ *
+ * \struct  can_capabilities_t
+ *
+ * \brief   Capabilities of a CAN peripheral.
+ *
+**/
+typedef struct {
+    bool           fd;                 // CAN FD frames are supported
+    int            max_data_hz;        // Highest data phase bitrate, 0 if FD is not supported
+    unsigned char  max_len;            // Longest data field in bytes
+    int            filter_banks;       // Hardware acceptance filter banks, 0 if unknown
+    bool           hw_timestamp;       // Timestamps are captured by the controller at the start of the frames
+} can_capabilities_t;
+
+/**
+ *
+ * \struct  can_id_range_t
+ *
+ * \brief   Range of CAN identifiers accepted by a filter, bounds included.
+ *
+**/
+typedef struct {
+    uint32_t       first;              // Lowest identifier, the only one of a single identifier range
+    uint32_t       last;               // Highest identifier, first for a single identifier
+} can_id_range_t;
+
 typedef enum {
     IRQ_RX,
     IRQ_TX,
@@ -107,6 +180,44 @@ typedef void (*can_irq_handler)(uint32_t id, CanIrqType type);
 
 typedef struct can_s can_t;
 
+/**
+ *
+ * \struct  can_rx_buffer_t
+ *
+ * \brief   Ring buffer of received CAN messages, filled from the RX interrupt.
+ *
+**/
+typedef struct {
+    can_t          *can;                                        // CAN object the buffer reads from
+    int             handle;                                     // Filter handle passed to ::can_read
+    CAN_Message     msgs[MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE];  // Buffered messages
+    size_t          head;                                       // Write position
+    size_t          count;                                      // Number of buffered messages
+    uint32_t        dropped;                                    // Messages dropped because the buffer was full
+    uint32_t        overruns;                                   // IRQ_OVERRUN interrupts
+    can_irq_handler handler;                                    // Handler for the other interrupts
+    uint32_t        id;                                         // Id passed to the handler
+    const can_id_range_t *ranges;                               // Software filter, NULL to accept all messages
+    size_t          range_count;                                // Number of ranges of the software filter
+    CANFormat       range_format;                               // Format accepted by the software filter
+    bool            sw_timestamp;                               // Messages are timestamped at the RX interrupt entry
+} can_rx_buffer_t;
+
+/**
+ *
+ * \struct  can_tx_queue_t
+ *
+ * \brief   Priority queue of messages to send, fed to the TX mailboxes from the TX interrupt.
+ *
+**/
+typedef struct {
+    can_t          *can;                                        // CAN object the queue writes to
+    CAN_Message     msgs[MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE];   // Queued messages, highest priority first
+    size_t          count;                                      // Number of queued messages
+    can_irq_handler handler;                                    // Handler for the other interrupts
+    uint32_t        id;                                         // Id passed to the handler
+} can_tx_queue_t;
+
 void          can_init(can_t *obj, PinName rd, PinName td);
 void          can_init_direct(can_t *obj, const can_pinmap_t *pinmap);
 void          can_init_freq(can_t *obj, PinName rd, PinName td, int hz);
@@ -120,6 +231,7 @@ void          can_irq_set(can_t *obj, CanIrqType irq, uint32_t enable);
 
 int           can_write(can_t *obj, CAN_Message, int cc);
 int           can_read(can_t *obj, CAN_Message *msg, int handle);
+int           can_read_burst(can_t *obj, CAN_Message *msgs, int max, int handle);
 int           can_mode(can_t *obj, CanMode mode);
 int           can_filter(can_t *obj, uint32_t id, uint32_t mask, CANFormat format, int32_t handle);
 void          can_reset(can_t *obj);
@@ -127,6 +239,236 @@ unsigned char can_rderror(can_t *obj);
 unsigned char can_tderror(can_t *obj);
 void          can_monitor(can_t *obj, int silent);
 
+/** Fill the given can_capabilities_t structure with the capabilities of the peripheral
+ *
+ * The default implementation reports classic CAN only.
+ *
+ * @param obj The initialized CAN object
+ * @param cap The capabilities to fill
+ */
+void          can_get_capabilities(can_t *obj, can_capabilities_t *cap);
+
+/** Configure the nominal and the data phase bitrates for CAN FD
+ *
+ * The data phase bitrate is used by frames sent with CANFDBitrateSwitch.
+ *
+ * @param obj     The CAN object
+ * @param hz      The nominal (arbitration phase) bitrate, as for ::can_frequency
+ * @param data_hz The data phase bitrate
+ * @return 1 on success, 0 if the bitrates are not supported
+ */
+int           can_fd_frequency(can_t *obj, int hz, int data_hz);
+
+/** Send a CAN FD or classic CAN message
+ *
+ * The default implementation sends classic frames with ::can_write and fails for FD frames.
+ *
+ * @param obj The CAN object
+ * @param msg The message, `len` is rounded up to the next valid FD length
+ * @param cc  As for ::can_write
+ * @return 1 if the message was queued, 0 otherwise
+ */
+int           can_fd_write(can_t *obj, const CANFD_Message *msg, int cc);
+
+/** Read a CAN FD or classic CAN message
+ *
+ * The default implementation reads classic frames with ::can_read.
+ *
+ * @param obj    The CAN object
+ * @param msg    The message read
+ * @param handle As for ::can_read
+ * @return 1 if a message was read, 0 otherwise
+ */
+int           can_fd_read(can_t *obj, CANFD_Message *msg, int handle);
+
+/** Convert the timestamp of a message to microsecond ticker time
+ *
+ * Controllers reporting `hw_timestamp` capture the timestamp in hardware,
+ * in the unit of their timer, at the start of the frame. Otherwise
+ * ::can_read leaves it as is, and ::can_rx_buffer_t sets it at the entry of
+ * the RX interrupt, from the lower 32 bits of the microsecond ticker time.
+ *
+ * The default implementation converts the timestamps of the microsecond
+ * ticker. Targets capturing timestamps in hardware override it, correlating
+ * their timer with the microsecond ticker. The conversion is valid for
+ * timestamps of the last 71 minutes.
+ *
+ * @param obj       The CAN object the message was received with
+ * @param timestamp The timestamp of the message
+ * @return The microsecond ticker time of the timestamp, see ::ticker_read_us
+ */
+uint64_t      can_timestamp_to_us(can_t *obj, uint32_t timestamp);
+
+/** Convert a data length code to the data field length in bytes
+ *
+ * @param dlc The data length code, 0-15
+ * @return The length in bytes
+ */
+unsigned char can_fd_dlc_to_len(unsigned char dlc);
+
+/** Convert a data field length to the data length code
+ *
+ * @param len The length in bytes, rounded up to the next valid FD length
+ * @return The data length code
+ */
+unsigned char can_fd_len_to_dlc(unsigned char len);
+
+/** Program acceptance filters for a set of identifier ranges
+ *
+ * The ranges are spread over the hardware filter banks, as identifier lists,
+ * masks or ranges depending on the peripheral, replacing the filter of the
+ * handle. The default implementation programs no filter and returns 0.
+ *
+ * @param obj    The CAN object
+ * @param ranges The ranges to accept
+ * @param count  The number of ranges
+ * @param format The format of the identifiers
+ * @param handle As for ::can_filter
+ * @return 1 if the hardware accepts exactly the ranges, 0 if the filter was left unchanged
+ */
+int           can_filter_ranges(can_t *obj, const can_id_range_t *ranges, size_t count, CANFormat format, int32_t handle);
+
+/** Check if an identifier is in a set of ranges
+ *
+ * Runs a binary search, in O(log count) time.
+ *
+ * @param ranges The ranges, sorted by identifier, not overlapping
+ * @param count  The number of ranges
+ * @param id     The identifier to look for
+ * @return true if one of the ranges contains the identifier
+ */
+bool          can_id_ranges_contain(const can_id_range_t *ranges, size_t count, uint32_t id);
+
+/** Start buffering received messages
+ *
+ * Takes over the handler set by ::can_irq_init and enables IRQ_RX. Every
+ * RX interrupt drains the hardware FIFO to the buffer, timestamping the
+ * messages at the interrupt entry if the controller does not timestamp
+ * them, see ::can_timestamp_to_us. Messages which do not
+ * fit to the buffer are read out and dropped. The other interrupts are
+ * forwarded to `handler`, IRQ_OVERRUN is also counted.
+ * The buffer size is set with MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE.
+ *
+ * @param buffer  The buffer to initialize
+ * @param obj     The initialized CAN object
+ * @param handle  Filter handle passed to ::can_read
+ * @param handler Handler for the other interrupts, or NULL
+ * @param id      Id passed to `handler`
+ */
+void          can_rx_buffer_init(can_rx_buffer_t *buffer, can_t *obj, int handle, can_irq_handler handler, uint32_t id);
+
+/** Accept only a set of identifier ranges in the buffer
+ *
+ * The ranges are programmed with ::can_filter_ranges. If the hardware cannot
+ * filter them, the RX interrupt discards the messages out of the ranges,
+ * found with ::can_id_ranges_contain, so they are neither buffered nor
+ * counted as dropped. The hardware filter of the handle must then accept
+ * the ranges.
+ *
+ * @param buffer The buffer
+ * @param ranges The ranges, sorted by identifier, not overlapping, valid until
+ *               the buffer is freed or filtered again, or NULL to accept all messages
+ * @param count  The number of ranges
+ * @param format The format of the identifiers
+ * @return 1 if the ranges are filtered by the hardware, 0 if they are filtered in software
+ */
+int           can_rx_buffer_filter(can_rx_buffer_t *buffer, const can_id_range_t *ranges, size_t count, CANFormat format);
+
+/** Stop buffering received messages
+ *
+ * Disables IRQ_RX and releases the handler set by ::can_rx_buffer_init.
+ *
+ * @param buffer The buffer
+ */
+void          can_rx_buffer_free(can_rx_buffer_t *buffer);
+
+/** Read buffered messages
+ *
+ * @param buffer The buffer
+ * @param msgs   Array for the messages, oldest first
+ * @param max    The size of the array
+ * @return The number of messages read
+ */
+int           can_rx_buffer_read(can_rx_buffer_t *buffer, CAN_Message *msgs, int max);
+
+/** Get the number of buffered messages
+ *
+ * @param buffer The buffer
+ * @return The number of messages waiting to be read
+ */
+size_t        can_rx_buffer_count(can_rx_buffer_t *buffer);
+
+/** Get the number of messages dropped because the buffer was full
+ *
+ * @param buffer The buffer
+ * @return The number of dropped messages since ::can_rx_buffer_init
+ */
+uint32_t      can_rx_buffer_dropped(can_rx_buffer_t *buffer);
+
+/** Get the number of IRQ_OVERRUN interrupts
+ *
+ * Counts the messages lost by the hardware, if the target reports them.
+ *
+ * @param buffer The buffer
+ * @return The number of overruns since ::can_rx_buffer_init
+ */
+uint32_t      can_rx_buffer_overruns(can_rx_buffer_t *buffer);
+
+/** Start queuing messages to send
+ *
+ * Takes over the handler set by ::can_irq_init and enables IRQ_TX. Every
+ * TX interrupt moves the queued messages of highest priority, the lowest
+ * identifiers in bus arbitration order, to the free mailboxes. The other
+ * interrupts are forwarded to `handler`. The queue size is set with
+ * MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE.
+ *
+ * To use it along with a ::can_rx_buffer_t, initialize the queue first, then
+ * pass ::can_tx_queue_irq and the queue to ::can_rx_buffer_init as the
+ * handler and its id.
+ *
+ * @param queue   The queue to initialize
+ * @param obj     The initialized CAN object
+ * @param handler Handler for the other interrupts, or NULL
+ * @param id      Id passed to `handler`
+ */
+void          can_tx_queue_init(can_tx_queue_t *queue, can_t *obj, can_irq_handler handler, uint32_t id);
+
+/** Stop queuing messages to send
+ *
+ * Disables IRQ_TX and releases the handler set by ::can_tx_queue_init. The
+ * messages left in the queue are discarded.
+ *
+ * @param queue The queue
+ */
+void          can_tx_queue_free(can_tx_queue_t *queue);
+
+/** Queue a message to send, without blocking
+ *
+ * Messages of equal identifiers are sent in the order they were queued.
+ *
+ * @param queue The queue
+ * @param msg   The message
+ * @return 1 if the message was queued or handed to a mailbox, 0 if the queue is full
+ */
+int           can_tx_queue_write(can_tx_queue_t *queue, const CAN_Message *msg);
+
+/** Get the number of messages waiting for a mailbox
+ *
+ * @param queue The queue
+ * @return The number of queued messages
+ */
+size_t        can_tx_queue_count(can_tx_queue_t *queue);
+
+/** Interrupt handler of the TX queue
+ *
+ * The handler installed by ::can_tx_queue_init, to chain with other users
+ * of the CAN interrupts.
+ *
+ * @param id   The queue
+ * @param type The interrupt
+ */
+void          can_tx_queue_irq(uint32_t id, CanIrqType type);
+
 /** Get the pins that support CAN RD
  *
  * Return a PinMap array of pins that support CAN RD. The
@@ -0,0 +1,288 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_HAL_CAPS_H
+#define MBED_HAL_CAPS_H
+
+#include "device.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+/* Compile-time capabilities set by the target configuration. The values not
+ * set are the ones every target of the peripheral supports, and the runtime
+ * queries like spi_get_capabilities() give the exact ones.
+ */
+#ifndef MBED_CONF_TARGET_SPI_MAX_FREQUENCY
+#define MBED_CONF_TARGET_SPI_MAX_FREQUENCY 0
+#endif
+
+#ifndef MBED_CONF_TARGET_SPI_HW_CS
+#define MBED_CONF_TARGET_SPI_HW_CS 0
+#endif
+
+#ifndef MBED_CONF_TARGET_SERIAL_MAX_BAUDRATE
+#define MBED_CONF_TARGET_SERIAL_MAX_BAUDRATE 0
+#endif
+
+#ifndef MBED_CONF_TARGET_GPIO_SPEED_CONTROL
+#define MBED_CONF_TARGET_GPIO_SPEED_CONTROL 0
+#endif
+
+/* The DEVICE_ macros are 1 or not defined, as 0 or 1 for constant expressions */
+#if DEVICE_CRC
+#define MBED_HAL_CAPS_CRC true
+#else
+#define MBED_HAL_CAPS_CRC false
+#endif
+
+#if DEVICE_DMA
+#define MBED_HAL_CAPS_DMA true
+#else
+#define MBED_HAL_CAPS_DMA false
+#endif
+
+#if DEVICE_I2C
+#define MBED_HAL_CAPS_I2C true
+#else
+#define MBED_HAL_CAPS_I2C false
+#endif
+
+#if DEVICE_I2CSLAVE
+#define MBED_HAL_CAPS_I2CSLAVE true
+#else
+#define MBED_HAL_CAPS_I2CSLAVE false
+#endif
+
+#if DEVICE_I2C_ASYNCH
+#define MBED_HAL_CAPS_I2C_ASYNCH true
+#else
+#define MBED_HAL_CAPS_I2C_ASYNCH false
+#endif
+
+#if DEVICE_INTERRUPTIN
+#define MBED_HAL_CAPS_INTERRUPTIN true
+#else
+#define MBED_HAL_CAPS_INTERRUPTIN false
+#endif
+
+#if DEVICE_PORTIN
+#define MBED_HAL_CAPS_PORTIN true
+#else
+#define MBED_HAL_CAPS_PORTIN false
+#endif
+
+#if DEVICE_PORTOUT
+#define MBED_HAL_CAPS_PORTOUT true
+#else
+#define MBED_HAL_CAPS_PORTOUT false
+#endif
+
+#if DEVICE_PWMOUT
+#define MBED_HAL_CAPS_PWMOUT true
+#else
+#define MBED_HAL_CAPS_PWMOUT false
+#endif
+
+#if DEVICE_PWMOUT_GROUP
+#define MBED_HAL_CAPS_PWMOUT_GROUP true
+#else
+#define MBED_HAL_CAPS_PWMOUT_GROUP false
+#endif
+
+#if DEVICE_SERIAL
+#define MBED_HAL_CAPS_SERIAL true
+#else
+#define MBED_HAL_CAPS_SERIAL false
+#endif
+
+#if DEVICE_SERIAL_ASYNCH
+#define MBED_HAL_CAPS_SERIAL_ASYNCH true
+#else
+#define MBED_HAL_CAPS_SERIAL_ASYNCH false
+#endif
+
+#if DEVICE_SERIAL_FC
+#define MBED_HAL_CAPS_SERIAL_FC true
+#else
+#define MBED_HAL_CAPS_SERIAL_FC false
+#endif
+
+#if DEVICE_SPI
+#define MBED_HAL_CAPS_SPI true
+#else
+#define MBED_HAL_CAPS_SPI false
+#endif
+
+#if DEVICE_SPISLAVE
+#define MBED_HAL_CAPS_SPISLAVE true
+#else
+#define MBED_HAL_CAPS_SPISLAVE false
+#endif
+
+#if DEVICE_SPI_ASYNCH
+#define MBED_HAL_CAPS_SPI_ASYNCH true
+#else
+#define MBED_HAL_CAPS_SPI_ASYNCH false
+#endif
+
+namespace mbed {
+namespace hal {
+
+/**
+ * \defgroup hal_caps Capability traits
+ * Capabilities of the target known at compile time
+ *
+ * Each peripheral has a tag type, and caps<tag> gives its capabilities as
+ * constant expressions, from the DEVICE_ macros and the target
+ * configuration. Drivers branch on them with constant conditions, so the
+ * code of the unsupported paths is not built in:
+ *
+ * @code
+ * if (mbed::hal::caps<mbed::hal::spi>::supports_dma) {
+ *     spi_transfer_dma(&spi, tx, rx, length);
+ * } else {
+ *     spi_master_block_write(&spi, tx, length, rx, length, 0xFF);
+ * }
+ * @endcode
+ *
+ * A value of 0 for a limit means it is not set by the target configuration,
+ * and the runtime capability query of the peripheral has to be used.
+ *
+ * @{
+ */
+
+/** Tag of the SPI peripheral */
+struct spi;
+/** Tag of the I2C peripheral */
+struct i2c;
+/** Tag of the serial peripheral */
+struct serial;
+/** Tag of the GPIO */
+struct gpio;
+/** Tag of the PWM output */
+struct pwmout;
+/** Tag of the CRC peripheral */
+struct crc;
+/** Tag of the DMA controller */
+struct dma;
+
+/** Capabilities of a peripheral, see the specializations */
+template <typename Peripheral>
+struct caps;
+
+/** Capabilities of the SPI peripheral */
+template <>
+struct caps<spi> {
+    static constexpr bool present = MBED_HAL_CAPS_SPI; /**< DEVICE_SPI */
+    static constexpr bool supports_slave = MBED_HAL_CAPS_SPISLAVE; /**< DEVICE_SPISLAVE */
+    static constexpr bool supports_async = MBED_HAL_CAPS_SPI_ASYNCH; /**< DEVICE_SPI_ASYNCH */
+    static constexpr bool supports_dma = MBED_HAL_CAPS_SPI && MBED_HAL_CAPS_DMA; /**< Transfers through hal_dma */
+    static constexpr bool supports_hw_cs = MBED_CONF_TARGET_SPI_HW_CS; /**< Chip select handled by the hardware */
+    static constexpr uint32_t max_frequency = MBED_CONF_TARGET_SPI_MAX_FREQUENCY; /**< Highest frequency, 0 if not set */
+#ifdef DEVICE_SPI_COUNT
+    static constexpr unsigned count = DEVICE_SPI_COUNT; /**< Number of peripherals */
+#else
+    static constexpr unsigned count = 0; /**< Number of peripherals, 0 if not set */
+#endif
+};
+
+/** Capabilities of the I2C peripheral */
+template <>
+struct caps<i2c> {
+    static constexpr bool present = MBED_HAL_CAPS_I2C; /**< DEVICE_I2C */
+    static constexpr bool supports_slave = MBED_HAL_CAPS_I2CSLAVE; /**< DEVICE_I2CSLAVE */
+    static constexpr bool supports_async = MBED_HAL_CAPS_I2C_ASYNCH; /**< DEVICE_I2C_ASYNCH */
+};
+
+/** Capabilities of the serial peripheral */
+template <>
+struct caps<serial> {
+    static constexpr bool present = MBED_HAL_CAPS_SERIAL; /**< DEVICE_SERIAL */
+    static constexpr bool supports_flow_control = MBED_HAL_CAPS_SERIAL_FC; /**< DEVICE_SERIAL_FC */
+    static constexpr bool supports_async = MBED_HAL_CAPS_SERIAL_ASYNCH; /**< DEVICE_SERIAL_ASYNCH */
+    static constexpr uint32_t max_baudrate = MBED_CONF_TARGET_SERIAL_MAX_BAUDRATE; /**< Highest baud rate, 0 if not set */
+};
+
+/** Capabilities of the GPIO */
+template <>
+struct caps<gpio> {
+    static constexpr bool supports_port_in = MBED_HAL_CAPS_PORTIN; /**< DEVICE_PORTIN */
+    static constexpr bool supports_port_out = MBED_HAL_CAPS_PORTOUT; /**< DEVICE_PORTOUT */
+    static constexpr bool supports_irq = MBED_HAL_CAPS_INTERRUPTIN; /**< DEVICE_INTERRUPTIN */
+    static constexpr bool supports_speed = MBED_CONF_TARGET_GPIO_SPEED_CONTROL; /**< gpio_speed() is implemented */
+#ifdef GPIO_BITS_INLINE
+    static constexpr bool inline_bits = true; /**< Set, clear and toggle are inline */
+#else
+    static constexpr bool inline_bits = false; /**< Set, clear and toggle are inline */
+#endif
+};
+
+/** Capabilities of the PWM output */
+template <>
+struct caps<pwmout> {
+    static constexpr bool present = MBED_HAL_CAPS_PWMOUT; /**< DEVICE_PWMOUT */
+    static constexpr bool supports_group = MBED_HAL_CAPS_PWMOUT_GROUP; /**< DEVICE_PWMOUT_GROUP */
+};
+
+/** Capabilities of the CRC peripheral */
+template <>
+struct caps<crc> {
+    static constexpr bool present = MBED_HAL_CAPS_CRC; /**< DEVICE_CRC */
+
+    /** Check whether a polynomial is computed in hardware
+     *
+     * @param polynomial The polynomial
+     * @param width      The width of the polynomial
+     * @return HAL_CRC_IS_SUPPORTED(polynomial, width), false without a CRC peripheral
+     */
+    static constexpr bool supports(uint32_t polynomial, uint32_t width)
+    {
+        // HAL_CRC_IS_SUPPORTED is a macro of the target, which may not use both parameters
+        return (void)polynomial, (void)width,
+#if DEVICE_CRC && defined(HAL_CRC_IS_SUPPORTED)
+               HAL_CRC_IS_SUPPORTED(polynomial, width);
+#else
+               false;
+#endif
+    }
+};
+
+/** Capabilities of the DMA controller */
+template <>
+struct caps<dma> {
+    static constexpr bool present = MBED_HAL_CAPS_DMA; /**< DEVICE_DMA */
+#ifdef DEVICE_DMA_CHANNEL_COUNT
+    static constexpr unsigned channels = DEVICE_DMA_CHANNEL_COUNT; /**< Number of channels */
+#else
+    static constexpr unsigned channels = 0; /**< Number of channels */
+#endif
+};
+
+/**@}*/
+
+} // namespace hal
+} // namespace mbed
+
+#endif // __cplusplus
+
+#endif // MBED_HAL_CAPS_H
+
+/** @}*/
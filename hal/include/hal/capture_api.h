@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CAPTURE_API_H
+#define MBED_CAPTURE_API_H
+
+#include "device.h"
+#include "pinmap.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_CAPTURE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Capture hal structure. capture_s is declared in the target's hal
+ */
+typedef struct capture_s capture_t;
+
+/** Edges of the input which are captured */
+typedef enum {
+    CAPTURE_EDGE_RISING  = (1 << 0),
+    CAPTURE_EDGE_FALLING = (1 << 1),
+    CAPTURE_EDGE_BOTH    = CAPTURE_EDGE_RISING | CAPTURE_EDGE_FALLING
+} capture_edge_t;
+
+/** Handler called from interrupt context when the capture buffer is full
+ *
+ * @param id    The id given to ::capture_start
+ * @param count The number of values in the buffer
+ */
+typedef void (*capture_handler)(uint32_t id, size_t count);
+
+/**
+ * \defgroup hal_capture Input capture hal functions
+ * Timestamps of input edges latched by a timer
+ *
+ * The timer copies its counter to a capture register on the edges of the
+ * input, so the timestamps are not delayed by the interrupt latency as the
+ * ones taken by a gpio_irq handler. The values are moved to a buffer of the
+ * caller, by DMA where the target supports it: the time between two edges
+ * is then only limited by the DMA request latency.
+ *
+ * The pulse widths and periods of the input are the differences of
+ * consecutive values, modulo the counter range.
+ *
+ * # Defined behavior
+ * * ::capture_init initializes the capture_t control structure
+ * * ::capture_free deinitializes the capture object
+ * * ::capture_tick_frequency returns the frequency of the captured counter
+ * * ::capture_counter_bits returns the width of the captured counter, at most 32
+ * * ::capture_start stores the counter value at each selected edge in the buffer,
+ *   in order, and calls the handler when the buffer is full
+ * * Capture stops when the buffer is full
+ * * ::capture_stop stops the capture without calling the handler and returns
+ *   the number of values stored
+ * * The values are exact to one counter tick, whatever the interrupt latency
+ *
+ * # Undefined behavior
+ * * Calling other function before ::capture_init
+ * * Calling ::capture_init with NC as capture pin
+ * * Calling ::capture_start while a capture is ongoing
+ * * Reading the buffer before the handler is called or the capture is stopped
+ * * Edges closer than the DMA request latency, or the interrupt latency on
+ *   targets capturing without DMA
+ *
+ * # Requirements for targets
+ * * The buffer is written by DMA when the target supports it, see hal/dma_api.h,
+ *   so it must be kept coherent with the data cache by the caller, see hal/cache_api.h
+ *
+ * @{
+ */
+
+/** Initialize the capture peripheral and configure the pin
+ *
+ * @param obj The capture object to initialize
+ * @param pinmap pointer to structure which holds static pinmap
+ */
+void capture_init_direct(capture_t *obj, const PinMap *pinmap);
+
+/** Initialize the capture peripheral and configure the pin
+ *
+ * @param obj The capture object to initialize
+ * @param pin The capture pin to initialize
+ */
+void capture_init(capture_t *obj, PinName pin);
+
+/** Deinitialize the capture object
+ *
+ * An ongoing capture is stopped.
+ * @param obj The capture object
+ */
+void capture_free(capture_t *obj);
+
+/** Get the frequency of the captured counter
+ *
+ * @param obj The capture object
+ * @return The number of ticks per second
+ */
+uint32_t capture_tick_frequency(capture_t *obj);
+
+/** Get the width of the captured counter
+ *
+ * @param obj The capture object
+ * @return The number of bits of the counter, the values wrap at 2^bits
+ */
+uint32_t capture_counter_bits(capture_t *obj);
+
+/** Start capturing the counter value on the edges of the input
+ *
+ * @param obj     The capture object
+ * @param edge    The edges captured
+ * @param buffer  The buffer the counter values are stored to
+ * @param count   The number of values of the buffer
+ * @param handler The handler called when the buffer is full, or NULL
+ * @param id      The id passed to the handler
+ */
+void capture_start(capture_t *obj, capture_edge_t edge, uint32_t *buffer, size_t count, capture_handler handler, uint32_t id);
+
+/** Stop capturing
+ *
+ * @param obj The capture object
+ * @return The number of values stored in the buffer
+ */
+size_t capture_stop(capture_t *obj);
+
+/** Get the pins that support input capture
+ *
+ * Return a PinMap array of pins that support input capture.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *capture_pinmap(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
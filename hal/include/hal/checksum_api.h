@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CHECKSUM_API_H
+#define MBED_CHECKSUM_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_checksum Internet checksum
+ * Ones' complement checksum of IP, UDP, TCP and ICMP (RFC 1071)
+ *
+ * The data is summed a word at a time. On cores with Helium (MVE), such as
+ * Cortex-M55, four words are summed at once across the lanes of a vector.
+ * On cores with the DSP extension the bytes are summed with the SIMD byte
+ * extract and add instructions, into separate halfword accumulators with no
+ * carry to propagate, and a scalar loop is used on the other cores.
+ *
+ * @code
+ * uint32_t sum = hal_inet_checksum_add(0, &pseudo_header, sizeof(pseudo_header));
+ * sum = hal_inet_checksum_add(sum, udp, udp_length);
+ * udp->checksum_be = hal_inet_checksum_finish(sum);
+ * @endcode
+ *
+ * # Defined behavior
+ * * The result doesn't depend on the alignment of the data
+ * * ::hal_inet_checksum of data which holds its own valid checksum is 0
+ *
+ * # Undefined behavior
+ * * Chaining ::hal_inet_checksum_add on buffers of odd size, but the last
+ *
+ * @{
+ */
+
+/** Add data to a checksum
+ *
+ * @param sum  0, or the sum returned for the data before
+ * @param data The data, in network byte order
+ * @param size The size of the data in bytes
+ * @return The sum, to give to the next call or to ::hal_inet_checksum_finish
+ */
+uint32_t hal_inet_checksum_add(uint32_t sum, const void *data, size_t size);
+
+/** Complete a checksum
+ *
+ * @param sum The sum returned by ::hal_inet_checksum_add
+ * @return The checksum, in network byte order, to store as it is
+ */
+uint16_t hal_inet_checksum_finish(uint32_t sum);
+
+/** Compute the checksum of one buffer
+ *
+ * @param data The data, in network byte order
+ * @param size The size of the data in bytes
+ * @return The checksum, in network byte order, to store as it is
+ */
+uint16_t hal_inet_checksum(const void *data, size_t size);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_CHECKSUM_API_H
+
+/** @}*/
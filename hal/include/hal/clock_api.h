@@ -0,0 +1,142 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CLOCK_API_H
+#define MBED_CLOCK_API_H
+
+#include "device.h"
+
+#if DEVICE_CLOCK_SCALING
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_clock Clock scaling
+ * Change the core and bus clocks at run time
+ *
+ * An application lowers the clocks while it is mostly idle and raises them
+ * for bursts of processing. Drivers whose timing depends on the clocks
+ * register a notifier, called before and after each change, to stop
+ * transfers and to program their peripherals again.
+ *
+ * @code
+ * hal_clock_set_core_frequency(16000000);
+ * // ...
+ * hal_clock_set_core_frequency(480000000);
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::hal_clock_set_core_frequency calls every registered notifier with
+ *   HAL_CLOCK_PRE_CHANGE, then changes the clocks, then calls every
+ *   notifier with HAL_CLOCK_POST_CHANGE, in registration order
+ * * The notifiers are called with HAL_CLOCK_POST_CHANGE even if the target
+ *   could not set the frequency
+ * * SystemCoreClock is the new core frequency when the notifiers are called
+ *   with HAL_CLOCK_POST_CHANGE
+ * * The us ticker keeps counting time across the change, and converts ticks
+ *   at the frequency reported after the change
+ * * wait_ns() is calibrated again after the change
+ *
+ * # Undefined behavior
+ * * Calling ::hal_clock_set_core_frequency from an interrupt handler, or
+ *   while another call is ongoing
+ * * Registering or removing a notifier from a notifier
+ * * Registering a notifier which is already registered
+ *
+ * # Requirements for targets
+ * * ::hal_clock_configure sets the core clock and the bus clocks derived from
+ *   it, with the flash wait states they need, and updates SystemCoreClock
+ * * The us ticker either keeps its frequency or reports the new one from its
+ *   get_info function
+ *
+ * @{
+ */
+
+/** Point of a clock change a notifier is called at */
+typedef enum {
+    HAL_CLOCK_PRE_CHANGE,    /**< The clocks are about to change */
+    HAL_CLOCK_POST_CHANGE    /**< The clocks have changed */
+} hal_clock_event_t;
+
+/** Handler of a clock change notifier
+ *
+ * @param id    The id given to ::hal_clock_notifier_add
+ * @param event The point of the change
+ */
+typedef void (*hal_clock_handler)(uint32_t id, hal_clock_event_t event);
+
+/** Clock change notifier
+ *
+ * The storage is provided by the driver and must stay valid until the
+ * notifier is removed.
+ */
+typedef struct hal_clock_notifier_s {
+    hal_clock_handler handler;              /**< Handler of the notifier */
+    uint32_t id;                            /**< Argument of the handler */
+    struct hal_clock_notifier_s *next;      /**< Next registered notifier */
+} hal_clock_notifier_t;
+
+/** Register a notifier
+ *
+ * @param notifier Storage for the notifier
+ * @param handler  Handler called before and after each clock change
+ * @param id       Argument of the handler
+ */
+void hal_clock_notifier_add(hal_clock_notifier_t *notifier, hal_clock_handler handler, uint32_t id);
+
+/** Remove a notifier
+ *
+ * @param notifier Notifier given to ::hal_clock_notifier_add, ignored if it
+ *   is not registered
+ */
+void hal_clock_notifier_remove(hal_clock_notifier_t *notifier);
+
+/** Change the core clock, and the bus clocks derived from it
+ *
+ * @param frequency New core frequency, in Hz
+ * @return 0 on success, -1 if the target can't run at this frequency, in
+ *   which case the clocks are unchanged
+ */
+int hal_clock_set_core_frequency(uint32_t frequency);
+
+/** Set the clocks for a core frequency
+ *
+ * Implemented by the target. Called by ::hal_clock_set_core_frequency with
+ * interrupts disabled.
+ *
+ * @param frequency New core frequency, in Hz
+ * @return 0 on success, -1 if the target can't run at this frequency
+ */
+int hal_clock_configure(uint32_t frequency);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_CLOCK_SCALING
+
+#endif // MBED_CLOCK_API_H
+
+/** @}*/
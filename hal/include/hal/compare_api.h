@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_COMPARE_API_H
+#define MBED_COMPARE_API_H
+
+#include "device.h"
+#include "pinmap.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_COMPARE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Compare hal structure. compare_s is declared in the target's hal
+ */
+typedef struct compare_s compare_t;
+
+/** Change of the output on a compare match */
+typedef enum {
+    COMPARE_ACTION_SET,     /**< The output is set high */
+    COMPARE_ACTION_CLEAR,   /**< The output is set low */
+    COMPARE_ACTION_TOGGLE   /**< The output is inverted */
+} compare_action_t;
+
+/** Handler called from interrupt context after the last compare match
+ *
+ * @param id The id given to ::compare_start
+ */
+typedef void (*compare_handler)(uint32_t id);
+
+/**
+ * \defgroup hal_compare Output compare hal functions
+ * Output edges driven by a timer at given counter values
+ *
+ * The timer changes the output when its counter matches the compare
+ * register, so the edges are not delayed by the interrupt latency as the
+ * ones written by a ticker event handler. The compare values are read from a
+ * buffer of the caller, by DMA where the target supports it, which makes
+ * sequences of edges with any timing possible.
+ *
+ * # Defined behavior
+ * * ::compare_init initializes the compare_t control structure, with the output low
+ * * ::compare_free deinitializes the compare object
+ * * ::compare_tick_frequency returns the frequency of the compared counter
+ * * ::compare_counter_bits returns the width of the compared counter, at most 32
+ * * ::compare_read returns the counter value
+ * * ::compare_write sets the output level while no sequence is ongoing
+ * * ::compare_start changes the output at each counter value of the buffer,
+ *   in order, and calls the handler after the last one
+ * * ::compare_stop stops the sequence without calling the handler, the output
+ *   keeps its level
+ * * The edges are exact to one counter tick, whatever the interrupt latency
+ *
+ * # Undefined behavior
+ * * Calling other function before ::compare_init
+ * * Calling ::compare_init with NC as compare pin
+ * * Calling ::compare_start while a sequence is ongoing
+ * * Modifying the buffer of an ongoing sequence
+ * * Values which are not reached within half the counter range after the
+ *   previous one, or after the counter value when ::compare_start is called
+ *   for the first one
+ * * Values closer than the DMA request latency, or the interrupt latency on
+ *   targets loading the compare register without DMA
+ *
+ * # Requirements for targets
+ * * The buffer is read by DMA when the target supports it, see hal/dma_api.h,
+ *   so it must be kept coherent with the data cache by the caller, see hal/cache_api.h
+ *
+ * @{
+ */
+
+/** Initialize the compare peripheral and configure the pin
+ *
+ * @param obj The compare object to initialize
+ * @param pinmap pointer to structure which holds static pinmap
+ */
+void compare_init_direct(compare_t *obj, const PinMap *pinmap);
+
+/** Initialize the compare peripheral and configure the pin
+ *
+ * @param obj The compare object to initialize
+ * @param pin The compare pin to initialize
+ */
+void compare_init(compare_t *obj, PinName pin);
+
+/** Deinitialize the compare object
+ *
+ * An ongoing sequence is stopped.
+ * @param obj The compare object
+ */
+void compare_free(compare_t *obj);
+
+/** Get the frequency of the compared counter
+ *
+ * @param obj The compare object
+ * @return The number of ticks per second
+ */
+uint32_t compare_tick_frequency(compare_t *obj);
+
+/** Get the width of the compared counter
+ *
+ * @param obj The compare object
+ * @return The number of bits of the counter, the values wrap at 2^bits
+ */
+uint32_t compare_counter_bits(compare_t *obj);
+
+/** Read the counter
+ *
+ * @param obj The compare object
+ * @return The counter value
+ */
+uint32_t compare_read(compare_t *obj);
+
+/** Set the output level
+ *
+ * @param obj   The compare object
+ * @param value The level, 0 for low, any other value for high
+ */
+void compare_write(compare_t *obj, int value);
+
+/** Start changing the output at the counter values of a buffer
+ *
+ * @param obj     The compare object
+ * @param action  The change of the output at each value
+ * @param buffer  The counter values
+ * @param count   The number of values of the buffer
+ * @param handler The handler called after the last value, or NULL
+ * @param id      The id passed to the handler
+ */
+void compare_start(compare_t *obj, compare_action_t action, const uint32_t *buffer, size_t count, compare_handler handler, uint32_t id);
+
+/** Stop changing the output
+ *
+ * @param obj The compare object
+ */
+void compare_stop(compare_t *obj);
+
+/** Get the pins that support output compare
+ *
+ * Return a PinMap array of pins that support output compare.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *compare_pinmap(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,236 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_COMPLETION_API_H
+#define MBED_COMPLETION_API_H
+
+#include "device.h"
+#include "hal/i2c_api.h"
+#include "hal/serial_api.h"
+#include "hal/spi_api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of completions a ::hal_completion_queue_t holds, must be a power of two
+ */
+#ifndef MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE
+#define MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE 16
+#endif
+
+/** Number of asynchronous transfers in progress for all the queues, at most 8
+ */
+#ifndef MBED_CONF_TARGET_COMPLETION_TRANSFERS
+#define MBED_CONF_TARGET_COMPLETION_TRANSFERS 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_completion Completion queue
+ * One queue for the completions of the asynchronous transfers of all the
+ * peripherals
+ *
+ * The transfers are started with the functions below instead of the
+ * asynchronous functions of each peripheral. Their interrupt handler calls
+ * the *_irq_handler_asynch() function of the peripheral, and posts one
+ * completion to the queue when the transfer ends, with the events and the
+ * id given at the start. The main loop drains the queue after each wake-up,
+ * handling every completion of the wake-up at once.
+ *
+ * @code
+ * static hal_completion_queue_t queue;
+ * hal_completion_t completions[8];
+ *
+ * hal_completion_queue_init(&queue);
+ * hal_completion_spi_transfer(&queue, &spi, tx, 4, rx, 4, 8, SPI_EVENT_ALL, SENSOR_READ);
+ * hal_completion_serial_tx(&queue, &serial, log, length, 8, SERIAL_EVENT_TX_ALL, LOG_SENT);
+ * while (true) {
+ *     const size_t count = hal_completion_drain(&queue, completions, 8);
+ *     for (size_t i = 0; i < count; i++) {
+ *         handle(completions[i].id, completions[i].events);
+ *     }
+ *     hal_idle();
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * Completions are popped in the order they were posted
+ * * ::hal_completion_post is safe to call from interrupt handlers of any
+ *   priority, for user completions
+ * * A completion posted to a full queue is dropped and counted
+ * * The transfer functions return -1, and start no transfer, when
+ *   MBED_CONF_TARGET_COMPLETION_TRANSFERS transfers are in progress
+ *
+ * # Undefined behavior
+ * * Popping or draining a queue from several contexts
+ * * Starting a serial transmission and reception of the same serial port at
+ *   the same time, they share the interrupt handler
+ *
+ * @{
+ */
+
+/** Peripheral which posted a completion */
+typedef enum {
+    HAL_COMPLETION_SPI,
+    HAL_COMPLETION_I2C,
+    HAL_COMPLETION_SERIAL_TX,
+    HAL_COMPLETION_SERIAL_RX,
+    HAL_COMPLETION_USER
+} hal_completion_source_t;
+
+/** Completion of a transfer
+ */
+typedef struct {
+    uint32_t id;        /**< The id given when the transfer started */
+    uint32_t events;    /**< The events of the peripheral the transfer ended with */
+    uint8_t source;     /**< The hal_completion_source_t */
+} hal_completion_t;
+
+/** Completions posted from interrupts and drained from thread context
+ */
+typedef struct {
+    hal_completion_t entries[MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE];
+    volatile uint32_t head;    /**< Count of completions posted */
+    volatile uint32_t tail;    /**< Count of completions popped */
+    volatile uint32_t dropped; /**< Count of completions lost because the queue was full */
+} hal_completion_queue_t;
+
+/** Initialize a completion queue
+ *
+ * @param queue The queue
+ */
+void hal_completion_queue_init(hal_completion_queue_t *queue);
+
+/** Post a completion
+ *
+ * @param queue  The queue
+ * @param source The hal_completion_source_t
+ * @param id     The id of the completion
+ * @param events The events of the completion
+ * @return true if posted, false if the queue was full
+ */
+bool hal_completion_post(hal_completion_queue_t *queue, uint8_t source, uint32_t id, uint32_t events);
+
+/** Pop the oldest completion
+ *
+ * Lock-free, must be called from a single context.
+ *
+ * @param queue      The queue
+ * @param completion Filled with the completion
+ * @return true if a completion was popped, false if the queue is empty
+ */
+bool hal_completion_pop(hal_completion_queue_t *queue, hal_completion_t *completion);
+
+/** Pop the completions, up to a number
+ *
+ * @param queue       The queue
+ * @param completions Filled with the completions, oldest first
+ * @param max         The size of completions
+ * @return The number of completions popped
+ */
+size_t hal_completion_drain(hal_completion_queue_t *queue, hal_completion_t *completions, size_t max);
+
+/** Get the number of completions lost because a queue was full
+ *
+ * @param queue The queue
+ * @return The number of completions dropped since ::hal_completion_queue_init
+ */
+uint32_t hal_completion_dropped(const hal_completion_queue_t *queue);
+
+#if DEVICE_SPI_ASYNCH
+/** Start an SPI transfer completing to a queue, see ::spi_master_transfer
+ *
+ * @param queue     The queue
+ * @param obj       The SPI object
+ * @param tx        The transmit buffer
+ * @param tx_length The number of words to transmit
+ * @param rx        The receive buffer
+ * @param rx_length The number of words to receive
+ * @param bit_width The bit width of buffer words
+ * @param event     The logical OR of the SPI events which end the transfer
+ * @param id        The id of the completion
+ * @return 0 if the transfer started, -1 otherwise
+ */
+int hal_completion_spi_transfer(hal_completion_queue_t *queue, spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length,
+                                uint8_t bit_width, uint32_t event, uint32_t id);
+#endif
+
+#if DEVICE_I2C_ASYNCH
+/** Start an I2C transfer completing to a queue, see ::i2c_transfer_asynch
+ *
+ * @param queue     The queue
+ * @param obj       The I2C object
+ * @param address   The address of the target
+ * @param tx        The transmit buffer
+ * @param tx_length The number of bytes to transmit
+ * @param rx        The receive buffer
+ * @param rx_length The number of bytes to receive
+ * @param stop      If true, stop is generated after the transfer
+ * @param event     The logical OR of the I2C events which end the transfer
+ * @param id        The id of the completion
+ * @return 0 if the transfer started, -1 otherwise
+ */
+int hal_completion_i2c_transfer(hal_completion_queue_t *queue, i2c_t *obj, uint32_t address, const void *tx, size_t tx_length,
+                                void *rx, size_t rx_length, bool stop, uint32_t event, uint32_t id);
+#endif
+
+#if DEVICE_SERIAL_ASYNCH
+/** Start a serial transmission completing to a queue, see ::serial_tx_asynch
+ *
+ * @param queue  The queue
+ * @param obj    The serial object
+ * @param tx     The transmit buffer
+ * @param length The number of words to transmit
+ * @param width  The bit width of buffer words
+ * @param event  The logical OR of the serial events which end the transmission
+ * @param id     The id of the completion
+ * @return 0 if the transmission started, -1 otherwise
+ */
+int hal_completion_serial_tx(hal_completion_queue_t *queue, serial_t *obj, const void *tx, size_t length, uint8_t width,
+                             uint32_t event, uint32_t id);
+
+/** Start a serial reception completing to a queue, see ::serial_rx_asynch
+ *
+ * @param queue      The queue
+ * @param obj        The serial object
+ * @param rx         The receive buffer
+ * @param length     The number of words to receive
+ * @param width      The bit width of buffer words
+ * @param event      The logical OR of the serial events which end the reception
+ * @param char_match The character ending the reception, SERIAL_RESERVED_CHAR_MATCH for none
+ * @param id         The id of the completion
+ * @return 0 if the reception started, -1 otherwise
+ */
+int hal_completion_serial_rx(hal_completion_queue_t *queue, serial_t *obj, void *rx, size_t length, uint8_t width,
+                             uint32_t event, uint8_t char_match, uint32_t id);
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_COMPLETION_API_H
+
+/** @}*/
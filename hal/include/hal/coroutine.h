@@ -0,0 +1,541 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_HAL_COROUTINE_H
+#define MBED_HAL_COROUTINE_H
+
+#include "device.h"
+
+#if defined(__cplusplus) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/i2c_api.h"
+#include "hal/idle_api.h"
+#include "hal/serial_api.h"
+#include "hal/sleep_api.h"
+#include "hal/spi_api.h"
+#include "hal/ticker_api.h"
+
+#include <array>
+#include <coroutine>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+/* Coroutines ready to run, queued from interrupt handlers */
+#ifndef MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE
+#define MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE 16
+#endif
+
+/* Asynchronous transfers awaited at the same time */
+#ifndef MBED_CONF_TARGET_COROUTINE_COMPLETIONS
+#define MBED_CONF_TARGET_COROUTINE_COMPLETIONS 4
+#endif
+
+namespace mbed {
+namespace hal {
+
+/**
+ * \defgroup hal_coroutine C++20 coroutines
+ * Awaiting the asynchronous transfers of the HAL from coroutines
+ *
+ * `co_await` on ::spi_transfer, ::i2c_transfer, ::serial_write or
+ * ::serial_read starts the transfer and suspends the coroutine. The
+ * interrupt handler ending the transfer queues the coroutine to the
+ * Executor, which resumes it from the main loop, never from interrupt
+ * context. The expression returns the events of the transfer.
+ *
+ * The Executor is a bare-metal run loop: it resumes the coroutines ready,
+ * and sleeps with ::hal_idle when there are none, until the next interrupt
+ * or ticker event.
+ *
+ * @code
+ * mbed::hal::Task read_sensor()
+ * {
+ *     for (;;) {
+ *         uint32_t events = co_await mbed::hal::i2c_transfer(&i2c, SENSOR, cmd, 1, data, 6);
+ *         if (events & I2C_EVENT_TRANSFER_COMPLETE) {
+ *             process(data);
+ *         }
+ *         co_await mbed::hal::sleep_for(100000);
+ *     }
+ * }
+ *
+ * int main()
+ * {
+ *     mbed::hal::Executor::set_ticker(get_us_ticker_channel_data(1));
+ *     mbed::hal::Executor::spawn(read_sensor());
+ *     mbed::hal::Executor::spawn(blink_led());
+ *     mbed::hal::Executor::run();
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * A coroutine awaiting a transfer is resumed by ::Executor::run once the
+ *   transfer reports one of the events given
+ * * Up to MBED_CONF_TARGET_COROUTINE_COMPLETIONS transfers are awaited at
+ *   the same time, each on its own peripheral
+ *
+ * # Undefined behavior
+ * * Awaiting two transfers of the same peripheral at the same time, a serial
+ *   write and read included
+ * * Awaiting ::sleep_for without a ticker given to ::Executor::set_ticker
+ * * Using the ticker given to ::Executor::set_ticker for other events
+ *
+ * @{
+ */
+
+/** Coroutine run by the Executor
+ *
+ * The coroutine starts suspended, and its frame is freed when it returns.
+ */
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            MBED_ASSERT(false);
+        }
+    };
+
+    Task(Task &&other) noexcept : _handle(std::exchange(other._handle, {}))
+    {
+    }
+
+    ~Task()
+    {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    /** Give up the ownership of the coroutine, once it is scheduled */
+    std::coroutine_handle<> release()
+    {
+        return std::exchange(_handle, {});
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+/** Bare-metal run loop of the coroutines */
+class Executor {
+public:
+    /** Queue a coroutine to be resumed, safe to call from interrupt handlers
+     *
+     * @param handle The coroutine
+     */
+    static void post(std::coroutine_handle<> handle)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(_head - _tail < MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE);
+        _ready[_head % MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE] = handle;
+        _head = _head + 1;
+        core_util_critical_section_exit();
+    }
+
+    /** Start a task, from the next run of the loop
+     *
+     * @param task The task
+     */
+    static void spawn(Task &&task)
+    {
+        post(task.release());
+    }
+
+    /** Resume the coroutines which are ready
+     *
+     * @return true if a coroutine was resumed
+     */
+    static bool run_ready()
+    {
+        bool resumed = false;
+        for (;;) {
+            core_util_critical_section_enter();
+            if (_tail == _head) {
+                core_util_critical_section_exit();
+                return resumed;
+            }
+            std::coroutine_handle<> handle = _ready[_tail % MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE];
+            _tail = _tail + 1;
+            core_util_critical_section_exit();
+
+            handle.resume();
+            resumed = true;
+        }
+    }
+
+    /** Run the coroutines forever, sleeping while none is ready */
+    [[noreturn]] static void run()
+    {
+        for (;;) {
+            run_ready();
+
+            // An interrupt queueing a coroutine after the check wakes the core up
+            core_util_critical_section_enter();
+            if (_tail == _head) {
+#if DEVICE_SLEEP
+                hal_idle();
+#endif
+            }
+            core_util_critical_section_exit();
+        }
+    }
+
+    /** Set the ticker of ::sleep_for, whose events the Executor then handles
+     *
+     * @param ticker The ticker, not used for other events
+     */
+    static void set_ticker(const ticker_data_t *ticker)
+    {
+        _ticker = ticker;
+        ticker_set_handler(ticker, ticker_handler);
+    }
+
+    /** Get the ticker given to ::set_ticker */
+    static const ticker_data_t *ticker()
+    {
+        return _ticker;
+    }
+
+private:
+    static void ticker_handler(uint32_t id)
+    {
+        post(std::coroutine_handle<>::from_address(reinterpret_cast<void *>(static_cast<uintptr_t>(id))));
+    }
+
+    static inline std::coroutine_handle<> _ready[MBED_CONF_TARGET_COROUTINE_READY_QUEUE_SIZE];
+    static inline volatile uint32_t _head;
+    static inline volatile uint32_t _tail;
+    static inline const ticker_data_t *_ticker;
+};
+
+/** Awaitable suspending a coroutine for a time */
+class SleepFor {
+public:
+    explicit SleepFor(us_timestamp_t us) : _us(us)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return _us == 0;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        const ticker_data_t *ticker = Executor::ticker();
+        MBED_ASSERT(ticker != nullptr);
+        ticker_insert_event_us(ticker, &_event, ticker_read_us(ticker) + _us,
+                               static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle.address())));
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+private:
+    us_timestamp_t _us;
+    ticker_event_t _event {};
+};
+
+/** Suspend the coroutine for a time
+ *
+ * @param us The time in microseconds, on the ticker of ::Executor::set_ticker
+ */
+inline SleepFor sleep_for(us_timestamp_t us)
+{
+    return SleepFor(us);
+}
+
+namespace detail {
+
+class AsyncOperation;
+
+/* A transfer awaited, and the IRQ handler polling its peripheral */
+struct Completion {
+    AsyncOperation *operation;
+    bool used;
+};
+
+inline Completion completions[MBED_CONF_TARGET_COROUTINE_COMPLETIONS];
+
+/** Base of the awaitables of the asynchronous transfers */
+class AsyncOperation {
+public:
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    /** The events the transfer ended with */
+    uint32_t await_resume() const noexcept
+    {
+        return _events;
+    }
+
+    /** Called from the IRQ handler of the transfer, with the events of the peripheral */
+    bool complete(uint32_t events)
+    {
+        if (!(events & _mask)) {
+            return false;
+        }
+        _events = events;
+        Executor::post(_handle);
+        return true;
+    }
+
+    virtual uint32_t poll() = 0;
+
+protected:
+    explicit AsyncOperation(uint32_t mask) : _mask(mask)
+    {
+    }
+
+    /* Claim a completion and return the address of its IRQ handler */
+    uint32_t claim(std::coroutine_handle<> handle);
+
+    std::coroutine_handle<> _handle;
+    uint32_t _mask;
+    uint32_t _events = 0;
+};
+
+template <size_t I>
+void irq_handler()
+{
+    Completion &completion = completions[I];
+    AsyncOperation *operation = completion.operation;
+    if (completion.used && operation->complete(operation->poll())) {
+        completion.used = false;
+    }
+}
+
+template <size_t... I>
+constexpr auto make_irq_handlers(std::index_sequence<I...>)
+{
+    return std::array<void (*)(), sizeof...(I)> { irq_handler<I>... };
+}
+
+inline uint32_t AsyncOperation::claim(std::coroutine_handle<> handle)
+{
+    static constexpr auto handlers = make_irq_handlers(std::make_index_sequence<MBED_CONF_TARGET_COROUTINE_COMPLETIONS>());
+
+    _handle = handle;
+    core_util_critical_section_enter();
+    size_t i = 0;
+    while (i < MBED_CONF_TARGET_COROUTINE_COMPLETIONS && completions[i].used) {
+        i++;
+    }
+    MBED_ASSERT(i < MBED_CONF_TARGET_COROUTINE_COMPLETIONS);
+    completions[i].operation = this;
+    completions[i].used = true;
+    core_util_critical_section_exit();
+
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handlers[i]));
+}
+
+} // namespace detail
+
+#if DEVICE_SPI_ASYNCH
+/** Awaitable SPI transfer, see ::spi_master_transfer */
+class SpiTransfer : public detail::AsyncOperation {
+public:
+    SpiTransfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t event) :
+        AsyncOperation(event), _obj(obj), _tx(tx), _tx_length(tx_length), _rx(rx), _rx_length(rx_length), _bit_width(bit_width)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        spi_master_transfer(_obj, _tx, _tx_length, _rx, _rx_length, _bit_width, claim(handle), _mask);
+    }
+
+    uint32_t poll() override
+    {
+        return spi_irq_handler_asynch(_obj);
+    }
+
+private:
+    spi_t *_obj;
+    const void *_tx;
+    size_t _tx_length;
+    void *_rx;
+    size_t _rx_length;
+    uint8_t _bit_width;
+};
+
+/** Transfer on the SPI bus, resuming the coroutine once it ends
+ *
+ * @return The awaitable, whose result is the SPI events of the transfer
+ */
+inline SpiTransfer spi_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length,
+                                uint8_t bit_width = 8, uint32_t event = SPI_EVENT_ALL)
+{
+    return SpiTransfer(obj, tx, tx_length, rx, rx_length, bit_width, event);
+}
+#endif // DEVICE_SPI_ASYNCH
+
+#if DEVICE_I2C_ASYNCH
+/** Awaitable I2C transfer, see ::i2c_transfer_asynch */
+class I2cTransfer : public detail::AsyncOperation {
+public:
+    I2cTransfer(i2c_t *obj, uint32_t address, const void *tx, size_t tx_length, void *rx, size_t rx_length, bool stop, uint32_t event) :
+        AsyncOperation(event), _obj(obj), _address(address), _tx(tx), _tx_length(tx_length), _rx(rx), _rx_length(rx_length), _stop(stop)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        i2c_transfer_asynch(_obj, _tx, _tx_length, _rx, _rx_length, _address, _stop, claim(handle), _mask);
+    }
+
+    uint32_t poll() override
+    {
+        return i2c_irq_handler_asynch(_obj);
+    }
+
+private:
+    i2c_t *_obj;
+    uint32_t _address;
+    const void *_tx;
+    size_t _tx_length;
+    void *_rx;
+    size_t _rx_length;
+    bool _stop;
+};
+
+/** Transfer on the I2C bus, resuming the coroutine once it ends
+ *
+ * @return The awaitable, whose result is the I2C events of the transfer
+ */
+inline I2cTransfer i2c_transfer(i2c_t *obj, uint32_t address, const void *tx, size_t tx_length, void *rx, size_t rx_length,
+                                bool stop = true, uint32_t event = I2C_EVENT_ALL)
+{
+    return I2cTransfer(obj, address, tx, tx_length, rx, rx_length, stop, event);
+}
+#endif // DEVICE_I2C_ASYNCH
+
+#if DEVICE_SERIAL_ASYNCH
+/** Awaitable serial transmission, see ::serial_tx_asynch */
+class SerialWrite : public detail::AsyncOperation {
+public:
+    SerialWrite(serial_t *obj, const void *tx, size_t length, uint8_t width, uint32_t event) :
+        AsyncOperation(event), _obj(obj), _tx(tx), _length(length), _width(width)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        serial_tx_asynch(_obj, _tx, _length, _width, claim(handle), _mask);
+    }
+
+    uint32_t poll() override
+    {
+        return static_cast<uint32_t>(serial_irq_handler_asynch(_obj));
+    }
+
+private:
+    serial_t *_obj;
+    const void *_tx;
+    size_t _length;
+    uint8_t _width;
+};
+
+/** Awaitable serial reception, see ::serial_rx_asynch */
+class SerialRead : public detail::AsyncOperation {
+public:
+    SerialRead(serial_t *obj, void *rx, size_t length, uint8_t width, uint32_t event, uint8_t char_match) :
+        AsyncOperation(event), _obj(obj), _rx(rx), _length(length), _width(width), _char_match(char_match)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        serial_rx_asynch(_obj, _rx, _length, _width, claim(handle), _mask, _char_match);
+    }
+
+    uint32_t poll() override
+    {
+        return static_cast<uint32_t>(serial_irq_handler_asynch(_obj));
+    }
+
+private:
+    serial_t *_obj;
+    void *_rx;
+    size_t _length;
+    uint8_t _width;
+    uint8_t _char_match;
+};
+
+/** Transmit on a serial port, resuming the coroutine once the transmission ends
+ *
+ * @return The awaitable, whose result is the serial events of the transmission
+ */
+inline SerialWrite serial_write(serial_t *obj, const void *tx, size_t length, uint8_t width = 8,
+                                uint32_t event = SERIAL_EVENT_TX_ALL)
+{
+    return SerialWrite(obj, tx, length, width, event);
+}
+
+/** Receive on a serial port, resuming the coroutine once the reception ends
+ *
+ * @return The awaitable, whose result is the serial events of the reception
+ */
+inline SerialRead serial_read(serial_t *obj, void *rx, size_t length, uint8_t width = 8,
+                              uint32_t event = SERIAL_EVENT_RX_ALL, uint8_t char_match = SERIAL_RESERVED_CHAR_MATCH)
+{
+    return SerialRead(obj, rx, length, width, event, char_match);
+}
+#endif // DEVICE_SERIAL_ASYNCH
+
+/**@}*/
+
+} // namespace hal
+} // namespace mbed
+
+#endif // __cplusplus && __cpp_impl_coroutine
+
+#endif // MBED_HAL_COROUTINE_H
+
+/** @}*/
@@ -20,6 +20,7 @@
 #ifndef CRC_HAL_API_H
 #define CRC_HAL_API_H
 
+#include "device.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -51,6 +52,23 @@ typedef struct crc_mbed_config {
     bool reflect_out;
 } crc_mbed_config_t;
 
+/** CRC computation context
+ *
+ * Holds the configuration and the intermediate remainder of one computation,
+ * so several computations can share the CRC module.
+ */
+typedef struct hal_crc_ctx {
+    /** Configuration given to hal_crc_ctx_start() */
+    crc_mbed_config_t config;
+    /** Intermediate remainder, before final xor and output reflection */
+    uint32_t state;
+} hal_crc_ctx_t;
+
+/** Handler called when an asynchronous CRC update completes
+ * @param id The id given to hal_crc_ctx_update_async()
+ */
+typedef void (*hal_crc_async_handler)(uint32_t id);
+
 #if DEVICE_CRC
 
 #ifdef __cplusplus
@@ -87,6 +105,8 @@ extern "C" {
  *   data length is equal to 0 - verified by test ::crc_compute_partial_invalid_param_test.
  * * Function hal_crc_get_result() returns the checksum result from the CRC module
  *   - verified by tests ::crc_calc_single_test, ::crc_calc_multi_test, ::crc_reconfigure_test.
+ * * Computations in different hal_crc_ctx_t contexts can be interleaved
+ *   - verified by test ::crc_ctx_interleave_test.
  *
  * # Undefined behaviour
  *
@@ -212,6 +232,54 @@ void hal_crc_compute_partial(const uint8_t *data, const size_t size);
  */
 uint32_t hal_crc_get_result(void);
 
+/** Start a computation in a context
+ * The CRC module is not touched; computations in different contexts can be
+ * interleaved with each other.
+ * The polynomial must be checked for support using the HAL_CRC_IS_SUPPORTED() macro.
+ * \param ctx    The context to initialize
+ * \param config CRC configuration parameters
+ */
+void hal_crc_ctx_start(hal_crc_ctx_t *ctx, const crc_mbed_config_t *config);
+
+/** Append data to the computation of a context
+ * The CRC module is loaded with the context state, fed with the data and its state is
+ * saved back to the context. This is done in a critical section, so contexts can be used
+ * from different threads and interrupts. Large buffers should use
+ * hal_crc_ctx_update_async() to keep interrupt latency low.
+ * The context API must not be used while a computation started with
+ * hal_crc_compute_partial_start() is in progress.
+ * If the function is passed an undefined pointer, or the size of the buffer is 0, this
+ * function does nothing and returns.
+ * \param ctx  The context
+ * \param data Input data stream
+ * \param size Size of the data stream in bytes
+ */
+void hal_crc_ctx_update(hal_crc_ctx_t *ctx, const uint8_t *data, size_t size);
+
+/** Append data to the computation of a context without blocking
+ * Targets feed the CRC module with DMA where available and call the handler from
+ * interrupt context once done. The data buffer and the context must stay valid until
+ * then. The default implementation calls hal_crc_ctx_update() and the handler before
+ * returning.
+ * \param ctx     The context
+ * \param data    Input data stream
+ * \param size    Size of the data stream in bytes
+ * \param handler The completion handler
+ * \param id      The id passed to the handler
+ * \return 0 if the update was started, -1 if the CRC module is busy with another
+ *         asynchronous update, the handler is not called then
+ */
+int hal_crc_ctx_update_async(hal_crc_ctx_t *ctx, const uint8_t *data, size_t size,
+                             hal_crc_async_handler handler, uint32_t id);
+
+/** Get the checksum of a context
+ * The final xor and output reflection are applied to the context state. The context is
+ * not modified, so more data can still be appended.
+ * \param ctx The context
+ * \return The CRC checksum of the data appended so far
+ */
+uint32_t hal_crc_ctx_get_result(const hal_crc_ctx_t *ctx);
+
 /**@}*/
 
 #ifdef __cplusplus
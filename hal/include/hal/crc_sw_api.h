@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CRC_SW_API_H
+#define MBED_CRC_SW_API_H
+
+#include "hal/crc_api.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of table slices used when none is given
+ * Slice-by-8 on cores with fast loads and enough flash, nibble tables on Armv6-M.
+ */
+#ifndef MBED_CONF_TARGET_CRC_SW_SLICES
+#if (__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || (__ARM_ARCH_8M_MAIN__ == 1U)
+#define MBED_CONF_TARGET_CRC_SW_SLICES 8
+#elif (__ARM_ARCH_6M__ == 1U) || (__ARM_ARCH_8M_BASE__ == 1U)
+#define MBED_CONF_TARGET_CRC_SW_SLICES 0
+#else
+#define MBED_CONF_TARGET_CRC_SW_SLICES 1
+#endif
+#endif
+
+/** Number of uint32_t table entries for a slice count
+ * 0 selects a 16 entry nibble table, 1 a 256 entry byte table, 4 and 8 slice-by-4/8.
+ */
+#define CRC_SW_TABLE_ENTRIES(slices) ((slices) == 0 ? 16 : 256 * (slices))
+
+/** Software CRC computation context
+ */
+typedef struct crc_sw_ctx {
+    /** Configuration given to crc_sw_ctx_start() */
+    crc_mbed_config_t config;
+    /** Table built by crc_sw_table_init() */
+    const uint32_t *table;
+    /** Number of table slices */
+    uint32_t slices;
+    /** Running remainder, in the table's bit order and alignment */
+    uint32_t state;
+} crc_sw_ctx_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_crc_sw Software CRC
+ * Table driven CRC engine for configurations the CRC module does not support,
+ * following the same crc_mbed_config_t semantics as the hardware CRC HAL API.
+ * # Defined behaviour
+ * * Every table size gives the same result as the hardware CRC for the same
+ *   configuration - verified by test ::crc_sw_calc_test.
+ * * Function crc_sw_ctx_update() can be called multiple times in succession
+ *   - verified by test ::crc_sw_calc_test.
+ * # Undefined behaviour
+ * * Using a table built for a different polynomial, width or input reflection.
+ * @{
+ */
+
+/** Build the lookup table for a polynomial
+ * The table only depends on the polynomial, width and input reflection, so it can
+ * be shared by all contexts using them, or generated once and kept in flash.
+ * \param table    Storage for CRC_SW_TABLE_ENTRIES(slices) entries
+ * \param slices   0, 1, 4 or 8
+ * \param config   CRC configuration
+ * \return 0 on success, -1 if the slice count or width is not supported
+ */
+int crc_sw_table_init(uint32_t *table, uint32_t slices, const crc_mbed_config_t *config);
+
+/** Start a computation
+ * \param ctx    The context to initialize
+ * \param config CRC configuration parameters, width from 1 to 32 bits
+ * \param table  Table built by crc_sw_table_init() for the configuration
+ * \param slices The slice count the table was built with
+ */
+void crc_sw_ctx_start(crc_sw_ctx_t *ctx, const crc_mbed_config_t *config, const uint32_t *table, uint32_t slices);
+
+/** Append data to a computation
+ * \param ctx  The context
+ * \param data Input data stream
+ * \param size Size of the data stream in bytes
+ */
+void crc_sw_ctx_update(crc_sw_ctx_t *ctx, const uint8_t *data, size_t size);
+
+/** Get the checksum of a computation
+ * The context is not modified, so more data can still be appended.
+ * \param ctx The context
+ * \return The CRC checksum of the data appended so far
+ */
+uint32_t crc_sw_ctx_get_result(const crc_sw_ctx_t *ctx);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_CRC_SW_API_H
+
+/**@}*/
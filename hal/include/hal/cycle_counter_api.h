@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_CYCLE_COUNTER_API_H
+#define MBED_CYCLE_COUNTER_API_H
+
+#include <stdint.h>
+#include "cmsis.h"
+#include "hal/ticker_api.h"
+
+/* The DWT cycle counter is only implemented by the ARMv7-M and ARMv8-M
+ * mainline architectures. A target can set DEVICE_CYCLE_COUNTER to 0 if its
+ * core was synthesized without it.
+ */
+#ifndef DEVICE_CYCLE_COUNTER
+#if ((__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || \
+     (__ARM_ARCH_8M_MAIN__ == 1U) || (__ARM_ARCH_8_1M_MAIN__ == 1U))
+#define DEVICE_CYCLE_COUNTER 1
+#else
+#define DEVICE_CYCLE_COUNTER 0
+#endif
+#endif
+
+#if DEVICE_CYCLE_COUNTER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_cycle_counter Cycle counter
+ * Access to the core clock cycle counter (DWT CYCCNT)
+ *
+ * # Defined behavior
+ * * The counter increments once per core clock cycle while the core is running
+ * * The counter is 32 bits wide and rolls over to 0
+ * * ::hal_cycle_counter_init is safe to call repeatedly and does not reset the counter
+ *
+ * # Undefined behavior
+ * * Reading the counter before calling ::hal_cycle_counter_init
+ * * The counter value after the core has been halted or in sleep modes
+ *   that gate the core clock
+ *
+ * @{
+ */
+
+/** Enable the cycle counter
+ *
+ * Enables the trace block and the DWT cycle counter. This leaves the counter
+ * running if it was already enabled, for instance by mbed_itm_init().
+ */
+void hal_cycle_counter_init(void);
+
+/** Read the cycle counter
+ *
+ * @return The current 32-bit cycle count
+ */
+static inline uint32_t hal_cycle_counter_read(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if MBED_CONF_TARGET_CUSTOM_TICKERS
+/** Get the cycle counter ticker
+ *
+ * The ticker runs at SystemCoreClock, as sampled when the ticker is
+ * initialized, and is widened to 64 bits by the common ticker layer. It can
+ * be passed to ticker_read_us() to time code with the accuracy of the core
+ * clock.
+ *
+ * @warning The cycle counter cannot generate interrupts: events inserted on
+ * this ticker are never dispatched. The ticker must be read at least once
+ * every 2^32 cycles to keep track of the counter rolling over.
+ *
+ * @note Requires MBED_CONF_TARGET_CUSTOM_TICKERS, as the common ticker layer
+ * otherwise only accepts the microsecond and low power tickers.
+ *
+ * @return The cycle counter ticker data
+ */
+const ticker_data_t *get_cycle_counter_ticker_data(void);
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_CYCLE_COUNTER
+
+#endif // MBED_CYCLE_COUNTER_API_H
+
+/** @}*/
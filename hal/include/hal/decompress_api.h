@@ -0,0 +1,122 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_DECOMPRESS_API_H
+#define MBED_DECOMPRESS_API_H
+
+#include "device.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_FLASH
+#include "hal/flash_api.h"
+#endif
+
+/* Size of the buffer the output of hal_decompress_to_flash() is gathered
+ * in before it is programmed, at least the flash page size.
+ */
+#ifndef MBED_CONF_TARGET_DECOMPRESS_BUFFER_SIZE
+#define MBED_CONF_TARGET_DECOMPRESS_BUFFER_SIZE 1024
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_decompress Decompression
+ * Decompression of firmware images and assets compressed with pithy
+ *
+ * The data is in the format of the pithy LZ77 compressor
+ * (http://github.com/johnezang/pithy): the decompressed length, then
+ * literals and copies of earlier output. Decoding is a byte copy loop with
+ * no table, and the compressed data is read in place, so it can be stored
+ * in a memory-mapped flash or a QSPI memory mapped for XIP.
+ *
+ * hal_decompress_to_flash() streams the output into flash pages, erasing
+ * the sectors as it reaches them: copies of output already programmed are
+ * read back from the flash, so only one buffer of output is held in RAM
+ * whatever the image size.
+ *
+ * @code
+ * // Install the compressed image received in the staging slot
+ * if (hal_decompress_to_flash(&flash, APPLICATION_ADDR, staging, staging_size) != 0) {
+ *     // Keep the staging slot for another attempt
+ * }
+ * @endcode
+ *
+ * # Defined behaviour
+ * * Function hal_decompress() outputs the data given to the compressor -
+ *   verified by test ::decompress_test.
+ * * Function hal_decompress_to_flash() programs the data given to the
+ *   compressor at the address - verified by test ::decompress_to_flash_test.
+ * * Both functions return -1 for truncated or corrupted data, or if the
+ *   output doesn't fit - verified by test ::decompress_invalid_test.
+ *
+ * # Undefined behaviour
+ * * Calling hal_decompress_to_flash() from several threads at once.
+ * * Compressed data overlapping the flash range the output is programmed to.
+ *
+ * @{
+ */
+
+/** Get the decompressed length of compressed data
+ *
+ * \param compressed The compressed data
+ * \param size       Size of the compressed data in bytes
+ * \param length     The decompressed length in bytes
+ * \return 0 for success, -1 if the length is not valid
+ */
+int hal_decompress_get_length(const uint8_t *compressed, size_t size, size_t *length);
+
+/** Decompress data into memory
+ *
+ * \param compressed  The compressed data
+ * \param size        Size of the compressed data in bytes
+ * \param output      Buffer receiving the decompressed data
+ * \param output_size Size of the buffer in bytes
+ * \return 0 for success, -1 if the data is not valid or doesn't fit
+ */
+int hal_decompress(const uint8_t *compressed, size_t size, uint8_t *output, size_t output_size);
+
+#if DEVICE_FLASH
+/** Decompress data into flash
+ *
+ * The sectors of the output range which are not blank are erased as the
+ * output reaches them. The last page is padded with the erase value.
+ *
+ * \param obj        The flash object
+ * \param address    Address of the output, at the start of a sector
+ * \param compressed The compressed data
+ * \param size       Size of the compressed data in bytes
+ * \return 0 for success, -1 if the data is not valid, doesn't fit in the
+ *         flash, or for a flash error
+ */
+int hal_decompress_to_flash(flash_t *obj, uint32_t address, const uint8_t *compressed, size_t size);
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_DECOMPRESS_API_H
+
+/**@}*/
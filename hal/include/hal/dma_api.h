@@ -0,0 +1,239 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_DMA_API_H
+#define MBED_DMA_API_H
+
+#include "device.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_DMA
+
+/* Smallest copy or fill done with DMA by hal_dma_memcpy() and friends */
+#ifndef MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD
+#define MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD 256
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_dma DMA controller
+ * Channel allocation and transfers shared by the drivers of a target
+ *
+ * Drivers allocate a channel for the DMA request of their peripheral when
+ * they start using DMA, and free it when they stop, instead of each driver
+ * using channels chosen at build time. A driver which doesn't get a channel
+ * falls back to transfers driven by interrupts.
+ *
+ * A transfer is a list of descriptors, executed in order. Each descriptor
+ * moves a number of items between a source and a destination which are
+ * either incremented after each item, for memory, or fixed, for a peripheral
+ * data register.
+ *
+ * The buffers must be kept coherent with the data cache by the caller, see
+ * hal/cache_api.h.
+ *
+ * # Defined behavior
+ * * ::hal_dma_channel_allocate returns a free channel able to serve the
+ *   request, or -1 if there is none
+ * * A channel is not returned by ::hal_dma_channel_allocate again until it is
+ *   freed with ::hal_dma_channel_free
+ * * ::hal_dma_channel_allocate and ::hal_dma_channel_free are safe to call
+ *   from interrupt handlers
+ * * ::hal_dma_start executes the descriptors of the list in order, then calls
+ *   the handler with DMA_EVENT_COMPLETE from interrupt context
+ * * The handler is called with DMA_EVENT_ERROR and the transfer stops if the
+ *   controller reports a bus error
+ * * ::hal_dma_abort stops the transfer without calling the handler
+ * * ::hal_dma_is_busy returns true from ::hal_dma_start until the handler is
+ *   called or the transfer is aborted
+ *
+ * # Undefined behavior
+ * * Using a channel which is not allocated
+ * * Calling ::hal_dma_start on a busy channel
+ * * Modifying the descriptors or the buffers of an ongoing transfer
+ *
+ * # Requirements for targets
+ * * DEVICE_DMA_CHANNEL_COUNT is defined in device.h, or a file included from
+ *   there, to the number of channels, at most 32
+ * * Controllers without linked-list support chain the descriptors from their
+ *   transfer complete interrupt
+ *
+ * @{
+ */
+
+/** Request line connecting a peripheral to the DMA controller
+ *
+ * The values are target specific. DMA_REQUEST_MEMORY is for memory-to-memory
+ * transfers.
+ */
+typedef uint32_t dma_request_t;
+
+/** Request of memory-to-memory transfers */
+#define DMA_REQUEST_MEMORY 0xFFFFFFFFUL
+
+/** Size of the items moved by a descriptor */
+typedef enum {
+    DMA_WIDTH_8BIT  = 1,
+    DMA_WIDTH_16BIT = 2,
+    DMA_WIDTH_32BIT = 4
+} dma_width_t;
+
+/** Events reported to the handler of a transfer */
+typedef enum {
+    DMA_EVENT_COMPLETE = (1 << 0),   /**< All the descriptors have been executed */
+    DMA_EVENT_ERROR    = (1 << 1)    /**< The transfer stopped on a bus error */
+} dma_event_t;
+
+/** Transfer descriptor
+ *
+ * Descriptors may be const and in flash, for lists repeated unchanged.
+ */
+typedef struct dma_descriptor_s {
+    const volatile void *src;               /**< Source of the first item */
+    volatile void *dst;                     /**< Destination of the first item */
+    size_t count;                           /**< Number of items */
+    dma_width_t width;                      /**< Size of the items */
+    bool src_increment;                     /**< Increment the source after each item */
+    bool dst_increment;                     /**< Increment the destination after each item */
+    const struct dma_descriptor_s *next;    /**< Next descriptor of the list, NULL for the last */
+} dma_descriptor_t;
+
+/** Handler called from interrupt context at the end of a transfer
+ *
+ * @param id     The id given to ::hal_dma_start
+ * @param events The logical OR of the dma_event_t that occurred
+ */
+typedef void (*dma_handler)(uint32_t id, uint32_t events);
+
+/** Allocate a channel
+ *
+ * @param request Request the channel will serve
+ * @return The channel, or -1 if no free channel can serve the request
+ */
+int hal_dma_channel_allocate(dma_request_t request);
+
+/** Free a channel
+ *
+ * @param channel Channel returned by ::hal_dma_channel_allocate, -1 is ignored
+ */
+void hal_dma_channel_free(int channel);
+
+/** Get the channels able to serve a request
+ *
+ * Implemented by the target.
+ *
+ * @param request Request to serve
+ * @return Bitmap of the channels, bit n set for channel n
+ */
+uint32_t hal_dma_channel_mask(dma_request_t request);
+
+/** Connect a channel to a request
+ *
+ * Implemented by the target. Called by ::hal_dma_channel_allocate.
+ *
+ * @param channel Channel to configure
+ * @param request Request the channel serves
+ */
+void hal_dma_channel_init(int channel, dma_request_t request);
+
+/** Start a transfer
+ *
+ * Implemented by the target.
+ *
+ * @param channel Channel to use
+ * @param list    First descriptor of the list
+ * @param handler Handler called at the end of the transfer, or NULL
+ * @param id      Argument of the handler
+ */
+void hal_dma_start(int channel, const dma_descriptor_t *list, dma_handler handler, uint32_t id);
+
+/** Stop a transfer
+ *
+ * Implemented by the target.
+ *
+ * @param channel Channel to stop
+ */
+void hal_dma_abort(int channel);
+
+/** Check if a transfer is ongoing
+ *
+ * Implemented by the target.
+ *
+ * @param channel Channel to check
+ * @return true until the transfer completes, fails or is aborted
+ */
+bool hal_dma_is_busy(int channel);
+
+/** Copy memory with DMA
+ *
+ * Copies below MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD bytes, from interrupt
+ * handlers, or when no memory-to-memory channel is free, are done with
+ * memcpy. Otherwise the core sleeps with hal_sleep() until the copy is
+ * complete. Both buffers are kept coherent with the data cache.
+ *
+ * @param dst  Destination
+ * @param src  Source
+ * @param size Number of bytes to copy
+ * @return dst
+ */
+void *hal_dma_memcpy(void *dst, const void *src, size_t size);
+
+/** Fill memory with DMA
+ *
+ * Falls back to memset like ::hal_dma_memcpy falls back to memcpy.
+ *
+ * @param dst   Destination
+ * @param value Value of the bytes, converted to uint8_t
+ * @param size  Number of bytes to fill
+ * @return dst
+ */
+void *hal_dma_memset(void *dst, int value, size_t size);
+
+/** Start copying memory with DMA
+ *
+ * The handler is called with DMA_EVENT_COMPLETE, or DMA_EVENT_ERROR, once the
+ * copy is done and the destination is coherent with the data cache. Copies
+ * below MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD bytes, or when no
+ * memory-to-memory channel is free, are done with memcpy and the handler is
+ * called before this function returns.
+ *
+ * @param dst     Destination
+ * @param src     Source
+ * @param size    Number of bytes to copy
+ * @param handler Handler called at the end of the copy
+ * @param id      Argument of the handler
+ */
+void hal_dma_memcpy_async(void *dst, const void *src, size_t size, dma_handler handler, uint32_t id);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_DMA
+
+#endif // MBED_DMA_API_H
+
+/** @}*/
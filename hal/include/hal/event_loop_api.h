@@ -0,0 +1,161 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_EVENT_LOOP_API_H
+#define MBED_EVENT_LOOP_API_H
+
+#include "device.h"
+#include "bootstrap/mbed_toolchain.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of events pending at the same time, including the periodic ones
+ */
+#ifndef MBED_CONF_TARGET_EVENT_LOOP_EVENTS
+#define MBED_CONF_TARGET_EVENT_LOOP_EVENTS 16
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_event_loop Event loop
+ * Cooperative event loop for bare-metal applications
+ *
+ * Interrupt handlers post calls to the event loop to move their work out
+ * of interrupt context, and timed calls are run once their time is reached.
+ * Every callback runs from ::hal_event_dispatch, in the context of the main
+ * loop, one after the other, so callbacks share data without locking but
+ * must not block.
+ *
+ * Posting is lock-free and takes a constant time: the event is allocated
+ * from a ::mbed_mem_pool_t and pushed to a lock-free list. Timed events are
+ * sorted by the dispatcher, which wakes ::hal_idle up for the earliest one
+ * with a TICKER_WAKEUP_ID event, so the ticker handler of the application is
+ * left alone. The lp ticker is used on targets which have one, so the event
+ * loop can use deep sleep, the us ticker otherwise.
+ *
+ * @code
+ * static void process_rx(void *context)
+ * {
+ *     ...
+ * }
+ *
+ * void uart_rx_irq(void)
+ * {
+ *     hal_event_call(process_rx, &rx_buffer);
+ * }
+ *
+ * int main(void)
+ * {
+ *     hal_event_call_every(500000, toggle_led, NULL);
+ *     hal_event_loop_run();
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * Events posted with ::hal_event_call run in the order they were posted
+ * * A timed event runs from the first ::hal_event_dispatch after its time
+ * * A periodic event runs at a fixed rate, periods missed while the loop was
+ *   busy are skipped
+ * * The posting functions and ::hal_event_cancel are safe to call from
+ *   interrupt handlers
+ * * The posting functions return NULL when MBED_CONF_TARGET_EVENT_LOOP_EVENTS
+ *   events are pending
+ * * A cancelled event doesn't run again, it is released when it would
+ *   have run
+ *
+ * # Undefined behavior
+ * * Calling ::hal_event_dispatch or ::hal_event_loop_run from an interrupt
+ *   handler, or from a callback
+ * * Cancelling an event which has already run, other than a periodic event
+ *
+ * @{
+ */
+
+/** Callback of an event
+ *
+ * @param context The context given when the event was posted
+ */
+typedef void (*hal_event_callback_t)(void *context);
+
+/** Event posted to the event loop */
+typedef struct hal_event_s hal_event_t;
+
+/** Post a call to the next dispatch
+ *
+ * @param callback The callback
+ * @param context  The context of the callback
+ * @return The event, or NULL if no event is free
+ */
+hal_event_t *hal_event_call(hal_event_callback_t callback, void *context);
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+/** Post a call after a delay
+ *
+ * @param delay_us The delay in microseconds
+ * @param callback The callback
+ * @param context  The context of the callback
+ * @return The event, or NULL if no event is free
+ */
+hal_event_t *hal_event_call_in(uint32_t delay_us, hal_event_callback_t callback, void *context);
+
+/** Post a periodic call, first run one period from now
+ *
+ * @param period_us The period in microseconds, not 0
+ * @param callback  The callback
+ * @param context   The context of the callback
+ * @return The event, or NULL if no event is free
+ */
+hal_event_t *hal_event_call_every(uint32_t period_us, hal_event_callback_t callback, void *context);
+#endif
+
+/** Cancel a pending event
+ *
+ * @param event The event returned when it was posted
+ */
+void hal_event_cancel(hal_event_t *event);
+
+/** Run the events posted and the timed events due
+ *
+ * Events posted by the callbacks run from the next dispatch.
+ *
+ * @return The number of callbacks run
+ */
+size_t hal_event_dispatch(void);
+
+/** Dispatch the events forever, idling in between
+ *
+ * The core sleeps with ::hal_idle on targets with sleep, until an interrupt
+ * posts an event or the next timed event is due.
+ */
+MBED_NORETURN void hal_event_loop_run(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_EVENT_LOOP_API_H
+
+/** @}*/
@@ -21,6 +21,7 @@
 #define MBED_FLASH_API_H
 
 #include "device.h"
+#include <stdbool.h>
 #include <stdint.h>
 
 #if DEVICE_FLASH
@@ -29,6 +30,29 @@
 
 typedef struct flash_s flash_t;
 
+/** Flash asynchronous operation handler
+ * @param id     The id given when the operation was started
+ * @param status 0 if the operation completed, -1 for error
+ */
+typedef void (*flash_async_handler)(uint32_t id, int32_t status);
+
+/** Flash accelerator settings
+ */
+typedef struct {
+    uint32_t wait_states; /**< Number of wait states for reads */
+    bool icache;          /**< Instruction cache enabled */
+    bool dcache;          /**< Data cache enabled */
+    bool prefetch;        /**< Prefetch buffer enabled */
+} flash_accel_config_t;
+
+/** Flash region of sectors of the same size
+ */
+typedef struct {
+    uint32_t start;       /**< Address of the first sector */
+    uint32_t size;        /**< Size of the region, in bytes */
+    uint32_t sector_size; /**< Size of every sector of the region */
+} flash_region_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -84,6 +108,20 @@ int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint32_t size)
  */
 int32_t flash_program_page(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size);
 
+/** Program a range which may span several pages and sectors
+ *
+ * The address and size must be aligned to the page size and the range must be erased.
+ * Alignment and range are checked once, then the data is written with the widest
+ * write the controller supports. The default implementation calls ::flash_program_page
+ * once per sector.
+ * @param obj The flash object
+ * @param address The starting address, aligned to the page size
+ * @param data The data buffer to be programmed
+ * @param size The number of bytes to program, aligned to the page size
+ * @return 0 for success, -1 for error
+ */
+int32_t flash_program(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size);
+
 /** Get sector size
  *
  * @param obj The flash object
@@ -92,6 +130,19 @@ int32_t flash_program_page(flash_t *obj, uint32_t address, const uint8_t *data,
  */
 uint32_t flash_get_sector_size(const flash_t *obj, uint32_t address);
 
+/** Get the regions of sectors of the same size
+ *
+ * Gives the whole sector geometry at once, so storage layers plan their
+ * erases without calling ::flash_get_sector_size for each sector. The
+ * regions are sorted by address, cover the flash without gap and adjacent
+ * regions have different sector sizes.
+ * @param obj The flash object
+ * @param regions The array receiving the first count regions
+ * @param count The number of elements of regions
+ * @return The number of regions of the flash, which may be greater than count, or -1 for error
+ */
+int32_t flash_get_layout(const flash_t *obj, flash_region_t *regions, uint32_t count);
+
 /** Get page size
  *
  * The page size defines the writable page size
@@ -121,6 +172,131 @@ uint32_t flash_get_size(const flash_t *obj);
  */
 uint8_t flash_get_erase_value(const flash_t *obj);
 
+/** Check if a range reads as erased
+ *
+ * Higher layers call it to skip the erase of sectors which are already
+ * blank, saving the erase time and a program/erase cycle of the sector.
+ * Targets with a hardware blank check command override it. The default
+ * implementation compares the memory mapped flash with the erase value a
+ * word at a time.
+ * @param obj The flash object
+ * @param address The starting address
+ * @param size The number of bytes to check
+ * @return 1 if every byte equals ::flash_get_erase_value, 0 if not, -1 for error
+ */
+int32_t flash_is_blank(flash_t *obj, uint32_t address, uint32_t size);
+
+/** Get the bank of an address
+ * While a bank is erased or programmed, the other banks can still be read
+ * and executed from, so code serving interrupts must run from another bank
+ * during an asynchronous operation.
+ * The default implementation reports a single bank.
+ * @param obj The flash object
+ * @param address The address
+ * @return The bank index, starting at 0
+ */
+uint32_t flash_get_bank(const flash_t *obj, uint32_t address);
+
+/** Get the number of banks
+ * The default implementation reports a single bank.
+ * @param obj The flash object
+ * @return The number of banks, ::flash_get_bank returns values below it
+ */
+uint32_t flash_get_bank_count(const flash_t *obj);
+
+/** Swap the banks at the next reset
+ * Selects the bank which does not contain the running code as the one mapped
+ * at ::flash_get_start_address, and booted from, after the next reset. An
+ * update is programmed in the inactive bank while the application keeps
+ * running from the active one, with ::flash_program_page_async, then the
+ * banks are swapped and the system reset by ::mbed_start_swapped_application.
+ * The default implementation does not support swapping the banks.
+ * @param obj The flash object
+ * @return 0 if the banks will be swapped, -1 if the flash has a single bank or does not support it
+ */
+int32_t flash_bank_swap(flash_t *obj);
+
+/** Erase one sector without blocking
+ * Same as ::flash_erase_sector, but returns once the erase has started and
+ * calls the handler from interrupt context when it completes. No other
+ * operation may be started on the flash until then.
+ * The default implementation erases synchronously and calls the handler before returning.
+ * @param obj The flash object
+ * @param address The sector starting address
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return 0 if the erase was started, -1 for error, the handler is not called then
+ */
+int32_t flash_erase_sector_async(flash_t *obj, uint32_t address, flash_async_handler handler, uint32_t id);
+
+/** Program pages without blocking
+ * Same as ::flash_program_page, but returns once programming has started and
+ * calls the handler from interrupt context when it completes. The data buffer
+ * must stay valid until then, and no other operation may be started on the flash.
+ * The default implementation programs synchronously and calls the handler before returning.
+ * @param obj The flash object
+ * @param address The sector starting address
+ * @param data The data buffer to be programmed
+ * @param size The number of bytes to program
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return 0 if programming was started, -1 for error, the handler is not called then
+ */
+int32_t flash_program_page_async(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, flash_async_handler handler, uint32_t id);
+
+/** Get the progress of the asynchronous operation
+ * @param obj The flash object
+ * @return The number of bytes erased or programmed so far, 0 if no operation is in progress
+ */
+uint32_t flash_async_progress(const flash_t *obj);
+
+/** Suspend the ongoing asynchronous erase
+ * The whole flash can be read while the erase is suspended. The default
+ * implementation does not support suspending.
+ * @param obj The flash object
+ * @return 0 if the erase is suspended, -1 if there is no erase to suspend or suspending is not supported
+ */
+int32_t flash_erase_suspend(flash_t *obj);
+
+/** Resume the erase suspended by ::flash_erase_suspend
+ * @param obj The flash object
+ * @return 0 if the erase was resumed, -1 for error
+ */
+int32_t flash_erase_resume(flash_t *obj);
+
+/** Get the flash accelerator settings
+ * The default implementation reports zero wait states with caches and prefetch disabled.
+ * @param obj The flash object
+ * @param config Filled with the current settings
+ * @return 0 for success, -1 for error
+ */
+int32_t flash_get_accel_config(const flash_t *obj, flash_accel_config_t *config);
+
+/** Configure wait states, caches and prefetch
+ * Wait states must meet the minimum required by the current core clock; increase them
+ * before raising the clock and reduce them after lowering it. Caches are invalidated
+ * before being enabled. The default implementation does not support configuration.
+ * @param obj The flash object
+ * @param config The settings to apply
+ * @return 0 for success, -1 if a setting is not supported or the wait states are too low
+ */
+int32_t flash_set_accel_config(flash_t *obj, const flash_accel_config_t *config);
+
+/** Get the minimum number of wait states for a core clock frequency
+ * @param obj The flash object
+ * @param hz The core clock frequency in Hz
+ * @return The minimum number of wait states
+ */
+uint32_t flash_get_min_wait_states(const flash_t *obj, uint32_t hz);
+
+/** Invalidate the flash instruction and data caches
+ * Called after erasing or programming so that stale contents are not read back.
+ * Implementations of ::flash_erase_sector and ::flash_program_page with caches
+ * enabled must call it before returning. The default implementation does nothing.
+ * @param obj The flash object
+ */
+void flash_cache_invalidate(flash_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
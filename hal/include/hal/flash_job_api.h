@@ -0,0 +1,159 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_FLASH_JOB_API_H
+#define MBED_FLASH_JOB_API_H
+
+#include "device.h"
+
+#if DEVICE_FLASH
+
+#include "hal/flash_api.h"
+
+#include <stdint.h>
+
+/** Largest number of bytes a program job programs per chunk, rounded down to
+ * a multiple of the page size, one page at least
+ */
+#ifndef MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE
+#define MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE 1024
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_flash_job Flash jobs
+ * Long erases and programs split in chunks
+ *
+ * A job erases a range one sector per chunk, or programs it
+ * MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE bytes per chunk, so that
+ * something else can run between the chunks:
+ * * ::flash_job_run blocks until the job is done, kicking the watchdog
+ *   after each chunk, so the watchdog timeout only has to cover the
+ *   longest sector erase instead of the whole update
+ * * ::flash_job_start runs one chunk per ::hal_event_dispatch, so the
+ *   other events keep being served and the main loop services the
+ *   watchdog, or its supervisor, as usual
+ *
+ * Sectors which are already blank are not erased again.
+ *
+ * @code
+ * static flash_job_t job;
+ *
+ * static void erased(flash_job_t *job, int32_t status)
+ * {
+ *     ...
+ * }
+ *
+ * flash_job_erase_init(&job, &flash, SLOT_ADDRESS, SLOT_SIZE);
+ * flash_job_start(&job, erased, NULL);
+ * hal_event_loop_run();
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::flash_job_step erases one sector, or programs one chunk, per call
+ * * A job started with ::flash_job_start runs a chunk per dispatch and
+ *   calls its handler from the event loop once done or on error
+ * * A job which failed can be run or started again, it resumes at the
+ *   chunk which failed
+ *
+ * # Undefined behavior
+ * * Other flash operations while a job is in progress
+ * * Calling ::flash_job_run while the watchdog supervisor runs
+ * * Modifying the data of a program job before it is done
+ *
+ * @{
+ */
+
+typedef struct flash_job flash_job_t;
+
+/** Completion handler of a job started with ::flash_job_start
+ *
+ * @param job    The job
+ * @param status 0 if the job is done, -1 for error
+ */
+typedef void (*flash_job_handler_t)(flash_job_t *job, int32_t status);
+
+/** Erase or program job, the fields are private
+ */
+struct flash_job {
+    flash_t *flash;
+    const uint8_t *data; /**< Data left to program, NULL for an erase job >*/
+    uint32_t address;    /**< Address of the next chunk >*/
+    uint32_t end;        /**< End address of the range >*/
+    flash_job_handler_t handler;
+    void *context;       /**< Context given to ::flash_job_start >*/
+};
+
+/** Prepare a job erasing a range
+ *
+ * @param job     The job
+ * @param obj     The flash object
+ * @param address The start address, at the start of a sector
+ * @param size    The size, up to the end of a sector
+ * @return 0 for success, -1 if the range is not made of whole sectors
+ */
+int32_t flash_job_erase_init(flash_job_t *job, flash_t *obj, uint32_t address, uint32_t size);
+
+/** Prepare a job programming an erased range
+ *
+ * @param job     The job
+ * @param obj     The flash object
+ * @param address The start address, aligned to the page size
+ * @param data    The data, valid until the job is done
+ * @param size    The size, aligned to the page size
+ * @return 0 for success, -1 if the range is not aligned or out of the flash
+ */
+int32_t flash_job_program_init(flash_job_t *job, flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size);
+
+/** Run the next chunk of a job
+ *
+ * @param job The job
+ * @return 1 if there are chunks left, 0 if the job is done, -1 for error
+ */
+int32_t flash_job_step(flash_job_t *job);
+
+/** Run a job to completion, kicking the watchdog after each chunk
+ *
+ * @param job The job
+ * @return 0 if the job is done, -1 for error
+ */
+int32_t flash_job_run(flash_job_t *job);
+
+/** Run a job from the event loop, a chunk per dispatch
+ *
+ * @param job     The job
+ * @param handler The handler called once the job is done or failed
+ * @param context The context stored in the job
+ * @return 0 if the job was posted, -1 if no event is free
+ */
+int32_t flash_job_start(flash_job_t *job, flash_job_handler_t handler, void *context);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_FLASH
+#endif // MBED_FLASH_JOB_API_H
+
+/** @}*/
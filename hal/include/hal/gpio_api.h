@@ -20,9 +20,11 @@
 #ifndef MBED_GPIO_API_H
 #define MBED_GPIO_API_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "device.h"
 #include "pinmap.h"
+#include "hal/ticker_api.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -84,6 +86,36 @@ void port_write(port_t *obj, int value);
  */
 int port_read(port_t *obj);
 
+/* Targets with set/clear/toggle registers may provide the following functions as
+ * static inline in their objects.h and define GPIO_BITS_INLINE. Otherwise they are
+ * regular functions: the default implementation does a read-modify-write of the port
+ * in a critical section and targets should override it with a single register write.
+ */
+#ifndef GPIO_BITS_INLINE
+
+/** Set port bits to 1, leaving the others unchanged
+ *
+ * @param obj  The port object
+ * @param bits The bits to set, restricted to the port mask
+ */
+void port_set_bits(port_t *obj, int bits);
+
+/** Clear port bits to 0, leaving the others unchanged
+ *
+ * @param obj  The port object
+ * @param bits The bits to clear, restricted to the port mask
+ */
+void port_clear_bits(port_t *obj, int bits);
+
+/** Toggle port bits, leaving the others unchanged
+ *
+ * @param obj  The port object
+ * @param bits The bits to toggle, restricted to the port mask
+ */
+void port_toggle_bits(port_t *obj, int bits);
+
+#endif // GPIO_BITS_INLINE
+
 #endif // DEVICE_PORTIN || DEVICE_PORTOUT
 
 #if DEVICE_INTERRUPTIN
@@ -102,6 +134,50 @@ typedef struct gpio_irq_s gpio_irq_t;
 
 typedef void (*gpio_irq_handler)(uint32_t id, gpio_irq_event event);
 
+/** Number of edges a ::gpio_irq_queue_t holds, must be a power of two
+ */
+#ifndef MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE
+#define MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE 32
+#endif
+
+/** Timestamped GPIO IRQ edge
+ */
+typedef struct {
+    uint32_t id;          /**< The id given to ::gpio_irq_init_queued */
+    gpio_irq_event event; /**< The edge */
+    uint32_t timestamp;   /**< us ticker counter value when the edge occurred */
+} gpio_irq_edge_t;
+
+/** Queue of timestamped edges, pushed from interrupts and drained from thread context
+ */
+typedef struct {
+    gpio_irq_edge_t edges[MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE];
+    volatile uint32_t head;    /**< Count of edges pushed */
+    volatile uint32_t tail;    /**< Count of edges popped */
+    volatile uint32_t dropped; /**< Count of edges lost because the queue was full */
+} gpio_irq_queue_t;
+
+/** GPIO IRQ pushing its edges to a queue
+ */
+typedef struct {
+    gpio_irq_t *irq;         /**< The GPIO IRQ object */
+    gpio_irq_queue_t *queue; /**< The queue edges go to */
+    uint32_t id;             /**< The id stored with each edge */
+} gpio_irq_queued_t;
+
+/** GPIO IRQ calling its handler once per debounced edge
+ */
+typedef struct {
+    gpio_irq_t *irq;          /**< The GPIO IRQ object */
+    gpio_irq_handler handler; /**< The handler of the debounced edges */
+    uint32_t id;              /**< The id passed to the handler */
+    uint32_t debounce_us;     /**< The debounce time, 0 without a filter */
+    bool hardware;            /**< The hardware glitch filter of the pin is used */
+    uint8_t events;           /**< Bit n set if event n is enabled with ::gpio_irq_set_debounced */
+    volatile bool masked;     /**< The edges are disabled until the end of the debounce time */
+    ticker_event_t event;     /**< us ticker event enabling the edges again */
+} gpio_irq_debounced_t;
+
 /**
  * \defgroup hal_gpioirq GPIO IRQ HAL functions
  *
@@ -112,6 +188,8 @@ typedef void (*gpio_irq_handler)(uint32_t id, gpio_irq_event event);
  * * ::gpio_irq_set enables/disables pin IRQ event
  * * ::gpio_irq_enable enables GPIO IRQ
  * * ::gpio_irq_disable disables GPIO IRQ
+ * * A debounced GPIO IRQ calls its handler for the first edge, then ignores
+ *   the pin for the debounce time, so a bouncing switch gives one call
  *
  * # Undefined behavior
  * * Calling other function before ::gpio_irq_init
@@ -169,6 +247,115 @@ void gpio_irq_disable(gpio_irq_t *obj);
  */
 const PinMap *gpio_irq_pinmap(void);
 
+/** Get the time of the edge being handled
+ *
+ * Called at the start of the GPIO IRQ handler. Targets with input capture return the
+ * captured time instead, converted to the us ticker counter. The default implementation
+ * reads the us ticker.
+ *
+ * @param obj The GPIO IRQ object
+ * @return The us ticker counter value when the edge occurred
+ */
+uint32_t gpio_irq_timestamp(gpio_irq_t *obj);
+
+/** Initialize an edge queue
+ *
+ * @param queue The queue
+ */
+void gpio_irq_queue_init(gpio_irq_queue_t *queue);
+
+/** Initialize a GPIO IRQ pin that pushes timestamped edges to a queue
+ *
+ * Several pins can share a queue. Edges are enabled with ::gpio_irq_set on obj->irq.
+ *
+ * @param obj   The queued GPIO IRQ object to initialize
+ * @param irq   The GPIO IRQ object to use
+ * @param pin   The GPIO pin name
+ * @param queue The queue
+ * @param id    The id stored with each edge
+ * @return -1 if pin is NC, 0 otherwise
+ */
+int gpio_irq_init_queued(gpio_irq_queued_t *obj, gpio_irq_t *irq, PinName pin, gpio_irq_queue_t *queue, uint32_t id);
+
+/** Pop the oldest edge from a queue
+ *
+ * Lock-free, must be called from a single context.
+ *
+ * @param queue The queue
+ * @param edge  Filled with the edge
+ * @return true if an edge was popped, false if the queue is empty
+ */
+bool gpio_irq_queue_pop(gpio_irq_queue_t *queue, gpio_irq_edge_t *edge);
+
+/** Get the number of edges lost because a queue was full
+ *
+ * @param queue The queue
+ * @return The number of edges dropped since ::gpio_irq_queue_init
+ */
+uint32_t gpio_irq_queue_dropped(const gpio_irq_queue_t *queue);
+
+/** Set the glitch filter of a GPIO IRQ pin
+ *
+ * Targets with a hardware filter on their interrupt lines override the default
+ * implementation, which returns -1. The filter covers pulses up to the
+ * debounce time, rounded up.
+ *
+ * @param obj         The GPIO IRQ object
+ * @param debounce_us The shortest pulse reported, 0 to disable the filter
+ * @return 0 if the filter is set, -1 if the pin has none or the time is out of its range
+ */
+int gpio_irq_debounce_set(gpio_irq_t *obj, uint32_t debounce_us);
+
+/** Initialize a GPIO IRQ pin that calls its handler once per debounced edge
+ *
+ * The hardware glitch filter of the pin is used where ::gpio_irq_debounce_set
+ * supports it. Otherwise the edges are filtered in software: the first edge
+ * disables the edges of the pin with ::gpio_irq_set, and a us ticker event
+ * enables them again after the debounce time, so the bounces take no
+ * interrupt. An edge which ends during the debounce time, such as a short
+ * press, is not reported.
+ *
+ * The software filter sets the handler of the us ticker, whose events must
+ * then not be used for anything else, and its pin interrupt must be masked by
+ * critical sections. Edges are enabled with ::gpio_irq_set_debounced.
+ *
+ * @param obj         The debounced GPIO IRQ object to initialize
+ * @param irq         The GPIO IRQ object to use
+ * @param pin         The GPIO pin name
+ * @param debounce_us The debounce time
+ * @param handler     The handler of the debounced edges
+ * @param id          The id passed to the handler
+ * @return -1 if pin is NC, 0 otherwise
+ */
+int gpio_irq_init_debounced(gpio_irq_debounced_t *obj, gpio_irq_t *irq, PinName pin, uint32_t debounce_us, gpio_irq_handler handler, uint32_t id);
+
+/** Enable or disable an edge of a debounced GPIO IRQ
+ *
+ * During the debounce time, the edge is only enabled once the time ends.
+ *
+ * @param obj    The debounced GPIO IRQ object
+ * @param event  The GPIO IRQ event
+ * @param enable The enable flag
+ */
+void gpio_irq_set_debounced(gpio_irq_debounced_t *obj, gpio_irq_event event, uint32_t enable);
+
+/** Pass an edge through the software filter of a debounced GPIO IRQ
+ *
+ * Called by the interrupt handler of the pin. Targets which take the edges
+ * from elsewhere, such as an input capture, call it too.
+ *
+ * @param obj   The debounced GPIO IRQ object
+ * @param event The edge
+ */
+void gpio_irq_debounce_edge(gpio_irq_debounced_t *obj, gpio_irq_event event);
+
+/** Check whether a debounced GPIO IRQ uses the hardware glitch filter
+ *
+ * @param obj The debounced GPIO IRQ object
+ * @return true with the hardware filter, false with the software one or without a filter
+ */
+bool gpio_irq_debounce_in_hardware(const gpio_irq_debounced_t *obj);
+
 /**@}*/
 
 #endif // DEVICE_INTERRUPTIN
@@ -212,12 +399,35 @@ const PinMap *gpio_irq_pinmap(void);
  *
  */
 
+/** GPIO output speed, the slew rate of the edges
+ *
+ * Pins of high-speed buses need the faster edges, other pins should keep
+ * GPIO_SPEED_LOW for lower EMI and power.
+ */
+typedef enum {
+    GPIO_SPEED_LOW = 0,
+    GPIO_SPEED_MEDIUM,
+    GPIO_SPEED_HIGH,
+    GPIO_SPEED_VERY_HIGH
+} gpio_speed_t;
+
+/** GPIO output drive strength
+ */
+typedef enum {
+    GPIO_DRIVE_LOW = 0,
+    GPIO_DRIVE_MEDIUM,
+    GPIO_DRIVE_HIGH,
+    GPIO_DRIVE_VERY_HIGH
+} gpio_drive_t;
+
 /** GPIO capabilities for a given pin
  */
 typedef struct {
     uint8_t pull_none : 1;
     uint8_t pull_down : 1;
     uint8_t pull_up : 1;
+    uint8_t speeds : 4;   /**< Bit (1 << speed) set for each gpio_speed_t supported, 0 if the speed is fixed */
+    uint8_t drives : 4;   /**< Bit (1 << drive) set for each gpio_drive_t supported, 0 if the drive is fixed */
 } gpio_capabilities_t;
 
 /** Set the given pin as GPIO
@@ -275,6 +485,38 @@ void gpio_write(gpio_t *obj, int value);
  */
 int gpio_read(gpio_t *obj);
 
+/** Set the output speed
+ *
+ * Targets use the nearest speed they support, see ::gpio_get_capabilities. The
+ * default implementation does nothing.
+ *
+ * @param obj   The GPIO object (must be connected)
+ * @param speed The output speed to be set
+ */
+void gpio_speed(gpio_t *obj, gpio_speed_t speed);
+
+/** Set the output drive strength
+ *
+ * Targets use the nearest drive strength they support, see
+ * ::gpio_get_capabilities. The default implementation does nothing.
+ *
+ * @param obj   The GPIO object (must be connected)
+ * @param drive The drive strength to be set
+ */
+void gpio_drive(gpio_t *obj, gpio_drive_t drive);
+
+#ifndef GPIO_BITS_INLINE
+
+/** Toggle the output value
+ *
+ * Targets may provide it as static inline, see ::port_set_bits.
+ *
+ * @param obj The GPIO object (must be connected)
+ */
+void gpio_toggle(gpio_t *obj);
+
+#endif // GPIO_BITS_INLINE
+
 // the following functions are generic and implemented in the common gpio.c file
 // TODO: fix, will be moved to the common gpio header file
 
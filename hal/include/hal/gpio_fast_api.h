@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_GPIO_FAST_API_H
+#define MBED_GPIO_FAST_API_H
+
+#include "hal/gpio_api.h"
+
+/**
+ * \defgroup hal_gpio_fast GPIO fast path
+ *
+ * Header-only GPIO access for time critical code such as bit-banged buses.
+ *
+ * Targets with DEVICE_GPIO_FAST provide a gpio_fast.h defining ::gpio_fast_write,
+ * ::gpio_fast_read and ::gpio_fast_toggle as static inline functions. They use register
+ * pointers and pin masks that ::gpio_init precomputes in gpio_t, so no call is made.
+ * Other targets fall back on ::gpio_write, ::gpio_read and ::gpio_toggle.
+ *
+ * # Defined behavior
+ * * The fast functions behave as ::gpio_write, ::gpio_read and ::gpio_toggle - Verified by ::fpga_test_fast_input_output
+ *
+ * # Undefined behavior
+ * * Calling the fast functions on a gpio_t object that was initialized with NC
+ *
+ * @{
+ */
+
+#if DEVICE_GPIO_FAST
+
+#include "gpio_fast.h"
+
+#else
+
+/** Set the output value
+ *
+ * @param obj   The GPIO object (must be connected)
+ * @param value The value to be set
+ */
+static inline void gpio_fast_write(gpio_t *obj, int value)
+{
+    gpio_write(obj, value);
+}
+
+/** Read the input value
+ *
+ * @param obj The GPIO object (must be connected)
+ * @return An integer value 1 or 0
+ */
+static inline int gpio_fast_read(gpio_t *obj)
+{
+    return gpio_read(obj);
+}
+
+/** Toggle the output value
+ *
+ * @param obj The GPIO object (must be connected)
+ */
+static inline void gpio_fast_toggle(gpio_t *obj)
+{
+    gpio_toggle(obj);
+}
+
+#endif // DEVICE_GPIO_FAST
+
+/**@}*/
+
+#endif // MBED_GPIO_FAST_API_H
+
+/**@}*/
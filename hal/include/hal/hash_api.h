@@ -0,0 +1,245 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_HASH_API_H
+#define MBED_HASH_API_H
+
+#include "device.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Size of the blocks the hash module processes, in bytes */
+#define HAL_HASH_BLOCK_SIZE 64
+
+/** Largest digest size, in bytes */
+#define HAL_HASH_MAX_DIGEST_SIZE 32
+
+/** Number of words of the largest chaining value */
+#define HAL_HASH_STATE_WORDS 8
+
+/* Blocks hashed per critical section by hal_hash_ctx_update(), which bounds
+ * the interrupt latency it adds. Large buffers should use
+ * hal_hash_ctx_update_async().
+ */
+#ifndef MBED_CONF_TARGET_HASH_SECTION_BLOCKS
+#define MBED_CONF_TARGET_HASH_SECTION_BLOCKS 16
+#endif
+
+/** Hash algorithm
+ */
+typedef enum hal_hash_algorithm {
+    HAL_HASH_SHA1,   ///< SHA-1, 20 byte digest
+    HAL_HASH_SHA224, ///< SHA-224, 28 byte digest
+    HAL_HASH_SHA256  ///< SHA-256, 32 byte digest
+} hal_hash_algorithm_t;
+
+/** Hash computation context
+ *
+ * Holds the chaining value and the incomplete block of one computation, so
+ * several computations can share the hash module.
+ */
+typedef struct hal_hash_ctx {
+    /** Algorithm given to hal_hash_ctx_start() */
+    hal_hash_algorithm_t algorithm;
+    /** Chaining value, the first word is H0 */
+    uint32_t state[HAL_HASH_STATE_WORDS];
+    /** Number of bytes appended */
+    uint64_t length;
+    /** Bytes appended after the last complete block */
+    uint8_t block[HAL_HASH_BLOCK_SIZE];
+} hal_hash_ctx_t;
+
+/** Handler called when an asynchronous hash operation completes
+ * @param id The id given to the asynchronous function
+ */
+typedef void (*hal_hash_async_handler)(uint32_t id);
+
+#if DEVICE_HASH
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_hash Hardware hash
+ *
+ * The hardware hash HAL API provides a low-level interface to the SHA-1 and
+ * SHA-2 accelerator of a target platform.
+ *
+ * Targets implement the block functions: hal_hash_compute_partial_start()
+ * loads a chaining value, hal_hash_compute_partial() hashes complete blocks
+ * and hal_hash_get_state() reads the chaining value back. The context
+ * functions are built upon them, they append the padding and keep the state
+ * of each computation in a hal_hash_ctx_t, so that computations can be
+ * interleaved. Targets with DMA override hal_hash_compute_partial_async().
+ *
+ * @code
+ * hal_hash_ctx_t ctx;
+ * uint8_t digest[32];
+ *
+ * hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+ * hal_hash_ctx_update(&ctx, image, image_size);
+ * hal_hash_ctx_get_digest(&ctx, digest);
+ * @endcode
+ *
+ * # Defined behaviour
+ *
+ * * Macro HAL_HASH_IS_SUPPORTED() evaluates true for SHA-256 - verified by
+ *   test ::hash_is_supported_test.
+ * * The digests of the FIPS 180-4 examples are computed for every supported
+ *   algorithm - verified by test ::hash_calc_test.
+ * * Function hal_hash_ctx_update() can be called multiple times in
+ *   succession, with any data size - verified by test ::hash_calc_multi_test.
+ * * Function hal_hash_ctx_get_digest() does not modify the context - verified
+ *   by test ::hash_calc_multi_test.
+ * * Computations in different hal_hash_ctx_t contexts can be interleaved
+ *   - verified by test ::hash_ctx_interleave_test.
+ * * Function hal_hash_ctx_update_async() calls its handler once the data is
+ *   appended - verified by test ::hash_ctx_interleave_test.
+ *
+ * # Undefined behaviour
+ *
+ * * Calling hal_hash_ctx_start() with an unsupported algorithm.
+ * * Calling hal_hash_ctx_update() while an asynchronous update is in progress.
+ * * Modifying the data or the context of an asynchronous update before its
+ *   handler is called.
+ *
+ * # Macros
+ *
+ * Platform support for hash algorithms is indicated by the macro
+ * HAL_HASH_IS_SUPPORTED(algorithm), which must be defined in device.h, or a
+ * file included from there. It must evaluate to a constant boolean
+ * expression when given a constant parameter, and be true for SHA-256.
+ *
+ * Example:
+ *
+ *    #define HAL_HASH_IS_SUPPORTED(algorithm) ((algorithm) != HAL_HASH_SHA1)
+ * @{
+ */
+
+/** Load a chaining value into the hash module
+ *
+ * The following blocks given to hal_hash_compute_partial() are hashed with
+ * it, as if the blocks hashed before had produced it.
+ *
+ * This function must be called with an algorithm supported by the platform.
+ *
+ * \param algorithm The algorithm
+ * \param state     The chaining value, 5 words for SHA-1 and 8 words for SHA-2
+ */
+void hal_hash_compute_partial_start(hal_hash_algorithm_t algorithm, const uint32_t *state);
+
+/** Hash complete blocks
+ *
+ * No padding is appended, the chaining value is kept in the hash module so
+ * that more blocks can be hashed.
+ *
+ * \param blocks Input data, count * HAL_HASH_BLOCK_SIZE bytes
+ * \param count  Number of blocks
+ */
+void hal_hash_compute_partial(const uint8_t *blocks, size_t count);
+
+/** Hash complete blocks without blocking
+ *
+ * Targets feed the hash module with DMA where available and call the handler
+ * from interrupt context once done. The blocks must stay valid until then.
+ * The default implementation calls hal_hash_compute_partial() and the handler
+ * before returning.
+ *
+ * \param blocks  Input data, count * HAL_HASH_BLOCK_SIZE bytes
+ * \param count   Number of blocks
+ * \param handler The completion handler
+ * \param id      The id passed to the handler
+ */
+void hal_hash_compute_partial_async(const uint8_t *blocks, size_t count, hal_hash_async_handler handler, uint32_t id);
+
+/** Read the chaining value back from the hash module
+ *
+ * \param state The chaining value, 5 words for SHA-1 and 8 words for SHA-2
+ */
+void hal_hash_get_state(uint32_t *state);
+
+/** Get the digest size of an algorithm
+ *
+ * \param algorithm The algorithm
+ * \return The digest size in bytes
+ */
+size_t hal_hash_digest_size(hal_hash_algorithm_t algorithm);
+
+/** Start a computation in a context
+ *
+ * The hash module is not touched; computations in different contexts can be
+ * interleaved with each other.
+ *
+ * \param ctx       The context to initialize
+ * \param algorithm The algorithm, checked for support with HAL_HASH_IS_SUPPORTED()
+ */
+void hal_hash_ctx_start(hal_hash_ctx_t *ctx, hal_hash_algorithm_t algorithm);
+
+/** Append data to the computation of a context
+ *
+ * The hash module is loaded with the context state, fed with the complete
+ * blocks and its state is saved back to the context. This is done in
+ * critical sections of up to MBED_CONF_TARGET_HASH_SECTION_BLOCKS blocks, so
+ * contexts can be used from different threads and interrupts.
+ *
+ * \param ctx  The context
+ * \param data Input data, may be NULL if size is 0
+ * \param size Size of the data in bytes
+ */
+void hal_hash_ctx_update(hal_hash_ctx_t *ctx, const uint8_t *data, size_t size);
+
+/** Append data to the computation of a context without blocking
+ *
+ * The complete blocks are fed with hal_hash_compute_partial_async(), the
+ * handler is called from interrupt context once done. The data buffer and
+ * the context must stay valid until then.
+ *
+ * \param ctx     The context
+ * \param data    Input data, may be NULL if size is 0
+ * \param size    Size of the data in bytes
+ * \param handler The completion handler
+ * \param id      The id passed to the handler
+ * \return 0 if the update was started, -1 if the hash module is busy with
+ *         another asynchronous update, the handler is not called then
+ */
+int hal_hash_ctx_update_async(hal_hash_ctx_t *ctx, const uint8_t *data, size_t size,
+                              hal_hash_async_handler handler, uint32_t id);
+
+/** Get the digest of a context
+ *
+ * The padding is appended to a copy of the context state. The context is not
+ * modified, so more data can still be appended.
+ *
+ * \param ctx    The context
+ * \param digest The digest, hal_hash_digest_size() bytes
+ */
+void hal_hash_ctx_get_digest(const hal_hash_ctx_t *ctx, uint8_t *digest);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_HASH
+#endif // MBED_HASH_API_H
+
+/**@}*/
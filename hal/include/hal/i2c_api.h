@@ -37,15 +37,43 @@
 #define I2C_EVENT_TRANSFER_EARLY_NACK (1 << 4)
 #define I2C_EVENT_ALL                 (I2C_EVENT_ERROR |  I2C_EVENT_TRANSFER_COMPLETE | I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)
 
+#define I2C_EVENT_SLAVE_READ_REQUEST  (1 << 5) // The master addressed the slave to read from it
+#define I2C_EVENT_SLAVE_WRITE_REQUEST (1 << 6) // The master addressed the slave to write to it
+#define I2C_EVENT_SLAVE_ALL           (I2C_EVENT_ERROR | I2C_EVENT_TRANSFER_COMPLETE | I2C_EVENT_SLAVE_READ_REQUEST | I2C_EVENT_SLAVE_WRITE_REQUEST)
+
 /**@}*/
 
+/** Descriptor of one transfer of an I2C transfer list
+ *
+ * A register read is described by the register address in `tx` and the
+ * buffer for the data in `rx`. A register write is described by the register
+ * address followed by the data in `tx`, with `rx_length` zero.
+ */
+typedef struct {
+    uint32_t    address;   /**< 8-bit slave address, as for ::i2c_write */
+    const void *tx;        /**< The transmit buffer */
+    size_t      tx_length; /**< The number of bytes to transmit */
+    void       *rx;        /**< The receive buffer */
+    size_t      rx_length; /**< The number of bytes to receive */
+} i2c_transfer_t;
+
 #if DEVICE_I2C_ASYNCH
+/** State of an asynchronous I2C transfer list
+ */
+typedef struct {
+    const i2c_transfer_t *next; /**< The transfer in progress */
+    size_t count;               /**< Number of transfers left, including the one in progress */
+    uint32_t handler;           /**< The I2C IRQ handler */
+    uint32_t event;             /**< Event mask for the transfers */
+} i2c_transfer_list_state_t;
+
 /** Asynch I2C HAL structure
  */
 typedef struct {
     struct i2c_s    i2c;     /**< Target specific I2C structure */
     struct buffer_s tx_buff; /**< Tx buffer */
     struct buffer_s rx_buff; /**< Rx buffer */
+    i2c_transfer_list_state_t list; /**< Transfer list state */
 } i2c_t;
 
 #else
@@ -68,6 +96,47 @@ typedef struct {
     int scl_function;
 } i2c_pinmap_t;
 
+#ifndef MBED_CONF_TARGET_I2C_TIMEOUT_US
+/** Default timeout of the blocking I2C functions, in microseconds */
+#define MBED_CONF_TARGET_I2C_TIMEOUT_US 10000
+#endif
+
+#if DEVICE_USTICKER
+/** Deadline of a blocking I2C operation, see ::i2c_deadline_start
+ */
+typedef struct {
+    uint64_t end_us; /**< Microsecond ticker time at which the operation times out */
+} i2c_deadline_t;
+#endif
+
+/** I2C speed modes, as bits of `speed_modes` in ::i2c_capabilities_t
+ */
+#define I2C_SPEED_STANDARD   (1 << 0) // Standard-mode, up to 100 kHz
+#define I2C_SPEED_FAST       (1 << 1) // Fast-mode, up to 400 kHz
+#define I2C_SPEED_FAST_PLUS  (1 << 2) // Fast-mode Plus, up to 1 MHz
+#define I2C_SPEED_HIGH_SPEED (1 << 3) // High-speed mode, up to 3.4 MHz
+
+/**
+ * Describes the capabilities of an I2C peripheral
+ */
+typedef struct {
+    uint32_t minimum_frequency; /**< Lowest frequency accepted by ::i2c_frequency, in Hz */
+    uint32_t maximum_frequency; /**< Highest frequency accepted by ::i2c_frequency, in Hz */
+    uint8_t  speed_modes;       /**< The I2C_SPEED_XXX modes supported by the peripheral and its pins */
+} i2c_capabilities_t;
+
+#ifndef I2C_TIMING_REGS
+/** Number of register values a target caches in ::i2c_timing_t */
+#define I2C_TIMING_REGS 2
+#endif
+
+/** Precomputed bus timing, see ::i2c_timing_prepare
+ */
+typedef struct {
+    int      hz;                    /**< Bus frequency */
+    uint32_t regs[I2C_TIMING_REGS]; /**< Target specific register values */
+} i2c_timing_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -80,6 +149,11 @@ extern "C" {
  * * ::i2c_init configures the pins used by I2C
  * * ::i2c_free returns the pins owned by the I2C object to their reset state
  * * ::i2c_frequency configure the I2C frequency
+ * * ::i2c_get_capabilities fills the given `i2c_capabilities_t` instance - TBD (basic test)
+ * * ::i2c_frequency supports the frequencies of the speed modes reported by ::i2c_get_capabilities, up to `maximum_frequency` - Verified by ::fpga_i2c_test_timing
+ * * ::i2c_frequency above 1 MHz selects the High-speed mode, in which the master code is sent at the start of every transfer - TBD (basic test)
+ * * ::i2c_timing_prepare returns -1 for a frequency outside the range reported by ::i2c_get_capabilities, 0 otherwise - TBD (basic test)
+ * * ::i2c_timing_apply sets the bus timing as ::i2c_frequency does with the frequency given to ::i2c_timing_prepare - TBD (basic test)
  * * ::i2c_start sends START command
  * * ::i2c_read reads `length` bytes from the I2C slave specified by `address` to the `data` buffer
  * * ::i2c_read reads generates a stop condition on the bus at the end of the transfer if `stop` parameter is non-zero
@@ -88,6 +162,10 @@ extern "C" {
  * * ::i2c_write generates a stop condition on the bus at the end of the transfer if `stop` parameter is non-zero
  * * ::i2c_write returns zero on success, error code otherwise
  * * ::i2c_reset resets the I2C peripheral
+ * * The blocking functions return I2C_ERROR_BUS_BUSY, or 2 for ::i2c_byte_write, once the timeout set by ::i2c_timeout elapses, MBED_CONF_TARGET_I2C_TIMEOUT_US by default - TBD (basic test)
+ * * ::i2c_timeout returns 0 if the timeout is set, -1 if the target only supports the default timeout - TBD (basic test)
+ * * ::i2c_bus_recover clocks SCL until the slave holding SDA low releases it, up to 9 times, then generates a stop condition - TBD (basic test)
+ * * ::i2c_bus_recover returns 0 if SDA and SCL are both high at the end, I2C_ERROR_BUS_BUSY otherwise - TBD (basic test)
  * * ::i2c_byte_read reads and return one byte from the specfied I2C slave
  * * ::i2c_byte_read uses `last` parameter to inform the slave that all bytes have been read
  * * ::i2c_byte_write writes one byte to the specified I2C slave
@@ -99,6 +177,9 @@ extern "C" {
  * * ::i2c_slave_write writes `length` bytes to the I2C master from the `data` buffer
  * * ::i2c_slave_write returns non-zero if a value is available, 0 otherwise
  * * ::i2c_slave_address configures I2C slave address
+ * * ::i2c_mem_read writes `mem_address_size` bytes of `mem_address`, most significant byte first, then reads `length` bytes after a repeated start - TBD (basic test)
+ * * ::i2c_mem_write writes `mem_address_size` bytes of `mem_address`, most significant byte first, followed by `length` bytes of `data` in one transfer - TBD (basic test)
+ * * ::i2c_mem_read and ::i2c_mem_write return zero on success, I2C_ERROR_XXX status otherwise - TBD (basic test)
  * * ::i2c_transfer_asynch starts I2C asynchronous transfer
  * * ::i2c_transfer_asynch writes `tx_length` bytes to the I2C slave specified by `address` from the `tx` buffer
  * * ::i2c_transfer_asynch reads `rx_length` bytes from the I2C slave specified by `address` to the `rx` buffer
@@ -108,6 +189,9 @@ extern "C" {
  * * ::i2c_irq_handler_asynch returns event flags if a transfer termination condition was met, otherwise returns 0.
  * * ::i2c_active returns non-zero if the I2C module is active or 0 if it is not
  * * ::i2c_abort_asynch aborts an on-going async transfer
+ * * ::i2c_transfer_list_asynch runs the transfers of the list one after another, each ending with a stop condition - TBD (basic test)
+ * * ::i2c_transfer_list_asynch stops at the first transfer which ends with an error event - TBD (basic test)
+ * * ::i2c_irq_handler_asynch_list returns the event flags of the whole list, or 0 while transfers are left - TBD (basic test)
  *
  * # Undefined behavior
  * * Calling ::i2c_init multiple times on the same `i2c_t`
@@ -124,6 +208,8 @@ extern "C" {
  * * Setting the length of the transfer or receive buffers to larger than the buffers are
  * * Passing an invalid pointer as `handler`
  * * Calling ::i2c_abort_async when no transfer is currently in progress
+ * * Passing an empty list to ::i2c_transfer_list_asynch
+ * * Calling ::i2c_bus_recover with pins used by an initialized I2C object
  *
  *
  * @{
@@ -160,6 +246,44 @@ void i2c_free(i2c_t *obj);
  */
 void i2c_frequency(i2c_t *obj, int hz);
 
+/** Get the capabilities of the I2C peripheral
+ *
+ *  The speed modes depend on the pins the peripheral was initialized with,
+ *  as Fast-mode Plus and High-speed need pads of higher drive strength.
+ *
+ *  The default implementation reports Standard-mode and Fast-mode.
+ *
+ *  @param obj The initialized I2C object
+ *  @param cap The capabilities to fill
+ */
+void i2c_get_capabilities(i2c_t *obj, i2c_capabilities_t *cap);
+
+/** Compute the bus timing of a frequency
+ *
+ *  The timing registers are computed once, so that switching the bus speed at
+ *  runtime with ::i2c_timing_apply does not compute them again. The timing
+ *  must be prepared again after a change of the clock of the peripheral.
+ *
+ *  The default implementation checks and records the frequency. Targets
+ *  override this function along with ::i2c_timing_apply, and may define
+ *  I2C_TIMING_REGS in their objects.h for the values they cache.
+ *
+ *  @param obj    The I2C object the timing is applied to
+ *  @param timing The timing to compute
+ *  @param hz     Frequency in Hz
+ *  @return 0 on success, -1 if the frequency is not supported
+ */
+int i2c_timing_prepare(i2c_t *obj, i2c_timing_t *timing, int hz);
+
+/** Apply a timing computed by ::i2c_timing_prepare
+ *
+ *  The default implementation calls ::i2c_frequency.
+ *
+ *  @param obj    The I2C object
+ *  @param timing The timing to apply
+ */
+void i2c_timing_apply(i2c_t *obj, const i2c_timing_t *timing);
+
 /** Send START command
  *
  *  @param obj The I2C object
@@ -202,6 +326,57 @@ int i2c_write(i2c_t *obj, int address, const char *data, int length, int stop);
  */
 void i2c_reset(i2c_t *obj);
 
+/** Set the timeout of the blocking functions
+ *
+ *  The bus is given up after the timeout, measured with the microsecond
+ *  ticker, so that a slave stretching the clock or holding the bus stalls
+ *  the caller for a bounded time. The timeout covers a whole ::i2c_read or
+ *  ::i2c_write transfer, and a single byte for the byte functions.
+ *
+ *  The default implementation returns -1.
+ *
+ *  @param obj        The I2C object
+ *  @param timeout_us The timeout in microseconds
+ *  @return 0 on success, -1 if the target only supports MBED_CONF_TARGET_I2C_TIMEOUT_US
+ */
+int i2c_timeout(i2c_t *obj, uint32_t timeout_us);
+
+/** Free a bus held by a slave
+ *
+ *  A slave reset in the middle of a read may hold SDA low, waiting for the
+ *  clock pulses of the byte it was sending. SCL is clocked at about 100 kHz
+ *  with the pins as GPIOs until SDA is released, and a stop condition is
+ *  generated. Call it before ::i2c_init, or after ::i2c_free, then
+ *  initialize the peripheral again.
+ *
+ *  The default implementation drives the pins through the GPIO API,
+ *  relying on the external pull-ups of the bus.
+ *
+ *  @param sda The sda pin
+ *  @param scl The scl pin
+ *  @return 0 if the bus is free, I2C_ERROR_BUS_BUSY otherwise
+ */
+int i2c_bus_recover(PinName sda, PinName scl);
+
+#if DEVICE_USTICKER
+/** Start the deadline of a blocking operation
+ *
+ *  For target implementations of the blocking functions, which check
+ *  ::i2c_deadline_expired in their wait loops instead of counting loops.
+ *
+ *  @param deadline   The deadline to start
+ *  @param timeout_us The timeout in microseconds
+ */
+void i2c_deadline_start(i2c_deadline_t *deadline, uint32_t timeout_us);
+
+/** Check a deadline started by ::i2c_deadline_start
+ *
+ *  @param deadline The deadline
+ *  @return true if the timeout elapsed
+ */
+bool i2c_deadline_expired(const i2c_deadline_t *deadline);
+#endif
+
 /** Read one byte
  *
  *  @param obj The I2C object
@@ -254,6 +429,39 @@ const PinMap *i2c_slave_sda_pinmap(void);
  */
 const PinMap *i2c_slave_scl_pinmap(void);
 
+/** Blocking read of slave registers
+ *
+ *  Writes the register address and reads the registers after a repeated
+ *  start, without releasing the bus in between.
+ *
+ *  @param obj              The I2C object
+ *  @param address          8-bit address, as for ::i2c_write
+ *  @param mem_address      The address of the first register
+ *  @param mem_address_size The size of the register address in bytes, 1 to 4
+ *  @param data             The buffer for receiving
+ *  @param length           Number of bytes to read
+ *  @return
+ *      zero - the registers were read
+ *      negative - I2C_ERROR_XXX status
+ */
+int i2c_mem_read(i2c_t *obj, int address, uint32_t mem_address, size_t mem_address_size, void *data, size_t length);
+
+/** Blocking write of slave registers
+ *
+ *  Writes the register address followed by the data in one transfer.
+ *
+ *  @param obj              The I2C object
+ *  @param address          8-bit address, as for ::i2c_write
+ *  @param mem_address      The address of the first register
+ *  @param mem_address_size The size of the register address in bytes, 1 to 4
+ *  @param data             The buffer for sending
+ *  @param length           Number of bytes to write
+ *  @return
+ *      zero - the registers were written
+ *      negative - I2C_ERROR_XXX status
+ */
+int i2c_mem_write(i2c_t *obj, int address, uint32_t mem_address, size_t mem_address_size, const void *data, size_t length);
+
 /**@}*/
 
 #if DEVICE_I2CSLAVE
@@ -313,6 +521,11 @@ void i2c_slave_address(i2c_t *obj, int idx, uint32_t address, uint32_t mask);
  */
 
 /** Start I2C asynchronous transfer
+ *
+ *  @note An implementation using DMA keeps the buffers coherent with the data
+ *  cache: hal_dma_tx_prepare() on tx and hal_dma_rx_prepare() on rx before
+ *  starting, then hal_dma_rx_complete() on rx before reporting
+ *  I2C_EVENT_TRANSFER_COMPLETE. See hal/cache_api.h.
  *
  *  @param obj       The I2C object
  *  @param tx        The transmit buffer
@@ -347,8 +560,102 @@ uint8_t i2c_active(i2c_t *obj);
  */
 void i2c_abort_asynch(i2c_t *obj);
 
+/** Start an asynchronous list of I2C transfers
+ *
+ *  Runs the transfers one after another like ::i2c_transfer_asynch with a
+ *  stop condition at the end of each, so register accesses of several slaves
+ *  complete as one job. The list and the buffers must stay valid until the
+ *  job completes. The handler must call ::i2c_irq_handler_asynch_list
+ *  instead of ::i2c_irq_handler_asynch.
+ *
+ *  The default implementation starts ::i2c_transfer_asynch for each transfer
+ *  from the IRQ handler of the previous one. Targets which can chain DMA
+ *  descriptors should override it.
+ *
+ *  @param obj     The I2C object
+ *  @param list    The transfers
+ *  @param count   The number of transfers
+ *  @param handler The I2C IRQ handler to be set
+ *  @param event   Event mask for the transfers. See \ref hal_I2CEvents
+ */
+void i2c_transfer_list_asynch(i2c_t *obj, const i2c_transfer_t *list, size_t count, uint32_t handler, uint32_t event);
+
+/** The asynchronous IRQ handler of a transfer list
+ *
+ *  @param obj The I2C object which holds the transfer information
+ *  @return Event flags if the list completed or a transfer ended with an error, otherwise return 0.
+ */
+uint32_t i2c_irq_handler_asynch_list(i2c_t *obj);
+
 #endif
 
+#if DEVICE_I2CSLAVE_ASYNCH
+
+/**
+ * \defgroup hal_AsynchI2CSlave Asynchronous I2C Hardware Abstraction Layer for slave
+ * Interrupt driven slave transfers, without polling ::i2c_slave_receive
+ *
+ * # Defined behavior
+ * * ::i2c_slave_transfer_asynch returns immediately, a transfer starts when the master addresses the slave - TBD (I2C slave test)
+ * * The handler is invoked with I2C_EVENT_SLAVE_READ_REQUEST or I2C_EVENT_SLAVE_WRITE_REQUEST on an address match, if requested - TBD (I2C slave test)
+ * * The handler is invoked with I2C_EVENT_TRANSFER_COMPLETE on the stop or repeated start condition ending the transfer - TBD (I2C slave test)
+ * * ::i2c_slave_transfer_length returns the number of bytes transferred by the last transfer - TBD (I2C slave test)
+ * * The slave sends 0xFF once the tx buffer is exhausted, and NACKs the bytes written beyond the rx buffer - TBD (I2C slave test)
+ *
+ * # Undefined behavior
+ * * Calling ::i2c_slave_transfer_asynch before ::i2c_slave_mode and ::i2c_slave_address
+ * * Calling the blocking slave functions while an asynchronous slave transfer is armed
+ *
+ * @{
+ */
+
+/** Arm the I2C slave for one asynchronous transfer
+ *
+ *  The slave answers the next time the master addresses it: the bytes the
+ *  master writes are stored to rx, and the bytes the master reads are taken
+ *  from tx, through DMA where the target supports it. The clock is stretched
+ *  while the handler processes an address match event, so the handler may
+ *  call this function again to choose the buffers for the request. Calling it
+ *  from the handler on I2C_EVENT_TRANSFER_COMPLETE arms the next transfer.
+ *
+ *  @note An implementation using DMA keeps the buffers coherent with the data
+ *  cache as ::i2c_transfer_asynch does. See hal/cache_api.h.
+ *
+ *  @param obj       The I2C object, in slave mode
+ *  @param tx        The buffer sent when the master reads, may be NULL if tx_length is zero
+ *  @param tx_length The number of bytes available to send
+ *  @param rx        The buffer filled when the master writes, may be NULL if rx_length is zero
+ *  @param rx_length The number of bytes available to receive
+ *  @param handler   The I2C IRQ handler to be set
+ *  @param event     Event mask for the transfer, from I2C_EVENT_SLAVE_ALL
+ */
+void i2c_slave_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint32_t handler, uint32_t event);
+
+/** The asynchronous IRQ handler of the slave
+ *
+ *  @param obj The I2C object which holds the transfer information
+ *  @return Event flags if an address match or the end of the transfer occurred, otherwise return 0.
+ */
+uint32_t i2c_slave_irq_handler_asynch(i2c_t *obj);
+
+/** Number of bytes transferred by the last slave transfer
+ *
+ *  @param obj The I2C object
+ *  @return The bytes received or sent before I2C_EVENT_TRANSFER_COMPLETE
+ */
+size_t i2c_slave_transfer_length(i2c_t *obj);
+
+/** Disarm the asynchronous slave
+ *
+ *  The slave no longer acknowledges its address until it is armed again.
+ *  @param obj The I2C object
+ */
+void i2c_slave_abort_asynch(i2c_t *obj);
+
+/**@}*/
+
+#endif // DEVICE_I2CSLAVE_ASYNCH
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,214 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_IDLE_API_H
+#define MBED_IDLE_API_H
+
+#include "device.h"
+
+#if DEVICE_SLEEP
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Initial estimate of the time to wake up from deep sleep, in microseconds */
+#ifndef MBED_CONF_TARGET_DEEP_SLEEP_LATENCY
+#define MBED_CONF_TARGET_DEEP_SLEEP_LATENCY 1000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_idle Tickless idle
+ * Sleep until the next ticker event, for bare-metal main loops
+ *
+ * @code
+ * while (true) {
+ *     process_pending_work();
+ *     hal_idle();
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::hal_idle returns after an interrupt, and no later than the next us
+ *   ticker or lp ticker event
+ * * ::hal_idle uses deep sleep when it is not locked and the next event is
+ *   at least twice the deep sleep wake-up latency away
+ * * The us ticker is suspended during deep sleep, unless it runs in deep
+ *   sleep, and resumed with the time spent asleep measured by the lp ticker
+ * * The wake-up latency starts at MBED_CONF_TARGET_DEEP_SLEEP_LATENCY and is
+ *   raised to the largest latency measured plus one lp ticker period, and
+ *   the lp ticker wake-up is scheduled that much before the next event
+ * * The latency of each deep sleep ended by the lp ticker wake-up is recorded
+ *   in the statistics returned by ::hal_idle_deep_sleep_stats_get
+ * * ::hal_idle_deep_sleep_stats_reset restarts the calibration from
+ *   MBED_CONF_TARGET_DEEP_SLEEP_LATENCY
+ * * ::hal_idle calls ::hal_watchdog_supervisor_service before sleeping, on
+ *   targets with a watchdog
+ * * The save handlers of the retention entries registered are called before
+ *   deep sleep, in the order of registration, and the restore handlers after
+ *   it, in the reverse order, with interrupts disabled
+ * * Deep sleep locks taken with ::hal_idle_deep_sleep_lock_owner are counted
+ *   for their owner, along with the time they are held, measured with the lp
+ *   ticker on targets which have one
+ *
+ * # Undefined behavior
+ * * Calling ::hal_idle from an interrupt handler
+ *
+ * @{
+ */
+
+/** Deep sleep wake-up statistics
+ *
+ * The latency is the time from the lp ticker wake-up to the return of
+ * hal_deepsleep(), measured with the lp ticker.
+ */
+typedef struct {
+    uint32_t count;         /**< Number of latencies measured */
+    uint32_t min_us;        /**< Shortest latency, in microseconds */
+    uint32_t max_us;        /**< Longest latency, in microseconds */
+    uint32_t average_us;    /**< Average latency, in microseconds, weighting recent ones more */
+    uint32_t late;          /**< Number of deep sleeps which returned after the next event */
+} hal_idle_deep_sleep_stats_t;
+
+/** Owner of deep sleep locks, with the statistics of its locks
+ *
+ * Owners are statically allocated with HAL_IDLE_DEEP_SLEEP_OWNER_INIT and are
+ * listed from their first lock on.
+ */
+typedef struct hal_idle_deep_sleep_owner_s {
+    const char *name;           /**< Name reported */
+    uint32_t lock_count;        /**< Number of locks taken, nested ones included */
+    uint64_t held_us;           /**< Time the lock was held, in microseconds, up to the last release */
+    uint64_t locked_at;         /**< lp ticker time of the first of the locks held */
+    uint16_t locks;             /**< Number of locks held */
+    bool listed;                /**< The owner is in the list of owners */
+    struct hal_idle_deep_sleep_owner_s *next;
+} hal_idle_deep_sleep_owner_t;
+
+/** Initializer of a ::hal_idle_deep_sleep_owner_t */
+#define HAL_IDLE_DEEP_SLEEP_OWNER_INIT(name) { (name), 0, 0, 0, 0, false, NULL }
+
+/** Peripheral state saved across deep sleep
+ *
+ * Drivers of targets whose peripherals lose their configuration in deep
+ * sleep register an entry from their init function. The save handler
+ * snapshots the registers to the context, and the restore handler writes
+ * them back, without the pin map lookups and clock setup of a full init.
+ */
+typedef struct hal_idle_retention_s {
+    void (*save)(void *context);        /**< Called before deep sleep */
+    void (*restore)(void *context);     /**< Called after deep sleep */
+    void *context;                      /**< Storage of the snapshot, owned by the driver */
+    struct hal_idle_retention_s *next;
+    struct hal_idle_retention_s *prev;
+} hal_idle_retention_t;
+
+/** Sleep until the next interrupt or ticker event */
+void hal_idle(void);
+
+/** Prevent ::hal_idle from using deep sleep
+ *
+ * Drivers which need the high-speed clocks, for instance while a transfer is
+ * ongoing, lock deep sleep. Locks are counted.
+ */
+void hal_idle_deep_sleep_lock(void);
+
+/** Allow ::hal_idle to use deep sleep once every lock is released */
+void hal_idle_deep_sleep_unlock(void);
+
+/** Prevent ::hal_idle from using deep sleep, counting the lock for its owner
+ *
+ * @param owner The owner of the lock
+ */
+void hal_idle_deep_sleep_lock_owner(hal_idle_deep_sleep_owner_t *owner);
+
+/** Release a lock taken with ::hal_idle_deep_sleep_lock_owner
+ *
+ * @param owner The owner of the lock
+ */
+void hal_idle_deep_sleep_unlock_owner(hal_idle_deep_sleep_owner_t *owner);
+
+/** Get the time an owner held deep sleep locked
+ *
+ * @param owner The owner
+ * @return The time in microseconds since boot or the last reset, the ongoing lock included
+ */
+uint64_t hal_idle_deep_sleep_owner_held_us(const hal_idle_deep_sleep_owner_t *owner);
+
+/** Iterate over the owners which took a lock
+ *
+ * @param owner NULL for the first owner, or the previous one
+ * @return The next owner, or NULL after the last one
+ */
+const hal_idle_deep_sleep_owner_t *hal_idle_deep_sleep_owner_next(const hal_idle_deep_sleep_owner_t *owner);
+
+/** Reset the lock counts and held times of every owner, keeping the locks held */
+void hal_idle_deep_sleep_owners_reset(void);
+
+/** Print the statistics of every owner with the trace library
+ *
+ * The locks taken with ::hal_idle_deep_sleep_lock have no owner and are
+ * reported as anonymous.
+ */
+void hal_idle_deep_sleep_owners_trace(void);
+
+/** Register a peripheral to save and restore around deep sleep
+ *
+ * @param entry   The entry, statically allocated or kept until unregistered
+ * @param save    The handler saving the state to the context
+ * @param restore The handler restoring the state from the context
+ * @param context The context passed to the handlers
+ */
+void hal_idle_retention_register(hal_idle_retention_t *entry, void (*save)(void *context), void (*restore)(void *context), void *context);
+
+/** Unregister a peripheral, from its free function
+ *
+ * @param entry The entry given to ::hal_idle_retention_register
+ */
+void hal_idle_retention_unregister(hal_idle_retention_t *entry);
+
+/** Get the deep sleep wake-up latency used by ::hal_idle
+ *
+ * @return The latency, in microseconds
+ */
+uint32_t hal_idle_deep_sleep_latency_us(void);
+
+/** Get the deep sleep wake-up statistics
+ *
+ * @param stats Set to the statistics since boot or the last reset
+ */
+void hal_idle_deep_sleep_stats_get(hal_idle_deep_sleep_stats_t *stats);
+
+/** Reset the deep sleep wake-up statistics and latency */
+void hal_idle_deep_sleep_stats_reset(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_SLEEP
+
+#endif // MBED_IDLE_API_H
+
+/** @}*/
@@ -0,0 +1,156 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_IMAGE_VERIFY_API_H
+#define MBED_IMAGE_VERIFY_API_H
+
+#include "device.h"
+#include "hal/hash_api.h"
+#include <stdint.h>
+
+#if DEVICE_QSPI
+#include "hal/qspi_api.h"
+#endif
+
+#if DEVICE_HASH
+
+/* Size of the chunks an image which is not memory-mapped is read in, a
+ * multiple of HAL_HASH_BLOCK_SIZE. Two chunk buffers are allocated.
+ */
+#ifndef MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE
+#define MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE 1024
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_image_verify Image verification
+ * Digest of a firmware image, streamed from where it is stored
+ *
+ * Memory-mapped images, in the internal flash or in a QSPI memory mapped for
+ * XIP, are given to the hash module as they are, which reads them by DMA on
+ * targets implementing hal_hash_compute_partial_async(). Other images are
+ * read in chunks into two buffers: a chunk is read while the one before is
+ * being hashed, so the read and the hash times overlap.
+ *
+ * @code
+ * const image_verify_source_t source = { image_verify_flash_read, &flash };
+ *
+ * if (image_verify(&source, slot_address, image_size, HAL_HASH_SHA256, manifest.digest) != 0) {
+ *     // Keep the current image
+ * }
+ * @endcode
+ *
+ * # Defined behaviour
+ * * Function image_verify_digest() returns the digest of the image, for any
+ *   size and source - verified by test ::image_verify_digest_test.
+ * * Function image_verify() returns 0 if the image matches the digest, -1 if
+ *   any byte differs - verified by test ::image_verify_test.
+ * * Functions image_verify_digest() and image_verify() return -1 if a read
+ *   fails - verified by test ::image_verify_read_error_test.
+ *
+ * # Undefined behaviour
+ * * Verifying images from several threads at once.
+ *
+ * @{
+ */
+
+/** Read function of an image which is not memory-mapped
+ *
+ * \param obj     Object of the source
+ * \param address Address of the data in the image storage
+ * \param data    Buffer to read the data into
+ * \param size    Number of bytes to read
+ * \return 0 for success, -1 for error
+ */
+typedef int32_t (*image_verify_read_t)(void *obj, uint32_t address, uint8_t *data, uint32_t size);
+
+/** Storage an image is read from
+ */
+typedef struct image_verify_source {
+    /** Read function, NULL if the image is memory-mapped at its address */
+    image_verify_read_t read;
+    /** Object given to the read function */
+    void *obj;
+} image_verify_source_t;
+
+#if DEVICE_QSPI
+/** Object of ::image_verify_qspi_read
+ */
+typedef struct image_verify_qspi {
+    qspi_t *qspi; /**< QSPI object the image is read with >*/
+    qspi_command_t read_cmd; /**< Command reading the image, its address is set for each chunk >*/
+} image_verify_qspi_t;
+#endif
+
+/** Compute the digest of an image
+ *
+ * \param source    Storage of the image
+ * \param address   Address of the image
+ * \param size      Size of the image in bytes
+ * \param algorithm Algorithm, checked for support with HAL_HASH_IS_SUPPORTED()
+ * \param digest    Digest, hal_hash_digest_size() bytes
+ * \return 0 for success, -1 if a read failed or the hash module is busy
+ *         with another asynchronous update
+ */
+int image_verify_digest(const image_verify_source_t *source, uint32_t address, uint32_t size,
+                        hal_hash_algorithm_t algorithm, uint8_t *digest);
+
+/** Check an image against its expected digest
+ *
+ * The digests are compared in constant time.
+ *
+ * \param source    Storage of the image
+ * \param address   Address of the image
+ * \param size      Size of the image in bytes
+ * \param algorithm Algorithm, checked for support with HAL_HASH_IS_SUPPORTED()
+ * \param expected  Expected digest, hal_hash_digest_size() bytes
+ * \return 0 if the image matches, -1 otherwise
+ */
+int image_verify(const image_verify_source_t *source, uint32_t address, uint32_t size,
+                 hal_hash_algorithm_t algorithm, const uint8_t *expected);
+
+#if DEVICE_FLASH
+/** Read function of an image in the internal flash, with flash_read()
+ *
+ * \param obj The flash_t object
+ */
+int32_t image_verify_flash_read(void *obj, uint32_t address, uint8_t *data, uint32_t size);
+#endif
+
+#if DEVICE_QSPI
+/** Read function of an image in a QSPI memory, with qspi_read()
+ *
+ * \param obj The image_verify_qspi_t object
+ */
+int32_t image_verify_qspi_read(void *obj, uint32_t address, uint8_t *data, uint32_t size);
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_HASH
+#endif // MBED_IMAGE_VERIFY_API_H
+
+/**@}*/
@@ -0,0 +1,195 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_IPC_API_H
+#define MBED_IPC_API_H
+
+#include "device.h"
+
+#if DEVICE_IPC
+
+#include "hal/cache_api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_ipc Inter-processor communication
+ * Primitives shared by the cores of multi-core targets
+ *
+ * Each core runs its own image, with its own HAL, and the two communicate
+ * through memory shared by the cores:
+ * * Hardware semaphores, taken with ::hal_ipc_hsem_try_lock, protect shared
+ *   data on targets whose shared memory has no global exclusive monitor
+ * * Notifications, sent with ::hal_ipc_notify, raise an interrupt on the
+ *   other core, through the mailbox of the target
+ * * Queues, ::hal_ipc_queue_t, pass items from one core to the other without
+ *   locking, with the cache maintenance needed when the cores have caches
+ *
+ * @code
+ * // In the memory shared by the cores, at the same address in both images
+ * HAL_IPC_QUEUE_DEFINE(MBED_SECTION(".shared"), samples, sizeof(sample_t), 16);
+ *
+ * // Core 1, producing
+ * if (hal_ipc_queue_push(&samples, &sample)) {
+ *     hal_ipc_notify(SAMPLES_CHANNEL);
+ * }
+ *
+ * // Core 0, in the handler given to hal_ipc_init
+ * static void ipc_handler(uint32_t channel)
+ * {
+ *     while (hal_ipc_queue_pop(&samples, &sample)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::hal_ipc_core_id returns 0 on the core which starts first
+ * * ::hal_ipc_hsem_try_lock fails while the other core holds the semaphore
+ * * ::hal_ipc_notify calls the handler of the other core with the channel,
+ *   notifications of a channel sent before the handler runs may be merged
+ * * Items are popped from a queue in the order they were pushed, a push to
+ *   a full queue fails
+ *
+ * # Undefined behavior
+ * * Pushing to a queue from both cores, or popping from both cores
+ * * Using a queue before one of the cores has called ::hal_ipc_queue_reset,
+ *   unless the shared memory is zeroed before both cores start
+ * * Unlocking a semaphore held by the other core
+ *
+ * # Requirements for targets
+ * * ::hal_ipc_core_id, ::hal_ipc_hsem_try_lock, ::hal_ipc_hsem_unlock,
+ *   ::hal_ipc_init and ::hal_ipc_notify are implemented by the target
+ *
+ * @{
+ */
+
+/** Handler of the notifications of the other core, called from interrupt context
+ *
+ * @param channel The channel given to ::hal_ipc_notify
+ */
+typedef void (*hal_ipc_handler_t)(uint32_t channel);
+
+/** Queue from one core to the other
+ *
+ * The producer and the consumer write separate cache lines, so the cache
+ * maintenance of one never discards the writes of the other. Each item has
+ * its own cache lines too.
+ */
+typedef struct {
+    MBED_ALIGN(HAL_DCACHE_LINE_SIZE) volatile uint32_t head;    /**< Count of items pushed, written by the producer */
+    MBED_ALIGN(HAL_DCACHE_LINE_SIZE) volatile uint32_t tail;    /**< Count of items popped, written by the consumer */
+    MBED_ALIGN(HAL_DCACHE_LINE_SIZE) uint8_t *storage;          /**< Storage of the items */
+    size_t slot_size;   /**< Size of the storage of an item, whole cache lines */
+    size_t item_size;   /**< Size of an item */
+    uint32_t count;     /**< Capacity of the queue, a power of two */
+} hal_ipc_queue_t;
+
+/** Define a queue and its storage
+ *
+ * @param placement Section attribute of the memory shared by the cores
+ * @param name      Name of the hal_ipc_queue_t
+ * @param item_size Size of an item in bytes
+ * @param count     Capacity of the queue, a power of two
+ */
+#define HAL_IPC_QUEUE_DEFINE(placement, name, item_size, count) \
+    placement MBED_ALIGN(HAL_DCACHE_LINE_SIZE) static uint8_t name##_storage[HAL_DMA_BUFFER_SIZE(item_size) * (count)]; \
+    placement static hal_ipc_queue_t name = { \
+        0, 0, name##_storage, HAL_DMA_BUFFER_SIZE(item_size), (item_size), (count) \
+    }
+
+/** Get the core running the caller
+ *
+ * @return 0 for the core which starts first, 1 for the other core
+ */
+uint32_t hal_ipc_core_id(void);
+
+/** Take a hardware semaphore if it is free
+ *
+ * @param sem The semaphore, from 0 to the number of semaphores of the target
+ * @return true if the semaphore was taken
+ */
+bool hal_ipc_hsem_try_lock(uint32_t sem);
+
+/** Take a hardware semaphore, waiting for the other core to release it
+ *
+ * @param sem The semaphore
+ */
+void hal_ipc_hsem_lock(uint32_t sem);
+
+/** Release a hardware semaphore
+ *
+ * The writes made while holding the semaphore are visible to the other core
+ * once it takes it.
+ *
+ * @param sem The semaphore taken by the calling core
+ */
+void hal_ipc_hsem_unlock(uint32_t sem);
+
+/** Enable the notifications from the other core
+ *
+ * @param handler The handler of the notifications
+ */
+void hal_ipc_init(hal_ipc_handler_t handler);
+
+/** Notify the other core
+ *
+ * @param channel The channel, from 0 to the number of channels of the target
+ */
+void hal_ipc_notify(uint32_t channel);
+
+/** Empty a queue, before the other core uses it
+ *
+ * @param queue The queue
+ */
+void hal_ipc_queue_reset(hal_ipc_queue_t *queue);
+
+/** Copy an item to a queue, from the producer core
+ *
+ * @param queue The queue
+ * @param item  The item, of queue->item_size bytes
+ * @return true if the item was pushed, false if the queue is full
+ */
+bool hal_ipc_queue_push(hal_ipc_queue_t *queue, const void *item);
+
+/** Copy the oldest item out of a queue, from the consumer core
+ *
+ * @param queue The queue
+ * @param item  Set to the item, of queue->item_size bytes
+ * @return true if an item was popped, false if the queue is empty
+ */
+bool hal_ipc_queue_pop(hal_ipc_queue_t *queue, void *item);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_IPC
+
+#endif // MBED_IPC_API_H
+
+/** @}*/
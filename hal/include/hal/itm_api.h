@@ -22,9 +22,29 @@
 
 #if DEVICE_ITM
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
+#ifndef MBED_CONF_TARGET_ITM_BUFFER_SIZE
+#define MBED_CONF_TARGET_ITM_BUFFER_SIZE 64
+#endif
+
+/* Mask of the stimulus ports enabled by mbed_itm_init on top of the SWO and trace ports */
+#ifndef MBED_CONF_TARGET_ITM_STIMULUS_PORTS
+#define MBED_CONF_TARGET_ITM_STIMULUS_PORTS 0
+#endif
+
+/* Send local timestamp packets after the stimulus port packets */
+#ifndef MBED_CONF_TARGET_ITM_TIMESTAMPS
+#define MBED_CONF_TARGET_ITM_TIMESTAMPS 0
+#endif
+
+/* Prescaler of the timestamp counter, 0 to 3 for the core clock divided by 1, 4, 16 or 64 */
+#ifndef MBED_CONF_TARGET_ITM_TIMESTAMP_PRESCALER
+#define MBED_CONF_TARGET_ITM_TIMESTAMP_PRESCALER 0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,7 +55,11 @@ extern "C" {
  */
 
 enum {
-    ITM_PORT_SWO = 0
+    ITM_PORT_SWO = 0,
+    ITM_PORT_TRACE_ERROR = 1,
+    ITM_PORT_TRACE_WARN = 2,
+    ITM_PORT_TRACE_INFO = 3,
+    ITM_PORT_TRACE_DEBUG = 4
 };
 
 /**
@@ -57,12 +81,18 @@ enum {
  *                  TPI->FFCR
  *                  DWT->CTRL
  *
- *             for SWO output on stimulus port 0.
+ *             for SWO output on stimulus port 0 and the trace ports.
  */
 void itm_init(void);
 
 /**
  * @brief      Initialization function for both generic registers and target specific clock and pin.
+ *
+ * Enables stimulus port 0 for SWO output, the trace ports, and the ports of
+ * MBED_CONF_TARGET_ITM_STIMULUS_PORTS. With MBED_CONF_TARGET_ITM_TIMESTAMPS,
+ * the ITM follows the stimulus port packets with local timestamp packets, the
+ * core clock cycles since the previous packet divided as set by
+ * MBED_CONF_TARGET_ITM_TIMESTAMP_PRESCALER, on cores with a prescaler.
  */
 void mbed_itm_init(void);
 
@@ -90,6 +120,106 @@ uint32_t mbed_itm_send(uint32_t port, uint32_t data);
  */
 void mbed_itm_send_block(uint32_t port, const void *data, size_t len);
 
+/**
+ * @brief      Send data over ITM stimulus port if its FIFO is ready.
+ *
+ * @param[in]  port  The stimulus port to send data over.
+ * @param[in]  data  The 32-bit data to send.
+ *
+ * @return     true if the data was written, false if the port is disabled
+ *             or its FIFO is full.
+ */
+bool mbed_itm_try_send(uint32_t port, uint32_t data);
+
+/**
+ * @brief      Send a block of data over ITM stimulus port without waiting.
+ *
+ * @param[in]  port  The stimulus port to send data over.
+ * @param[in]  data  The block of data to send.
+ * @param[in]  len   The number of bytes of data to send.
+ *
+ * The data is written with the same port accesses as mbed_itm_send_block,
+ * while the stimulus port FIFO is ready. It stops at the first access the
+ * FIFO does not accept, and the rest of the data is left to the caller to
+ * drop or send later. Safe to call from interrupts, several subsystems can
+ * send on their own ports concurrently.
+ *
+ * @return     number of bytes sent.
+ */
+size_t mbed_itm_try_send_block(uint32_t port, const void *data, size_t len);
+
+/**
+ * @brief      Queue a block of data for ITM stimulus port without waiting.
+ *
+ * @param[in]  port  The stimulus port to send data over.
+ * @param[in]  data  The block of data to send.
+ * @param[in]  len   The number of bytes of data to send.
+ *
+ * The data is split to 32-bit words and queued to a buffer of
+ * MBED_CONF_TARGET_ITM_BUFFER_SIZE port writes, which is then written out
+ * as far as the stimulus port FIFO accepts it. Data that does not fit
+ * to the buffer is dropped. Safe to call from interrupts.
+ *
+ * @return     number of bytes queued.
+ */
+size_t mbed_itm_send_block_buffered(uint32_t port, const void *data, size_t len);
+
+/**
+ * @brief      Write out queued data while the stimulus port FIFO accepts it.
+ *
+ * Returns when the buffer is empty or the FIFO is full, it never waits.
+ * Should be called regularly, for example from the idle loop.
+ */
+void mbed_itm_flush(void);
+
+/**
+ * @brief      Get number of bytes dropped because the buffer was full.
+ *
+ * @return     number of dropped bytes since start up.
+ */
+uint32_t mbed_itm_dropped(void);
+
+/**
+ * @brief      Start sending samples of the program counter over SWO.
+ *
+ * @param[in]  interval  The number of core clock cycles between samples.
+ *
+ * The DWT sends a PC sample packet every interval cycles, with the address
+ * of the instruction executing, or a sleep packet if the core is sleeping.
+ * The interval is rounded to a multiple of 64 cycles up to 1024 cycles, or of
+ * 1024 cycles up to 16384 cycles, which the DWT counter supports. Each sample
+ * is 5 bytes on SWO, so the SWO bandwidth bounds the rate of sampling. ITM is
+ * initialized if it was not.
+ *
+ * tools/swo_profile/swo_profile.py turns the samples into a profile by
+ * function.
+ *
+ * @return     the interval of the samples, in core clock cycles.
+ */
+uint32_t mbed_itm_pc_sampling_start(uint32_t interval);
+
+/**
+ * @brief      Stop sending samples of the program counter.
+ */
+void mbed_itm_pc_sampling_stop(void);
+
+/**
+ * @brief      mbed_trace print function for buffered SWO output.
+ *
+ * @param[in]  dlevel  The trace level of the line.
+ * @param[in]  str     The trace line, with its newline.
+ *
+ * Each trace level is sent over its own stimulus port, ITM_PORT_TRACE_ERROR to
+ * ITM_PORT_TRACE_DEBUG, and other output over ITM_PORT_SWO.
+ * usage e.g.
+ * @code
+ *  mbed_itm_init();
+ *  mbed_trace_init();
+ *  mbed_trace_level_print_function_set(mbed_itm_trace_print);
+ * @endcode
+ */
+void mbed_itm_trace_print(uint8_t dlevel, const char *str);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -38,6 +38,7 @@ extern "C" {
  * * Has a reported frequency between 4KHz and 64KHz - verified by ::lp_ticker_info_test
  * * Has a counter that is at least 12 bits wide - verified by ::lp_ticker_info_test
  * * Continues operating in deep sleep mode - verified by ::lp_ticker_deepsleep_test
+ * * lp_ticker_set_irq_priority only accepts priorities masked by critical sections - verified by ::lp_ticker_irq_priority_test
  * * All behavior defined by the @ref hal_ticker_shared "ticker specification"
  *
  * # Undefined behavior
@@ -63,6 +64,9 @@ extern "C" {
  *
  * If any are defined, all 3 must be defined, and the macros are checked for consistency with
  * lp_ticker_get_info by test ::lp_ticker_info_test.
+ *
+ * LP_TICKER_IRQn: The NVIC interrupt of the ticker, whose priority is then set by
+ * lp_ticker_set_irq_priority.
 
  * @{
  */
@@ -87,6 +91,16 @@ ticker_irq_handler_type set_lp_ticker_irq_handler(ticker_irq_handler_type ticker
  */
 const ticker_data_t *get_lp_ticker_data(void);
 
+/** Set the priority of the low power ticker interrupt
+ *
+ * See us_ticker_set_irq_priority(), the same constraints apply.
+ *
+ * @param priority Priority as passed to NVIC_SetPriority()
+ * @return true if the priority was set, false if the critical sections don't
+ *         mask it or the target doesn't define LP_TICKER_IRQn
+ */
+bool lp_ticker_set_irq_priority(uint32_t priority);
+
 /** The wrapper for ticker_irq_handler, to pass lp ticker's data
  *
  */
@@ -22,11 +22,36 @@
 
 #include "device.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Access permissions of an MPU region */
+typedef enum {
+    MPU_ACCESS_NONE,        /**< Any access faults, for stack guards */
+    MPU_ACCESS_READ_ONLY,   /**< Writes fault */
+    MPU_ACCESS_READ_WRITE,  /**< Reads and writes are allowed */
+} mpu_access_t;
+
+/** Cache policy of an MPU region of normal memory */
+typedef enum {
+    MPU_CACHE_NONE,             /**< Not cacheable, for DMA buffers */
+    MPU_CACHE_WRITE_THROUGH,    /**< Write-through, read-allocate */
+    MPU_CACHE_WRITE_BACK,       /**< Write-back, read and write-allocate */
+} mpu_cache_t;
+
+/** Memory region configured with ::mbed_mpu_region_add */
+typedef struct {
+    uint32_t base;          /**< Start address of the region */
+    uint32_t size;          /**< Size of the region, in bytes */
+    mpu_access_t access;    /**< Access permissions */
+    mpu_cache_t cache;      /**< Cache policy */
+    bool shareable;         /**< Shared with other bus masters */
+    bool execute_never;     /**< Instruction fetches fault */
+} mpu_region_t;
+
 #if DEVICE_MPU
 
 /**
@@ -42,9 +67,31 @@ extern "C" {
  *      This RAM includes heap, stack, data and zero init - Verified  by ::mpu_fault_test_data,
  *      ::mpu_fault_test_bss, ::mpu_fault_test_stack and ::mpu_fault_test_heap.
  * * Writing to ROM results in a fault when write never is enabled - Not verified
+ * * ::mbed_mpu_region_add configures a region with the first MPU region not used
+ *   and returns it, or returns -1 if none is left or if the MPU can't
+ *   configure the region - Verified by ::mpu_region_add_test
+ * * On ARMv6-M and ARMv7-M, regions added take priority over the ROM and RAM
+ *   protection - Verified by ::mpu_region_guard_test
+ * * ::mbed_mpu_region_set changes the region in place - Verified by
+ *   ::mpu_region_set_test
+ * * ::mbed_mpu_region_remove frees the region for ::mbed_mpu_region_add -
+ *   Verified by ::mpu_region_add_test
+ * * ::mbed_mpu_init removes every region added, and adds the one of the DMA
+ *   RAM when it is configured as non-cacheable or write-through, see
+ *   ::hal_dma_tx_prepare
+ *
+ * # Region constraints
+ * * ARMv6-M and ARMv7-M: the size is a power of two of at least 32 bytes, and
+ *   the base is a multiple of the size
+ * * ARMv8-M: the base and size are multiples of 32 bytes, and the region
+ *   overlaps no other enabled region, as an access matching several regions
+ *   faults. ::MPU_ACCESS_NONE is not supported, stack guards are done with the
+ *   stack limit registers instead.
  *
  * # Undefined behavior
  * * Calling any function other than ::mbed_mpu_init before the initialization of the MPU.
+ * * Overlapping regions added with ::mbed_mpu_region_add
+ * * Setting or removing a region which was not added
  *
  * @{
  */
@@ -82,6 +129,43 @@ void mbed_mpu_enable_rom_wn(bool enable);
  */
 void mbed_mpu_enable_ram_xn(bool enable);
 
+/**
+ * Add a memory region
+ *
+ * Non cacheable regions spare the cache maintenance of DMA buffers, see
+ * ::hal_dma_tx_prepare. A region with no access below a stack faults on
+ * stack overflows.
+ *
+ * @code
+ * HAL_DMA_BUFFER(static, rx_buffer, 1024);
+ *
+ * const mpu_region_t region = {
+ *     (uint32_t)rx_buffer, sizeof(rx_buffer), MPU_ACCESS_READ_WRITE, MPU_CACHE_NONE, false, true
+ * };
+ * int id = mbed_mpu_region_add(&region);
+ * @endcode
+ *
+ * @param region The region to add
+ * @return The region added, or -1 if it could not be added
+ */
+int mbed_mpu_region_add(const mpu_region_t *region);
+
+/**
+ * Change a memory region
+ *
+ * @param id     The region returned by ::mbed_mpu_region_add
+ * @param region The new configuration of the region
+ * @return 0 on success, -1 if the MPU can't configure the region
+ */
+int mbed_mpu_region_set(int id, const mpu_region_t *region);
+
+/**
+ * Remove a memory region
+ *
+ * @param id The region returned by ::mbed_mpu_region_add
+ */
+void mbed_mpu_region_remove(int id);
+
 /** Deinitialize the MPU
  *
  * Powerdown the MPU in preparation for powerdown, reset or jumping to another application.
@@ -98,6 +182,12 @@ void mbed_mpu_free(void);
 
 #define mbed_mpu_enable_ram_xn(enable) (void)enable
 
+#define mbed_mpu_region_add(region) ((void)(region), -1)
+
+#define mbed_mpu_region_set(id, region) ((void)(id), (void)(region), -1)
+
+#define mbed_mpu_region_remove(id) (void)id
+
 #define mbed_mpu_free()
 
 #endif
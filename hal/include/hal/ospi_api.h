@@ -142,6 +142,63 @@ typedef enum ospi_status {
     OSPI_STATUS_OK    =  0, /**< Function executed sucessfully  >*/
 } ospi_status_t;
 
+/** OSPI asynchronous operation handler
+ *
+ * @param id The id given when the operation was started
+ * @param status OSPI_STATUS_OK if the operation completed, an error status otherwise
+ */
+typedef void (*ospi_async_handler)(uint32_t id, ospi_status_t status);
+
+#ifndef MBED_CONF_TARGET_OSPI_READ_CACHE_LINES
+#define MBED_CONF_TARGET_OSPI_READ_CACHE_LINES 4
+#endif
+
+#ifndef MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE
+#define MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE 256
+#endif
+
+/** Line of a OSPI read cache
+ */
+typedef struct ospi_read_cache_line {
+    uint32_t address; /**< Memory address of the first byte of the line >*/
+    uint32_t last_use; /**< Value of the cache use counter at the last hit or fill >*/
+    bool valid; /**< The line holds the memory content >*/
+    uint8_t data[MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE]; /**< Content of the line >*/
+} ospi_read_cache_line_t;
+
+/** OSPI read cache
+ *
+ * Memory read in MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE lines, evicting the
+ * least recently used of the MBED_CONF_TARGET_OSPI_READ_CACHE_LINES lines.
+ */
+typedef struct ospi_read_cache {
+    ospi_t *ospi; /**< OSPI object the memory is read with >*/
+    ospi_command_t read_cmd; /**< Command reading the lines, its address is set for each line >*/
+    uint32_t use_count; /**< Counter of the line uses >*/
+    ospi_read_cache_line_t lines[MBED_CONF_TARGET_OSPI_READ_CACHE_LINES]; /**< The lines >*/
+} ospi_read_cache_t;
+
+/** Maximum pattern length accepted by ::ospi_calibrate
+ */
+#define OSPI_CALIBRATION_MAX_LENGTH 64
+
+/** OSPI controller capabilities
+ */
+typedef struct {
+    uint32_t bus_widths;                      /**< Bit n set if ospi_bus_width_t value n is supported >*/
+    uint32_t max_hz[OSPI_CFG_BUS_OCTA_DTR + 1]; /**< Maximum frequency per bus width, 0 if unknown >*/
+    uint32_t sample_delays;                   /**< Number of selectable sample delays, 0 if fixed >*/
+    bool dqs;                                 /**< Read data can be sampled with DQS >*/
+} ospi_capabilities_t;
+
+/** Result of ::ospi_calibrate
+ */
+typedef struct {
+    uint32_t hz;           /**< Highest frequency at which the pattern was read back >*/
+    uint32_t sample_delay; /**< Sample delay in the middle of the passing window >*/
+    bool dqs;              /**< DQS sampling is used >*/
+} ospi_calibration_t;
+
 /** Initialize OSPI peripheral.
  *
  * It should initialize OSPI pins (io0-io7, sclk, ssel and dqs), set frequency, clock polarity and phase mode. The clock for the peripheral should be enabled
@@ -204,6 +261,56 @@ ospi_status_t ospi_free(ospi_t *obj);
  */
 ospi_status_t ospi_frequency(ospi_t *obj, int hz);
 
+/** Get the controller capabilities
+ *
+ * The default implementation reports every bus width with unknown maximum
+ * frequencies, a fixed sample delay and no DQS sampling.
+ *
+ * @param obj OSPI object
+ * @param cap Filled with the capabilities
+ */
+void ospi_get_capabilities(ospi_t *obj, ospi_capabilities_t *cap);
+
+/** Select the read data sample delay
+ *
+ * @param obj OSPI object
+ * @param delay The delay, lower than ospi_capabilities_t::sample_delays
+ * @return OSPI_STATUS_OK if the delay was set
+           OSPI_STATUS_INVALID_PARAMETER if the delay is not supported
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_set_sample_delay(ospi_t *obj, uint32_t delay);
+
+/** Enable or disable sampling read data with DQS
+ *
+ * @param obj OSPI object
+ * @param enable true to sample with DQS
+ * @return OSPI_STATUS_OK if the setting was applied
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_set_dqs(ospi_t *obj, bool enable);
+
+/** Find the highest stable frequency and the best sample delay
+ *
+ * The memory must already hold the pattern at the command address. Starting at the
+ * maximum frequency of the command data bus width, the pattern is read back with
+ * DQS sampling if available, otherwise with each sample delay. The frequency is
+ * lowered in 1/8 steps until a read succeeds. The controller is left configured
+ * with the result.
+ *
+ * @param obj OSPI object
+ * @param read_cmd The read command used for calibration
+ * @param pattern The expected data
+ * @param length The pattern length in bytes, at most ::OSPI_CALIBRATION_MAX_LENGTH
+ * @param min_hz The lowest frequency to try
+ * @param result Filled with the selected settings
+ * @return OSPI_STATUS_OK if stable settings were found
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_calibrate(ospi_t *obj, const ospi_command_t *read_cmd, const void *pattern, size_t length,
+                             uint32_t min_hz, ospi_calibration_t *result);
+
 /** Send a command and block of data
  *
  * @param obj OSPI object
@@ -242,6 +349,185 @@ ospi_status_t ospi_command_transfer(ospi_t *obj, const ospi_command_t *command,
  */
 ospi_status_t ospi_read(ospi_t *obj, const ospi_command_t *command, void *data, size_t *length);
 
+/** Switch the controller to memory-mapped (XIP) mode
+ *
+ * The external memory can then be read, and code executed from it, directly at
+ * ::ospi_memory_mapped_base. The address field of the command is ignored, the bus
+ * address selects the memory address. ::ospi_write, ::ospi_read and
+ * ::ospi_command_transfer must not be called until ::ospi_disable_memory_mapped
+ * has returned, use it to leave memory-mapped mode before programming.
+ * The default implementation does not support memory-mapped mode.
+ *
+ * @param obj OSPI object
+ * @param read_cmd The read command the controller issues for bus accesses
+ * @return OSPI_STATUS_OK if memory-mapped mode is enabled
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_enable_memory_mapped(ospi_t *obj, const ospi_command_t *read_cmd);
+
+/** Switch the controller to memory-mapped mode for reads and writes
+ *
+ * Same as ::ospi_enable_memory_mapped, for RAM such as OPI PSRAM and HyperRAM:
+ * bus writes are turned into the write command, so the memory can be used as
+ * normal RAM at ::ospi_memory_mapped_base. The latency of the memory is the
+ * dummy count of the commands; HyperBus controllers generate the
+ * command-address phase themselves and only use the bus widths and dummy counts.
+ * The default implementation does not support memory-mapped mode.
+ *
+ * @param obj OSPI object
+ * @param read_cmd The read command the controller issues for bus reads
+ * @param write_cmd The write command the controller issues for bus writes
+ * @return OSPI_STATUS_OK if memory-mapped mode is enabled
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_enable_memory_mapped_rw(ospi_t *obj, const ospi_command_t *read_cmd, const ospi_command_t *write_cmd);
+
+/** Leave memory-mapped mode and return to indirect command transfers
+ *
+ * @param obj OSPI object
+ * @return OSPI_STATUS_OK if indirect mode is restored
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_disable_memory_mapped(ospi_t *obj);
+
+/** Get the bus address the external memory is mapped at
+ *
+ * With ::ospi_enable_memory_mapped_rw, the memory may be written through the
+ * returned address, cast to a non-const pointer.
+ *
+ * @param obj OSPI object
+ * @return The address of memory address 0, NULL if memory-mapped mode is not enabled
+ */
+const void *ospi_memory_mapped_base(const ospi_t *obj);
+
+/** Start a command and write block of data without blocking
+ *
+ * The handler is called from interrupt context once the transfer has completed.
+ * Targets move the data with DMA where the controller supports it. The data buffer
+ * must stay valid and no other transfer may be started until then.
+ * The default implementation uses ::ospi_write and calls the handler before returning.
+ *
+ * @param obj OSPI object
+ * @param command OSPI command
+ * @param data TX buffer
+ * @param length TX buffer length in bytes
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return OSPI_STATUS_OK if the transfer has started, the handler is not called otherwise
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_write_async(ospi_t *obj, const ospi_command_t *command, const void *data, size_t length, ospi_async_handler handler, uint32_t id);
+
+/** Start a command and read block of data without blocking
+ *
+ * Same as ::ospi_write_async, for reading. The default implementation uses ::ospi_read.
+ *
+ * @param obj OSPI object
+ * @param command OSPI command
+ * @param data RX buffer
+ * @param length RX buffer length in bytes
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return OSPI_STATUS_OK if the transfer has started, the handler is not called otherwise
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_read_async(ospi_t *obj, const ospi_command_t *command, void *data, size_t length, ospi_async_handler handler, uint32_t id);
+
+/** Poll a status register until it matches without blocking
+ *
+ * The command reads one status byte, typically Read Status Register. The controller
+ * repeats it until (status & mask) == match, then the handler is called from interrupt
+ * context. Use it to wait for the write-in-progress bit to clear after erase or program.
+ * Targets use the controller's automatic polling mode where available.
+ * The default implementation polls with ::ospi_command_transfer before returning.
+ *
+ * @param obj OSPI object
+ * @param command OSPI command reading the status byte
+ * @param mask The status bits to compare
+ * @param match The expected value of the masked bits
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return OSPI_STATUS_OK if polling has started, the handler is not called otherwise
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_status_poll_async(ospi_t *obj, const ospi_command_t *command, uint8_t mask, uint8_t match, ospi_async_handler handler, uint32_t id);
+
+/** Check whether an asynchronous transfer or status poll is in progress
+ *
+ * @param obj OSPI object
+ * @return true if an asynchronous operation is ongoing
+ */
+bool ospi_async_active(ospi_t *obj);
+
+/** Abort the ongoing asynchronous transfer or status poll
+ *
+ * The handler is not called.
+ *
+ * @param obj OSPI object
+ */
+void ospi_abort_async(ospi_t *obj);
+
+/** Initialize a read cache
+ *
+ * The cache stores recently read memory so that small random reads do not each pay
+ * for the command, address and dummy cycles. Memory is read a whole line at a time,
+ * so the memory size must be a multiple of MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE.
+ * The cache is only coherent if the memory is modified through
+ * ::ospi_read_cache_write and ::ospi_read_cache_erase, or
+ * ::ospi_read_cache_invalidate is called after modifying it.
+ *
+ * @param cache The read cache
+ * @param obj OSPI object the memory is read with
+ * @param read_cmd The read command, its address is ignored
+ */
+void ospi_read_cache_init(ospi_read_cache_t *cache, ospi_t *obj, const ospi_command_t *read_cmd);
+
+/** Read memory through the read cache
+ *
+ * Reads longer than a line bypass the cache.
+ *
+ * @param cache The read cache
+ * @param address The memory address
+ * @param data RX buffer
+ * @param length RX buffer length in bytes
+ * @return OSPI_STATUS_OK if the data has been read
+           OSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           OSPI_STATUS_ERROR otherwise
+ */
+ospi_status_t ospi_read_cache_read(ospi_read_cache_t *cache, uint32_t address, void *data, size_t length);
+
+/** Write memory and invalidate the cached lines it overlaps
+ *
+ * @param cache The read cache
+ * @param command The write command, its address is the memory address written
+ * @param data TX buffer
+ * @param[in,out] length in - TX buffer length in bytes, out - number of bytes written
+ * @return The status of ::ospi_write
+ */
+ospi_status_t ospi_read_cache_write(ospi_read_cache_t *cache, const ospi_command_t *command, const void *data, size_t *length);
+
+/** Erase memory and invalidate the cached lines it overlaps
+ *
+ * @param cache The read cache
+ * @param command The erase command, its address is the memory address erased
+ * @param size The number of bytes the command erases
+ * @return The status of ::ospi_command_transfer
+ */
+ospi_status_t ospi_read_cache_erase(ospi_read_cache_t *cache, const ospi_command_t *command, size_t size);
+
+/** Invalidate the cached lines overlapping a memory range
+ *
+ * @param cache The read cache
+ * @param address The memory address
+ * @param length The length of the range in bytes
+ */
+void ospi_read_cache_invalidate(ospi_read_cache_t *cache, uint32_t address, size_t length);
+
 /** Get the pins that support OSPI SCLK
  *
  * Return a PinMap array of pins that support OSPI SCLK in
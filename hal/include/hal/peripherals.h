@@ -0,0 +1,345 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_HAL_PERIPHERALS_H
+#define MBED_HAL_PERIPHERALS_H
+
+#include "device.h"
+
+#ifdef __cplusplus
+
+#include "hal/gpio_fast_api.h"
+#include "hal/static_pinmap.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace mbed {
+namespace hal {
+
+/**
+ * \defgroup hal_peripherals C++ peripheral objects
+ * Header-only C++ objects holding HAL objects, with their pins as template
+ * parameters
+ *
+ * The constructor initializes the peripheral and the destructor frees it.
+ * The member functions are inline calls of the C functions, with no
+ * virtual dispatch or state other than the HAL object, so they compile to
+ * the same code as the C API.
+ *
+ * With C++14 and the target pin map tables of the peripheral
+ * (STATIC_PINMAP_READY and the PINMAP_ macros), the peripherals are resolved
+ * at compile time with the get_*_pinmap()
+ * functions and initialized with the *_init_direct() functions. Pins which
+ * do not map to one peripheral fail the build.
+ *
+ * @code
+ * mbed::hal::Gpio<LED1> led(PIN_OUTPUT);
+ * mbed::hal::Spi<SPI_MOSI, SPI_MISO, SPI_SCK> spi;
+ *
+ * spi.frequency(8000000);
+ * led.write(1);
+ * spi.write(0x9F);
+ * @endcode
+ *
+ * @{
+ */
+
+#if __cplusplus >= 201402L && STATIC_PINMAP_READY
+#define MBED_HAL_PERIPHERALS_STATIC 1
+#else
+#define MBED_HAL_PERIPHERALS_STATIC 0
+#endif
+
+/** Base of the peripheral objects, neither copyable nor movable */
+class NonCopyablePeripheral {
+protected:
+    NonCopyablePeripheral() = default;
+    ~NonCopyablePeripheral() = default;
+    NonCopyablePeripheral(const NonCopyablePeripheral &) = delete;
+    NonCopyablePeripheral &operator=(const NonCopyablePeripheral &) = delete;
+};
+
+/** GPIO pin, with the accesses of the GPIO fast path */
+template <PinName Pin>
+class Gpio : private NonCopyablePeripheral {
+public:
+    /** Initialize the pin
+     *
+     * @param direction The direction of the pin
+     * @param mode      The pull mode of the pin
+     * @param value     The initial output value
+     */
+    explicit Gpio(PinDirection direction = PIN_INPUT, PinMode mode = PullDefault, int value = 0)
+    {
+        gpio_init_inout(&_gpio, Pin, direction, mode, value);
+    }
+
+    ~Gpio()
+    {
+        gpio_free(&_gpio);
+    }
+
+    void write(int value)
+    {
+        gpio_fast_write(&_gpio, value);
+    }
+
+    int read()
+    {
+        return gpio_fast_read(&_gpio);
+    }
+
+    void toggle()
+    {
+        gpio_fast_toggle(&_gpio);
+    }
+
+    void dir(PinDirection direction)
+    {
+        gpio_dir(&_gpio, direction);
+    }
+
+    void mode(PinMode mode)
+    {
+        gpio_mode(&_gpio, mode);
+    }
+
+    /** The HAL object, for the functions not wrapped */
+    gpio_t *get()
+    {
+        return &_gpio;
+    }
+
+private:
+    gpio_t _gpio;
+};
+
+#if DEVICE_SPI
+/** SPI master */
+template <PinName Mosi, PinName Miso, PinName Sclk, PinName Ssel = NC>
+class Spi : private NonCopyablePeripheral {
+public:
+    /** Initialize the SPI peripheral, in mode 0 with 8 bit words */
+    Spi()
+    {
+#if MBED_HAL_PERIPHERALS_STATIC && defined(PINMAP_SPI_MOSI) && defined(PINMAP_SPI_MISO) && defined(PINMAP_SPI_SCLK) && defined(PINMAP_SPI_SSEL)
+        static constexpr spi_pinmap_t pinmap = get_spi_pinmap(Mosi, Miso, Sclk, Ssel);
+        STATIC_PINMAP_ASSERT(pinmap);
+        spi_init_direct(&_spi, &pinmap);
+#else
+        spi_init(&_spi, Mosi, Miso, Sclk, Ssel);
+#endif
+    }
+
+    ~Spi()
+    {
+        spi_free(&_spi);
+    }
+
+    void format(int bits, int mode = 0)
+    {
+        spi_format(&_spi, bits, mode, 0);
+    }
+
+    void frequency(int hz)
+    {
+        spi_frequency(&_spi, hz);
+    }
+
+    int write(int value)
+    {
+        return spi_master_write(&_spi, value);
+    }
+
+    int write(const char *tx, int tx_length, char *rx, int rx_length, char fill = 0xFF)
+    {
+        return spi_master_block_write(&_spi, tx, tx_length, rx, rx_length, fill);
+    }
+
+    /** The HAL object, for the functions not wrapped */
+    spi_t *get()
+    {
+        return &_spi;
+    }
+
+private:
+    spi_t _spi;
+};
+#endif // DEVICE_SPI
+
+#if DEVICE_I2C
+/** I2C master */
+template <PinName Sda, PinName Scl>
+class I2c : private NonCopyablePeripheral {
+public:
+    I2c()
+    {
+#if MBED_HAL_PERIPHERALS_STATIC && defined(PINMAP_I2C_SDA) && defined(PINMAP_I2C_SCL)
+        static constexpr i2c_pinmap_t pinmap = get_i2c_pinmap(Sda, Scl);
+        STATIC_PINMAP_ASSERT(pinmap);
+        i2c_init_direct(&_i2c, &pinmap);
+#else
+        i2c_init(&_i2c, Sda, Scl);
+#endif
+    }
+
+    ~I2c()
+    {
+        i2c_free(&_i2c);
+    }
+
+    void frequency(int hz)
+    {
+        i2c_frequency(&_i2c, hz);
+    }
+
+    int read(int address, char *data, int length, bool stop = true)
+    {
+        return i2c_read(&_i2c, address, data, length, stop);
+    }
+
+    int write(int address, const char *data, int length, bool stop = true)
+    {
+        return i2c_write(&_i2c, address, data, length, stop);
+    }
+
+    /** The HAL object, for the functions not wrapped */
+    i2c_t *get()
+    {
+        return &_i2c;
+    }
+
+private:
+    i2c_t _i2c;
+};
+#endif // DEVICE_I2C
+
+#if DEVICE_SERIAL
+/** Serial port */
+template <PinName Tx, PinName Rx>
+class Serial : private NonCopyablePeripheral {
+public:
+    /** Initialize the serial port
+     *
+     * @param baudrate The baud rate
+     */
+    explicit Serial(int baudrate = 9600)
+    {
+#if MBED_HAL_PERIPHERALS_STATIC && defined(PINMAP_UART_TX) && defined(PINMAP_UART_RX)
+        static constexpr serial_pinmap_t pinmap = get_uart_pinmap(Tx, Rx);
+        STATIC_PINMAP_ASSERT(pinmap);
+        serial_init_direct(&_serial, &pinmap);
+#else
+        serial_init(&_serial, Tx, Rx);
+#endif
+        serial_baud(&_serial, baudrate);
+    }
+
+    ~Serial()
+    {
+        serial_free(&_serial);
+    }
+
+    void baud(int baudrate)
+    {
+        serial_baud(&_serial, baudrate);
+    }
+
+    void putc(int c)
+    {
+        serial_putc(&_serial, c);
+    }
+
+    int getc()
+    {
+        return serial_getc(&_serial);
+    }
+
+    /** The HAL object, for the functions not wrapped */
+    serial_t *get()
+    {
+        return &_serial;
+    }
+
+private:
+    serial_t _serial;
+};
+#endif // DEVICE_SERIAL
+
+#if DEVICE_PWMOUT
+/** PWM output */
+template <PinName Pin>
+class PwmOut : private NonCopyablePeripheral {
+public:
+    PwmOut()
+    {
+#if MBED_HAL_PERIPHERALS_STATIC && defined(PINMAP_PWM)
+        static constexpr PinMap pinmap = get_pwm_pinmap(Pin);
+        STATIC_PINMAP_ASSERT(pinmap);
+        pwmout_init_direct(&_pwm, &pinmap);
+#else
+        pwmout_init(&_pwm, Pin);
+#endif
+    }
+
+    ~PwmOut()
+    {
+        pwmout_free(&_pwm);
+    }
+
+    void period_us(int us)
+    {
+        pwmout_period_us(&_pwm, us);
+    }
+
+    void pulsewidth_us(int us)
+    {
+        pwmout_pulsewidth_us(&_pwm, us);
+    }
+
+    /** Set the duty-cycle, 0 for 0 percent to 65535 for 100 percent */
+    void write_u16(uint16_t duty)
+    {
+        pwmout_write_u16(&_pwm, duty);
+    }
+
+    /** The HAL object, for the functions not wrapped */
+    pwmout_t *get()
+    {
+        return &_pwm;
+    }
+
+private:
+    pwmout_t _pwm;
+};
+#endif // DEVICE_PWMOUT
+
+#undef MBED_HAL_PERIPHERALS_STATIC
+
+/**@}*/
+
+} // namespace hal
+} // namespace mbed
+
+#endif // __cplusplus
+
+#endif // MBED_HAL_PERIPHERALS_H
+
+/** @}*/
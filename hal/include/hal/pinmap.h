@@ -39,6 +39,23 @@ typedef struct {
     const PinName *pins;
 } PinList;
 
+/** Pin map sorted by pin, generated by tools/pinmap_index/pinmap_index.py */
+typedef struct {
+    const PinMap *map;    /**< The pin map, terminated by NC */
+    const PinMap *sorted; /**< Entries of map in ascending pin order, equal pins in their map order */
+    uint32_t count;       /**< Number of entries in sorted */
+} PinMapIndex;
+
+/** Most distinct candidate pins ::pinmap_find_peripheral_pins tracks in its pin sets,
+ *  beyond this it falls back to a slower search
+ */
+#ifndef MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS
+#define MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS 64
+#endif
+
+/** Most pin maps ::pinmap_find_peripheral_pins solves at once with pin sets */
+#define PINMAP_SOLVER_MAX_MAPS 16
+
 typedef struct {
     uint32_t count;
     const int *peripheral;
@@ -54,6 +71,28 @@ void     pinmap_pinout(PinName pin, const PinMap *map);
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap *map);
 uint32_t pinmap_find_function(PinName pin, const PinMap *map);
 
+/**
+ * Get the sorted index of a pin map
+ *
+ * Used by pinmap_pinout(), pinmap_find_peripheral() and pinmap_find_function()
+ * to binary search instead of scanning the map. Targets get a definition by
+ * building the file generated by tools/pinmap_index/pinmap_index.py.
+ * The default implementation returns NULL.
+ *
+ * @param map The pin map
+ * @return The index of map, or NULL if map has none
+ */
+const PinMapIndex *pinmap_index(const PinMap *map);
+
+/**
+ * Find the first entry of a pin in a sorted pin map
+ *
+ * @param index The pin map index
+ * @param pin The pin to look for
+ * @return The map entry for pin, or NULL if pin is not in the map
+ */
+const PinMap *pinmap_index_find(const PinMapIndex *index, PinName pin);
+
 /**
  * Find a combination of pins suitable for use given the constraints
  *
@@ -120,6 +159,36 @@ uint32_t pinmap_find_function(PinName pin, const PinMap *map);
  */
 bool pinmap_find_peripheral_pins(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count);
 
+/**
+ * Handler called for each combination found by ::pinmap_find_all_peripheral_pins
+ *
+ * @param context The context given to ::pinmap_find_all_peripheral_pins
+ * @return true to look for the next combination, false to stop
+ */
+typedef bool (*pinmap_pins_handler)(void *context);
+
+/**
+ * Find every combination of pins suitable for use with a peripheral
+ *
+ * The pins are chosen as for ::pinmap_find_peripheral_pins. The handler is
+ * called with each combination written to the pins array. When the handler
+ * returns false the search stops and the pins keep that combination, otherwise
+ * the unset pins are back to NC on return.
+ *
+ * @param whitelist List of pins to choose from
+ * @param blacklist List of pins which cannot be used
+ * @param per Peripheral to which the pins belong
+ * @param maps An array of pin maps to select from
+ * @param pins An array of pins to find. Pins already set to a value will be
+ *             left unchanged. Only pins initialized to NC will be updated by this function
+ * @param count The size of maps and pins, at most PINMAP_SOLVER_MAX_MAPS
+ * @param handler Handler called for each combination
+ * @param context Context passed to the handler
+ * @return The number of combinations passed to the handler, 0 if there is none or if
+ *         more than MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS distinct pins are candidates
+ */
+uint32_t pinmap_find_all_peripheral_pins(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count, pinmap_pins_handler handler, void *context);
+
 /**
  * Check if the pin is in the list
  *
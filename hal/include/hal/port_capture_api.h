@@ -0,0 +1,204 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_PORT_CAPTURE_API_H
+#define MBED_PORT_CAPTURE_API_H
+
+#include "device.h"
+
+#if DEVICE_PORTIN
+
+#include "hal/dma_api.h"
+#include "hal/gpio_api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_port_capture Port capture
+ * Capture of a parallel bus from a port into a buffer
+ *
+ * Each sample is a read of the input data register of the port, triggered
+ * on an edge of a clock pin, or at a fixed rate. The samples are the low
+ * 1, 2 or 4 bytes of the register, unmasked: wire the bus to the low pins of
+ * the port for byte samples.
+ *
+ * When the target provides a DMA request for the trigger with
+ * ::port_capture_dma_get, the DMA controller moves the samples with no CPU
+ * load and no sample is missed. Otherwise the capture falls back to reading
+ * the port from a GPIO interrupt on the clock pin, at rates limited by the
+ * interrupt latency. The software capture at a fixed rate is blocking: the
+ * port is read in a loop timed by the us ticker with interrupts disabled, and
+ * the handler is called before ::port_capture_start returns.
+ *
+ * With DMA, the buffer must be kept coherent with the data cache by the
+ * caller, see hal/cache_api.h.
+ *
+ * @code
+ * static uint8_t samples[1024];
+ * static const port_capture_config_t config = { ADC_CLK, IRQ_RISE, 0, 1 };
+ * static port_capture_t capture;
+ *
+ * port_init(&port, PortA, 0xFF, PIN_INPUT);
+ * port_capture_start(&capture, &port, &config, samples, sizeof(samples), on_samples, 0);
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::port_capture_start returns -1 if the trigger is not supported, or
+ *   neither a clock pin nor a rate is given
+ * * The software capture at a fixed rate supports rates up to 1 MHz
+ * * The handler is called from interrupt context with
+ *   PORT_CAPTURE_EVENT_COMPLETE once count samples are in the buffer
+ * * The handler is called with PORT_CAPTURE_EVENT_ERROR and the capture stops
+ *   on a DMA bus error
+ * * ::port_capture_stop stops the capture without calling the handler
+ * * ::port_capture_uses_dma returns true while a capture moved by DMA is in
+ *   progress
+ *
+ * # Undefined behavior
+ * * Calling ::port_capture_start on a capture in progress
+ * * Accessing the buffer before the handler is called or the capture stopped
+ *
+ * # Requirements for targets
+ * * Targets able to trigger DMA requests from an edge of a pin, or from a
+ *   timer, implement ::port_capture_dma_get and ::port_capture_dma_release
+ *
+ * @{
+ */
+
+/** Events reported to the handler of a capture */
+typedef enum {
+    PORT_CAPTURE_EVENT_COMPLETE = (1 << 0), /**< count samples were captured */
+    PORT_CAPTURE_EVENT_ERROR    = (1 << 1)  /**< The DMA transfer stopped on a bus error */
+} port_capture_event_t;
+
+/** Handler called from interrupt context at the end of a capture
+ *
+ * @param id     The id given to ::port_capture_start
+ * @param events The logical OR of the port_capture_event_t that occurred
+ */
+typedef void (*port_capture_handler)(uint32_t id, uint32_t events);
+
+/** Trigger and size of the samples
+ */
+typedef struct {
+    PinName clock;       /**< Pin clocking the samples, NC to sample at rate_hz */
+    gpio_irq_event edge; /**< Edge of the clock sampled, IRQ_RISE or IRQ_FALL */
+    uint32_t rate_hz;    /**< Sample rate when there is no clock pin */
+    uint8_t width;       /**< Size of the samples in bytes: 1, 2 or 4 */
+} port_capture_config_t;
+
+#if DEVICE_DMA
+/** DMA request and data register of a capture, filled by the target
+ */
+typedef struct {
+    dma_request_t request;     /**< Request raised on each trigger */
+    const volatile void *data; /**< Input data register of the port */
+} port_capture_dma_t;
+#endif
+
+/** Capture in progress
+ */
+typedef struct {
+    port_t *port;
+    uint8_t *buffer;
+    size_t count;
+    volatile size_t index;
+    uint8_t width;
+    port_capture_handler handler;
+    uint32_t id;
+    int channel;          /**< DMA channel, -1 for software capture */
+#if DEVICE_DMA
+    dma_descriptor_t descriptor;
+#endif
+#if DEVICE_INTERRUPTIN
+    gpio_irq_t irq;
+    bool irq_used;
+#endif
+} port_capture_t;
+
+/** Start capturing samples into a buffer
+ *
+ * @param capture The capture
+ * @param port    The port, initialized as input
+ * @param config  The trigger and the size of the samples
+ * @param buffer  The buffer, count samples of config->width bytes, aligned to the width
+ * @param count   The number of samples
+ * @param handler The handler called at the end of the capture
+ * @param id      The id passed to the handler
+ * @return 0 if the capture started, -1 otherwise
+ */
+int port_capture_start(port_capture_t *capture, port_t *port, const port_capture_config_t *config, void *buffer, size_t count, port_capture_handler handler, uint32_t id);
+
+/** Stop a capture, without calling its handler
+ *
+ * @param capture The capture
+ */
+void port_capture_stop(port_capture_t *capture);
+
+/** Check whether a capture is in progress
+ *
+ * @param capture The capture
+ * @return true from ::port_capture_start until the handler is called or the capture is stopped
+ */
+bool port_capture_is_busy(port_capture_t *capture);
+
+/** Check whether the samples of a capture in progress are moved by DMA
+ *
+ * @param capture The capture
+ * @return true if the capture uses DMA, false for the software capture or once it ended
+ */
+bool port_capture_uses_dma(port_capture_t *capture);
+
+#if DEVICE_DMA
+/** Set up the trigger of a port for DMA capture
+ *
+ * Routes the edge of the clock pin, or a timer running at the rate, to a DMA
+ * request. The default implementation returns -1.
+ *
+ * @param obj    The port
+ * @param config The trigger and the size of the samples
+ * @param dma    The DMA request and data register of the port
+ * @return 0 on success, -1 if the trigger is not supported
+ */
+int port_capture_dma_get(port_t *obj, const port_capture_config_t *config, port_capture_dma_t *dma);
+
+/** Release the trigger set up by ::port_capture_dma_get
+ *
+ * @param obj The port
+ */
+void port_capture_dma_release(port_t *obj);
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_PORTIN
+
+#endif // MBED_PORT_CAPTURE_API_H
+
+/** @}*/
@@ -23,8 +23,16 @@
 #include "device.h"
 #include "pinmap.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #if DEVICE_PWMOUT
 
+/* Number of outputs running a DMA burst at the same time */
+#ifndef MBED_CONF_TARGET_PWMOUT_BURST_COUNT
+#define MBED_CONF_TARGET_PWMOUT_BURST_COUNT 2
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +41,36 @@ extern "C" {
  */
 typedef struct pwmout_s pwmout_t;
 
+/** Pwmout period interrupt handler
+ * @param id The id given to ::pwmout_period_irq_set
+ */
+typedef void (*pwmout_irq_handler)(uint32_t id);
+
+/** Pwmout capabilities structure
+ */
+typedef struct {
+    bool burst; /**< ::pwmout_burst_start is supported */
+} pwmout_capabilities_t;
+
+/** DMA request and register of the pulsewidth updates of an output
+ */
+typedef struct {
+    uint32_t request;       /**< DMA request raised by the timer at the start of every period */
+    volatile void *compare; /**< Compare register of the channel, written 16 bits at a time */
+} pwmout_burst_dma_t;
+
+/** Events reported to the handler of a burst */
+typedef enum {
+    PWMOUT_BURST_EVENT_COMPLETE = (1 << 0), /**< All the pulsewidths have been written */
+    PWMOUT_BURST_EVENT_ERROR    = (1 << 1)  /**< The burst stopped on a DMA error */
+} pwmout_burst_event_t;
+
+/** Handler called from interrupt context at the end of a burst
+ * @param id     The id given to ::pwmout_burst_start
+ * @param events The logical OR of the pwmout_burst_event_t that occurred
+ */
+typedef void (*pwmout_burst_handler)(uint32_t id, uint32_t events);
+
 /**
  * \defgroup hal_pwmout Pwmout hal functions
  *
@@ -49,6 +87,15 @@ typedef struct pwmout_s pwmout_t;
  * * ::pwmout_pulsewidth_ms sets the PWM pulsewidth specified in miliseconds, keeping the period the same
  * * ::pwmout_pulsewidth_us sets the PWM pulsewidth specified in microseconds, keeping the period the same
  * * ::pwmout_read_pulsewidth_us read the PWM pulsewidth specified in microseconds
+ * * ::pwmout_write_u16 sets the output duty-cycle in range <0, 65535> - TBD (basic test)
+ * * ::pwmout_read_u16 returns the current output duty-cycle in range <0, 65535> - TBD (basic test)
+ * * ::pwmout_tick_frequency returns the frequency of the ticks used by ::pwmout_period_ticks and ::pwmout_pulsewidth_ticks - TBD (basic test)
+ * * ::pwmout_period_ticks sets the PWM period specified in ticks, keeping the duty cycle the same - TBD (basic test)
+ * * ::pwmout_pulsewidth_ticks sets the PWM pulsewidth specified in ticks, keeping the period the same - TBD (basic test)
+ * * ::pwmout_write_u16_sync sets the duty-cycles of all the given outputs from the same PWM period on - TBD (basic test)
+ * * ::pwmout_period_irq_set calls the handler at the start of every PWM period, or returns -1 if not supported - TBD (basic test)
+ * * ::pwmout_burst_start sets a new pulsewidth at the start of each PWM period, from a buffer, without interrupts, if
+ *   ::pwmout_get_capabilities reports bursts - TBD (basic test)
  * * The accuracy of the PWM is +/- 10%
  * * The PWM operations ::pwmout_write, ::pwmout_read, ::pwmout_read, ::pwmout_period_ms, ::pwmout_period_us
  *   ::pwmout_pulsewidth, ::pwmout_pulsewidth_ms, ::pwmout_pulsewidth_us take less than 20us to complete
@@ -152,6 +199,102 @@ void pwmout_pulsewidth_us(pwmout_t *obj, int us);
  */
 int pwmout_read_pulsewidth_us(pwmout_t *obj);
 
+/** Set the output duty-cycle in range <0, 65535>
+ * Value 0 represents 0 percent, 65535 represents 100 percent.
+ * Unlike ::pwmout_write, no floating-point arithmetic is involved.
+ * @param obj  The pwmout object
+ * @param duty The duty-cycle
+ */
+void pwmout_write_u16(pwmout_t *obj, uint16_t duty);
+
+/** Read the current output duty-cycle in range <0, 65535>
+ * @param obj The pwmout object
+ * @return The duty-cycle
+ */
+uint16_t pwmout_read_u16(pwmout_t *obj);
+
+/** Get the frequency of the PWM ticks
+ * Targets return the counter clock of the PWM timer. The default
+ * implementation uses microseconds as ticks.
+ * @param obj The pwmout object
+ * @return The number of ticks per second
+ */
+uint32_t pwmout_tick_frequency(pwmout_t *obj);
+
+/** Set the PWM period specified in ticks, keeping the duty cycle the same
+ * @param obj   The pwmout object
+ * @param ticks The period in ticks of ::pwmout_tick_frequency
+ */
+void pwmout_period_ticks(pwmout_t *obj, uint32_t ticks);
+
+/** Set the PWM pulsewidth specified in ticks, keeping the period the same
+ * @param obj   The pwmout object
+ * @param ticks The pulsewidth in ticks of ::pwmout_tick_frequency
+ */
+void pwmout_pulsewidth_ticks(pwmout_t *obj, uint32_t ticks);
+
+/** Set the duty-cycles of several outputs together
+ * The new duty-cycles take effect from the same PWM period on. Targets
+ * should write the compare registers of the channels sharing a timer
+ * while its update event is held off, or in one register write. The
+ * default implementation calls ::pwmout_write_u16 for every output with
+ * interrupts disabled.
+ * @param objs  The pwmout objects
+ * @param duty  The duty-cycles, one per output
+ * @param count The number of outputs
+ */
+void pwmout_write_u16_sync(pwmout_t *const *objs, const uint16_t *duty, size_t count);
+
+/** Set the handler called at the start of every PWM period
+ * The default implementation returns -1.
+ * @param obj     The pwmout object
+ * @param handler The handler, called from interrupt context, or NULL to disable the interrupt
+ * @param id      The id passed to the handler
+ * @return 0 on success, -1 if the period interrupt is not supported
+ */
+int pwmout_period_irq_set(pwmout_t *obj, pwmout_irq_handler handler, uint32_t id);
+
+/** Get the capabilities of the output
+ * @param obj The pwmout object
+ * @param cap The capabilities to fill
+ */
+void pwmout_get_capabilities(pwmout_t *obj, pwmout_capabilities_t *cap);
+
+/** Get the DMA request and register of the pulsewidth updates of an output
+ * Targets implement it for the timers raising a DMA request on their update
+ * event, with the compare register preloaded so a value written during a
+ * period takes effect at the start of the next one. The common
+ * implementation of the bursts uses it on targets with DEVICE_DMA. The
+ * default implementation returns -1.
+ * @param obj The pwmout object
+ * @param dma The request and register
+ * @return 0 on success, -1 if the output cannot be updated by DMA
+ */
+int pwmout_burst_dma_get(pwmout_t *obj, pwmout_burst_dma_t *dma);
+
+/** Stream pulsewidths to the output, one per PWM period
+ * The DMA writes the next pulsewidth at the start of every period, for
+ * waveforms or LED protocols like WS2812 changing the duty cycle every
+ * period. The first pulsewidth takes effect one period after the start, and
+ * the last one stays in effect after the burst, so a burst usually ends with
+ * the idle level. Periods starting too fast for the DMA repeat the previous
+ * pulsewidth. The buffer must be kept coherent with the data cache, see
+ * hal/cache_api.h, and unchanged until the handler is called.
+ * @param obj         The pwmout object
+ * @param pulsewidths The pulsewidths in ticks of ::pwmout_tick_frequency
+ * @param count       The number of pulsewidths
+ * @param handler     The handler, called from interrupt context at the end of the burst
+ * @param id          The id passed to the handler
+ * @return 0 on success, -1 if bursts are not supported or no DMA channel is free
+ */
+int pwmout_burst_start(pwmout_t *obj, const uint16_t *pulsewidths, size_t count, pwmout_burst_handler handler, uint32_t id);
+
+/** Stop the burst of the output without calling its handler
+ * The pulsewidth written last stays in effect.
+ * @param obj The pwmout object
+ */
+void pwmout_burst_stop(pwmout_t *obj);
+
 /** Get the pins that support PWM
  *
  * Return a PinMap array of pins that support PWM.
@@ -0,0 +1,196 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_PWMOUT_GROUP_API_H
+#define MBED_PWMOUT_GROUP_API_H
+
+#include "device.h"
+
+#if DEVICE_PWMOUT_GROUP
+
+#include "pinmap.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Largest number of channels of a group */
+#define PWMOUT_GROUP_MAX_CHANNELS 6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_pwmout_group PWM group
+ * Channels of one timer, with complementary outputs, dead-time and
+ * synchronized updates, for motor control and power conversion
+ *
+ * The channels of a group share the period and the counter of their timer.
+ * Each channel drives an output and optionally its complementary output,
+ * with the hardware inserting the dead-time between the edges of the two.
+ * The pulsewidths are written to the preload, or shadow, registers and take
+ * effect together at the start of the next period.
+ *
+ * @code
+ * static const pwmout_group_channel_t phases[3] = {
+ *     { PHASE_U, PHASE_U_N }, { PHASE_V, PHASE_V_N }, { PHASE_W, PHASE_W_N }
+ * };
+ * static const pwmout_group_config_t config = { 20000, PWMOUT_ALIGN_CENTER, 500 };
+ * pwmout_group_t bridge;
+ *
+ * if (pwmout_group_init(&bridge, phases, 3, &config) == 0) {
+ *     pwmout_group_write_u16(&bridge, (const uint16_t[]) { 0x8000, 0x8000, 0x8000 });
+ *     pwmout_group_start(&bridge);
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::pwmout_group_init returns -1, with no output driven, if the pins are not
+ *   channels of one timer, or the configuration is not supported
+ * * The outputs are at their inactive level from ::pwmout_group_init to
+ *   ::pwmout_group_start, and after ::pwmout_group_stop
+ * * ::pwmout_group_start starts all the channels on the same counter cycle
+ * * The pulsewidths written by one ::pwmout_group_write take effect from the
+ *   same period on, never partly
+ * * An output and its complementary output are never active at the same time,
+ *   and each edge of one is delayed by the dead-time after the opposite edge
+ *   of the other
+ * * In center-aligned mode, the pulses of all channels are centered on the
+ *   middle of the period
+ *
+ * # Undefined behavior
+ * * Calling other functions before ::pwmout_group_init
+ * * Pulsewidths longer than the period
+ *
+ * # Requirements for targets
+ * * DEVICE_PWMOUT_GROUP is defined in device.h and struct pwmout_group_s in
+ *   objects.h
+ *
+ * @{
+ */
+
+/** PWM group HAL structure. pwmout_group_s is declared in the target's hal
+ */
+typedef struct pwmout_group_s pwmout_group_t;
+
+/** Alignment of the pulses in the period
+ */
+typedef enum {
+    PWMOUT_ALIGN_EDGE,   /**< Pulses start at the start of the period, the counter counts up */
+    PWMOUT_ALIGN_CENTER  /**< Pulses centered in the period, the counter counts up then down */
+} pwmout_alignment_t;
+
+/** Pins of a channel
+ */
+typedef struct {
+    PinName pin;   /**< Output */
+    PinName pin_n; /**< Complementary output, NC for none */
+} pwmout_group_channel_t;
+
+/** Configuration of a group
+ */
+typedef struct {
+    uint32_t period_us;           /**< Period of the PWM, in microseconds */
+    pwmout_alignment_t alignment; /**< Alignment of the pulses */
+    uint32_t dead_time_ns;        /**< Dead-time of the complementary outputs, rounded up by the target */
+} pwmout_group_config_t;
+
+/** Initialize the channels of a group
+ *
+ * @param obj      The group object
+ * @param channels The pins of each channel
+ * @param count    The number of channels, up to PWMOUT_GROUP_MAX_CHANNELS
+ * @param config   The configuration of the group
+ * @return 0 on success, -1 if the group is not supported
+ */
+int pwmout_group_init(pwmout_group_t *obj, const pwmout_group_channel_t *channels, size_t count, const pwmout_group_config_t *config);
+
+/** Stop the outputs and release the pins and the timer
+ *
+ * @param obj The group object
+ */
+void pwmout_group_free(pwmout_group_t *obj);
+
+/** Start all the channels together
+ *
+ * @param obj The group object
+ */
+void pwmout_group_start(pwmout_group_t *obj);
+
+/** Stop all the channels, with the outputs at their inactive level
+ *
+ * @param obj The group object
+ */
+void pwmout_group_stop(pwmout_group_t *obj);
+
+/** Get the number of channels of the group
+ *
+ * @param obj The group object
+ * @return The number of channels given to ::pwmout_group_init
+ */
+size_t pwmout_group_channel_count(pwmout_group_t *obj);
+
+/** Get the period of the PWM in timer ticks
+ *
+ * In center-aligned mode the period is the whole up and down cycle of the
+ * counter.
+ *
+ * @param obj The group object
+ * @return The period in ticks, the unit of the pulsewidths of ::pwmout_group_write
+ */
+uint32_t pwmout_group_period_ticks(pwmout_group_t *obj);
+
+/** Get the dead-time inserted by the timer
+ *
+ * @param obj The group object
+ * @return The dead-time in nanoseconds, after rounding
+ */
+uint32_t pwmout_group_dead_time_ns(pwmout_group_t *obj);
+
+/** Set the pulsewidths of all the channels from the next period on
+ *
+ * Writes the preload registers with the update event of the timer held off,
+ * so it is safe to call from the period interrupt or any other context.
+ *
+ * @param obj         The group object
+ * @param pulsewidths The pulsewidths in ticks of ::pwmout_group_period_ticks, one per channel
+ */
+void pwmout_group_write(pwmout_group_t *obj, const uint32_t *pulsewidths);
+
+/** Set the duty-cycles of all the channels from the next period on
+ *
+ * Value 0 represents 0 percent, 65535 represents 100 percent. The default
+ * implementation converts the duty-cycles to ticks for ::pwmout_group_write.
+ *
+ * @param obj  The group object
+ * @param duty The duty-cycles, one per channel
+ */
+void pwmout_group_write_u16(pwmout_group_t *obj, const uint16_t *duty);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_PWMOUT_GROUP
+
+#endif // MBED_PWMOUT_GROUP_API_H
+
+/** @}*/
@@ -0,0 +1,238 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_QEI_API_H
+#define MBED_QEI_API_H
+
+#include "device.h"
+#include "pinmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if DEVICE_QEI
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Qei hal structure. qei_s is declared in the target's hal
+ */
+typedef struct qei_s qei_t;
+
+/** Edges of the encoder signals which are counted */
+typedef enum {
+    QEI_MODE_X2,    /**< Both edges of the A signal */
+    QEI_MODE_X4     /**< Both edges of the A and B signals */
+} qei_mode_t;
+
+/** Direction of the last count */
+typedef enum {
+    QEI_DIRECTION_UP,       /**< A leads B, the counter is incremented */
+    QEI_DIRECTION_DOWN      /**< B leads A, the counter is decremented */
+} qei_direction_t;
+
+/** Events reported to the handler */
+typedef enum {
+    QEI_EVENT_INDEX     = (1 << 0),     /**< Index pulse */
+    QEI_EVENT_OVERFLOW  = (1 << 1),     /**< The counter wrapped from its maximum to 0 */
+    QEI_EVENT_UNDERFLOW = (1 << 2),     /**< The counter wrapped from 0 to its maximum */
+    QEI_EVENT_DIRECTION = (1 << 3)      /**< The direction changed */
+} qei_event_t;
+
+/**
+ * \struct  qei_capabilities_t
+ *
+ * \brief   Capabilities of a quadrature encoder interface.
+ */
+typedef struct {
+    uint8_t  counter_bits;      /**< Width of the counter, at most 32 */
+    bool     x4;                /**< QEI_MODE_X4 is supported */
+    bool     index;             /**< The index pulse is supported */
+    bool     index_reset;       /**< The index pulse can reset the counter */
+    uint32_t events;            /**< Logical OR of the qei_event_t which can be reported */
+    uint8_t  filter_max;        /**< Highest input filter setting, 0 if there is no filter */
+} qei_capabilities_t;
+
+/** Pins of a quadrature encoder interface */
+typedef struct {
+    int peripheral;
+    PinName a_pin;
+    int a_function;
+    PinName b_pin;
+    int b_function;
+    PinName index_pin;
+    int index_function;
+} qei_pinmap_t;
+
+/** Handler called from interrupt context on the enabled events
+ * @param id     The id given to ::qei_irq_set
+ * @param events The logical OR of the qei_event_t that occurred
+ */
+typedef void (*qei_irq_handler)(uint32_t id, uint32_t events);
+
+/**
+ * \defgroup hal_qei Quadrature encoder interface hal functions
+ * Encoder positions counted by a timer in encoder mode
+ *
+ * The timer counts the edges of the A and B signals of a quadrature encoder,
+ * up or down depending on which leads, without any CPU load. Positions wider
+ * than the counter are kept by the caller from the overflow and underflow
+ * events.
+ *
+ * # Defined behavior
+ * * ::qei_init initializes the qei_t control structure, with the counter at 0
+ * * ::qei_free deinitializes the qei object
+ * * ::qei_get_capabilities fills the capabilities of the interface
+ * * ::qei_read returns the counter value
+ * * ::qei_write sets the counter value
+ * * ::qei_direction returns the direction of the last count
+ * * ::qei_index_reset sets whether the index pulse resets the counter to 0
+ * * ::qei_filter sets the input filter rejecting glitches on the signals
+ * * ::qei_irq_set calls the handler on the enabled events, and returns -1 if
+ *   one of them is not supported
+ * * The counter is incremented by one per count, in the counted edges of ::qei_mode_t
+ *
+ * # Undefined behavior
+ * * Calling other function before ::qei_init
+ * * Calling ::qei_init with NC as A or B pin
+ * * Writing a counter value wider than the counter
+ * * Enabling the index events or reset with NC as index pin
+ * * Counts faster than the input filter or the timer clock allow
+ *
+ * @{
+ */
+
+/** Initialize the quadrature encoder interface and configure the pins
+ *
+ * @param obj    The qei object to initialize
+ * @param pinmap pointer to structure which holds static pinmap
+ * @param mode   The counted edges
+ */
+void qei_init_direct(qei_t *obj, const qei_pinmap_t *pinmap, qei_mode_t mode);
+
+/** Initialize the quadrature encoder interface and configure the pins
+ *
+ * @param obj   The qei object to initialize
+ * @param a     The pin of the A signal
+ * @param b     The pin of the B signal
+ * @param index The pin of the index pulse, or NC
+ * @param mode  The counted edges
+ */
+void qei_init(qei_t *obj, PinName a, PinName b, PinName index, qei_mode_t mode);
+
+/** Deinitialize the qei object
+ *
+ * @param obj The qei object
+ */
+void qei_free(qei_t *obj);
+
+/** Fill the given qei_capabilities_t structure with the capabilities of the interface
+ *
+ * @param obj The qei object
+ * @param cap The capabilities to fill
+ */
+void qei_get_capabilities(qei_t *obj, qei_capabilities_t *cap);
+
+/** Read the counter
+ *
+ * @param obj The qei object
+ * @return The counter value
+ */
+uint32_t qei_read(qei_t *obj);
+
+/** Set the counter
+ *
+ * @param obj   The qei object
+ * @param count The counter value
+ */
+void qei_write(qei_t *obj, uint32_t count);
+
+/** Get the direction of the last count
+ *
+ * @param obj The qei object
+ * @return The direction
+ */
+qei_direction_t qei_direction(qei_t *obj);
+
+/** Set whether the index pulse resets the counter
+ *
+ * @param obj    The qei object
+ * @param enable true to reset the counter to 0 on the index pulse
+ * @return 0 on success, -1 if not supported
+ */
+int qei_index_reset(qei_t *obj, bool enable);
+
+/** Set the input filter of the signals
+ *
+ * Higher settings reject longer glitches, and limit the count rate. The
+ * lengths are target specific.
+ * @param obj    The qei object
+ * @param filter The filter setting, 0 to disable the filter, at most qei_capabilities_t::filter_max
+ */
+void qei_filter(qei_t *obj, uint8_t filter);
+
+/** Set the handler called on the events of the interface
+ *
+ * @param obj     The qei object
+ * @param handler The handler, called from interrupt context
+ * @param id      The id passed to the handler
+ * @param events  The logical OR of the qei_event_t to enable, 0 to disable the interrupt
+ * @return 0 on success, -1 if one of the events is not supported
+ */
+int qei_irq_set(qei_t *obj, qei_irq_handler handler, uint32_t id, uint32_t events);
+
+/** Get the pins that support the A signal
+ *
+ * Return a PinMap array of pins that support the A signal.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *qei_a_pinmap(void);
+
+/** Get the pins that support the B signal
+ *
+ * Return a PinMap array of pins that support the B signal.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *qei_b_pinmap(void);
+
+/** Get the pins that support the index pulse
+ *
+ * Return a PinMap array of pins that support the index pulse.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *qei_index_pinmap(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -121,6 +121,66 @@ typedef enum qspi_status {
     QSPI_STATUS_OK    =  0, /**< Function executed sucessfully  >*/
 } qspi_status_t;
 
+/** QSPI asynchronous operation handler
+ *
+ * @param id The id given when the operation was started
+ * @param status QSPI_STATUS_OK if the operation completed, an error status otherwise
+ */
+typedef void (*qspi_async_handler)(uint32_t id, qspi_status_t status);
+
+#ifndef MBED_CONF_TARGET_QSPI_READ_CACHE_LINES
+#define MBED_CONF_TARGET_QSPI_READ_CACHE_LINES 4
+#endif
+
+#ifndef MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE
+#define MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE 256
+#endif
+
+/** Line of a QSPI read cache
+ */
+typedef struct qspi_read_cache_line {
+    uint32_t address; /**< Memory address of the first byte of the line >*/
+    uint32_t last_use; /**< Value of the cache use counter at the last hit or fill >*/
+    bool valid; /**< The line holds the memory content >*/
+    uint8_t data[MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE]; /**< Content of the line >*/
+} qspi_read_cache_line_t;
+
+/** QSPI read cache
+ *
+ * Memory read in MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE lines, evicting the
+ * least recently used of the MBED_CONF_TARGET_QSPI_READ_CACHE_LINES lines.
+ */
+typedef struct qspi_read_cache {
+    qspi_t *qspi; /**< QSPI object the memory is read with >*/
+    qspi_command_t read_cmd; /**< Command reading the lines, its address is set for each line >*/
+    uint32_t use_count; /**< Counter of the line uses >*/
+    qspi_read_cache_line_t lines[MBED_CONF_TARGET_QSPI_READ_CACHE_LINES]; /**< The lines >*/
+} qspi_read_cache_t;
+
+/** Type of a step of a command sequence
+ */
+typedef enum qspi_step_type {
+    QSPI_STEP_TRANSFER, /**< ::qspi_command_transfer of tx_data and rx_data >*/
+    QSPI_STEP_WRITE,    /**< ::qspi_write of tx_data >*/
+    QSPI_STEP_READ,     /**< ::qspi_read to rx_data >*/
+    QSPI_STEP_POLL,     /**< Repeat the command reading a status byte until it matches >*/
+} qspi_step_type_t;
+
+/** Step of a command sequence
+ *
+ * Which of the buffers are used depends on the type, the others are ignored.
+ */
+typedef struct qspi_step {
+    qspi_step_type_t type; /**< Type of the step >*/
+    qspi_command_t command; /**< Command of the step >*/
+    const void *tx_data; /**< TX buffer >*/
+    size_t tx_size; /**< TX buffer length in bytes >*/
+    void *rx_data; /**< RX buffer >*/
+    size_t rx_size; /**< RX buffer length in bytes >*/
+    uint8_t poll_mask; /**< Status bits compared by QSPI_STEP_POLL >*/
+    uint8_t poll_match; /**< Expected value of the masked status bits >*/
+} qspi_step_t;
+
 /** Initialize QSPI peripheral.
  *
  * It should initialize QSPI pins (io0-io3, sclk and ssel), set frequency, clock polarity and phase mode. The clock for the peripheral should be enabled
@@ -215,6 +275,201 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+/** Switch the controller to memory-mapped (XIP) mode
+ *
+ * The external memory can then be read, and code executed from it, directly at
+ * ::qspi_memory_mapped_base. The address field of the command is ignored, the bus
+ * address selects the memory address. ::qspi_write, ::qspi_read and
+ * ::qspi_command_transfer must not be called until ::qspi_disable_memory_mapped
+ * has returned, use it to leave memory-mapped mode before programming.
+ * The default implementation does not support memory-mapped mode.
+ *
+ * @param obj QSPI object
+ * @param read_cmd The read command the controller issues for bus accesses
+ * @return QSPI_STATUS_OK if memory-mapped mode is enabled
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_enable_memory_mapped(qspi_t *obj, const qspi_command_t *read_cmd);
+
+/** Leave memory-mapped mode and return to indirect command transfers
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if indirect mode is restored
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_disable_memory_mapped(qspi_t *obj);
+
+/** Get the bus address the external memory is mapped at
+ *
+ * @param obj QSPI object
+ * @return The address of memory address 0, NULL if memory-mapped mode is not enabled
+ */
+const void *qspi_memory_mapped_base(const qspi_t *obj);
+
+/** Start a command and write block of data without blocking
+ *
+ * The handler is called from interrupt context once the transfer has completed.
+ * Targets move the data with DMA where the controller supports it. The data buffer
+ * must stay valid and no other transfer may be started until then.
+ * The default implementation uses ::qspi_write and calls the handler before returning.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data TX buffer
+ * @param length TX buffer length in bytes
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has started, the handler is not called otherwise
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_async_handler handler, uint32_t id);
+
+/** Start a command and read block of data without blocking
+ *
+ * Same as ::qspi_write_async, for reading. The default implementation uses ::qspi_read.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data RX buffer
+ * @param length RX buffer length in bytes
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has started, the handler is not called otherwise
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_async_handler handler, uint32_t id);
+
+/** Poll a status register until it matches without blocking
+ *
+ * The command reads one status byte, typically Read Status Register. The controller
+ * repeats it until (status & mask) == match, then the handler is called from interrupt
+ * context. Use it to wait for the write-in-progress bit to clear after erase or program.
+ * Targets use the controller's automatic polling mode where available.
+ * The default implementation polls with ::qspi_command_transfer before returning.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command reading the status byte
+ * @param mask The status bits to compare
+ * @param match The expected value of the masked bits
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return QSPI_STATUS_OK if polling has started, the handler is not called otherwise
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_status_poll_async(qspi_t *obj, const qspi_command_t *command, uint8_t mask, uint8_t match, qspi_async_handler handler, uint32_t id);
+
+/** Run a sequence of commands
+ *
+ * Memory operations are sequences such as write enable, program, then poll the
+ * write-in-progress bit. The steps are run in order, and the sequence stops at the
+ * first step failing. Targets chain the steps without returning to the caller in
+ * between, and run QSPI_STEP_POLL with the controller's automatic polling mode.
+ * The default implementation runs each step with the corresponding function, and
+ * QSPI_STEP_POLL with ::qspi_status_poll_async.
+ *
+ * @param obj QSPI object
+ * @param steps The steps
+ * @param count The number of steps
+ * @return QSPI_STATUS_OK if every step succeeded
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_command_sequence(qspi_t *obj, const qspi_step_t *steps, size_t count);
+
+/** Run a sequence of commands without blocking
+ *
+ * Same as ::qspi_command_sequence, but the handler is called from interrupt context
+ * once the last step has completed or a step has failed. The steps and their buffers
+ * must stay valid and no other transfer may be started until then.
+ * The default implementation uses ::qspi_command_sequence and calls the handler
+ * before returning.
+ *
+ * @param obj QSPI object
+ * @param steps The steps
+ * @param count The number of steps
+ * @param handler The completion handler
+ * @param id The id passed to the handler
+ * @return QSPI_STATUS_OK if the sequence has started, the handler is not called otherwise
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_command_sequence_async(qspi_t *obj, const qspi_step_t *steps, size_t count, qspi_async_handler handler, uint32_t id);
+
+/** Check whether an asynchronous transfer or status poll is in progress
+ *
+ * @param obj QSPI object
+ * @return true if an asynchronous operation is ongoing
+ */
+bool qspi_async_active(qspi_t *obj);
+
+/** Abort the ongoing asynchronous transfer or status poll
+ *
+ * The handler is not called.
+ *
+ * @param obj QSPI object
+ */
+void qspi_abort_async(qspi_t *obj);
+
+/** Initialize a read cache
+ *
+ * The cache stores recently read memory so that small random reads do not each pay
+ * for the command, address and dummy cycles. Memory is read a whole line at a time,
+ * so the memory size must be a multiple of MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE.
+ * The cache is only coherent if the memory is modified through
+ * ::qspi_read_cache_write and ::qspi_read_cache_erase, or
+ * ::qspi_read_cache_invalidate is called after modifying it.
+ *
+ * @param cache The read cache
+ * @param obj QSPI object the memory is read with
+ * @param read_cmd The read command, its address is ignored
+ */
+void qspi_read_cache_init(qspi_read_cache_t *cache, qspi_t *obj, const qspi_command_t *read_cmd);
+
+/** Read memory through the read cache
+ *
+ * Reads longer than a line bypass the cache.
+ *
+ * @param cache The read cache
+ * @param address The memory address
+ * @param data RX buffer
+ * @param length RX buffer length in bytes
+ * @return QSPI_STATUS_OK if the data has been read
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_read_cache_read(qspi_read_cache_t *cache, uint32_t address, void *data, size_t length);
+
+/** Write memory and invalidate the cached lines it overlaps
+ *
+ * @param cache The read cache
+ * @param command The write command, its address is the memory address written
+ * @param data TX buffer
+ * @param[in,out] length in - TX buffer length in bytes, out - number of bytes written
+ * @return The status of ::qspi_write
+ */
+qspi_status_t qspi_read_cache_write(qspi_read_cache_t *cache, const qspi_command_t *command, const void *data, size_t *length);
+
+/** Erase memory and invalidate the cached lines it overlaps
+ *
+ * @param cache The read cache
+ * @param command The erase command, its address is the memory address erased
+ * @param size The number of bytes the command erases
+ * @return The status of ::qspi_command_transfer
+ */
+qspi_status_t qspi_read_cache_erase(qspi_read_cache_t *cache, const qspi_command_t *command, size_t size);
+
+/** Invalidate the cached lines overlapping a memory range
+ *
+ * @param cache The read cache
+ * @param address The memory address
+ * @param length The length of the range in bytes
+ */
+void qspi_read_cache_invalidate(qspi_read_cache_t *cache, uint32_t address, size_t length);
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_QSPI_SFDP_API_H
+#define MBED_QSPI_SFDP_API_H
+
+#include "device.h"
+
+#if DEVICE_QSPI
+
+#include "hal/qspi_api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Number of erase types of the Basic Flash Parameter Table */
+#define QSPI_SFDP_ERASE_TYPES 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_qspi_sfdp QSPI SFDP
+ * Discover the parameters of a serial NOR flash from its JEDEC SFDP tables
+ *
+ * The Basic Flash Parameter Table (JESD216) gives the size of the flash, its
+ * page size, erase types and fast read modes. ::qspi_sfdp_read_params picks
+ * the fastest read mode usable without switching the flash to another
+ * protocol: 1-4-4, then 1-1-4, 1-2-2, 1-1-2 and 1-1-1. The quad modes need the
+ * Quad Enable bit of the flash set, with ::qspi_sfdp_enable_quad.
+ *
+ * The 4-4-4 and DTR modes are reported but not selected: 4-4-4 needs the
+ * flash switched to QPI mode, and ::qspi_command_t has no DTR setting.
+ *
+ * @code
+ * qspi_sfdp_params_t params;
+ *
+ * if (qspi_sfdp_read_params(&qspi, &params) == QSPI_STATUS_OK &&
+ *         qspi_sfdp_enable_quad(&qspi, &params) == QSPI_STATUS_OK) {
+ *     qspi_read(&qspi, &params.read_cmd, data, &length);
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::qspi_sfdp_parse_bfpt keeps the 1-1-1 read command 0x03 unless the table
+ *   declares a faster mode
+ * * ::qspi_sfdp_read_params returns QSPI_STATUS_ERROR if the flash has no
+ *   valid SFDP header
+ * * ::qspi_sfdp_enable_quad does nothing if the read command selected is not
+ *   a quad one, or the flash declares no Quad Enable bit
+ *
+ * # Undefined behavior
+ * * Calling ::qspi_sfdp_read_params while the controller is in memory-mapped mode
+ *
+ * @{
+ */
+
+/** Erase type of the flash
+ */
+typedef struct qspi_sfdp_erase_type {
+    uint32_t size;       /**< Size erased, 0 if the erase type is not defined >*/
+    uint8_t instruction; /**< Instruction of the erase command >*/
+} qspi_sfdp_erase_type_t;
+
+/** Parameters of the flash
+ */
+typedef struct qspi_sfdp_params {
+    uint64_t size;      /**< Size of the flash in bytes >*/
+    uint32_t page_size; /**< Size of a program page in bytes >*/
+    qspi_command_t read_cmd; /**< Fastest read command, its address is set by the caller >*/
+    qspi_sfdp_erase_type_t erase[QSPI_SFDP_ERASE_TYPES]; /**< Erase types of the flash >*/
+    uint8_t quad_enable; /**< Quad Enable requirements of the Basic Flash Parameter Table, 0 for none >*/
+    bool read_444;       /**< The flash supports 4-4-4 fast read >*/
+    bool dtr;            /**< The flash supports DTR reads >*/
+} qspi_sfdp_params_t;
+
+/** Parse a Basic Flash Parameter Table
+ *
+ * @param bfpt The table
+ * @param length The length of the table in bytes, at least 36 bytes (9 DWORDs)
+ * @param params The parameters of the flash
+ * @return QSPI_STATUS_OK if the table was parsed
+           QSPI_STATUS_INVALID_PARAMETER if the table is too short
+ */
+qspi_status_t qspi_sfdp_parse_bfpt(const uint8_t *bfpt, size_t length, qspi_sfdp_params_t *params);
+
+/** Read the SFDP tables of the flash and parse them
+ *
+ * The SFDP tables are read with the Read SFDP command in 1-1-1 mode, with a
+ * 24 bit address and 8 dummy cycles.
+ *
+ * @param obj QSPI object
+ * @param params The parameters of the flash
+ * @return QSPI_STATUS_OK if the parameters were read
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_sfdp_read_params(qspi_t *obj, qspi_sfdp_params_t *params);
+
+/** Set the Quad Enable bit required by the quad read command
+ *
+ * @param obj QSPI object
+ * @param params The parameters returned by ::qspi_sfdp_read_params
+ * @return QSPI_STATUS_OK if the read command of the parameters can be used
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_sfdp_enable_quad(qspi_t *obj, const qspi_sfdp_params_t *params);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_QSPI
+
+#endif // MBED_QSPI_SFDP_API_H
+
+/** @}*/
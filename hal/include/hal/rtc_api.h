@@ -22,6 +22,7 @@
 
 #include "device.h"
 
+#include <stdint.h>
 #include <time.h>
 
 #ifdef __cplusplus
@@ -45,9 +46,19 @@ extern "C" {
  * - Verified by test ::rtc_write_read_test.
  * * The functions ::rtc_isenabled returns 1 if the RTC is counting and the time has been set,
  * 0 otherwise - Verified by test ::rtc_enabled_test.
+ * * The function ::rtc_read_subseconds returns the time with the seconds and
+ * the sub-seconds read together, and the sub-seconds are less than
+ * ::rtc_subsecond_frequency - Verified by test ::rtc_subseconds_test.
+ * * The function ::rtc_set_alarm calls the handler once at the given time, or
+ * right away if the time has passed, and returns -1 if alarms are not supported
+ * - Verified by test ::rtc_alarm_test.
+ * * The alarm wakes the target up from deep sleep - Verified by test ::rtc_alarm_test.
+ * * The function ::rtc_cancel_alarm stops the handler of an alarm from being called
+ * - Verified by test ::rtc_alarm_test.
  *
  * # Undefined behaviour
  * * Calling any function other than ::rtc_init before the initialisation of the RTC
+ * * Calling ::rtc_write while an alarm is set
  *
  * # Potential bugs
  * * Incorrect overflow handling - Verified by ::rtc_range_test
@@ -164,6 +175,64 @@ time_t rtc_read(void);
  */
 void rtc_write(time_t t);
 
+/** Handler of an RTC alarm, called from interrupt context
+ */
+typedef void (*rtc_alarm_handler)(void);
+
+/** Get the frequency of the sub-second counter of the RTC
+ *
+ * The default implementation returns 1, for RTCs counting whole seconds.
+ *
+ * @return The number of sub-second ticks per second
+ */
+uint32_t rtc_subsecond_frequency(void);
+
+/** Get the current time from the RTC peripheral with sub-second resolution
+ *
+ * The seconds and the sub-seconds are read from the same RTC update, which
+ * avoids reading the RTC and a ticker and matching their times.
+ *
+ * The default implementation returns the time of ::rtc_read and 0 sub-seconds.
+ *
+ * @param seconds The current time in seconds
+ * @return The sub-second ticks elapsed since @p seconds, in ticks of ::rtc_subsecond_frequency
+ *
+ * Example implementation for an RTC latching the seconds when the
+ * sub-seconds are read:
+ * @code
+ * uint32_t rtc_read_subseconds(time_t *seconds)
+ * {
+ *     // Counting down from the prescaler value
+ *     uint32_t subseconds = RTC_PRESCALER - RTC_SUBSECONDS;
+ *     *seconds = (time_t)RTC_SECONDS_SHADOW;
+ *
+ *     return subseconds;
+ * }
+ * @endcode
+ */
+uint32_t rtc_read_subseconds(time_t *seconds);
+
+/** Set the alarm of the RTC
+ *
+ * The alarm replaces the one already set, and is kept in sleep and deep sleep
+ * so it can wake up targets on which the RTC stays powered with a lower
+ * consumption than the lp ticker.
+ *
+ * The default implementation returns -1.
+ *
+ * @param seconds    The time of the alarm in seconds
+ * @param subseconds The sub-seconds of the alarm, in ticks of ::rtc_subsecond_frequency
+ * @param handler    The handler called at the time of the alarm
+ * @return 0 on success, -1 if alarms are not supported
+ */
+int rtc_set_alarm(time_t seconds, uint32_t subseconds, rtc_alarm_handler handler);
+
+/** Cancel the alarm of the RTC
+ *
+ * The default implementation does nothing.
+ */
+void rtc_cancel_alarm(void);
+
 /**@}*/
 
 #ifdef __cplusplus
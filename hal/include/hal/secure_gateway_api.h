@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_SECURE_GATEWAY_API_H
+#define MBED_SECURE_GATEWAY_API_H
+
+#include "device.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_secure_gateway Secure gateway
+ * Fewer secure calls from the non-secure image of TrustZone-M targets
+ *
+ * On targets built for a non-secure core (DOMAIN_NS), the HAL functions of
+ * secure peripherals are veneers into the secure image, and each call costs
+ * a secure transition. Two interfaces cut them down:
+ * * ::hal_secure_us_ticker_shadow gives the address of a counter the secure
+ *   image lets the non-secure image read, the us ticker counter. The us
+ *   ticker data then reads it directly rather than calling ::us_ticker_read.
+ * * ::hal_secure_gateway runs a batch of operations, flash programs and
+ *   erases, TRNG reads and ticker reads, with one secure call.
+ *
+ * The secure image implements both as non-secure entry functions, with
+ * ::MBED_NONSECURE_ENTRY. Its ::hal_secure_gateway checks that the buffers
+ * of the operations are non-secure memory, with cmse_check_address_range(),
+ * and calls ::hal_secure_gateway_execute with its own HAL objects. The
+ * default implementations, used when the secure image has no gateway, give
+ * no shadow and run each operation with its own secure call.
+ *
+ * @code
+ * hal_secure_op_t ops[] = {
+ *     { .type = HAL_SECURE_OP_FLASH_ERASE, .obj = &flash, .address = sector },
+ *     { .type = HAL_SECURE_OP_FLASH_PROGRAM, .obj = &flash, .address = sector, .data = image, .size = 1024 },
+ *     { .type = HAL_SECURE_OP_TRNG, .obj = &trng, .data = nonce, .size = sizeof(nonce) },
+ * };
+ *
+ * if (hal_secure_gateway(ops, 3) != 3) {
+ *     // ops[i].result tells which operation failed
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * The operations of a batch run in order, and the batch stops at the first
+ *   one which fails
+ * * The result of each operation is the one of the HAL function it stands
+ *   for, 0 on success
+ * * The value read through ::hal_secure_us_ticker_shadow is the one
+ *   ::us_ticker_read returns
+ *
+ * # Undefined behavior
+ * * Operations of secure peripherals the target doesn't have
+ *
+ * @{
+ */
+
+/** Operations of a batch */
+typedef enum {
+    HAL_SECURE_OP_US_TICKER_READ,   /**< ::us_ticker_read into value */
+    HAL_SECURE_OP_LP_TICKER_READ,   /**< ::lp_ticker_read into value */
+    HAL_SECURE_OP_TRNG,             /**< ::trng_get_bytes of size bytes into data, value set to the length written */
+    HAL_SECURE_OP_FLASH_PROGRAM,    /**< ::flash_program of size bytes of data at address */
+    HAL_SECURE_OP_FLASH_ERASE       /**< ::flash_erase_sector of the sector at address */
+} hal_secure_op_type_t;
+
+/** Operation of a batch */
+typedef struct {
+    uint8_t type;       /**< The hal_secure_op_type_t */
+    int32_t result;     /**< Set to the result of the operation */
+    void *obj;          /**< The flash_t or trng_t of the non-secure image, for the default gateway */
+    uint32_t address;   /**< Address in flash */
+    void *data;         /**< Data to program, or buffer to fill */
+    uint32_t size;      /**< Size of data in bytes */
+    uint32_t value;     /**< Value read */
+} hal_secure_op_t;
+
+/** Objects of the HAL the operations run with */
+typedef struct {
+    void *flash;        /**< The flash_t, NULL to run with the one of each operation */
+    void *trng;         /**< The trng_t, NULL to run with the one of each operation */
+} hal_secure_gateway_objects_t;
+
+/** Run a batch of operations with one secure call
+ *
+ * @param ops   The operations
+ * @param count The number of operations
+ * @return The number of operations which succeeded
+ */
+uint32_t hal_secure_gateway(hal_secure_op_t *ops, uint32_t count);
+
+/** Get the counter of the us ticker readable by the non-secure image
+ *
+ * @return The address of the counter, or NULL if it can only be read with
+ *         ::us_ticker_read
+ */
+const volatile uint32_t *hal_secure_us_ticker_shadow(void);
+
+/** Run a batch of operations with the HAL of the calling image
+ *
+ * @param objects The objects of the HAL, from the secure image
+ * @param ops     The operations, checked by the caller
+ * @param count   The number of operations
+ * @return The number of operations which succeeded
+ */
+uint32_t hal_secure_gateway_execute(const hal_secure_gateway_objects_t *objects, hal_secure_op_t *ops, uint32_t count);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_SECURE_GATEWAY_API_H
+
+/** @}*/
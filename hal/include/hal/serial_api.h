@@ -22,6 +22,8 @@
 
 #include "device.h"
 #include "pinmap.h"
+#include "hal/clock_api.h"
+#include "hal/gpio_api.h"
 #include "hal/utils/buffer.h"
 
 #if DEVICE_SERIAL
@@ -30,10 +32,14 @@
 #define SERIAL_EVENT_RX_SHIFT (8)
 
 #define SERIAL_EVENT_TX_MASK (0x00FC)
-#define SERIAL_EVENT_RX_MASK (0x3F00)
+#define SERIAL_EVENT_RX_MASK (0x7F00)
 
 #define SERIAL_EVENT_ERROR (1 << 1)
 
+#ifndef MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE
+#define MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE 64
+#endif
+
 /**
  * @defgroup SerialTXEvents Serial TX Events Macros
  *
@@ -54,6 +60,7 @@
 #define SERIAL_EVENT_RX_PARITY_ERROR    (1 << (SERIAL_EVENT_RX_SHIFT + 3))
 #define SERIAL_EVENT_RX_OVERFLOW        (1 << (SERIAL_EVENT_RX_SHIFT + 4))
 #define SERIAL_EVENT_RX_CHARACTER_MATCH (1 << (SERIAL_EVENT_RX_SHIFT + 5))
+#define SERIAL_EVENT_RX_IDLE            (1 << (SERIAL_EVENT_RX_SHIFT + 6)) /**< RX line went idle, only reported to ::serial_rx_stream_start handlers */
 #define SERIAL_EVENT_RX_ALL             (SERIAL_EVENT_RX_OVERFLOW | SERIAL_EVENT_RX_PARITY_ERROR | \
                                          SERIAL_EVENT_RX_FRAMING_ERROR | SERIAL_EVENT_RX_OVERRUN_ERROR | \
                                          SERIAL_EVENT_RX_COMPLETE | SERIAL_EVENT_RX_CHARACTER_MATCH)
@@ -86,6 +93,24 @@ typedef enum {
 typedef void (*uart_irq_handler)(uint32_t id, SerialIrq event);
 
 #if DEVICE_SERIAL_ASYNCH
+/** Serial RX stream handler
+ *
+ * @param id    The id given to ::serial_rx_stream_start
+ * @param head  Position in the ring buffer after the last received byte
+ * @param event The logical OR of SERIAL_EVENT_RX_IDLE, SERIAL_EVENT_RX_COMPLETE and RX error events
+ */
+typedef void (*serial_rx_stream_handler)(uint32_t id, size_t head, int event);
+
+/** Serial RX stream state
+ */
+typedef struct {
+    uint8_t *buffer;                  /**< Ring buffer, NULL when the stream is stopped */
+    size_t size;                      /**< Size of the ring buffer in bytes */
+    size_t head;                      /**< Position after the last received byte */
+    serial_rx_stream_handler handler; /**< Stream handler */
+    uint32_t id;                      /**< Id passed to the handler */
+} serial_rx_stream_t;
+
 /** Asynch serial HAL structure
  */
 typedef struct {
@@ -94,6 +119,7 @@ typedef struct {
     struct buffer_s rx_buff; /**< RX buffer */
     uint8_t char_match;      /**< Character to be matched */
     uint8_t char_found;      /**< State of the matched character */
+    serial_rx_stream_t rx_stream; /**< RX stream state */
 } serial_t;
 
 #else
@@ -120,6 +146,75 @@ typedef struct {
     int rx_flow_function;
 } serial_fc_pinmap_t;
 
+typedef struct {
+    int peripheral;
+    PinName de_pin;
+    int de_function;
+} serial_de_pinmap_t;
+
+/** RS-485 driver enable configuration
+ */
+typedef struct {
+    bool de_active_high;    /**< DE is high while transmitting, low otherwise */
+    uint16_t assert_time;   /**< Time from DE assertion to the start bit, in 1/16 bit times */
+    uint16_t deassert_time; /**< Time from the end of the last stop bit to DE deassertion, in 1/16 bit times */
+} serial_rs485_config_t;
+
+/**
+ * @defgroup SerialOversampling Serial Oversampling Macros
+ *
+ * @{
+ */
+#define SERIAL_OVERSAMPLING_16 (1 << 0) /**< 16 samples per bit */
+#define SERIAL_OVERSAMPLING_8  (1 << 1) /**< 8 samples per bit, for twice the baud rate */
+/**@}*/
+
+/** Serial capabilities
+ */
+typedef struct {
+    uint16_t rx_fifo_size;   /**< Number of bytes the RX hardware FIFO holds, 1 without FIFO */
+    uint16_t tx_fifo_size;   /**< Number of bytes the TX hardware FIFO holds, 1 without FIFO */
+    bool rx_timeout;         /**< RX character timeout interrupt supported */
+    uint16_t rx_timeout_max; /**< Longest RX character timeout, in character times */
+    uint32_t baud_max;       /**< Highest baud rate with the current clock, 0 if unknown */
+    uint8_t oversampling;    /**< Logical OR of the SERIAL_OVERSAMPLING_ modes available */
+    uint8_t divisor_frac_bits; /**< Number of fractional bits of the baud rate divisor */
+} serial_capabilities_t;
+
+/** Serial TX FIFO structure
+ */
+typedef struct {
+    serial_t *serial;                                     /**< Serial object the FIFO drains to */
+    uint8_t buffer[MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE]; /**< FIFO storage */
+    size_t head;                                          /**< Write position */
+    size_t count;                                         /**< Number of queued bytes */
+    size_t high_water;                                    /**< Highest number of queued bytes */
+    uart_irq_handler rx_handler;                          /**< Handler for the RX IRQ */
+    uint32_t rx_id;                                       /**< Id passed to the RX handler */
+} serial_tx_fifo_t;
+
+/** RS-485 driver enable in software, for peripherals without hardware support
+ */
+typedef struct {
+    serial_t *serial;        /**< Serial object to write to */
+    gpio_t de;               /**< Driver enable pin */
+    int de_active;           /**< Level of the driver enable pin while transmitting */
+    uint32_t assert_ns;      /**< Time from DE assertion to the first byte written */
+    uint32_t deassert_ns;    /**< Time from the end of the last byte to DE deassertion */
+    uint32_t char_ns;        /**< Time to send the longest character */
+    uint32_t fifo_chars;     /**< Characters the hardware FIFO and shift register hold */
+} serial_rs485_sw_t;
+
+#if DEVICE_CLOCK_SCALING
+/** Baud rate kept across clock changes
+ */
+typedef struct {
+    hal_clock_notifier_t notifier;                        /**< Clock change notifier */
+    serial_t *serial;                                     /**< Serial object to program again */
+    int baudrate;                                         /**< Baud rate to set after each change */
+} serial_clock_follower_t;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -181,6 +276,28 @@ extern "C" {
  * * ::serial_rx_abort_asynch aborts the ongoing RX transaction.
  * * ::serial_rx_abort_asynch disables the enabled interupt for RX.
  * * ::serial_rx_abort_asynch flushes the TX hardware buffer if RX FIFO is used.
+ * * ::serial_rx_stream_start writes received bytes to the ring buffer, wrapping around at its end - TBD (basic test)
+ * * ::serial_rx_stream_start returns -1 if an async RX transfer is active - TBD (basic test)
+ * * Calling ::serial_rx_stream_start while a stream is active restarts the stream with the new buffer - TBD (basic test)
+ * * The handler given to ::serial_rx_stream_start is invoked with SERIAL_EVENT_RX_IDLE when the line goes idle - TBD (basic test)
+ * * ::serial_rx_stream_head returns the position after the last received byte - TBD (basic test)
+ * * ::serial_rx_stream_stop stops the reception and disables the RX interrupt - TBD (basic test)
+ * * ::serial_get_capabilities fills the given ::serial_capabilities_t - TBD (basic test)
+ * * ::serial_rx_threshold_set makes `RxIrq` fire when at least the given number of bytes can be read,
+ * rounded down to a level the hardware supports, and returns that level - TBD (basic test)
+ * * ::serial_tx_threshold_set makes `TxIrq` fire when at least the given number of bytes can be written,
+ * rounded down to a level the hardware supports, and returns that level - TBD (basic test)
+ * * The thresholds are 1 byte after ::serial_init, and on peripherals without hardware FIFO
+ * * ::serial_baud_exact sets the baud rate closest to the one requested, choosing the oversampling
+ * mode with the lowest error, and returns the achieved baud rate and its error - TBD (basic test)
+ * * ::serial_baud_exact returns -1 and keeps the baud rate when the target can't report the achieved
+ * baud rate - TBD (basic test)
+ * * ::serial_set_rs485 makes the peripheral assert the DE pin while it transmits, with the given
+ * assertion and deassertion times, or returns -1 if the peripheral can't drive it - TBD (basic test)
+ * * ::serial_set_rs485 with `de` NC stops driving the DE pin - TBD (basic test)
+ * * ::serial_rs485_sw_write asserts the DE pin from before the first byte to after the last one - TBD (basic test)
+ * * ::serial_rx_timeout_set makes `RxIrq` fire when bytes below the RX threshold stayed in the FIFO
+ * for the given number of character times, and returns -1 if this is not supported - TBD (basic test)
  * * Correct operation guaranteed when interrupt latency is shorter than one packet transfer time (packet_bits / baudrate)
  * if the flow control is not used.
  * * Correct operation guaranteed regardless of interrupt latency if the flow control is used.
@@ -231,6 +348,35 @@ void serial_free(serial_t *obj);
  */
 void serial_baud(serial_t *obj, int baudrate);
 
+/** Configure the baud rate, and report the baud rate achieved
+ *
+ * The oversampling mode with the lowest error is chosen, 16x when both give
+ * the same error for its better noise immunity. Use ::serial_get_capabilities
+ * to know the highest baud rate before requesting it.
+ *
+ * @param obj       The serial object
+ * @param baudrate  The baud rate to be configured
+ * @param error_ppm The error of the achieved baud rate relative to the one
+ *                  requested, in parts per million, may be NULL
+ * @return The baud rate achieved, or -1 if the target can't report it
+ */
+int serial_baud_exact(serial_t *obj, int baudrate, int32_t *error_ppm);
+
+/** Compute a baud rate divisor, rounded to the nearest
+ *
+ * Helper for the implementations of ::serial_baud_exact, for peripherals
+ * dividing their clock by oversampling * divisor, with `frac_bits`
+ * fractional bits in the divisor.
+ *
+ * @param clock_hz     Frequency of the peripheral clock
+ * @param baudrate     The baud rate requested
+ * @param oversampling Number of samples per bit, 8 or 16
+ * @param frac_bits    Number of fractional bits of the divisor
+ * @param achieved     The baud rate achieved with the divisor, may be NULL
+ * @return The divisor, in fixed point with `frac_bits` fractional bits
+ */
+uint32_t serial_baud_divisor(uint32_t clock_hz, uint32_t baudrate, uint32_t oversampling, uint32_t frac_bits, uint32_t *achieved);
+
 /** Configure the format. Set the number of bits, parity and the number of stop bits
  *
  * @param obj       The serial object
@@ -329,6 +475,67 @@ void serial_set_flow_control(serial_t *obj, FlowControl type, PinName rxflow, Pi
 void serial_set_flow_control_direct(serial_t *obj, FlowControl type, const serial_fc_pinmap_t *pinmap);
 #endif
 
+#if DEVICE_SERIAL_RS485
+/** Configure the RS-485 driver enable in the hardware
+ *
+ * The peripheral drives the transceiver driver enable pin around each
+ * transmission, so there is no interrupt to take and no turnaround latency.
+ * Use ::serial_rs485_sw_init when this returns -1.
+ *
+ * @param obj    The serial object
+ * @param de     The driver enable pin, or NC to stop driving it
+ * @param config The driver enable configuration, ignored when `de` is NC
+ * @return 0 on success, -1 if the peripheral can't drive the pin
+ */
+int serial_set_rs485(serial_t *obj, PinName de, const serial_rs485_config_t *config);
+
+/** Configure the RS-485 driver enable in the hardware
+ *
+ * @param obj    The serial object
+ * @param pinmap Pointer to structure which holds static pinmap
+ * @param config The driver enable configuration
+ * @return 0 on success, -1 if the peripheral can't drive the pin
+ */
+int serial_set_rs485_direct(serial_t *obj, const serial_de_pinmap_t *pinmap, const serial_rs485_config_t *config);
+#endif
+
+/** Get the capabilities of the serial hardware FIFOs
+ *
+ * @param obj The serial object
+ * @param cap Capabilities of the serial hardware FIFOs
+ */
+void serial_get_capabilities(serial_t *obj, serial_capabilities_t *cap);
+
+/** Set the RX hardware FIFO trigger level
+ *
+ * Interrupts are taken once per trigger level rather than once per byte.
+ * Enable the RX character timeout with ::serial_rx_timeout_set so that the
+ * bytes below the trigger level at the end of a message are reported too.
+ *
+ * @param obj   The serial object
+ * @param level Number of bytes to read at each `RxIrq`, from 1 to rx_fifo_size
+ * @return The level set, the highest one the hardware supports up to `level`
+ */
+size_t serial_rx_threshold_set(serial_t *obj, size_t level);
+
+/** Set the TX hardware FIFO trigger level
+ *
+ * @param obj   The serial object
+ * @param level Number of bytes to write at each `TxIrq`, from 1 to tx_fifo_size
+ * @return The level set, the highest one the hardware supports up to `level`
+ */
+size_t serial_tx_threshold_set(serial_t *obj, size_t level);
+
+/** Set the RX character timeout
+ *
+ * @param obj        The serial object
+ * @param char_times Idle time after the last byte received before `RxIrq` fires,
+ *                   in character times, from 1 to rx_timeout_max, or 0 to disable
+ *                   the timeout
+ * @return 0 on success, -1 if the timeout is not supported
+ */
+int serial_rx_timeout_set(serial_t *obj, uint32_t char_times);
+
 /** Get the pins that support Serial TX
  *
  * Return a PinMap array of pins that support Serial TX. The
@@ -367,6 +574,125 @@ const PinMap *serial_cts_pinmap(void);
 const PinMap *serial_rts_pinmap(void);
 #endif
 
+#if DEVICE_SERIAL_RS485
+/** Get the pins that support Serial RS-485 driver enable
+ *
+ * Return a PinMap array of pins that support Serial RS-485 driver enable. The
+ * array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *serial_de_pinmap(void);
+#endif
+
+/** Initialize a TX FIFO for the serial object
+ *
+ * Data written to the FIFO is sent by the TX IRQ, so writers do not wait for
+ * the serial peripheral. The FIFO takes over the handler set by
+ * ::serial_irq_handler and forwards RX IRQs to `rx_handler`.
+ * The FIFO size is set with MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE.
+ *
+ * @param fifo       The TX FIFO to initialize
+ * @param obj        The initialized serial object
+ * @param rx_handler The handler for RX IRQs, or NULL
+ * @param rx_id      The id passed to `rx_handler`
+ */
+void serial_tx_fifo_init(serial_tx_fifo_t *fifo, serial_t *obj, uart_irq_handler rx_handler, uint32_t rx_id);
+
+/** Queue data to the TX FIFO
+ *
+ * Does not block. Data which does not fit to the FIFO is not queued.
+ * Safe to call from interrupts.
+ *
+ * @param fifo   The TX FIFO
+ * @param data   The data to send
+ * @param length The number of bytes to send
+ * @return The number of bytes queued
+ */
+size_t serial_tx_fifo_write(serial_tx_fifo_t *fifo, const void *data, size_t length);
+
+/** Get the number of bytes waiting in the TX FIFO
+ *
+ * @param fifo The TX FIFO
+ * @return The number of queued bytes
+ */
+size_t serial_tx_fifo_count(serial_tx_fifo_t *fifo);
+
+/** Get the highest number of bytes queued in the TX FIFO since it was initialized
+ *
+ * @param fifo The TX FIFO
+ * @return The high water mark in bytes
+ */
+size_t serial_tx_fifo_high_water(serial_tx_fifo_t *fifo);
+
+/** Wait until the TX FIFO is empty
+ *
+ * Must not be called from interrupts.
+ *
+ * @param fifo The TX FIFO
+ */
+void serial_tx_fifo_flush(serial_tx_fifo_t *fifo);
+
+/** Stop the TX FIFO
+ *
+ * Disables the TX IRQ and discards the queued data.
+ *
+ * @param fifo The TX FIFO
+ */
+void serial_tx_fifo_free(serial_tx_fifo_t *fifo);
+
+/** Initialize the RS-485 driver enable in software
+ *
+ * For peripherals that can't drive the DE pin, see ::serial_set_rs485. The
+ * pin is driven around ::serial_rs485_sw_write, which waits for the hardware
+ * FIFO to drain as the serial API can't tell when the last stop bit is sent,
+ * so the turnaround is longer than with the hardware. Call it again after
+ * changing the baud rate.
+ *
+ * @param sw       Storage for the driver enable state
+ * @param obj      The serial object
+ * @param de       The driver enable pin
+ * @param baudrate The baud rate of the serial object
+ * @param config   The driver enable configuration
+ */
+void serial_rs485_sw_init(serial_rs485_sw_t *sw, serial_t *obj, PinName de, int baudrate, const serial_rs485_config_t *config);
+
+/** Write data with the RS-485 driver enabled
+ *
+ * This is a blocking call, returning after DE is deasserted.
+ *
+ * @param sw     The driver enable state
+ * @param data   The data to be sent
+ * @param length The number of bytes to send
+ */
+void serial_rs485_sw_write(serial_rs485_sw_t *sw, const void *data, size_t length);
+
+/** Release the driver enable pin
+ *
+ * @param sw The driver enable state
+ */
+void serial_rs485_sw_free(serial_rs485_sw_t *sw);
+
+#if DEVICE_CLOCK_SCALING
+/** Set the baud rate, and set it again after each clock change
+ *
+ * Serial drivers call this instead of ::serial_baud so that the divider is
+ * derived again from the new peripheral clock. Calling it again with the
+ * same follower changes the baud rate.
+ *
+ * @param follower Storage for the notifier, valid until ::serial_clock_follower_free
+ * @param obj      The serial object
+ * @param baudrate The baud rate to be configured
+ */
+void serial_clock_follower_init(serial_clock_follower_t *follower, serial_t *obj, int baudrate);
+
+/** Stop setting the baud rate after clock changes
+ *
+ * @param follower The follower given to ::serial_clock_follower_init
+ */
+void serial_clock_follower_free(serial_clock_follower_t *follower);
+#endif
+
 #if DEVICE_SERIAL_ASYNCH
 
 /**@}*/
@@ -379,6 +705,9 @@ const PinMap *serial_rts_pinmap(void);
 /** Begin asynchronous TX transfer. The used buffer is specified in the serial object,
  *  tx_buff
  *
+ * @note An implementation using DMA calls hal_dma_tx_prepare() on tx before
+ * starting, so the DMA reads the data written by the CPU. See hal/cache_api.h.
+ *
  * @param obj       The serial object
  * @param tx        The transmit buffer
  * @param tx_length The number of bytes to transmit
@@ -392,6 +721,10 @@ int serial_tx_asynch(serial_t *obj, const void *tx, size_t tx_length, uint8_t tx
 /** Begin asynchronous RX transfer (enable interrupt for data collecting)
  *  The used buffer is specified in the serial object - rx_buff
  *
+ * @note An implementation using DMA calls hal_dma_rx_prepare() on rx before
+ * starting and hal_dma_rx_complete() on the bytes received before reporting
+ * the end of the transfer. See hal/cache_api.h.
+ *
  * @param obj        The serial object
  * @param rx         The receive buffer
  * @param rx_length  The number of bytes to receive
@@ -437,6 +770,42 @@ void serial_tx_abort_asynch(serial_t *obj);
  */
 void serial_rx_abort_asynch(serial_t *obj);
 
+/** Start continuous reception to a ring buffer
+ *
+ * Received bytes are written to the ring buffer one after another, wrapping
+ * around at the end, until ::serial_rx_stream_stop is called. The handler is
+ * called with the position after the last received byte when the line goes
+ * idle (SERIAL_EVENT_RX_IDLE), when the buffer is half full or wraps around
+ * (SERIAL_EVENT_RX_COMPLETE) and on RX errors. The handler must consume the
+ * data before the stream wraps around to it again; unread data is overwritten.
+ *
+ * Targets should implement this with circular DMA and the idle line interrupt.
+ * The default implementation receives one byte per RX interrupt through
+ * ::serial_irq_handler, replacing the handler registered there, and reports
+ * SERIAL_EVENT_RX_IDLE as soon as the receive register is empty.
+ *
+ * @param obj     The serial object
+ * @param ring    The ring buffer
+ * @param size    Size of the ring buffer in bytes, at least 2
+ * @param handler The stream handler, called from interrupt context
+ * @param id      The id passed to the handler
+ * @return 0 if the stream was started, -1 if an async RX transfer is active
+ */
+int serial_rx_stream_start(serial_t *obj, void *ring, size_t size, serial_rx_stream_handler handler, uint32_t id);
+
+/** Get the position after the last byte received by the RX stream
+ *
+ * @param obj The serial object
+ * @return The position in the ring buffer
+ */
+size_t serial_rx_stream_head(serial_t *obj);
+
+/** Stop the reception started by ::serial_rx_stream_start
+ *
+ * @param obj The serial object
+ */
+void serial_rx_stream_stop(serial_t *obj);
+
 /**@}*/
 
 #endif
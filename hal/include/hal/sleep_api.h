@@ -66,6 +66,8 @@ extern "C" {
  *
  * The wake-up time shall be less than 10 us.
  *
+ * It is called inside critical sections through hal_critical_section_sleep(),
+ * so it must not enter a critical section itself.
  */
 void hal_sleep(void);
 
@@ -78,6 +80,9 @@ void hal_sleep(void);
  * The processor can only be woken up by low power ticker, RTC, an external interrupt on a pin or a watchdog timer.
  *
  * The wake-up time shall be less than 10 ms.
+ *
+ * It is called inside critical sections through hal_critical_section_sleep(),
+ * so it must not enter a critical section itself.
  */
 void hal_deepsleep(void);
 
@@ -22,6 +22,8 @@
 
 #include "device.h"
 #include "pinmap.h"
+#include "gpio_api.h"
+#include "hal/clock_api.h"
 #include "hal/utils/buffer.h"
 
 #if DEVICE_SPI
@@ -36,13 +38,109 @@
 #define SPI_FILL_WORD         (0xFFFF)
 #define SPI_FILL_CHAR         (0xFF)
 
+/** Segment of a scatter-gather SPI transfer
+ */
+typedef struct {
+    void   *buffer; /**< Pointer to the data of the segment */
+    size_t  length; /**< Length of the segment in bytes */
+} spi_iov_t;
+
+#ifndef SPI_DEVICE_CONFIG_REGS
+/** Number of register values a target caches in ::spi_device_config_t */
+#define SPI_DEVICE_CONFIG_REGS 4
+#endif
+
+/** Configuration of a device on a shared SPI bus, see ::spi_prepare_config
+ */
+typedef struct {
+    int      bits;  /**< Number of bits per SPI frame, see ::spi_format */
+    int      mode;  /**< SPI mode, see ::spi_format */
+    int      slave; /**< Zero for master mode or non-zero for slave mode */
+    int      hz;    /**< Bus frequency, see ::spi_frequency */
+    uint32_t regs[SPI_DEVICE_CONFIG_REGS]; /**< Target specific register values */
+} spi_device_config_t;
+
 #if DEVICE_SPI_ASYNCH
+/** Progress of an asynchronous scatter-gather SPI transfer
+ */
+typedef struct {
+    const spi_iov_t *tx;       /**< Remaining tx segments */
+    size_t           tx_count; /**< Number of remaining tx segments */
+    size_t           tx_pos;   /**< Bytes of the first tx segment already transferred */
+    const spi_iov_t *rx;       /**< Remaining rx segments */
+    size_t           rx_count; /**< Number of remaining rx segments */
+    size_t           rx_pos;   /**< Bytes of the first rx segment already transferred */
+    size_t           length;   /**< Length of the part in progress */
+    uint8_t          bit_width; /**< The bit width of buffer words */
+    uint32_t         handler;  /**< SPI interrupt handler */
+    uint32_t         event;    /**< The logical OR of events to be registered */
+} spi_iov_state_t;
+
+typedef struct spi_transaction_s spi_transaction_t;
+
+/** Descriptor of a queued SPI transaction
+ *
+ * The descriptor must stay valid until its callback has been called.
+ */
+struct spi_transaction_s {
+    gpio_t            *cs;        /**< Chip select output, driven low during the transaction, or NULL */
+    int                bits;      /**< Number of bits per SPI frame, see ::spi_format */
+    int                mode;      /**< SPI mode, see ::spi_format */
+    int                hz;        /**< Bus frequency, see ::spi_frequency */
+    const void        *tx;        /**< The transmit buffer */
+    size_t             tx_length; /**< The number of bytes to transmit */
+    void              *rx;        /**< The receive buffer */
+    size_t             rx_length; /**< The number of bytes to receive */
+    uint8_t            bit_width; /**< The bit width of buffer words */
+    uint32_t           event;     /**< The logical OR of events to be reported */
+    /** Called from the interrupt handler when the transaction ends, with the events met */
+    void (*callback)(spi_transaction_t *transaction, uint32_t event);
+    void              *context;   /**< User data, not used by the HAL */
+    spi_transaction_t *next;      /**< Used by the HAL to link queued transactions */
+};
+
+/** State of the SPI transaction queue
+ */
+typedef struct {
+    spi_transaction_t *head;    /**< Transaction in progress, followed by the queued ones */
+    spi_transaction_t *tail;    /**< Last queued transaction */
+    uint32_t           handler; /**< SPI interrupt handler */
+    int                bits;    /**< Current number of bits per frame, 0 when not configured */
+    int                mode;    /**< Current SPI mode */
+    int                hz;      /**< Current bus frequency */
+} spi_queue_state_t;
+
+/** SPI slave stream handler
+ *
+ * @param id    The id given to ::spi_slave_stream_start
+ * @param head  Position in the buffers after the last word transferred, half the size or 0
+ * @param event SPI_EVENT_COMPLETE when a half of the buffers has been transferred, or the
+ *              error events which stopped the stream
+ */
+typedef void (*spi_slave_stream_handler)(uint32_t id, size_t head, uint32_t event);
+
+/** State of an SPI slave stream
+ */
+typedef struct {
+    const uint8_t *tx;                 /**< Transmit ring buffer, or NULL */
+    uint8_t *rx;                       /**< Receive ring buffer, or NULL */
+    size_t size;                       /**< Size of the ring buffers in bytes, 0 when the stream is stopped */
+    size_t head;                       /**< Position after the last word transferred */
+    uint8_t bit_width;                 /**< The bit width of buffer words */
+    uint32_t handler;                  /**< SPI interrupt handler */
+    spi_slave_stream_handler callback; /**< Stream handler */
+    uint32_t id;                       /**< Id passed to the stream handler */
+} spi_slave_stream_t;
+
 /** Asynch SPI HAL structure
  */
 typedef struct {
     struct spi_s spi;        /**< Target specific SPI structure */
     struct buffer_s tx_buff; /**< Tx buffer */
     struct buffer_s rx_buff; /**< Rx buffer */
+    spi_iov_state_t iov;     /**< Scatter-gather transfer state */
+    spi_queue_state_t queue; /**< Transaction queue state */
+    spi_slave_stream_t stream; /**< Slave stream state */
 } spi_t;
 
 #else
@@ -64,6 +162,22 @@ typedef struct {
     int ssel_function;
 } spi_pinmap_t;
 
+/** Hardware chip select behaviour in master mode, see ::spi_cs_config
+ */
+typedef enum {
+    SPI_CS_HOLD,  /**< Chip select stays asserted for the whole transfer */
+    SPI_CS_PULSE, /**< Chip select is deasserted between successive frames */
+} spi_cs_mode_t;
+
+/** Hardware chip select configuration
+ */
+typedef struct {
+    spi_cs_mode_t mode; /**< Behaviour between frames */
+    uint32_t setup_ns;  /**< Minimum delay from the assertion of chip select to the first clock edge */
+    uint32_t hold_ns;   /**< Minimum delay from the last clock edge to the deassertion of chip select */
+    uint32_t idle_ns;   /**< Minimum time chip select stays deasserted, between transfers or frames */
+} spi_cs_config_t;
+
 /**
  * Describes the capabilities of a SPI peripherals
  */
@@ -82,10 +196,23 @@ typedef struct {
     uint8_t     clk_modes; /**< specifies supported modes from spi_mode_t. Each bit represents the corresponding mode. */
     bool        support_slave_mode; /**< If true, the device can handle SPI slave mode using hardware management on the specified ssel pin. */
     bool        hw_cs_handle; /**< If true, in SPI master mode Chip Select can be handled by hardware. */
+    uint8_t     hw_cs_modes; /**< specifies supported modes from spi_cs_mode_t. Each bit represents the corresponding mode. */
+    uint32_t    hw_cs_delay_max_ns; /**< Longest setup, hold and idle delay of the hardware Chip Select, 0 if they cannot be set. */
     bool        async_mode; /**< If true, in async mode is supported. */
     bool        tx_rx_buffers_equal_length; /**< If true, rx and tx buffers must have the same length. */
 } spi_capabilities_t;
 
+#if DEVICE_CLOCK_SCALING
+/**
+ * Frequency kept across clock changes
+ */
+typedef struct {
+    hal_clock_notifier_t notifier; /**< Clock change notifier */
+    spi_t *spi; /**< SPI object to program again */
+    int hz; /**< Frequency to set after each change */
+} spi_clock_follower_t;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -99,6 +226,9 @@ extern "C" {
  * * ::spi_get_capabilities() fills the given `spi_capabilities_t` instance - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_get_capabilities() should consider the `ssel` pin when evaluation the `support_slave_mode` and `hw_cs_handle` capability - TBD (basic test)
  * * ::spi_get_capabilities(): if the given `ssel` pin cannot be managed by hardware, `support_slave_mode` and `hw_cs_handle` should be false - TBD (basic test)
+ * * ::spi_cs_config returns 0 and configures the hardware chip select if the mode is in `hw_cs_modes` and no delay exceeds `hw_cs_delay_max_ns`, -1 otherwise - TBD (basic test)
+ * * Once configured with ::spi_cs_config, the hardware chip select follows the mode and the delays in every master transfer, blocking or not - Verified by ::fpga_spi_test_timing
+ * * Without a call to ::spi_cs_config, the behaviour of the hardware chip select between frames is target specific
  * * At least a symbol width of 8bit must be supported - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * The supported frequency range must include the range [0.2..2] MHz - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_free returns the pins owned by the SPI object to their reset state - Verified by ::fpga_spi_test_init_free
@@ -106,11 +236,17 @@ extern "C" {
  * * ::spi_format configures clock polarity and phase - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_format configures master/slave mode - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common; slave mode - TBD
  * * ::spi_frequency sets the SPI baud rate - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
+ * * ::spi_frequency sets the closest baud rate not above the requested one, within a factor of two - Verified by ::fpga_spi_test_timing
+ * * ::spi_apply_config sets the format and the baud rate given to ::spi_prepare_config - Verified by ::fpga_spi_test_config_switch
  * * ::spi_master_write writes a symbol out in master mode and receives a symbol - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_master_block_write writes `tx_length` words to the bus - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_master_block_write reads `rx_length` words from the bus - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_master_block_write returns the maximum of tx_length and rx_length - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_master_block_write specifies the write_fill which is default data transmitted while performing a read - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
+ * * ::spi_master_block_write_w writes and reads `count` words of `bit_width` bits from the given word buffers - Verified by ::fpga_spi_test_common_no_ss
+ * * ::spi_master_block_write_w sends words with all bits set when tx is NULL - TBD (basic test)
+ * * ::spi_master_transfer_iov writes the concatenation of the tx segments and reads into the concatenation of the rx segments - TBD (basic test)
+ * * ::spi_master_transfer_iov returns the maximum of the total tx and rx lengths - TBD (basic test)
  * * ::spi_get_module returns the SPI module number - TBD (basic test)
  * * ::spi_slave_read returns a received value out of the SPI receive buffer in slave mode - TBD (SPI slave test)
  * * ::spi_slave_read blocks until a value is available - TBD (SPI slave test)
@@ -123,6 +259,9 @@ extern "C" {
  * * ::spi_master_transfer specifies the bit width of buffer words - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * The callback given to ::spi_master_transfer is invoked when the transfer completes (with a success or an error) - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_master_transfer specifies the logical OR of events to be registered - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
+ * * ::spi_master_transfer_iov_asynch transfers the segments like ::spi_master_transfer_iov and reports the events like ::spi_master_transfer, through ::spi_irq_handler_asynch_iov - TBD (basic test)
+ * * ::spi_master_transaction_submit runs the queued transactions in order, each with its own chip select, format and frequency - TBD (basic test)
+ * * The callback of each queued transaction is invoked when the transaction ends - TBD (basic test)
  * * ::spi_irq_handler_asynch reads the received values out of the RX FIFO - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_irq_handler_asynch writes values into the TX FIFO - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
  * * ::spi_irq_handler_asynch checks for transfer termination conditions, such as buffer overflows or transfer complete - Verified by ::fpga_spi_test_common_no_ss and ::fpga_spi_test_common
@@ -137,6 +276,7 @@ extern "C" {
  * * Passing an invalid pointer as `obj` to any function
  * * Passing an invalid pointer as `handler` to ::spi_master_transfer
  * * Calling ::spi_abort while no async transfer is being processed (no transfer or a synchronous transfer)
+ * * Calling ::spi_cs_config while a transfer is in progress
  *
  * @{
  */
@@ -209,6 +349,71 @@ void spi_format(spi_t *obj, int bits, int mode, int slave);
  */
 void spi_frequency(spi_t *obj, int hz);
 
+/** Compute the configuration of a device on a shared bus
+ *
+ * The prescaler and the register values for the format and the frequency
+ * are computed once, so that switching to the device with ::spi_apply_config
+ * takes a handful of register writes. The configuration must be prepared
+ * again after a change of the clock of the peripheral.
+ *
+ * The default implementation only records the parameters. Targets override
+ * this function along with ::spi_apply_config, and may define
+ * SPI_DEVICE_CONFIG_REGS in their objects.h for the values they cache.
+ *
+ * @param[in]  obj    The SPI object the configuration is applied to
+ * @param[out] config The configuration to compute
+ * @param[in]  bits   The number of bits per frame
+ * @param[in]  mode   The SPI mode (clock polarity, phase, and shift direction)
+ * @param[in]  slave  Zero for master mode or non-zero for slave mode
+ * @param[in]  hz     The baud rate in Hz
+ */
+void spi_prepare_config(spi_t *obj, spi_device_config_t *config, int bits, int mode, int slave, int hz);
+
+/** Apply a configuration computed by ::spi_prepare_config
+ *
+ * The result is the same as calling ::spi_format and ::spi_frequency with the
+ * parameters of the configuration. The default implementation does so.
+ *
+ * @param[in,out] obj    The SPI object to configure
+ * @param[in]     config The configuration to apply
+ */
+void spi_apply_config(spi_t *obj, const spi_device_config_t *config);
+
+/** Configure the hardware chip select
+ *
+ * Selects whether the chip select given to ::spi_init stays asserted for the
+ * whole transfer or pulses between frames, and the delays around it, so that
+ * drivers need not toggle a GPIO around every transaction. The delays are
+ * rounded up to the resolution of the peripheral.
+ *
+ * The default implementation returns -1.
+ *
+ * @param[in,out] obj    The SPI object, initialized with an `ssel` pin
+ * @param[in]     config The chip select configuration
+ * @return 0 on success, -1 if `ssel` is NC or the configuration is not supported
+ */
+int spi_cs_config(spi_t *obj, const spi_cs_config_t *config);
+
+#if DEVICE_CLOCK_SCALING
+/** Set the SPI baud rate, and set it again after each clock change
+ *
+ * SPI drivers call this instead of ::spi_frequency so that the divider is
+ * derived again from the new bus clock. Calling it again with the same
+ * follower changes the frequency.
+ *
+ * @param[out]    follower Storage for the notifier, valid until ::spi_clock_follower_free
+ * @param[in,out] obj      The SPI object to configure
+ * @param[in]     hz       The baud rate in Hz
+ */
+void spi_clock_follower_init(spi_clock_follower_t *follower, spi_t *obj, int hz);
+
+/** Stop setting the SPI baud rate after clock changes
+ *
+ * @param[in] follower The follower given to ::spi_clock_follower_init
+ */
+void spi_clock_follower_free(spi_clock_follower_t *follower);
+#endif
+
 /**@}*/
 /**
  * \defgroup SynchSPI Synchronous SPI Hardware Abstraction Layer
@@ -241,6 +446,50 @@ int  spi_master_write(spi_t *obj, int value);
  */
 int spi_master_block_write(spi_t *obj, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, char write_fill);
 
+/** Write a block of words out in master mode and receive a value per word
+ *
+ *  The buffers hold one word per element, of 8, 16 or 32 bits following
+ *  bit_width, so 16-bit and 32-bit frames are written to the data register
+ *  without packing them into bytes. The SPI format must have been set to a
+ *  frame size of at most bit_width bits.
+ *
+ *  The default implementation calls ::spi_master_write for every word.
+ *  Targets with FIFO packing, where a single data register access transfers
+ *  several frames, should override it.
+ *
+ * @param[in] obj       The SPI peripheral to use for sending
+ * @param[in] tx        Words to write to the device, or NULL to send words with all bits set
+ * @param[in] rx        Buffer for the words read from the device, or NULL to discard them
+ * @param[in] count     Number of words to write and read
+ * @param[in] bit_width Width of the buffer elements in bits, 8, 16 or 32
+ * @returns
+ *      The number of words written and read from the device.
+ */
+int spi_master_block_write_w(spi_t *obj, const void *tx, void *rx, size_t count, uint8_t bit_width);
+
+/** Write and read scattered buffers in master mode as one transfer
+ *
+ *  The bytes of the tx segments are sent one after another, and the
+ *  received bytes are stored to the rx segments one after another, without
+ *  copying them to an intermediate buffer. The total number of bytes sent
+ *  and received will be the maximum of the total tx and rx lengths. The
+ *  bytes written will be padded with the value 0xff.
+ *
+ *  The default implementation calls ::spi_master_block_write for every
+ *  contiguous part of the segments. Targets which drive chip select in
+ *  hardware should override it so that chip select stays asserted.
+ *
+ * @param[in] obj  The SPI peripheral to use for sending
+ * @param[in] tx   Array of segments to write to the device, may be NULL if ntx is zero
+ * @param[in] ntx  Number of tx segments
+ * @param[in] rx   Array of segments to read from the device, may be NULL if nrx is zero
+ * @param[in] nrx  Number of rx segments
+ * @returns
+ *      The number of bytes written and read from the device. This is
+ *      maximum of the total tx and rx lengths.
+ */
+int spi_master_transfer_iov(spi_t *obj, const spi_iov_t *tx, size_t ntx, spi_iov_t *rx, size_t nrx);
+
 /** Check if a value is available to read
  *
  * @param[in] obj The SPI peripheral to check
@@ -359,6 +608,11 @@ const PinMap *spi_slave_cs_pinmap(void);
  */
 
 /** Begin the SPI transfer. Buffer pointers and lengths are specified in tx_buff and rx_buff
+ *
+ * @note An implementation using DMA keeps the buffers coherent with the data
+ * cache: hal_dma_tx_prepare() on tx and hal_dma_rx_prepare() on rx before
+ * starting, then hal_dma_rx_complete() on rx before reporting
+ * SPI_EVENT_COMPLETE. See hal/cache_api.h.
  *
  * @param[in] obj       The SPI object that holds the transfer information
  * @param[in] tx        The transmit buffer
@@ -371,6 +625,136 @@ const PinMap *spi_slave_cs_pinmap(void);
  */
 void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event);
 
+/** Begin the SPI transfer of scattered buffers
+ *
+ * Transfers the segments like ::spi_master_transfer_iov without blocking.
+ * The segment arrays and buffers must stay valid until the transfer completes.
+ * The handler must call ::spi_irq_handler_asynch_iov instead of ::spi_irq_handler_asynch.
+ *
+ * The default implementation runs ::spi_master_transfer for every contiguous
+ * part of the segments. Targets which support linked DMA descriptors or drive
+ * chip select in hardware should override it.
+ *
+ * @param[in] obj       The SPI object that holds the transfer information
+ * @param[in] tx        Array of segments to transmit, the lengths are in bytes
+ * @param[in] ntx       Number of tx segments
+ * @param[in] rx        Array of segments to receive to, the lengths are in bytes
+ * @param[in] nrx       Number of rx segments
+ * @param[in] bit_width The bit width of buffer words
+ * @param[in] event     The logical OR of events to be registered
+ * @param[in] handler   SPI interrupt handler
+ */
+void spi_master_transfer_iov_asynch(spi_t *obj, const spi_iov_t *tx, size_t ntx, spi_iov_t *rx, size_t nrx, uint8_t bit_width, uint32_t handler, uint32_t event);
+
+/** The asynchronous IRQ handler of scatter-gather transfers
+ *
+ * Calls ::spi_irq_handler_asynch and starts the next part of the transfer when the previous part completes.
+ * @param[in] obj     The SPI object that holds the transfer information
+ * @return Event flags if a termination condition was met for the whole transfer; otherwise 0.
+ */
+uint32_t spi_irq_handler_asynch_iov(spi_t *obj);
+
+/** Set up the SPI transaction queue
+ *
+ * @param[in] obj The SPI object, initialized in master mode
+ */
+void spi_master_transaction_queue_init(spi_t *obj);
+
+/** Queue SPI transactions
+ *
+ * Appends the transactions to the queue of the SPI object and starts the first one
+ * if the queue was idle. When a transaction ends, the next one is started from the
+ * interrupt handler before the callback of the finished one is called, so the bus
+ * does not wait for the application. Format and frequency are only changed when
+ * they differ from the previous transaction.
+ * The handler must call ::spi_irq_handler_asynch_queue instead of ::spi_irq_handler_asynch.
+ * ::spi_master_transaction_queue_init must be called once after ::spi_init.
+ *
+ * The default implementation runs ::spi_master_transfer for one transaction at a
+ * time. Targets which can chain DMA transfers should override it together with
+ * ::spi_irq_handler_asynch_queue and ::spi_master_transaction_abort.
+ *
+ * @param[in] obj          The SPI object, initialized in master mode
+ * @param[in] transactions Array of transaction descriptors
+ * @param[in] count        Number of descriptors in the array
+ * @param[in] handler      SPI interrupt handler
+ */
+void spi_master_transaction_submit(spi_t *obj, spi_transaction_t *transactions, size_t count, uint32_t handler);
+
+/** The asynchronous IRQ handler of queued transactions
+ *
+ * Calls ::spi_irq_handler_asynch, starts the next queued transaction and calls
+ * the callback of the transaction which ended.
+ * @param[in] obj     The SPI object that holds the transaction queue
+ * @return Event flags of the transaction which ended; otherwise 0.
+ */
+uint32_t spi_irq_handler_asynch_queue(spi_t *obj);
+
+/** Abort the transaction in progress and drop the queued ones
+ *
+ * The callbacks of the dropped transactions are not called.
+ * @param obj The SPI peripheral to stop
+ */
+void spi_master_transaction_abort(spi_t *obj);
+
+/** Start streaming in slave mode
+ *
+ * The master clocks the words of the transmit ring buffer out while the words
+ * it sends fill the receive ring buffer, and the stream wraps around at the
+ * end of the buffers until ::spi_slave_stream_stop. The stream handler is
+ * called each time a half of the buffers has been transferred, so the
+ * application processes the received half and refills the transmitted half
+ * while the other half is transferred. The transmit buffer is loaded before
+ * the start.
+ * The SPI object must be configured in slave mode by ::spi_format.
+ * The handler must call ::spi_irq_handler_asynch_stream instead of ::spi_irq_handler_asynch.
+ *
+ * The default implementation runs ::spi_master_transfer for one half at a
+ * time, restarted from the interrupt handler, so words are lost if the
+ * master sends them before the next half is started. Targets with circular
+ * DMA should override it together with ::spi_irq_handler_asynch_stream,
+ * ::spi_slave_stream_head and ::spi_slave_stream_stop.
+ *
+ * @note An implementation using DMA calls hal_dma_rx_complete() on the
+ * received half before calling the stream handler. The application calls
+ * hal_dma_tx_prepare() on a transmit half it has refilled. See hal/cache_api.h.
+ *
+ * @param[in] obj       The SPI object, initialized in slave mode
+ * @param[in] tx        Transmit ring buffer, or NULL to send the fill word
+ * @param[in] rx        Receive ring buffer, or NULL to discard the received words
+ * @param[in] size      Size of each ring buffer in bytes, a multiple of two words
+ * @param[in] bit_width The bit width of buffer words
+ * @param[in] handler   SPI interrupt handler
+ * @param[in] callback  Stream handler
+ * @param[in] id        Id passed to the stream handler
+ * @return 0 on success, -1 if a transfer is active or the size is not a multiple of two words
+ */
+int spi_slave_stream_start(spi_t *obj, const void *tx, void *rx, size_t size, uint8_t bit_width, uint32_t handler,
+                           spi_slave_stream_handler callback, uint32_t id);
+
+/** The asynchronous IRQ handler of slave streams
+ *
+ * Calls ::spi_irq_handler_asynch, starts the transfer of the next half and
+ * calls the stream handler.
+ * @param[in] obj     The SPI object that holds the stream
+ * @return The error events which stopped the stream; otherwise 0.
+ */
+uint32_t spi_irq_handler_asynch_stream(spi_t *obj);
+
+/** Get the position of a slave stream
+ *
+ * @param[in] obj The SPI object that holds the stream
+ * @return Position in the buffers after the last word transferred
+ */
+size_t spi_slave_stream_head(spi_t *obj);
+
+/** Stop a slave stream
+ *
+ * The stream handler is not called after this returns.
+ * @param[in] obj The SPI object that holds the stream
+ */
+void spi_slave_stream_stop(spi_t *obj);
+
 /** The asynchronous IRQ handler
  *
  * Reads the received values out of the RX FIFO, writes values into the TX FIFO and checks for transfer termination
@@ -31,11 +31,24 @@
 #include "qspi_api.h"
 #include "ospi_api.h"
 #include "can_api.h"
+#include "capture_api.h"
+#include "compare_api.h"
+#include "qei_api.h"
 #include <mstd_cstddef>
 
 #if STATIC_PINMAP_READY
 #include "PeripheralPinMaps.h"
 
+/** Check a pinmap returned by one of the get_*_pinmap() functions
+ *
+ * @param pinmap The pinmap
+ * @return true if all pins were found and map to the same peripheral
+ */
+template <typename PinMapType>
+constexpr bool static_pinmap_is_valid(const PinMapType &pinmap)
+{
+    return pinmap.peripheral != (int) NC;
+}
 
 #if defined(DEVICE_PWMOUT) && defined(PINMAP_PWM)
 MSTD_CONSTEXPR_FN_14 PinMap get_pwm_pinmap(const PinName pin)
@@ -82,6 +95,30 @@ MSTD_CONSTEXPR_FN_14 PinMap get_analogout_pinmap(const PinName pin)
 }
 #endif // DEVICE_ANALOGOUT
 
+#if defined(DEVICE_CAPTURE) && defined(PINMAP_CAPTURE)
+MSTD_CONSTEXPR_FN_14 PinMap get_capture_pinmap(const PinName pin)
+{
+    for (const PinMap &pinmap : PINMAP_CAPTURE) {
+        if (pinmap.pin == pin) {
+            return {pin, pinmap.peripheral, pinmap.function};
+        }
+    }
+    return {NC, (int) NC, (int) NC};
+}
+#endif // DEVICE_CAPTURE
+
+#if defined(DEVICE_COMPARE) && defined(PINMAP_COMPARE)
+MSTD_CONSTEXPR_FN_14 PinMap get_compare_pinmap(const PinName pin)
+{
+    for (const PinMap &pinmap : PINMAP_COMPARE) {
+        if (pinmap.pin == pin) {
+            return {pin, pinmap.peripheral, pinmap.function};
+        }
+    }
+    return {NC, (int) NC, (int) NC};
+}
+#endif // DEVICE_COMPARE
+
 #if defined(DEVICE_I2C) && defined(PINMAP_I2C_SDA) && defined(PINMAP_I2C_SCL)
 MSTD_CONSTEXPR_FN_14 i2c_pinmap_t get_i2c_pinmap(const PinName sda, const PinName scl)
 {
@@ -165,6 +202,18 @@ MSTD_CONSTEXPR_FN_14 serial_fc_pinmap_t get_uart_fc_pinmap(const PinName rxflow,
     return {cts_map->peripheral, cts_map->pin, cts_map->function, rts_map->pin, rts_map->function};
 }
 #endif // DEVICE_SERIAL_FC
+
+#if defined(DEVICE_SERIAL_RS485) && defined(PINMAP_UART_DE)
+MSTD_CONSTEXPR_FN_14 serial_de_pinmap_t get_uart_de_pinmap(const PinName de)
+{
+    for (const PinMap &pinmap : PINMAP_UART_DE) {
+        if (pinmap.pin == de) {
+            return {pinmap.peripheral, pinmap.pin, pinmap.function};
+        }
+    }
+    return {(int) NC, NC, (int) NC};
+}
+#endif // DEVICE_SERIAL_RS485
 #endif // DEVICE_SERIAL
 
 #if defined(DEVICE_SPI) && defined(PINMAP_SPI_MOSI) && defined(PINMAP_SPI_MISO) && defined(PINMAP_SPI_SCLK) && defined(PINMAP_SPI_SSEL)
@@ -239,6 +288,42 @@ MSTD_CONSTEXPR_FN_14 can_pinmap_t get_can_pinmap(const PinName rd, const PinName
 }
 #endif //DEVICE_CAN
 
+#if defined(DEVICE_QEI) && defined(PINMAP_QEI_A) && defined(PINMAP_QEI_B) && defined(PINMAP_QEI_INDEX)
+MSTD_CONSTEXPR_FN_14 qei_pinmap_t get_qei_pinmap(const PinName a, const PinName b, const PinName index)
+{
+    const PinMap *a_map = nullptr;
+    for (const PinMap &pinmap : PINMAP_QEI_A) {
+        if (pinmap.pin == a) {
+            a_map = &pinmap;
+            break;
+        }
+    }
+
+    const PinMap *b_map = nullptr;
+    for (const PinMap &pinmap : PINMAP_QEI_B) {
+        if (pinmap.pin == b) {
+            b_map = &pinmap;
+            break;
+        }
+    }
+
+    const PinMap *index_map = nullptr;
+    for (const PinMap &pinmap : PINMAP_QEI_INDEX) {
+        if (pinmap.pin == index) {
+            index_map = &pinmap;
+            break;
+        }
+    }
+
+    if ((!a_map || !b_map || !index_map) || (a_map->peripheral != b_map->peripheral) ||
+            (index_map->pin != NC && a_map->peripheral != index_map->peripheral)) {
+        return {(int) NC, NC, (int) NC, NC, (int) NC, NC, (int) NC};
+    }
+
+    return {a_map->peripheral, a_map->pin, a_map->function, b_map->pin, b_map->function, index_map->pin, index_map->function};
+}
+#endif //DEVICE_QEI
+
 #if defined(DEVICE_QSPI) && defined(PINMAP_QSPI_DATA0) && defined(PINMAP_QSPI_DATA1) && defined(PINMAP_QSPI_DATA2) && defined(PINMAP_QSPI_DATA3) && defined(PINMAP_QSPI_SCLK) && defined(PINMAP_QSPI_SSEL)
 MSTD_CONSTEXPR_FN_14 qspi_pinmap_t get_qspi_pinmap(const PinName data0, const PinName data1, const PinName data2, const PinName data3, const PinName sclk, const PinName ssel)
 {
@@ -400,6 +485,13 @@ MSTD_CONSTEXPR_FN_14 ospi_pinmap_t get_ospi_pinmap(const PinName data0, const Pi
 
 #else // STATIC_PINMAP_READY
 
+/* Without the target pin map tables the peripheral can only be resolved at run time. */
+template <typename PinMapType>
+constexpr bool static_pinmap_is_valid(const PinMapType &)
+{
+    return true;
+}
+
 #if DEVICE_PWMOUT
 MSTD_CONSTEXPR_FN_14 PinMap get_pwm_pinmap(const PinName pin)
 {
@@ -421,6 +513,20 @@ MSTD_CONSTEXPR_FN_14 PinMap get_analogout_pinmap(const PinName pin)
 }
 #endif // DEVICE_ANALOGOUT
 
+#if DEVICE_CAPTURE
+MSTD_CONSTEXPR_FN_14 PinMap get_capture_pinmap(const PinName pin)
+{
+    return {pin, (int) NC, (int) NC};
+}
+#endif // DEVICE_CAPTURE
+
+#if DEVICE_COMPARE
+MSTD_CONSTEXPR_FN_14 PinMap get_compare_pinmap(const PinName pin)
+{
+    return {pin, (int) NC, (int) NC};
+}
+#endif // DEVICE_COMPARE
+
 #if DEVICE_I2C
 MSTD_CONSTEXPR_FN_14 i2c_pinmap_t get_i2c_pinmap(const PinName sda, const PinName scl)
 {
@@ -440,6 +546,13 @@ MSTD_CONSTEXPR_FN_14 serial_fc_pinmap_t get_uart_fc_pinmap(const PinName rxflow,
     return {(int) NC, txflow, (int) NC, rxflow, (int) NC};
 }
 #endif // DEVICE_SERIAL_FC
+
+#if DEVICE_SERIAL_RS485
+MSTD_CONSTEXPR_FN_14 serial_de_pinmap_t get_uart_de_pinmap(const PinName de)
+{
+    return {(int) NC, de, (int) NC};
+}
+#endif // DEVICE_SERIAL_RS485
 #endif // DEVICE_SERIAL
 
 #if DEVICE_SPI
@@ -456,6 +569,13 @@ MSTD_CONSTEXPR_FN_14 can_pinmap_t get_can_pinmap(const PinName rd, const PinName
 }
 #endif //DEVICE_CAN
 
+#if DEVICE_QEI
+MSTD_CONSTEXPR_FN_14 qei_pinmap_t get_qei_pinmap(const PinName a, const PinName b, const PinName index)
+{
+    return {(int) NC, a, (int) NC, b, (int) NC, index, (int) NC};
+}
+#endif //DEVICE_QEI
+
 #if DEVICE_QSPI
 MSTD_CONSTEXPR_FN_14 qspi_pinmap_t get_qspi_pinmap(const PinName data0, const PinName data1, const PinName data2, const PinName data3, const PinName sclk, const PinName ssel)
 {
@@ -472,4 +592,24 @@ MSTD_CONSTEXPR_FN_14 ospi_pinmap_t get_ospi_pinmap(const PinName data0, const Pi
 
 #endif // STATIC_PINMAP_READY
 
+#if __cplusplus >= 201402L
+/** Fail the build if a constexpr pinmap is invalid
+ *
+ * Example:
+ * @code
+ * constexpr PinMap pwm_pinmap = get_pwm_pinmap(D9);
+ * STATIC_PINMAP_ASSERT(pwm_pinmap);
+ * pwmout_init_direct(&pwm, &pwm_pinmap);
+ * @endcode
+ *
+ * When every peripheral is initialized this way, nothing references the PinMap tables
+ * at run time and the linker drops them along with the pinmap_peripheral()/pinmap_function()
+ * searches.
+ *
+ * @param pinmap A constexpr pinmap returned by one of the get_*_pinmap() functions
+ */
+#define STATIC_PINMAP_ASSERT(pinmap) \
+    static_assert(static_pinmap_is_valid(pinmap), "Pins are not available or do not map to a single peripheral")
+#endif
+
 #endif // STATIC_PINMAP_H
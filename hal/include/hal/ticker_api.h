@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "device.h"
 
 /**
@@ -38,16 +39,87 @@ typedef uint32_t timestamp_t;
  */
 typedef uint64_t us_timestamp_t;
 
+/* Select the data structure used to store the events of a ticker queue.
+ *
+ * By default events are kept in a linked list sorted by timestamp: insertion
+ * is O(n) but the structure is small and dispatch is O(1).
+ * If MBED_CONF_TARGET_TICKER_QUEUE_HEAP is set, events are kept in a pairing
+ * heap instead: insertion is O(1), removal and dispatch are O(log n) amortized.
+ * This bounds the time spent in critical sections when many events are queued
+ * on the same ticker. In that mode, the dispatch order of events sharing the
+ * same timestamp is unspecified.
+ */
+#ifndef MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+#define MBED_CONF_TARGET_TICKER_QUEUE_HEAP 0
+#endif
+
+/* Enable the per event slack used to coalesce ticker interrupts.
+ *
+ * When set, each event records how long its dispatch may be delayed. The
+ * interrupt is then scheduled at the latest time that satisfies all the events
+ * it covers, so events with overlapping windows are dispatched by a single
+ * interrupt. This adds 4 bytes to ticker_event_t and 8 bytes to
+ * ticker_event_queue_t.
+ */
+#ifndef MBED_CONF_TARGET_TICKER_EVENT_SLACK
+#define MBED_CONF_TARGET_TICKER_EVENT_SLACK 0
+#endif
+
+/* Record statistics of each ticker queue, see ticker_get_stats().
+ *
+ * This adds 32 bytes to ticker_event_queue_t and a few instructions to the
+ * insertion, removal and dispatch of events.
+ */
+#ifndef MBED_CONF_TARGET_TICKER_STATS
+#define MBED_CONF_TARGET_TICKER_STATS 0
+#endif
+
+/* Call the event handlers of a ticker with interrupts enabled.
+ *
+ * When set, ticker_irq_handler() takes up to
+ * MBED_CONF_TARGET_TICKER_DISPATCH_BATCH expired events out of the queue in
+ * a critical section, then leaves it to call their handlers, so the time
+ * spent with interrupts disabled no longer depends on the length of the
+ * handlers. An event removed while its batch is being dispatched may still
+ * have its handler called once.
+ */
+#ifndef MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH
+#define MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH 0
+#endif
+
+#ifndef MBED_CONF_TARGET_TICKER_DISPATCH_BATCH
+#define MBED_CONF_TARGET_TICKER_DISPATCH_BATCH 8
+#endif
+
 /** Ticker's event structure
+ *
+ * @note With MBED_CONF_TARGET_TICKER_QUEUE_HEAP, an event must be zero
+ * initialized before being passed to ticker_remove_event() if it has never
+ * been inserted.
  */
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
-    struct ticker_event_s *next;      /**< Next event in the queue */
+    uint32_t               period;    /**< Period in us of a periodic event, 0 for a single event */
+    struct ticker_event_s *next;      /**< Next event in the queue, or next sibling in the heap */
+#if MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+    struct ticker_event_s *child;     /**< First child in the heap */
+    struct ticker_event_s *prev;      /**< Parent or previous sibling in the heap */
+#endif
+#if MBED_CONF_TARGET_TICKER_EVENT_SLACK
+    uint32_t               slack;     /**< Time in us the event dispatch may be delayed by */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
 
+/** Id of events which only wake the core up
+ *
+ * They are removed from the queue when they are due, without calling the
+ * event handler. The id must not be used by other events.
+ */
+#define TICKER_WAKEUP_ID 0xFFFFFFFFUL
+
 /** Information about the ticker implementation
  */
 typedef struct {
@@ -56,7 +128,16 @@ typedef struct {
 } ticker_info_t;
 
 
+/** Maximum number of extra compare channels of a ticker used by the common layer */
+#define TICKER_MAX_COMPARE_CHANNELS 3
+
 /** Ticker's interface structure - required API for a ticker
+ *
+ * A ticker whose timer has several compare channels can set
+ * set_interrupt_channels and compare_channels. The channel used by
+ * set_interrupt is then set for the first event of the queue, and the extra
+ * channels for the following ones, so close events are signalled without the
+ * interrupt being set again in between.
  */
 typedef struct {
     void (*init)(void);                           /**< Init function */
@@ -68,11 +149,19 @@ typedef struct {
     void (*free)(void);                           /**< Disable function */
     const ticker_info_t *(*get_info)(void);       /**< Return info about this ticker's implementation */
     bool runs_in_deep_sleep;                      /**< Whether ticker operates in deep sleep */
+    /** Set the interrupt of the first count extra compare channels, which
+     * fire as the one of set_interrupt, disable the other extra channels.
+     * Optional, clear_interrupt and disable_interrupt apply to all the
+     * channels.
+     */
+    void (*set_interrupt_channels)(const timestamp_t *timestamps, uint32_t count);
+    uint32_t compare_channels;                    /**< Number of extra compare channels, 0 without set_interrupt_channels */
 } ticker_interface_t;
 
 /* Optimizations to avoid run-time computation if custom ticker support is disabled and
  * there is exactly one of USTICKER or LPTICKER available, or if they have the same
- * parameter value(s).
+ * parameter value(s). If both have all their parameters defined but they differ,
+ * the ticker code uses the constants of each ticker without storing them here.
  */
 #define MBED_TICKER_JUST_US      (!MBED_CONF_TARGET_CUSTOM_TICKERS && DEVICE_USTICKER && !DEVICE_LPTICKER)
 #define MBED_TICKER_JUST_LP      (!MBED_CONF_TARGET_CUSTOM_TICKERS && DEVICE_LPTICKER && !DEVICE_USTICKER)
@@ -105,16 +194,33 @@ typedef struct {
 #define MBED_TICKER_CONSTANT_MASK LP_TICKER_MASK
 #endif
 
+#if MBED_CONF_TARGET_TICKER_STATS || defined(DOXYGEN_ONLY)
+/** Statistics of a ticker queue
+ */
+typedef struct {
+    uint32_t depth;                 /**< Number of events in the queue */
+    uint32_t max_depth;             /**< Largest number of events in the queue */
+    uint32_t inserts;               /**< Number of events inserted */
+    uint32_t removes;               /**< Number of events removed before their dispatch */
+    uint32_t dispatches;            /**< Number of events dispatched, periodic events once per period */
+    uint32_t max_lateness_us;       /**< Longest time from the timestamp of an event to its dispatch */
+    uint32_t interrupts_scheduled;  /**< Number of times the interrupt was set or fired */
+    uint32_t interrupts;            /**< Number of calls to ticker_irq_handler */
+} ticker_stats_t;
+#endif
+
 /** Ticker's event queue structure
  */
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
-    ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_t *head;               /**< A pointer to head, the earliest event */
 #ifndef MBED_TICKER_CONSTANT_PERIOD_NUM
     uint32_t period_num;                /**< Ratio of period to 1us, numerator */
+    uint64_t period_num_reciprocal;     /**< UINT64_MAX / period_num, to divide by it with a multiplication */
 #endif
 #ifndef MBED_TICKER_CONSTANT_PERIOD_DEN
     uint32_t period_den;                /**< Ratio of period to 1us, denominator */
+    uint64_t period_den_reciprocal;     /**< UINT64_MAX / period_den, to divide by it with a multiplication */
 #endif
 #ifndef MBED_TICKER_CONSTANT_MASK
     uint32_t bitmask;                   /**< Mask to be applied to time values read */
@@ -128,6 +234,13 @@ typedef struct {
     uint32_t tick_remainder;            /**< Ticks that have not been added to base_time */
 #endif
     us_timestamp_t present_time;        /**< Store the timestamp used for present time */
+    uint32_t sequence;                  /**< Odd while the present time is updated */
+#if MBED_CONF_TARGET_TICKER_EVENT_SLACK
+    us_timestamp_t match_time;          /**< Time the interrupt is scheduled for */
+#endif
+#if MBED_CONF_TARGET_TICKER_STATS
+    ticker_stats_t stats;               /**< Statistics of the queue */
+#endif
     bool initialized;                   /**< Indicate if the instance is initialized */
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
@@ -163,6 +276,9 @@ extern "C" {
 void ticker_set_handler(const ticker_data_t *const ticker, ticker_event_handler handler);
 
 /** IRQ handler that goes through the events to trigger overdue events.
+ *
+ * With MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH, the event handler is called
+ * outside of the critical section.
  *
  * @param ticker The ticker object.
  */
@@ -210,6 +326,61 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  */
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 
+/** Insert an event to the queue with a dispatch tolerance
+ *
+ * The event will be executed between timestamp and timestamp + slack us.
+ * Within that window, the ticker interrupt is delayed so it can dispatch other
+ * events whose windows overlap, reducing the number of interrupts.
+ *
+ * @note The slack is ignored unless MBED_CONF_TARGET_TICKER_EVENT_SLACK is
+ * set, the event is then executed at timestamp as with ticker_insert_event_us.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's timestamp
+ * @param slack     The time in us the event may be delayed by
+ * @param id        The event object
+ */
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id);
+
+/** Insert a periodic event to the queue
+ *
+ * The event will be executed every period us, starting period us after
+ * ticker_read_us(). The dispatcher moves it to its next timestamp before
+ * calling the event handler, it is neither removed nor inserted again every
+ * period. The timestamps are multiples of the period from the first one,
+ * lateness is not accumulated: an event late by several periods is executed
+ * once per missed period.
+ *
+ * The event is periodic until it is removed with ticker_remove_event(),
+ * which can be called by its handler. It must not be inserted again while
+ * it is in the queue.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param period    The period of the event in us, which must not be 0
+ * @param id        The event object
+ */
+void ticker_insert_periodic_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, uint32_t period, uint32_t id);
+
+/** Insert several events to the queue
+ *
+ * This is equivalent to calling ticker_insert_event_us() for each event, in
+ * order, but the queue is updated in a single pass and the ticker interrupt
+ * is reprogrammed at most once.
+ *
+ * @note The batch is sorted before entering the critical section so the
+ * time spent with interrupts disabled does not depend on the order of the
+ * events.
+ *
+ * @param ticker     The ticker object.
+ * @param events     The event objects to be inserted to the queue
+ * @param timestamps The timestamp of each event
+ * @param ids        The id of each event
+ * @param count      The number of events in the batch
+ */
+void ticker_insert_events_us(const ticker_data_t *const ticker, ticker_event_t *const events[], const us_timestamp_t timestamps[], const uint32_t ids[], size_t count);
+
 /** Read the current (relative) ticker's timestamp
  *
  * @warning Return a relative timestamp because the counter wrap every 4294
@@ -225,6 +396,15 @@ timestamp_t ticker_read(const ticker_data_t *const ticker);
  * @warning Return an absolute timestamp counting from the initialization of the
  * ticker.
  *
+ * @note The time is read without masking interrupts, the read is retried if the
+ * ticker interrupt or another context updates the present time meanwhile. The
+ * ticker interrupt is scheduled so the present time is updated before the counter
+ * wraps, the interrupts are only masked if it is late.
+ *
+ * @note The caller must be masked by critical sections, see
+ * hal_critical_section_masks_caller(): an interrupt handler of higher priority
+ * could preempt an update of the present time and retry forever.
+ *
  * @param ticker The ticker object.
  * @return The current timestamp
  */
@@ -246,10 +426,29 @@ int ticker_get_next_timestamp(const ticker_data_t *const ticker, timestamp_t *ti
  */
 int ticker_get_next_timestamp_us(const ticker_data_t *const ticker, us_timestamp_t *timestamp);
 
+#if MBED_CONF_TARGET_TICKER_STATS || defined(DOXYGEN_ONLY)
+/** Read the statistics of a ticker queue
+ *
+ * @param ticker        The ticker object.
+ * @param stats         Set to the statistics recorded since the ticker was
+ *                      initialized or the statistics were reset.
+ */
+void ticker_get_stats(const ticker_data_t *const ticker, ticker_stats_t *stats);
+
+/** Reset the statistics of a ticker queue
+ *
+ * The counters are cleared and the maximum depth starts from the depth of
+ * the queue.
+ *
+ * @param ticker        The ticker object.
+ */
+void ticker_reset_stats(const ticker_data_t *const ticker);
+#endif
+
 /** Suspend this ticker
  *
- * When suspended reads will always return the same time and no
- * events will be dispatched. When suspended the common layer
+ * When suspended reads will always return the time the ticker was
+ * suspended at and no events will be dispatched. When suspended the common layer
  * will only ever call the interface function clear_interrupt()
  * and that is only if ticker_irq_handler is called.
  *
@@ -267,6 +466,32 @@ void ticker_suspend(const ticker_data_t *const ticker);
  */
 void ticker_resume(const ticker_data_t *const ticker);
 
+/** Resume this ticker, accounting for the time spent suspended
+ *
+ * The time of the ticker is advanced by the given time, measured with
+ * another ticker while this one was stopped, for instance by the lp ticker
+ * during deep sleep. The events which became due are dispatched.
+ *
+ * @param ticker        The ticker object.
+ * @param elapsed_us    The time spent suspended, in microseconds.
+ */
+void ticker_resume_compensated(const ticker_data_t *const ticker, us_timestamp_t elapsed_us);
+
+/** Take a change of the frequency of this ticker into account
+ *
+ * Call this while the ticker is suspended, after the frequency reported by
+ * its get_info function has changed, for instance because it is clocked by
+ * a bus whose clock was changed. Ticks read after the call are converted
+ * with the new frequency.
+ *
+ * @note This has no effect on the ratio of tickers whose period is fixed at
+ * build time by US_TICKER_PERIOD_NUM or LP_TICKER_PERIOD_NUM, which must
+ * keep their frequency.
+ *
+ * @param ticker        The ticker object.
+ */
+void ticker_update_timing(const ticker_data_t *const ticker);
+
 /* Private functions
  *
  * @cond PRIVATE
@@ -0,0 +1,129 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_TICKER_MUX_API_H
+#define MBED_TICKER_MUX_API_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hal/ticker_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_ticker_mux Ticker multiplexer
+ * Virtual tickers sharing the counter and the compare interrupt of a hardware ticker
+ *
+ * Each channel of a multiplexer implements the @ref hal_ticker_shared
+ * "ticker specification" and is used by its own ::ticker_data_t, so each
+ * queue schedules and dispatches its events independently. The hardware
+ * compare interrupt is set for the earliest deadline of the channels.
+ *
+ * The ::ticker_interface_t functions take no parameter, so the ticker
+ * providing a multiplexer defines the functions of each channel, which call
+ * the functions below with the channel number.
+ *
+ * @{
+ */
+
+/** State of a multiplexer channel */
+typedef struct {
+    timestamp_t reference;              /**< Counter value the compare interrupt was set at */
+    uint32_t delta;                     /**< Ticks from the reference to the compare interrupt */
+    bool initialized;                   /**< The channel has been initialized */
+    bool armed;                         /**< The compare interrupt is set */
+    bool pending;                       /**< The interrupt is pending */
+} ticker_mux_channel_t;
+
+/** Multiplexer of a hardware ticker */
+typedef struct {
+    const ticker_interface_t *interface; /**< Interface of the hardware ticker */
+    ticker_mux_channel_t *channels;     /**< State of the channels */
+    uint32_t count;                     /**< Number of channels */
+    uint32_t bitmask;                   /**< Mask of the hardware counter */
+} ticker_mux_t;
+
+/** Initialize a channel, and the hardware ticker if needed
+ *
+ * The pending interrupt and the compare interrupt of the channel are cleared,
+ * the ones of the other channels are kept.
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ */
+void ticker_mux_init(ticker_mux_t *mux, uint32_t channel);
+
+/** Deinitialize a channel, and the hardware ticker with the last one
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ */
+void ticker_mux_free(ticker_mux_t *mux, uint32_t channel);
+
+/** Set the compare interrupt of a channel
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ * @param timestamp The counter value to interrupt at
+ */
+void ticker_mux_set_interrupt(ticker_mux_t *mux, uint32_t channel, timestamp_t timestamp);
+
+/** Disable the compare interrupt of a channel
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ */
+void ticker_mux_disable_interrupt(ticker_mux_t *mux, uint32_t channel);
+
+/** Clear the pending interrupt of a channel
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ */
+void ticker_mux_clear_interrupt(ticker_mux_t *mux, uint32_t channel);
+
+/** Set the interrupt of a channel pending
+ *
+ * @param mux       The multiplexer
+ * @param channel   The channel
+ */
+void ticker_mux_fire_interrupt(ticker_mux_t *mux, uint32_t channel);
+
+/** Handle the hardware ticker interrupt
+ *
+ * Calls @p handler for each channel whose interrupt is pending, then sets
+ * the compare interrupt for the next deadline.
+ *
+ * @param mux       The multiplexer
+ * @param handler   The function dispatching the interrupt of a channel,
+ *                  which calls ::ticker_irq_handler with its ticker data
+ */
+void ticker_mux_irq_handler(ticker_mux_t *mux, void (*handler)(uint32_t channel));
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,172 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_TRACEPOINT_API_H
+#define MBED_TRACEPOINT_API_H
+
+#include "device.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Record the HAL tracepoints */
+#ifndef MBED_CONF_TARGET_TRACEPOINTS_ENABLED
+#define MBED_CONF_TARGET_TRACEPOINTS_ENABLED 0
+#endif
+
+/* Number of records of the RAM ring, a power of two */
+#ifndef MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE
+#define MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE 128
+#endif
+
+/* ITM stimulus port to stream the records on instead of the RAM ring, -1 for none */
+#ifndef MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT
+#define MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT -1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_tracepoint Tracepoints
+ * Binary records of the HAL driver operations, for a timeline on the host
+ *
+ * Each record is the event, the exception number of the context recording
+ * it, 0 for thread mode, a timestamp and two arguments. The records are kept
+ * in a RAM ring of MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE records, the
+ * oldest overwritten first, or streamed over the ITM stimulus port
+ * MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT. tools/tracepoint_timeline converts
+ * them to a timeline for the Chrome trace viewer or Perfetto.
+ *
+ * The timestamps are cycles of the DWT cycle counter, or ticks of the us
+ * ticker on cores without it, at ::hal_tracepoint_frequency.
+ *
+ * The common HAL code records the events below. Target drivers record the
+ * ones of the operations they implement with ::HAL_TRACEPOINT, and
+ * applications their own events from HAL_TRACEPOINT_USER.
+ *
+ * @code
+ * hal_tracepoint_init();
+ * run_the_workload();
+ * hal_tracepoint_dump();
+ * @endcode
+ *
+ * # Defined behavior
+ * * Nothing is recorded before ::hal_tracepoint_init
+ * * ::HAL_TRACEPOINT compiles to nothing unless
+ *   MBED_CONF_TARGET_TRACEPOINTS_ENABLED is set
+ * * ::HAL_TRACEPOINT is safe to call from interrupt handlers
+ *
+ * @{
+ */
+
+/** Events of the tracepoints, *_START and *_COMPLETE ones are paired */
+typedef enum {
+    HAL_TRACEPOINT_TICKER_INSERT = 1,      /**< Ticker event inserted: event, timestamp */
+    HAL_TRACEPOINT_TICKER_DISPATCH,        /**< Ticker event handler called: id, lateness in ticker time */
+    HAL_TRACEPOINT_SLEEP_START,            /**< Sleep entered: 1 for deep sleep */
+    HAL_TRACEPOINT_SLEEP_COMPLETE,         /**< Sleep exited: 1 for deep sleep */
+    HAL_TRACEPOINT_SPI_START,              /**< SPI transfer started: object, tx length << 16 | rx length */
+    HAL_TRACEPOINT_SPI_COMPLETE,           /**< SPI transfer completed: object, events */
+    HAL_TRACEPOINT_I2C_START,              /**< I2C transfer started: object, address */
+    HAL_TRACEPOINT_I2C_COMPLETE,           /**< I2C transfer completed: object, events */
+    HAL_TRACEPOINT_SERIAL_TX_START,        /**< Serial transmission started: object, length */
+    HAL_TRACEPOINT_SERIAL_TX_COMPLETE,     /**< Serial transmission completed: object */
+    HAL_TRACEPOINT_SERIAL_RX_START,        /**< Serial reception started: object, length */
+    HAL_TRACEPOINT_SERIAL_RX_COMPLETE,     /**< Serial reception completed: object, events */
+    HAL_TRACEPOINT_FLASH_PROGRAM_START,    /**< Flash program started: address, size */
+    HAL_TRACEPOINT_FLASH_PROGRAM_COMPLETE, /**< Flash program completed: address, status */
+    HAL_TRACEPOINT_FLASH_ERASE_START,      /**< Flash erase started: address */
+    HAL_TRACEPOINT_FLASH_ERASE_COMPLETE,   /**< Flash erase completed: address, status */
+    HAL_TRACEPOINT_USER = 0x8000           /**< First event of the application */
+} hal_tracepoint_id_t;
+
+/** Record of a tracepoint */
+typedef struct {
+    uint32_t timestamp; /**< Time of the event at ::hal_tracepoint_frequency */
+    uint16_t id;        /**< The event, ::hal_tracepoint_id_t */
+    uint16_t context;   /**< Exception number of the context, 0 for thread mode */
+    uint32_t arg0;      /**< First argument of the event */
+    uint32_t arg1;      /**< Second argument of the event */
+} hal_tracepoint_record_t;
+
+#if MBED_CONF_TARGET_TRACEPOINTS_ENABLED
+
+/** Start recording the tracepoints
+ *
+ * Enables the cycle counter, or initializes the us ticker, for the timestamps.
+ */
+void hal_tracepoint_init(void);
+
+/** Record a tracepoint, see ::HAL_TRACEPOINT
+ *
+ * @param id The event
+ * @param arg0 The first argument of the event
+ * @param arg1 The second argument of the event
+ */
+void hal_tracepoint_record(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/** Get the frequency of the timestamps
+ *
+ * @return The frequency of the timestamps in Hz
+ */
+uint32_t hal_tracepoint_frequency(void);
+
+/** Read the records of the RAM ring, oldest first
+ *
+ * The records read are removed from the ring.
+ *
+ * @param records The records
+ * @param count The largest number of records to read
+ * @return The number of records read
+ */
+size_t hal_tracepoint_read(hal_tracepoint_record_t *records, size_t count);
+
+/** Get the number of records overwritten before they were read
+ *
+ * @return The number of records lost since ::hal_tracepoint_init
+ */
+uint32_t hal_tracepoint_dropped(void);
+
+/** Print the records of the RAM ring on the console
+ *
+ * Prints "#tracepoint begin <frequency>", a "#tracepoint <hex>" line per
+ * record, and "#tracepoint end", for tools/tracepoint_timeline.
+ */
+void hal_tracepoint_dump(void);
+
+/** Record a tracepoint, compiled out unless MBED_CONF_TARGET_TRACEPOINTS_ENABLED is set */
+#define HAL_TRACEPOINT(id, arg0, arg1) hal_tracepoint_record((id), (uint32_t)(arg0), (uint32_t)(arg1))
+
+#else
+
+#define HAL_TRACEPOINT(id, arg0, arg1) ((void)0)
+
+#endif
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_TRACEPOINT_API_H
+
+/** @}*/
@@ -21,6 +21,8 @@
 #define MBED_TRNG_API_H
 
 #include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include "device.h"
 
 #if defined(DEVICE_TRNG) || defined(FEATURE_PSA)
@@ -29,6 +31,66 @@
  */
 typedef struct trng_s trng_t;
 
+#ifndef MBED_CONF_TARGET_TRNG_POOL_SIZE
+#define MBED_CONF_TARGET_TRNG_POOL_SIZE 64
+#endif
+
+/* Cutoffs of the SP 800-90B health tests, for a false positive probability of
+ * 2^-20 and the min-entropy per raw byte assessed for the TRNG. The defaults
+ * assume 1 bit per byte; for H bits, the Repetition Count Test cutoff is
+ * 1 + ceil(20 / H), the Adaptive Proportion Test cutoff over 512 samples is
+ * 410 for H = 0.5, 177 for H = 2, 62 for H = 4 and 13 for H = 8.
+ */
+#ifndef MBED_CONF_TARGET_TRNG_RCT_CUTOFF
+#define MBED_CONF_TARGET_TRNG_RCT_CUTOFF 21
+#endif
+
+#ifndef MBED_CONF_TARGET_TRNG_APT_CUTOFF
+#define MBED_CONF_TARGET_TRNG_APT_CUTOFF 311
+#endif
+
+/* Raw bytes conditioned into each TRNG_CONDITIONED_BLOCK_SIZE output block,
+ * twice the output bits at the default entropy assessment
+ */
+#ifndef MBED_CONF_TARGET_TRNG_CONDITIONING_INPUT_SIZE
+#define MBED_CONF_TARGET_TRNG_CONDITIONING_INPUT_SIZE 64
+#endif
+
+/** Window of the Adaptive Proportion Test, in samples */
+#define TRNG_APT_WINDOW_SIZE 512
+
+/** Samples tested at start-up before any conditioned output */
+#define TRNG_STARTUP_SAMPLES 1024
+
+/** Bytes output by ::trng_condition */
+#define TRNG_CONDITIONED_BLOCK_SIZE 4
+
+/** Handler called when the TRNG has new data ready
+ */
+typedef void (*trng_irq_handler)(uint32_t id);
+
+/** Entropy pool topped up in the background
+ */
+typedef struct trng_pool {
+    trng_t *trng;                                    /**< TRNG feeding the pool */
+    uint8_t buffer[MBED_CONF_TARGET_TRNG_POOL_SIZE]; /**< Ring buffer of random bytes */
+    size_t head;                                     /**< Index of the oldest byte */
+    size_t count;                                    /**< Number of bytes available */
+    bool irq;                                        /**< The TRNG interrupt fills the pool */
+} trng_pool_t;
+
+/** State of the continuous health tests of a TRNG
+ */
+typedef struct trng_health {
+    uint8_t rct_sample;   /**< Sample repeated in the Repetition Count Test */
+    uint16_t rct_count;   /**< Number of repetitions of rct_sample */
+    uint8_t apt_sample;   /**< First sample of the Adaptive Proportion Test window */
+    uint16_t apt_count;   /**< Number of occurrences of apt_sample in the window */
+    uint16_t apt_index;   /**< Number of samples of the window tested, 0 to start a window */
+    uint16_t startup;     /**< Number of start-up samples left to test */
+    bool failed;          /**< A health test failed, latched until ::trng_health_init */
+} trng_health_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -60,6 +122,114 @@ void trng_free(trng_t *obj);
  */
 int trng_get_bytes(trng_t *obj, uint8_t *output, size_t length, size_t *output_length);
 
+/** Set the handler called when new random data is ready
+ *
+ * The handler is called from interrupt context and may call ::trng_get_bytes.
+ * The default implementation does not support the interrupt.
+ *
+ * @param obj The TRNG object
+ * @param handler The handler, NULL to disable the interrupt
+ * @param id The id passed to the handler
+ * @return 0 success, -1 if the interrupt is not supported
+ */
+int trng_irq_set(trng_t *obj, trng_irq_handler handler, uint32_t id);
+
+/** Initialize an entropy pool
+ *
+ * The pool is filled by the TRNG interrupt when the target supports it, otherwise
+ * ::trng_pool_fill must be called, typically from an idle hook.
+ *
+ * @param pool The pool
+ * @param obj The initialized TRNG object feeding the pool
+ */
+void trng_pool_init(trng_pool_t *pool, trng_t *obj);
+
+/** Stop filling an entropy pool
+ *
+ * The remaining bytes are cleared.
+ *
+ * @param pool The pool
+ */
+void trng_pool_free(trng_pool_t *pool);
+
+/** Top up an entropy pool with what the TRNG has ready
+ *
+ * Does not wait for the TRNG. Safe to call from thread, idle or interrupt context.
+ *
+ * @param pool The pool
+ * @return The number of bytes added
+ */
+size_t trng_pool_fill(trng_pool_t *pool);
+
+/** Get the number of random bytes available in an entropy pool
+ *
+ * @param pool The pool
+ * @return The number of bytes available
+ */
+size_t trng_pool_count(const trng_pool_t *pool);
+
+/** Get random data from an entropy pool without blocking
+ *
+ * Bytes are taken from the pool and cleared from it. Fewer bytes than requested are
+ * returned when the pool runs low; the caller retries later, as with ::trng_get_bytes.
+ *
+ * @param pool The pool
+ * @param output The pointer to an output array
+ * @param length The size of output data, to avoid buffer overwrite
+ * @param output_length The length of generated data
+ * @return 0 success, -1 fail
+ */
+int trng_get_bytes_pooled(trng_pool_t *pool, uint8_t *output, size_t length, size_t *output_length);
+
+/** Reset the health tests of a TRNG
+ *
+ * Clears a latched failure and requires TRNG_STARTUP_SAMPLES samples to pass
+ * the tests again before ::trng_get_bytes_conditioned outputs anything.
+ *
+ * @param health The health test state
+ */
+void trng_health_init(trng_health_t *health);
+
+/** Run the SP 800-90B continuous health tests on raw samples
+ *
+ * Each byte is a sample, tested with the Repetition Count Test and the
+ * Adaptive Proportion Test using MBED_CONF_TARGET_TRNG_RCT_CUTOFF and
+ * MBED_CONF_TARGET_TRNG_APT_CUTOFF. A failure is latched.
+ *
+ * @param health The health test state
+ * @param samples The raw samples
+ * @param length The number of samples
+ * @return 0 if the samples passed, -1 if a test failed now or before
+ */
+int trng_health_check(trng_health_t *health, const uint8_t *samples, size_t length);
+
+/** Condition raw samples into a full entropy block
+ *
+ * The default implementation computes the SHA-256 of the samples with the
+ * @ref hal_hash "hash module" when there is one, truncated to the block size.
+ * Otherwise it computes their CRC-32, with the CRC module when it supports the
+ * polynomial, in software otherwise.
+ *
+ * @param input The raw samples, MBED_CONF_TARGET_TRNG_CONDITIONING_INPUT_SIZE bytes
+ * @param length The number of raw samples
+ * @param output The TRNG_CONDITIONED_BLOCK_SIZE conditioned bytes
+ */
+void trng_condition(const uint8_t *input, size_t length, uint8_t *output);
+
+/** Get health tested and conditioned random data
+ *
+ * Raw data is read from the TRNG until the requested length is output, every
+ * sample going through ::trng_health_check before ::trng_condition.
+ *
+ * @param obj The TRNG object
+ * @param health The health test state, initialized with ::trng_health_init
+ * @param output The pointer to an output array
+ * @param length The size of output data, to avoid buffer overwrite
+ * @param output_length The length of generated data
+ * @return 0 success, -1 if the TRNG failed or a health test failed
+ */
+int trng_get_bytes_conditioned(trng_t *obj, trng_health_t *health, uint8_t *output, size_t length, size_t *output_length);
+
 /**@}*/
 
 #ifdef __cplusplus
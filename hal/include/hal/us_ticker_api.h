@@ -23,6 +23,13 @@
 #include <stdint.h>
 #include "hal/ticker_api.h"
 
+/* Number of tickers sharing the us ticker hardware, each with its own event
+ * queue. Channel 0 is the ticker returned by get_us_ticker_data().
+ */
+#ifndef MBED_CONF_TARGET_US_TICKER_CHANNELS
+#define MBED_CONF_TARGET_US_TICKER_CHANNELS 1
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +42,7 @@ extern "C" {
  * * Has a reported frequency between 250KHz and 8MHz for counters which are less than 32 bits wide - Verified by test ::us_ticker_info_test
  * * Has a reported frequency up to 100MHz for counters which are 32 bits wide - Verified by test ::us_ticker_info_test
  * * Has a counter that is at least 16 bits wide - Verified by test ::us_ticker_info_test
+ * * us_ticker_set_irq_priority only accepts priorities masked by critical sections - Verified by test ::us_ticker_irq_priority_test
  * * All behavior defined by the @ref hal_ticker_shared "ticker specification"
  *
  * # Undefined behavior
@@ -56,6 +64,13 @@ extern "C" {
  *
  * If any are defined, all 3 must be defined, and the macros are checked for consistency with
  * us_ticker_get_info by test ::us_ticker_info_test.
+ *
+ * US_TICKER_COMPARE_CHANNELS: The number of compare channels of the timer besides the one of
+ * us_ticker_set_interrupt, up to TICKER_MAX_COMPARE_CHANNELS. The target then implements
+ * us_ticker_set_interrupt_channels.
+ *
+ * US_TICKER_IRQn: The NVIC interrupt of the ticker, whose priority is then set by
+ * us_ticker_set_irq_priority.
 
  * @{
  */
@@ -117,6 +132,35 @@ ticker_irq_handler_type set_us_ticker_irq_handler(ticker_irq_handler_type ticker
  */
 const ticker_data_t *get_us_ticker_data(void);
 
+/** Get the data of a channel of the us ticker
+ *
+ * With MBED_CONF_TARGET_US_TICKER_CHANNELS greater than 1, the us ticker
+ * hardware is shared by that many tickers through a @ref hal_ticker_mux
+ * "ticker multiplexer". Each one has its own event queue and is dispatched by
+ * ::ticker_irq_handler, the compare interrupt is set for the earliest event of
+ * all of them. Channel 0 is the ticker returned by get_us_ticker_data(), the
+ * handler set by set_us_ticker_irq_handler() only applies to it.
+ *
+ * @param channel The channel, less than MBED_CONF_TARGET_US_TICKER_CHANNELS
+ * @return The ticker data of the channel, NULL if there is no such channel
+ */
+const ticker_data_t *get_us_ticker_channel_data(uint32_t channel);
+
+
+/** Set the priority of the ticker interrupt
+ *
+ * The ticker interrupt handler updates the event queue in critical sections,
+ * so it must run at a priority masked by them, see
+ * hal_critical_section_masks_priority(). With
+ * MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY, the interrupts of higher
+ * priorities preempt the dispatch of the ticker events and are never delayed
+ * by critical sections, but must not use the ticker API.
+ *
+ * @param priority Priority as passed to NVIC_SetPriority()
+ * @return true if the priority was set, false if the critical sections don't
+ *         mask it or the target doesn't define US_TICKER_IRQn
+ */
+bool us_ticker_set_irq_priority(uint32_t priority);
 
 /** The wrapper for ticker_irq_handler, to pass us ticker's data
  *
@@ -268,6 +312,19 @@ void us_ticker_clear_interrupt(void);
  */
 void us_ticker_fire_interrupt(void);
 
+/** Set the interrupt of the extra compare channels
+ *
+ * Only required if the target defines US_TICKER_COMPARE_CHANNELS. The first
+ * count extra channels are set to interrupt at the given timestamps, as
+ * us_ticker_set_interrupt does, and the other extra channels are disabled.
+ * All the channels call us_ticker_irq_handler, us_ticker_clear_interrupt and
+ * us_ticker_disable_interrupt apply to all of them.
+ *
+ * @param timestamps The timestamps of the channels, in increasing order
+ * @param count      The number of channels to set, up to US_TICKER_COMPARE_CHANNELS
+ */
+void us_ticker_set_interrupt_channels(const timestamp_t *timestamps, uint32_t count);
+
 /** Get frequency and counter bits of this ticker.
  *
  * Pseudo Code:
@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal */
+/** @{*/
+
+#ifndef MBED_WATCHDOG_SUPERVISOR_API_H
+#define MBED_WATCHDOG_SUPERVISOR_API_H
+
+#include "device.h"
+
+#if DEVICE_WATCHDOG
+
+#include "hal/watchdog_api.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Largest number of clients of the supervisor */
+#define WATCHDOG_SUPERVISOR_MAX_CLIENTS 32
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_watchdog_supervisor Watchdog supervisor
+ * Kick the watchdog only when every supervised task is alive
+ *
+ * Tasks, or subsystems, register with the supervisor and check in regularly.
+ * The hardware watchdog is kicked from ::hal_watchdog_supervisor_service
+ * only, once every registered client has checked in since the last kick, so
+ * a single stuck task resets the system.
+ *
+ * ::hal_idle calls ::hal_watchdog_supervisor_service before sleeping, so
+ * the watchdog is kicked without waking up for it. When nothing else wakes
+ * the core up, the supervisor wakes it up half way to the earliest time the
+ * watchdog may trigger, taking the accuracy of its clock from
+ * ::hal_watchdog_get_platform_features into account.
+ *
+ * @code
+ * static int client;
+ *
+ * client = hal_watchdog_supervisor_register();
+ * hal_watchdog_supervisor_start(&config);
+ * while (true) {
+ *     process_pending_work();
+ *     hal_watchdog_supervisor_check_in(client);
+ *     hal_idle();
+ * }
+ * @endcode
+ *
+ * # Defined behavior
+ * * ::hal_watchdog_supervisor_register returns a client which has not checked
+ *   in, or -1 if WATCHDOG_SUPERVISOR_MAX_CLIENTS are registered
+ * * ::hal_watchdog_supervisor_check_in and ::hal_watchdog_supervisor_register
+ *   are safe to call from interrupt handlers
+ * * ::hal_watchdog_supervisor_service kicks the watchdog if it was started
+ *   with ::hal_watchdog_supervisor_start and every registered client has
+ *   checked in since the last kick, and clears the check-ins
+ * * The watchdog is kicked by ::hal_watchdog_supervisor_service when no
+ *   client is registered
+ *
+ * # Undefined behavior
+ * * Calling ::hal_watchdog_kick while the supervisor runs
+ * * Checking in or unregistering a client which is not registered
+ *
+ * @{
+ */
+
+/** Start the watchdog supervised by the clients
+ *
+ * @param config Configuration of the watchdog, see ::hal_watchdog_init
+ * @return The status of ::hal_watchdog_init
+ */
+watchdog_status_t hal_watchdog_supervisor_start(const watchdog_config_t *config);
+
+/** Stop the watchdog and the supervision
+ *
+ * @return The status of ::hal_watchdog_stop
+ */
+watchdog_status_t hal_watchdog_supervisor_stop(void);
+
+/** Register a client
+ *
+ * @return The client, or -1 if WATCHDOG_SUPERVISOR_MAX_CLIENTS are registered
+ */
+int hal_watchdog_supervisor_register(void);
+
+/** Unregister a client
+ *
+ * @param client The client returned by ::hal_watchdog_supervisor_register
+ */
+void hal_watchdog_supervisor_unregister(int client);
+
+/** Report that a client is alive
+ *
+ * @param client The client returned by ::hal_watchdog_supervisor_register
+ */
+void hal_watchdog_supervisor_check_in(int client);
+
+/** Kick the watchdog if every client has checked in
+ *
+ * @return true if the watchdog was kicked
+ */
+bool hal_watchdog_supervisor_service(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEVICE_WATCHDOG
+
+#endif // MBED_WATCHDOG_SUPERVISOR_API_H
+
+/** @}*/
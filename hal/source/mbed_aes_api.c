@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/aes_api.h"
+
+#if DEVICE_AES
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+#include <string.h>
+
+// The asynchronous update in progress, which owns the AES module
+static volatile bool async_busy;
+static struct {
+    hal_aes_ctx_t *ctx;
+    hal_aes_async_handler handler;
+    uint32_t id;
+} async_update;
+
+MBED_WEAK void hal_aes_crypt_partial_async(const uint8_t *input, uint8_t *output, size_t count,
+                                           hal_aes_async_handler handler, uint32_t id)
+{
+    hal_aes_crypt_partial(input, output, count);
+    handler(id);
+}
+
+MBED_WEAK void hal_aes_ctx_start(hal_aes_ctx_t *ctx, const aes_mbed_config_t *config, const uint8_t *key, const uint8_t *iv)
+{
+    ctx->config = *config;
+    memset(ctx->key, 0, sizeof(ctx->key));
+    memcpy(ctx->key, key, config->key_bits / 8);
+    if (iv != NULL) {
+        memcpy(ctx->iv, iv, sizeof(ctx->iv));
+    } else {
+        memset(ctx->iv, 0, sizeof(ctx->iv));
+    }
+}
+
+MBED_WEAK int hal_aes_ctx_update(hal_aes_ctx_t *ctx, const uint8_t *input, uint8_t *output, size_t size)
+{
+    MBED_ASSERT(!core_util_atomic_load_bool(&async_busy));
+
+    if ((size % HAL_AES_BLOCK_SIZE) != 0) {
+        return -1;
+    }
+
+    size_t count = size / HAL_AES_BLOCK_SIZE;
+    while (count > 0) {
+        const size_t chunk = count < MBED_CONF_TARGET_AES_SECTION_BLOCKS ? count : MBED_CONF_TARGET_AES_SECTION_BLOCKS;
+
+        core_util_critical_section_enter();
+        hal_aes_crypt_partial_start(&ctx->config, ctx->key, ctx->iv);
+        hal_aes_crypt_partial(input, output, chunk);
+        if (ctx->config.mode != HAL_AES_MODE_ECB) {
+            hal_aes_get_iv(ctx->iv);
+        }
+        core_util_critical_section_exit();
+
+        input += chunk * HAL_AES_BLOCK_SIZE;
+        output += chunk * HAL_AES_BLOCK_SIZE;
+        count -= chunk;
+    }
+
+    return 0;
+}
+
+static void async_update_done(uint32_t id)
+{
+    (void)id;
+    hal_aes_ctx_t *ctx = async_update.ctx;
+    const hal_aes_async_handler handler = async_update.handler;
+    const uint32_t handler_id = async_update.id;
+
+    if (ctx->config.mode != HAL_AES_MODE_ECB) {
+        hal_aes_get_iv(ctx->iv);
+    }
+
+    // The handler may start another update
+    core_util_atomic_store_bool(&async_busy, false);
+    handler(handler_id);
+}
+
+MBED_WEAK int hal_aes_ctx_update_async(hal_aes_ctx_t *ctx, const uint8_t *input, uint8_t *output, size_t size,
+                                      hal_aes_async_handler handler, uint32_t id)
+{
+    if ((size % HAL_AES_BLOCK_SIZE) != 0 || core_util_atomic_exchange_bool(&async_busy, true)) {
+        return -1;
+    }
+
+    async_update.ctx = ctx;
+    async_update.handler = handler;
+    async_update.id = id;
+
+    if (size == 0) {
+        core_util_atomic_store_bool(&async_busy, false);
+        handler(id);
+        return 0;
+    }
+
+    hal_aes_crypt_partial_start(&ctx->config, ctx->key, ctx->iv);
+    hal_aes_crypt_partial_async(input, output, size / HAL_AES_BLOCK_SIZE, async_update_done, 0);
+
+    return 0;
+}
+
+MBED_WEAK void hal_aes_ctx_free(hal_aes_ctx_t *ctx)
+{
+    volatile uint8_t *p = (volatile uint8_t *)ctx;
+
+    // Not optimized away, unlike memset
+    for (size_t i = 0; i < sizeof(*ctx); i++) {
+        p[i] = 0;
+    }
+}
+
+#endif // DEVICE_AES
@@ -0,0 +1,141 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/analogin_api.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_ANALOGIN
+
+MBED_WEAK void analogin_get_capabilities(analogin_t *obj, analogin_capabilities_t *cap)
+{
+    (void)obj;
+
+    cap->resolutions = 0;
+    cap->max_oversampling = 1;
+    cap->min_sampling_time_ns = 0;
+    cap->max_sampling_time_ns = 0;
+}
+
+MBED_WEAK int analogin_configure(analogin_t *obj, const analogin_config_t *config)
+{
+    (void)obj;
+
+    if (config->resolution != 0 || config->oversampling > 1 || config->sampling_time_ns != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+uint16_t analogin_read_average_u16(analogin_t *obj, uint16_t count)
+{
+    uint32_t sum = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        sum += analogin_read_u16(obj);
+    }
+    return (uint16_t)((sum + count / 2) / count);
+}
+
+MBED_WEAK int analogin_watchdog_set(analogin_t *obj, uint16_t low, uint16_t high, analogin_watchdog_handler handler, uint32_t id)
+{
+    (void)obj;
+    (void)low;
+    (void)high;
+    (void)handler;
+    (void)id;
+    return -1;
+}
+
+MBED_WEAK void analogin_watchdog_clear(analogin_t *obj)
+{
+    (void)obj;
+}
+
+int analogin_scan_init(analogin_scan_t *scan, analogin_t *const *channels, size_t channel_count, uint16_t *buffer, size_t length, analogin_scan_handler handler, uint32_t id)
+{
+    if (channel_count == 0 || length == 0 || (length % (2 * channel_count)) != 0) {
+        return -1;
+    }
+
+    scan->channels = channels;
+    scan->channel_count = channel_count;
+    scan->buffer = buffer;
+    scan->length = length;
+    scan->pos = 0;
+    scan->handler = handler;
+    scan->id = id;
+#if DEVICE_PWMOUT
+    scan->pwm = NULL;
+#endif
+    return 0;
+}
+
+MBED_WEAK int analogin_scan_start(analogin_scan_t *scan, uint32_t sample_rate_hz)
+{
+    (void)scan;
+    (void)sample_rate_hz;
+    return -1;
+}
+
+#if DEVICE_PWMOUT
+static void analogin_scan_pwm_irq(uint32_t id)
+{
+    analogin_scan_frame((analogin_scan_t *)id);
+}
+
+MBED_WEAK int analogin_scan_start_pwm(analogin_scan_t *scan, pwmout_t *pwm, int offset_us)
+{
+    if (offset_us != 0) {
+        return -1;
+    }
+    if (pwmout_period_irq_set(pwm, analogin_scan_pwm_irq, (uint32_t)scan) != 0) {
+        return -1;
+    }
+    scan->pwm = pwm;
+    return 0;
+}
+#endif
+
+MBED_WEAK void analogin_scan_stop(analogin_scan_t *scan)
+{
+#if DEVICE_PWMOUT
+    if (scan->pwm != NULL) {
+        pwmout_period_irq_set(scan->pwm, NULL, 0);
+        scan->pwm = NULL;
+    }
+#else
+    (void)scan;
+#endif
+}
+
+void analogin_scan_frame(analogin_scan_t *scan)
+{
+    const size_t half = scan->length / 2;
+
+    for (size_t i = 0; i < scan->channel_count; i++) {
+        scan->buffer[scan->pos + i] = analogin_read_u16(scan->channels[i]);
+    }
+    scan->pos += scan->channel_count;
+
+    if (scan->pos == half) {
+        scan->handler(scan->id, scan->buffer, half);
+    } else if (scan->pos == scan->length) {
+        scan->pos = 0;
+        scan->handler(scan->id, scan->buffer + half, half);
+    }
+}
+
+#endif // DEVICE_ANALOGIN
@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/analogout_api.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_ANALOGOUT
+
+int analogout_stream_init(analogout_stream_t *stream, dac_t *dac, uint16_t *buffer, size_t length, analogout_stream_handler handler, uint32_t id)
+{
+    if (length == 0 || (length % 2) != 0) {
+        return -1;
+    }
+
+    stream->dac = dac;
+    stream->buffer = buffer;
+    stream->length = length;
+    stream->pos = 0;
+    stream->handler = handler;
+    stream->id = id;
+    return 0;
+}
+
+MBED_WEAK int analogout_stream_start(analogout_stream_t *stream, uint32_t sample_rate_hz)
+{
+    (void)stream;
+    (void)sample_rate_hz;
+    return -1;
+}
+
+MBED_WEAK void analogout_stream_stop(analogout_stream_t *stream)
+{
+    (void)stream;
+}
+
+void analogout_stream_sample(analogout_stream_t *stream)
+{
+    const size_t half = stream->length / 2;
+
+    analogout_write_u16(stream->dac, stream->buffer[stream->pos]);
+    stream->pos++;
+
+    if (stream->pos == half) {
+        stream->handler(stream->id, stream->buffer, half);
+    } else if (stream->pos == stream->length) {
+        stream->pos = 0;
+        stream->handler(stream->id, stream->buffer + half, half);
+    }
+}
+
+#endif // DEVICE_ANALOGOUT
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/cache_api.h"
+
+#if DEVICE_DCACHE
+
+#define LINE_MASK ((uintptr_t)HAL_DCACHE_LINE_SIZE - 1)
+
+static bool dcache_enabled(void)
+{
+    return (SCB->CCR & SCB_CCR_DC_Msk) != 0;
+}
+
+void hal_dcache_clean_range(const void *addr, size_t size)
+{
+    if (size == 0 || !dcache_enabled()) {
+        return;
+    }
+    SCB_CleanDCache_by_Addr((uint32_t *)(uintptr_t)addr, (int32_t)size);
+}
+
+void hal_dcache_invalidate_range(void *addr, size_t size)
+{
+    if (size == 0 || !dcache_enabled()) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end = start + size;
+    // Lines entirely inside the range
+    uintptr_t inner_start = (start + LINE_MASK) & ~LINE_MASK;
+    uintptr_t inner_end = end & ~LINE_MASK;
+
+    if (inner_start > inner_end) {
+        // The range is inside a single line shared with other variables
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)start, (int32_t)size);
+        return;
+    }
+    if (start != inner_start) {
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)(start & ~LINE_MASK), HAL_DCACHE_LINE_SIZE);
+    }
+    if (end != inner_end) {
+        SCB_CleanInvalidateDCache_by_Addr((uint32_t *)inner_end, HAL_DCACHE_LINE_SIZE);
+    }
+    if (inner_end != inner_start) {
+        SCB_InvalidateDCache_by_Addr((uint32_t *)inner_start, (int32_t)(inner_end - inner_start));
+    }
+}
+
+void hal_dcache_clean_invalidate_range(void *addr, size_t size)
+{
+    if (size == 0 || !dcache_enabled()) {
+        return;
+    }
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+}
+
+#else
+
+void hal_dcache_clean_range(const void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void hal_dcache_invalidate_range(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void hal_dcache_clean_invalidate_range(void *addr, size_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+#endif // DEVICE_DCACHE
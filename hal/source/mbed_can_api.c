@@ -0,0 +1,393 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/can_api.h"
+#include "hal/us_ticker_api.h"
+#include "bootstrap/mbed_critical.h"
+#include "mbed_toolchain.h"
+
+#include <string.h>
+
+#if DEVICE_CAN
+
+#define CAN_CLASSIC_MAX_DATA_LENGTH 8
+
+/* Standard frames win the arbitration over extended frames of the same base identifier */
+#define CAN_EXTENDED_BASE_SHIFT 18
+
+static const unsigned char can_fd_lengths[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+
+unsigned char can_fd_dlc_to_len(unsigned char dlc)
+{
+    return can_fd_lengths[dlc & 0x0F];
+}
+
+unsigned char can_fd_len_to_dlc(unsigned char len)
+{
+    unsigned char dlc = 0;
+    while (dlc < 15 && can_fd_lengths[dlc] < len) {
+        dlc++;
+    }
+    return dlc;
+}
+
+MBED_WEAK void can_get_capabilities(can_t *obj, can_capabilities_t *cap)
+{
+    (void)obj;
+
+    cap->fd = false;
+    cap->max_data_hz = 0;
+    cap->max_len = CAN_CLASSIC_MAX_DATA_LENGTH;
+    cap->filter_banks = 0;
+    cap->hw_timestamp = false;
+}
+
+MBED_WEAK uint64_t can_timestamp_to_us(can_t *obj, uint32_t timestamp)
+{
+    (void)obj;
+
+#if DEVICE_USTICKER
+    const uint64_t now = ticker_read_us(get_us_ticker_data());
+    return now - (uint32_t)((uint32_t)now - timestamp);
+#else
+    return timestamp;
+#endif
+}
+
+MBED_WEAK int can_fd_frequency(can_t *obj, int hz, int data_hz)
+{
+    if (data_hz != hz) {
+        return 0;
+    }
+    return can_frequency(obj, hz);
+}
+
+MBED_WEAK int can_fd_write(can_t *obj, const CANFD_Message *msg, int cc)
+{
+    if ((msg->flags & CANFDFrame) || msg->len > CAN_CLASSIC_MAX_DATA_LENGTH) {
+        return 0;
+    }
+
+    CAN_Message classic;
+    classic.id = msg->id;
+    memcpy(classic.data, msg->data, CAN_CLASSIC_MAX_DATA_LENGTH);
+    classic.len = msg->len;
+    classic.format = msg->format;
+    classic.type = msg->type;
+    classic.timestamp = 0;
+    return can_write(obj, classic, cc);
+}
+
+MBED_WEAK int can_fd_read(can_t *obj, CANFD_Message *msg, int handle)
+{
+    CAN_Message classic;
+    if (!can_read(obj, &classic, handle)) {
+        return 0;
+    }
+
+    msg->id = classic.id;
+    memcpy(msg->data, classic.data, CAN_CLASSIC_MAX_DATA_LENGTH);
+    msg->len = classic.len;
+    msg->format = classic.format;
+    msg->type = classic.type;
+    msg->flags = CANFDNone;
+    msg->timestamp = classic.timestamp;
+    return 1;
+}
+
+MBED_WEAK int can_read_burst(can_t *obj, CAN_Message *msgs, int max, int handle)
+{
+    int count = 0;
+    while (count < max && can_read(obj, &msgs[count], handle)) {
+        count++;
+    }
+    return count;
+}
+
+MBED_WEAK int can_filter_ranges(can_t *obj, const can_id_range_t *ranges, size_t count, CANFormat format, int32_t handle)
+{
+    (void)obj;
+    (void)ranges;
+    (void)count;
+    (void)format;
+    (void)handle;
+
+    return 0;
+}
+
+bool can_id_ranges_contain(const can_id_range_t *ranges, size_t count, uint32_t id)
+{
+    // Find the last range starting at or before the identifier
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (ranges[middle].first <= id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low != 0 && id <= ranges[low - 1].last;
+}
+
+static bool can_rx_buffer_accepts(const can_rx_buffer_t *buffer, const CAN_Message *msg)
+{
+    if (buffer->ranges == NULL) {
+        return true;
+    }
+    if (buffer->range_format != CANAny && buffer->range_format != msg->format) {
+        return false;
+    }
+    return can_id_ranges_contain(buffer->ranges, buffer->range_count, msg->id);
+}
+
+/* Discard the messages rejected by the software filter, returns the number kept */
+static size_t can_rx_buffer_apply_filter(const can_rx_buffer_t *buffer, CAN_Message *msgs, size_t count)
+{
+    if (buffer->ranges == NULL) {
+        return count;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (can_rx_buffer_accepts(buffer, &msgs[i])) {
+            if (kept != i) {
+                msgs[kept] = msgs[i];
+            }
+            kept++;
+        }
+    }
+    return kept;
+}
+
+static void can_rx_buffer_irq(uint32_t id, CanIrqType type)
+{
+    can_rx_buffer_t *buffer = (can_rx_buffer_t *)id;
+
+    if (type != IRQ_RX) {
+        if (type == IRQ_OVERRUN) {
+            buffer->overruns++;
+        }
+        if (buffer->handler != NULL) {
+            buffer->handler(buffer->id, type);
+        }
+        return;
+    }
+
+#if DEVICE_USTICKER
+    const uint32_t now = buffer->sw_timestamp ? (uint32_t)ticker_read_us(get_us_ticker_data()) : 0;
+#endif
+
+    // Drain the hardware FIFO, straight to the buffer while it has space
+    while (buffer->count < MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE) {
+        size_t space = MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE - buffer->head;
+        if (space > MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE - buffer->count) {
+            space = MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE - buffer->count;
+        }
+        int read = can_read_burst(buffer->can, &buffer->msgs[buffer->head], (int)space, buffer->handle);
+#if DEVICE_USTICKER
+        for (int i = 0; buffer->sw_timestamp && i < read; i++) {
+            buffer->msgs[buffer->head + (size_t)i].timestamp = now;
+        }
+#endif
+        size_t kept = can_rx_buffer_apply_filter(buffer, &buffer->msgs[buffer->head], (size_t)read);
+        buffer->head = (buffer->head + kept) % MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE;
+        buffer->count += kept;
+        if ((size_t)read != space) {
+            return;
+        }
+    }
+
+    CAN_Message msg;
+    while (can_read(buffer->can, &msg, buffer->handle)) {
+        if (can_rx_buffer_accepts(buffer, &msg)) {
+            buffer->dropped++;
+        }
+    }
+}
+
+void can_rx_buffer_init(can_rx_buffer_t *buffer, can_t *obj, int handle, can_irq_handler handler, uint32_t id)
+{
+    buffer->can = obj;
+    buffer->handle = handle;
+    buffer->head = 0;
+    buffer->count = 0;
+    buffer->dropped = 0;
+    buffer->overruns = 0;
+    buffer->handler = handler;
+    buffer->id = id;
+    buffer->ranges = NULL;
+    buffer->range_count = 0;
+    buffer->range_format = CANAny;
+
+    can_capabilities_t cap;
+    can_get_capabilities(obj, &cap);
+    buffer->sw_timestamp = !cap.hw_timestamp;
+
+    can_irq_init(obj, can_rx_buffer_irq, (uint32_t)buffer);
+    can_irq_set(obj, IRQ_RX, 1);
+}
+
+int can_rx_buffer_filter(can_rx_buffer_t *buffer, const can_id_range_t *ranges, size_t count, CANFormat format)
+{
+    const int hardware = ranges != NULL && can_filter_ranges(buffer->can, ranges, count, format, buffer->handle);
+
+    core_util_critical_section_enter();
+    buffer->ranges = hardware ? NULL : ranges;
+    buffer->range_count = count;
+    buffer->range_format = format;
+    core_util_critical_section_exit();
+
+    return hardware;
+}
+
+void can_rx_buffer_free(can_rx_buffer_t *buffer)
+{
+    can_irq_set(buffer->can, IRQ_RX, 0);
+    can_irq_free(buffer->can);
+}
+
+int can_rx_buffer_read(can_rx_buffer_t *buffer, CAN_Message *msgs, int max)
+{
+    int read = 0;
+
+    core_util_critical_section_enter();
+    while (read < max && buffer->count != 0) {
+        size_t tail = (buffer->head + MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE - buffer->count) % MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE;
+        msgs[read] = buffer->msgs[tail];
+        buffer->count--;
+        read++;
+    }
+    core_util_critical_section_exit();
+
+    return read;
+}
+
+size_t can_rx_buffer_count(can_rx_buffer_t *buffer)
+{
+    core_util_critical_section_enter();
+    size_t count = buffer->count;
+    core_util_critical_section_exit();
+    return count;
+}
+
+uint32_t can_rx_buffer_dropped(can_rx_buffer_t *buffer)
+{
+    core_util_critical_section_enter();
+    uint32_t dropped = buffer->dropped;
+    core_util_critical_section_exit();
+    return dropped;
+}
+
+uint32_t can_rx_buffer_overruns(can_rx_buffer_t *buffer)
+{
+    core_util_critical_section_enter();
+    uint32_t overruns = buffer->overruns;
+    core_util_critical_section_exit();
+    return overruns;
+}
+
+/* Bus arbitration rank of a message, lowest first */
+static uint32_t can_tx_priority(const CAN_Message *msg)
+{
+    if (msg->format == CANExtended) {
+        return ((msg->id & 0x1FFFFFFF) << 1) | 1;
+    }
+    return (msg->id & 0x7FF) << (CAN_EXTENDED_BASE_SHIFT + 1);
+}
+
+/* Move the messages of highest priority to the free mailboxes, in a critical section */
+static void can_tx_queue_feed(can_tx_queue_t *queue)
+{
+    size_t sent = 0;
+    while (sent < queue->count && can_write(queue->can, queue->msgs[sent], 0)) {
+        sent++;
+    }
+    if (sent != 0) {
+        memmove(&queue->msgs[0], &queue->msgs[sent], (queue->count - sent) * sizeof(CAN_Message));
+        queue->count -= sent;
+    }
+}
+
+void can_tx_queue_irq(uint32_t id, CanIrqType type)
+{
+    can_tx_queue_t *queue = (can_tx_queue_t *)id;
+
+    if (type != IRQ_TX) {
+        if (queue->handler != NULL) {
+            queue->handler(queue->id, type);
+        }
+        return;
+    }
+
+    core_util_critical_section_enter();
+    can_tx_queue_feed(queue);
+    core_util_critical_section_exit();
+}
+
+void can_tx_queue_init(can_tx_queue_t *queue, can_t *obj, can_irq_handler handler, uint32_t id)
+{
+    queue->can = obj;
+    queue->count = 0;
+    queue->handler = handler;
+    queue->id = id;
+
+    can_irq_init(obj, can_tx_queue_irq, (uint32_t)queue);
+    can_irq_set(obj, IRQ_TX, 1);
+}
+
+void can_tx_queue_free(can_tx_queue_t *queue)
+{
+    can_irq_set(queue->can, IRQ_TX, 0);
+    can_irq_free(queue->can);
+    queue->count = 0;
+}
+
+int can_tx_queue_write(can_tx_queue_t *queue, const CAN_Message *msg)
+{
+    int queued = 0;
+
+    core_util_critical_section_enter();
+    if (queue->count < MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE) {
+        // Insert after the messages of the same or higher priority
+        const uint32_t priority = can_tx_priority(msg);
+        size_t position = queue->count;
+        while (position != 0 && can_tx_priority(&queue->msgs[position - 1]) > priority) {
+            queue->msgs[position] = queue->msgs[position - 1];
+            position--;
+        }
+        queue->msgs[position] = *msg;
+        queue->count++;
+        queued = 1;
+    }
+    // A mailbox may be free without a TX interrupt pending, if the queue was empty
+    can_tx_queue_feed(queue);
+    core_util_critical_section_exit();
+
+    return queued;
+}
+
+size_t can_tx_queue_count(can_tx_queue_t *queue)
+{
+    core_util_critical_section_enter();
+    size_t count = queue->count;
+    core_util_critical_section_exit();
+    return count;
+}
+
+#endif // DEVICE_CAN
@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/checksum_api.h"
+
+#include "cmsis.h"
+
+#include <stdbool.h>
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#endif
+
+/* The sums are of halfwords in the byte order of the core, little-endian,
+ * which gives the byte swapped sum of the network order halfwords (RFC 1071
+ * section 2 (B)). They are swapped back in network order on completion.
+ */
+
+static uint32_t fold(uint64_t sum)
+{
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return (uint32_t)sum;
+}
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+/* Four words are added at once across the lanes of a Helium vector, into a
+ * 64-bit sum, and the last vector is predicated so the loop has no tail. */
+static uint64_t sum_words(const uint32_t *words, size_t count)
+{
+    uint64_t sum = 0;
+
+    while (count > 0) {
+        const mve_pred16_t lanes = vctp32q(count);
+        sum = vaddlvaq_p_u32(sum, vld1q_z_u32(words, lanes), lanes);
+        words += 4;
+        count = count > 4 ? count - 4 : 0;
+    }
+    return sum;
+}
+#elif defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+/* Bytes 0 and 2 of each word are added to the halfwords of one accumulator,
+ * bytes 1 and 3 to another, which can take 256 words before overflowing. */
+static uint64_t sum_words(const uint32_t *words, size_t count)
+{
+    uint64_t sum = 0;
+
+    while (count > 0) {
+        const size_t block = count < 256 ? count : 256;
+        uint32_t low = 0;
+        uint32_t high = 0;
+
+        for (size_t i = 0; i < block; i++) {
+            const uint32_t word = words[i];
+            low = __UXTAB16(low, word);
+            high = __UXTAB16(high, __ROR(word, 8));
+        }
+        sum += (low & 0xFFFF) + (low >> 16) + (((high & 0xFFFF) + (high >> 16)) << 8);
+        words += block;
+        count -= block;
+    }
+    return sum;
+}
+#else
+static uint64_t sum_words(const uint32_t *words, size_t count)
+{
+    uint64_t sum = 0;
+
+    // The halfwords of each word are added at once, the carries in the top half
+    for (size_t i = 0; i < count; i++) {
+        sum += words[i];
+    }
+    return sum;
+}
+#endif
+
+uint32_t hal_inet_checksum_add(uint32_t sum, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    const bool odd = ((uintptr_t)bytes & 1) != 0;
+    uint64_t total = 0;
+
+    // Data at an odd address is summed from the next byte, the halfwords
+    // then straddle the ones of the data and the sum is swapped
+    if (odd && size > 0) {
+        total += (uint32_t)*bytes++ << 8;
+        size--;
+    }
+    if (((uintptr_t)bytes & 2) && size >= 2) {
+        total += bytes[0] | ((uint32_t)bytes[1] << 8);
+        bytes += 2;
+        size -= 2;
+    }
+
+    total += sum_words((const uint32_t *)bytes, size / 4);
+    bytes += size & ~(size_t)3;
+    if (size & 2) {
+        total += bytes[0] | ((uint32_t)bytes[1] << 8);
+        bytes += 2;
+    }
+    if (size & 1) {
+        total += bytes[0];
+    }
+
+    uint32_t folded = fold(total);
+    if (odd) {
+        folded = ((folded & 0xFF) << 8) | (folded >> 8);
+    }
+    // Back in network order, where the sum of the previous calls is
+    folded = ((folded & 0xFF) << 8) | (folded >> 8);
+    return fold((uint64_t)sum + folded);
+}
+
+uint16_t hal_inet_checksum_finish(uint32_t sum)
+{
+    const uint32_t folded = ~fold(sum) & 0xFFFF;
+    // In network order in memory
+    return (uint16_t)(((folded & 0xFF) << 8) | (folded >> 8));
+}
+
+uint16_t hal_inet_checksum(const void *data, size_t size)
+{
+    return hal_inet_checksum_finish(hal_inet_checksum_add(0, data, size));
+}
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/clock_api.h"
+
+#if DEVICE_CLOCK_SCALING
+
+#include <stddef.h>
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_wait_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+static hal_clock_notifier_t *notifiers;
+
+static void notify(hal_clock_event_t event)
+{
+    for (hal_clock_notifier_t *notifier = notifiers; notifier != NULL; notifier = notifier->next) {
+        notifier->handler(notifier->id, event);
+    }
+}
+
+void hal_clock_notifier_add(hal_clock_notifier_t *notifier, hal_clock_handler handler, uint32_t id)
+{
+    notifier->handler = handler;
+    notifier->id = id;
+    notifier->next = NULL;
+
+    core_util_critical_section_enter();
+    hal_clock_notifier_t **last = &notifiers;
+    while (*last != NULL) {
+        last = &(*last)->next;
+    }
+    *last = notifier;
+    core_util_critical_section_exit();
+}
+
+void hal_clock_notifier_remove(hal_clock_notifier_t *notifier)
+{
+    core_util_critical_section_enter();
+    for (hal_clock_notifier_t **node = &notifiers; *node != NULL; node = &(*node)->next) {
+        if (*node == notifier) {
+            *node = notifier->next;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+int hal_clock_set_core_frequency(uint32_t frequency)
+{
+    notify(HAL_CLOCK_PRE_CHANGE);
+
+    core_util_critical_section_enter();
+#if DEVICE_USTICKER
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+    const bool us_ticker_running = us_ticker->queue->initialized;
+#if DEVICE_LPTICKER
+    // Measures the time the us ticker is suspended
+    const ticker_data_t *const lp_ticker = get_lp_ticker_data();
+    us_timestamp_t start = 0;
+#endif
+    if (us_ticker_running) {
+        // Bring the time up to date with the ticks at the old frequency
+        ticker_read_us(us_ticker);
+        ticker_suspend(us_ticker);
+#if DEVICE_LPTICKER
+        start = ticker_read_us(lp_ticker);
+#endif
+    }
+#endif
+
+    const int ret = hal_clock_configure(frequency);
+
+#if DEVICE_USTICKER
+    if (us_ticker_running) {
+        us_timestamp_t elapsed_us = 0;
+#if DEVICE_LPTICKER
+        elapsed_us = ticker_read_us(lp_ticker) - start;
+#endif
+        ticker_update_timing(us_ticker);
+        ticker_resume_compensated(us_ticker, elapsed_us);
+    }
+#endif
+    core_util_critical_section_exit();
+
+#ifdef __CORTEX_M
+    if (ret == 0) {
+        wait_ns_calibrate();
+    }
+#endif
+
+    notify(HAL_CLOCK_POST_CHANGE);
+    return ret;
+}
+
+#endif // DEVICE_CLOCK_SCALING
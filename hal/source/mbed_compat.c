@@ -53,6 +53,8 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
         cap->word_length = 0x00008080;              // 8 and 16 bit symbols
         cap->support_slave_mode = false;            // to be determined later based on ssel
         cap->hw_cs_handle = false;                  // irrelevant in slave mode
+        cap->hw_cs_modes = 0;                       // irrelevant in slave mode
+        cap->hw_cs_delay_max_ns = 0;                // irrelevant in slave mode
         cap->slave_delay_between_symbols_ns = 2500; // 2.5 us
         cap->clk_modes = 0x0f;                      // all clock modes
         cap->tx_rx_buffers_equal_length = true;     // rx buffer size must be equal tx buffer size
@@ -67,6 +69,8 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
         cap->word_length = 0x00008080;            // 8 and 16 bit symbols
         cap->support_slave_mode = false;          // to be determined later based on ssel
         cap->hw_cs_handle = false;                // to be determined later based on ssel
+        cap->hw_cs_modes = 0;                     // spi_cs_config is not supported
+        cap->hw_cs_delay_max_ns = 0;              // spi_cs_config is not supported
         cap->slave_delay_between_symbols_ns = 0;  // irrelevant in master mode
         cap->clk_modes = 0x0f;                    // all clock modes
         cap->tx_rx_buffers_equal_length = true;   // rx buffer size must be equal tx buffer size
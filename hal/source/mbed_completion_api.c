@@ -0,0 +1,225 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/completion_api.h"
+
+#include "bootstrap/mbed_critical.h"
+
+#if MBED_CONF_TARGET_COMPLETION_TRANSFERS > 8
+#error "MBED_CONF_TARGET_COMPLETION_TRANSFERS must be at most 8"
+#endif
+
+void hal_completion_queue_init(hal_completion_queue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+}
+
+bool hal_completion_post(hal_completion_queue_t *queue, uint8_t source, uint32_t id, uint32_t events)
+{
+    bool posted = false;
+
+    // interrupts of different priorities may post to the queue
+    core_util_critical_section_enter();
+    const uint32_t head = queue->head;
+    if (head - queue->tail < MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE) {
+        hal_completion_t *completion = &queue->entries[head & (MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE - 1)];
+        completion->id = id;
+        completion->events = events;
+        completion->source = source;
+        queue->head = head + 1;
+        posted = true;
+    } else {
+        queue->dropped++;
+    }
+    core_util_critical_section_exit();
+
+    return posted;
+}
+
+bool hal_completion_pop(hal_completion_queue_t *queue, hal_completion_t *completion)
+{
+    const uint32_t tail = queue->tail;
+    if (tail == queue->head) {
+        return false;
+    }
+    *completion = queue->entries[tail & (MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE - 1)];
+    queue->tail = tail + 1;
+    return true;
+}
+
+size_t hal_completion_drain(hal_completion_queue_t *queue, hal_completion_t *completions, size_t max)
+{
+    uint32_t tail = queue->tail;
+    const uint32_t head = queue->head;
+    size_t count = 0;
+
+    while (tail != head && count < max) {
+        completions[count++] = queue->entries[tail & (MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE - 1)];
+        tail++;
+    }
+    queue->tail = tail;
+    return count;
+}
+
+uint32_t hal_completion_dropped(const hal_completion_queue_t *queue)
+{
+    return queue->dropped;
+}
+
+#if DEVICE_SPI_ASYNCH || DEVICE_I2C_ASYNCH || DEVICE_SERIAL_ASYNCH
+
+/* Transfer in progress. The handler given to the peripheral takes no
+ * parameter, so each transfer has its own handler, finding it in the table.
+ */
+typedef struct {
+    hal_completion_queue_t *queue;
+    void *obj;
+    uint32_t id;
+    uint32_t mask;
+    uint8_t source;
+    bool used;
+} completion_transfer_t;
+
+static completion_transfer_t transfers[MBED_CONF_TARGET_COMPLETION_TRANSFERS];
+
+static void transfer_irq(completion_transfer_t *transfer)
+{
+    uint32_t events = 0;
+
+    switch (transfer->source) {
+#if DEVICE_SPI_ASYNCH
+        case HAL_COMPLETION_SPI:
+            events = spi_irq_handler_asynch((spi_t *)transfer->obj);
+            break;
+#endif
+#if DEVICE_I2C_ASYNCH
+        case HAL_COMPLETION_I2C:
+            events = i2c_irq_handler_asynch((i2c_t *)transfer->obj);
+            break;
+#endif
+#if DEVICE_SERIAL_ASYNCH
+        case HAL_COMPLETION_SERIAL_TX:
+        case HAL_COMPLETION_SERIAL_RX:
+            events = (uint32_t)serial_irq_handler_asynch((serial_t *)transfer->obj);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (transfer->used && (events & transfer->mask)) {
+        transfer->used = false;
+        hal_completion_post(transfer->queue, transfer->source, transfer->id, events);
+    }
+}
+
+#define TRANSFER_HANDLER(n) \
+    static void transfer_handler_##n(void) \
+    { \
+        transfer_irq(&transfers[n]); \
+    }
+
+TRANSFER_HANDLER(0)
+TRANSFER_HANDLER(1)
+TRANSFER_HANDLER(2)
+TRANSFER_HANDLER(3)
+TRANSFER_HANDLER(4)
+TRANSFER_HANDLER(5)
+TRANSFER_HANDLER(6)
+TRANSFER_HANDLER(7)
+
+static void (*const transfer_handlers[8])(void) = {
+    transfer_handler_0, transfer_handler_1, transfer_handler_2, transfer_handler_3,
+    transfer_handler_4, transfer_handler_5, transfer_handler_6, transfer_handler_7
+};
+
+/* Claim a transfer, return the address of its handler, 0 if none is free */
+static uint32_t claim_transfer(hal_completion_queue_t *queue, uint8_t source, void *obj, uint32_t mask, uint32_t id)
+{
+    uint32_t handler = 0;
+
+    core_util_critical_section_enter();
+    for (int i = 0; i < MBED_CONF_TARGET_COMPLETION_TRANSFERS; i++) {
+        completion_transfer_t *transfer = &transfers[i];
+        if (!transfer->used) {
+            transfer->queue = queue;
+            transfer->obj = obj;
+            transfer->id = id;
+            transfer->mask = mask;
+            transfer->source = source;
+            transfer->used = true;
+            handler = (uint32_t)transfer_handlers[i];
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return handler;
+}
+
+#endif // DEVICE_SPI_ASYNCH || DEVICE_I2C_ASYNCH || DEVICE_SERIAL_ASYNCH
+
+#if DEVICE_SPI_ASYNCH
+int hal_completion_spi_transfer(hal_completion_queue_t *queue, spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length,
+                                uint8_t bit_width, uint32_t event, uint32_t id)
+{
+    const uint32_t handler = claim_transfer(queue, HAL_COMPLETION_SPI, obj, event, id);
+    if (!handler) {
+        return -1;
+    }
+    spi_master_transfer(obj, tx, tx_length, rx, rx_length, bit_width, handler, event);
+    return 0;
+}
+#endif
+
+#if DEVICE_I2C_ASYNCH
+int hal_completion_i2c_transfer(hal_completion_queue_t *queue, i2c_t *obj, uint32_t address, const void *tx, size_t tx_length,
+                                void *rx, size_t rx_length, bool stop, uint32_t event, uint32_t id)
+{
+    const uint32_t handler = claim_transfer(queue, HAL_COMPLETION_I2C, obj, event, id);
+    if (!handler) {
+        return -1;
+    }
+    i2c_transfer_asynch(obj, tx, tx_length, rx, rx_length, address, stop, handler, event);
+    return 0;
+}
+#endif
+
+#if DEVICE_SERIAL_ASYNCH
+int hal_completion_serial_tx(hal_completion_queue_t *queue, serial_t *obj, const void *tx, size_t length, uint8_t width,
+                             uint32_t event, uint32_t id)
+{
+    const uint32_t handler = claim_transfer(queue, HAL_COMPLETION_SERIAL_TX, obj, event, id);
+    if (!handler) {
+        return -1;
+    }
+    serial_tx_asynch(obj, tx, length, width, handler, event);
+    return 0;
+}
+
+int hal_completion_serial_rx(hal_completion_queue_t *queue, serial_t *obj, void *rx, size_t length, uint8_t width,
+                             uint32_t event, uint8_t char_match, uint32_t id)
+{
+    const uint32_t handler = claim_transfer(queue, HAL_COMPLETION_SERIAL_RX, obj, event, id);
+    if (!handler) {
+        return -1;
+    }
+    serial_rx_asynch(obj, rx, length, width, handler, event, char_match);
+    return 0;
+}
+#endif
@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/crc_api.h"
+
+#if DEVICE_CRC
+
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+
+static uint32_t crc_mask(uint32_t width)
+{
+    return width < 32 ? (1UL << width) - 1 : 0xFFFFFFFF;
+}
+
+static uint32_t crc_reflect(uint32_t value, uint32_t width)
+{
+    uint32_t reflected = 0;
+    for (uint32_t i = 0; i < width; i++) {
+        reflected = (reflected << 1) | (value & 1);
+        value >>= 1;
+    }
+    return reflected;
+}
+
+MBED_WEAK void hal_crc_ctx_start(hal_crc_ctx_t *ctx, const crc_mbed_config_t *config)
+{
+    ctx->config = *config;
+    ctx->state = config->initial_xor & crc_mask(config->width);
+}
+
+MBED_WEAK void hal_crc_ctx_update(hal_crc_ctx_t *ctx, const uint8_t *data, size_t size)
+{
+    if ((data == NULL) || (size == 0)) {
+        return;
+    }
+
+    // the remainder so far is the seed of the continued computation
+    crc_mbed_config_t config = ctx->config;
+    config.initial_xor = ctx->state;
+
+    core_util_critical_section_enter();
+    hal_crc_compute_partial_start(&config);
+    hal_crc_compute_partial(data, size);
+    uint32_t result = hal_crc_get_result();
+    core_util_critical_section_exit();
+
+    // undo the final transformations to get the remainder back
+    result = (result ^ config.final_xor) & crc_mask(config.width);
+    ctx->state = config.reflect_out ? crc_reflect(result, config.width) : result;
+}
+
+MBED_WEAK int hal_crc_ctx_update_async(hal_crc_ctx_t *ctx, const uint8_t *data, size_t size,
+                                       hal_crc_async_handler handler, uint32_t id)
+{
+    hal_crc_ctx_update(ctx, data, size);
+    handler(id);
+    return 0;
+}
+
+MBED_WEAK uint32_t hal_crc_ctx_get_result(const hal_crc_ctx_t *ctx)
+{
+    const crc_mbed_config_t *config = &ctx->config;
+    const uint32_t result = config->reflect_out ? crc_reflect(ctx->state, config->width) : ctx->state;
+    return (result ^ config->final_xor) & crc_mask(config->width);
+}
+
+#endif // DEVICE_CRC
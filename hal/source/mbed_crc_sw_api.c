@@ -0,0 +1,176 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/crc_sw_api.h"
+
+/* Reflected configurations keep the remainder reflected and LSB aligned, the
+ * others keep it MSB aligned in 32 bits, so that any width uses byte tables.
+ */
+
+static uint32_t crc_sw_mask(uint32_t width)
+{
+    return width < 32 ? (1UL << width) - 1 : 0xFFFFFFFF;
+}
+
+static uint32_t crc_sw_reflect(uint32_t value, uint32_t width)
+{
+    uint32_t reflected = 0;
+    for (uint32_t i = 0; i < width; i++) {
+        reflected = (reflected << 1) | (value & 1);
+        value >>= 1;
+    }
+    return reflected;
+}
+
+static uint32_t crc_sw_shift(uint32_t state, uint32_t poly, uint32_t bits, bool reflect)
+{
+    for (uint32_t i = 0; i < bits; i++) {
+        if (reflect) {
+            state = (state & 1) ? (state >> 1) ^ poly : state >> 1;
+        } else {
+            state = (state & 0x80000000) ? (state << 1) ^ poly : state << 1;
+        }
+    }
+    return state;
+}
+
+int crc_sw_table_init(uint32_t *table, uint32_t slices, const crc_mbed_config_t *config)
+{
+    const bool reflect = config->reflect_in;
+    const uint32_t width = config->width;
+
+    if ((width == 0) || (width > 32) || ((slices != 0) && (slices != 1) && (slices != 4) && (slices != 8))) {
+        return -1;
+    }
+
+    const uint32_t poly = reflect ? crc_sw_reflect(config->polynomial, width) :
+                          (config->polynomial & crc_sw_mask(width)) << (32 - width);
+
+    if (slices == 0) {
+        for (uint32_t n = 0; n < 16; n++) {
+            table[n] = crc_sw_shift(reflect ? n : n << 28, poly, 4, reflect);
+        }
+        return 0;
+    }
+
+    for (uint32_t b = 0; b < 256; b++) {
+        table[b] = crc_sw_shift(reflect ? b : b << 24, poly, 8, reflect);
+    }
+    for (uint32_t k = 1; k < slices; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            const uint32_t prev = table[(k - 1) * 256 + b];
+            table[k * 256 + b] = reflect ? (prev >> 8) ^ table[prev & 0xFF] : (prev << 8) ^ table[prev >> 24];
+        }
+    }
+    return 0;
+}
+
+void crc_sw_ctx_start(crc_sw_ctx_t *ctx, const crc_mbed_config_t *config, const uint32_t *table, uint32_t slices)
+{
+    const uint32_t init = config->initial_xor & crc_sw_mask(config->width);
+
+    ctx->config = *config;
+    ctx->table = table;
+    ctx->slices = slices;
+    ctx->state = config->reflect_in ? crc_sw_reflect(init, config->width) : init << (32 - config->width);
+}
+
+static uint32_t crc_sw_update_reflected(const uint32_t *t, uint32_t slices, uint32_t state, const uint8_t *p, size_t size)
+{
+    if (slices == 0) {
+        for (; size > 0; size--, p++) {
+            state = t[(state ^ *p) & 0xF] ^ (state >> 4);
+            state = t[(state ^ (*p >> 4)) & 0xF] ^ (state >> 4);
+        }
+        return state;
+    }
+
+    if (slices == 8) {
+        for (; size >= 8; size -= 8, p += 8) {
+            const uint32_t x = state ^ (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+            state = t[7 * 256 + (x & 0xFF)] ^ t[6 * 256 + ((x >> 8) & 0xFF)] ^
+                    t[5 * 256 + ((x >> 16) & 0xFF)] ^ t[4 * 256 + (x >> 24)] ^
+                    t[3 * 256 + p[4]] ^ t[2 * 256 + p[5]] ^ t[256 + p[6]] ^ t[p[7]];
+        }
+    } else if (slices == 4) {
+        for (; size >= 4; size -= 4, p += 4) {
+            const uint32_t x = state ^ (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+            state = t[3 * 256 + (x & 0xFF)] ^ t[2 * 256 + ((x >> 8) & 0xFF)] ^
+                    t[256 + ((x >> 16) & 0xFF)] ^ t[x >> 24];
+        }
+    }
+
+    for (; size > 0; size--, p++) {
+        state = t[(state ^ *p) & 0xFF] ^ (state >> 8);
+    }
+    return state;
+}
+
+static uint32_t crc_sw_update_normal(const uint32_t *t, uint32_t slices, uint32_t state, const uint8_t *p, size_t size)
+{
+    if (slices == 0) {
+        for (; size > 0; size--, p++) {
+            state = (state << 4) ^ t[(state >> 28) ^ (*p >> 4)];
+            state = (state << 4) ^ t[(state >> 28) ^ (*p & 0xF)];
+        }
+        return state;
+    }
+
+    if (slices == 8) {
+        for (; size >= 8; size -= 8, p += 8) {
+            const uint32_t x = state ^ (((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]);
+            state = t[7 * 256 + (x >> 24)] ^ t[6 * 256 + ((x >> 16) & 0xFF)] ^
+                    t[5 * 256 + ((x >> 8) & 0xFF)] ^ t[4 * 256 + (x & 0xFF)] ^
+                    t[3 * 256 + p[4]] ^ t[2 * 256 + p[5]] ^ t[256 + p[6]] ^ t[p[7]];
+        }
+    } else if (slices == 4) {
+        for (; size >= 4; size -= 4, p += 4) {
+            const uint32_t x = state ^ (((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]);
+            state = t[3 * 256 + (x >> 24)] ^ t[2 * 256 + ((x >> 16) & 0xFF)] ^
+                    t[256 + ((x >> 8) & 0xFF)] ^ t[x & 0xFF];
+        }
+    }
+
+    for (; size > 0; size--, p++) {
+        state = (state << 8) ^ t[(state >> 24) ^ *p];
+    }
+    return state;
+}
+
+void crc_sw_ctx_update(crc_sw_ctx_t *ctx, const uint8_t *data, size_t size)
+{
+    if ((data == NULL) || (size == 0)) {
+        return;
+    }
+
+    if (ctx->config.reflect_in) {
+        ctx->state = crc_sw_update_reflected(ctx->table, ctx->slices, ctx->state, data, size);
+    } else {
+        ctx->state = crc_sw_update_normal(ctx->table, ctx->slices, ctx->state, data, size);
+    }
+}
+
+uint32_t crc_sw_ctx_get_result(const crc_sw_ctx_t *ctx)
+{
+    const crc_mbed_config_t *config = &ctx->config;
+
+    // back to the plain remainder, then apply the final transformations
+    uint32_t result = config->reflect_in ? crc_sw_reflect(ctx->state, config->width) : ctx->state >> (32 - config->width);
+    if (config->reflect_out) {
+        result = crc_sw_reflect(result, config->width);
+    }
+    return (result ^ config->final_xor) & crc_sw_mask(config->width);
+}
@@ -21,46 +21,153 @@
 
 #include <stdbool.h>
 
-static bool critical_interrupts_enabled = false;
-static bool state_saved = false;
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY && \
+    ((__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || \
+     (__ARM_ARCH_8M_MAIN__ == 1U) || (__ARM_ARCH_8_1M_MAIN__ == 1U))
+#define CRITICAL_SECTION_BASEPRI \
+    ((uint32_t)MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY << (8U - __NVIC_PRIO_BITS))
+#endif
+
+/* Set while in a critical section, the other bits hold the interrupt mask to
+ * restore on exit: the previous BASEPRI value, or 1 if interrupts were
+ * disabled with PRIMASK. */
+#define CRITICAL_STATE_SAVED (1UL << 31)
+
+static uint32_t critical_state = 0;
+
+#ifdef CRITICAL_SECTION_BASEPRI
 
-static bool are_interrupts_enabled(void)
+MBED_RAMFUNC static uint32_t mask_interrupts(void)
 {
-#if defined(__CORTEX_A9)
-    return ((__get_CPSR() & 0x80) == 0);
+    const uint32_t basepri = __get_BASEPRI();
+
+#if defined(__CORTEX_M7)
+    // Cortex-M7 r0p1 erratum 837070: an interrupt can still be taken right
+    // after BASEPRI is raised, unless PRIMASK is set around the change
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    __set_BASEPRI_MAX(CRITICAL_SECTION_BASEPRI);
+    __set_PRIMASK(primask);
 #else
-    return ((__get_PRIMASK() & 0x1) == 0);
+    __set_BASEPRI_MAX(CRITICAL_SECTION_BASEPRI);
 #endif
+
+    return basepri;
+}
+
+MBED_RAMFUNC static bool are_interrupts_masked(void)
+{
+    return __get_BASEPRI() != 0;
+}
+
+MBED_RAMFUNC static void restore_interrupts(uint32_t mask)
+{
+    __set_BASEPRI(mask);
 }
 
+#else
+
+MBED_RAMFUNC static bool are_interrupts_masked(void)
+{
+#if defined(__CORTEX_A9)
+    return ((__get_CPSR() & 0x80) != 0);
+#else
+    return ((__get_PRIMASK() & 0x1) != 0);
+#endif
+}
 
-MBED_WEAK void hal_critical_section_enter(void)
+MBED_RAMFUNC static uint32_t mask_interrupts(void)
 {
-    const bool interrupt_state = are_interrupts_enabled();
+    const uint32_t mask = are_interrupts_masked() ? 1 : 0;
 
     __disable_irq();
 
-    if (state_saved == true) {
+    return mask;
+}
+
+MBED_RAMFUNC static void restore_interrupts(uint32_t mask)
+{
+    if (mask == 0) {
+        __enable_irq();
+    }
+}
+
+#endif // CRITICAL_SECTION_BASEPRI
+
+MBED_WEAK MBED_RAMFUNC void hal_critical_section_enter(void)
+{
+    const uint32_t mask = mask_interrupts();
+
+    if (critical_state & CRITICAL_STATE_SAVED) {
         return;
     }
 
-    critical_interrupts_enabled = interrupt_state;
-    state_saved = true;
+    critical_state = CRITICAL_STATE_SAVED | mask;
 }
 
-MBED_WEAK void hal_critical_section_exit(void)
+MBED_WEAK MBED_RAMFUNC void hal_critical_section_exit(void)
 {
-    // Interrupts must be disabled on invoking an exit from a critical section
-    MBED_ASSERT(!are_interrupts_enabled());
-    state_saved = false;
+    // Interrupts must be masked on invoking an exit from a critical section
+    MBED_ASSERT(are_interrupts_masked());
+    const uint32_t mask = critical_state & ~CRITICAL_STATE_SAVED;
+    critical_state = 0;
 
     // Restore the IRQs to their state prior to entering the critical section
-    if (critical_interrupts_enabled == true) {
-        __enable_irq();
-    }
+    restore_interrupts(mask);
 }
 
 MBED_WEAK bool hal_in_critical_section(void)
 {
-    return (state_saved == true);
+    return (critical_state & CRITICAL_STATE_SAVED) != 0;
+}
+
+MBED_WEAK bool hal_critical_section_masks_priority(uint32_t priority)
+{
+#if defined(__NVIC_PRIO_BITS)
+    if (priority >= (1UL << __NVIC_PRIO_BITS)) {
+        return false;
+    }
+#endif
+#ifdef CRITICAL_SECTION_BASEPRI
+    return priority >= MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY;
+#else
+    return true;
+#endif
+}
+
+MBED_WEAK bool hal_critical_section_masks_caller(void)
+{
+#ifdef CRITICAL_SECTION_BASEPRI
+    const uint32_t exception = __get_IPSR();
+
+    if (exception == 0) {
+        return true;
+    }
+    // NMI and HardFault have fixed priorities, higher than any BASEPRI
+    if (exception <= 3) {
+        return false;
+    }
+    return NVIC_GetPriority((IRQn_Type)((int32_t)exception - 16)) >= MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY;
+#else
+    return true;
+#endif
+}
+
+MBED_WEAK MBED_RAMFUNC void hal_critical_section_sleep(void (*sleep)(void))
+{
+    // Sleeping outside a critical section could miss the wake-up interrupt
+    MBED_ASSERT(are_interrupts_masked());
+
+#ifdef CRITICAL_SECTION_BASEPRI
+    // WFI ignores PRIMASK, but not BASEPRI, to decide whether to wake up
+    const uint32_t primask = __get_PRIMASK();
+    const uint32_t basepri = __get_BASEPRI();
+    __disable_irq();
+    __set_BASEPRI(0);
+    sleep();
+    __set_BASEPRI(basepri);
+    __set_PRIMASK(primask);
+#else
+    sleep();
+#endif
 }
@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/cycle_counter_api.h"
+
+#if DEVICE_CYCLE_COUNTER
+
+#define DWT_ENABLE_WRITE 0xC5ACCE55
+
+void hal_cycle_counter_init(void)
+{
+    /* Enable the DWT and ITM blocks */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+#if defined(__CORTEX_M7)
+    /* Unlock write access to the DWT registers */
+    DWT->LAR = DWT_ENABLE_WRITE;
+#endif
+
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+#if MBED_CONF_TARGET_CUSTOM_TICKERS
+
+static ticker_info_t cycle_counter_info = {
+    .frequency = 0,
+    .bits = 32
+};
+
+static void cycle_counter_ticker_init(void)
+{
+    hal_cycle_counter_init();
+    cycle_counter_info.frequency = SystemCoreClock;
+}
+
+static uint32_t cycle_counter_ticker_read(void)
+{
+    return hal_cycle_counter_read();
+}
+
+static void cycle_counter_ticker_set_interrupt(timestamp_t timestamp)
+{
+    /* The cycle counter has no compare interrupt */
+    (void)timestamp;
+}
+
+static void cycle_counter_ticker_nop(void)
+{
+}
+
+static const ticker_info_t *cycle_counter_ticker_get_info(void)
+{
+    return &cycle_counter_info;
+}
+
+static ticker_event_queue_t events = { 0 };
+
+static const ticker_interface_t cycle_counter_interface = {
+    .init = cycle_counter_ticker_init,
+    .read = cycle_counter_ticker_read,
+    .disable_interrupt = cycle_counter_ticker_nop,
+    .clear_interrupt = cycle_counter_ticker_nop,
+    .set_interrupt = cycle_counter_ticker_set_interrupt,
+    .fire_interrupt = cycle_counter_ticker_nop,
+    .get_info = cycle_counter_ticker_get_info,
+    .free = cycle_counter_ticker_nop,
+    .runs_in_deep_sleep = false,
+};
+
+static const ticker_data_t cycle_counter_data = {
+    .interface = &cycle_counter_interface,
+    .queue = &events
+};
+
+const ticker_data_t *get_cycle_counter_ticker_data(void)
+{
+    return &cycle_counter_data;
+}
+
+#endif // MBED_CONF_TARGET_CUSTOM_TICKERS
+
+#endif // DEVICE_CYCLE_COUNTER
@@ -0,0 +1,309 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/decompress_api.h"
+
+#include <string.h>
+
+/* Tags of the pithy format, the two low bits of the first byte of an element:
+ * - literal: the length minus one in the six high bits, or 60 to 63 for a
+ *   length of 1 to 4 more bytes, then the bytes
+ * - copy with a one byte offset: length minus 4 in bits 2 to 4, offset
+ *   bits 8 to 10 in bits 5 to 7, then offset bits 0 to 7
+ * - copy with a two or three byte offset: the length minus one in the six
+ *   high bits, then the offset. A length of 63 is followed by one more byte
+ *   of length, 64 by a two byte length.
+ * All the multi byte fields are little-endian.
+ */
+#define TAG_LITERAL 0
+#define LITERAL_LENGTH_BYTES_BASE 60
+#define COPY_LENGTH_BYTE 63
+#define COPY_LENGTH_HALFWORD 64
+
+/* The output: a buffer holding the whole output in memory, or the part not
+ * yet programmed in flash.
+ */
+typedef struct {
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t used;
+    uint32_t flushed;
+    uint32_t length;
+#if DEVICE_FLASH
+    flash_t *flash;
+    uint32_t address;
+    uint32_t erased;
+#endif
+} output_t;
+
+static uint32_t load_le(const uint8_t *data, unsigned bytes)
+{
+    uint32_t value = 0;
+
+    for (unsigned i = 0; i < bytes; i++) {
+        value |= (uint32_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+// Variable length: seven bits per byte, least significant first
+static const uint8_t *parse_length(const uint8_t *data, const uint8_t *end, size_t *length)
+{
+    uint32_t value = 0;
+
+    for (unsigned shift = 0; shift <= 28; shift += 7) {
+        if (data >= end) {
+            return NULL;
+        }
+        const uint8_t byte = *data++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (byte < (shift == 28 ? 0x10 : 0x80)) {
+            *length = value;
+            return data;
+        }
+    }
+    return NULL;
+}
+
+#if DEVICE_FLASH
+static int flush(output_t *out)
+{
+    const uint32_t page = flash_get_page_size(out->flash);
+    const uint32_t address = out->address + out->flushed;
+    uint32_t size = out->used;
+
+    // The last page is padded with the erase value
+    if ((size % page) != 0) {
+        memset(out->buffer + size, flash_get_erase_value(out->flash), page - size % page);
+        size += page - size % page;
+    }
+
+    while (out->erased < address + size) {
+        const uint32_t sector = flash_get_sector_size(out->flash, out->erased);
+        if (sector == MBED_FLASH_INVALID_SIZE) {
+            return -1;
+        }
+        if (flash_is_blank(out->flash, out->erased, sector) != 1 && flash_erase_sector(out->flash, out->erased) != 0) {
+            return -1;
+        }
+        out->erased += sector;
+    }
+
+    if (flash_program(out->flash, address, out->buffer, size) != 0) {
+        return -1;
+    }
+    out->flushed += out->used;
+    out->used = 0;
+    return 0;
+}
+#endif
+
+static int advance(output_t *out, uint32_t size)
+{
+    out->used += size;
+#if DEVICE_FLASH
+    if (out->flash != NULL && out->used == out->size) {
+        return flush(out);
+    }
+#endif
+    return 0;
+}
+
+static int emit_literal(output_t *out, const uint8_t *data, uint32_t size)
+{
+    while (size > 0) {
+        const uint32_t space = out->size - out->used;
+        const uint32_t n = size < space ? size : space;
+
+        memcpy(out->buffer + out->used, data, n);
+        data += n;
+        size -= n;
+        if (advance(out, n) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int emit_copy(output_t *out, uint32_t offset, uint32_t size)
+{
+    while (size > 0) {
+        uint8_t *to = out->buffer + out->used;
+        const uint32_t space = out->size - out->used;
+        uint32_t n = size < space ? size : space;
+
+        if (offset <= out->used) {
+            const uint8_t *from = to - offset;
+            if (offset >= n) {
+                memcpy(to, from, n);
+            } else if (offset == 1) {
+                memset(to, *from, n);
+            } else {
+                // The copy repeats the bytes it writes
+                for (uint32_t i = 0; i < n; i++) {
+                    to[i] = from[i];
+                }
+            }
+        } else {
+#if DEVICE_FLASH
+            // Output already programmed, read up to the start of the buffer
+            const uint32_t from = out->address + out->flushed + out->used - offset;
+            if (n > offset - out->used) {
+                n = offset - out->used;
+            }
+            if (flash_read(out->flash, from, to, n) != 0) {
+                return -1;
+            }
+#else
+            return -1;
+#endif
+        }
+
+        size -= n;
+        if (advance(out, n) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// The compressor pads the data, which is ignored once the output is complete
+static int decode(const uint8_t *data, const uint8_t *end, output_t *out)
+{
+    while (data < end && out->flushed + out->used < out->length) {
+        const uint8_t tag = *data++;
+        const unsigned extra = tag & 3;
+        const uint32_t produced = out->flushed + out->used;
+        uint32_t size;
+
+        if (extra == TAG_LITERAL) {
+            size = (tag >> 2) + 1;
+            if (size > LITERAL_LENGTH_BYTES_BASE) {
+                const unsigned bytes = size - LITERAL_LENGTH_BYTES_BASE;
+                if ((size_t)(end - data) < bytes) {
+                    return -1;
+                }
+                size = load_le(data, bytes) + 1;
+                data += bytes;
+            }
+            if ((size_t)(end - data) < size || out->length - produced < size) {
+                return -1;
+            }
+            if (emit_literal(out, data, size) != 0) {
+                return -1;
+            }
+            data += size;
+        } else {
+            if ((size_t)(end - data) < extra) {
+                return -1;
+            }
+            uint32_t offset = load_le(data, extra);
+            data += extra;
+
+            if (extra == 1) {
+                offset |= (uint32_t)(tag >> 5) << 8;
+                size = ((tag >> 2) & 7) + 4;
+            } else {
+                size = (tag >> 2) + 1;
+                if (size == COPY_LENGTH_BYTE) {
+                    if (data >= end) {
+                        return -1;
+                    }
+                    size = *data++ + COPY_LENGTH_BYTE;
+                } else if (size == COPY_LENGTH_HALFWORD) {
+                    if ((size_t)(end - data) < 2) {
+                        return -1;
+                    }
+                    size = load_le(data, 2);
+                    data += 2;
+                }
+            }
+            if (offset == 0 || offset > produced || size == 0 || out->length - produced < size) {
+                return -1;
+            }
+            if (emit_copy(out, offset, size) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return out->flushed + out->used == out->length ? 0 : -1;
+}
+
+int hal_decompress_get_length(const uint8_t *compressed, size_t size, size_t *length)
+{
+    return parse_length(compressed, compressed + size, length) != NULL ? 0 : -1;
+}
+
+int hal_decompress(const uint8_t *compressed, size_t size, uint8_t *output, size_t output_size)
+{
+    const uint8_t *const end = compressed + size;
+    size_t length;
+
+    compressed = parse_length(compressed, end, &length);
+    if (compressed == NULL || length > output_size) {
+        return -1;
+    }
+
+    output_t out = { 0 };
+    out.buffer = output;
+    out.size = length;
+    out.length = length;
+    return decode(compressed, end, &out);
+}
+
+#if DEVICE_FLASH
+static uint8_t flash_buffer[MBED_CONF_TARGET_DECOMPRESS_BUFFER_SIZE];
+
+int hal_decompress_to_flash(flash_t *obj, uint32_t address, const uint8_t *compressed, size_t size)
+{
+    const uint8_t *const end = compressed + size;
+    const uint32_t start = flash_get_start_address(obj);
+    const uint32_t page = flash_get_page_size(obj);
+    size_t length;
+
+    compressed = parse_length(compressed, end, &length);
+    if (compressed == NULL || page > sizeof(flash_buffer) || address < start ||
+            length > start + flash_get_size(obj) - address) {
+        return -1;
+    }
+
+    // The sectors are erased from the address on, which must start one
+    uint32_t sector = start;
+    while (sector < address) {
+        const uint32_t sector_size = flash_get_sector_size(obj, sector);
+        if (sector_size == MBED_FLASH_INVALID_SIZE) {
+            return -1;
+        }
+        sector += sector_size;
+    }
+    if (sector != address) {
+        return -1;
+    }
+
+    output_t out = { 0 };
+    out.buffer = flash_buffer;
+    out.size = sizeof(flash_buffer) - sizeof(flash_buffer) % page;
+    out.length = length;
+    out.flash = obj;
+    out.address = address;
+    out.erased = address;
+    if (decode(compressed, end, &out) != 0) {
+        return -1;
+    }
+    return out.used > 0 ? flush(&out) : 0;
+}
+#endif
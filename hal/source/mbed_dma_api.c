@@ -0,0 +1,187 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/dma_api.h"
+
+#if DEVICE_DMA
+
+#include <string.h>
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/cache_api.h"
+#include "hal/sleep_api.h"
+#include "hal/utils/critical_section_api.h"
+
+MBED_STATIC_ASSERT(DEVICE_DMA_CHANNEL_COUNT <= 32, "DEVICE_DMA_CHANNEL_COUNT must be at most 32");
+
+// Allocated channels, bit n set for channel n
+static volatile uint32_t allocated_channels;
+
+int hal_dma_channel_allocate(dma_request_t request)
+{
+    const uint32_t mask = hal_dma_channel_mask(request);
+    uint32_t allocated = core_util_atomic_load_explicit_u32(&allocated_channels, mbed_memory_order_relaxed);
+    uint32_t lowest_free;
+    do {
+        const uint32_t free_channels = ~allocated & mask;
+        if (free_channels == 0) {
+            return -1;
+        }
+        lowest_free = free_channels & (0U - free_channels);
+    } while (!core_util_atomic_compare_exchange_weak_explicit_u32(&allocated_channels, &allocated, allocated | lowest_free,
+                                                                  mbed_memory_order_acquire, mbed_memory_order_relaxed));
+
+    const int channel = 31 - (int)__CLZ(lowest_free);
+    hal_dma_channel_init(channel, request);
+    return channel;
+}
+
+void hal_dma_channel_free(int channel)
+{
+    if (channel < 0) {
+        return;
+    }
+    MBED_ASSERT(channel < DEVICE_DMA_CHANNEL_COUNT);
+    MBED_ASSERT(!hal_dma_is_busy(channel));
+    core_util_atomic_bitmap_release_u32(&allocated_channels, (unsigned)channel);
+}
+
+// Copies started by hal_dma_memcpy_async(), by channel
+typedef struct {
+    dma_descriptor_t descriptor;
+    dma_handler handler;
+    uint32_t id;
+} dma_copy_t;
+
+static dma_copy_t copies[DEVICE_DMA_CHANNEL_COUNT];
+
+static dma_width_t copy_width(const void *dst, const void *src, size_t size)
+{
+    // Move words when both buffers allow it
+    return (((uintptr_t)dst | (uintptr_t)src | size) & 3) == 0 ? DMA_WIDTH_32BIT : DMA_WIDTH_8BIT;
+}
+
+static void wait_for_channel(int channel)
+{
+#if DEVICE_SLEEP
+    core_util_critical_section_enter();
+    while (hal_dma_is_busy(channel)) {
+        hal_critical_section_sleep(hal_sleep);
+    }
+    core_util_critical_section_exit();
+#else
+    while (hal_dma_is_busy(channel));
+#endif
+}
+
+/* Run a blocking copy or fill of size bytes on a memory-to-memory channel.
+ * Returns false if no channel is free.
+ */
+static bool dma_copy(void *dst, const void *src, size_t size, bool src_increment, dma_width_t width)
+{
+    // Waiting in an interrupt handler could block the DMA interrupt
+    if (core_util_is_isr_active()) {
+        return false;
+    }
+
+    const int channel = hal_dma_channel_allocate(DMA_REQUEST_MEMORY);
+    if (channel < 0) {
+        return false;
+    }
+
+    const dma_descriptor_t descriptor = {
+        .src = src,
+        .dst = dst,
+        .count = size / width,
+        .width = width,
+        .src_increment = src_increment,
+        .dst_increment = true,
+        .next = NULL
+    };
+
+    hal_dma_tx_prepare(src, src_increment ? size : width);
+    hal_dma_rx_prepare(dst, size);
+    hal_dma_start(channel, &descriptor, NULL, 0);
+    wait_for_channel(channel);
+    hal_dma_rx_complete(dst, size);
+
+    hal_dma_channel_free(channel);
+    return true;
+}
+
+void *hal_dma_memcpy(void *dst, const void *src, size_t size)
+{
+    if (size < MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD ||
+            !dma_copy(dst, src, size, true, copy_width(dst, src, size))) {
+        memcpy(dst, src, size);
+    }
+    return dst;
+}
+
+void *hal_dma_memset(void *dst, int value, size_t size)
+{
+    if (size < MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD) {
+        return memset(dst, value, size);
+    }
+
+    // The source is a single word holding the value in every byte
+    const uint32_t pattern = 0x01010101UL * (uint8_t)value;
+    if (!dma_copy(dst, &pattern, size, false, copy_width(dst, NULL, size))) {
+        memset(dst, value, size);
+    }
+    return dst;
+}
+
+static void copy_complete(uint32_t channel, uint32_t events)
+{
+    dma_copy_t *copy = &copies[channel];
+    const dma_handler handler = copy->handler;
+    const uint32_t id = copy->id;
+
+    hal_dma_rx_complete((void *)copy->descriptor.dst, copy->descriptor.count * copy->descriptor.width);
+    hal_dma_channel_free((int)channel);
+    handler(id, events);
+}
+
+void hal_dma_memcpy_async(void *dst, const void *src, size_t size, dma_handler handler, uint32_t id)
+{
+    const int channel = size < MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD ? -1 : hal_dma_channel_allocate(DMA_REQUEST_MEMORY);
+    if (channel < 0) {
+        memcpy(dst, src, size);
+        handler(id, DMA_EVENT_COMPLETE);
+        return;
+    }
+
+    dma_copy_t *copy = &copies[channel];
+    const dma_width_t width = copy_width(dst, src, size);
+    copy->descriptor.src = src;
+    copy->descriptor.dst = dst;
+    copy->descriptor.count = size / width;
+    copy->descriptor.width = width;
+    copy->descriptor.src_increment = true;
+    copy->descriptor.dst_increment = true;
+    copy->descriptor.next = NULL;
+    copy->handler = handler;
+    copy->id = id;
+
+    hal_dma_tx_prepare(src, size);
+    hal_dma_rx_prepare(dst, size);
+    hal_dma_start(channel, &copy->descriptor, copy_complete, (uint32_t)channel);
+}
+
+#endif // DEVICE_DMA
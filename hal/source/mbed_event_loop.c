@@ -0,0 +1,203 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/event_loop_api.h"
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_mem_pool.h"
+#include "hal/idle_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+struct hal_event_s {
+    hal_event_callback_t callback;
+    void *context;
+    us_timestamp_t due;         // Time to run at, 0 to run at the next dispatch
+    uint32_t period_us;         // 0 for events which run once
+    struct hal_event_s *next;
+    volatile bool cancelled;
+};
+
+MBED_MEM_POOL_DEFINE(event_pool, sizeof(struct hal_event_s), MBED_CONF_TARGET_EVENT_LOOP_EVENTS);
+
+// Events posted since the last dispatch, the newest first
+static hal_event_t *volatile posted;
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+// Timed events, sorted by time, only used by the dispatcher
+static hal_event_t *timed;
+// Ends hal_idle for the earliest timed event
+static ticker_event_t wakeup_event;
+static us_timestamp_t wakeup_due;
+
+static const ticker_data_t *get_event_ticker(void)
+{
+#if DEVICE_LPTICKER
+    return get_lp_ticker_data();
+#else
+    return get_us_ticker_data();
+#endif
+}
+#endif
+
+static hal_event_t *post(hal_event_callback_t callback, void *context, us_timestamp_t due, uint32_t period_us)
+{
+    hal_event_t *event = (hal_event_t *)mbed_mem_pool_alloc(&event_pool);
+    if (!event) {
+        return NULL;
+    }
+
+    event->callback = callback;
+    event->context = context;
+    event->due = due;
+    event->period_us = period_us;
+    event->cancelled = false;
+
+    void *head = core_util_atomic_load_ptr((void *const volatile *)&posted);
+    do {
+        event->next = (hal_event_t *)head;
+    } while (!core_util_atomic_cas_ptr((void *volatile *)&posted, &head, event));
+
+    return event;
+}
+
+hal_event_t *hal_event_call(hal_event_callback_t callback, void *context)
+{
+    return post(callback, context, 0, 0);
+}
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+hal_event_t *hal_event_call_in(uint32_t delay_us, hal_event_callback_t callback, void *context)
+{
+    return post(callback, context, ticker_read_us(get_event_ticker()) + delay_us, 0);
+}
+
+hal_event_t *hal_event_call_every(uint32_t period_us, hal_event_callback_t callback, void *context)
+{
+    MBED_ASSERT(period_us != 0);
+
+    return post(callback, context, ticker_read_us(get_event_ticker()) + period_us, period_us);
+}
+
+static void insert_timed(hal_event_t *event)
+{
+    hal_event_t **link = &timed;
+    while (*link && (*link)->due <= event->due) {
+        link = &(*link)->next;
+    }
+    event->next = *link;
+    *link = event;
+}
+
+/* Run the timed events due, then wake up for the next one. */
+static size_t dispatch_timed(void)
+{
+    const ticker_data_t *const ticker = get_event_ticker();
+    const us_timestamp_t now = ticker_read_us(ticker);
+    size_t count = 0;
+
+    while (timed && timed->due <= now) {
+        hal_event_t *event = timed;
+        timed = event->next;
+
+        if (!event->cancelled) {
+            event->callback(event->context);
+            count++;
+        }
+        if (event->period_us && !event->cancelled) {
+            event->due += event->period_us;
+            if (event->due <= now) {
+                event->due = now + event->period_us;
+            }
+            insert_timed(event);
+        } else {
+            mbed_mem_pool_free(&event_pool, event);
+        }
+    }
+
+    if (!timed) {
+        ticker_remove_event(ticker, &wakeup_event);
+        wakeup_due = 0;
+    } else if (timed->due != wakeup_due) {
+        ticker_remove_event(ticker, &wakeup_event);
+        ticker_insert_event_us(ticker, &wakeup_event, timed->due, TICKER_WAKEUP_ID);
+        wakeup_due = timed->due;
+    }
+
+    return count;
+}
+#endif
+
+void hal_event_cancel(hal_event_t *event)
+{
+    core_util_atomic_store_bool(&event->cancelled, true);
+}
+
+size_t hal_event_dispatch(void)
+{
+    size_t count = 0;
+
+    // Take every event posted at once, and restore the order they were posted in
+    hal_event_t *event = (hal_event_t *)core_util_atomic_exchange_ptr((void *volatile *)&posted, NULL);
+    hal_event_t *ready = NULL;
+    while (event) {
+        hal_event_t *next = event->next;
+        event->next = ready;
+        ready = event;
+        event = next;
+    }
+
+    while (ready) {
+        event = ready;
+        ready = event->next;
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+        if (event->due && !event->cancelled) {
+            insert_timed(event);
+            continue;
+        }
+#endif
+        if (!event->cancelled) {
+            event->callback(event->context);
+            count++;
+        }
+        mbed_mem_pool_free(&event_pool, event);
+    }
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+    count += dispatch_timed();
+#endif
+
+    return count;
+}
+
+void hal_event_loop_run(void)
+{
+    while (true) {
+        hal_event_dispatch();
+
+#if DEVICE_SLEEP
+        // An event posted after the check wakes the core up from hal_idle
+        core_util_critical_section_enter();
+        if (!core_util_atomic_load_ptr((void *const volatile *)&posted)) {
+            hal_idle();
+        }
+        core_util_critical_section_exit();
+#endif
+    }
+}
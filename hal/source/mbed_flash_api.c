@@ -19,12 +19,243 @@
 #if DEVICE_FLASH
 
 #include "bootstrap/mbed_toolchain.h"
+#include "hal/dma_api.h"
+#include "hal/tracepoint_api.h"
 #include <string.h>
 
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#endif
+
 MBED_WEAK int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint32_t size)
 {
+#if DEVICE_DMA
+    hal_dma_memcpy(data, (const void *)address, size);
+#else
     memcpy(data, (const void *)address, size);
+#endif
+    return 0;
+}
+
+MBED_WEAK int32_t flash_program(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size)
+{
+    const uint32_t page_size = flash_get_page_size(obj);
+    const uint32_t start = flash_get_start_address(obj);
+    const uint32_t end = start + flash_get_size(obj);
+
+    if ((address % page_size) || (size % page_size) ||
+            (address < start) || (address > end) || (size > end - address)) {
+        return -1;
+    }
+
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_START, address, size);
+    while (size > 0) {
+        const uint32_t sector_size = flash_get_sector_size(obj, address);
+        if (sector_size == MBED_FLASH_INVALID_SIZE) {
+            HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_COMPLETE, address, -1);
+            return -1;
+        }
+        // flash_program_page accepts several pages as long as they stay in one sector
+        uint32_t chunk = sector_size - (address % sector_size);
+        if (chunk > size) {
+            chunk = size;
+        }
+        if (flash_program_page(obj, address, data, chunk) != 0) {
+            flash_cache_invalidate(obj);
+            HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_COMPLETE, address, -1);
+            return -1;
+        }
+        address += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    flash_cache_invalidate(obj);
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_COMPLETE, address, 0);
     return 0;
 }
 
+MBED_WEAK int32_t flash_get_layout(const flash_t *obj, flash_region_t *regions, uint32_t count)
+{
+    const uint32_t start = flash_get_start_address(obj);
+    const uint32_t end = start + flash_get_size(obj);
+    uint32_t found = 0;
+    uint32_t region_start = start;
+    uint32_t region_sector_size = 0;
+
+    // Walk the sectors once, merging the runs of sectors of the same size
+    for (uint32_t address = start; address < end;) {
+        const uint32_t sector_size = flash_get_sector_size(obj, address);
+        if (sector_size == MBED_FLASH_INVALID_SIZE || sector_size == 0) {
+            return -1;
+        }
+        if (sector_size != region_sector_size) {
+            if (region_sector_size && found <= count) {
+                regions[found - 1].size = address - region_start;
+            }
+            if (found < count) {
+                regions[found].start = address;
+                regions[found].sector_size = sector_size;
+            }
+            found++;
+            region_start = address;
+            region_sector_size = sector_size;
+        }
+        address += sector_size;
+    }
+    if (found && found <= count) {
+        regions[found - 1].size = end - region_start;
+    }
+
+    return (int32_t)found;
+}
+
+MBED_WEAK int32_t flash_is_blank(flash_t *obj, uint32_t address, uint32_t size)
+{
+    const uint32_t start = flash_get_start_address(obj);
+    const uint32_t end = start + flash_get_size(obj);
+
+    if ((address < start) || (address > end) || (size > end - address)) {
+        return -1;
+    }
+
+    const uint8_t erase_value = flash_get_erase_value(obj);
+    const uint32_t erase_word = erase_value * 0x01010101UL;
+    const uint8_t *bytes = (const uint8_t *)address;
+    uint32_t differ = 0;
+
+    // Bytes up to the first word boundary
+    while (size > 0 && ((uintptr_t)bytes % sizeof(uint32_t))) {
+        differ |= *bytes++ ^ erase_value;
+        size--;
+    }
+
+    const uint32_t *words = (const uint32_t *)bytes;
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+    // Helium vectors, checking the accumulated difference once per 4 vectors
+    const uint32x4_t erase_vector = vdupq_n_u32(erase_word);
+    while (size >= 16 * sizeof(uint32_t)) {
+        uint32x4_t vector_differ = veorq_u32(vld1q_u32(words), erase_vector);
+        vector_differ = vorrq_u32(vector_differ, veorq_u32(vld1q_u32(words + 4), erase_vector));
+        vector_differ = vorrq_u32(vector_differ, veorq_u32(vld1q_u32(words + 8), erase_vector));
+        vector_differ = vorrq_u32(vector_differ, veorq_u32(vld1q_u32(words + 12), erase_vector));
+        if (vmaxvq_u32(0, vector_differ)) {
+            return 0;
+        }
+        words += 16;
+        size -= 16 * sizeof(uint32_t);
+    }
+#endif
+
+    // Whole words, checking the accumulated difference once per 4 words
+    while (size >= 4 * sizeof(uint32_t)) {
+        differ |= (words[0] ^ erase_word) | (words[1] ^ erase_word) |
+                  (words[2] ^ erase_word) | (words[3] ^ erase_word);
+        if (differ) {
+            return 0;
+        }
+        words += 4;
+        size -= 4 * sizeof(uint32_t);
+    }
+    while (size >= sizeof(uint32_t)) {
+        differ |= *words++ ^ erase_word;
+        size -= sizeof(uint32_t);
+    }
+
+    bytes = (const uint8_t *)words;
+    while (size > 0) {
+        differ |= *bytes++ ^ erase_value;
+        size--;
+    }
+
+    return differ ? 0 : 1;
+}
+
+MBED_WEAK uint32_t flash_get_bank(const flash_t *obj, uint32_t address)
+{
+    (void)obj;
+    (void)address;
+    return 0;
+}
+
+MBED_WEAK uint32_t flash_get_bank_count(const flash_t *obj)
+{
+    (void)obj;
+    return 1;
+}
+
+MBED_WEAK int32_t flash_bank_swap(flash_t *obj)
+{
+    (void)obj;
+    return -1;
+}
+
+MBED_WEAK int32_t flash_erase_sector_async(flash_t *obj, uint32_t address, flash_async_handler handler, uint32_t id)
+{
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_ERASE_START, address, 0);
+    int32_t status = flash_erase_sector(obj, address);
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_ERASE_COMPLETE, address, status);
+    if (status == 0) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK int32_t flash_program_page_async(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, flash_async_handler handler, uint32_t id)
+{
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_START, address, size);
+    int32_t status = flash_program_page(obj, address, data, size);
+    HAL_TRACEPOINT(HAL_TRACEPOINT_FLASH_PROGRAM_COMPLETE, address, status);
+    if (status == 0) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK uint32_t flash_async_progress(const flash_t *obj)
+{
+    (void)obj;
+    return 0;
+}
+
+MBED_WEAK int32_t flash_erase_suspend(flash_t *obj)
+{
+    (void)obj;
+    return -1;
+}
+
+MBED_WEAK int32_t flash_erase_resume(flash_t *obj)
+{
+    (void)obj;
+    return -1;
+}
+
+MBED_WEAK int32_t flash_get_accel_config(const flash_t *obj, flash_accel_config_t *config)
+{
+    (void)obj;
+    config->wait_states = 0;
+    config->icache = false;
+    config->dcache = false;
+    config->prefetch = false;
+    return 0;
+}
+
+MBED_WEAK int32_t flash_set_accel_config(flash_t *obj, const flash_accel_config_t *config)
+{
+    (void)obj;
+    (void)config;
+    return -1;
+}
+
+MBED_WEAK uint32_t flash_get_min_wait_states(const flash_t *obj, uint32_t hz)
+{
+    (void)obj;
+    (void)hz;
+    return 0;
+}
+
+MBED_WEAK void flash_cache_invalidate(flash_t *obj)
+{
+    (void)obj;
+}
+
 #endif
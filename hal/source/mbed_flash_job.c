@@ -0,0 +1,156 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/flash_job_api.h"
+
+#if DEVICE_FLASH
+
+#include "hal/event_loop_api.h"
+#include "hal/watchdog_api.h"
+
+#include <stddef.h>
+
+static int32_t check_range(flash_t *obj, uint32_t address, uint32_t size)
+{
+    const uint32_t start = flash_get_start_address(obj);
+    const uint32_t end = start + flash_get_size(obj);
+
+    if ((address < start) || (address > end) || (size > end - address)) {
+        return -1;
+    }
+    return 0;
+}
+
+// The sectors are walked from the start of the flash, which the address must start one of
+static uint32_t sector_boundary(flash_t *obj, uint32_t from, uint32_t address)
+{
+    while (from < address) {
+        const uint32_t sector_size = flash_get_sector_size(obj, from);
+        if (sector_size == MBED_FLASH_INVALID_SIZE || sector_size == 0) {
+            return MBED_FLASH_INVALID_SIZE;
+        }
+        from += sector_size;
+    }
+    return from == address ? from : MBED_FLASH_INVALID_SIZE;
+}
+
+int32_t flash_job_erase_init(flash_job_t *job, flash_t *obj, uint32_t address, uint32_t size)
+{
+    if (check_range(obj, address, size) != 0) {
+        return -1;
+    }
+    const uint32_t start = sector_boundary(obj, flash_get_start_address(obj), address);
+    if (start == MBED_FLASH_INVALID_SIZE || sector_boundary(obj, start, address + size) == MBED_FLASH_INVALID_SIZE) {
+        return -1;
+    }
+
+    job->flash = obj;
+    job->data = NULL;
+    job->address = address;
+    job->end = address + size;
+    job->handler = NULL;
+    job->context = NULL;
+    return 0;
+}
+
+int32_t flash_job_program_init(flash_job_t *job, flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size)
+{
+    const uint32_t page_size = flash_get_page_size(obj);
+
+    if ((address % page_size) || (size % page_size) || check_range(obj, address, size) != 0) {
+        return -1;
+    }
+
+    job->flash = obj;
+    job->data = data;
+    job->address = address;
+    job->end = address + size;
+    job->handler = NULL;
+    job->context = NULL;
+    return 0;
+}
+
+int32_t flash_job_step(flash_job_t *job)
+{
+    if (job->address >= job->end) {
+        return 0;
+    }
+
+    if (job->data == NULL) {
+        const uint32_t sector_size = flash_get_sector_size(job->flash, job->address);
+        if (sector_size == MBED_FLASH_INVALID_SIZE) {
+            return -1;
+        }
+        if (flash_is_blank(job->flash, job->address, sector_size) != 1 &&
+                flash_erase_sector(job->flash, job->address) != 0) {
+            return -1;
+        }
+        job->address += sector_size;
+    } else {
+        const uint32_t page_size = flash_get_page_size(job->flash);
+        uint32_t chunk = MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE - MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE % page_size;
+        if (chunk == 0) {
+            chunk = page_size;
+        }
+        if (chunk > job->end - job->address) {
+            chunk = job->end - job->address;
+        }
+        if (flash_program(job->flash, job->address, job->data, chunk) != 0) {
+            return -1;
+        }
+        job->address += chunk;
+        job->data += chunk;
+    }
+
+    return job->address < job->end ? 1 : 0;
+}
+
+int32_t flash_job_run(flash_job_t *job)
+{
+    int32_t status;
+
+    do {
+        status = flash_job_step(job);
+#if DEVICE_WATCHDOG
+        hal_watchdog_kick();
+#endif
+    } while (status > 0);
+
+    return status;
+}
+
+static void run_chunk(void *context)
+{
+    flash_job_t *job = (flash_job_t *)context;
+    int32_t status = flash_job_step(job);
+
+    // The other events run before the next chunk
+    if (status > 0 && hal_event_call(run_chunk, job) == NULL) {
+        status = -1;
+    }
+    if (status <= 0) {
+        job->handler(job, status);
+    }
+}
+
+int32_t flash_job_start(flash_job_t *job, flash_job_handler_t handler, void *context)
+{
+    job->handler = handler;
+    job->context = context;
+    return hal_event_call(run_chunk, job) != NULL ? 0 : -1;
+}
+
+#endif // DEVICE_FLASH
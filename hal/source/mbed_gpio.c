@@ -15,6 +15,7 @@
  */
 
 #include "hal/gpio_api.h"
+#include "bootstrap/mbed_critical.h"
 #include "bootstrap/mbed_toolchain.h"
 #include "hal/PinNameAliases.h"
 
@@ -76,8 +77,60 @@ MBED_WEAK void gpio_get_capabilities(gpio_t *gpio, gpio_capabilities_t *cap)
     cap->pull_none = 1;
     cap->pull_down = 1;
     cap->pull_up = 1;
+    // Speed and drive strength are fixed unless the target implements them.
+    cap->speeds = 0;
+    cap->drives = 0;
 }
 
+MBED_WEAK void gpio_speed(gpio_t *obj, gpio_speed_t speed)
+{
+    (void)obj;
+    (void)speed;
+}
+
+MBED_WEAK void gpio_drive(gpio_t *obj, gpio_drive_t drive)
+{
+    (void)obj;
+    (void)drive;
+}
+
+#ifndef GPIO_BITS_INLINE
+
+// To be re-implemented in the target layer with set/clear/toggle registers where they exist.
+MBED_WEAK void gpio_toggle(gpio_t *obj)
+{
+    core_util_critical_section_enter();
+    gpio_write(obj, !gpio_read(obj));
+    core_util_critical_section_exit();
+}
+
+#if DEVICE_PORTOUT
+
+MBED_WEAK void port_set_bits(port_t *obj, int bits)
+{
+    core_util_critical_section_enter();
+    port_write(obj, port_read(obj) | bits);
+    core_util_critical_section_exit();
+}
+
+MBED_WEAK void port_clear_bits(port_t *obj, int bits)
+{
+    core_util_critical_section_enter();
+    port_write(obj, port_read(obj) & ~bits);
+    core_util_critical_section_exit();
+}
+
+MBED_WEAK void port_toggle_bits(port_t *obj, int bits)
+{
+    core_util_critical_section_enter();
+    port_write(obj, port_read(obj) ^ bits);
+    core_util_critical_section_exit();
+}
+
+#endif // DEVICE_PORTOUT
+
+#endif // GPIO_BITS_INLINE
+
 typedef enum {
     DEFAULT_GPIO = 0,
 } DefaultGPIOPeripheralName;
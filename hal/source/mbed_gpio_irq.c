@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
-#include "hal/gpio_irq_api.h"
+#include "hal/gpio_api.h"
 
 #if DEVICE_INTERRUPTIN
 
-#include "platform/mbed_toolchain.h"
-#include "hal/gpio_api.h"
+#include <string.h>
+
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+#include "hal/us_ticker_api.h"
 
 MBED_WEAK const PinMap *gpio_irq_pinmap()
 {
@@ -28,4 +31,149 @@ MBED_WEAK const PinMap *gpio_irq_pinmap()
     return gpio_pinmap();
 }
 
+MBED_WEAK uint32_t gpio_irq_timestamp(gpio_irq_t *obj)
+{
+    (void)obj;
+    return us_ticker_read();
+}
+
+void gpio_irq_queue_init(gpio_irq_queue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped = 0;
+}
+
+static void gpio_irq_queued_handler(uint32_t id, gpio_irq_event event)
+{
+    gpio_irq_queued_t *obj = (gpio_irq_queued_t *)id;
+    const uint32_t timestamp = gpio_irq_timestamp(obj->irq);
+    gpio_irq_queue_t *queue = obj->queue;
+
+    // pins sharing the queue may interrupt at different priorities
+    core_util_critical_section_enter();
+    const uint32_t head = queue->head;
+    if (head - queue->tail < MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE) {
+        gpio_irq_edge_t *edge = &queue->edges[head & (MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE - 1)];
+        edge->id = obj->id;
+        edge->event = event;
+        edge->timestamp = timestamp;
+        queue->head = head + 1;
+    } else {
+        queue->dropped++;
+    }
+    core_util_critical_section_exit();
+}
+
+int gpio_irq_init_queued(gpio_irq_queued_t *obj, gpio_irq_t *irq, PinName pin, gpio_irq_queue_t *queue, uint32_t id)
+{
+    obj->irq = irq;
+    obj->queue = queue;
+    obj->id = id;
+    return gpio_irq_init(irq, pin, gpio_irq_queued_handler, (uint32_t)obj);
+}
+
+bool gpio_irq_queue_pop(gpio_irq_queue_t *queue, gpio_irq_edge_t *edge)
+{
+    const uint32_t tail = queue->tail;
+    if (tail == queue->head) {
+        return false;
+    }
+    *edge = queue->edges[tail & (MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE - 1)];
+    queue->tail = tail + 1;
+    return true;
+}
+
+uint32_t gpio_irq_queue_dropped(const gpio_irq_queue_t *queue)
+{
+    return queue->dropped;
+}
+
+MBED_WEAK int gpio_irq_debounce_set(gpio_irq_t *obj, uint32_t debounce_us)
+{
+    (void)obj;
+    return debounce_us ? -1 : 0;
+}
+
+static void gpio_irq_debounced_handler(uint32_t id, gpio_irq_event event)
+{
+    gpio_irq_debounce_edge((gpio_irq_debounced_t *)id, event);
+}
+
+// Handler of the us ticker events, whose id is the debounced GPIO IRQ object
+static void gpio_irq_debounce_timeout(uint32_t id)
+{
+    gpio_irq_debounced_t *obj = (gpio_irq_debounced_t *)id;
+
+    core_util_critical_section_enter();
+    obj->masked = false;
+    gpio_irq_set(obj->irq, IRQ_RISE, obj->events & (1U << IRQ_RISE));
+    gpio_irq_set(obj->irq, IRQ_FALL, obj->events & (1U << IRQ_FALL));
+    core_util_critical_section_exit();
+}
+
+void gpio_irq_debounce_edge(gpio_irq_debounced_t *obj, gpio_irq_event event)
+{
+    if (!obj->hardware && obj->debounce_us != 0) {
+        const ticker_data_t *const ticker = get_us_ticker_data();
+
+        core_util_critical_section_enter();
+        // An edge latched before the pin was disabled is a bounce too
+        if (obj->masked) {
+            core_util_critical_section_exit();
+            return;
+        }
+        obj->masked = true;
+        gpio_irq_set(obj->irq, IRQ_RISE, 0);
+        gpio_irq_set(obj->irq, IRQ_FALL, 0);
+        ticker_insert_event_us(ticker, &obj->event, ticker_read_us(ticker) + obj->debounce_us, (uint32_t)obj);
+        core_util_critical_section_exit();
+    }
+    obj->handler(obj->id, event);
+}
+
+int gpio_irq_init_debounced(gpio_irq_debounced_t *obj, gpio_irq_t *irq, PinName pin, uint32_t debounce_us, gpio_irq_handler handler, uint32_t id)
+{
+    obj->irq = irq;
+    obj->handler = handler;
+    obj->id = id;
+    obj->debounce_us = debounce_us;
+    obj->hardware = false;
+    obj->events = 0;
+    obj->masked = false;
+    memset(&obj->event, 0, sizeof(obj->event));
+
+    if (gpio_irq_init(irq, pin, gpio_irq_debounced_handler, (uint32_t)obj) != 0) {
+        return -1;
+    }
+    // Also called without a debounce time, to disable the filter of a previous user
+    const bool filtered = gpio_irq_debounce_set(irq, debounce_us) == 0;
+    if (debounce_us != 0) {
+        obj->hardware = filtered;
+        if (!filtered) {
+            ticker_set_handler(get_us_ticker_data(), gpio_irq_debounce_timeout);
+        }
+    }
+    return 0;
+}
+
+void gpio_irq_set_debounced(gpio_irq_debounced_t *obj, gpio_irq_event event, uint32_t enable)
+{
+    core_util_critical_section_enter();
+    if (enable) {
+        obj->events |= 1U << event;
+    } else {
+        obj->events &= ~(1U << event);
+    }
+    if (!obj->masked) {
+        gpio_irq_set(obj->irq, event, enable);
+    }
+    core_util_critical_section_exit();
+}
+
+bool gpio_irq_debounce_in_hardware(const gpio_irq_debounced_t *obj)
+{
+    return obj->hardware;
+}
+
 #endif
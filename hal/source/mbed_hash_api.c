@@ -0,0 +1,222 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/hash_api.h"
+
+#if DEVICE_HASH
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+#include <string.h>
+
+/* Bytes of the length appended to the padding */
+#define HASH_LENGTH_SIZE 8
+
+static const uint32_t sha1_initial_state[] = {
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+};
+
+static const uint32_t sha224_initial_state[] = {
+    0xC1059ED8, 0x367CD507, 0x3070DD17, 0xF70E5939, 0xFFC00B31, 0x68581511, 0x64F98FA7, 0xBEFA4FA4
+};
+
+static const uint32_t sha256_initial_state[] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+// The asynchronous update in progress, which owns the hash module
+static volatile bool async_busy;
+static struct {
+    hal_hash_ctx_t *ctx;
+    const uint8_t *tail;
+    size_t tail_size;
+    hal_hash_async_handler handler;
+    uint32_t id;
+} async_update;
+
+size_t hal_hash_digest_size(hal_hash_algorithm_t algorithm)
+{
+    switch (algorithm) {
+        case HAL_HASH_SHA1:
+            return 20;
+        case HAL_HASH_SHA224:
+            return 28;
+        default:
+            return 32;
+    }
+}
+
+MBED_WEAK void hal_hash_compute_partial_async(const uint8_t *blocks, size_t count,
+                                              hal_hash_async_handler handler, uint32_t id)
+{
+    hal_hash_compute_partial(blocks, count);
+    handler(id);
+}
+
+/* Hash complete blocks into the state of a context */
+static void hash_blocks(hal_hash_ctx_t *ctx, const uint8_t *blocks, size_t count)
+{
+    while (count > 0) {
+        const size_t chunk = count < MBED_CONF_TARGET_HASH_SECTION_BLOCKS ? count : MBED_CONF_TARGET_HASH_SECTION_BLOCKS;
+
+        core_util_critical_section_enter();
+        hal_hash_compute_partial_start(ctx->algorithm, ctx->state);
+        hal_hash_compute_partial(blocks, chunk);
+        hal_hash_get_state(ctx->state);
+        core_util_critical_section_exit();
+
+        blocks += chunk * HAL_HASH_BLOCK_SIZE;
+        count -= chunk;
+    }
+}
+
+/* Append data to the incomplete block of a context, and hash it once
+ * complete. Returns the number of bytes appended. */
+static size_t fill_block(hal_hash_ctx_t *ctx, const uint8_t *data, size_t size)
+{
+    const size_t used = ctx->length % HAL_HASH_BLOCK_SIZE;
+    const size_t length = size < HAL_HASH_BLOCK_SIZE - used ? size : HAL_HASH_BLOCK_SIZE - used;
+
+    memcpy(&ctx->block[used], data, length);
+    ctx->length += length;
+    if (used + length == HAL_HASH_BLOCK_SIZE) {
+        hash_blocks(ctx, ctx->block, 1);
+    }
+
+    return length;
+}
+
+MBED_WEAK void hal_hash_ctx_start(hal_hash_ctx_t *ctx, hal_hash_algorithm_t algorithm)
+{
+    ctx->algorithm = algorithm;
+    ctx->length = 0;
+    memset(ctx->state, 0, sizeof(ctx->state));
+    switch (algorithm) {
+        case HAL_HASH_SHA1:
+            memcpy(ctx->state, sha1_initial_state, sizeof(sha1_initial_state));
+            break;
+        case HAL_HASH_SHA224:
+            memcpy(ctx->state, sha224_initial_state, sizeof(sha224_initial_state));
+            break;
+        default:
+            memcpy(ctx->state, sha256_initial_state, sizeof(sha256_initial_state));
+            break;
+    }
+}
+
+MBED_WEAK void hal_hash_ctx_update(hal_hash_ctx_t *ctx, const uint8_t *data, size_t size)
+{
+    MBED_ASSERT(!core_util_atomic_load_bool(&async_busy));
+
+    if ((ctx->length % HAL_HASH_BLOCK_SIZE) != 0 && size > 0) {
+        const size_t length = fill_block(ctx, data, size);
+        data += length;
+        size -= length;
+    }
+
+    const size_t count = size / HAL_HASH_BLOCK_SIZE;
+    hash_blocks(ctx, data, count);
+    ctx->length += count * HAL_HASH_BLOCK_SIZE;
+    data += count * HAL_HASH_BLOCK_SIZE;
+    size -= count * HAL_HASH_BLOCK_SIZE;
+
+    if (size > 0) {
+        memcpy(ctx->block, data, size);
+        ctx->length += size;
+    }
+}
+
+// The id is the number of blocks hashed, the hash module state is stale if none
+static void async_update_done(uint32_t id)
+{
+    hal_hash_ctx_t *ctx = async_update.ctx;
+    const hal_hash_async_handler handler = async_update.handler;
+    const uint32_t handler_id = async_update.id;
+
+    if (id != 0) {
+        hal_hash_get_state(ctx->state);
+    }
+    if (async_update.tail_size > 0) {
+        memcpy(ctx->block, async_update.tail, async_update.tail_size);
+        ctx->length += async_update.tail_size;
+    }
+
+    // The handler may start another update
+    core_util_atomic_store_bool(&async_busy, false);
+    handler(handler_id);
+}
+
+MBED_WEAK int hal_hash_ctx_update_async(hal_hash_ctx_t *ctx, const uint8_t *data, size_t size,
+                                       hal_hash_async_handler handler, uint32_t id)
+{
+    if (core_util_atomic_exchange_bool(&async_busy, true)) {
+        return -1;
+    }
+
+    // The incomplete block of the context is completed synchronously
+    if ((ctx->length % HAL_HASH_BLOCK_SIZE) != 0 && size > 0) {
+        const size_t length = fill_block(ctx, data, size);
+        data += length;
+        size -= length;
+    }
+
+    const size_t count = size / HAL_HASH_BLOCK_SIZE;
+    async_update.ctx = ctx;
+    async_update.tail = data + count * HAL_HASH_BLOCK_SIZE;
+    async_update.tail_size = size - count * HAL_HASH_BLOCK_SIZE;
+    async_update.handler = handler;
+    async_update.id = id;
+
+    if (count == 0) {
+        async_update_done(0);
+        return 0;
+    }
+
+    ctx->length += count * HAL_HASH_BLOCK_SIZE;
+    hal_hash_compute_partial_start(ctx->algorithm, ctx->state);
+    hal_hash_compute_partial_async(data, count, async_update_done, count);
+
+    return 0;
+}
+
+MBED_WEAK void hal_hash_ctx_get_digest(const hal_hash_ctx_t *ctx, uint8_t *digest)
+{
+    hal_hash_ctx_t final = *ctx;
+    const uint64_t bits = ctx->length * 8;
+    size_t used = ctx->length % HAL_HASH_BLOCK_SIZE;
+
+    // A one bit, zeros up to the length, then the length in bits, big endian
+    final.block[used++] = 0x80;
+    if (used > HAL_HASH_BLOCK_SIZE - HASH_LENGTH_SIZE) {
+        memset(&final.block[used], 0, HAL_HASH_BLOCK_SIZE - used);
+        hash_blocks(&final, final.block, 1);
+        used = 0;
+    }
+    memset(&final.block[used], 0, HAL_HASH_BLOCK_SIZE - HASH_LENGTH_SIZE - used);
+    for (int i = 0; i < HASH_LENGTH_SIZE; i++) {
+        final.block[HAL_HASH_BLOCK_SIZE - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    hash_blocks(&final, final.block, 1);
+
+    const size_t size = hal_hash_digest_size(ctx->algorithm);
+    for (size_t i = 0; i < size; i++) {
+        digest[i] = (uint8_t)(final.state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+}
+
+#endif // DEVICE_HASH
@@ -0,0 +1,242 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/i2c_api.h"
+#include "hal/gpio_api.h"
+#include "hal/tracepoint_api.h"
+#include "hal/us_ticker_api.h"
+#include "bootstrap/mbed_wait_api.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_I2C
+
+#define I2C_BYTE_ACK 1
+#define I2C_BYTE_TIMEOUT 2
+
+/* Half a period of the 100 kHz clock of the bus recovery */
+#define I2C_RECOVER_HALF_PERIOD_US 5
+
+/* Clock pulses needed for a slave to finish the byte it sends */
+#define I2C_RECOVER_PULSES 9
+
+/* Longest time a slave may stretch a clock pulse of the bus recovery */
+#define I2C_RECOVER_STRETCH_US 1000
+
+/* Put the register address to the buffer, most significant byte first */
+static void i2c_mem_address_encode(uint8_t *buffer, uint32_t mem_address, size_t mem_address_size)
+{
+    for (size_t i = 0; i < mem_address_size; i++) {
+        buffer[i] = (uint8_t)(mem_address >> (8 * (mem_address_size - 1 - i)));
+    }
+}
+
+/* Write one byte of an ongoing transfer, returns zero or I2C_ERROR_XXX status */
+static int i2c_mem_byte_write(i2c_t *obj, int data)
+{
+    int ack = i2c_byte_write(obj, data);
+    if (ack == I2C_BYTE_ACK) {
+        return 0;
+    }
+    return ack == I2C_BYTE_TIMEOUT ? I2C_ERROR_BUS_BUSY : I2C_ERROR_NO_SLAVE;
+}
+
+MBED_WEAK void i2c_get_capabilities(i2c_t *obj, i2c_capabilities_t *cap)
+{
+    (void)obj;
+
+    cap->minimum_frequency = 100000;            // 100 kHz
+    cap->maximum_frequency = 400000;            // 400 kHz
+    cap->speed_modes = I2C_SPEED_STANDARD | I2C_SPEED_FAST;
+}
+
+MBED_WEAK int i2c_timing_prepare(i2c_t *obj, i2c_timing_t *timing, int hz)
+{
+    i2c_capabilities_t cap;
+    i2c_get_capabilities(obj, &cap);
+
+    if (hz <= 0 || (uint32_t)hz < cap.minimum_frequency || (uint32_t)hz > cap.maximum_frequency) {
+        return -1;
+    }
+
+    timing->hz = hz;
+    return 0;
+}
+
+MBED_WEAK void i2c_timing_apply(i2c_t *obj, const i2c_timing_t *timing)
+{
+    i2c_frequency(obj, timing->hz);
+}
+
+MBED_WEAK int i2c_timeout(i2c_t *obj, uint32_t timeout_us)
+{
+    (void)obj;
+    (void)timeout_us;
+
+    return -1;
+}
+
+/* Drive the line low, or release it to the pull-up */
+static void i2c_line_set(gpio_t *line, int value)
+{
+    if (value) {
+        gpio_dir(line, PIN_INPUT);
+    } else {
+        gpio_write(line, 0);
+        gpio_dir(line, PIN_OUTPUT);
+    }
+    wait_us(I2C_RECOVER_HALF_PERIOD_US);
+}
+
+/* Release SCL, and wait for the slave to stop stretching it */
+static bool i2c_scl_release(gpio_t *scl)
+{
+    i2c_line_set(scl, 1);
+    for (int waited = 0; !gpio_read(scl); waited += I2C_RECOVER_HALF_PERIOD_US) {
+        if (waited >= I2C_RECOVER_STRETCH_US) {
+            return false;
+        }
+        wait_us(I2C_RECOVER_HALF_PERIOD_US);
+    }
+    return true;
+}
+
+MBED_WEAK int i2c_bus_recover(PinName sda, PinName scl)
+{
+    gpio_t sda_line;
+    gpio_t scl_line;
+
+    gpio_init_in_ex(&sda_line, sda, PullNone);
+    gpio_init_in_ex(&scl_line, scl, PullNone);
+
+    bool released = i2c_scl_release(&scl_line);
+    for (int i = 0; released && i < I2C_RECOVER_PULSES && !gpio_read(&sda_line); i++) {
+        i2c_line_set(&scl_line, 0);
+        released = i2c_scl_release(&scl_line);
+    }
+
+    if (released) {
+        // Stop condition: SDA rises while SCL is high
+        i2c_line_set(&scl_line, 0);
+        i2c_line_set(&sda_line, 0);
+        released = i2c_scl_release(&scl_line);
+        i2c_line_set(&sda_line, 1);
+    }
+
+    const bool idle = released && gpio_read(&sda_line) && gpio_read(&scl_line);
+
+    gpio_free(&sda_line);
+    gpio_free(&scl_line);
+
+    return idle ? 0 : I2C_ERROR_BUS_BUSY;
+}
+
+#if DEVICE_USTICKER
+void i2c_deadline_start(i2c_deadline_t *deadline, uint32_t timeout_us)
+{
+    deadline->end_us = ticker_read_us(get_us_ticker_data()) + timeout_us;
+}
+
+bool i2c_deadline_expired(const i2c_deadline_t *deadline)
+{
+    return ticker_read_us(get_us_ticker_data()) >= deadline->end_us;
+}
+#endif
+
+MBED_WEAK int i2c_mem_read(i2c_t *obj, int address, uint32_t mem_address, size_t mem_address_size, void *data, size_t length)
+{
+    uint8_t mem_address_bytes[sizeof(uint32_t)];
+    i2c_mem_address_encode(mem_address_bytes, mem_address, mem_address_size);
+
+    int written = i2c_write(obj, address & ~1, (const char *)mem_address_bytes, (int)mem_address_size, 0);
+    if (written != (int)mem_address_size) {
+        i2c_stop(obj);
+        return written < 0 ? written : I2C_ERROR_NO_SLAVE;
+    }
+
+    int read = i2c_read(obj, address | 1, (char *)data, (int)length, 1);
+    if (read != (int)length) {
+        return read < 0 ? read : I2C_ERROR_NO_SLAVE;
+    }
+    return 0;
+}
+
+MBED_WEAK int i2c_mem_write(i2c_t *obj, int address, uint32_t mem_address, size_t mem_address_size, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint8_t mem_address_bytes[sizeof(uint32_t)];
+    i2c_mem_address_encode(mem_address_bytes, mem_address, mem_address_size);
+
+    i2c_start(obj);
+    int status = i2c_mem_byte_write(obj, address & ~1);
+    for (size_t i = 0; status == 0 && i < mem_address_size; i++) {
+        status = i2c_mem_byte_write(obj, mem_address_bytes[i]);
+    }
+    for (size_t i = 0; status == 0 && i < length; i++) {
+        status = i2c_mem_byte_write(obj, bytes[i]);
+    }
+    i2c_stop(obj);
+
+    return status;
+}
+
+#if DEVICE_I2C_ASYNCH
+
+static void i2c_transfer_list_start(i2c_t *obj)
+{
+    i2c_transfer_list_state_t *list = &obj->list;
+    const i2c_transfer_t *transfer = list->next;
+
+    // Completion of each transfer is needed to start the next one
+    HAL_TRACEPOINT(HAL_TRACEPOINT_I2C_START, obj, transfer->address);
+    i2c_transfer_asynch(obj, transfer->tx, transfer->tx_length, transfer->rx, transfer->rx_length,
+                        transfer->address, 1, list->handler, list->event | I2C_EVENT_TRANSFER_COMPLETE);
+}
+
+MBED_WEAK void i2c_transfer_list_asynch(i2c_t *obj, const i2c_transfer_t *list, size_t count, uint32_t handler, uint32_t event)
+{
+    obj->list.next = list;
+    obj->list.count = count;
+    obj->list.handler = handler;
+    obj->list.event = event;
+
+    i2c_transfer_list_start(obj);
+}
+
+MBED_WEAK uint32_t i2c_irq_handler_asynch_list(i2c_t *obj)
+{
+    i2c_transfer_list_state_t *list = &obj->list;
+    uint32_t events = i2c_irq_handler_asynch(obj);
+
+    if (events) {
+        HAL_TRACEPOINT(HAL_TRACEPOINT_I2C_COMPLETE, obj, events);
+    }
+    if ((events & I2C_EVENT_TRANSFER_COMPLETE) &&
+            !(events & (I2C_EVENT_ERROR | I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK))) {
+        list->count--;
+        if (list->count != 0) {
+            // The list continues, report the events of the whole list at the end
+            list->next++;
+            i2c_transfer_list_start(obj);
+            return 0;
+        }
+    }
+
+    return events & list->event;
+}
+
+#endif // DEVICE_I2C_ASYNCH
+
+#endif // DEVICE_I2C
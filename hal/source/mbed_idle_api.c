@@ -0,0 +1,353 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/idle_api.h"
+
+#if DEVICE_SLEEP
+
+#define TRACE_GROUP "idle"
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_trace.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/sleep_api.h"
+#include "hal/tracepoint_api.h"
+#include "hal/us_ticker_api.h"
+#include "hal/utils/critical_section_api.h"
+#include "hal/watchdog_supervisor_api.h"
+
+static volatile uint16_t deep_sleep_lock;
+static uint32_t deep_sleep_latency_us = MBED_CONF_TARGET_DEEP_SLEEP_LATENCY;
+static hal_idle_deep_sleep_stats_t deep_sleep_stats = { 0, UINT32_MAX, 0, 0, 0 };
+static hal_idle_deep_sleep_owner_t *owners;
+// Registration order, newest at the head, oldest at the tail
+static hal_idle_retention_t *retention_head;
+static hal_idle_retention_t *retention_tail;
+
+/* Time the owners' locks are measured with, 0 without an lp ticker. */
+static uint64_t owner_time_us(void)
+{
+#if DEVICE_LPTICKER
+    return ticker_read_us(get_lp_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+#if DEVICE_LPTICKER
+// Wakes the core up from deep sleep for the next us ticker event
+static ticker_event_t wakeup_event;
+
+/* Time to the next event of a ticker, UINT64_MAX if there is none. */
+static us_timestamp_t time_to_next_event(const ticker_data_t *const ticker)
+{
+    us_timestamp_t next;
+    if (!ticker_get_next_timestamp_us(ticker, &next)) {
+        return UINT64_MAX;
+    }
+    const us_timestamp_t now = ticker_read_us(ticker);
+    return next > now ? next - now : 0;
+}
+
+static void record_latency(uint32_t latency_us, uint32_t resolution_us, bool late)
+{
+    hal_idle_deep_sleep_stats_t *stats = &deep_sleep_stats;
+
+    if (latency_us < stats->min_us) {
+        stats->min_us = latency_us;
+    }
+    if (latency_us > stats->max_us) {
+        stats->max_us = latency_us;
+    }
+    // Exponential moving average over about 8 samples
+    if (stats->count == 0) {
+        stats->average_us = latency_us;
+    } else {
+        stats->average_us = (uint32_t)(((uint64_t)stats->average_us * 7 + latency_us) / 8);
+    }
+    stats->count++;
+    if (late) {
+        stats->late++;
+    }
+
+    // Plan for the worst case seen, plus the error of the measurement, so
+    // deadlines are not missed
+    if (latency_us + resolution_us > deep_sleep_latency_us) {
+        deep_sleep_latency_us = latency_us + resolution_us;
+    }
+}
+
+#if DEVICE_USTICKER
+/* Suspend the channels of the us ticker, the unused ones are left alone. */
+static void suspend_us_tickers(void)
+{
+    ticker_suspend(get_us_ticker_data());
+    for (uint32_t i = 1; i < MBED_CONF_TARGET_US_TICKER_CHANNELS; i++) {
+        const ticker_data_t *const ticker = get_us_ticker_channel_data(i);
+        if (ticker->queue->initialized) {
+            ticker_suspend(ticker);
+        }
+    }
+}
+
+static void resume_us_tickers(us_timestamp_t elapsed_us)
+{
+    ticker_resume_compensated(get_us_ticker_data(), elapsed_us);
+    for (uint32_t i = 1; i < MBED_CONF_TARGET_US_TICKER_CHANNELS; i++) {
+        const ticker_data_t *const ticker = get_us_ticker_channel_data(i);
+        if (ticker->queue->initialized) {
+            ticker_resume_compensated(ticker, elapsed_us);
+        }
+    }
+}
+#endif
+
+static void deep_sleep(const ticker_data_t *const lp_ticker, us_timestamp_t idle_time)
+{
+#if DEVICE_USTICKER
+    const bool suspend_us_ticker = !get_us_ticker_data()->interface->runs_in_deep_sleep;
+#endif
+    const bool timed = idle_time != UINT64_MAX;
+    const us_timestamp_t start = ticker_read_us(lp_ticker);
+    const us_timestamp_t wakeup = start + idle_time - deep_sleep_latency_us;
+
+    if (timed) {
+        ticker_insert_event_us(lp_ticker, &wakeup_event, wakeup, TICKER_WAKEUP_ID);
+    }
+#if DEVICE_USTICKER
+    // The us ticker counts the time up to its suspension, only the time
+    // from there on is added to it
+    us_timestamp_t suspended = start;
+    if (suspend_us_ticker) {
+        suspend_us_tickers();
+        suspended = ticker_read_us(lp_ticker);
+    }
+#endif
+
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SLEEP_START, 1, 0);
+    for (hal_idle_retention_t *entry = retention_tail; entry; entry = entry->prev) {
+        entry->save(entry->context);
+    }
+    hal_critical_section_sleep(hal_deepsleep);
+    for (hal_idle_retention_t *entry = retention_head; entry; entry = entry->next) {
+        entry->restore(entry->context);
+    }
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SLEEP_COMPLETE, 1, 0);
+
+    const us_timestamp_t end = ticker_read_us(lp_ticker);
+#if DEVICE_USTICKER
+    if (suspend_us_ticker) {
+        resume_us_tickers(end - suspended);
+    }
+#endif
+    if (timed) {
+        ticker_remove_event(lp_ticker, &wakeup_event);
+        if (end >= wakeup) {
+            // Woken up by the lp ticker rather than by another interrupt
+            const uint32_t frequency = lp_ticker->interface->get_info()->frequency;
+            record_latency((uint32_t)(end - wakeup), (1000000 + frequency - 1) / frequency, end > start + idle_time);
+        }
+    }
+}
+#endif // DEVICE_LPTICKER
+
+void hal_idle(void)
+{
+    // hal_critical_section_sleep() keeps the interrupts masked, so none can
+    // be missed between the checks and the sleep
+    core_util_critical_section_enter();
+
+#if DEVICE_WATCHDOG
+    // Kick while the checks are cheap, rather than waking up for it later
+    hal_watchdog_supervisor_service();
+#endif
+
+#if DEVICE_LPTICKER
+    if (core_util_atomic_load_u16(&deep_sleep_lock) == 0) {
+        const ticker_data_t *const lp_ticker = get_lp_ticker_data();
+        us_timestamp_t idle_time = time_to_next_event(lp_ticker);
+#if DEVICE_USTICKER
+        // Each channel of the us ticker has its own events
+        for (uint32_t i = 0; i < MBED_CONF_TARGET_US_TICKER_CHANNELS; i++) {
+            const us_timestamp_t us_idle_time = time_to_next_event(get_us_ticker_channel_data(i));
+            if (us_idle_time < idle_time) {
+                idle_time = us_idle_time;
+            }
+        }
+#endif
+        if (idle_time >= 2 * (us_timestamp_t)deep_sleep_latency_us) {
+            deep_sleep(lp_ticker, idle_time);
+            core_util_critical_section_exit();
+            return;
+        }
+    }
+#endif
+
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SLEEP_START, 0, 0);
+    hal_critical_section_sleep(hal_sleep);
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SLEEP_COMPLETE, 0, 0);
+    core_util_critical_section_exit();
+}
+
+void hal_idle_deep_sleep_lock(void)
+{
+    const uint16_t count = core_util_atomic_incr_u16(&deep_sleep_lock, 1);
+    MBED_ASSERT(count != 0);
+    (void)count;
+}
+
+void hal_idle_deep_sleep_unlock(void)
+{
+    const uint16_t count = core_util_atomic_decr_u16(&deep_sleep_lock, 1);
+    MBED_ASSERT(count != UINT16_MAX);
+    (void)count;
+}
+
+void hal_idle_deep_sleep_lock_owner(hal_idle_deep_sleep_owner_t *owner)
+{
+    core_util_critical_section_enter();
+    if (!owner->listed) {
+        owner->next = owners;
+        owners = owner;
+        owner->listed = true;
+    }
+    if (owner->locks == 0) {
+        owner->locked_at = owner_time_us();
+    }
+    owner->locks++;
+    owner->lock_count++;
+    hal_idle_deep_sleep_lock();
+    core_util_critical_section_exit();
+}
+
+void hal_idle_deep_sleep_unlock_owner(hal_idle_deep_sleep_owner_t *owner)
+{
+    core_util_critical_section_enter();
+    MBED_ASSERT(owner->locks != 0);
+    owner->locks--;
+    if (owner->locks == 0) {
+        owner->held_us += owner_time_us() - owner->locked_at;
+    }
+    hal_idle_deep_sleep_unlock();
+    core_util_critical_section_exit();
+}
+
+uint64_t hal_idle_deep_sleep_owner_held_us(const hal_idle_deep_sleep_owner_t *owner)
+{
+    core_util_critical_section_enter();
+    uint64_t held_us = owner->held_us;
+    if (owner->locks != 0) {
+        held_us += owner_time_us() - owner->locked_at;
+    }
+    core_util_critical_section_exit();
+    return held_us;
+}
+
+const hal_idle_deep_sleep_owner_t *hal_idle_deep_sleep_owner_next(const hal_idle_deep_sleep_owner_t *owner)
+{
+    return owner ? owner->next : owners;
+}
+
+void hal_idle_deep_sleep_owners_reset(void)
+{
+    core_util_critical_section_enter();
+    const uint64_t now = owner_time_us();
+    for (hal_idle_deep_sleep_owner_t *owner = owners; owner; owner = owner->next) {
+        owner->lock_count = 0;
+        owner->held_us = 0;
+        owner->locked_at = now;
+    }
+    core_util_critical_section_exit();
+}
+
+void hal_idle_deep_sleep_owners_trace(void)
+{
+    uint32_t anonymous = core_util_atomic_load_u16(&deep_sleep_lock);
+
+    for (const hal_idle_deep_sleep_owner_t *owner = owners; owner; owner = owner->next) {
+        const uint16_t locks = owner->locks;
+        tr_info("%s: %lu locks, %lu ms held%s", owner->name, (unsigned long)owner->lock_count,
+                (unsigned long)(hal_idle_deep_sleep_owner_held_us(owner) / 1000), locks ? ", locked" : "");
+        anonymous -= locks;
+    }
+    if (anonymous) {
+        tr_info("anonymous: %lu locks held", (unsigned long)anonymous);
+    }
+}
+
+void hal_idle_retention_register(hal_idle_retention_t *entry, void (*save)(void *context), void (*restore)(void *context), void *context)
+{
+    entry->save = save;
+    entry->restore = restore;
+    entry->context = context;
+
+    core_util_critical_section_enter();
+    entry->prev = NULL;
+    entry->next = retention_head;
+    if (retention_head) {
+        retention_head->prev = entry;
+    } else {
+        retention_tail = entry;
+    }
+    retention_head = entry;
+    core_util_critical_section_exit();
+}
+
+void hal_idle_retention_unregister(hal_idle_retention_t *entry)
+{
+    core_util_critical_section_enter();
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        retention_head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        retention_tail = entry->prev;
+    }
+    entry->next = NULL;
+    entry->prev = NULL;
+    core_util_critical_section_exit();
+}
+
+uint32_t hal_idle_deep_sleep_latency_us(void)
+{
+    return deep_sleep_latency_us;
+}
+
+void hal_idle_deep_sleep_stats_get(hal_idle_deep_sleep_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    *stats = deep_sleep_stats;
+    core_util_critical_section_exit();
+}
+
+void hal_idle_deep_sleep_stats_reset(void)
+{
+    core_util_critical_section_enter();
+    deep_sleep_stats.count = 0;
+    deep_sleep_stats.min_us = UINT32_MAX;
+    deep_sleep_stats.max_us = 0;
+    deep_sleep_stats.average_us = 0;
+    deep_sleep_stats.late = 0;
+    deep_sleep_latency_us = MBED_CONF_TARGET_DEEP_SLEEP_LATENCY;
+    core_util_critical_section_exit();
+}
+
+#endif // DEVICE_SLEEP
@@ -0,0 +1,140 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/image_verify_api.h"
+
+#if DEVICE_HASH
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+
+#if DEVICE_FLASH
+#include "hal/flash_api.h"
+#endif
+
+MBED_STATIC_ASSERT((MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE % HAL_HASH_BLOCK_SIZE) == 0,
+                   "MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE must be a multiple of HAL_HASH_BLOCK_SIZE");
+
+// One chunk is read into a buffer while the other is hashed
+static uint8_t chunks[2][MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE];
+static volatile bool hashed;
+
+static void chunk_hashed(uint32_t id)
+{
+    (void)id;
+    core_util_atomic_store_bool(&hashed, true);
+}
+
+static int start_hash(hal_hash_ctx_t *ctx, const uint8_t *data, uint32_t size)
+{
+    core_util_atomic_store_bool(&hashed, false);
+    return hal_hash_ctx_update_async(ctx, data, size, chunk_hashed, 0);
+}
+
+static void wait_hashed(void)
+{
+    while (!core_util_atomic_load_bool(&hashed)) {
+    }
+}
+
+static int hash_read(const image_verify_source_t *source, hal_hash_ctx_t *ctx, uint32_t address, uint32_t size)
+{
+    uint32_t length = size < sizeof(chunks[0]) ? size : sizeof(chunks[0]);
+    unsigned current = 0;
+
+    if (length > 0 && source->read(source->obj, address, chunks[current], length) != 0) {
+        return -1;
+    }
+
+    while (length > 0) {
+        if (start_hash(ctx, chunks[current], length) != 0) {
+            return -1;
+        }
+        address += length;
+        size -= length;
+
+        length = size < sizeof(chunks[0]) ? size : sizeof(chunks[0]);
+        const int32_t status = length > 0 ? source->read(source->obj, address, chunks[current ^ 1], length) : 0;
+        wait_hashed();
+        if (status != 0) {
+            return -1;
+        }
+        current ^= 1;
+    }
+
+    return 0;
+}
+
+int image_verify_digest(const image_verify_source_t *source, uint32_t address, uint32_t size,
+                        hal_hash_algorithm_t algorithm, uint8_t *digest)
+{
+    hal_hash_ctx_t ctx;
+
+    hal_hash_ctx_start(&ctx, algorithm);
+    if (source->read == NULL) {
+        // Hashed in place, the hash module reads the memory itself
+        if (start_hash(&ctx, (const uint8_t *)(uintptr_t)address, size) != 0) {
+            return -1;
+        }
+        wait_hashed();
+    } else if (hash_read(source, &ctx, address, size) != 0) {
+        return -1;
+    }
+
+    hal_hash_ctx_get_digest(&ctx, digest);
+    return 0;
+}
+
+int image_verify(const image_verify_source_t *source, uint32_t address, uint32_t size,
+                 hal_hash_algorithm_t algorithm, const uint8_t *expected)
+{
+    uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+    if (image_verify_digest(source, address, size, algorithm, digest) != 0) {
+        return -1;
+    }
+
+    // The time taken doesn't tell how many bytes match
+    uint8_t diff = 0;
+    const size_t digest_size = hal_hash_digest_size(algorithm);
+    for (size_t i = 0; i < digest_size; i++) {
+        diff |= digest[i] ^ expected[i];
+    }
+    return diff == 0 ? 0 : -1;
+}
+
+#if DEVICE_FLASH
+int32_t image_verify_flash_read(void *obj, uint32_t address, uint8_t *data, uint32_t size)
+{
+    return flash_read((flash_t *)obj, address, data, size);
+}
+#endif
+
+#if DEVICE_QSPI
+int32_t image_verify_qspi_read(void *obj, uint32_t address, uint8_t *data, uint32_t size)
+{
+    image_verify_qspi_t *image = (image_verify_qspi_t *)obj;
+    size_t length = size;
+
+    image->read_cmd.address.value = address;
+    if (qspi_read(image->qspi, &image->read_cmd, data, &length) != QSPI_STATUS_OK || length != size) {
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+#endif // DEVICE_HASH
@@ -0,0 +1,80 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/ipc_api.h"
+
+#if DEVICE_IPC
+
+#include "bootstrap/mbed_atomic.h"
+
+#include <string.h>
+
+void hal_ipc_hsem_lock(uint32_t sem)
+{
+    while (!hal_ipc_hsem_try_lock(sem)) {
+    }
+}
+
+/* Read a counter written by the other core. */
+static uint32_t read_shared(volatile uint32_t *counter)
+{
+    hal_dcache_invalidate_range((void *)counter, sizeof(*counter));
+    return core_util_atomic_load_u32(counter);
+}
+
+/* Write a counter read by the other core, after the items it publishes. */
+static void write_shared(volatile uint32_t *counter, uint32_t value)
+{
+    core_util_atomic_store_u32(counter, value);
+    hal_dcache_clean_range((const void *)counter, sizeof(*counter));
+}
+
+void hal_ipc_queue_reset(hal_ipc_queue_t *queue)
+{
+    write_shared(&queue->head, 0);
+    write_shared(&queue->tail, 0);
+}
+
+bool hal_ipc_queue_push(hal_ipc_queue_t *queue, const void *item)
+{
+    const uint32_t head = queue->head;
+    if (head - read_shared(&queue->tail) >= queue->count) {
+        return false;
+    }
+
+    uint8_t *slot = &queue->storage[(head & (queue->count - 1)) * queue->slot_size];
+    memcpy(slot, item, queue->item_size);
+    hal_dcache_clean_range(slot, queue->item_size);
+    write_shared(&queue->head, head + 1);
+    return true;
+}
+
+bool hal_ipc_queue_pop(hal_ipc_queue_t *queue, void *item)
+{
+    const uint32_t tail = queue->tail;
+    if (tail == read_shared(&queue->head)) {
+        return false;
+    }
+
+    uint8_t *slot = &queue->storage[(tail & (queue->count - 1)) * queue->slot_size];
+    hal_dcache_invalidate_range(slot, queue->item_size);
+    memcpy(item, slot, queue->item_size);
+    // The slot may be written again once the tail moves
+    write_shared(&queue->tail, tail + 1);
+    return true;
+}
+
+#endif // DEVICE_IPC
@@ -18,8 +18,11 @@
 
 #include "hal/itm_api.h"
 #include "cmsis.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_trace.h"
 
 #include <stdbool.h>
+#include <string.h>
 
 #ifndef ITM_STIM_FIFOREADY_Msk
 #define ITM_STIM_FIFOREADY_Msk 1
@@ -29,6 +32,40 @@
 
 #define SWO_NRZ 0x02
 #define SWO_STIMULUS_PORT 0x01
+#define TRACE_STIMULUS_PORTS ((1 << ITM_PORT_TRACE_ERROR) | \
+                              (1 << ITM_PORT_TRACE_WARN)  | \
+                              (1 << ITM_PORT_TRACE_INFO)  | \
+                              (1 << ITM_PORT_TRACE_DEBUG))
+
+/* The PC sampling counter counts down from POSTPRESET + 1 to 0 on every
+ * 2^6 or 2^10 cycles, selected by CYCTAP. */
+#define PC_SAMPLING_FAST_SHIFT 6
+#define PC_SAMPLING_SLOW_SHIFT 10
+#define PC_SAMPLING_MAX_RELOAD 16
+
+#if MBED_CONF_TARGET_ITM_TIMESTAMPS
+#ifdef ITM_TCR_TSPrescale_Pos
+#define ITM_TCR_TIMESTAMPS ((1 << ITM_TCR_TSENA_Pos) | \
+                            (MBED_CONF_TARGET_ITM_TIMESTAMP_PRESCALER << ITM_TCR_TSPrescale_Pos))
+#else
+#define ITM_TCR_TIMESTAMPS (1 << ITM_TCR_TSENA_Pos)
+#endif
+#else
+#define ITM_TCR_TIMESTAMPS 0
+#endif
+
+#define ITM_BUFFER_PORT_Msk   0x1F
+#define ITM_BUFFER_SIZE_Pos   5
+
+/* Pending port writes of the buffered output. Each entry is one 8-, 16- or
+ * 32-bit port write, so the FIFO is filled with as few writes as possible. */
+static struct {
+    uint32_t data[MBED_CONF_TARGET_ITM_BUFFER_SIZE];
+    uint8_t info[MBED_CONF_TARGET_ITM_BUFFER_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+} itm_buffer;
 
 void mbed_itm_init(void)
 {
@@ -63,13 +100,48 @@ void mbed_itm_init(void)
         ITM->TCR  = (1 << ITM_TCR_TraceBusID_Pos) |
                     (1 << ITM_TCR_DWTENA_Pos)     |
                     (1 << ITM_TCR_SYNCENA_Pos)    |
+                    ITM_TCR_TIMESTAMPS            |
                     (1 << ITM_TCR_ITMENA_Pos);
 
         /* Trace Enable Register */
-        ITM->TER = SWO_STIMULUS_PORT;
+        ITM->TER = SWO_STIMULUS_PORT | TRACE_STIMULUS_PORTS | MBED_CONF_TARGET_ITM_STIMULUS_PORTS;
     }
 }
 
+uint32_t mbed_itm_pc_sampling_start(uint32_t interval)
+{
+    const uint32_t shift = interval > (PC_SAMPLING_MAX_RELOAD << PC_SAMPLING_FAST_SHIFT) ?
+                           PC_SAMPLING_SLOW_SHIFT : PC_SAMPLING_FAST_SHIFT;
+    uint32_t reload = (interval + (1UL << (shift - 1))) >> shift;
+
+    if (reload < 1) {
+        reload = 1;
+    } else if (reload > PC_SAMPLING_MAX_RELOAD) {
+        reload = PC_SAMPLING_MAX_RELOAD;
+    }
+
+    mbed_itm_init();
+
+    /* The counter is only reloaded while sampling is disabled */
+    uint32_t ctrl = DWT->CTRL & ~(DWT_CTRL_PCSAMPLENA_Msk | DWT_CTRL_CYCTAP_Msk |
+                                  DWT_CTRL_POSTINIT_Msk | DWT_CTRL_POSTPRESET_Msk);
+    DWT->CTRL = ctrl;
+
+    ctrl |= ((shift == PC_SAMPLING_SLOW_SHIFT) << DWT_CTRL_CYCTAP_Pos) |
+            ((reload - 1) << DWT_CTRL_POSTINIT_Pos)   |
+            ((reload - 1) << DWT_CTRL_POSTPRESET_Pos) |
+            (1 << DWT_CTRL_CYCCNTENA_Pos);
+    DWT->CTRL = ctrl;
+    DWT->CTRL = ctrl | (1 << DWT_CTRL_PCSAMPLENA_Pos);
+
+    return reload << shift;
+}
+
+void mbed_itm_pc_sampling_stop(void)
+{
+    DWT->CTRL &= ~DWT_CTRL_PCSAMPLENA_Msk;
+}
+
 static void itm_out8(uint32_t port, uint8_t data)
 {
     /* Wait until port is available */
@@ -130,4 +202,148 @@ void mbed_itm_send_block(uint32_t port, const void *data, size_t len)
         }
     }
 }
+
+static bool itm_port_enabled(uint32_t port)
+{
+    return ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0UL) &&   /* ITM enabled */
+           ((ITM->TER & (1UL << port)) != 0UL);          /* ITM Port enabled */
+}
+
+bool mbed_itm_try_send(uint32_t port, uint32_t data)
+{
+    if (!itm_port_enabled(port) || (ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) == 0) {
+        return false;
+    }
+
+    ITM->PORT[port].u32 = data;
+    return true;
+}
+
+size_t mbed_itm_try_send_block(uint32_t port, const void *data, size_t len)
+{
+    const uint8_t *ptr = data;
+    size_t sent = 0;
+
+    if (!itm_port_enabled(port)) {
+        return 0;
+    }
+
+    /* Each access is checked and written with interrupts masked, so the
+     * sender of another port cannot fill the shared FIFO in between */
+    while (sent < len) {
+        const size_t size = (((uintptr_t)ptr & 3) == 0 && len - sent >= 4) ? 4 : 1;
+
+        core_util_critical_section_enter();
+        const bool ready = (ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) != 0;
+        if (ready) {
+            if (size == 4) {
+                ITM->PORT[port].u32 = *(const uint32_t *)ptr;
+            } else {
+                ITM->PORT[port].u8 = *ptr;
+            }
+        }
+        core_util_critical_section_exit();
+
+        if (!ready) {
+            break;
+        }
+        ptr += size;
+        sent += size;
+    }
+
+    return sent;
+}
+
+size_t mbed_itm_send_block_buffered(uint32_t port, const void *data, size_t len)
+{
+    const uint8_t *ptr = data;
+    size_t queued = 0;
+
+    /* Check if ITM and port is enabled */
+    if (((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0UL) ||       /* ITM disabled */
+            ((ITM->TER & (1UL << port)) == 0UL)) {       /* ITM Port disabled */
+        return 0;
+    }
+
+    core_util_critical_section_enter();
+    while (len != 0) {
+        if (itm_buffer.head - itm_buffer.tail == MBED_CONF_TARGET_ITM_BUFFER_SIZE) {
+            itm_buffer.dropped += len;
+            break;
+        }
+        uint32_t size = len >= 4 ? 4 : len >= 2 ? 2 : 1;
+        uint32_t index = itm_buffer.head % MBED_CONF_TARGET_ITM_BUFFER_SIZE;
+        uint32_t word = 0;
+        memcpy(&word, ptr, size);
+        itm_buffer.data[index] = word;
+        itm_buffer.info[index] = port | ((size - 1) << ITM_BUFFER_SIZE_Pos);
+        itm_buffer.head++;
+        ptr += size;
+        len -= size;
+        queued += size;
+    }
+    core_util_critical_section_exit();
+
+    mbed_itm_flush();
+
+    return queued;
+}
+
+void mbed_itm_flush(void)
+{
+    core_util_critical_section_enter();
+    while (itm_buffer.tail != itm_buffer.head) {
+        uint32_t index = itm_buffer.tail % MBED_CONF_TARGET_ITM_BUFFER_SIZE;
+        uint32_t port = itm_buffer.info[index] & ITM_BUFFER_PORT_Msk;
+
+        /* Leave the rest for later if the port is busy */
+        if ((ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) == 0) {
+            break;
+        }
+
+        switch ((itm_buffer.info[index] >> ITM_BUFFER_SIZE_Pos) + 1) {
+            case 4:
+                ITM->PORT[port].u32 = itm_buffer.data[index];
+                break;
+            case 2:
+                ITM->PORT[port].u16 = (uint16_t)itm_buffer.data[index];
+                break;
+            default:
+                ITM->PORT[port].u8 = (uint8_t)itm_buffer.data[index];
+                break;
+        }
+        itm_buffer.tail++;
+    }
+    core_util_critical_section_exit();
+}
+
+uint32_t mbed_itm_dropped(void)
+{
+    return itm_buffer.dropped;
+}
+
+void mbed_itm_trace_print(uint8_t dlevel, const char *str)
+{
+    uint32_t port;
+
+    switch (dlevel) {
+        case TRACE_LEVEL_ERROR:
+            port = ITM_PORT_TRACE_ERROR;
+            break;
+        case TRACE_LEVEL_WARN:
+            port = ITM_PORT_TRACE_WARN;
+            break;
+        case TRACE_LEVEL_INFO:
+            port = ITM_PORT_TRACE_INFO;
+            break;
+        case TRACE_LEVEL_DEBUG:
+            port = ITM_PORT_TRACE_DEBUG;
+            break;
+        default:
+            port = ITM_PORT_SWO;
+            break;
+    }
+
+    mbed_itm_send_block_buffered(port, str, strlen(str));
+}
 #endif // DEVICE_ITM
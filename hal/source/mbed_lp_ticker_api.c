@@ -15,9 +15,14 @@
  */
 
 #include "hal/lp_ticker_api.h"
+#include "hal/utils/critical_section_api.h"
 
 #if DEVICE_LPTICKER
 
+#ifdef LP_TICKER_IRQn
+#include "cmsis.h"
+#endif
+
 static ticker_event_queue_t events = { 0 };
 
 static ticker_irq_handler_type irq_handler = ticker_irq_handler;
@@ -57,6 +62,20 @@ ticker_irq_handler_type set_lp_ticker_irq_handler(ticker_irq_handler_type ticker
     return prev_irq_handler;
 }
 
+bool lp_ticker_set_irq_priority(uint32_t priority)
+{
+#ifdef LP_TICKER_IRQn
+    if (!hal_critical_section_masks_priority(priority)) {
+        return false;
+    }
+    NVIC_SetPriority(LP_TICKER_IRQn, priority);
+    return true;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
 void lp_ticker_irq_handler(void)
 {
 #if LPTICKER_DELAY_TICKS > 0
@@ -0,0 +1,301 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/ospi_api.h"
+
+#if DEVICE_OSPI
+
+#include "bootstrap/mbed_toolchain.h"
+#include <stddef.h>
+#include <string.h>
+
+MBED_WEAK ospi_status_t ospi_enable_memory_mapped(ospi_t *obj, const ospi_command_t *read_cmd)
+{
+    (void)obj;
+    (void)read_cmd;
+    return OSPI_STATUS_ERROR;
+}
+
+MBED_WEAK ospi_status_t ospi_enable_memory_mapped_rw(ospi_t *obj, const ospi_command_t *read_cmd, const ospi_command_t *write_cmd)
+{
+    (void)obj;
+    (void)read_cmd;
+    (void)write_cmd;
+    return OSPI_STATUS_ERROR;
+}
+
+MBED_WEAK ospi_status_t ospi_disable_memory_mapped(ospi_t *obj)
+{
+    (void)obj;
+    return OSPI_STATUS_ERROR;
+}
+
+MBED_WEAK const void *ospi_memory_mapped_base(const ospi_t *obj)
+{
+    (void)obj;
+    return NULL;
+}
+
+MBED_WEAK ospi_status_t ospi_write_async(ospi_t *obj, const ospi_command_t *command, const void *data, size_t length, ospi_async_handler handler, uint32_t id)
+{
+    ospi_status_t status = ospi_write(obj, command, data, &length);
+    if (status == OSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK ospi_status_t ospi_read_async(ospi_t *obj, const ospi_command_t *command, void *data, size_t length, ospi_async_handler handler, uint32_t id)
+{
+    ospi_status_t status = ospi_read(obj, command, data, &length);
+    if (status == OSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK ospi_status_t ospi_status_poll_async(ospi_t *obj, const ospi_command_t *command, uint8_t mask, uint8_t match, ospi_async_handler handler, uint32_t id)
+{
+    uint8_t reg;
+    ospi_status_t status;
+
+    do {
+        status = ospi_command_transfer(obj, command, NULL, 0, &reg, 1);
+    } while ((status == OSPI_STATUS_OK) && ((reg & mask) != match));
+
+    if (status == OSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK bool ospi_async_active(ospi_t *obj)
+{
+    (void)obj;
+    return false;
+}
+
+MBED_WEAK void ospi_abort_async(ospi_t *obj)
+{
+    (void)obj;
+}
+
+MBED_WEAK void ospi_get_capabilities(ospi_t *obj, ospi_capabilities_t *cap)
+{
+    (void)obj;
+    memset(cap, 0, sizeof(*cap));
+    cap->bus_widths = (1 << (OSPI_CFG_BUS_OCTA_DTR + 1)) - 1;
+}
+
+MBED_WEAK ospi_status_t ospi_set_sample_delay(ospi_t *obj, uint32_t delay)
+{
+    (void)obj;
+    return delay == 0 ? OSPI_STATUS_OK : OSPI_STATUS_INVALID_PARAMETER;
+}
+
+MBED_WEAK ospi_status_t ospi_set_dqs(ospi_t *obj, bool enable)
+{
+    (void)obj;
+    return enable ? OSPI_STATUS_ERROR : OSPI_STATUS_OK;
+}
+
+static bool ospi_calibration_read(ospi_t *obj, const ospi_command_t *read_cmd, const void *pattern, size_t length)
+{
+    uint8_t data[OSPI_CALIBRATION_MAX_LENGTH];
+    size_t read_length = length;
+
+    if (ospi_read(obj, read_cmd, data, &read_length) != OSPI_STATUS_OK) {
+        return false;
+    }
+    return (read_length == length) && (memcmp(data, pattern, length) == 0);
+}
+
+ospi_status_t ospi_calibrate(ospi_t *obj, const ospi_command_t *read_cmd, const void *pattern, size_t length,
+                             uint32_t min_hz, ospi_calibration_t *result)
+{
+    ospi_capabilities_t cap;
+
+    if ((length == 0) || (length > OSPI_CALIBRATION_MAX_LENGTH) || (min_hz == 0) ||
+            (read_cmd->data.bus_width > OSPI_CFG_BUS_OCTA_DTR)) {
+        return OSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    ospi_get_capabilities(obj, &cap);
+    if ((cap.bus_widths & (1 << read_cmd->data.bus_width)) == 0) {
+        return OSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    const uint32_t delays = cap.sample_delays ? cap.sample_delays : 1;
+    uint32_t hz = cap.max_hz[read_cmd->data.bus_width];
+    if (hz < min_hz) {
+        hz = min_hz;
+    }
+
+    while (hz >= min_hz) {
+        if (ospi_frequency(obj, hz) == OSPI_STATUS_OK) {
+            if (cap.dqs && (ospi_set_dqs(obj, true) == OSPI_STATUS_OK)) {
+                if (ospi_calibration_read(obj, read_cmd, pattern, length)) {
+                    result->hz = hz;
+                    result->sample_delay = 0;
+                    result->dqs = true;
+                    return OSPI_STATUS_OK;
+                }
+                ospi_set_dqs(obj, false);
+            }
+
+            // look for the widest window of passing delays and use its middle
+            uint32_t best_start = 0, best_count = 0, start = 0, count = 0;
+            for (uint32_t delay = 0; delay < delays; delay++) {
+                if ((ospi_set_sample_delay(obj, delay) == OSPI_STATUS_OK) &&
+                        ospi_calibration_read(obj, read_cmd, pattern, length)) {
+                    if (count++ == 0) {
+                        start = delay;
+                    }
+                    if (count > best_count) {
+                        best_start = start;
+                        best_count = count;
+                    }
+                } else {
+                    count = 0;
+                }
+            }
+
+            if (best_count > 0) {
+                result->hz = hz;
+                result->sample_delay = best_start + (best_count - 1) / 2;
+                result->dqs = false;
+                return ospi_set_sample_delay(obj, result->sample_delay);
+            }
+        }
+
+        if (hz == min_hz) {
+            break;
+        }
+        hz -= hz / 8;
+        if (hz < min_hz) {
+            hz = min_hz;
+        }
+    }
+
+    return OSPI_STATUS_ERROR;
+}
+
+void ospi_read_cache_init(ospi_read_cache_t *cache, ospi_t *obj, const ospi_command_t *read_cmd)
+{
+    memset(cache, 0, sizeof(*cache));
+    cache->ospi = obj;
+    cache->read_cmd = *read_cmd;
+}
+
+static ospi_read_cache_line_t *read_cache_line(ospi_read_cache_t *cache, uint32_t line_address, ospi_status_t *status)
+{
+    ospi_read_cache_line_t *victim = &cache->lines[0];
+
+    *status = OSPI_STATUS_OK;
+    cache->use_count++;
+    for (size_t i = 0; i < MBED_CONF_TARGET_OSPI_READ_CACHE_LINES; i++) {
+        ospi_read_cache_line_t *line = &cache->lines[i];
+        if (line->valid && line->address == line_address) {
+            line->last_use = cache->use_count;
+            return line;
+        }
+        // Invalid lines first, then the least recently used one
+        if (victim->valid && (!line->valid || (cache->use_count - line->last_use > cache->use_count - victim->last_use))) {
+            victim = line;
+        }
+    }
+
+    size_t length = MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE;
+    victim->valid = false;
+    cache->read_cmd.address.value = line_address;
+    *status = ospi_read(cache->ospi, &cache->read_cmd, victim->data, &length);
+    if (*status != OSPI_STATUS_OK) {
+        return NULL;
+    }
+    if (length != MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE) {
+        *status = OSPI_STATUS_ERROR;
+        return NULL;
+    }
+    victim->address = line_address;
+    victim->last_use = cache->use_count;
+    victim->valid = true;
+    return victim;
+}
+
+ospi_status_t ospi_read_cache_read(ospi_read_cache_t *cache, uint32_t address, void *data, size_t length)
+{
+    uint8_t *out = (uint8_t *)data;
+    ospi_status_t status = OSPI_STATUS_OK;
+
+    if (length > MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE) {
+        cache->read_cmd.address.value = address;
+        return ospi_read(cache->ospi, &cache->read_cmd, data, &length);
+    }
+
+    while (length > 0) {
+        const uint32_t offset = address % MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE;
+        size_t chunk = MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE - offset;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        const ospi_read_cache_line_t *line = read_cache_line(cache, address - offset, &status);
+        if (line == NULL) {
+            return status;
+        }
+        memcpy(out, &line->data[offset], chunk);
+
+        out += chunk;
+        address += chunk;
+        length -= chunk;
+    }
+    return status;
+}
+
+void ospi_read_cache_invalidate(ospi_read_cache_t *cache, uint32_t address, size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+    for (size_t i = 0; i < MBED_CONF_TARGET_OSPI_READ_CACHE_LINES; i++) {
+        ospi_read_cache_line_t *line = &cache->lines[i];
+        // The line overlaps [address, address + length)
+        if (line->valid && (line->address - address < length ||
+                            address - line->address < MBED_CONF_TARGET_OSPI_READ_CACHE_LINE_SIZE)) {
+            line->valid = false;
+        }
+    }
+}
+
+ospi_status_t ospi_read_cache_write(ospi_read_cache_t *cache, const ospi_command_t *command, const void *data, size_t *length)
+{
+    const size_t requested = *length;
+    const ospi_status_t status = ospi_write(cache->ospi, command, data, length);
+
+    // Part of the data may have been written on error
+    ospi_read_cache_invalidate(cache, command->address.value, requested);
+    return status;
+}
+
+ospi_status_t ospi_read_cache_erase(ospi_read_cache_t *cache, const ospi_command_t *command, size_t size)
+{
+    const ospi_status_t status = ospi_command_transfer(cache->ospi, command, NULL, 0, NULL, 0);
+
+    ospi_read_cache_invalidate(cache, command->address.value, size);
+    return status;
+}
+
+#endif // DEVICE_OSPI
@@ -16,22 +16,63 @@
 
 #include "hal/pinmap.h"
 #include "bootstrap/mbed_error.h"
+#include "bootstrap/mbed_toolchain.h"
+#include <stddef.h>
 
-void pinmap_pinout(PinName pin, const PinMap *map)
+MBED_WEAK const PinMapIndex *pinmap_index(const PinMap *map)
 {
-    if (pin == NC) {
-        return;
+    (void)map;
+    return NULL;
+}
+
+const PinMap *pinmap_index_find(const PinMapIndex *index, PinName pin)
+{
+    // lower bound, so duplicate pins resolve to the same entry as a linear scan
+    uint32_t first = 0;
+    uint32_t last = index->count;
+    while (first < last) {
+        const uint32_t middle = first + (last - first) / 2;
+        if ((int)index->sorted[middle].pin < (int)pin) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    if (first < index->count && index->sorted[first].pin == pin) {
+        return &index->sorted[first];
+    }
+    return NULL;
+}
+
+static const PinMap *pinmap_find(PinName pin, const PinMap *map)
+{
+    const PinMapIndex *index = pinmap_index(map);
+    if (index) {
+        return pinmap_index_find(index, pin);
     }
 
     while (map->pin != NC) {
         if (map->pin == pin) {
-            pin_function(pin, map->function);
-
-            pin_mode(pin, PullNone);
-            return;
+            return map;
         }
         map++;
     }
+    return NULL;
+}
+
+void pinmap_pinout(PinName pin, const PinMap *map)
+{
+    if (pin == NC) {
+        return;
+    }
+
+    const PinMap *entry = pinmap_find(pin, map);
+    if (entry) {
+        pin_function(pin, entry->function);
+
+        pin_mode(pin, PullNone);
+        return;
+    }
     MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_PINMAP_INVALID), "could not pinout", pin);
 }
 
@@ -56,13 +97,8 @@ uint32_t pinmap_merge(uint32_t a, uint32_t b)
 
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap *map)
 {
-    while (map->pin != NC) {
-        if (map->pin == pin) {
-            return map->peripheral;
-        }
-        map++;
-    }
-    return (uint32_t)NC;
+    const PinMap *entry = pinmap_find(pin, map);
+    return entry ? (uint32_t)entry->peripheral : (uint32_t)NC;
 }
 
 uint32_t pinmap_peripheral(PinName pin, const PinMap *map)
@@ -81,13 +117,8 @@ uint32_t pinmap_peripheral(PinName pin, const PinMap *map)
 
 uint32_t pinmap_find_function(PinName pin, const PinMap *map)
 {
-    while (map->pin != NC) {
-        if (map->pin == pin) {
-            return map->function;
-        }
-        map++;
-    }
-    return (uint32_t)NC;
+    const PinMap *entry = pinmap_find(pin, map);
+    return entry ? (uint32_t)entry->function : (uint32_t)NC;
 }
 
 uint32_t pinmap_function(PinName pin, const PinMap *map)
@@ -104,7 +135,7 @@ uint32_t pinmap_function(PinName pin, const PinMap *map)
     return function;
 }
 
-bool pinmap_find_peripheral_pins(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count)
+static bool pinmap_find_peripheral_pins_recursive(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count)
 {
     /*
      * This function uses recursion to find a suitable set of pins which meet the requirements.
@@ -156,7 +187,7 @@ bool pinmap_find_peripheral_pins(const PinList *whitelist, const PinList *blackl
                     continue;
                 }
                 *pin = map->pin;
-                if (pinmap_find_peripheral_pins(whitelist, blacklist, per, maps, pins, count)) {
+                if (pinmap_find_peripheral_pins_recursive(whitelist, blacklist, per, maps, pins, count)) {
                     return true;
                 }
             }
@@ -167,6 +198,166 @@ bool pinmap_find_peripheral_pins(const PinList *whitelist, const PinList *blackl
     return true;
 }
 
+#define PIN_SET_WORDS ((MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS + 31) / 32)
+
+/* Set of candidate pins, bit n stands for pin_solver_t::pins[n] */
+typedef struct {
+    uint32_t bits[PIN_SET_WORDS];
+} pin_set_t;
+
+typedef struct {
+    PinName pins[MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS];
+    uint32_t pin_count;
+    pin_set_t candidates[PINMAP_SOLVER_MAX_MAPS];
+    PinName **assigned;
+    uint32_t count;
+    pinmap_pins_handler handler;
+    void *context;
+    uint32_t found;
+} pin_solver_t;
+
+static uint32_t pin_set_count_free(const pin_set_t *set, const pin_set_t *used)
+{
+    uint32_t n = 0;
+    for (uint32_t w = 0; w < PIN_SET_WORDS; w++) {
+        for (uint32_t bits = set->bits[w] & ~used->bits[w]; bits; bits &= bits - 1) {
+            n++;
+        }
+    }
+    return n;
+}
+
+static bool pin_solver_init(pin_solver_t *solver, const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count)
+{
+    solver->pin_count = 0;
+    solver->assigned = pins;
+    solver->count = count;
+    solver->found = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        pin_set_t *candidates = &solver->candidates[i];
+        for (uint32_t w = 0; w < PIN_SET_WORDS; w++) {
+            candidates->bits[w] = 0;
+        }
+        if (*pins[i] != NC) {
+            continue;
+        }
+        for (const PinMap *map = maps[i]; map->pin != NC; map++) {
+            if (map->peripheral != per) {
+                continue;
+            }
+            if (!pinmap_list_has_pin(whitelist, map->pin)) {
+                // Not part of this form factor
+                continue;
+            }
+            if (pinmap_list_has_pin(blacklist, map->pin)) {
+                // Restricted pin
+                continue;
+            }
+            bool already_in_use = false;
+            for (uint32_t j = 0; j < count; j++) {
+                if (map->pin == *pins[j]) {
+                    already_in_use = true;
+                    break;
+                }
+            }
+            if (already_in_use) {
+                continue;
+            }
+
+            uint32_t index = 0;
+            while (index < solver->pin_count && solver->pins[index] != map->pin) {
+                index++;
+            }
+            if (index == solver->pin_count) {
+                if (index == MBED_CONF_TARGET_PINMAP_SOLVER_MAX_PINS) {
+                    return false;
+                }
+                solver->pins[solver->pin_count++] = map->pin;
+            }
+            candidates->bits[index / 32] |= 1UL << (index % 32);
+        }
+    }
+    return true;
+}
+
+/* Returns false once the handler asks to stop, leaving the last combination in the pins */
+static bool pin_solver_search(pin_solver_t *solver, pin_set_t *used)
+{
+    // Branch on the pin with the fewest free candidates, a pin with none is a dead end
+    uint32_t best = solver->count;
+    uint32_t best_free = UINT32_MAX;
+    for (uint32_t i = 0; i < solver->count; i++) {
+        if (*solver->assigned[i] != NC) {
+            continue;
+        }
+        const uint32_t n = pin_set_count_free(&solver->candidates[i], used);
+        if (n == 0) {
+            return true;
+        }
+        if (n < best_free) {
+            best = i;
+            best_free = n;
+        }
+    }
+
+    if (best == solver->count) {
+        solver->found++;
+        return solver->handler(solver->context);
+    }
+
+    const pin_set_t *candidates = &solver->candidates[best];
+    for (uint32_t index = 0; index < solver->pin_count; index++) {
+        const uint32_t mask = 1UL << (index % 32);
+        if (!(candidates->bits[index / 32] & mask) || (used->bits[index / 32] & mask)) {
+            continue;
+        }
+        *solver->assigned[best] = solver->pins[index];
+        used->bits[index / 32] |= mask;
+        if (!pin_solver_search(solver, used)) {
+            return false;
+        }
+        used->bits[index / 32] &= ~mask;
+    }
+    *solver->assigned[best] = NC;
+    return true;
+}
+
+static uint32_t pin_solver_run(pin_solver_t *solver)
+{
+    pin_set_t used = { { 0 } };
+    pin_solver_search(solver, &used);
+    return solver->found;
+}
+
+static bool pinmap_stop_at_first(void *context)
+{
+    (void)context;
+    return false;
+}
+
+bool pinmap_find_peripheral_pins(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count)
+{
+    pin_solver_t solver;
+    if (count > PINMAP_SOLVER_MAX_MAPS || !pin_solver_init(&solver, whitelist, blacklist, per, maps, pins, count)) {
+        return pinmap_find_peripheral_pins_recursive(whitelist, blacklist, per, maps, pins, count);
+    }
+    solver.handler = pinmap_stop_at_first;
+    solver.context = NULL;
+    return pin_solver_run(&solver) != 0;
+}
+
+uint32_t pinmap_find_all_peripheral_pins(const PinList *whitelist, const PinList *blacklist, int per, const PinMap *const *maps, PinName **pins, uint32_t count, pinmap_pins_handler handler, void *context)
+{
+    pin_solver_t solver;
+    if (count > PINMAP_SOLVER_MAX_MAPS || !pin_solver_init(&solver, whitelist, blacklist, per, maps, pins, count)) {
+        return 0;
+    }
+    solver.handler = handler;
+    solver.context = context;
+    return pin_solver_run(&solver);
+}
+
 bool pinmap_list_has_pin(const PinList *list, PinName pin)
 {
     for (uint32_t i = 0; i < list->count; i++) {
@@ -0,0 +1,225 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/port_capture_api.h"
+
+#if DEVICE_PORTIN
+
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+#include "hal/us_ticker_api.h"
+
+/* Store one sample, return true once the buffer is full */
+static bool store_sample(port_capture_t *capture)
+{
+    const uint32_t value = (uint32_t)port_read(capture->port);
+    const size_t index = capture->index;
+
+    switch (capture->width) {
+        case 1:
+            capture->buffer[index] = (uint8_t)value;
+            break;
+        case 2:
+            ((uint16_t *)capture->buffer)[index] = (uint16_t)value;
+            break;
+        default:
+            ((uint32_t *)capture->buffer)[index] = value;
+            break;
+    }
+    capture->index = index + 1;
+
+    return capture->index == capture->count;
+}
+
+static void complete(port_capture_t *capture, uint32_t events)
+{
+    port_capture_stop(capture);
+    capture->handler(capture->id, events);
+}
+
+#if DEVICE_DMA
+MBED_WEAK int port_capture_dma_get(port_t *obj, const port_capture_config_t *config, port_capture_dma_t *dma)
+{
+    (void)obj;
+    (void)config;
+    (void)dma;
+    return -1;
+}
+
+MBED_WEAK void port_capture_dma_release(port_t *obj)
+{
+    (void)obj;
+}
+
+static void dma_handler_capture(uint32_t id, uint32_t events)
+{
+    port_capture_t *capture = (port_capture_t *)id;
+
+    capture->index = (events & DMA_EVENT_ERROR) ? 0 : capture->count;
+    complete(capture, (events & DMA_EVENT_ERROR) ? PORT_CAPTURE_EVENT_ERROR : PORT_CAPTURE_EVENT_COMPLETE);
+}
+
+static int start_dma(port_capture_t *capture, const port_capture_config_t *config)
+{
+    port_capture_dma_t dma;
+
+    if (port_capture_dma_get(capture->port, config, &dma) != 0) {
+        return -1;
+    }
+    const int channel = hal_dma_channel_allocate(dma.request);
+    if (channel < 0) {
+        port_capture_dma_release(capture->port);
+        return -1;
+    }
+
+    dma_descriptor_t *descriptor = &capture->descriptor;
+    descriptor->src = dma.data;
+    descriptor->dst = capture->buffer;
+    descriptor->count = capture->count;
+    descriptor->width = (dma_width_t)config->width;
+    descriptor->src_increment = false;
+    descriptor->dst_increment = true;
+    descriptor->next = NULL;
+
+    capture->channel = channel;
+    hal_dma_channel_init(channel, dma.request);
+    hal_dma_start(channel, descriptor, dma_handler_capture, (uint32_t)capture);
+    return 0;
+}
+#endif
+
+#if DEVICE_INTERRUPTIN
+static void irq_handler_capture(uint32_t id, gpio_irq_event event)
+{
+    port_capture_t *capture = (port_capture_t *)id;
+
+    (void)event;
+    if (capture->irq_used && store_sample(capture)) {
+        complete(capture, PORT_CAPTURE_EVENT_COMPLETE);
+    }
+}
+
+static int start_irq(port_capture_t *capture, const port_capture_config_t *config)
+{
+    if (gpio_irq_init(&capture->irq, config->clock, irq_handler_capture, (uint32_t)capture) != 0) {
+        return -1;
+    }
+    capture->irq_used = true;
+    gpio_irq_set(&capture->irq, config->edge, 1);
+    gpio_irq_enable(&capture->irq);
+    return 0;
+}
+#endif
+
+#if DEVICE_USTICKER
+/* Blocking: the samples are taken on the schedule of the us ticker, not
+ * starting again from each read, so the rate does not drift. */
+static int capture_at_rate(port_capture_t *capture, uint32_t rate_hz)
+{
+    if (rate_hz == 0 || rate_hz > 1000000) {
+        return -1;
+    }
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const uint32_t interval_us = 1000000 / rate_hz;
+
+    core_util_critical_section_enter();
+    us_timestamp_t next = ticker_read_us(ticker);
+    do {
+        while (ticker_read_us(ticker) < next) {
+        }
+        next += interval_us;
+    } while (!store_sample(capture));
+    core_util_critical_section_exit();
+
+    capture->handler(capture->id, PORT_CAPTURE_EVENT_COMPLETE);
+    return 0;
+}
+#endif
+
+int port_capture_start(port_capture_t *capture, port_t *port, const port_capture_config_t *config, void *buffer, size_t count, port_capture_handler handler, uint32_t id)
+{
+    capture->port = port;
+    capture->buffer = (uint8_t *)buffer;
+    capture->count = count;
+    capture->index = 0;
+    capture->width = config->width;
+    capture->handler = handler;
+    capture->id = id;
+    capture->channel = -1;
+#if DEVICE_INTERRUPTIN
+    capture->irq_used = false;
+#endif
+
+    if (count == 0 || (config->clock == NC && config->rate_hz == 0)) {
+        return -1;
+    }
+
+#if DEVICE_DMA
+    if (start_dma(capture, config) == 0) {
+        return 0;
+    }
+#endif
+
+    if (config->clock != NC) {
+#if DEVICE_INTERRUPTIN
+        return start_irq(capture, config);
+#else
+        return -1;
+#endif
+    }
+
+#if DEVICE_USTICKER
+    return capture_at_rate(capture, config->rate_hz);
+#else
+    return -1;
+#endif
+}
+
+void port_capture_stop(port_capture_t *capture)
+{
+    core_util_critical_section_enter();
+
+#if DEVICE_DMA
+    if (capture->channel >= 0) {
+        hal_dma_abort(capture->channel);
+        hal_dma_channel_free(capture->channel);
+        port_capture_dma_release(capture->port);
+        capture->channel = -1;
+    }
+#endif
+#if DEVICE_INTERRUPTIN
+    if (capture->irq_used) {
+        gpio_irq_disable(&capture->irq);
+        gpio_irq_free(&capture->irq);
+        capture->irq_used = false;
+    }
+#endif
+    capture->count = capture->index;
+
+    core_util_critical_section_exit();
+}
+
+bool port_capture_is_busy(port_capture_t *capture)
+{
+    return capture->index < capture->count;
+}
+
+bool port_capture_uses_dma(port_capture_t *capture)
+{
+    return capture->channel >= 0;
+}
+
+#endif // DEVICE_PORTIN
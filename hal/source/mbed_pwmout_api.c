@@ -0,0 +1,227 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/pwmout_api.h"
+#include "hal/pwmout_group_api.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/dma_api.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_PWMOUT
+
+#define PWMOUT_DUTY_MAX 0xFFFF
+#define PWMOUT_US_TICK_FREQUENCY 1000000
+
+MBED_WEAK void pwmout_write_u16(pwmout_t *obj, uint16_t duty)
+{
+    const uint32_t period = (uint32_t)pwmout_read_period_us(obj);
+    uint32_t pulsewidth = period;
+    if (duty != PWMOUT_DUTY_MAX) {
+        // Round to nearest, scaling by 2^16 instead of dividing by 65535.
+        // Stay in 32 bits for periods up to 65.536 ms.
+        if (period <= 0x10000) {
+            pulsewidth = (period * duty + 0x8000) >> 16;
+        } else {
+            pulsewidth = (uint32_t)(((uint64_t)period * duty + 0x8000) >> 16);
+        }
+    }
+    pwmout_pulsewidth_us(obj, (int)pulsewidth);
+}
+
+MBED_WEAK uint16_t pwmout_read_u16(pwmout_t *obj)
+{
+    const uint32_t period = (uint32_t)pwmout_read_period_us(obj);
+    const uint32_t pulsewidth = (uint32_t)pwmout_read_pulsewidth_us(obj);
+    if (period == 0) {
+        return 0;
+    }
+    if (pulsewidth >= period) {
+        return PWMOUT_DUTY_MAX;
+    }
+    if (pulsewidth <= 0x10000) {
+        return (uint16_t)((pulsewidth * PWMOUT_DUTY_MAX + period / 2) / period);
+    }
+    return (uint16_t)(((uint64_t)pulsewidth * PWMOUT_DUTY_MAX + period / 2) / period);
+}
+
+MBED_WEAK uint32_t pwmout_tick_frequency(pwmout_t *obj)
+{
+    (void)obj;
+    return PWMOUT_US_TICK_FREQUENCY;
+}
+
+MBED_WEAK void pwmout_period_ticks(pwmout_t *obj, uint32_t ticks)
+{
+    pwmout_period_us(obj, (int)ticks);
+}
+
+MBED_WEAK void pwmout_pulsewidth_ticks(pwmout_t *obj, uint32_t ticks)
+{
+    pwmout_pulsewidth_us(obj, (int)ticks);
+}
+
+MBED_WEAK void pwmout_write_u16_sync(pwmout_t *const *objs, const uint16_t *duty, size_t count)
+{
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < count; i++) {
+        pwmout_write_u16(objs[i], duty[i]);
+    }
+    core_util_critical_section_exit();
+}
+
+MBED_WEAK int pwmout_period_irq_set(pwmout_t *obj, pwmout_irq_handler handler, uint32_t id)
+{
+    (void)obj;
+    (void)handler;
+    (void)id;
+    return -1;
+}
+
+MBED_WEAK int pwmout_burst_dma_get(pwmout_t *obj, pwmout_burst_dma_t *dma)
+{
+    (void)obj;
+    (void)dma;
+    return -1;
+}
+
+#if DEVICE_DMA
+/* Outputs running a burst, a free slot has no object */
+static struct {
+    pwmout_t *obj;
+    int channel;
+    dma_descriptor_t descriptor;
+    pwmout_burst_handler handler;
+    uint32_t id;
+} bursts[MBED_CONF_TARGET_PWMOUT_BURST_COUNT];
+
+static void pwmout_burst_release(size_t slot)
+{
+    hal_dma_channel_free(bursts[slot].channel);
+    core_util_critical_section_enter();
+    bursts[slot].obj = NULL;
+    core_util_critical_section_exit();
+}
+
+static void pwmout_burst_dma_handler(uint32_t id, uint32_t events)
+{
+    const pwmout_burst_handler handler = bursts[id].handler;
+    const uint32_t handler_id = bursts[id].id;
+
+    // The slot can be reused by the handler
+    pwmout_burst_release(id);
+    handler(handler_id, (events & DMA_EVENT_ERROR) ? PWMOUT_BURST_EVENT_ERROR : PWMOUT_BURST_EVENT_COMPLETE);
+}
+#endif
+
+MBED_WEAK void pwmout_get_capabilities(pwmout_t *obj, pwmout_capabilities_t *cap)
+{
+#if DEVICE_DMA
+    pwmout_burst_dma_t dma;
+    cap->burst = pwmout_burst_dma_get(obj, &dma) == 0;
+#else
+    (void)obj;
+    cap->burst = false;
+#endif
+}
+
+MBED_WEAK int pwmout_burst_start(pwmout_t *obj, const uint16_t *pulsewidths, size_t count, pwmout_burst_handler handler, uint32_t id)
+{
+#if DEVICE_DMA
+    pwmout_burst_dma_t dma;
+    size_t slot = MBED_CONF_TARGET_PWMOUT_BURST_COUNT;
+
+    if (count == 0 || pwmout_burst_dma_get(obj, &dma) != 0) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < MBED_CONF_TARGET_PWMOUT_BURST_COUNT; i++) {
+        if (bursts[i].obj == NULL) {
+            bursts[i].obj = obj;
+            slot = i;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+    if (slot == MBED_CONF_TARGET_PWMOUT_BURST_COUNT) {
+        return -1;
+    }
+
+    const int channel = hal_dma_channel_allocate(dma.request);
+    if (channel < 0) {
+        core_util_critical_section_enter();
+        bursts[slot].obj = NULL;
+        core_util_critical_section_exit();
+        return -1;
+    }
+
+    bursts[slot].channel = channel;
+    bursts[slot].handler = handler;
+    bursts[slot].id = id;
+    bursts[slot].descriptor.src = pulsewidths;
+    bursts[slot].descriptor.dst = dma.compare;
+    bursts[slot].descriptor.count = count;
+    bursts[slot].descriptor.width = DMA_WIDTH_16BIT;
+    bursts[slot].descriptor.src_increment = true;
+    bursts[slot].descriptor.dst_increment = false;
+    bursts[slot].descriptor.next = NULL;
+
+    hal_dma_channel_init(channel, dma.request);
+    hal_dma_start(channel, &bursts[slot].descriptor, pwmout_burst_dma_handler, slot);
+    return 0;
+#else
+    (void)obj;
+    (void)pulsewidths;
+    (void)count;
+    (void)handler;
+    (void)id;
+    return -1;
+#endif
+}
+
+MBED_WEAK void pwmout_burst_stop(pwmout_t *obj)
+{
+#if DEVICE_DMA
+    // Not to race with the end of the burst
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < MBED_CONF_TARGET_PWMOUT_BURST_COUNT; i++) {
+        if (bursts[i].obj == obj) {
+            hal_dma_abort(bursts[i].channel);
+            pwmout_burst_release(i);
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+#else
+    (void)obj;
+#endif
+}
+
+#if DEVICE_PWMOUT_GROUP
+MBED_WEAK void pwmout_group_write_u16(pwmout_group_t *obj, const uint16_t *duty)
+{
+    const uint32_t period = pwmout_group_period_ticks(obj);
+    const size_t count = pwmout_group_channel_count(obj);
+    uint32_t pulsewidths[PWMOUT_GROUP_MAX_CHANNELS];
+
+    for (size_t i = 0; i < count; i++) {
+        pulsewidths[i] = (duty[i] == PWMOUT_DUTY_MAX) ? period : (uint32_t)(((uint64_t)period * duty[i] + 0x8000) >> 16);
+    }
+    pwmout_group_write(obj, pulsewidths);
+}
+#endif // DEVICE_PWMOUT_GROUP
+
+#endif // DEVICE_PWMOUT
@@ -0,0 +1,252 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/qspi_api.h"
+
+#if DEVICE_QSPI
+
+#include "bootstrap/mbed_toolchain.h"
+#include <stddef.h>
+#include <string.h>
+
+MBED_WEAK qspi_status_t qspi_enable_memory_mapped(qspi_t *obj, const qspi_command_t *read_cmd)
+{
+    (void)obj;
+    (void)read_cmd;
+    return QSPI_STATUS_ERROR;
+}
+
+MBED_WEAK qspi_status_t qspi_disable_memory_mapped(qspi_t *obj)
+{
+    (void)obj;
+    return QSPI_STATUS_ERROR;
+}
+
+MBED_WEAK const void *qspi_memory_mapped_base(const qspi_t *obj)
+{
+    (void)obj;
+    return NULL;
+}
+
+MBED_WEAK qspi_status_t qspi_write_async(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_async_handler handler, uint32_t id)
+{
+    qspi_status_t status = qspi_write(obj, command, data, &length);
+    if (status == QSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK qspi_status_t qspi_read_async(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_async_handler handler, uint32_t id)
+{
+    qspi_status_t status = qspi_read(obj, command, data, &length);
+    if (status == QSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK qspi_status_t qspi_status_poll_async(qspi_t *obj, const qspi_command_t *command, uint8_t mask, uint8_t match, qspi_async_handler handler, uint32_t id)
+{
+    uint8_t reg;
+    qspi_status_t status;
+
+    do {
+        status = qspi_command_transfer(obj, command, NULL, 0, &reg, 1);
+    } while ((status == QSPI_STATUS_OK) && ((reg & mask) != match));
+
+    if (status == QSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+static void sequence_poll_handler(uint32_t id, qspi_status_t status)
+{
+    *(volatile qspi_status_t *)id = status;
+}
+
+static qspi_status_t sequence_poll(qspi_t *obj, const qspi_step_t *step)
+{
+    // Set by the handler, which the controller may call from interrupt context
+    volatile qspi_status_t result = QSPI_STATUS_INVALID_PARAMETER;
+
+    qspi_status_t status = qspi_status_poll_async(obj, &step->command, step->poll_mask, step->poll_match,
+                                                  sequence_poll_handler, (uint32_t)&result);
+    if (status != QSPI_STATUS_OK) {
+        return status;
+    }
+    while (result == QSPI_STATUS_INVALID_PARAMETER);
+    return result;
+}
+
+MBED_WEAK qspi_status_t qspi_command_sequence(qspi_t *obj, const qspi_step_t *steps, size_t count)
+{
+    qspi_status_t status = QSPI_STATUS_OK;
+
+    for (size_t i = 0; (i < count) && (status == QSPI_STATUS_OK); i++) {
+        const qspi_step_t *step = &steps[i];
+        size_t length;
+
+        switch (step->type) {
+            case QSPI_STEP_TRANSFER:
+                status = qspi_command_transfer(obj, &step->command, step->tx_data, step->tx_size, step->rx_data, step->rx_size);
+                break;
+            case QSPI_STEP_WRITE:
+                length = step->tx_size;
+                status = qspi_write(obj, &step->command, step->tx_data, &length);
+                break;
+            case QSPI_STEP_READ:
+                length = step->rx_size;
+                status = qspi_read(obj, &step->command, step->rx_data, &length);
+                break;
+            case QSPI_STEP_POLL:
+                status = sequence_poll(obj, step);
+                break;
+            default:
+                status = QSPI_STATUS_INVALID_PARAMETER;
+                break;
+        }
+    }
+    return status;
+}
+
+MBED_WEAK qspi_status_t qspi_command_sequence_async(qspi_t *obj, const qspi_step_t *steps, size_t count, qspi_async_handler handler, uint32_t id)
+{
+    qspi_status_t status = qspi_command_sequence(obj, steps, count);
+    if (status == QSPI_STATUS_OK) {
+        handler(id, status);
+    }
+    return status;
+}
+
+MBED_WEAK bool qspi_async_active(qspi_t *obj)
+{
+    (void)obj;
+    return false;
+}
+
+MBED_WEAK void qspi_abort_async(qspi_t *obj)
+{
+    (void)obj;
+}
+
+void qspi_read_cache_init(qspi_read_cache_t *cache, qspi_t *obj, const qspi_command_t *read_cmd)
+{
+    memset(cache, 0, sizeof(*cache));
+    cache->qspi = obj;
+    cache->read_cmd = *read_cmd;
+}
+
+static qspi_read_cache_line_t *read_cache_line(qspi_read_cache_t *cache, uint32_t line_address, qspi_status_t *status)
+{
+    qspi_read_cache_line_t *victim = &cache->lines[0];
+
+    *status = QSPI_STATUS_OK;
+    cache->use_count++;
+    for (size_t i = 0; i < MBED_CONF_TARGET_QSPI_READ_CACHE_LINES; i++) {
+        qspi_read_cache_line_t *line = &cache->lines[i];
+        if (line->valid && line->address == line_address) {
+            line->last_use = cache->use_count;
+            return line;
+        }
+        // Invalid lines first, then the least recently used one
+        if (victim->valid && (!line->valid || (cache->use_count - line->last_use > cache->use_count - victim->last_use))) {
+            victim = line;
+        }
+    }
+
+    size_t length = MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE;
+    victim->valid = false;
+    cache->read_cmd.address.value = line_address;
+    *status = qspi_read(cache->qspi, &cache->read_cmd, victim->data, &length);
+    if (*status != QSPI_STATUS_OK) {
+        return NULL;
+    }
+    if (length != MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE) {
+        *status = QSPI_STATUS_ERROR;
+        return NULL;
+    }
+    victim->address = line_address;
+    victim->last_use = cache->use_count;
+    victim->valid = true;
+    return victim;
+}
+
+qspi_status_t qspi_read_cache_read(qspi_read_cache_t *cache, uint32_t address, void *data, size_t length)
+{
+    uint8_t *out = (uint8_t *)data;
+    qspi_status_t status = QSPI_STATUS_OK;
+
+    if (length > MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE) {
+        cache->read_cmd.address.value = address;
+        return qspi_read(cache->qspi, &cache->read_cmd, data, &length);
+    }
+
+    while (length > 0) {
+        const uint32_t offset = address % MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE;
+        size_t chunk = MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE - offset;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        const qspi_read_cache_line_t *line = read_cache_line(cache, address - offset, &status);
+        if (line == NULL) {
+            return status;
+        }
+        memcpy(out, &line->data[offset], chunk);
+
+        out += chunk;
+        address += chunk;
+        length -= chunk;
+    }
+    return status;
+}
+
+void qspi_read_cache_invalidate(qspi_read_cache_t *cache, uint32_t address, size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+    for (size_t i = 0; i < MBED_CONF_TARGET_QSPI_READ_CACHE_LINES; i++) {
+        qspi_read_cache_line_t *line = &cache->lines[i];
+        // The line overlaps [address, address + length)
+        if (line->valid && (line->address - address < length ||
+                            address - line->address < MBED_CONF_TARGET_QSPI_READ_CACHE_LINE_SIZE)) {
+            line->valid = false;
+        }
+    }
+}
+
+qspi_status_t qspi_read_cache_write(qspi_read_cache_t *cache, const qspi_command_t *command, const void *data, size_t *length)
+{
+    const size_t requested = *length;
+    const qspi_status_t status = qspi_write(cache->qspi, command, data, length);
+
+    // Part of the data may have been written on error
+    qspi_read_cache_invalidate(cache, command->address.value, requested);
+    return status;
+}
+
+qspi_status_t qspi_read_cache_erase(qspi_read_cache_t *cache, const qspi_command_t *command, size_t size)
+{
+    const qspi_status_t status = qspi_command_transfer(cache->qspi, command, NULL, 0, NULL, 0);
+
+    qspi_read_cache_invalidate(cache, command->address.value, size);
+    return status;
+}
+
+#endif // DEVICE_QSPI
@@ -0,0 +1,273 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/qspi_sfdp_api.h"
+
+#if DEVICE_QSPI
+
+#include <string.h>
+
+#define SFDP_CMD_READ           0x5A
+#define SFDP_READ_DUMMY_CYCLES  8
+#define SFDP_HEADER_SIZE        8
+#define SFDP_BFPT_ID            0xFF00
+
+/* DWORDs of the Basic Flash Parameter Table read, up to the Quad Enable requirements */
+#define BFPT_MIN_DWORDS         9
+#define BFPT_MAX_DWORDS         16
+
+#define CMD_READ                0x03
+#define CMD_WREN                0x06
+#define CMD_RDSR1               0x05
+#define CMD_WRSR1               0x01
+#define CMD_RDSR2               0x35
+#define CMD_WRSR2               0x31
+#define CMD_RDSR2_BIT7          0x3F
+#define CMD_WRSR2_BIT7          0x3E
+#define SR1_WIP                 0x01
+
+static uint32_t bfpt_dword(const uint8_t *bfpt, int n)
+{
+    const uint8_t *p = &bfpt[(n - 1) * 4];
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void single_command(qspi_command_t *cmd, uint8_t instruction)
+{
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->instruction.bus_width = QSPI_CFG_BUS_SINGLE;
+    cmd->instruction.value = instruction;
+    cmd->address.disabled = true;
+    cmd->alt.disabled = true;
+    cmd->data.bus_width = QSPI_CFG_BUS_SINGLE;
+}
+
+/* Fast read modes, from the fastest: bit of DWORD 1 declaring the mode, then
+ * DWORD and shift of its instruction, wait states and mode clocks.
+ */
+static const struct {
+    uint8_t support_bit;
+    uint8_t dword;
+    uint8_t shift;
+    qspi_bus_width_t address_width;
+    qspi_bus_width_t data_width;
+} read_modes[] = {
+    { 21, 3, 0,  QSPI_CFG_BUS_QUAD,   QSPI_CFG_BUS_QUAD },   // 1-4-4
+    { 22, 3, 16, QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_QUAD },   // 1-1-4
+    { 20, 4, 16, QSPI_CFG_BUS_DUAL,   QSPI_CFG_BUS_DUAL },   // 1-2-2
+    { 16, 4, 0,  QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_DUAL },   // 1-1-2
+};
+
+static uint8_t bus_lines(qspi_bus_width_t width)
+{
+    return width == QSPI_CFG_BUS_QUAD ? 4 : (width == QSPI_CFG_BUS_DUAL ? 2 : 1);
+}
+
+qspi_status_t qspi_sfdp_parse_bfpt(const uint8_t *bfpt, size_t length, qspi_sfdp_params_t *params)
+{
+    const size_t dwords = length / 4;
+
+    if (dwords < BFPT_MIN_DWORDS) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(params, 0, sizeof(*params));
+
+    const uint32_t dw1 = bfpt_dword(bfpt, 1);
+    const uint32_t dw2 = bfpt_dword(bfpt, 2);
+    const uint32_t density = dw2 & 0x7FFFFFFFUL;
+    // Density in bits, either the size minus one or a power of two
+    params->size = (dw2 & 0x80000000UL) ? ((density >= 3 && density < 67) ? (1ULL << (density - 3)) : 0) : ((uint64_t)density + 1) / 8;
+    params->dtr = (dw1 >> 19) & 1;
+    params->read_444 = (bfpt_dword(bfpt, 5) >> 4) & 1;
+
+    qspi_command_t *cmd = &params->read_cmd;
+    single_command(cmd, CMD_READ);
+    cmd->address.disabled = false;
+    cmd->address.bus_width = QSPI_CFG_BUS_SINGLE;
+    cmd->address.size = (((dw1 >> 17) & 0x3) == 0x2) ? QSPI_CFG_ADDR_SIZE_32 : QSPI_CFG_ADDR_SIZE_24;
+
+    for (size_t i = 0; i < sizeof(read_modes) / sizeof(read_modes[0]); i++) {
+        if (!((dw1 >> read_modes[i].support_bit) & 1)) {
+            continue;
+        }
+        const uint32_t mode = bfpt_dword(bfpt, read_modes[i].dword) >> read_modes[i].shift;
+        const uint8_t mode_clocks = (mode >> 5) & 0x7;
+
+        cmd->instruction.value = (mode >> 8) & 0xFF;
+        cmd->address.bus_width = read_modes[i].address_width;
+        cmd->data.bus_width = read_modes[i].data_width;
+        cmd->dummy_count = mode & 0x1F;
+        // Mode bits all set, which no flash takes as entering continuous read mode
+        if (mode_clocks) {
+            cmd->alt.disabled = false;
+            cmd->alt.bus_width = read_modes[i].data_width;
+            cmd->alt.size = mode_clocks * bus_lines(read_modes[i].data_width);
+            cmd->alt.value = (1UL << cmd->alt.size) - 1;
+        }
+        break;
+    }
+
+    for (int i = 0; i < QSPI_SFDP_ERASE_TYPES; i++) {
+        const uint32_t erase = bfpt_dword(bfpt, 8 + i / 2) >> ((i % 2) * 16);
+        const uint8_t size = erase & 0xFF;
+        if (size > 0 && size < 32) {
+            params->erase[i].size = 1UL << size;
+            params->erase[i].instruction = (erase >> 8) & 0xFF;
+        }
+    }
+
+    params->page_size = (dwords >= 11) ? (1UL << ((bfpt_dword(bfpt, 11) >> 4) & 0xF)) : 256;
+    params->quad_enable = (dwords >= 15) ? ((bfpt_dword(bfpt, 15) >> 20) & 0x7) : 0;
+
+    return QSPI_STATUS_OK;
+}
+
+static qspi_status_t sfdp_read(qspi_t *obj, uint32_t address, void *data, size_t size)
+{
+    qspi_command_t cmd;
+
+    single_command(&cmd, SFDP_CMD_READ);
+    cmd.address.disabled = false;
+    cmd.address.bus_width = QSPI_CFG_BUS_SINGLE;
+    cmd.address.size = QSPI_CFG_ADDR_SIZE_24;
+    cmd.address.value = address;
+    cmd.dummy_count = SFDP_READ_DUMMY_CYCLES;
+
+    return qspi_command_transfer(obj, &cmd, NULL, 0, data, size);
+}
+
+qspi_status_t qspi_sfdp_read_params(qspi_t *obj, qspi_sfdp_params_t *params)
+{
+    uint8_t header[SFDP_HEADER_SIZE];
+    uint8_t bfpt[BFPT_MAX_DWORDS * 4];
+
+    if (sfdp_read(obj, 0, header, sizeof(header)) != QSPI_STATUS_OK ||
+            memcmp(header, "SFDP", 4) != 0) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    // The Basic Flash Parameter Table is the first parameter table
+    if (sfdp_read(obj, SFDP_HEADER_SIZE, header, sizeof(header)) != QSPI_STATUS_OK ||
+            (header[0] | (header[7] << 8)) != SFDP_BFPT_ID) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    size_t length = (size_t)header[3] * 4;
+    if (length > sizeof(bfpt)) {
+        length = sizeof(bfpt);
+    }
+    const uint32_t table = header[4] | ((uint32_t)header[5] << 8) | ((uint32_t)header[6] << 16);
+    if (sfdp_read(obj, table, bfpt, length) != QSPI_STATUS_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    return qspi_sfdp_parse_bfpt(bfpt, length, params) == QSPI_STATUS_OK ? QSPI_STATUS_OK : QSPI_STATUS_ERROR;
+}
+
+static qspi_status_t read_register(qspi_t *obj, uint8_t instruction, uint8_t *value)
+{
+    qspi_command_t cmd;
+
+    single_command(&cmd, instruction);
+    return qspi_command_transfer(obj, &cmd, NULL, 0, value, 1);
+}
+
+/* Write enable, write the status register, then wait for the write to complete */
+static qspi_status_t write_register(qspi_t *obj, uint8_t instruction, const uint8_t *value, size_t size)
+{
+    qspi_step_t steps[3];
+
+    memset(steps, 0, sizeof(steps));
+    steps[0].type = QSPI_STEP_TRANSFER;
+    single_command(&steps[0].command, CMD_WREN);
+    steps[1].type = QSPI_STEP_TRANSFER;
+    single_command(&steps[1].command, instruction);
+    steps[1].tx_data = value;
+    steps[1].tx_size = size;
+    steps[2].type = QSPI_STEP_POLL;
+    single_command(&steps[2].command, CMD_RDSR1);
+    steps[2].poll_mask = SR1_WIP;
+    steps[2].poll_match = 0;
+
+    return qspi_command_sequence(obj, steps, 3);
+}
+
+qspi_status_t qspi_sfdp_enable_quad(qspi_t *obj, const qspi_sfdp_params_t *params)
+{
+    uint8_t sr[2] = { 0, 0 };
+    qspi_status_t status = QSPI_STATUS_OK;
+
+    if (params->read_cmd.data.bus_width != QSPI_CFG_BUS_QUAD) {
+        return QSPI_STATUS_OK;
+    }
+
+    switch (params->quad_enable) {
+        case 0:
+            break;
+        case 1:
+        case 4:
+            // Bit 1 of status register 2, which cannot be read back
+            status = read_register(obj, CMD_RDSR1, &sr[0]);
+            sr[1] = 0x02;
+            if (status == QSPI_STATUS_OK) {
+                status = write_register(obj, CMD_WRSR1, sr, 2);
+            }
+            break;
+        case 2:
+            // Bit 6 of status register 1
+            status = read_register(obj, CMD_RDSR1, &sr[0]);
+            if (status == QSPI_STATUS_OK && !(sr[0] & 0x40)) {
+                sr[0] |= 0x40;
+                status = write_register(obj, CMD_WRSR1, sr, 1);
+            }
+            break;
+        case 3:
+            // Bit 7 of status register 2, with its own instructions
+            status = read_register(obj, CMD_RDSR2_BIT7, &sr[1]);
+            if (status == QSPI_STATUS_OK && !(sr[1] & 0x80)) {
+                sr[1] |= 0x80;
+                status = write_register(obj, CMD_WRSR2_BIT7, &sr[1], 1);
+            }
+            break;
+        case 5:
+            // Bit 1 of status register 2, written along with status register 1
+            status = read_register(obj, CMD_RDSR1, &sr[0]);
+            if (status == QSPI_STATUS_OK) {
+                status = read_register(obj, CMD_RDSR2, &sr[1]);
+            }
+            if (status == QSPI_STATUS_OK && !(sr[1] & 0x02)) {
+                sr[1] |= 0x02;
+                status = write_register(obj, CMD_WRSR1, sr, 2);
+            }
+            break;
+        case 6:
+            // Bit 1 of status register 2, written on its own
+            status = read_register(obj, CMD_RDSR2, &sr[1]);
+            if (status == QSPI_STATUS_OK && !(sr[1] & 0x02)) {
+                sr[1] |= 0x02;
+                status = write_register(obj, CMD_WRSR2, &sr[1], 1);
+            }
+            break;
+        default:
+            status = QSPI_STATUS_ERROR;
+            break;
+    }
+
+    return status == QSPI_STATUS_OK ? QSPI_STATUS_OK : QSPI_STATUS_ERROR;
+}
+
+#endif // DEVICE_QSPI
@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/rtc_api.h"
+#include "mbed_toolchain.h"
+
+#if DEVICE_RTC
+
+MBED_WEAK uint32_t rtc_subsecond_frequency(void)
+{
+    return 1;
+}
+
+MBED_WEAK uint32_t rtc_read_subseconds(time_t *seconds)
+{
+    *seconds = rtc_read();
+    return 0;
+}
+
+MBED_WEAK int rtc_set_alarm(time_t seconds, uint32_t subseconds, rtc_alarm_handler handler)
+{
+    (void)seconds;
+    (void)subseconds;
+    (void)handler;
+    return -1;
+}
+
+MBED_WEAK void rtc_cancel_alarm(void)
+{
+}
+
+#endif // DEVICE_RTC
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/secure_gateway_api.h"
+
+#include "bootstrap/mbed_toolchain.h"
+#include "hal/flash_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/trng_api.h"
+#include "hal/us_ticker_api.h"
+
+static int32_t execute(const hal_secure_gateway_objects_t *objects, hal_secure_op_t *op)
+{
+    switch (op->type) {
+#if DEVICE_USTICKER
+        case HAL_SECURE_OP_US_TICKER_READ:
+            op->value = us_ticker_read();
+            return 0;
+#endif
+#if DEVICE_LPTICKER
+        case HAL_SECURE_OP_LP_TICKER_READ:
+            op->value = lp_ticker_read();
+            return 0;
+#endif
+#if DEVICE_TRNG
+        case HAL_SECURE_OP_TRNG: {
+            size_t length = 0;
+            trng_t *trng = (trng_t *)(objects->trng ? objects->trng : op->obj);
+            const int result = trng_get_bytes(trng, (uint8_t *)op->data, op->size, &length);
+            op->value = (uint32_t)length;
+            return result;
+        }
+#endif
+#if DEVICE_FLASH
+        case HAL_SECURE_OP_FLASH_PROGRAM:
+            return flash_program((flash_t *)(objects->flash ? objects->flash : op->obj), op->address,
+                                 (const uint8_t *)op->data, op->size);
+        case HAL_SECURE_OP_FLASH_ERASE:
+            return flash_erase_sector((flash_t *)(objects->flash ? objects->flash : op->obj), op->address);
+#endif
+        default:
+            return -1;
+    }
+}
+
+uint32_t hal_secure_gateway_execute(const hal_secure_gateway_objects_t *objects, hal_secure_op_t *ops, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        ops[i].result = execute(objects, &ops[i]);
+        if (ops[i].result != 0) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#if DOMAIN_NS
+/* Without a gateway in the secure image, each operation is its own secure call. */
+MBED_WEAK uint32_t hal_secure_gateway(hal_secure_op_t *ops, uint32_t count)
+{
+    static const hal_secure_gateway_objects_t objects = { NULL, NULL };
+
+    return hal_secure_gateway_execute(&objects, ops, count);
+}
+
+MBED_WEAK const volatile uint32_t *hal_secure_us_ticker_shadow(void)
+{
+    return NULL;
+}
+#endif // DOMAIN_NS
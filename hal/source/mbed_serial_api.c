@@ -0,0 +1,334 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/serial_api.h"
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_wait_api.h"
+#include "hal/tracepoint_api.h"
+#include "mbed_toolchain.h"
+
+#include <string.h>
+
+#if DEVICE_SERIAL
+
+static void serial_tx_fifo_irq(uint32_t id, SerialIrq event)
+{
+    serial_tx_fifo_t *fifo = (serial_tx_fifo_t *)id;
+
+    if (event != TxIrq) {
+        if (fifo->rx_handler != NULL) {
+            fifo->rx_handler(fifo->rx_id, event);
+        }
+        return;
+    }
+
+    core_util_critical_section_enter();
+    while (fifo->count != 0 && serial_writable(fifo->serial)) {
+        size_t tail = (fifo->head + MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE - fifo->count) % MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE;
+        serial_putc(fifo->serial, fifo->buffer[tail]);
+        fifo->count--;
+    }
+    if (fifo->count == 0) {
+        serial_irq_set(fifo->serial, TxIrq, 0);
+        HAL_TRACEPOINT(HAL_TRACEPOINT_SERIAL_TX_COMPLETE, fifo->serial, 0);
+    }
+    core_util_critical_section_exit();
+}
+
+void serial_tx_fifo_init(serial_tx_fifo_t *fifo, serial_t *obj, uart_irq_handler rx_handler, uint32_t rx_id)
+{
+    fifo->serial = obj;
+    fifo->head = 0;
+    fifo->count = 0;
+    fifo->high_water = 0;
+    fifo->rx_handler = rx_handler;
+    fifo->rx_id = rx_id;
+
+    serial_irq_handler(obj, serial_tx_fifo_irq, (uint32_t)fifo);
+}
+
+size_t serial_tx_fifo_write(serial_tx_fifo_t *fifo, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    core_util_critical_section_enter();
+    size_t space = MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE - fifo->count;
+    if (length > space) {
+        length = space;
+    }
+    size_t written = 0;
+    while (written < length) {
+        size_t part = MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE - fifo->head;
+        if (part > length - written) {
+            part = length - written;
+        }
+        memcpy(&fifo->buffer[fifo->head], &bytes[written], part);
+        fifo->head = (fifo->head + part) % MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE;
+        written += part;
+    }
+    fifo->count += length;
+    if (fifo->count > fifo->high_water) {
+        fifo->high_water = fifo->count;
+    }
+    if (length != 0) {
+        if (fifo->count == length) {
+            // The FIFO was empty, a new transmission starts
+            HAL_TRACEPOINT(HAL_TRACEPOINT_SERIAL_TX_START, fifo->serial, length);
+        }
+        serial_irq_set(fifo->serial, TxIrq, 1);
+    }
+    core_util_critical_section_exit();
+
+    return length;
+}
+
+size_t serial_tx_fifo_count(serial_tx_fifo_t *fifo)
+{
+    core_util_critical_section_enter();
+    size_t count = fifo->count;
+    core_util_critical_section_exit();
+    return count;
+}
+
+size_t serial_tx_fifo_high_water(serial_tx_fifo_t *fifo)
+{
+    core_util_critical_section_enter();
+    size_t high_water = fifo->high_water;
+    core_util_critical_section_exit();
+    return high_water;
+}
+
+void serial_tx_fifo_flush(serial_tx_fifo_t *fifo)
+{
+    while (serial_tx_fifo_count(fifo) != 0) {
+        // The TX IRQ drains the FIFO.
+    }
+}
+
+void serial_tx_fifo_free(serial_tx_fifo_t *fifo)
+{
+    core_util_critical_section_enter();
+    serial_irq_set(fifo->serial, TxIrq, 0);
+    fifo->count = 0;
+    core_util_critical_section_exit();
+}
+
+// Longest character: start bit, 9 data bits, parity and 2 stop bits
+#define SERIAL_MAX_FRAME_BITS 13
+
+void serial_rs485_sw_init(serial_rs485_sw_t *sw, serial_t *obj, PinName de, int baudrate, const serial_rs485_config_t *config)
+{
+    serial_capabilities_t cap;
+    serial_get_capabilities(obj, &cap);
+
+    const uint32_t bit_ns = 1000000000UL / (uint32_t)baudrate;
+
+    sw->serial = obj;
+    sw->de_active = config->de_active_high ? 1 : 0;
+    sw->assert_ns = bit_ns * config->assert_time / 16;
+    sw->deassert_ns = bit_ns * config->deassert_time / 16;
+    sw->char_ns = bit_ns * SERIAL_MAX_FRAME_BITS;
+    // The bytes in the FIFO and the one in the shift register
+    sw->fifo_chars = cap.tx_fifo_size + 1;
+
+    gpio_init_out_ex(&sw->de, de, !sw->de_active);
+}
+
+void serial_rs485_sw_write(serial_rs485_sw_t *sw, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    gpio_write(&sw->de, sw->de_active);
+    wait_ns(sw->assert_ns);
+
+    for (size_t i = 0; i < length; i++) {
+        serial_putc(sw->serial, bytes[i]);
+    }
+
+    // Wait for the bytes still in the hardware to be sent
+    const size_t pending = length < sw->fifo_chars ? length : sw->fifo_chars;
+    wait_us((int)(((uint64_t)pending * sw->char_ns + 999) / 1000));
+    wait_ns(sw->deassert_ns);
+    gpio_write(&sw->de, !sw->de_active);
+}
+
+void serial_rs485_sw_free(serial_rs485_sw_t *sw)
+{
+    gpio_write(&sw->de, !sw->de_active);
+    gpio_free(&sw->de);
+}
+
+MBED_WEAK void serial_get_capabilities(serial_t *obj, serial_capabilities_t *cap)
+{
+    (void)obj;
+
+    cap->rx_fifo_size = 1;
+    cap->tx_fifo_size = 1;
+    cap->rx_timeout = false;
+    cap->rx_timeout_max = 0;
+    cap->baud_max = 0;
+    cap->oversampling = SERIAL_OVERSAMPLING_16;
+    cap->divisor_frac_bits = 0;
+}
+
+MBED_WEAK int serial_baud_exact(serial_t *obj, int baudrate, int32_t *error_ppm)
+{
+    (void)obj;
+    (void)baudrate;
+    (void)error_ppm;
+
+    return -1;
+}
+
+uint32_t serial_baud_divisor(uint32_t clock_hz, uint32_t baudrate, uint32_t oversampling, uint32_t frac_bits, uint32_t *achieved)
+{
+    const uint64_t clock = (uint64_t)clock_hz << frac_bits;
+    const uint64_t samples = (uint64_t)oversampling * baudrate;
+
+    // Rounded to the nearest, no lower than a divisor of one
+    uint64_t divisor = (clock + samples / 2) / samples;
+    if (divisor < (1ULL << frac_bits)) {
+        divisor = 1ULL << frac_bits;
+    }
+    if (divisor > UINT32_MAX) {
+        divisor = UINT32_MAX;
+    }
+
+    if (achieved != NULL) {
+        const uint64_t divided = divisor * oversampling;
+        *achieved = (uint32_t)((clock + divided / 2) / divided);
+    }
+
+    return (uint32_t)divisor;
+}
+
+MBED_WEAK size_t serial_rx_threshold_set(serial_t *obj, size_t level)
+{
+    (void)obj;
+    (void)level;
+
+    return 1;
+}
+
+MBED_WEAK size_t serial_tx_threshold_set(serial_t *obj, size_t level)
+{
+    (void)obj;
+    (void)level;
+
+    return 1;
+}
+
+MBED_WEAK int serial_rx_timeout_set(serial_t *obj, uint32_t char_times)
+{
+    (void)obj;
+
+    return char_times == 0 ? 0 : -1;
+}
+
+#if DEVICE_CLOCK_SCALING
+
+static void serial_clock_changed(uint32_t id, hal_clock_event_t event)
+{
+    serial_clock_follower_t *follower = (serial_clock_follower_t *)id;
+
+    if (event == HAL_CLOCK_POST_CHANGE) {
+        serial_baud(follower->serial, follower->baudrate);
+    }
+}
+
+void serial_clock_follower_init(serial_clock_follower_t *follower, serial_t *obj, int baudrate)
+{
+    hal_clock_notifier_remove(&follower->notifier);
+    follower->serial = obj;
+    follower->baudrate = baudrate;
+    serial_baud(obj, baudrate);
+    hal_clock_notifier_add(&follower->notifier, serial_clock_changed, (uint32_t)follower);
+}
+
+void serial_clock_follower_free(serial_clock_follower_t *follower)
+{
+    hal_clock_notifier_remove(&follower->notifier);
+}
+
+#endif // DEVICE_CLOCK_SCALING
+
+#endif // DEVICE_SERIAL
+
+#if DEVICE_SERIAL_ASYNCH
+
+static void serial_rx_stream_irq(uint32_t id, SerialIrq event)
+{
+    serial_t *obj = (serial_t *)id;
+    serial_rx_stream_t *stream = &obj->rx_stream;
+    int events = SERIAL_EVENT_RX_IDLE;
+
+    if (event != RxIrq || stream->buffer == NULL) {
+        return;
+    }
+
+    while (serial_readable(obj)) {
+        stream->buffer[stream->head] = (uint8_t)serial_getc(obj);
+        stream->head++;
+        if (stream->head == stream->size) {
+            stream->head = 0;
+            events |= SERIAL_EVENT_RX_COMPLETE;
+        } else if (stream->head == stream->size / 2) {
+            events |= SERIAL_EVENT_RX_COMPLETE;
+        }
+    }
+
+    if (events & SERIAL_EVENT_RX_COMPLETE) {
+        HAL_TRACEPOINT(HAL_TRACEPOINT_SERIAL_RX_COMPLETE, obj, events);
+    }
+    stream->handler(stream->id, stream->head, events);
+}
+
+MBED_WEAK int serial_rx_stream_start(serial_t *obj, void *ring, size_t size, serial_rx_stream_handler handler, uint32_t id)
+{
+    if (serial_rx_active(obj)) {
+        return -1;
+    }
+
+    obj->rx_stream.buffer = (uint8_t *)ring;
+    obj->rx_stream.size = size;
+    obj->rx_stream.head = 0;
+    obj->rx_stream.handler = handler;
+    obj->rx_stream.id = id;
+
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SERIAL_RX_START, obj, size);
+    serial_irq_handler(obj, serial_rx_stream_irq, (uint32_t)obj);
+    serial_irq_set(obj, RxIrq, 1);
+    return 0;
+}
+
+MBED_WEAK size_t serial_rx_stream_head(serial_t *obj)
+{
+    core_util_critical_section_enter();
+    size_t head = obj->rx_stream.head;
+    core_util_critical_section_exit();
+    return head;
+}
+
+MBED_WEAK void serial_rx_stream_stop(serial_t *obj)
+{
+    serial_irq_set(obj, RxIrq, 0);
+
+    core_util_critical_section_enter();
+    obj->rx_stream.buffer = NULL;
+    core_util_critical_section_exit();
+}
+
+#endif // DEVICE_SERIAL_ASYNCH
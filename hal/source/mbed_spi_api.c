@@ -0,0 +1,430 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/spi_api.h"
+#include "hal/gpio_api.h"
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/tracepoint_api.h"
+#include "mbed_toolchain.h"
+
+#include <stdbool.h>
+
+#if DEVICE_SPI
+
+/* Skip the exhausted segments, return the number of bytes left in the first one */
+static size_t spi_iov_trim(const spi_iov_t **iov, size_t *count, size_t *pos)
+{
+    while (*count != 0 && *pos >= (*iov)->length) {
+        (*iov)++;
+        (*count)--;
+        *pos = 0;
+    }
+    return *count != 0 ? (*iov)->length - *pos : 0;
+}
+
+/* Length of the next part which is contiguous in both tx and rx */
+static size_t spi_iov_part_length(size_t tx_left, size_t rx_left)
+{
+    if (tx_left == 0) {
+        return rx_left;
+    }
+    if (rx_left == 0) {
+        return tx_left;
+    }
+    return tx_left < rx_left ? tx_left : rx_left;
+}
+
+MBED_WEAK void spi_prepare_config(spi_t *obj, spi_device_config_t *config, int bits, int mode, int slave, int hz)
+{
+    (void)obj;
+
+    config->bits = bits;
+    config->mode = mode;
+    config->slave = slave;
+    config->hz = hz;
+}
+
+MBED_WEAK void spi_apply_config(spi_t *obj, const spi_device_config_t *config)
+{
+    spi_format(obj, config->bits, config->mode, config->slave);
+    spi_frequency(obj, config->hz);
+}
+
+MBED_WEAK int spi_cs_config(spi_t *obj, const spi_cs_config_t *config)
+{
+    (void)obj;
+    (void)config;
+
+    return -1;
+}
+
+MBED_WEAK int spi_master_block_write_w(spi_t *obj, const void *tx, void *rx, size_t count, uint8_t bit_width)
+{
+    MBED_ASSERT(bit_width == 8 || bit_width == 16 || bit_width == 32);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t value = 0xFFFFFFFF;
+
+        if (tx) {
+            switch (bit_width) {
+                case 8:
+                    value = ((const uint8_t *)tx)[i];
+                    break;
+                case 16:
+                    value = ((const uint16_t *)tx)[i];
+                    break;
+                default:
+                    value = ((const uint32_t *)tx)[i];
+                    break;
+            }
+        }
+
+        value = (uint32_t)spi_master_write(obj, (int)value);
+
+        if (rx) {
+            switch (bit_width) {
+                case 8:
+                    ((uint8_t *)rx)[i] = (uint8_t)value;
+                    break;
+                case 16:
+                    ((uint16_t *)rx)[i] = (uint16_t)value;
+                    break;
+                default:
+                    ((uint32_t *)rx)[i] = value;
+                    break;
+            }
+        }
+    }
+
+    return (int)count;
+}
+
+MBED_WEAK int spi_master_transfer_iov(spi_t *obj, const spi_iov_t *tx, size_t ntx, spi_iov_t *rx, size_t nrx)
+{
+    const spi_iov_t *rx_iov = rx;
+    size_t tx_pos = 0;
+    size_t rx_pos = 0;
+    int total = 0;
+
+    while (true) {
+        size_t tx_left = spi_iov_trim(&tx, &ntx, &tx_pos);
+        size_t rx_left = spi_iov_trim(&rx_iov, &nrx, &rx_pos);
+        size_t length = spi_iov_part_length(tx_left, rx_left);
+
+        if (length == 0) {
+            break;
+        }
+
+        spi_master_block_write(obj,
+                               tx_left ? (const char *)tx->buffer + tx_pos : NULL, tx_left ? (int)length : 0,
+                               rx_left ? (char *)rx_iov->buffer + rx_pos : NULL, rx_left ? (int)length : 0,
+                               SPI_FILL_CHAR);
+
+        tx_pos += tx_left ? length : 0;
+        rx_pos += rx_left ? length : 0;
+        total += (int)length;
+    }
+
+    return total;
+}
+
+#if DEVICE_SPI_ASYNCH
+
+/* Start the next part of the transfer, returns false if there is nothing left */
+static bool spi_iov_start_part(spi_t *obj)
+{
+    spi_iov_state_t *iov = &obj->iov;
+    size_t tx_left = spi_iov_trim(&iov->tx, &iov->tx_count, &iov->tx_pos);
+    size_t rx_left = spi_iov_trim(&iov->rx, &iov->rx_count, &iov->rx_pos);
+
+    iov->length = spi_iov_part_length(tx_left, rx_left);
+    if (iov->length == 0) {
+        return false;
+    }
+
+    spi_master_transfer(obj,
+                        tx_left ? (const char *)iov->tx->buffer + iov->tx_pos : NULL, tx_left ? iov->length : 0,
+                        rx_left ? (char *)iov->rx->buffer + iov->rx_pos : NULL, rx_left ? iov->length : 0,
+                        iov->bit_width, iov->handler, iov->event);
+    return true;
+}
+
+MBED_WEAK void spi_master_transfer_iov_asynch(spi_t *obj, const spi_iov_t *tx, size_t ntx, spi_iov_t *rx, size_t nrx, uint8_t bit_width, uint32_t handler, uint32_t event)
+{
+    spi_iov_state_t *iov = &obj->iov;
+
+    iov->tx = tx;
+    iov->tx_count = ntx;
+    iov->tx_pos = 0;
+    iov->rx = rx;
+    iov->rx_count = nrx;
+    iov->rx_pos = 0;
+    iov->bit_width = bit_width;
+    iov->handler = handler;
+    iov->event = event;
+
+    if (!spi_iov_start_part(obj)) {
+        // Nothing to transfer, still complete the transfer through the handler
+        spi_master_transfer(obj, NULL, 0, NULL, 0, bit_width, handler, event);
+    }
+}
+
+MBED_WEAK uint32_t spi_irq_handler_asynch_iov(spi_t *obj)
+{
+    spi_iov_state_t *iov = &obj->iov;
+    uint32_t events = spi_irq_handler_asynch(obj);
+
+    if ((events & SPI_EVENT_INTERNAL_TRANSFER_COMPLETE) &&
+            !(events & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW))) {
+        iov->tx_pos += iov->tx_count ? iov->length : 0;
+        iov->rx_pos += iov->rx_count ? iov->length : 0;
+        if (spi_iov_start_part(obj)) {
+            // The transfer continues, report the events of the whole transfer at the end
+            return 0;
+        }
+    }
+
+    return events;
+}
+
+/* Configure the bus for the transaction and start it */
+static void spi_queue_start(spi_t *obj, spi_transaction_t *transaction)
+{
+    spi_queue_state_t *queue = &obj->queue;
+
+    if (transaction->bits != queue->bits || transaction->mode != queue->mode) {
+        spi_format(obj, transaction->bits, transaction->mode, 0);
+        queue->bits = transaction->bits;
+        queue->mode = transaction->mode;
+    }
+    if (transaction->hz != queue->hz) {
+        spi_frequency(obj, transaction->hz);
+        queue->hz = transaction->hz;
+    }
+    if (transaction->cs) {
+        gpio_write(transaction->cs, 0);
+    }
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SPI_START, obj, (transaction->tx_length << 16) | (transaction->rx_length & 0xFFFF));
+    spi_master_transfer(obj, transaction->tx, transaction->tx_length, transaction->rx, transaction->rx_length,
+                        transaction->bit_width, queue->handler, transaction->event);
+}
+
+MBED_WEAK void spi_master_transaction_queue_init(spi_t *obj)
+{
+    spi_queue_state_t *queue = &obj->queue;
+
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->handler = 0;
+    queue->bits = 0;
+    queue->mode = 0;
+    queue->hz = 0;
+}
+
+MBED_WEAK void spi_master_transaction_submit(spi_t *obj, spi_transaction_t *transactions, size_t count, uint32_t handler)
+{
+    spi_queue_state_t *queue = &obj->queue;
+    bool idle;
+
+    if (count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        transactions[i].next = (i + 1 < count) ? &transactions[i + 1] : NULL;
+    }
+
+    core_util_critical_section_enter();
+    idle = (queue->head == NULL);
+    if (idle) {
+        queue->head = transactions;
+        queue->handler = handler;
+    } else {
+        queue->tail->next = transactions;
+    }
+    queue->tail = &transactions[count - 1];
+    core_util_critical_section_exit();
+
+    if (idle) {
+        spi_queue_start(obj, transactions);
+    }
+}
+
+MBED_WEAK uint32_t spi_irq_handler_asynch_queue(spi_t *obj)
+{
+    spi_queue_state_t *queue = &obj->queue;
+    spi_transaction_t *done = queue->head;
+    spi_transaction_t *next;
+    uint32_t events = spi_irq_handler_asynch(obj);
+
+    if (done == NULL || !(events & SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
+        return 0;
+    }
+    HAL_TRACEPOINT(HAL_TRACEPOINT_SPI_COMPLETE, obj, events);
+    if (done->cs) {
+        gpio_write(done->cs, 1);
+    }
+
+    core_util_critical_section_enter();
+    next = done->next;
+    queue->head = next;
+    if (next == NULL) {
+        queue->tail = NULL;
+    }
+    core_util_critical_section_exit();
+
+    // Keep the bus busy while the callback runs
+    if (next != NULL) {
+        spi_queue_start(obj, next);
+    }
+    if (done->callback) {
+        done->callback(done, events & done->event);
+    }
+
+    return events & done->event;
+}
+
+MBED_WEAK void spi_master_transaction_abort(spi_t *obj)
+{
+    spi_queue_state_t *queue = &obj->queue;
+    spi_transaction_t *current;
+
+    core_util_critical_section_enter();
+    current = queue->head;
+    queue->head = NULL;
+    queue->tail = NULL;
+    core_util_critical_section_exit();
+
+    if (current != NULL) {
+        spi_abort_asynch(obj);
+        if (current->cs) {
+            gpio_write(current->cs, 1);
+        }
+    }
+}
+
+/* Start the transfer of the half of the buffers after the head */
+static void spi_stream_start_half(spi_t *obj)
+{
+    spi_slave_stream_t *stream = &obj->stream;
+    const size_t half = stream->size / 2;
+
+    spi_master_transfer(obj,
+                        stream->tx ? stream->tx + stream->head : NULL, stream->tx ? half : 0,
+                        stream->rx ? stream->rx + stream->head : NULL, stream->rx ? half : 0,
+                        stream->bit_width, stream->handler, SPI_EVENT_ALL);
+}
+
+MBED_WEAK int spi_slave_stream_start(spi_t *obj, const void *tx, void *rx, size_t size, uint8_t bit_width, uint32_t handler,
+                                     spi_slave_stream_handler callback, uint32_t id)
+{
+    const size_t word_size = (bit_width + 7) / 8;
+    spi_slave_stream_t *stream = &obj->stream;
+
+    if (spi_active(obj) || size == 0 || size % (2 * word_size) != 0) {
+        return -1;
+    }
+
+    stream->tx = (const uint8_t *)tx;
+    stream->rx = (uint8_t *)rx;
+    stream->head = 0;
+    stream->bit_width = bit_width;
+    stream->handler = handler;
+    stream->callback = callback;
+    stream->id = id;
+    stream->size = size;
+
+    spi_stream_start_half(obj);
+    return 0;
+}
+
+MBED_WEAK uint32_t spi_irq_handler_asynch_stream(spi_t *obj)
+{
+    spi_slave_stream_t *stream = &obj->stream;
+    uint32_t events = spi_irq_handler_asynch(obj);
+
+    if (stream->size == 0 || !(events & SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
+        return 0;
+    }
+
+    if (events & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW)) {
+        stream->size = 0;
+        stream->callback(stream->id, stream->head, events & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW));
+        return events & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW);
+    }
+
+    stream->head += stream->size / 2;
+    if (stream->head == stream->size) {
+        stream->head = 0;
+    }
+
+    // Keep the next half ready for the master while the handler runs
+    spi_stream_start_half(obj);
+    stream->callback(stream->id, stream->head, SPI_EVENT_COMPLETE);
+
+    return 0;
+}
+
+MBED_WEAK size_t spi_slave_stream_head(spi_t *obj)
+{
+    core_util_critical_section_enter();
+    size_t head = obj->stream.head;
+    core_util_critical_section_exit();
+    return head;
+}
+
+MBED_WEAK void spi_slave_stream_stop(spi_t *obj)
+{
+    core_util_critical_section_enter();
+    const bool active = obj->stream.size != 0;
+    obj->stream.size = 0;
+    core_util_critical_section_exit();
+
+    if (active) {
+        spi_abort_asynch(obj);
+    }
+}
+
+#endif // DEVICE_SPI_ASYNCH
+
+#if DEVICE_CLOCK_SCALING
+
+static void spi_clock_changed(uint32_t id, hal_clock_event_t event)
+{
+    spi_clock_follower_t *follower = (spi_clock_follower_t *)id;
+
+    if (event == HAL_CLOCK_POST_CHANGE) {
+        spi_frequency(follower->spi, follower->hz);
+    }
+}
+
+void spi_clock_follower_init(spi_clock_follower_t *follower, spi_t *obj, int hz)
+{
+    hal_clock_notifier_remove(&follower->notifier);
+    follower->spi = obj;
+    follower->hz = hz;
+    spi_frequency(obj, hz);
+    hal_clock_notifier_add(&follower->notifier, spi_clock_changed, (uint32_t)follower);
+}
+
+void spi_clock_follower_free(spi_clock_follower_t *follower)
+{
+    hal_clock_notifier_remove(&follower->notifier);
+}
+
+#endif // DEVICE_CLOCK_SCALING
+
+#endif // DEVICE_SPI
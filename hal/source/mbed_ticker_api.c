@@ -16,10 +16,15 @@
 
 #include <stdio.h>
 #include <stddef.h>
+#include <string.h>
 #include "hal/ticker_api.h"
+#include "bootstrap/mbed_atomic.h"
 #include "bootstrap/mbed_critical.h"
 #include "bootstrap/mbed_assert.h"
 #include "bootstrap/mbed_error.h"
+#include "bootstrap/mbed_toolchain.h"
+#include "hal/tracepoint_api.h"
+#include "hal/utils/critical_section_api.h"
 
 #if !MBED_CONF_TARGET_CUSTOM_TICKERS
 #include "us_ticker_api.h"
@@ -44,6 +49,45 @@
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
 
+#if MBED_CONF_TARGET_TICKER_STATS
+MBED_FORCEINLINE static void stats_inserted(ticker_event_queue_t *queue, uint32_t count)
+{
+    ticker_stats_t *stats = &queue->stats;
+
+    stats->inserts += count;
+    stats->depth += count;
+    if (stats->depth > stats->max_depth) {
+        stats->max_depth = stats->depth;
+    }
+}
+
+MBED_FORCEINLINE static void stats_dispatched(ticker_event_queue_t *queue, const ticker_event_t *obj, bool popped)
+{
+    ticker_stats_t *stats = &queue->stats;
+    const us_timestamp_t lateness = queue->present_time - obj->timestamp;
+
+    stats->dispatches++;
+    if (popped) {
+        stats->depth--;
+    }
+    if (lateness > stats->max_lateness_us) {
+        stats->max_lateness_us = lateness > UINT32_MAX ? UINT32_MAX : (uint32_t)lateness;
+    }
+}
+
+#define TICKER_STATS_INSERTED(queue, count) stats_inserted((queue), (count))
+#define TICKER_STATS_REMOVED(queue) ((queue)->stats.removes++, (queue)->stats.depth--)
+#define TICKER_STATS_DISPATCHED(queue, obj, popped) stats_dispatched((queue), (obj), (popped))
+#define TICKER_STATS_SCHEDULED(queue) ((queue)->stats.interrupts_scheduled++)
+#define TICKER_STATS_INTERRUPT(queue) ((queue)->stats.interrupts++)
+#else
+#define TICKER_STATS_INSERTED(queue, count) ((void)(count))
+#define TICKER_STATS_REMOVED(queue)
+#define TICKER_STATS_DISPATCHED(queue, obj, popped)
+#define TICKER_STATS_SCHEDULED(queue)
+#define TICKER_STATS_INTERRUPT(queue)
+#endif // MBED_CONF_TARGET_TICKER_STATS
+
 /* Macros that either look up the info from mbed_ticker_queue_t, or give a constant.
  * Some constants are defined during the definition of initialize, to keep the
  * compile-time and run-time calculations alongside each other.
@@ -53,17 +97,21 @@ static void update_present_time(const ticker_data_t *const ticker);
 // don't bother doing computing shift - rely on the compiler being able convert "/ 2^k" to ">> k",
 // except that it's useful to note shift 0 for numerator 1, as that's special-cased
 #define TICKER_PERIOD_NUM_SHIFTS(queue) (MBED_TICKER_CONSTANT_PERIOD_NUM == 1 ? 0 : -1)
+#define TICKER_PERIOD_NUM_RECIPROCAL(queue) (UINT64_MAX / MBED_TICKER_CONSTANT_PERIOD_NUM)
 #else
 #define TICKER_PERIOD_NUM(queue) ((queue)->period_num)
 #define TICKER_PERIOD_NUM_SHIFTS(queue) ((queue)->period_num_shifts)
+#define TICKER_PERIOD_NUM_RECIPROCAL(queue) ((queue)->period_num_reciprocal)
 #endif
 
 #ifdef MBED_TICKER_CONSTANT_PERIOD_DEN
 #define TICKER_PERIOD_DEN(queue) MBED_TICKER_CONSTANT_PERIOD_DEN
 #define TICKER_PERIOD_DEN_SHIFTS(queue) (MBED_TICKER_CONSTANT_PERIOD_DEN == 1 ? 0 : -1)
+#define TICKER_PERIOD_DEN_RECIPROCAL(queue) (UINT64_MAX / MBED_TICKER_CONSTANT_PERIOD_DEN)
 #else
 #define TICKER_PERIOD_DEN(queue) ((queue)->period_den)
 #define TICKER_PERIOD_DEN_SHIFTS(queue) ((queue)->period_den_shifts)
+#define TICKER_PERIOD_DEN_RECIPROCAL(queue) ((queue)->period_den_reciprocal)
 #endif
 
 #if MBED_TICKER_CONSTANT_PERIOD_DEN == 1
@@ -97,6 +145,47 @@ static void update_present_time(const ticker_data_t *const ticker);
 #define TICKER_MAX_DELTA_US(queue) ((queue)->max_delta_us)
 #endif
 
+/* When the us and lp tickers both have compile-time info, but it differs so it
+ * can't be shared through the MBED_TICKER_CONSTANT_xxx macros above, the time
+ * conversions are compiled once for each ticker with its own constants.
+ * `runs_in_deep_sleep` tells which ticker it is, as in update_timing().
+ */
+#if !MBED_CONF_TARGET_CUSTOM_TICKERS && DEVICE_USTICKER && DEVICE_LPTICKER && \
+    defined US_TICKER_PERIOD_NUM && defined US_TICKER_PERIOD_DEN && defined US_TICKER_MASK && \
+    defined LP_TICKER_PERIOD_NUM && defined LP_TICKER_PERIOD_DEN && defined LP_TICKER_MASK && \
+    !(defined MBED_TICKER_CONSTANT_PERIOD && defined MBED_TICKER_CONSTANT_MASK)
+#define TICKER_CONSTANTS_PER_TICKER 1
+#else
+#define TICKER_CONSTANTS_PER_TICKER 0
+#endif
+
+/* The period ratio and limits passed to the conversions */
+#define TICKER_TIMING_PARAMETERS \
+    uint32_t period_num, int period_num_shifts, uint64_t period_num_reciprocal, \
+    uint32_t period_den, int period_den_shifts, uint64_t period_den_reciprocal, \
+    uint32_t bitmask, uint32_t max_delta, uint64_t max_delta_us
+
+#define TICKER_QUEUE_TIMING(queue) \
+    TICKER_PERIOD_NUM(queue), TICKER_PERIOD_NUM_SHIFTS(queue), TICKER_PERIOD_NUM_RECIPROCAL(queue), \
+    TICKER_PERIOD_DEN(queue), TICKER_PERIOD_DEN_SHIFTS(queue), TICKER_PERIOD_DEN_RECIPROCAL(queue), \
+    TICKER_BITMASK(queue), TICKER_MAX_DELTA(queue), TICKER_MAX_DELTA_US(queue)
+
+#if TICKER_CONSTANTS_PER_TICKER
+#define TICKER_CONSTANT_TIMING(num, den, mask) \
+    (num), ((num) == 1 ? 0 : -1), (UINT64_MAX / (num)), \
+    (den), ((den) == 1 ? 0 : -1), (UINT64_MAX / (den)), \
+    (mask), 7 * (((mask) >> 4) + 1), \
+    (((uint64_t)7 * (((mask) >> 4) + 1) * (num) + (den) - 1) / (den))
+
+#define TICKER_TIMING_CALL(ticker, function, ...) \
+    (!(ticker)->interface->runs_in_deep_sleep ? \
+     function(__VA_ARGS__, TICKER_CONSTANT_TIMING(US_TICKER_PERIOD_NUM, US_TICKER_PERIOD_DEN, US_TICKER_MASK)) : \
+     function(__VA_ARGS__, TICKER_CONSTANT_TIMING(LP_TICKER_PERIOD_NUM, LP_TICKER_PERIOD_DEN, LP_TICKER_MASK)))
+#else
+#define TICKER_TIMING_CALL(ticker, function, ...) \
+    function(__VA_ARGS__, TICKER_QUEUE_TIMING((ticker)->queue))
+#endif
+
 #if COMPUTE_RATIO_FROM_FREQUENCY
 static inline uint32_t gcd(uint32_t a, uint32_t b)
 {
@@ -120,21 +209,45 @@ static int exact_log2(uint32_t n)
 #endif
 
 /*
- * Initialize a ticker instance.
+ * High 64 bits of the 128-bit product of a and b.
  */
-static void initialize(const ticker_data_t *ticker)
+MBED_FORCEINLINE static uint64_t multiply_high(uint64_t a, uint64_t b)
 {
-    // return if the queue has already been initialized, in that case the
-    // interface used by the queue is already initialized.
-    if (ticker->queue->initialized) {
-        return;
-    }
-    if (ticker->queue->suspended) {
-        return;
-    }
+    const uint64_t a_lo = (uint32_t)a;
+    const uint64_t a_hi = a >> 32;
+    const uint64_t b_lo = (uint32_t)b;
+    const uint64_t b_hi = b >> 32;
+
+    const uint64_t lo_lo = a_lo * b_lo;
+    const uint64_t hi_lo = a_hi * b_lo;
+    const uint64_t lo_hi = a_lo * b_hi;
+    // Can't overflow, each term is at most (2^32 - 1)^2
+    const uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+}
 
-    ticker->interface->init();
+/*
+ * Divide n by d, with reciprocal = UINT64_MAX / d, without a 64-bit division
+ * which is a library call on Cortex-M.
+ *
+ * For d not a power of 2, reciprocal is floor(2^64 / d), so the estimate
+ * n * reciprocal / 2^64 is at most 1 below the quotient.
+ */
+MBED_FORCEINLINE static uint64_t divide_by_reciprocal(uint64_t n, uint32_t d, uint64_t reciprocal)
+{
+    uint64_t quotient = multiply_high(n, reciprocal);
+    if (n - quotient * d >= d) {
+        quotient++;
+    }
+    return quotient;
+}
 
+/*
+ * Derive the conversion ratios and limits of a ticker from its info.
+ */
+static void update_timing(const ticker_data_t *ticker)
+{
 #if MBED_TRAP_ERRORS_ENABLED || COMPUTE_RATIO_FROM_FREQUENCY || !defined MBED_TICKER_CONSTANT_MASK
     const ticker_info_t *info = ticker->interface->get_info();
 #endif
@@ -181,8 +294,10 @@ static void initialize(const ticker_data_t *ticker)
     const uint32_t period_gcd = gcd(frequency, 1000000);
     ticker->queue->period_num = 1000000 / period_gcd;
     ticker->queue->period_num_shifts = exact_log2(ticker->queue->period_num);
+    ticker->queue->period_num_reciprocal = UINT64_MAX / ticker->queue->period_num;
     ticker->queue->period_den = frequency / period_gcd;
     ticker->queue->period_den_shifts = exact_log2(ticker->queue->period_den);
+    ticker->queue->period_den_reciprocal = UINT64_MAX / ticker->queue->period_den;
 #elif !defined MBED_TICKER_CONSTANT_PERIOD
     // Have ratio defines, but need to figure out which one applies.
     // `runs_in_deep_sleep` is a viable proxy. (We have asserts above that
@@ -190,9 +305,13 @@ static void initialize(const ticker_data_t *ticker)
     const bool is_usticker = !DEVICE_LPTICKER || !ticker->interface->runs_in_deep_sleep;
 #ifndef MBED_TICKER_CONSTANT_PERIOD_NUM
     ticker->queue->period_num = is_usticker ? US_TICKER_PERIOD_NUM : LP_TICKER_PERIOD_NUM;
+    ticker->queue->period_num_reciprocal = is_usticker ? UINT64_MAX / US_TICKER_PERIOD_NUM : UINT64_MAX / LP_TICKER_PERIOD_NUM;
+    ticker->queue->period_num_shifts = ticker->queue->period_num == 1 ? 0 : -1;
 #endif
 #ifndef MBED_TICKER_CONSTANT_PERIOD_DEN
     ticker->queue->period_den = is_usticker ? US_TICKER_PERIOD_DEN : LP_TICKER_PERIOD_DEN;
+    ticker->queue->period_den_reciprocal = is_usticker ? UINT64_MAX / US_TICKER_PERIOD_DEN : UINT64_MAX / LP_TICKER_PERIOD_DEN;
+    ticker->queue->period_den_shifts = ticker->queue->period_den == 1 ? 0 : -1;
 #endif
 #endif // COMPUTE_RATIO_FROM_FREQUENCY / MBED_TICKER_CONSTANT_PERIOD
 
@@ -224,6 +343,24 @@ static void initialize(const ticker_data_t *ticker)
 #define CONSTANT_MAX_DELTA_US \
         (((uint64_t)CONSTANT_MAX_DELTA * MBED_TICKER_CONSTANT_PERIOD_NUM + MBED_TICKER_CONSTANT_PERIOD_DEN - 1) / MBED_TICKER_CONSTANT_PERIOD_DEN)
 #endif
+}
+
+/*
+ * Initialize a ticker instance.
+ */
+static void initialize(const ticker_data_t *ticker)
+{
+    // return if the queue has already been initialized, in that case the
+    // interface used by the queue is already initialized.
+    if (ticker->queue->initialized) {
+        return;
+    }
+    if (ticker->queue->suspended) {
+        return;
+    }
+
+    ticker->interface->init();
+    update_timing(ticker);
 
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
@@ -232,6 +369,9 @@ static void initialize(const ticker_data_t *ticker)
     ticker->queue->present_time = 0;
     ticker->queue->dispatching = false;
     ticker->queue->suspended = false;
+#if MBED_CONF_TARGET_TICKER_STATS
+    memset(&ticker->queue->stats, 0, sizeof(ticker->queue->stats));
+#endif
     ticker->queue->initialized = true;
 
     update_present_time(ticker);
@@ -278,109 +418,333 @@ static us_timestamp_t convert_timestamp(us_timestamp_t ref, timestamp_t timestam
 }
 
 /**
- * Update the present timestamp value of a ticker.
+ * Compute the time elapsed since the last tick read, and the tick remainder
+ * once it is added to the present time. The queue is not modified so the time
+ * can be read without updating it.
  */
-static void update_present_time(const ticker_data_t *const ticker)
+MBED_FORCEINLINE static uint64_t compute_elapsed_us(const ticker_event_queue_t *queue, uint32_t ticker_time, uint32_t *remainder, TICKER_TIMING_PARAMETERS)
 {
-    ticker_event_queue_t *queue = ticker->queue;
-    if (queue->suspended) {
-        return;
-    }
-    uint32_t ticker_time = ticker->interface->read();
-    if (ticker_time == queue->tick_last_read) {
-        // No work to do
-        return;
-    }
+    (void)max_delta;
+    (void)max_delta_us;
 
-    uint32_t elapsed_ticks = (ticker_time - queue->tick_last_read) & TICKER_BITMASK(queue);
-    queue->tick_last_read = ticker_time;
+    uint32_t elapsed_ticks = (ticker_time - queue->tick_last_read) & bitmask;
+    *remainder = TICKER_TICK_REMAINDER(queue);
 
     // Convert elapsed_ticks to elapsed_us as (elapsed_ticks * period_num / period_den)
     // adding in any remainder from the last division
     uint64_t scaled_ticks;
-    if (SLOW_MULTIPLY && TICKER_PERIOD_NUM_SHIFTS(queue) >= 0) {
-        scaled_ticks = (uint64_t) elapsed_ticks << TICKER_PERIOD_NUM_SHIFTS(queue);
+    if (SLOW_MULTIPLY && period_num_shifts >= 0) {
+        scaled_ticks = (uint64_t) elapsed_ticks << period_num_shifts;
     } else {
-        scaled_ticks = (uint64_t) elapsed_ticks * TICKER_PERIOD_NUM(queue);
+        scaled_ticks = (uint64_t) elapsed_ticks * period_num;
     }
     uint64_t elapsed_us;
-    if (TICKER_PERIOD_DEN_SHIFTS(queue) == 0) {
+    if (period_den_shifts == 0) {
         // Optimized for cases that don't need division
         elapsed_us = scaled_ticks;
     } else {
         scaled_ticks += TICKER_TICK_REMAINDER(queue);
-        if (TICKER_PERIOD_DEN_SHIFTS(queue) >= 0) {
+        if (period_den_shifts >= 0) {
             // Speed-optimised for shifts
-            elapsed_us = scaled_ticks >> TICKER_PERIOD_DEN_SHIFTS(queue);
-            TICKER_SET_TICK_REMAINDER(queue, scaled_ticks - (elapsed_us << TICKER_PERIOD_DEN_SHIFTS(queue)));
+            elapsed_us = scaled_ticks >> period_den_shifts;
+            *remainder = scaled_ticks - (elapsed_us << period_den_shifts);
         } else {
-            // General case division
-            elapsed_us = scaled_ticks / TICKER_PERIOD_DEN(queue);
-            TICKER_SET_TICK_REMAINDER(queue, scaled_ticks - elapsed_us * TICKER_PERIOD_DEN(queue));
+            // General case, divide with the reciprocal
+            elapsed_us = divide_by_reciprocal(scaled_ticks, period_den, period_den_reciprocal);
+            *remainder = scaled_ticks - elapsed_us * period_den;
         }
     }
 
-    // Update current time
+    return elapsed_us;
+}
+
+/*
+ * Sequence lock of the present time, for ticker_read_us(). All the writers are
+ * in critical sections, the sequence is odd while they update it.
+ */
+MBED_FORCEINLINE static void present_time_write_begin(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->sequence, queue->sequence + 1);
+}
+
+MBED_FORCEINLINE static void present_time_write_end(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->sequence, queue->sequence + 1);
+}
+
+/**
+ * Update the present timestamp value of a ticker.
+ */
+MBED_RAMFUNC static void update_present_time(const ticker_data_t *const ticker)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+    if (queue->suspended) {
+        return;
+    }
+    uint32_t ticker_time = ticker->interface->read();
+    if (ticker_time == queue->tick_last_read) {
+        // No work to do
+        return;
+    }
+
+    uint32_t remainder;
+    const uint64_t elapsed_us = TICKER_TIMING_CALL(ticker, compute_elapsed_us, queue, ticker_time, &remainder);
+
+    // Update current time, readers outside of critical sections retry if they
+    // see the sequence change
+    present_time_write_begin(queue);
+    queue->tick_last_read = ticker_time;
+    TICKER_SET_TICK_REMAINDER(queue, remainder);
     queue->present_time += elapsed_us;
+    present_time_write_end(queue);
 }
 
 /**
  * Given the absolute timestamp compute the hal tick timestamp rounded up.
  */
-static timestamp_t compute_tick_round_up(const ticker_data_t *const ticker, us_timestamp_t timestamp)
+MBED_FORCEINLINE static timestamp_t compute_tick_round_up_with(ticker_event_queue_t *queue, us_timestamp_t timestamp, TICKER_TIMING_PARAMETERS)
 {
-    ticker_event_queue_t *queue = ticker->queue;
     us_timestamp_t delta_us = timestamp - queue->present_time;
 
-    timestamp_t delta = TICKER_MAX_DELTA(queue);
-    if (delta_us <= TICKER_MAX_DELTA_US(queue)) {
+    timestamp_t delta = max_delta;
+    if (delta_us <= max_delta_us) {
         // Checking max_delta_us ensures the operation will not overflow
 
         // Convert delta_us to delta (ticks) as (delta_us * period_den / period_num)
         // taking care to round up if num != 1
         uint64_t scaled_delta;
-        if (SLOW_MULTIPLY && TICKER_PERIOD_DEN_SHIFTS(queue) >= 0) {
+        if (SLOW_MULTIPLY && period_den_shifts >= 0) {
             // Optimized denominators divisible by 2
-            scaled_delta = delta_us << TICKER_PERIOD_DEN_SHIFTS(queue);
+            scaled_delta = delta_us << period_den_shifts;
         } else {
             // General case
-            scaled_delta = delta_us * TICKER_PERIOD_DEN(queue);
+            scaled_delta = delta_us * period_den;
         }
-        if (TICKER_PERIOD_NUM_SHIFTS(queue) == 0) {
+        if (period_num_shifts == 0) {
             delta = scaled_delta;
         } else {
-            scaled_delta += TICKER_PERIOD_NUM(queue) - 1;
-            if (TICKER_PERIOD_NUM_SHIFTS(queue) >= 0) {
+            scaled_delta += period_num - 1;
+            if (period_num_shifts >= 0) {
                 // Optimized numerators divisible by 2
-                delta = scaled_delta >> TICKER_PERIOD_NUM_SHIFTS(queue);
+                delta = scaled_delta >> period_num_shifts;
             } else {
-                // General case
-                delta = scaled_delta / TICKER_PERIOD_NUM(queue);
+                // General case, divide with the reciprocal
+                delta = divide_by_reciprocal(scaled_delta, period_num, period_num_reciprocal);
             }
         }
-        if (delta > TICKER_MAX_DELTA(queue)) {
-            delta = TICKER_MAX_DELTA(queue);
+        if (delta > max_delta) {
+            delta = max_delta;
         }
     }
-    return (queue->tick_last_read + delta) & TICKER_BITMASK(queue);
+    return (queue->tick_last_read + delta) & bitmask;
 }
 
-//NOTE: Must be called from critical section!
-static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id)
+MBED_RAMFUNC static timestamp_t compute_tick_round_up(const ticker_data_t *const ticker, us_timestamp_t timestamp)
 {
-    ticker_event_queue_t *queue = ticker->queue;
+    return TICKER_TIMING_CALL(ticker, compute_tick_round_up_with, ticker->queue, timestamp);
+}
 
-    // initialise our data
-    obj->timestamp = timestamp;
-    obj->id = id;
+#if MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+/*
+ * Pairing heap backend.
+ *
+ * The root of the heap is queue->head. Each node links to its first child
+ * through `child`, to its next sibling through `next` and to its parent (if it
+ * is the first child) or its previous sibling through `prev`. The root of a
+ * heap, as well as any event outside of a heap, has `prev` and `next` set to
+ * NULL.
+ */
+
+/*
+ * Meld two heaps and return the root of the resulting heap.
+ *
+ * On equal timestamps, a remains the root.
+ */
+MBED_RAMFUNC static ticker_event_t *heap_meld(ticker_event_t *a, ticker_event_t *b)
+{
+    if (b->timestamp < a->timestamp) {
+        ticker_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // b becomes the first child of a
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/*
+ * Meld a list of sibling heaps into a single heap using the two-pass
+ * scheme: meld siblings by pairs from left to right, then meld the
+ * resulting heaps together from right to left.
+ */
+MBED_RAMFUNC static ticker_event_t *heap_merge_pairs(ticker_event_t *first)
+{
+    ticker_event_t *pairs = NULL;
+
+    // First pass, the melded pairs are pushed on a stack linked through next
+    while (first != NULL) {
+        ticker_event_t *a = first;
+        ticker_event_t *b = a->next;
+        first = (b != NULL) ? b->next : NULL;
+
+        a->prev = NULL;
+        a->next = NULL;
+        if (b != NULL) {
+            b->prev = NULL;
+            b->next = NULL;
+            a = heap_meld(a, b);
+        }
+
+        a->next = pairs;
+        pairs = a;
+    }
+
+    if (pairs == NULL) {
+        return NULL;
+    }
+
+    // Second pass, the stack holds the rightmost pair first
+    ticker_event_t *root = pairs;
+    pairs = pairs->next;
+    root->next = NULL;
+    while (pairs != NULL) {
+        ticker_event_t *p = pairs;
+        pairs = pairs->next;
+        p->next = NULL;
+        root = heap_meld(p, root);
+    }
+
+    return root;
+}
+
+/*
+ * Add an event to the queue.
+ */
+MBED_RAMFUNC static void queue_link(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    obj->next = NULL;
+    obj->prev = NULL;
+    obj->child = NULL;
+
+    queue->head = (queue->head != NULL) ? heap_meld(queue->head, obj) : obj;
+}
+
+/*
+ * Take the earliest event out of the queue.
+ */
+MBED_RAMFUNC static void queue_pop_head(ticker_event_queue_t *queue)
+{
+    ticker_event_t *head = queue->head;
+
+    queue->head = heap_merge_pairs(head->child);
+    head->child = NULL;
+}
+
+/*
+ * Move the head of the queue to a later timestamp.
+ */
+MBED_RAMFUNC static void queue_rearm_head(ticker_event_queue_t *queue, us_timestamp_t timestamp)
+{
+    ticker_event_t *head = queue->head;
+
+    // A head without children stays in place, otherwise its children are
+    // merged into the new head before it is linked again at its new timestamp
+    if (head->child != NULL) {
+        queue_pop_head(queue);
+        head->timestamp = timestamp;
+        queue_link(queue, head);
+    } else {
+        head->timestamp = timestamp;
+    }
+}
+
+/*
+ * Take an event out of the queue. Return true if the head of the queue
+ * has been modified.
+ *
+ * Events that are not in the queue are ignored.
+ */
+static bool queue_unlink(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    if (queue->head == obj) {
+        queue_pop_head(queue);
+        TICKER_STATS_REMOVED(queue);
+        return true;
+    }
 
+    if (obj->prev == NULL) {
+        // Not in a heap
+        return false;
+    }
+    TICKER_STATS_REMOVED(queue);
+
+    // Detach the subtree rooted at obj from its parent or sibling
+    if (obj->prev->child == obj) {
+        obj->prev->child = obj->next;
+    } else {
+        obj->prev->next = obj->next;
+    }
+    if (obj->next != NULL) {
+        obj->next->prev = obj->prev;
+    }
+    obj->prev = NULL;
+    obj->next = NULL;
+
+    // The children of obj cannot be earlier than the head
+    ticker_event_t *children = heap_merge_pairs(obj->child);
+    obj->child = NULL;
+    if (children != NULL) {
+        queue->head = heap_meld(queue->head, children);
+    }
+
+    return false;
+}
+
+/*
+ * Prepare a chain of events, linked through next, to be added to the queue.
+ *
+ * The heap does not need the chain to be sorted.
+ */
+static ticker_event_t *queue_prepare_chain(ticker_event_t *chain)
+{
+    return chain;
+}
+
+/*
+ * Add a chain of events prepared by queue_prepare_chain() to the queue.
+ */
+static void queue_link_chain(ticker_event_queue_t *queue, ticker_event_t *chain)
+{
+    while (chain != NULL) {
+        ticker_event_t *next = chain->next;
+        queue_link(queue, chain);
+        chain = next;
+    }
+}
+#else
+/*
+ * Sorted linked list backend.
+ */
+
+/*
+ * Add an event to the queue.
+ */
+MBED_RAMFUNC static void queue_link(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
     /* Go through the list until we either reach the end, or find
        an element this should come before (which is possibly the
        head). */
     ticker_event_t *prev = NULL, *p = queue->head;
     while (p != NULL) {
         /* check if we come before p */
-        if (timestamp < p->timestamp) {
+        if (obj->timestamp < p->timestamp) {
             break;
         }
         /* go to the next element */
@@ -397,16 +761,300 @@ static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
     } else {
         prev->next = obj;
     }
+}
+
+/*
+ * Take the earliest event out of the queue.
+ */
+MBED_RAMFUNC static void queue_pop_head(ticker_event_queue_t *queue)
+{
+    queue->head = queue->head->next;
+}
+
+/*
+ * Move the head of the queue to a later timestamp.
+ */
+MBED_RAMFUNC static void queue_rearm_head(ticker_event_queue_t *queue, us_timestamp_t timestamp)
+{
+    ticker_event_t *head = queue->head;
+
+    head->timestamp = timestamp;
+
+    // The head stays in place while it is still the earliest event
+    if (head->next != NULL && head->next->timestamp <= timestamp) {
+        queue_pop_head(queue);
+        queue_link(queue, head);
+    }
+}
+
+/*
+ * Take an event out of the queue. Return true if the head of the queue
+ * has been modified.
+ *
+ * Events that are not in the queue are ignored.
+ */
+static bool queue_unlink(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    // remove this object from the list
+    if (queue->head == obj) {
+        // first in the list, so just drop me
+        queue_pop_head(queue);
+        TICKER_STATS_REMOVED(queue);
+        return true;
+    }
+
+    // find the object before me, then drop me
+    ticker_event_t *p = queue->head;
+    while (p != NULL) {
+        if (p->next == obj) {
+            p->next = obj->next;
+            TICKER_STATS_REMOVED(queue);
+            break;
+        }
+        p = p->next;
+    }
+
+    return false;
+}
+/*
+ * Merge two lists sorted by timestamp. On equal timestamps, the events of a
+ * come first.
+ */
+static ticker_event_t *merge_sorted(ticker_event_t *a, ticker_event_t *b)
+{
+    ticker_event_t *head = NULL;
+    ticker_event_t **tail = &head;
+
+    while (a != NULL && b != NULL) {
+        if (b->timestamp < a->timestamp) {
+            *tail = b;
+            b = b->next;
+        } else {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (a != NULL) ? a : b;
 
-    if (prev == NULL || timestamp <= queue->present_time) {
+    return head;
+}
+
+/*
+ * Prepare a chain of events, linked through next, to be added to the queue.
+ *
+ * The chain is merge sorted so it can be merged into the queue in one pass.
+ * The sort is stable: events with the same timestamp keep their order.
+ */
+static ticker_event_t *queue_prepare_chain(ticker_event_t *chain)
+{
+    if (chain == NULL || chain->next == NULL) {
+        return chain;
+    }
+
+    // Split the chain in two halves
+    ticker_event_t *slow = chain, *fast = chain->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    ticker_event_t *second = slow->next;
+    slow->next = NULL;
+
+    return merge_sorted(queue_prepare_chain(chain), queue_prepare_chain(second));
+}
+
+/*
+ * Add a chain of events prepared by queue_prepare_chain() to the queue.
+ *
+ * The events already in the queue come first on equal timestamps, as if the
+ * events of the chain had been inserted one by one.
+ */
+static void queue_link_chain(ticker_event_queue_t *queue, ticker_event_t *chain)
+{
+    queue->head = merge_sorted(queue->head, chain);
+}
+#endif // MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+
+#if MBED_CONF_TARGET_TICKER_EVENT_SLACK
+// Maximum number of events examined when coalescing, this bounds the time
+// spent computing the interrupt time in critical section.
+#define TICKER_COALESCE_MAX_EVENTS 8
+
+#define TICKER_SET_EVENT_SLACK(obj, value) ((obj)->slack = (value))
+#define TICKER_MATCH_TIME(queue) ((queue)->match_time)
+#define TICKER_SET_MATCH_TIME(queue, time) ((queue)->match_time = (time))
+
+/*
+ * Return the latest time an event can be dispatched at.
+ */
+MBED_RAMFUNC static us_timestamp_t event_deadline(const ticker_event_t *obj)
+{
+    if (obj->timestamp > UINT64_MAX - obj->slack) {
+        return UINT64_MAX;
+    }
+    return obj->timestamp + obj->slack;
+}
+
+#if MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+/*
+ * Lower limit to the deadline of the events of the heaps in the sibling list
+ * which are due before limit. Return false if more than budget events would
+ * have to be examined.
+ */
+MBED_RAMFUNC static bool heap_coalesce(const ticker_event_t *obj, us_timestamp_t *limit, unsigned *budget)
+{
+    for (; obj != NULL; obj = obj->next) {
+        if (*budget == 0) {
+            return false;
+        }
+        --*budget;
+
+        // The children of obj are not due before obj
+        if (obj->timestamp > *limit) {
+            continue;
+        }
+        const us_timestamp_t deadline = event_deadline(obj);
+        if (deadline < *limit) {
+            *limit = deadline;
+        }
+        if (!heap_coalesce(obj->child, limit, budget)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Compute the time the interrupt should be scheduled at to dispatch the
+ * head of the queue along with as many events as possible.
+ */
+MBED_RAMFUNC static us_timestamp_t queue_match_time(const ticker_event_queue_t *queue)
+{
+    us_timestamp_t limit = event_deadline(queue->head);
+    unsigned budget = TICKER_COALESCE_MAX_EVENTS;
+
+    if (!heap_coalesce(queue->head->child, &limit, &budget)) {
+        // Too many events to consider, don't delay the head
+        return queue->head->timestamp;
+    }
+    return limit;
+}
+#else
+/*
+ * Compute the time the interrupt should be scheduled at to dispatch the
+ * head of the queue along with as many events as possible.
+ */
+MBED_RAMFUNC static us_timestamp_t queue_match_time(const ticker_event_queue_t *queue)
+{
+    const ticker_event_t *obj = queue->head;
+    us_timestamp_t limit = event_deadline(obj);
+    unsigned budget = TICKER_COALESCE_MAX_EVENTS;
+
+    for (obj = obj->next; obj != NULL && obj->timestamp <= limit; obj = obj->next) {
+        if (budget == 0) {
+            // Too many events to consider, stop the window at this one
+            return obj->timestamp;
+        }
+        --budget;
+
+        const us_timestamp_t deadline = event_deadline(obj);
+        if (deadline < limit) {
+            limit = deadline;
+        }
+    }
+    return limit;
+}
+#endif // MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+#else
+#define TICKER_SET_EVENT_SLACK(obj, value) ((void)(value))
+#define TICKER_MATCH_TIME(queue) ((queue)->present_time)
+#define TICKER_SET_MATCH_TIME(queue, time) ((void)(time))
+#define queue_match_time(queue) ((queue)->head->timestamp)
+#endif // MBED_CONF_TARGET_TICKER_EVENT_SLACK
+
+//NOTE: Must be called from critical section!
+static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t period, uint32_t id)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+
+    MBED_ASSERT(hal_critical_section_masks_caller());
+
+    // initialise our data
+    obj->timestamp = timestamp;
+    obj->id = id;
+    obj->period = period;
+    TICKER_SET_EVENT_SLACK(obj, slack);
+    HAL_TRACEPOINT(HAL_TRACEPOINT_TICKER_INSERT, obj, timestamp);
+
+    queue_link(queue, obj);
+    TICKER_STATS_INSERTED(queue, 1);
+
+    // The interrupt must be rescheduled if the event is due before the time
+    // it is currently scheduled for.
+    if (queue->head == obj || timestamp <= TICKER_MATCH_TIME(queue)) {
         schedule_interrupt(ticker);
     }
 }
 
+/*
+ * Set the extra compare channels of the ticker for the events following the
+ * interrupt at match_time. The heap is not sorted past its root, the
+ * channels are only used with the sorted list.
+ */
+MBED_RAMFUNC static void schedule_compare_channels(const ticker_data_t *const ticker, us_timestamp_t match_time, timestamp_t match_tick)
+{
+    const ticker_interface_t *const interface = ticker->interface;
+    uint32_t count = 0;
+    timestamp_t ticks[TICKER_MAX_COMPARE_CHANNELS];
+
+    if (interface->compare_channels == 0) {
+        return;
+    }
+
+#if !MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+    const ticker_event_queue_t *const queue = ticker->queue;
+    const uint32_t channels = interface->compare_channels < TICKER_MAX_COMPARE_CHANNELS ?
+                              interface->compare_channels : TICKER_MAX_COMPARE_CHANNELS;
+    const us_timestamp_t limit = queue->present_time + TICKER_MAX_DELTA_US(queue);
+    timestamp_t previous_tick = match_tick;
+
+    for (const ticker_event_t *obj = queue->head; obj != NULL && count < channels; obj = obj->next) {
+        // The events up to the match time are dispatched by its interrupt
+        if (obj->timestamp <= match_time) {
+            continue;
+        }
+        if (obj->timestamp > limit) {
+            break;
+        }
+        const timestamp_t tick = compute_tick_round_up(ticker, obj->timestamp);
+        if (tick != previous_tick) {
+            ticks[count++] = tick;
+            previous_tick = tick;
+        }
+    }
+#else
+    (void)match_time;
+    (void)match_tick;
+#endif
+
+    interface->set_interrupt_channels(ticks, count);
+}
+
+/*
+ * Disable the extra compare channels of the ticker.
+ */
+MBED_RAMFUNC static void disable_compare_channels(const ticker_data_t *const ticker)
+{
+    if (ticker->interface->compare_channels != 0) {
+        ticker->interface->set_interrupt_channels(NULL, 0);
+    }
+}
+
 /**
  * Return 1 if the tick has incremented to or past match_tick, otherwise 0.
  */
-int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, timestamp_t match_tick)
+MBED_RAMFUNC int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, timestamp_t match_tick)
 {
     if (match_tick > prev_tick) {
         return (cur_tick >= match_tick) || (cur_tick < prev_tick);
@@ -428,7 +1076,7 @@ int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, t
  * in ticker.queue.max_delta. This is necessary to keep track
  * of the timer overflow.
  */
-static void schedule_interrupt(const ticker_data_t *const ticker)
+MBED_RAMFUNC static void schedule_interrupt(const ticker_data_t *const ticker)
 {
     ticker_event_queue_t *queue = ticker->queue;
     if (queue->suspended || queue->dispatching) {
@@ -441,12 +1089,15 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
 
     if (queue->head) {
         us_timestamp_t present = queue->present_time;
-        us_timestamp_t match_time = queue->head->timestamp;
+        us_timestamp_t match_time = queue_match_time(queue);
+        TICKER_SET_MATCH_TIME(queue, match_time);
 
         // if the event at the head of the queue is in the past then schedule
         // it immediately.
         if (match_time <= present) {
+            disable_compare_channels(ticker);
             ticker->interface->fire_interrupt();
+            TICKER_STATS_SCHEDULED(queue);
             return;
         }
 
@@ -457,15 +1108,20 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
         MBED_ASSERT(match_tick != queue->tick_last_read);
 
         ticker->interface->set_interrupt(match_tick);
+        TICKER_STATS_SCHEDULED(queue);
+        schedule_compare_channels(ticker, match_time, match_tick);
         timestamp_t cur_tick = ticker->interface->read();
 
         if (_ticker_match_interval_passed(queue->tick_last_read, cur_tick, match_tick)) {
             ticker->interface->fire_interrupt();
         }
     } else {
+        TICKER_SET_MATCH_TIME(queue, UINT64_MAX);
         uint32_t match_tick =
             (queue->tick_last_read + TICKER_MAX_DELTA(queue)) & TICKER_BITMASK(queue);
         ticker->interface->set_interrupt(match_tick);
+        TICKER_STATS_SCHEDULED(queue);
+        disable_compare_channels(ticker);
     }
 }
 
@@ -478,17 +1134,64 @@ void ticker_set_handler(const ticker_data_t *const ticker, ticker_event_handler
     core_util_critical_section_exit();
 }
 
-void ticker_irq_handler(const ticker_data_t *const ticker)
+MBED_RAMFUNC void ticker_irq_handler(const ticker_data_t *const ticker)
 {
+    // The interrupt of the ticker is set to a priority above the critical
+    // section mask, the queue could change while it is dispatched
+    MBED_ASSERT(hal_critical_section_masks_caller());
     core_util_critical_section_enter();
     ticker_event_queue_t *queue = ticker->queue;
 
     ticker->interface->clear_interrupt();
+    TICKER_STATS_INTERRUPT(queue);
     if (queue->suspended) {
         core_util_critical_section_exit();
         return;
     }
 
+#if MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH
+    if (queue->dispatching) {
+        // Interrupting a dispatch, which reschedules the interrupt once done
+        core_util_critical_section_exit();
+        return;
+    }
+
+    queue->dispatching = true;
+    while (1) {
+        uint32_t ids[MBED_CONF_TARGET_TICKER_DISPATCH_BATCH];
+        size_t count = 0;
+
+        update_present_time(ticker);
+
+        // Take the expired events out of the queue, then run their handlers
+        // with interrupts enabled
+        while (count < MBED_CONF_TARGET_TICKER_DISPATCH_BATCH &&
+                queue->head != NULL && queue->head->timestamp <= queue->present_time) {
+            ticker_event_t *p = queue->head;
+            HAL_TRACEPOINT(HAL_TRACEPOINT_TICKER_DISPATCH, p->id, queue->present_time - p->timestamp);
+            TICKER_STATS_DISPATCHED(queue, p, p->period == 0);
+            if (p->period != 0) {
+                queue_rearm_head(queue, p->timestamp + p->period);
+            } else {
+                queue_pop_head(queue);
+            }
+            if (queue->event_handler != NULL && p->id != TICKER_WAKEUP_ID) {
+                ids[count++] = p->id;
+            }
+        }
+        if (count == 0) {
+            break;
+        }
+
+        const ticker_event_handler handler = queue->event_handler;
+        core_util_critical_section_exit();
+        for (size_t i = 0; i < count; i++) {
+            handler(ids[i]);
+        }
+        core_util_critical_section_enter();
+    }
+    queue->dispatching = false;
+#else
     /* Go through all the pending TimerEvents */
     queue->dispatching = true;
     while (1) {
@@ -503,8 +1206,15 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
-            queue->head = queue->head->next;
-            if (queue->event_handler != NULL) {
+            HAL_TRACEPOINT(HAL_TRACEPOINT_TICKER_DISPATCH, p->id, queue->present_time - p->timestamp);
+            TICKER_STATS_DISPATCHED(queue, p, p->period == 0);
+            if (p->period != 0) {
+                // Periodic events stay in the queue, at their next timestamp
+                queue_rearm_head(queue, p->timestamp + p->period);
+            } else {
+                queue_pop_head(queue);
+            }
+            if (queue->event_handler != NULL && p->id != TICKER_WAKEUP_ID) {
                 (*queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
             /* Note: We continue back to examining the head because calling the
@@ -514,6 +1224,7 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
         }
     }
     queue->dispatching = false;
+#endif
 
     schedule_interrupt(ticker);
 
@@ -532,7 +1243,7 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
                                             timestamp
                                         );
 
-    insert_event(ticker, obj, absolute_timestamp, id);
+    insert_event(ticker, obj, absolute_timestamp, 0, 0, id);
 
     core_util_critical_section_exit();
 }
@@ -544,31 +1255,88 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     // update the current timestamp
     update_present_time(ticker);
 
-    insert_event(ticker, obj, timestamp, id);
+    insert_event(ticker, obj, timestamp, 0, 0, id);
 
     core_util_critical_section_exit();
 }
 
-void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id)
+{
+    core_util_critical_section_enter();
+
+    // update the current timestamp
+    update_present_time(ticker);
+
+    insert_event(ticker, obj, timestamp, slack, 0, id);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_insert_periodic_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, uint32_t period, uint32_t id)
+{
+    MBED_ASSERT(period != 0);
+
+    core_util_critical_section_enter();
+
+    // update the current timestamp
+    update_present_time(ticker);
+
+    insert_event(ticker, obj, ticker->queue->present_time + period, 0, period, id);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_insert_events_us(const ticker_data_t *const ticker, ticker_event_t *const events[], const us_timestamp_t timestamps[], const uint32_t ids[], size_t count)
 {
+    MBED_ASSERT(hal_critical_section_masks_caller());
+    if (count == 0) {
+        return;
+    }
+
+    // Prepare the batch outside of the critical section, the events are
+    // not visible to the queue yet.
+    ticker_event_t *chain = NULL;
+    us_timestamp_t earliest = timestamps[0];
+    for (size_t i = count; i > 0; --i) {
+        ticker_event_t *obj = events[i - 1];
+        obj->timestamp = timestamps[i - 1];
+        obj->id = ids[i - 1];
+        obj->period = 0;
+        TICKER_SET_EVENT_SLACK(obj, 0);
+        HAL_TRACEPOINT(HAL_TRACEPOINT_TICKER_INSERT, obj, obj->timestamp);
+        obj->next = chain;
+        chain = obj;
+        if (obj->timestamp < earliest) {
+            earliest = obj->timestamp;
+        }
+    }
+    chain = queue_prepare_chain(chain);
+
     core_util_critical_section_enter();
+
     ticker_event_queue_t *queue = ticker->queue;
+    ticker_event_t *const previous_head = queue->head;
 
-    // remove this object from the list
-    if (queue->head == obj) {
-        // first in the list, so just drop me
-        queue->head = obj->next;
+    // update the current timestamp
+    update_present_time(ticker);
+
+    queue_link_chain(queue, chain);
+    TICKER_STATS_INSERTED(queue, count);
+
+    if (queue->head != previous_head || earliest <= TICKER_MATCH_TIME(queue)) {
+        schedule_interrupt(ticker);
+    }
+
+    core_util_critical_section_exit();
+}
+
+void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
+{
+    MBED_ASSERT(hal_critical_section_masks_caller());
+    core_util_critical_section_enter();
+
+    if (queue_unlink(ticker->queue, obj)) {
         schedule_interrupt(ticker);
-    } else {
-        // find the object before me, then drop me
-        ticker_event_t *p = queue->head;
-        while (p != NULL) {
-            if (p->next == obj) {
-                p->next = obj->next;
-                break;
-            }
-            p = p->next;
-        }
     }
 
     core_util_critical_section_exit();
@@ -583,8 +1351,35 @@ us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 {
     us_timestamp_t ret;
 
+    // A writer preempted by the caller would never end its update
+    MBED_ASSERT(hal_critical_section_masks_caller());
     initialize(ticker);
 
+    // Compute the time from a consistent snapshot of the present time, without
+    // masking interrupts, unless the ticks read since the last update are
+    // enough for the counter to wrap before the next one.
+    ticker_event_queue_t *queue = ticker->queue;
+    while (true) {
+        const uint32_t sequence = core_util_atomic_load_u32(&queue->sequence);
+        if (sequence & 1) {
+            continue;
+        }
+
+        ret = queue->present_time;
+        if (!queue->suspended) {
+            const uint32_t ticker_time = ticker->interface->read();
+            if (((ticker_time - queue->tick_last_read) & TICKER_BITMASK(queue)) > TICKER_MAX_DELTA(queue)) {
+                break;
+            }
+            uint32_t remainder;
+            ret += TICKER_TIMING_CALL(ticker, compute_elapsed_us, queue, ticker_time, &remainder);
+        }
+
+        if (core_util_atomic_load_u32(&queue->sequence) == sequence) {
+            return ret;
+        }
+    }
+
     core_util_critical_section_enter();
     update_present_time(ticker);
     ret = ticker->queue->present_time;
@@ -623,22 +1418,69 @@ int ticker_get_next_timestamp_us(const ticker_data_t *const data, us_timestamp_t
     return ret;
 }
 
+#if MBED_CONF_TARGET_TICKER_STATS
+void ticker_get_stats(const ticker_data_t *const ticker, ticker_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    *stats = ticker->queue->stats;
+    core_util_critical_section_exit();
+}
+
+void ticker_reset_stats(const ticker_data_t *const ticker)
+{
+    core_util_critical_section_enter();
+    ticker_stats_t *stats = &ticker->queue->stats;
+    const uint32_t depth = stats->depth;
+    memset(stats, 0, sizeof(*stats));
+    stats->depth = depth;
+    stats->max_depth = depth;
+    core_util_critical_section_exit();
+}
+#endif
+
 void ticker_suspend(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    // Reads don't update the present time, it is frozen at the time of the
+    // suspension
+    if (ticker->queue->initialized && !ticker->queue->suspended) {
+        update_present_time(ticker);
+    }
     ticker->queue->suspended = true;
 
     core_util_critical_section_exit();
 }
 
+void ticker_update_timing(const ticker_data_t *const ticker)
+{
+    core_util_critical_section_enter();
+
+    if (ticker->queue->initialized) {
+        present_time_write_begin(ticker->queue);
+        update_timing(ticker);
+        TICKER_SET_TICK_REMAINDER(ticker->queue, 0);
+        present_time_write_end(ticker->queue);
+    }
+
+    core_util_critical_section_exit();
+}
+
 void ticker_resume(const ticker_data_t *const ticker)
+{
+    ticker_resume_compensated(ticker, 0);
+}
+
+void ticker_resume_compensated(const ticker_data_t *const ticker, us_timestamp_t elapsed_us)
 {
     core_util_critical_section_enter();
 
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
+        present_time_write_begin(ticker->queue);
         ticker->queue->tick_last_read = ticker->interface->read();
+        ticker->queue->present_time += elapsed_us;
+        present_time_write_end(ticker->queue);
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
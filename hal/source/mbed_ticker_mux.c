@@ -0,0 +1,199 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/ticker_mux_api.h"
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_critical.h"
+
+static bool any_channel_initialized(const ticker_mux_t *mux)
+{
+    for (uint32_t i = 0; i < mux->count; i++) {
+        if (mux->channels[i].initialized) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Set the interrupt of the channels whose deadline has passed pending, and
+ * return the ticks from now to the earliest deadline of the others, or
+ * UINT32_MAX if none is set. Deadlines are kept relative to the counter value
+ * they were set at, which is always less than a counter wrap in the past as the
+ * common ticker layer sets the interrupt within max_delta ticks.
+ */
+static uint32_t update_channels(ticker_mux_t *mux, timestamp_t now, bool *passed)
+{
+    uint32_t next = UINT32_MAX;
+
+    *passed = false;
+    for (uint32_t i = 0; i < mux->count; i++) {
+        ticker_mux_channel_t *channel = &mux->channels[i];
+        if (!channel->armed) {
+            continue;
+        }
+
+        const uint32_t elapsed = (now - channel->reference) & mux->bitmask;
+        if (elapsed >= channel->delta) {
+            channel->armed = false;
+            channel->pending = true;
+            *passed = true;
+        } else if (channel->delta - elapsed < next) {
+            next = channel->delta - elapsed;
+        }
+    }
+
+    return next;
+}
+
+/*
+ * Set the hardware compare interrupt for the earliest deadline of the
+ * channels, and fire it if a deadline has passed.
+ */
+static void schedule(ticker_mux_t *mux)
+{
+    const ticker_interface_t *const interface = mux->interface;
+    const timestamp_t now = interface->read();
+    bool passed;
+    const uint32_t next = update_channels(mux, now, &passed);
+
+    if (next != UINT32_MAX) {
+        interface->set_interrupt((now + next) & mux->bitmask);
+
+        // The deadline may have been reached while the interrupt was set
+        if (((interface->read() - now) & mux->bitmask) >= next) {
+            passed = true;
+        }
+    } else {
+        interface->disable_interrupt();
+    }
+
+    if (passed) {
+        interface->fire_interrupt();
+    }
+}
+
+void ticker_mux_init(ticker_mux_t *mux, uint32_t channel)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    // Initializing the hardware again could reset the counter the other
+    // channels are using
+    if (!any_channel_initialized(mux)) {
+        mux->interface->init();
+        mux->bitmask = (uint32_t)(((uint64_t)1 << mux->interface->get_info()->bits) - 1);
+    }
+
+    ticker_mux_channel_t *const state = &mux->channels[channel];
+    state->armed = false;
+    state->pending = false;
+    state->initialized = true;
+    schedule(mux);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_free(ticker_mux_t *mux, uint32_t channel)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    ticker_mux_channel_t *const state = &mux->channels[channel];
+    state->armed = false;
+    state->pending = false;
+    state->initialized = false;
+    if (any_channel_initialized(mux)) {
+        schedule(mux);
+    } else {
+        mux->interface->free();
+    }
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_set_interrupt(ticker_mux_t *mux, uint32_t channel, timestamp_t timestamp)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    ticker_mux_channel_t *const state = &mux->channels[channel];
+    state->reference = mux->interface->read();
+    state->delta = (timestamp - state->reference) & mux->bitmask;
+    state->armed = true;
+    schedule(mux);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_disable_interrupt(ticker_mux_t *mux, uint32_t channel)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    mux->channels[channel].armed = false;
+    schedule(mux);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_clear_interrupt(ticker_mux_t *mux, uint32_t channel)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    mux->channels[channel].pending = false;
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_fire_interrupt(ticker_mux_t *mux, uint32_t channel)
+{
+    MBED_ASSERT(channel < mux->count);
+
+    core_util_critical_section_enter();
+
+    mux->channels[channel].pending = true;
+    mux->interface->fire_interrupt();
+
+    core_util_critical_section_exit();
+}
+
+void ticker_mux_irq_handler(ticker_mux_t *mux, void (*handler)(uint32_t channel))
+{
+    bool passed;
+
+    core_util_critical_section_enter();
+    mux->interface->clear_interrupt();
+    update_channels(mux, mux->interface->read(), &passed);
+    core_util_critical_section_exit();
+
+    // The handler of a channel clears its interrupt, and sets the next one
+    for (uint32_t i = 0; i < mux->count; i++) {
+        if (mux->channels[i].pending) {
+            handler(i);
+        }
+    }
+
+    core_util_critical_section_enter();
+    schedule(mux);
+    core_util_critical_section_exit();
+}
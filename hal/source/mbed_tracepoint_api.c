@@ -0,0 +1,156 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/tracepoint_api.h"
+
+#if MBED_CONF_TARGET_TRACEPOINTS_ENABLED
+
+#include "bootstrap/mbed_critical.h"
+#include "cmsis.h"
+#include "hal/cycle_counter_api.h"
+#include "hal/itm_api.h"
+#include "hal/us_ticker_api.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#define TRACEPOINT_ITM (DEVICE_ITM && MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT >= 0)
+
+#if (MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE & (MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE - 1)) != 0
+#error MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE must be a power of two
+#endif
+
+static bool recording;
+#if !TRACEPOINT_ITM
+// Free running positions, the ring holds the last BUFFER_SIZE records
+static hal_tracepoint_record_t ring[MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE];
+static uint32_t head;
+static uint32_t tail;
+static uint32_t dropped;
+#endif
+
+static uint32_t tracepoint_timestamp(void)
+{
+#if DEVICE_CYCLE_COUNTER
+    return hal_cycle_counter_read();
+#elif DEVICE_USTICKER
+    return us_ticker_read();
+#else
+    return 0;
+#endif
+}
+
+void hal_tracepoint_init(void)
+{
+#if DEVICE_CYCLE_COUNTER
+    hal_cycle_counter_init();
+#elif DEVICE_USTICKER
+    us_ticker_init();
+#endif
+#if TRACEPOINT_ITM
+    mbed_itm_init();
+#endif
+    recording = true;
+}
+
+uint32_t hal_tracepoint_frequency(void)
+{
+#if DEVICE_CYCLE_COUNTER
+    return SystemCoreClock;
+#elif DEVICE_USTICKER
+    return us_ticker_get_info()->frequency;
+#else
+    return 0;
+#endif
+}
+
+void hal_tracepoint_record(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+    if (!recording) {
+        return;
+    }
+
+    // Stamped inside the critical section, so the records are in time order
+    core_util_critical_section_enter();
+#if TRACEPOINT_ITM
+    const hal_tracepoint_record_t record = {
+        tracepoint_timestamp(), id, (uint16_t)__get_IPSR(), arg0, arg1
+    };
+    mbed_itm_send_block_buffered(MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT, &record, sizeof(record));
+#else
+    hal_tracepoint_record_t *record = &ring[head % MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE];
+    record->timestamp = tracepoint_timestamp();
+    record->id = id;
+    record->context = (uint16_t)__get_IPSR();
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+    head++;
+    if (head - tail > MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE) {
+        tail++;
+        dropped++;
+    }
+#endif
+    core_util_critical_section_exit();
+}
+
+size_t hal_tracepoint_read(hal_tracepoint_record_t *records, size_t count)
+{
+    size_t read = 0;
+
+#if !TRACEPOINT_ITM
+    core_util_critical_section_enter();
+    while (read < count && tail != head) {
+        records[read++] = ring[tail % MBED_CONF_TARGET_TRACEPOINTS_BUFFER_SIZE];
+        tail++;
+    }
+    core_util_critical_section_exit();
+#else
+    (void)records;
+    (void)count;
+#endif
+
+    return read;
+}
+
+uint32_t hal_tracepoint_dropped(void)
+{
+#if !TRACEPOINT_ITM
+    return dropped;
+#else
+    return mbed_itm_dropped() / sizeof(hal_tracepoint_record_t);
+#endif
+}
+
+void hal_tracepoint_dump(void)
+{
+    static const char digits[] = "0123456789abcdef";
+    hal_tracepoint_record_t record;
+    char line[2 * sizeof(record) + 1];
+
+    printf("#tracepoint begin %lu\n", (unsigned long)hal_tracepoint_frequency());
+    while (hal_tracepoint_read(&record, 1) == 1) {
+        const uint8_t *bytes = (const uint8_t *)&record;
+        for (size_t i = 0; i < sizeof(record); i++) {
+            line[2 * i] = digits[bytes[i] >> 4];
+            line[2 * i + 1] = digits[bytes[i] & 0xF];
+        }
+        line[2 * sizeof(record)] = '\0';
+        printf("#tracepoint %s\n", line);
+    }
+    printf("#tracepoint end\n");
+}
+
+#endif // MBED_CONF_TARGET_TRACEPOINTS_ENABLED
@@ -0,0 +1,269 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/trng_api.h"
+
+#if defined(DEVICE_TRNG) || defined(FEATURE_PSA)
+
+#include "bootstrap/mbed_critical.h"
+#include "bootstrap/mbed_toolchain.h"
+#include "hal/crc_api.h"
+#include "hal/crc_sw_api.h"
+#include "hal/hash_api.h"
+#include <string.h>
+
+/* Bytes read from the TRNG per critical section while filling */
+#define TRNG_POOL_CHUNK 8
+
+MBED_WEAK int trng_irq_set(trng_t *obj, trng_irq_handler handler, uint32_t id)
+{
+    (void)obj;
+    (void)handler;
+    (void)id;
+    return -1;
+}
+
+static void trng_pool_irq(uint32_t id)
+{
+    trng_pool_t *pool = (trng_pool_t *)id;
+
+    trng_pool_fill(pool);
+    if (pool->count == MBED_CONF_TARGET_TRNG_POOL_SIZE) {
+        trng_irq_set(pool->trng, NULL, 0);
+    }
+}
+
+void trng_pool_init(trng_pool_t *pool, trng_t *obj)
+{
+    pool->trng = obj;
+    pool->head = 0;
+    pool->count = 0;
+    pool->irq = trng_irq_set(obj, trng_pool_irq, (uint32_t)pool) == 0;
+}
+
+void trng_pool_free(trng_pool_t *pool)
+{
+    if (pool->irq) {
+        trng_irq_set(pool->trng, NULL, 0);
+    }
+    core_util_critical_section_enter();
+    memset(pool->buffer, 0, sizeof(pool->buffer));
+    pool->count = 0;
+    core_util_critical_section_exit();
+}
+
+size_t trng_pool_fill(trng_pool_t *pool)
+{
+    size_t added = 0;
+
+    while (true) {
+        core_util_critical_section_enter();
+        const size_t tail = (pool->head + pool->count) % MBED_CONF_TARGET_TRNG_POOL_SIZE;
+        size_t space = MBED_CONF_TARGET_TRNG_POOL_SIZE - pool->count;
+        // contiguous space up to the end of the ring
+        if (space > MBED_CONF_TARGET_TRNG_POOL_SIZE - tail) {
+            space = MBED_CONF_TARGET_TRNG_POOL_SIZE - tail;
+        }
+        if (space > TRNG_POOL_CHUNK) {
+            space = TRNG_POOL_CHUNK;
+        }
+        size_t length = 0;
+        if ((space == 0) || (trng_get_bytes(pool->trng, &pool->buffer[tail], space, &length) != 0)) {
+            length = 0;
+        }
+        pool->count += length;
+        core_util_critical_section_exit();
+
+        added += length;
+        if ((space == 0) || (length < space)) {
+            return added;
+        }
+    }
+}
+
+size_t trng_pool_count(const trng_pool_t *pool)
+{
+    return pool->count;
+}
+
+int trng_get_bytes_pooled(trng_pool_t *pool, uint8_t *output, size_t length, size_t *output_length)
+{
+    size_t copied = 0;
+
+    core_util_critical_section_enter();
+    while ((copied < length) && (pool->count > 0)) {
+        size_t chunk = MBED_CONF_TARGET_TRNG_POOL_SIZE - pool->head;
+        if (chunk > pool->count) {
+            chunk = pool->count;
+        }
+        if (chunk > length - copied) {
+            chunk = length - copied;
+        }
+        memcpy(output + copied, &pool->buffer[pool->head], chunk);
+        memset(&pool->buffer[pool->head], 0, chunk);
+        pool->head = (pool->head + chunk) % MBED_CONF_TARGET_TRNG_POOL_SIZE;
+        pool->count -= chunk;
+        copied += chunk;
+    }
+    core_util_critical_section_exit();
+
+    // room again for the interrupt to refill
+    if (pool->irq && (copied > 0)) {
+        trng_irq_set(pool->trng, trng_pool_irq, (uint32_t)pool);
+    }
+
+    *output_length = copied;
+    return 0;
+}
+
+void trng_health_init(trng_health_t *health)
+{
+    memset(health, 0, sizeof(*health));
+    health->startup = TRNG_STARTUP_SAMPLES;
+}
+
+int trng_health_check(trng_health_t *health, const uint8_t *samples, size_t length)
+{
+    for (size_t i = 0; (i < length) && !health->failed; i++) {
+        const uint8_t sample = samples[i];
+
+        // Repetition Count Test, SP 800-90B 4.4.1
+        if ((health->rct_count > 0) && (sample == health->rct_sample)) {
+            if (++health->rct_count >= MBED_CONF_TARGET_TRNG_RCT_CUTOFF) {
+                health->failed = true;
+            }
+        } else {
+            health->rct_sample = sample;
+            health->rct_count = 1;
+        }
+
+        // Adaptive Proportion Test, SP 800-90B 4.4.2
+        if (health->apt_index == 0) {
+            health->apt_sample = sample;
+            health->apt_count = 1;
+        } else if ((sample == health->apt_sample) && (++health->apt_count >= MBED_CONF_TARGET_TRNG_APT_CUTOFF)) {
+            health->failed = true;
+        }
+        if (++health->apt_index == TRNG_APT_WINDOW_SIZE) {
+            health->apt_index = 0;
+        }
+    }
+
+    return health->failed ? -1 : 0;
+}
+
+static const crc_mbed_config_t trng_crc_config = {
+    POLY_32BIT_ANSI, 32, 0xFFFFFFFF, 0xFFFFFFFF, true, true
+};
+
+MBED_WEAK void trng_condition(const uint8_t *input, size_t length, uint8_t *output)
+{
+    uint32_t result;
+
+#if DEVICE_HASH
+    // SHA-256, a vetted conditioning function, truncated to the block size
+    if (HAL_HASH_IS_SUPPORTED(HAL_HASH_SHA256)) {
+        hal_hash_ctx_t ctx;
+        uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+        hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+        hal_hash_ctx_update(&ctx, input, length);
+        hal_hash_ctx_get_digest(&ctx, digest);
+        memcpy(output, digest, TRNG_CONDITIONED_BLOCK_SIZE);
+        memset(digest, 0, sizeof(digest));
+        memset(&ctx, 0, sizeof(ctx));
+        return;
+    }
+#endif
+
+#if DEVICE_CRC
+    if (HAL_CRC_IS_SUPPORTED(POLY_32BIT_ANSI, 32)) {
+        hal_crc_ctx_t ctx;
+        hal_crc_ctx_start(&ctx, &trng_crc_config);
+        hal_crc_ctx_update(&ctx, input, length);
+        result = hal_crc_ctx_get_result(&ctx);
+    } else
+#endif
+    {
+        // Nibble table, built on first use; concurrent builds write the same entries
+        static uint32_t table[CRC_SW_TABLE_ENTRIES(0)];
+        static bool table_ready;
+        crc_sw_ctx_t ctx;
+
+        if (!table_ready) {
+            crc_sw_table_init(table, 0, &trng_crc_config);
+            table_ready = true;
+        }
+        crc_sw_ctx_start(&ctx, &trng_crc_config, table, 0);
+        crc_sw_ctx_update(&ctx, input, length);
+        result = crc_sw_ctx_get_result(&ctx);
+    }
+
+    memcpy(output, &result, TRNG_CONDITIONED_BLOCK_SIZE);
+}
+
+/* Fill a buffer with raw samples which passed the health tests */
+static int trng_get_bytes_tested(trng_t *obj, trng_health_t *health, uint8_t *raw, size_t length)
+{
+    size_t count = 0;
+
+    while (count < length) {
+        size_t read = 0;
+        if ((trng_get_bytes(obj, raw + count, length - count, &read) != 0) ||
+                (trng_health_check(health, raw + count, read) != 0)) {
+            return -1;
+        }
+        count += read;
+    }
+
+    return 0;
+}
+
+int trng_get_bytes_conditioned(trng_t *obj, trng_health_t *health, uint8_t *output, size_t length, size_t *output_length)
+{
+    uint8_t raw[MBED_CONF_TARGET_TRNG_CONDITIONING_INPUT_SIZE];
+    uint8_t block[TRNG_CONDITIONED_BLOCK_SIZE];
+    size_t copied = 0;
+    int ret = health->failed ? -1 : 0;
+
+    // Start-up tests, SP 800-90B 4.3, the samples are discarded
+    while ((ret == 0) && (health->startup > 0)) {
+        const size_t chunk = health->startup < sizeof(raw) ? health->startup : sizeof(raw);
+        ret = trng_get_bytes_tested(obj, health, raw, chunk);
+        if (ret == 0) {
+            health->startup -= chunk;
+        }
+    }
+
+    while ((ret == 0) && (copied < length)) {
+        ret = trng_get_bytes_tested(obj, health, raw, sizeof(raw));
+        if (ret == 0) {
+            size_t chunk = length - copied;
+            if (chunk > sizeof(block)) {
+                chunk = sizeof(block);
+            }
+            trng_condition(raw, sizeof(raw), block);
+            memcpy(output + copied, block, chunk);
+            copied += chunk;
+        }
+    }
+
+    memset(raw, 0, sizeof(raw));
+    memset(block, 0, sizeof(block));
+    *output_length = copied;
+    return ret;
+}
+
+#endif
@@ -15,12 +15,24 @@
  */
 
 #include <stddef.h>
+#include "bootstrap/mbed_assert.h"
 #include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_toolchain.h"
 #include "hal/us_ticker_api.h"
+#include "hal/secure_gateway_api.h"
+#include "hal/ticker_mux_api.h"
+#include "hal/utils/critical_section_api.h"
 
 #if DEVICE_USTICKER
 
-static ticker_event_queue_t events = { 0 };
+#ifdef US_TICKER_IRQn
+#include "cmsis.h"
+#endif
+
+MBED_STATIC_ASSERT(MBED_CONF_TARGET_US_TICKER_CHANNELS >= 1 && MBED_CONF_TARGET_US_TICKER_CHANNELS <= 4,
+                   "The us ticker has between 1 and 4 channels");
+
+MBED_DTCM_BSS static ticker_event_queue_t events = { 0 };
 
 static ticker_irq_handler_type irq_handler = ticker_irq_handler;
 
@@ -55,13 +67,34 @@ static void note_us_ticker_free()
 
 #endif // MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
 
+#if DOMAIN_NS
+static const volatile uint32_t *us_ticker_shadow;
+static bool us_ticker_shadow_checked;
+
+/* Read the counter the secure image shares, rather than making a secure
+ * call for each read. The shadow is looked up on the first read, once the
+ * ticker is initialized. */
+static uint32_t us_ticker_read_shadow(void)
+{
+    if (!us_ticker_shadow_checked) {
+        us_ticker_shadow = hal_secure_us_ticker_shadow();
+        us_ticker_shadow_checked = true;
+    }
+    return us_ticker_shadow ? *us_ticker_shadow : us_ticker_read();
+}
+
+#define US_TICKER_READ us_ticker_read_shadow
+#else
+#define US_TICKER_READ us_ticker_read
+#endif
+
 static const ticker_interface_t us_interface = {
 #if MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     .init = us_ticker_init,
 #else
     .init = note_us_ticker_init,
 #endif
-    .read = us_ticker_read,
+    .read = US_TICKER_READ,
     .disable_interrupt = us_ticker_disable_interrupt,
     .clear_interrupt = us_ticker_clear_interrupt,
     .set_interrupt = us_ticker_set_interrupt,
@@ -73,8 +106,93 @@ static const ticker_interface_t us_interface = {
     .free = note_us_ticker_free,
 #endif
     .runs_in_deep_sleep = false,
+#if US_TICKER_COMPARE_CHANNELS && MBED_CONF_TARGET_US_TICKER_CHANNELS == 1
+    // The multiplexer only uses the channel of us_ticker_set_interrupt
+    .set_interrupt_channels = us_ticker_set_interrupt_channels,
+    .compare_channels = US_TICKER_COMPARE_CHANNELS,
+#endif
+};
+
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 1
+
+static ticker_mux_channel_t us_channels[MBED_CONF_TARGET_US_TICKER_CHANNELS];
+
+static ticker_mux_t us_mux = {
+    .interface = &us_interface,
+    .channels = us_channels,
+    .count = MBED_CONF_TARGET_US_TICKER_CHANNELS,
+};
+
+// The interface functions take no parameter, define them for each channel
+#define US_TICKER_CHANNEL_INTERFACE(n)                                                                      \
+    static void us_ticker_channel_init_##n(void) { ticker_mux_init(&us_mux, n); }                          \
+    static void us_ticker_channel_free_##n(void) { ticker_mux_free(&us_mux, n); }                          \
+    static void us_ticker_channel_disable_interrupt_##n(void) { ticker_mux_disable_interrupt(&us_mux, n); } \
+    static void us_ticker_channel_clear_interrupt_##n(void) { ticker_mux_clear_interrupt(&us_mux, n); }     \
+    static void us_ticker_channel_fire_interrupt_##n(void) { ticker_mux_fire_interrupt(&us_mux, n); }       \
+    static void us_ticker_channel_set_interrupt_##n(timestamp_t timestamp)                                  \
+    {                                                                                                       \
+        ticker_mux_set_interrupt(&us_mux, n, timestamp);                                                    \
+    }                                                                                                       \
+    static const ticker_interface_t us_channel_interface_##n = {                                            \
+        .init = us_ticker_channel_init_##n,                                                                 \
+        .read = US_TICKER_READ,                                                                             \
+        .disable_interrupt = us_ticker_channel_disable_interrupt_##n,                                       \
+        .clear_interrupt = us_ticker_channel_clear_interrupt_##n,                                           \
+        .set_interrupt = us_ticker_channel_set_interrupt_##n,                                               \
+        .fire_interrupt = us_ticker_channel_fire_interrupt_##n,                                             \
+        .get_info = us_ticker_get_info,                                                                     \
+        .free = us_ticker_channel_free_##n,                                                                 \
+        .runs_in_deep_sleep = false,                                                                        \
+    }
+
+US_TICKER_CHANNEL_INTERFACE(0);
+US_TICKER_CHANNEL_INTERFACE(1);
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 2
+US_TICKER_CHANNEL_INTERFACE(2);
+#endif
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 3
+US_TICKER_CHANNEL_INTERFACE(3);
+#endif
+
+static ticker_event_queue_t channel_events[MBED_CONF_TARGET_US_TICKER_CHANNELS - 1];
+
+// Channel 0 is the us ticker data used by the rest of the HAL
+static const ticker_data_t us_channel_data[MBED_CONF_TARGET_US_TICKER_CHANNELS] = {
+    { .interface = &us_channel_interface_0, .queue = &events },
+    { .interface = &us_channel_interface_1, .queue = &channel_events[0] },
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 2
+    { .interface = &us_channel_interface_2, .queue = &channel_events[1] },
+#endif
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 3
+    { .interface = &us_channel_interface_3, .queue = &channel_events[2] },
+#endif
 };
 
+static void us_ticker_channel_irq_handler(uint32_t channel)
+{
+    if (channel != 0) {
+        ticker_irq_handler(&us_channel_data[channel]);
+    } else if (irq_handler) {
+        irq_handler(&us_channel_data[0]);
+    }
+}
+
+const ticker_data_t *get_us_ticker_data(void)
+{
+    return &us_channel_data[0];
+}
+
+const ticker_data_t *get_us_ticker_channel_data(uint32_t channel)
+{
+    if (channel >= MBED_CONF_TARGET_US_TICKER_CHANNELS) {
+        return NULL;
+    }
+    return &us_channel_data[channel];
+}
+
+#else // MBED_CONF_TARGET_US_TICKER_CHANNELS > 1
+
 static const ticker_data_t us_data = {
     .interface = &us_interface,
     .queue = &events
@@ -85,6 +203,13 @@ const ticker_data_t *get_us_ticker_data(void)
     return &us_data;
 }
 
+const ticker_data_t *get_us_ticker_channel_data(uint32_t channel)
+{
+    return channel == 0 ? &us_data : NULL;
+}
+
+#endif // MBED_CONF_TARGET_US_TICKER_CHANNELS > 1
+
 ticker_irq_handler_type set_us_ticker_irq_handler(ticker_irq_handler_type ticker_irq_handler)
 {
     ticker_irq_handler_type prev_irq_handler = irq_handler;
@@ -94,11 +219,29 @@ ticker_irq_handler_type set_us_ticker_irq_handler(ticker_irq_handler_type ticker
     return prev_irq_handler;
 }
 
+bool us_ticker_set_irq_priority(uint32_t priority)
+{
+#ifdef US_TICKER_IRQn
+    if (!hal_critical_section_masks_priority(priority)) {
+        return false;
+    }
+    NVIC_SetPriority(US_TICKER_IRQn, priority);
+    return true;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
 void us_ticker_irq_handler(void)
 {
+#if MBED_CONF_TARGET_US_TICKER_CHANNELS > 1
+    ticker_mux_irq_handler(&us_mux, us_ticker_channel_irq_handler);
+#else
     if (irq_handler) {
         irq_handler(&us_data);
     }
+#endif
 }
 
 #else
@@ -108,4 +251,10 @@ const ticker_data_t *get_us_ticker_data(void)
     return NULL;
 }
 
+const ticker_data_t *get_us_ticker_channel_data(uint32_t channel)
+{
+    (void)channel;
+    return NULL;
+}
+
 #endif  // DEVICE_USTICKER
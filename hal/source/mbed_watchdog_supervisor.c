@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/watchdog_supervisor_api.h"
+
+#if DEVICE_WATCHDOG
+
+#include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+static volatile uint32_t registered;
+static volatile uint32_t checked_in;
+static bool running;
+
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+// Wakes the core up for the next kick, when nothing else does
+static ticker_event_t wakeup_event;
+static uint32_t wakeup_interval_us;
+
+static const ticker_data_t *get_wakeup_ticker(void)
+{
+#if DEVICE_LPTICKER
+    return get_lp_ticker_data();
+#else
+    return get_us_ticker_data();
+#endif
+}
+
+/* Half the earliest time the watchdog may trigger after a kick. */
+static uint32_t compute_wakeup_interval_us(void)
+{
+    const watchdog_features_t features = hal_watchdog_get_platform_features();
+    uint64_t interval_us = (uint64_t)hal_watchdog_get_reload_value() * 1000;
+
+    if (features.clock_max_frequency > features.clock_typical_frequency) {
+        interval_us = interval_us * features.clock_typical_frequency / features.clock_max_frequency;
+    }
+    interval_us /= 2;
+
+    return interval_us > UINT32_MAX ? UINT32_MAX : (uint32_t)interval_us;
+}
+
+static void schedule_wakeup(void)
+{
+    const ticker_data_t *const ticker = get_wakeup_ticker();
+
+    ticker_remove_event(ticker, &wakeup_event);
+    ticker_insert_event_us(ticker, &wakeup_event, ticker_read_us(ticker) + wakeup_interval_us, TICKER_WAKEUP_ID);
+}
+#endif
+
+watchdog_status_t hal_watchdog_supervisor_start(const watchdog_config_t *config)
+{
+    core_util_critical_section_enter();
+
+    const watchdog_status_t status = hal_watchdog_init(config);
+    if (status == WATCHDOG_STATUS_OK) {
+        core_util_atomic_store_u32(&checked_in, 0);
+        running = true;
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+        wakeup_interval_us = compute_wakeup_interval_us();
+        schedule_wakeup();
+#endif
+    }
+
+    core_util_critical_section_exit();
+
+    return status;
+}
+
+watchdog_status_t hal_watchdog_supervisor_stop(void)
+{
+    core_util_critical_section_enter();
+
+    const watchdog_status_t status = hal_watchdog_stop();
+    if (status == WATCHDOG_STATUS_OK) {
+        running = false;
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+        ticker_remove_event(get_wakeup_ticker(), &wakeup_event);
+#endif
+    }
+
+    core_util_critical_section_exit();
+
+    return status;
+}
+
+int hal_watchdog_supervisor_register(void)
+{
+    const int client = core_util_atomic_bitmap_claim_u32(&registered);
+    if (client >= 0) {
+        // The client has not checked in yet
+        core_util_atomic_bitmap_release_u32(&checked_in, (unsigned)client);
+    }
+    return client;
+}
+
+void hal_watchdog_supervisor_unregister(int client)
+{
+    MBED_ASSERT(client >= 0 && client < WATCHDOG_SUPERVISOR_MAX_CLIENTS);
+
+    core_util_atomic_bitmap_release_u32(&registered, (unsigned)client);
+    core_util_atomic_bitmap_release_u32(&checked_in, (unsigned)client);
+}
+
+void hal_watchdog_supervisor_check_in(int client)
+{
+    MBED_ASSERT(client >= 0 && client < WATCHDOG_SUPERVISOR_MAX_CLIENTS);
+
+    core_util_atomic_fetch_or_u32(&checked_in, 1UL << client);
+}
+
+bool hal_watchdog_supervisor_service(void)
+{
+    bool kicked = false;
+
+    core_util_critical_section_enter();
+
+    const uint32_t expected = core_util_atomic_load_u32(&registered);
+    if (running && (core_util_atomic_load_u32(&checked_in) & expected) == expected) {
+        // Check-ins made from here on count for the next kick
+        core_util_atomic_fetch_and_u32(&checked_in, ~expected);
+        hal_watchdog_kick();
+#if DEVICE_LPTICKER || DEVICE_USTICKER
+        schedule_wakeup();
+#endif
+        kicked = true;
+    }
+
+    core_util_critical_section_exit();
+
+    return kicked;
+}
+
+#endif // DEVICE_WATCHDOG
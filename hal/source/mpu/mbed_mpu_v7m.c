@@ -15,7 +15,10 @@
  */
 
 #include "hal/mpu_api.h"
+#include "hal/cache_api.h"
 #include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
 #include "cmsis.h"
 
 #if ((__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || (__ARM_ARCH_6M__ == 1U)) && \
@@ -44,6 +47,16 @@ static_assert(
     MBED_MPU_ROM_END == 0x20000000 - 1,
     "Unsupported value for MBED_MPU_ROM_END");
 
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+static_assert(
+    (MBED_CONF_TARGET_DMA_RAM_SIZE & (MBED_CONF_TARGET_DMA_RAM_SIZE - 1)) == 0 &&
+    (MBED_CONF_TARGET_DMA_RAM_START & (MBED_CONF_TARGET_DMA_RAM_SIZE - 1)) == 0,
+    "The DMA RAM must be a power of two size, aligned on its size");
+#endif
+
+// Regions in use, the ones of ROM and RAM protection and the ones added
+static volatile uint32_t regions_used;
+
 void mbed_mpu_init()
 {
     // Flush memory writes before configuring the MPU.
@@ -135,6 +148,10 @@ void mbed_mpu_init()
 #else
 #define LAST_RAM_REGION 2
 #endif
+#define FIRST_ADDED_REGION (LAST_RAM_REGION + 1)
+
+    // The regions the MPU doesn't have are never available
+    core_util_atomic_store_u32(&regions_used, ((1UL << FIRST_ADDED_REGION) - 1) | ~((1UL << regions) - 1));
 
     // Select region 1 and use it for WBWA ram regions
     // - SRAM 0x20000000 to 0x3FFFFFFF
@@ -188,6 +205,23 @@ void mbed_mpu_init()
     // Ensure changes take effect
     __DSB();
     __ISB();
+
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+    const mpu_region_t dma_ram = {
+        MBED_CONF_TARGET_DMA_RAM_START,
+        MBED_CONF_TARGET_DMA_RAM_SIZE,
+        MPU_ACCESS_READ_WRITE,
+        HAL_DMA_RAM_NON_CACHEABLE ? MPU_CACHE_NONE : MPU_CACHE_WRITE_THROUGH,
+        false,
+        true
+    };
+    const int dma_ram_region = mbed_mpu_region_add(&dma_ram);
+    MBED_ASSERT(dma_ram_region != -1);
+    (void)dma_ram_region;
+
+    // Write back the lines cached while the DMA RAM was write-back
+    hal_dcache_clean_invalidate_range((void *)MBED_CONF_TARGET_DMA_RAM_START, MBED_CONF_TARGET_DMA_RAM_SIZE);
+#endif
 }
 
 void mbed_mpu_free()
@@ -235,4 +269,114 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+static bool region_rasr(const mpu_region_t *region, uint32_t *rasr)
+{
+    // A power of two size, with the base aligned on it
+    if (region->size < 32 || (region->size & (region->size - 1)) || (region->base & (region->size - 1))) {
+        return false;
+    }
+
+    uint32_t access_permission;
+    switch (region->access) {
+        case MPU_ACCESS_NONE:
+            access_permission = ARM_MPU_AP_NONE;
+            break;
+        case MPU_ACCESS_READ_ONLY:
+            access_permission = ARM_MPU_AP_RO;
+            break;
+        default:
+            access_permission = ARM_MPU_AP_FULL;
+            break;
+    }
+
+    // TEX, C and B encodings of normal memory
+    uint32_t type_ext, cacheable, bufferable;
+    switch (region->cache) {
+        case MPU_CACHE_NONE:
+            type_ext = 1, cacheable = 0, bufferable = 0;
+            break;
+        case MPU_CACHE_WRITE_THROUGH:
+            type_ext = 0, cacheable = 1, bufferable = 0;
+            break;
+        default:
+            type_ext = 1, cacheable = 1, bufferable = 1;
+            break;
+    }
+
+    *rasr = ARM_MPU_RASR(
+                region->execute_never,          // DisableExec
+                access_permission,              // AccessPermission
+                type_ext,                       // TypeExtField
+                region->shareable,              // IsShareable
+                cacheable,                      // IsCacheable
+                bufferable,                     // IsBufferable
+                0U,                             // SubRegionDisable
+                30U - __CLZ(region->size));     // Size, ARM_MPU_REGION_SIZE_32B for 32 bytes
+
+    return true;
+}
+
+static void set_region(uint32_t id, uint32_t base, uint32_t rasr)
+{
+    core_util_critical_section_enter();
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    // Disable the region while neither the old nor the new configuration is complete
+    ARM_MPU_ClrRegion(id);
+    ARM_MPU_SetRegion(ARM_MPU_RBAR(id, base), rasr);
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+
+    core_util_critical_section_exit();
+}
+
+int mbed_mpu_region_add(const mpu_region_t *region)
+{
+    uint32_t rasr;
+    if (!region_rasr(region, &rasr)) {
+        return -1;
+    }
+
+    const int id = core_util_atomic_bitmap_claim_u32(&regions_used);
+    if (id >= 0) {
+        set_region(id, region->base, rasr);
+    }
+
+    return id;
+}
+
+int mbed_mpu_region_set(int id, const mpu_region_t *region)
+{
+    MBED_ASSERT(id >= FIRST_ADDED_REGION && id < 32 && (regions_used & (1UL << id)));
+
+    uint32_t rasr;
+    if (!region_rasr(region, &rasr)) {
+        return -1;
+    }
+
+    set_region(id, region->base, rasr);
+
+    return 0;
+}
+
+void mbed_mpu_region_remove(int id)
+{
+    MBED_ASSERT(id >= FIRST_ADDED_REGION && id < 32 && (regions_used & (1UL << id)));
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    ARM_MPU_ClrRegion(id);
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+
+    core_util_atomic_bitmap_release_u32(&regions_used, id);
+}
+
 #endif
@@ -15,7 +15,10 @@
  */
 
 #include "hal/mpu_api.h"
+#include "hal/cache_api.h"
 #include "bootstrap/mbed_assert.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
 #include "cmsis.h"
 
 #if ((__ARM_ARCH_8M_BASE__ == 1U) || (__ARM_ARCH_8M_MAIN__ == 1U) || (__ARM_ARCH_8_1M_MAIN__ == 1U)) && \
@@ -36,6 +39,20 @@
 static_assert(MBED_MPU_ROM_END <= 0x20000000 - 1,
               "Unsupported value for MBED_MPU_ROM_END");
 
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+static_assert(((MBED_CONF_TARGET_DMA_RAM_START | MBED_CONF_TARGET_DMA_RAM_SIZE) & 0x1F) == 0,
+              "The DMA RAM must be aligned on 32 bytes");
+#endif
+
+enum {
+    AttrIndex_WTRA,
+    AttrIndex_WBWARA,
+    AttrIndex_NC,
+};
+
+// Regions in use, the ones of ROM and RAM protection and the ones added
+static volatile uint32_t regions_used;
+
 void mbed_mpu_init()
 {
     // Flush memory writes before configuring the MPU.
@@ -75,13 +92,11 @@ void mbed_mpu_init()
 
     const uint8_t WTRA = ARM_MPU_ATTR_MEMORY_(1, 0, 1, 0);      // Non-transient, Write-Through, Read-allocate, Not Write-allocate
     const uint8_t WBWARA = ARM_MPU_ATTR_MEMORY_(1, 1, 1, 1);    // Non-transient, Write-Back, Read-allocate, Write-allocate
-    enum {
-        AttrIndex_WTRA,
-        AttrIndex_WBWARA,
-    };
+    const uint8_t NC = ARM_MPU_ATTR_NON_CACHEABLE;              // Normal memory, Non-cacheable
 
     ARM_MPU_SetMemAttr(AttrIndex_WTRA, ARM_MPU_ATTR(WTRA, WTRA));
     ARM_MPU_SetMemAttr(AttrIndex_WBWARA, ARM_MPU_ATTR(WBWARA, WBWARA));
+    ARM_MPU_SetMemAttr(AttrIndex_NC, ARM_MPU_ATTR(NC, NC));
 
     ARM_MPU_SetRegion(
         0,                          // Region
@@ -113,6 +128,10 @@ void mbed_mpu_init()
 #else
 #define LAST_RAM_REGION 3
 #endif
+#define FIRST_ADDED_REGION (LAST_RAM_REGION + 1)
+
+    // The regions the MPU doesn't have are never available
+    core_util_atomic_store_u32(&regions_used, ((1UL << FIRST_ADDED_REGION) - 1) | ~((1UL << regions) - 1));
 
     ARM_MPU_SetRegion(
         1,                          // Region
@@ -162,6 +181,23 @@ void mbed_mpu_init()
     // Ensure changes take effect
     __DSB();
     __ISB();
+
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+    const mpu_region_t dma_ram = {
+        MBED_CONF_TARGET_DMA_RAM_START,
+        MBED_CONF_TARGET_DMA_RAM_SIZE,
+        MPU_ACCESS_READ_WRITE,
+        HAL_DMA_RAM_NON_CACHEABLE ? MPU_CACHE_NONE : MPU_CACHE_WRITE_THROUGH,
+        false,
+        true
+    };
+    const int dma_ram_region = mbed_mpu_region_add(&dma_ram);
+    MBED_ASSERT(dma_ram_region != -1);
+    (void)dma_ram_region;
+
+    // Write back the lines cached while the DMA RAM was write-back
+    hal_dcache_clean_invalidate_range((void *)MBED_CONF_TARGET_DMA_RAM_START, MBED_CONF_TARGET_DMA_RAM_SIZE);
+#endif
 }
 
 void mbed_mpu_free()
@@ -209,4 +245,140 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+static bool region_valid(const mpu_region_t *region)
+{
+    // There is no access permission denying all accesses
+    if (region->access == MPU_ACCESS_NONE) {
+        return false;
+    }
+
+    return region->size != 0 && ((region->base | region->size) & 0x1F) == 0 &&
+           region->size - 1 <= UINT32_MAX - region->base;
+}
+
+/* Whether a region overlaps one configured other than the given one, enabled
+ * or not, as ROM and RAM protection may be enabled again after the region is
+ * added.
+ */
+static bool region_overlaps(int id, const mpu_region_t *region)
+{
+    const uint32_t regions = (MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos;
+    const uint32_t limit = region->base + (region->size - 1);
+
+    for (uint32_t other = 0; other < regions; other++) {
+        if ((int)other == id) {
+            continue;
+        }
+
+        MPU->RNR = other;
+        const uint32_t rlar = MPU->RLAR;
+        if (rlar == 0) {
+            continue;
+        }
+
+        const uint32_t other_base = MPU->RBAR & MPU_RBAR_BASE_Msk;
+        const uint32_t other_limit = (rlar & MPU_RLAR_LIMIT_Msk) | 0x1F;
+        if (region->base <= other_limit && other_base <= limit) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void set_region(uint32_t id, const mpu_region_t *region)
+{
+    uint32_t attr_index;
+    switch (region->cache) {
+        case MPU_CACHE_NONE:
+            attr_index = AttrIndex_NC;
+            break;
+        case MPU_CACHE_WRITE_THROUGH:
+            attr_index = AttrIndex_WTRA;
+            break;
+        default:
+            attr_index = AttrIndex_WBWARA;
+            break;
+    }
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    // Disable the region while neither the old nor the new configuration is complete
+    ARM_MPU_ClrRegion(id);
+    ARM_MPU_SetRegion(
+        id,                                                     // Region
+        ARM_MPU_RBAR(
+            region->base,                                       // Base
+            region->shareable ? ARM_MPU_SH_INNER : ARM_MPU_SH_NON,
+            region->access == MPU_ACCESS_READ_ONLY,             // Read-Only
+            1,                                                  // Non-Privileged
+            region->execute_never),                             // Execute Never
+        ARM_MPU_RLAR(
+            region->base + (region->size - 1),                  // Limit
+            attr_index)                                         // Attribute index
+    );
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+}
+
+int mbed_mpu_region_add(const mpu_region_t *region)
+{
+    if (!region_valid(region)) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+
+    int id = -1;
+    if (!region_overlaps(-1, region)) {
+        id = core_util_atomic_bitmap_claim_u32(&regions_used);
+        if (id >= 0) {
+            set_region(id, region);
+        }
+    }
+
+    core_util_critical_section_exit();
+
+    return id;
+}
+
+int mbed_mpu_region_set(int id, const mpu_region_t *region)
+{
+    MBED_ASSERT(id >= FIRST_ADDED_REGION && id < 32 && (regions_used & (1UL << id)));
+
+    if (!region_valid(region)) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+
+    const bool overlaps = region_overlaps(id, region);
+    if (!overlaps) {
+        set_region(id, region);
+    }
+
+    core_util_critical_section_exit();
+
+    return overlaps ? -1 : 0;
+}
+
+void mbed_mpu_region_remove(int id)
+{
+    MBED_ASSERT(id >= FIRST_ADDED_REGION && id < 32 && (regions_used & (1UL << id)));
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    ARM_MPU_ClrRegion(id);
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+
+    core_util_atomic_bitmap_release_u32(&regions_used, id);
+}
+
 #endif
@@ -72,6 +72,28 @@ MBED_WEAK void serial_set_flow_control_direct(serial_t *obj, FlowControl type, c
 }
 #endif
 
+#if DEVICE_SERIAL_RS485
+MBED_WEAK int serial_set_rs485_direct(serial_t *obj, const serial_de_pinmap_t *pinmap, const serial_rs485_config_t *config)
+{
+    return serial_set_rs485(obj, pinmap->de_pin, config);
+}
+#endif
+#endif
+
+#if DEVICE_CAPTURE
+MBED_WEAK void capture_init_direct(capture_t *obj, const PinMap *pinmap)
+{
+    capture_init(obj, pinmap->pin);
+}
+#endif
+
+#if DEVICE_COMPARE
+MBED_WEAK void compare_init_direct(compare_t *obj, const PinMap *pinmap)
+{
+    compare_init(obj, pinmap->pin);
+}
+#endif
+
 #if DEVICE_CAN
 MBED_WEAK void can_init_freq_direct(can_t *obj, const can_pinmap_t *pinmap, int hz)
 {
@@ -82,7 +104,13 @@ MBED_WEAK void can_init_direct(can_t *obj, const can_pinmap_t *pinmap)
 {
     can_init(obj, pinmap->rd_pin, pinmap->td_pin);
 }
+#endif
 
+#if DEVICE_QEI
+MBED_WEAK void qei_init_direct(qei_t *obj, const qei_pinmap_t *pinmap, qei_mode_t mode)
+{
+    qei_init(obj, pinmap->a_pin, pinmap->b_pin, pinmap->index_pin, mode);
+}
 #endif
 
 #if DEVICE_QSPI
@@ -98,5 +126,3 @@ MBED_WEAK ospi_status_t ospi_init_direct(ospi_t *obj, const ospi_pinmap_t *pinma
     return ospi_init(obj, pinmap->data0_pin, pinmap->data1_pin, pinmap->data2_pin, pinmap->data3_pin, pinmap->data4_pin, pinmap->data5_pin, pinmap->data6_pin, pinmap->data7_pin, pinmap->sclk_pin, pinmap->ssel_pin, pinmap->dqs_pin, hz, mode);
 }
 #endif
-
-#endif
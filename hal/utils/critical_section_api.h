@@ -21,6 +21,23 @@
 #define MBED_CRITICAL_SECTION_API_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+/** Priority of the interrupts masked by the default critical section
+ *
+ * 0 disables all interrupts with PRIMASK. On ARMv7-M and ARMv8-M mainline
+ * cores, a value from 1 to (1 << __NVIC_PRIO_BITS) - 1, as passed to
+ * NVIC_SetPriority(), only masks the interrupts of this priority and lower
+ * priorities with BASEPRI. The interrupts of higher priorities keep running
+ * in critical sections, so they must not use any API that enters one.
+ *
+ * @note Interrupts masked by BASEPRI don't wake the core from WFI, so the
+ * core is only put to sleep inside a critical section with
+ * hal_critical_section_sleep().
+ */
+#ifndef MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY
+#define MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY 0
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -98,6 +115,55 @@ void hal_critical_section_exit(void);
 bool hal_in_critical_section(void);
 
 
+/** Determine if the critical section masks the interrupts of a priority
+ *
+ * An interrupt handler which enters critical sections, such as the ticker
+ * interrupt handlers, must run at a priority the critical section masks, or
+ * it could preempt a critical section of lower priority. The interrupts of
+ * higher priorities keep running when the critical section only masks
+ * priorities with BASEPRI, see MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY.
+ *
+ * The default implementation can be found in mbed_critical_section_api.c, it
+ * must be overridden along with hal_critical_section_enter().
+ *
+ * @param priority Priority as passed to NVIC_SetPriority()
+ * @return True if the priority is valid and masked in critical sections
+ */
+bool hal_critical_section_masks_priority(uint32_t priority);
+
+
+/** Determine if the critical section masks the code calling this function
+ *
+ * This is true in thread mode and in the handlers of interrupts whose
+ * priority is masked, see hal_critical_section_masks_priority(). APIs whose
+ * state is shared with interrupt handlers check it, as an interrupt handler
+ * of higher priority cannot use them safely.
+ *
+ * @return True if the caller is masked in critical sections
+ */
+bool hal_critical_section_masks_caller(void);
+
+
+/** Put the core to sleep inside a critical section
+ *
+ * Calls the sleep function with all the interrupts masked by PRIMASK and
+ * with BASEPRI cleared, then restores both. A pending interrupt of any
+ * priority wakes the core up, without being taken before the critical
+ * section is exited, so the caller can check a condition set by an
+ * interrupt handler and sleep until it changes without missing the
+ * interrupt.
+ *
+ * The sleep function must not enter a critical section, which would mask
+ * the interrupts with BASEPRI again.
+ *
+ * The default implementation can be found in mbed_critical_section_api.c, it
+ * must be overridden along with hal_critical_section_enter().
+ *
+ * @param sleep Function executing WFI, such as hal_sleep() or hal_deepsleep()
+ */
+void hal_critical_section_sleep(void (*sleep)(void));
+
+
 /**@}*/
 
 #ifdef __cplusplus
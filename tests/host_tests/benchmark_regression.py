@@ -0,0 +1,116 @@
+"""
+Copyright (c) 2021 Arm Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import json
+import os
+
+from mbed_host_tests import BaseHostTest
+
+DEFAULT_BASELINE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "benchmark_baselines")
+DEFAULT_THRESHOLD = 10.0
+
+
+class BenchmarkRegression(BaseHostTest):
+    """
+    Compare the results of a benchmark with the baselines of the target
+
+    1) The device sends each result as {{benchmark;<name>,<cycles>}}
+    2) The device sends {{benchmark_done;<number of failed cases>}}
+    3) The host compares the results with <baseline dir>/<target>.json, an
+       object mapping result names to cycles, and fails the test if a result
+       is more than the threshold above its baseline
+
+    Results without a baseline are reported but don't fail the test, so a new
+    benchmark or a new target can be added before its baselines.
+
+    The environment sets:
+    - MBED_BENCHMARK_BASELINE_DIR: directory of the baselines, by default
+      benchmark_baselines next to this file
+    - MBED_BENCHMARK_THRESHOLD: increase allowed, in percent, 10 by default
+    - MBED_BENCHMARK_TARGET: target name, by default the platform name given
+      by greentea
+    - MBED_BENCHMARK_RESULTS: file to write the results to, in the format of
+      the baselines, to create or update them
+    """
+
+    def __init__(self):
+        super(BenchmarkRegression, self).__init__()
+        self.results = {}
+
+    def _callback_benchmark(self, key, value, timestamp):
+        name, _, cycles = value.rpartition(",")
+        try:
+            self.results[name] = int(cycles)
+        except ValueError:
+            self.log("invalid benchmark result '%s'" % value)
+
+    def _callback_benchmark_done(self, key, value, timestamp):
+        passed = int(value) == 0
+        target = os.environ.get("MBED_BENCHMARK_TARGET") or self.get_config_item("platform_name")
+
+        results_path = os.environ.get("MBED_BENCHMARK_RESULTS")
+        if results_path:
+            with open(results_path, "w") as results_file:
+                json.dump(self.results, results_file, indent=4, sort_keys=True)
+
+        baselines = self._load_baselines(target)
+        if baselines is None:
+            self.log("no baselines for target %s, results are not checked" % target)
+        elif not self._check(baselines):
+            passed = False
+
+        self.notify_complete(passed)
+
+    def _load_baselines(self, target):
+        if not target:
+            return None
+        baseline_dir = os.environ.get("MBED_BENCHMARK_BASELINE_DIR", DEFAULT_BASELINE_DIR)
+        path = os.path.join(baseline_dir, "%s.json" % target)
+        if not os.path.isfile(path):
+            return None
+        with open(path) as baseline_file:
+            return json.load(baseline_file)
+
+    def _check(self, baselines):
+        threshold = float(os.environ.get("MBED_BENCHMARK_THRESHOLD", DEFAULT_THRESHOLD))
+        passed = True
+
+        for name in sorted(self.results):
+            cycles = self.results[name]
+            baseline = baselines.get(name)
+            if baseline is None:
+                self.log("%s: %d cycles, no baseline" % (name, cycles))
+                continue
+
+            change = 100.0 * (cycles - baseline) / baseline if baseline else 0.0
+            if change > threshold:
+                self.log("%s: %d cycles, %+.1f%% over %d, REGRESSION" % (name, cycles, change, baseline))
+                passed = False
+            else:
+                self.log("%s: %d cycles, %+.1f%% from %d" % (name, cycles, change, baseline))
+
+        for name in sorted(set(baselines) - set(self.results)):
+            self.log("%s: not reported" % name)
+
+        return passed
+
+    def setup(self):
+        self.register_callback("benchmark", self._callback_benchmark)
+        self.register_callback("benchmark_done", self._callback_benchmark_done)
+
+    def teardown(self):
+        pass
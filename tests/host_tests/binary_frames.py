@@ -0,0 +1,89 @@
+"""
+Copyright (c) 2021 Arm Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+"""
+Decoder of the binary frames sent by greentea_send_frame()
+
+A frame is the data followed by its CRC-32, little endian, COBS encoded and
+delimited by null bytes. The key-value messages and text between the frames
+are skipped, as well as frames with a wrong CRC, which are counted.
+
+mbedhtrun only passes key-value messages to host tests, so the frames are
+decoded from the bytes of the serial port, or of a log of it:
+
+    decoder = FrameDecoder()
+    for data in decoder.feed(serial_bytes):
+        ...
+"""
+
+import struct
+import zlib
+
+CRC_SIZE = 4
+
+
+def cobs_decode(encoded):
+    """Data of a COBS encoded frame without its delimiters, None if it is invalid."""
+    data = bytearray()
+    index = 0
+    while index < len(encoded):
+        code = encoded[index]
+        end = index + code
+        if code == 0 or end > len(encoded):
+            return None
+        data += encoded[index + 1:end]
+        index = end
+        if code != 0xFF and index < len(encoded):
+            data.append(0)
+    return bytes(data)
+
+
+def decode_frame(encoded):
+    """Data of a frame, None if it is invalid or its CRC is wrong."""
+    data = cobs_decode(encoded)
+    if data is None or len(data) < CRC_SIZE:
+        return None
+    payload = data[:-CRC_SIZE]
+    (crc,) = struct.unpack("<I", data[-CRC_SIZE:])
+    return payload if zlib.crc32(payload) & 0xFFFFFFFF == crc else None
+
+
+class FrameDecoder(object):
+    """Find the frames in a stream of bytes."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.errors = 0
+
+    def feed(self, chunk):
+        """Data of the complete frames found up to the end of the chunk."""
+        self.pending += chunk
+        *candidates, pending = self.pending.split(b"\0")
+        self.pending = bytearray(pending)
+        frames = []
+        for candidate in candidates:
+            data = decode_frame(bytes(candidate))
+            if data is not None:
+                frames.append(data)
+            elif not _is_text(candidate):
+                self.errors += 1
+        return frames
+
+
+def _is_text(candidate):
+    """The text between frames, made of printable characters."""
+    return all(32 <= byte < 127 or byte in b"\t\r\n" for byte in candidate)
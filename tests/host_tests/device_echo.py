@@ -16,17 +16,45 @@ limitations under the License.
 """
 
 
+import json
+import os
 import uuid
 from mbed_host_tests import BaseHostTest
 
 class Device_Echo(BaseHostTest):
+    """
+    Echo the messages of the device, and collect its benchmark results
+
+    The device sends each result as {{echo_result;<name>,<value>}}: console
+    round trip latencies and throughput, and the throughput and CPU load of
+    the serial loopback paths at several baud rates. The results are logged,
+    and written to the file set by MBED_ECHO_RESULTS as a JSON object mapping
+    result names to values, to compare targets.
+    """
+
+    def __init__(self):
+        super(Device_Echo, self).__init__()
+        self.results = {}
 
     def _callback_repeat(self, key, value, _):
         self.send_kv(key, value)
 
+    def _callback_result(self, key, value, _):
+        name, _, result = value.rpartition(",")
+        try:
+            self.results[name] = int(result)
+        except ValueError:
+            self.log("invalid echo result '%s'" % value)
+            return
+        self.log("%s: %s" % (name, result))
+
     def setup(self):
         self.register_callback("echo", self._callback_repeat)
         self.register_callback("echo_count", self._callback_repeat)
+        self.register_callback("echo_result", self._callback_result)
 
     def teardown(self):
-        pass
+        results_path = os.environ.get("MBED_ECHO_RESULTS")
+        if results_path and self.results:
+            with open(results_path, "w") as results_file:
+                json.dump(self.results, results_file, indent=4, sort_keys=True)
@@ -0,0 +1,76 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_aes_tests */
+/** @{*/
+
+#ifndef AES_API_TESTS_H
+#define AES_API_TESTS_H
+
+#include "device.h"
+
+#if DEVICE_AES
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that HAL_AES_IS_SUPPORTED() is true for 128 bit keys in every mode.
+ *
+ *  Given is platform with hardware AES support.
+ *  When HAL_AES_IS_SUPPORTED() is evaluated for 128 bit keys in ECB, CBC and CTR modes.
+ *  Then it is true.
+ */
+void aes_is_supported_test();
+
+/** Test that the FIPS 197 and SP 800-38A examples are encrypted and decrypted.
+ *
+ *  Given is platform with hardware AES support.
+ *  When the examples of each supported mode and key size are encrypted, then decrypted.
+ *  Then the expected ciphertext and the plaintext are output.
+ */
+void aes_crypt_test();
+
+/** Test that data can be processed in several calls.
+ *
+ *  Given is platform with hardware AES support.
+ *  When the SP 800-38A examples are processed one block at a time, in place.
+ *  Then the expected ciphertext is output.
+ *  When the data size is not a multiple of the block size.
+ *  Then hal_aes_ctx_update() returns -1.
+ */
+void aes_crypt_multi_test();
+
+/** Test that computations in different contexts can be interleaved.
+ *
+ *  Given is platform with hardware AES support.
+ *  When blocks are processed alternately in contexts with different modes,
+ *  synchronously and asynchronously.
+ *  Then each context outputs the expected ciphertext.
+ */
+void aes_ctx_interleave_test();
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
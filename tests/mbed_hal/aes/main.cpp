@@ -0,0 +1,235 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "aes_api.h"
+#include "aes_api_tests.h"
+
+#if !DEVICE_AES
+#error [NOT_SUPPORTED] AES not supported for this target
+#else
+
+using namespace utest::v1;
+
+#define EXAMPLE_BLOCKS 2
+
+typedef struct {
+    aes_mbed_config_t config;
+    uint8_t key[HAL_AES_MAX_KEY_SIZE];
+    uint8_t iv[HAL_AES_BLOCK_SIZE];
+    uint8_t plaintext[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+    uint8_t ciphertext[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+    size_t size;
+} TEST_CASE;
+
+#define SP800_38A_KEY \
+    { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c }
+
+#define SP800_38A_PLAINTEXT \
+    { \
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, \
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51 \
+    }
+
+#define FIPS_197_PLAINTEXT \
+    { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff }
+
+static const TEST_CASE test_cases[] = {
+    /* SP 800-38A F.1.1, F.2.1 and F.5.1, first two blocks. */
+    {
+        {HAL_AES_MODE_ECB, 128, false}, SP800_38A_KEY, {0}, SP800_38A_PLAINTEXT,
+        {
+            0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+            0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf
+        }, 32
+    },
+    {
+        {HAL_AES_MODE_CBC, 128, false}, SP800_38A_KEY,
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+        SP800_38A_PLAINTEXT,
+        {
+            0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+            0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2
+        }, 32
+    },
+    {
+        {HAL_AES_MODE_CTR, 128, false}, SP800_38A_KEY,
+        {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff},
+        SP800_38A_PLAINTEXT,
+        {
+            0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+            0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff
+        }, 32
+    },
+    /* FIPS 197 C.1, C.2 and C.3. */
+    {
+        {HAL_AES_MODE_ECB, 128, false},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+        {0}, FIPS_197_PLAINTEXT,
+        {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a}, 16
+    },
+    {
+        {HAL_AES_MODE_ECB, 192, false},
+        {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17
+        },
+        {0}, FIPS_197_PLAINTEXT,
+        {0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0, 0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91}, 16
+    },
+    {
+        {HAL_AES_MODE_ECB, 256, false},
+        {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+        },
+        {0}, FIPS_197_PLAINTEXT,
+        {0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89}, 16
+    },
+};
+
+#define TEST_CASE_COUNT (sizeof(test_cases) / sizeof(TEST_CASE))
+
+static bool is_supported(const TEST_CASE *test_case)
+{
+    return HAL_AES_IS_SUPPORTED(test_case->config.mode, test_case->config.key_bits);
+}
+
+static void start(hal_aes_ctx_t *ctx, const TEST_CASE *test_case, bool decrypt)
+{
+    aes_mbed_config_t config = test_case->config;
+    config.decrypt = decrypt;
+    hal_aes_ctx_start(ctx, &config, test_case->key, config.mode == HAL_AES_MODE_ECB ? NULL : test_case->iv);
+}
+
+/* Test that 128 bit keys are supported in every mode. */
+void aes_is_supported_test()
+{
+    TEST_ASSERT_TRUE(HAL_AES_IS_SUPPORTED(HAL_AES_MODE_ECB, 128));
+    TEST_ASSERT_TRUE(HAL_AES_IS_SUPPORTED(HAL_AES_MODE_CBC, 128));
+    TEST_ASSERT_TRUE(HAL_AES_IS_SUPPORTED(HAL_AES_MODE_CTR, 128));
+}
+
+/* Test that the FIPS 197 and SP 800-38A examples are encrypted and decrypted. */
+void aes_crypt_test()
+{
+    for (unsigned int i = 0; i < TEST_CASE_COUNT; i++) {
+        if (!is_supported(&test_cases[i])) {
+            continue;
+        }
+
+        hal_aes_ctx_t ctx;
+        uint8_t output[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+
+        start(&ctx, &test_cases[i], false);
+        TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx, test_cases[i].plaintext, output, test_cases[i].size));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(test_cases[i].ciphertext, output, test_cases[i].size);
+
+        start(&ctx, &test_cases[i], true);
+        TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx, test_cases[i].ciphertext, output, test_cases[i].size));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(test_cases[i].plaintext, output, test_cases[i].size);
+
+        hal_aes_ctx_free(&ctx);
+    }
+}
+
+/* Test that data can be processed in several calls. */
+void aes_crypt_multi_test()
+{
+    for (unsigned int i = 0; i < TEST_CASE_COUNT; i++) {
+        if (!is_supported(&test_cases[i])) {
+            continue;
+        }
+
+        hal_aes_ctx_t ctx;
+        uint8_t buffer[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+
+        memcpy(buffer, test_cases[i].plaintext, sizeof(buffer));
+        start(&ctx, &test_cases[i], false);
+        for (size_t offset = 0; offset < test_cases[i].size; offset += HAL_AES_BLOCK_SIZE) {
+            TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx, buffer + offset, buffer + offset, HAL_AES_BLOCK_SIZE));
+        }
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(test_cases[i].ciphertext, buffer, test_cases[i].size);
+
+        TEST_ASSERT_EQUAL(-1, hal_aes_ctx_update(&ctx, buffer, buffer, HAL_AES_BLOCK_SIZE - 1));
+        hal_aes_ctx_free(&ctx);
+    }
+}
+
+static void aes_ctx_async_handler(uint32_t id)
+{
+    (*(uint32_t *)id)++;
+}
+
+/* Test that computations in different contexts can be interleaved. */
+void aes_ctx_interleave_test()
+{
+    // The CBC and CTR examples
+    const TEST_CASE *const test_a = &test_cases[1];
+    const TEST_CASE *const test_b = &test_cases[2];
+    hal_aes_ctx_t ctx_a;
+    hal_aes_ctx_t ctx_b;
+    uint8_t output_a[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+    uint8_t output_b[EXAMPLE_BLOCKS * HAL_AES_BLOCK_SIZE];
+
+    start(&ctx_a, test_a, false);
+    start(&ctx_b, test_b, false);
+    TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx_a, test_a->plaintext, output_a, HAL_AES_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx_b, test_b->plaintext, output_b, HAL_AES_BLOCK_SIZE));
+
+    volatile uint32_t calls = 0;
+    int ret = hal_aes_ctx_update_async(&ctx_a, test_a->plaintext + HAL_AES_BLOCK_SIZE, output_a + HAL_AES_BLOCK_SIZE,
+                                       HAL_AES_BLOCK_SIZE, aes_ctx_async_handler, (uint32_t) &calls);
+    TEST_ASSERT_EQUAL(0, ret);
+    while (calls == 0);
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL(0, hal_aes_ctx_update(&ctx_b, test_b->plaintext + HAL_AES_BLOCK_SIZE, output_b + HAL_AES_BLOCK_SIZE,
+                                            HAL_AES_BLOCK_SIZE));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_a->ciphertext, output_a, sizeof(output_a));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_b->ciphertext, output_b, sizeof(output_b));
+
+    hal_aes_ctx_free(&ctx_a);
+    hal_aes_ctx_free(&ctx_b);
+}
+
+Case cases[] = {
+    Case("test: supported modes.", aes_is_supported_test),
+    Case("test: AES encryption and decryption.", aes_crypt_test),
+    Case("test: AES ciphering - multi input.", aes_crypt_multi_test),
+    Case("test: interleaved computations in contexts.", aes_ctx_interleave_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    greentea_init_custom_io();
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_AES
@@ -0,0 +1,163 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/cycle_counter_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+using namespace utest::v1;
+
+#define ITERATIONS 1000
+
+static volatile uint8_t value8;
+static volatile uint16_t value16;
+static volatile uint32_t value32;
+static volatile uint64_t value64;
+static volatile int32_t signed32;
+static void *volatile pointer;
+
+/* Test that the explicit increments and decrements give the same results for every ordering. */
+void atomic_incr_decr_explicit_test()
+{
+    const mbed_memory_order orders[] = {
+        mbed_memory_order_relaxed,
+        mbed_memory_order_acquire,
+        mbed_memory_order_release,
+        mbed_memory_order_acq_rel,
+        mbed_memory_order_seq_cst,
+    };
+    uint8_t buffer[4];
+
+    for (mbed_memory_order order : orders) {
+        value8 = 0xFF;
+        value16 = 0;
+        value32 = 1;
+        value64 = UINT32_MAX;
+        signed32 = 0;
+        pointer = buffer;
+
+        TEST_ASSERT_EQUAL_UINT8(0, core_util_atomic_incr_explicit_u8(&value8, 1, order));
+        TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, core_util_atomic_decr_explicit_u16(&value16, 1, order));
+        TEST_ASSERT_EQUAL_UINT32(3, core_util_atomic_incr_explicit_u32(&value32, 2, order));
+        TEST_ASSERT_EQUAL_UINT32(1, core_util_atomic_decr_explicit_u32(&value32, 2, order));
+        TEST_ASSERT_TRUE(core_util_atomic_incr_explicit_u64(&value64, 1, order) == (uint64_t)UINT32_MAX + 1);
+        TEST_ASSERT_EQUAL_INT32(-1, core_util_atomic_decr_explicit_s32(&signed32, 1, order));
+        TEST_ASSERT_EQUAL_PTR(buffer + 3, core_util_atomic_incr_explicit_ptr(&pointer, 3, order));
+        TEST_ASSERT_EQUAL_PTR(buffer + 1, core_util_atomic_decr_explicit_ptr(&pointer, 2, order));
+    }
+}
+
+/* Test that bitmap allocation claims the lowest clear bits and reuses released bits. */
+void atomic_bitmap_test()
+{
+    volatile uint32_t bitmap = 0x5;
+
+    TEST_ASSERT_EQUAL_INT(1, core_util_atomic_bitmap_claim_u32(&bitmap));
+    TEST_ASSERT_EQUAL_INT(3, core_util_atomic_bitmap_claim_u32(&bitmap));
+    TEST_ASSERT_EQUAL_UINT32(0xF, bitmap);
+
+    TEST_ASSERT_FALSE(core_util_atomic_bitmap_claim_bit_u32(&bitmap, 2));
+    TEST_ASSERT_TRUE(core_util_atomic_bitmap_claim_bit_u32(&bitmap, 31));
+    TEST_ASSERT_EQUAL_UINT32(0x8000000F, bitmap);
+
+    core_util_atomic_bitmap_release_u32(&bitmap, 2);
+    TEST_ASSERT_EQUAL_INT(2, core_util_atomic_bitmap_claim_u32(&bitmap));
+
+    for (int i = 4; i < 31; i++) {
+        TEST_ASSERT_EQUAL_INT(i, core_util_atomic_bitmap_claim_u32(&bitmap));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, core_util_atomic_bitmap_claim_u32(&bitmap));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, bitmap);
+}
+
+/* Test that the reference count reports the last release and refuses to revive a freed object. */
+void atomic_refcount_test()
+{
+    volatile uint32_t count = 1;
+
+    TEST_ASSERT_EQUAL_UINT32(2, core_util_atomic_refcount_acquire_u32(&count));
+    TEST_ASSERT_TRUE(core_util_atomic_refcount_try_acquire_u32(&count));
+    TEST_ASSERT_EQUAL_UINT32(3, count);
+
+    TEST_ASSERT_FALSE(core_util_atomic_refcount_release_u32(&count));
+    TEST_ASSERT_FALSE(core_util_atomic_refcount_release_u32(&count));
+    TEST_ASSERT_TRUE(core_util_atomic_refcount_release_u32(&count));
+
+    TEST_ASSERT_FALSE(core_util_atomic_refcount_try_acquire_u32(&count));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+}
+
+#if DEVICE_CYCLE_COUNTER
+/* Measure the increments with and without barriers, and check relaxed ordering is not slower.
+ * The margin absorbs the jitter of the measurement when both compile to the same code.
+ */
+void atomic_incr_relaxed_benchmark_test()
+{
+    hal_cycle_counter_init();
+
+    value32 = 0;
+    core_util_critical_section_enter();
+    uint32_t start = hal_cycle_counter_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        core_util_atomic_incr_u32(&value32, 1);
+    }
+    const uint32_t seq_cst_cycles = hal_cycle_counter_read() - start;
+
+    start = hal_cycle_counter_read();
+    for (int i = 0; i < ITERATIONS; i++) {
+        core_util_atomic_incr_explicit_u32(&value32, 1, mbed_memory_order_relaxed);
+    }
+    const uint32_t relaxed_cycles = hal_cycle_counter_read() - start;
+    core_util_critical_section_exit();
+
+    printf("%d increments: %lu cycles with seq_cst, %lu cycles with relaxed\r\n", ITERATIONS,
+           (unsigned long)seq_cst_cycles, (unsigned long)relaxed_cycles);
+
+    TEST_ASSERT_EQUAL_UINT32(2 * ITERATIONS, value32);
+    TEST_ASSERT_TRUE(relaxed_cycles <= seq_cst_cycles + seq_cst_cycles / 20);
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Atomic explicit increment/decrement test", atomic_incr_decr_explicit_test),
+    Case("Atomic bitmap test", atomic_bitmap_test),
+    Case("Atomic reference count test", atomic_refcount_test),
+#if DEVICE_CYCLE_COUNTER
+    Case("Atomic relaxed increment benchmark", atomic_incr_relaxed_benchmark_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
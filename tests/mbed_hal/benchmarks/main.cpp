@@ -0,0 +1,424 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/cycle_counter_api.h"
+#include "hal/crc_api.h"
+#include "hal/flash_api.h"
+#include "hal/gpio_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/PinNameAliases.h"
+#include "hal/serial_api.h"
+#include "hal/spi_api.h"
+#include "hal/us_ticker_api.h"
+#include "mbed_atomic.h"
+#include "mbed_critical.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !DEVICE_CYCLE_COUNTER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+/* Each operation is measured this many times and the lowest count is kept, so
+ * the interrupts that occurred during some of the runs are not counted. */
+#define ITERATIONS      32
+#define NAME_LENGTH     48
+
+#define TICKER_MAX_DEPTH 16
+#define TICKER_MAX_DELTA 64
+#define TICKER_DELTA_MARGIN 8
+#define TICKER_DELTA_REPEAT 4
+#define SPI_FREQUENCY   1000000
+#define SPI_BLOCK_SIZE  16
+#define CRC_BLOCK_SIZE  64
+#define FLASH_MAX_PAGE  512
+
+extern serial_t stdio_uart;
+
+static uint32_t read_overhead;
+
+/* Get the cycles taken by one call of the operation. */
+template<typename F>
+static uint32_t measure(F operation, int iterations = ITERATIONS)
+{
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < iterations; i++) {
+        const uint32_t start = hal_cycle_counter_read();
+        operation(i);
+        const uint32_t cycles = hal_cycle_counter_read() - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best > read_overhead ? best - read_overhead : 0;
+}
+
+/* Send a result to the host, where CI tracks it across targets and commits. */
+static void report(const char *name, uint32_t cycles)
+{
+    char value[NAME_LENGTH + 12];
+    snprintf(value, sizeof(value), "%s,%lu", name, (unsigned long)cycles);
+    greentea_send_kv("benchmark", value);
+}
+
+static void benchmark_setup()
+{
+    hal_cycle_counter_init();
+    read_overhead = 0;
+    read_overhead = measure([](int) {});
+}
+
+/* Measure entering and leaving a critical section. */
+void critical_section_benchmark()
+{
+    report("critical_section_enter_exit", measure([](int) {
+        core_util_critical_section_enter();
+        core_util_critical_section_exit();
+    }));
+
+    core_util_critical_section_enter();
+    report("critical_section_nested_enter_exit", measure([](int) {
+        core_util_critical_section_enter();
+        core_util_critical_section_exit();
+    }));
+    core_util_critical_section_exit();
+}
+
+/* Measure the atomic operations used by the drivers. */
+void atomic_benchmark()
+{
+    static volatile uint32_t value;
+
+    report("atomic_load_u32", measure([](int) {
+        (void)core_util_atomic_load_u32(&value);
+    }));
+    report("atomic_store_u32", measure([](int i) {
+        core_util_atomic_store_u32(&value, i);
+    }));
+    report("atomic_incr_u32", measure([](int) {
+        (void)core_util_atomic_incr_u32(&value, 1);
+    }));
+    report("atomic_exchange_u32", measure([](int i) {
+        (void)core_util_atomic_exchange_u32(&value, i);
+    }));
+    report("atomic_cas_u32", measure([](int i) {
+        uint32_t expected = value;
+        (void)core_util_atomic_cas_u32(&value, &expected, i);
+    }));
+}
+
+#if DEVICE_USTICKER
+/* Measure reading the time, and the event queue at several depths. */
+void ticker_benchmark()
+{
+    static ticker_event_t queued[TICKER_MAX_DEPTH];
+    static ticker_event_t event;
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    char name[NAME_LENGTH];
+
+    report("ticker_read_us", measure([ticker](int) {
+        (void)ticker_read_us(ticker);
+    }));
+
+    for (int depth = 0; depth <= TICKER_MAX_DEPTH; depth = depth ? depth * 4 : 1) {
+        // Events far enough in the future not to fire during the measurement
+        const us_timestamp_t base = ticker_read_us(ticker) + 10000000;
+        for (int i = 0; i < depth; i++) {
+            ticker_insert_event_us(ticker, &queued[i], base + i * 1000, 0);
+        }
+
+        // The new event goes at the end of the queue, the longest insertion
+        uint32_t insert = UINT32_MAX;
+        uint32_t remove = UINT32_MAX;
+        for (int i = 0; i < ITERATIONS; i++) {
+            const uint32_t start = hal_cycle_counter_read();
+            ticker_insert_event_us(ticker, &event, base + TICKER_MAX_DEPTH * 1000, 0);
+            const uint32_t inserted = hal_cycle_counter_read();
+            ticker_remove_event(ticker, &event);
+            const uint32_t removed = hal_cycle_counter_read();
+            if (inserted - start < insert) {
+                insert = inserted - start;
+            }
+            if (removed - inserted < remove) {
+                remove = removed - inserted;
+            }
+        }
+
+        for (int i = 0; i < depth; i++) {
+            ticker_remove_event(ticker, &queued[i]);
+        }
+
+        snprintf(name, sizeof(name), "ticker_insert_event_us_depth_%d", depth);
+        report(name, insert - read_overhead);
+        snprintf(name, sizeof(name), "ticker_remove_event_depth_%d", depth);
+        report(name, remove - read_overhead);
+    }
+}
+
+static volatile bool ticker_fired;
+
+static void ticker_characterization_handler(const ticker_data_t *const ticker)
+{
+    ticker->interface->clear_interrupt();
+    ticker_fired = true;
+}
+
+/* Check that an interrupt set delta ticks ahead fires, TICKER_DELTA_MARGIN
+ * ticks late at most, rather than being missed until the counter wraps. */
+static bool ticker_delta_fires(const ticker_interface_t *intf, uint32_t delta)
+{
+    const uint32_t mask = (uint32_t)((1ULL << intf->get_info()->bits) - 1);
+
+    core_util_critical_section_enter();
+    ticker_fired = false;
+    const uint32_t start = intf->read();
+    intf->set_interrupt((start + delta) & mask);
+    core_util_critical_section_exit();
+
+    while (!ticker_fired && ((intf->read() - start) & mask) < delta + TICKER_DELTA_MARGIN);
+    intf->disable_interrupt();
+
+    return ticker_fired;
+}
+
+/* Measure reading a ticker at each layer, programming its interrupt and the
+ * smallest delta an interrupt can be set ahead of the counter. */
+static void ticker_characterize(const ticker_data_t *const ticker, const char *prefix)
+{
+    const ticker_interface_t *const intf = ticker->interface;
+    const uint32_t mask = (uint32_t)((1ULL << intf->get_info()->bits) - 1);
+    char name[NAME_LENGTH];
+
+    snprintf(name, sizeof(name), "%s_interface_read", prefix);
+    report(name, measure([intf](int) {
+        (void)intf->read();
+    }));
+    snprintf(name, sizeof(name), "%s_ticker_read", prefix);
+    report(name, measure([ticker](int) {
+        (void)ticker_read(ticker);
+    }));
+    snprintf(name, sizeof(name), "%s_ticker_read_us", prefix);
+    report(name, measure([ticker](int) {
+        (void)ticker_read_us(ticker);
+    }));
+
+    // Half the counter range ahead, so the interrupt does not fire
+    const uint32_t far = (intf->read() + mask / 2) & mask;
+    snprintf(name, sizeof(name), "%s_set_interrupt", prefix);
+    report(name, measure([intf, far, mask](int i) {
+        intf->set_interrupt((far + i) & mask);
+    }));
+    intf->disable_interrupt();
+
+    uint32_t delta = 1;
+    for (; delta <= TICKER_MAX_DELTA; delta++) {
+        int fired = 0;
+        while (fired < TICKER_DELTA_REPEAT && ticker_delta_fires(intf, delta)) {
+            fired++;
+        }
+        if (fired == TICKER_DELTA_REPEAT) {
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE_MESSAGE(delta <= TICKER_MAX_DELTA, "Ticker interrupt missed for every delta");
+    snprintf(name, sizeof(name), "%s_min_delta_ticks", prefix);
+    report(name, delta);
+
+    // Let the ticker layer program its next interrupt again
+    static ticker_event_t event;
+    ticker_insert_event_us(ticker, &event, ticker_read_us(ticker) + 10000000, 0);
+    ticker_remove_event(ticker, &event);
+}
+
+/* Characterize the us and lp tickers, with the interrupts of the ticker
+ * layer diverted to a stub while their interrupt is set directly. */
+void ticker_characterization()
+{
+    ticker_irq_handler_type prev_handler = set_us_ticker_irq_handler(ticker_characterization_handler);
+    ticker_characterize(get_us_ticker_data(), "us_ticker");
+    set_us_ticker_irq_handler(prev_handler);
+
+#if DEVICE_LPTICKER
+    prev_handler = set_lp_ticker_irq_handler(ticker_characterization_handler);
+    ticker_characterize(get_lp_ticker_data(), "lp_ticker");
+    set_lp_ticker_irq_handler(prev_handler);
+#endif
+}
+#endif
+
+/* Measure driving a pin. */
+void gpio_benchmark()
+{
+    static gpio_t gpio;
+    gpio_init_out(&gpio, LED1);
+
+    report("gpio_write", measure([](int i) {
+        gpio_write(&gpio, i & 1);
+    }));
+    gpio_write(&gpio, 0);
+}
+
+#if DEVICE_SPI && defined(TARGET_FF_ARDUINO_UNO)
+/* Measure SPI transfers at a fixed frequency, without a slave connected. */
+void spi_benchmark()
+{
+    static spi_t spi;
+    static uint8_t tx_buffer[SPI_BLOCK_SIZE];
+    static uint8_t rx_buffer[SPI_BLOCK_SIZE];
+    char name[NAME_LENGTH];
+
+    spi_init(&spi, ARDUINO_UNO_SPI_MOSI, ARDUINO_UNO_SPI_MISO, ARDUINO_UNO_SPI_SCK, NC);
+    spi_format(&spi, 8, 0, 0);
+    spi_frequency(&spi, SPI_FREQUENCY);
+
+    report("spi_master_write", measure([](int i) {
+        (void)spi_master_write(&spi, i);
+    }));
+    snprintf(name, sizeof(name), "spi_master_block_write_%d", SPI_BLOCK_SIZE);
+    report(name, measure([](int) {
+        (void)spi_master_block_write(&spi, (const char *)tx_buffer, SPI_BLOCK_SIZE,
+                                     (char *)rx_buffer, SPI_BLOCK_SIZE, 0xFF);
+    }));
+
+    spi_free(&spi);
+}
+#endif
+
+#if DEVICE_SERIAL
+/* Measure writing a character to the console, at the console baud rate. */
+void serial_benchmark()
+{
+    // Wait for the characters already sent
+    greentea_custom_io_flush();
+    const uint32_t start = hal_cycle_counter_read();
+    while ((hal_cycle_counter_read() - start) < SystemCoreClock / 100);
+
+    report("serial_putc", measure([](int) {
+        serial_putc(&stdio_uart, ' ');
+    }));
+    serial_putc(&stdio_uart, '\r');
+    serial_putc(&stdio_uart, '\n');
+}
+#endif
+
+#if DEVICE_FLASH
+/* Measure programming pages of the last sector, which is erased before and after. */
+void flash_benchmark()
+{
+    static flash_t flash;
+    static uint8_t page[FLASH_MAX_PAGE];
+
+    TEST_ASSERT_EQUAL_INT32(0, flash_init(&flash));
+    const uint32_t end = flash_get_start_address(&flash) + flash_get_size(&flash);
+    const uint32_t sector_size = flash_get_sector_size(&flash, end - 1);
+    const uint32_t sector = end - sector_size;
+    const uint32_t page_size = flash_get_page_size(&flash);
+    TEST_ASSERT_TRUE(page_size <= sizeof(page));
+
+    const int pages = sector_size / page_size < ITERATIONS ? sector_size / page_size : ITERATIONS;
+    for (uint32_t i = 0; i < page_size; i++) {
+        page[i] = (uint8_t)i;
+    }
+
+    report("flash_erase_sector", measure([sector](int) {
+        TEST_ASSERT_EQUAL_INT32(0, flash_erase_sector(&flash, sector));
+    }, 1));
+    report("flash_program_page", measure([sector, page_size](int i) {
+        TEST_ASSERT_EQUAL_INT32(0, flash_program_page(&flash, sector + i * page_size, page, page_size));
+    }, pages));
+
+    TEST_ASSERT_EQUAL_INT32(0, flash_erase_sector(&flash, sector));
+    TEST_ASSERT_EQUAL_INT32(0, flash_free(&flash));
+}
+#endif
+
+#if DEVICE_CRC
+/* Measure the hardware CRC over a block. */
+void crc_benchmark()
+{
+    static uint8_t data[CRC_BLOCK_SIZE];
+    const crc_mbed_config_t config = { POLY_32BIT_ANSI, 32, 0xFFFFFFFF, 0xFFFFFFFF, true, true };
+    char name[NAME_LENGTH];
+
+    memset(data, 0x5A, sizeof(data));
+    hal_crc_compute_partial_start(&config);
+    snprintf(name, sizeof(name), "hal_crc_compute_partial_%d", CRC_BLOCK_SIZE);
+    report(name, measure([](int) {
+        hal_crc_compute_partial(data, sizeof(data));
+    }));
+    (void)hal_crc_get_result();
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+#if MBED_GREENTEA_BENCHMARK
+    GREENTEA_SETUP(60, "benchmark_regression");
+#else
+    GREENTEA_SETUP(60, "default_auto");
+#endif
+    benchmark_setup();
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+/* Let the host compare the results with the baselines once they are all sent. */
+void test_teardown(const size_t passed, const size_t failed, const failure_t failure)
+{
+#if MBED_GREENTEA_BENCHMARK
+    greentea_send_kv("benchmark_done", (int)failed);
+#endif
+    greentea_test_teardown_handler(passed, failed, failure);
+}
+
+Case cases[] = {
+    Case("critical section benchmark", critical_section_benchmark),
+    Case("atomic benchmark", atomic_benchmark),
+#if DEVICE_USTICKER
+    Case("ticker benchmark", ticker_benchmark),
+    Case("ticker characterization", ticker_characterization),
+#endif
+    Case("GPIO benchmark", gpio_benchmark),
+#if DEVICE_SPI && defined(TARGET_FF_ARDUINO_UNO)
+    Case("SPI benchmark", spi_benchmark),
+#endif
+#if DEVICE_SERIAL
+    Case("serial benchmark", serial_benchmark),
+#endif
+#if DEVICE_FLASH
+    Case("flash benchmark", flash_benchmark),
+#endif
+#if DEVICE_CRC
+    Case("CRC benchmark", crc_benchmark),
+#endif
+};
+
+Specification specification(test_setup, cases, test_teardown);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CYCLE_COUNTER
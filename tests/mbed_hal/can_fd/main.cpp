@@ -0,0 +1,177 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/can_api.h"
+#include "hal/pinmap.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "../can_test_utils.h"
+
+#if !DEVICE_CAN || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define CAN_FREQUENCY 500000
+#define CAN_DATA_FREQUENCY 2000000
+#define READ_TIMEOUT_US 10000
+
+static can_t can;
+
+/* Initialize the CAN peripheral in loopback mode. */
+static void can_loopback_init()
+{
+    PinName rd;
+    PinName td;
+    TEST_ASSERT_TRUE(find_can_pins(&rd, &td));
+
+    can_init_freq(&can, rd, td, CAN_FREQUENCY);
+    TEST_ASSERT_EQUAL_INT(1, can_mode(&can, MODE_TEST_LOCAL));
+}
+
+/* Send the message and read it back. */
+static void can_fd_loopback(const CANFD_Message *msg, CANFD_Message *received)
+{
+    TEST_ASSERT_EQUAL_INT(1, can_fd_write(&can, msg, 0));
+
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    while (!can_fd_read(&can, received, 0)) {
+        TEST_ASSERT_TRUE((ticker_read_us(us_ticker) - start) < READ_TIMEOUT_US);
+    }
+}
+
+/* Test the conversion between data length codes and lengths. */
+void can_fd_dlc_test()
+{
+    for (unsigned char len = 0; len <= 8; len++) {
+        TEST_ASSERT_EQUAL_UINT8(len, can_fd_len_to_dlc(len));
+        TEST_ASSERT_EQUAL_UINT8(len, can_fd_dlc_to_len(len));
+    }
+    TEST_ASSERT_EQUAL_UINT8(9, can_fd_len_to_dlc(9));
+    TEST_ASSERT_EQUAL_UINT8(9, can_fd_len_to_dlc(12));
+    TEST_ASSERT_EQUAL_UINT8(13, can_fd_len_to_dlc(25));
+    TEST_ASSERT_EQUAL_UINT8(15, can_fd_len_to_dlc(64));
+    TEST_ASSERT_EQUAL_UINT8(32, can_fd_dlc_to_len(13));
+    TEST_ASSERT_EQUAL_UINT8(64, can_fd_dlc_to_len(15));
+}
+
+/* Test that the reported capabilities are consistent. */
+void can_fd_capabilities_test()
+{
+    can_loopback_init();
+
+    can_capabilities_t cap;
+    can_get_capabilities(&can, &cap);
+    if (cap.fd) {
+        TEST_ASSERT_EQUAL_UINT8(CAN_FD_MAX_DATA_LENGTH, cap.max_len);
+        TEST_ASSERT_TRUE(cap.max_data_hz >= CAN_FREQUENCY);
+    } else {
+        TEST_ASSERT_EQUAL_UINT8(8, cap.max_len);
+        TEST_ASSERT_EQUAL_INT(0, cap.max_data_hz);
+        TEST_ASSERT_EQUAL_INT(0, can_fd_frequency(&can, CAN_FREQUENCY, CAN_DATA_FREQUENCY));
+    }
+
+    can_free(&can);
+}
+
+/* Test that classic frames go through the FD API. */
+void can_fd_classic_frame_test()
+{
+    can_loopback_init();
+
+    CANFD_Message msg = {};
+    msg.id = 0x123;
+    msg.len = 8;
+    for (int i = 0; i < 8; i++) {
+        msg.data[i] = i;
+    }
+    msg.format = CANStandard;
+    msg.type = CANData;
+    msg.flags = CANFDNone;
+
+    CANFD_Message received;
+    can_fd_loopback(&msg, &received);
+
+    TEST_ASSERT_EQUAL_UINT(msg.id, received.id);
+    TEST_ASSERT_EQUAL_UINT8(msg.len, received.len);
+    TEST_ASSERT_EQUAL_UINT8(CANFDNone, received.flags & CANFDFrame);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(msg.data, received.data, msg.len);
+
+    can_free(&can);
+}
+
+/* Test that 64 byte frames are sent with bitrate switch. */
+void can_fd_frame_test()
+{
+    can_loopback_init();
+
+    can_capabilities_t cap;
+    can_get_capabilities(&can, &cap);
+    TEST_SKIP_UNLESS_MESSAGE(cap.fd, "CAN FD not supported");
+
+    int data_hz = cap.max_data_hz < CAN_DATA_FREQUENCY ? cap.max_data_hz : CAN_DATA_FREQUENCY;
+    TEST_ASSERT_EQUAL_INT(1, can_fd_frequency(&can, CAN_FREQUENCY, data_hz));
+
+    CANFD_Message msg = {};
+    msg.id = 0x1ABCDEF;
+    msg.len = CAN_FD_MAX_DATA_LENGTH;
+    for (int i = 0; i < CAN_FD_MAX_DATA_LENGTH; i++) {
+        msg.data[i] = 0xFF - i;
+    }
+    msg.format = CANExtended;
+    msg.type = CANData;
+    msg.flags = CANFDFrame | CANFDBitrateSwitch;
+
+    CANFD_Message received;
+    can_fd_loopback(&msg, &received);
+
+    TEST_ASSERT_EQUAL_UINT(msg.id, received.id);
+    TEST_ASSERT_EQUAL_UINT8(msg.len, received.len);
+    TEST_ASSERT_EQUAL_UINT8(CANFDFrame | CANFDBitrateSwitch, received.flags & (CANFDFrame | CANFDBitrateSwitch));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(msg.data, received.data, msg.len);
+
+    can_free(&can);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("CAN FD DLC conversion test", can_fd_dlc_test),
+    Case("CAN FD capabilities test", can_fd_capabilities_test),
+    Case("CAN FD classic frame test", can_fd_classic_frame_test),
+    Case("CAN FD frame test", can_fd_frame_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CAN || !DEVICE_USTICKER
@@ -0,0 +1,237 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/can_api.h"
+#include "hal/pinmap.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "../can_test_utils.h"
+
+#if !DEVICE_CAN || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define CAN_FREQUENCY 1000000
+#define FRAME_COUNT 500
+#define WRITE_TIMEOUT_US 10000
+#define BURST_COUNT 2
+
+static can_t can;
+static can_rx_buffer_t rx_buffer;
+
+/* Initialize the CAN peripheral in loopback mode. */
+static void can_loopback_init()
+{
+    PinName rd;
+    PinName td;
+    TEST_ASSERT_TRUE(find_can_pins(&rd, &td));
+
+    can_init_freq(&can, rd, td, CAN_FREQUENCY);
+    TEST_ASSERT_EQUAL_INT(1, can_mode(&can, MODE_TEST_LOCAL));
+}
+
+/* Send a data frame with the sequence number as its id, retry while the TX mailboxes are full. */
+static void can_send_frame(unsigned int seq)
+{
+    CAN_Message msg = {};
+    msg.id = seq & 0x7FF;
+    msg.len = 8;
+    msg.data[0] = seq & 0xFF;
+    msg.data[1] = (seq >> 8) & 0xFF;
+    msg.format = CANStandard;
+    msg.type = CANData;
+
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    while (!can_write(&can, msg, 0)) {
+        TEST_ASSERT_TRUE((ticker_read_us(us_ticker) - start) < WRITE_TIMEOUT_US);
+    }
+}
+
+/* Wait until the frames in flight have been looped back. */
+static void can_wait_frames()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    while ((ticker_read_us(us_ticker) - start) < WRITE_TIMEOUT_US);
+}
+
+/* Test that can_read_burst() drains all the frames waiting in the hardware FIFO. */
+void can_read_burst_test()
+{
+    can_loopback_init();
+
+    for (unsigned int i = 0; i < BURST_COUNT; i++) {
+        can_send_frame(i);
+    }
+    can_wait_frames();
+
+    CAN_Message msgs[BURST_COUNT + 1];
+    TEST_ASSERT_EQUAL_INT(BURST_COUNT, can_read_burst(&can, msgs, BURST_COUNT + 1, 0));
+    for (unsigned int i = 0; i < BURST_COUNT; i++) {
+        TEST_ASSERT_EQUAL_UINT(i, msgs[i].id);
+    }
+    TEST_ASSERT_EQUAL_INT(0, can_read_burst(&can, msgs, BURST_COUNT + 1, 0));
+
+    can_free(&can);
+}
+
+/* Test that no frame is lost at full bus load while the buffer is drained. */
+void can_rx_buffer_stress_test()
+{
+    can_loopback_init();
+    can_rx_buffer_init(&rx_buffer, &can, 0, NULL, 0);
+
+    CAN_Message msgs[MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE];
+    unsigned int received = 0;
+    for (unsigned int i = 0; i < FRAME_COUNT; i++) {
+        can_send_frame(i);
+        int count = can_rx_buffer_read(&rx_buffer, msgs, MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE);
+        for (int j = 0; j < count; j++, received++) {
+            TEST_ASSERT_EQUAL_UINT(received & 0x7FF, msgs[j].id);
+        }
+    }
+    can_wait_frames();
+    int count = can_rx_buffer_read(&rx_buffer, msgs, MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE);
+    for (int j = 0; j < count; j++, received++) {
+        TEST_ASSERT_EQUAL_UINT(received & 0x7FF, msgs[j].id);
+    }
+
+    TEST_ASSERT_EQUAL_UINT(FRAME_COUNT, received);
+    TEST_ASSERT_EQUAL_UINT32(0, can_rx_buffer_dropped(&rx_buffer));
+    TEST_ASSERT_EQUAL_UINT32(0, can_rx_buffer_overruns(&rx_buffer));
+
+    can_rx_buffer_free(&rx_buffer);
+    can_free(&can);
+}
+
+/* Test that the frames which do not fit to a full buffer are counted as dropped. */
+void can_rx_buffer_drop_test()
+{
+    can_loopback_init();
+    can_rx_buffer_init(&rx_buffer, &can, 0, NULL, 0);
+
+    const unsigned int frames = MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE * 2;
+    for (unsigned int i = 0; i < frames; i++) {
+        can_send_frame(i);
+    }
+    can_wait_frames();
+
+    TEST_ASSERT_EQUAL_UINT(MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE, can_rx_buffer_count(&rx_buffer));
+    TEST_ASSERT_EQUAL_UINT32(frames - MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE, can_rx_buffer_dropped(&rx_buffer));
+
+    // The oldest frames are kept
+    CAN_Message msg;
+    TEST_ASSERT_EQUAL_INT(1, can_rx_buffer_read(&rx_buffer, &msg, 1));
+    TEST_ASSERT_EQUAL_UINT(0, msg.id);
+
+    can_rx_buffer_free(&rx_buffer);
+    can_free(&can);
+}
+
+/* Test that can_id_ranges_contain() finds the identifiers of single identifier and wider ranges. */
+void can_id_ranges_contain_test()
+{
+    const can_id_range_t ranges[] = { { 5, 5 }, { 10, 20 }, { 100, 100 } };
+    const size_t count = sizeof(ranges) / sizeof(ranges[0]);
+
+    for (uint32_t id = 0; id < 200; id++) {
+        const bool expected = id == 5 || (id >= 10 && id <= 20) || id == 100;
+        TEST_ASSERT_EQUAL(expected, can_id_ranges_contain(ranges, count, id));
+    }
+    TEST_ASSERT_FALSE(can_id_ranges_contain(ranges, 0, 5));
+}
+
+/* Test that only the frames in the filter ranges are buffered, and the others are not counted as dropped. */
+void can_rx_buffer_filter_test()
+{
+    const can_id_range_t ranges[] = { { 3, 3 }, { 8, 11 } };
+
+    can_loopback_init();
+    can_rx_buffer_init(&rx_buffer, &can, 0, NULL, 0);
+    can_rx_buffer_filter(&rx_buffer, ranges, sizeof(ranges) / sizeof(ranges[0]), CANStandard);
+
+    for (unsigned int i = 0; i < 16; i++) {
+        can_send_frame(i);
+    }
+    can_wait_frames();
+
+    CAN_Message msgs[MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE];
+    const unsigned int expected[] = { 3, 8, 9, 10, 11 };
+    TEST_ASSERT_EQUAL_INT(5, can_rx_buffer_read(&rx_buffer, msgs, MBED_CONF_TARGET_CAN_RX_BUFFER_SIZE));
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT(expected[i], msgs[i].id);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, can_rx_buffer_dropped(&rx_buffer));
+
+    can_rx_buffer_free(&rx_buffer);
+    can_free(&can);
+}
+
+/* Test that the buffered frames carry a timestamp of their reception, in microsecond ticker time. */
+void can_rx_buffer_timestamp_test()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+
+    can_loopback_init();
+    can_rx_buffer_init(&rx_buffer, &can, 0, NULL, 0);
+
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    can_send_frame(0);
+    can_wait_frames();
+    const us_timestamp_t end = ticker_read_us(us_ticker);
+
+    CAN_Message msg;
+    TEST_ASSERT_EQUAL_INT(1, can_rx_buffer_read(&rx_buffer, &msg, 1));
+    const uint64_t received = can_timestamp_to_us(&can, msg.timestamp);
+    TEST_ASSERT_TRUE(received >= start);
+    TEST_ASSERT_TRUE(received <= end);
+
+    can_rx_buffer_free(&rx_buffer);
+    can_free(&can);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("CAN read burst test", can_read_burst_test),
+    Case("CAN RX buffer stress test", can_rx_buffer_stress_test),
+    Case("CAN RX buffer drop test", can_rx_buffer_drop_test),
+    Case("CAN ID ranges contain test", can_id_ranges_contain_test),
+    Case("CAN RX buffer filter test", can_rx_buffer_filter_test),
+    Case("CAN RX buffer timestamp test", can_rx_buffer_timestamp_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CAN || !DEVICE_USTICKER
@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup hal_can
+ * @{
+ * @defgroup hal_can_test_util Tests
+ * Helpers of the CAN HAL tests.
+ * @{
+ */
+
+#ifndef MBED_CAN_TEST_UTILS_H
+#define MBED_CAN_TEST_UTILS_H
+
+#include "hal/can_api.h"
+#include "hal/pinmap.h"
+
+#if DEVICE_CAN
+
+/* Find a pair of RD and TD pins of one peripheral. */
+static bool find_can_pins(PinName *rd, PinName *td)
+{
+    for (const PinMap *rd_map = can_rd_pinmap(); rd_map->pin != NC; rd_map++) {
+        for (const PinMap *td_map = can_td_pinmap(); td_map->pin != NC; td_map++) {
+            if (rd_map->peripheral == td_map->peripheral) {
+                *rd = rd_map->pin;
+                *td = td_map->pin;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#endif // DEVICE_CAN
+
+#endif
+
+/** @}*/
+/** @}*/
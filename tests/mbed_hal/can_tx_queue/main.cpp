@@ -0,0 +1,173 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/can_api.h"
+#include "hal/pinmap.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "../can_test_utils.h"
+
+#if !DEVICE_CAN || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define CAN_FREQUENCY 1000000
+#define SEND_TIMEOUT_US 20000
+
+// Frames queued behind the ones that found a free mailbox on submission
+#define QUEUED_COUNT (MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE / 2)
+
+static can_t can;
+static can_tx_queue_t tx_queue;
+static can_rx_buffer_t rx_buffer;
+
+/* Initialize the CAN peripheral in loopback mode, with the TX queue and the RX buffer. */
+static void can_loopback_init()
+{
+    PinName rd;
+    PinName td;
+    TEST_ASSERT_TRUE(find_can_pins(&rd, &td));
+
+    can_init_freq(&can, rd, td, CAN_FREQUENCY);
+    TEST_ASSERT_EQUAL_INT(1, can_mode(&can, MODE_TEST_LOCAL));
+
+    can_tx_queue_init(&tx_queue, &can, NULL, 0);
+    can_rx_buffer_init(&rx_buffer, &can, 0, can_tx_queue_irq, (uint32_t)&tx_queue);
+}
+
+static void can_loopback_free()
+{
+    can_rx_buffer_free(&rx_buffer);
+    can_tx_queue_free(&tx_queue);
+    can_free(&can);
+}
+
+static CAN_Message can_frame(unsigned int id, CANFormat format)
+{
+    CAN_Message msg = {};
+    msg.id = id;
+    msg.len = 8;
+    msg.format = format;
+    msg.type = CANData;
+    return msg;
+}
+
+/* Wait until the queue is empty and the frames in flight have been looped back. */
+static void can_wait_sent()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    while (can_tx_queue_count(&tx_queue) != 0) {
+        TEST_ASSERT_TRUE((ticker_read_us(us_ticker) - start) < SEND_TIMEOUT_US);
+    }
+    while ((ticker_read_us(us_ticker) - start) < SEND_TIMEOUT_US);
+}
+
+/* Test that the queued frames are sent lowest identifier first, whatever the submission order. */
+void can_tx_queue_priority_test()
+{
+    can_loopback_init();
+
+    for (unsigned int id = MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE; id > 0; id--) {
+        const CAN_Message msg = can_frame(id, CANStandard);
+        TEST_ASSERT_EQUAL_INT(1, can_tx_queue_write(&tx_queue, &msg));
+    }
+    can_wait_sent();
+
+    CAN_Message msgs[MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE];
+    TEST_ASSERT_EQUAL_INT(MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE, can_rx_buffer_read(&rx_buffer, msgs, MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE));
+
+    // The last frames submitted waited in the queue, and overtook the others
+    unsigned int expected = 1;
+    for (int i = 0; i < MBED_CONF_TARGET_CAN_TX_QUEUE_SIZE && expected <= QUEUED_COUNT; i++) {
+        if (msgs[i].id <= QUEUED_COUNT) {
+            TEST_ASSERT_EQUAL_UINT(expected, msgs[i].id);
+            expected++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT(QUEUED_COUNT + 1, expected);
+
+    can_loopback_free();
+}
+
+/* Test that frames of equal identifiers keep their order, and standard frames precede extended frames of the same base identifier. */
+void can_tx_queue_order_test()
+{
+    can_loopback_init();
+
+    // Keep the mailboxes busy so that the frames below are queued
+    for (unsigned int i = 0; i < QUEUED_COUNT; i++) {
+        const CAN_Message msg = can_frame(0x7FF, CANStandard);
+        TEST_ASSERT_EQUAL_INT(1, can_tx_queue_write(&tx_queue, &msg));
+    }
+
+    CAN_Message msg = can_frame(0x100 << 18, CANExtended);
+    TEST_ASSERT_EQUAL_INT(1, can_tx_queue_write(&tx_queue, &msg));
+    for (unsigned int i = 0; i < 2; i++) {
+        msg = can_frame(0x100, CANStandard);
+        msg.data[0] = i;
+        TEST_ASSERT_EQUAL_INT(1, can_tx_queue_write(&tx_queue, &msg));
+    }
+    can_wait_sent();
+
+    CAN_Message msgs[QUEUED_COUNT + 3];
+    TEST_ASSERT_EQUAL_INT(QUEUED_COUNT + 3, can_rx_buffer_read(&rx_buffer, msgs, QUEUED_COUNT + 3));
+
+    int found = 0;
+    for (int i = 0; i < QUEUED_COUNT + 3; i++) {
+        if (msgs[i].id == 0x7FF) {
+            continue;
+        }
+        if (found < 2) {
+            TEST_ASSERT_EQUAL(CANStandard, msgs[i].format);
+            TEST_ASSERT_EQUAL_UINT8(found, msgs[i].data[0]);
+        } else {
+            TEST_ASSERT_EQUAL(CANExtended, msgs[i].format);
+        }
+        found++;
+    }
+    TEST_ASSERT_EQUAL_INT(3, found);
+
+    can_loopback_free();
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("CAN TX queue priority test", can_tx_queue_priority_test),
+    Case("CAN TX queue order test", can_tx_queue_order_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CAN || !DEVICE_USTICKER
@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/checksum_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <string.h>
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 1200
+
+static uint8_t buffer[BUFFER_SIZE + 4];
+
+/* Checksum a byte at a time, of network order halfwords */
+static uint16_t reference_checksum(const uint8_t *data, size_t size)
+{
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < size; i += 2) {
+        sum += ((uint32_t)data[i] << 8) | (i + 1 < size ? data[i + 1] : 0);
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    const uint16_t checksum = ~sum & 0xFFFF;
+    return (uint16_t)((checksum >> 8) | (checksum << 8));
+}
+
+/* Test the example of RFC 1071, and that a checksum over data with its
+ * checksum is 0. */
+void checksum_rfc1071_test()
+{
+    uint8_t data[] = { 0x00, 0x01, 0xF2, 0x03, 0xF4, 0xF5, 0xF6, 0xF7, 0x00, 0x00 };
+
+    const uint16_t checksum = hal_inet_checksum(data, 8);
+    TEST_ASSERT_EQUAL_UINT8(0x22, ((uint8_t *)&checksum)[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x0D, ((uint8_t *)&checksum)[1]);
+
+    memcpy(&data[8], &checksum, sizeof(checksum));
+    TEST_ASSERT_EQUAL_UINT16(0, hal_inet_checksum(data, sizeof(data)));
+}
+
+/* Test every alignment and sizes around the word and block boundaries,
+ * with all bytes set so that the accumulators are the closest to overflowing. */
+void checksum_alignment_test()
+{
+    for (int fill = 0; fill < 2; fill++) {
+        for (size_t i = 0; i < sizeof(buffer); i++) {
+            buffer[i] = fill ? 0xFF : (uint8_t)(i * 7 + 3);
+        }
+        for (size_t offset = 0; offset < 4; offset++) {
+            for (size_t size = 0; size <= BUFFER_SIZE; size += (size < 16 ? 1 : 61)) {
+                TEST_ASSERT_EQUAL_UINT16(reference_checksum(&buffer[offset], size), hal_inet_checksum(&buffer[offset], size));
+            }
+        }
+    }
+}
+
+/* Test that a checksum computed over several buffers matches the one of
+ * the whole data. */
+void checksum_chained_test()
+{
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(i * 13 + 1);
+    }
+
+    uint32_t sum = hal_inet_checksum_add(0, &buffer[1], 12);
+    sum = hal_inet_checksum_add(sum, &buffer[13], 100);
+    sum = hal_inet_checksum_add(sum, &buffer[113], 1001);
+    TEST_ASSERT_EQUAL_UINT16(reference_checksum(&buffer[1], 1113), hal_inet_checksum_finish(sum));
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("checksum RFC 1071 test", checksum_rfc1071_test),
+    Case("checksum alignment test", checksum_alignment_test),
+    Case("checksum chained test", checksum_chained_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/clock_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <string.h>
+
+#if !DEVICE_CLOCK_SCALING || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define DELAY_US 100000
+
+static uint32_t initial_frequency;
+static char calls[8];
+static volatile size_t call_count;
+static uint32_t post_change_frequency;
+
+static void notifier_handler(uint32_t id, hal_clock_event_t event)
+{
+    if (call_count < sizeof(calls) - 1) {
+        calls[call_count++] = (char)((event == HAL_CLOCK_PRE_CHANGE ? 'a' : 'A') + id);
+    }
+    if (event == HAL_CLOCK_POST_CHANGE) {
+        post_change_frequency = SystemCoreClock;
+    }
+}
+
+/* A quarter of the initial frequency, which a target able to scale its clocks is expected to support. */
+static uint32_t low_frequency()
+{
+    return initial_frequency / 4;
+}
+
+/* Test that the notifiers are called in order before and after a change, and not once removed. */
+void clock_notifier_test()
+{
+    hal_clock_notifier_t notifiers[3];
+
+    for (uint32_t i = 0; i < 3; i++) {
+        hal_clock_notifier_add(&notifiers[i], notifier_handler, i);
+    }
+    hal_clock_notifier_remove(&notifiers[1]);
+
+    memset(calls, 0, sizeof(calls));
+    call_count = 0;
+    TEST_ASSERT_EQUAL_INT(0, hal_clock_set_core_frequency(low_frequency()));
+    TEST_ASSERT_EQUAL_STRING("acAC", calls);
+    TEST_ASSERT_EQUAL_UINT32(low_frequency(), post_change_frequency);
+
+    hal_clock_notifier_remove(&notifiers[0]);
+    memset(calls, 0, sizeof(calls));
+    call_count = 0;
+    TEST_ASSERT_EQUAL_INT(0, hal_clock_set_core_frequency(initial_frequency));
+    TEST_ASSERT_EQUAL_STRING("cC", calls);
+    TEST_ASSERT_EQUAL_UINT32(initial_frequency, post_change_frequency);
+
+    hal_clock_notifier_remove(&notifiers[2]);
+}
+
+/* Test that a frequency the target can't run at is rejected, leaving the clocks unchanged. */
+void clock_invalid_frequency_test()
+{
+    TEST_ASSERT_EQUAL_INT(-1, hal_clock_set_core_frequency(UINT32_MAX));
+    TEST_ASSERT_EQUAL_UINT32(initial_frequency, SystemCoreClock);
+}
+
+/* Test that the us ticker keeps time across changes, against the lp ticker when there is one. */
+void clock_ticker_test()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const uint32_t frequencies[] = { low_frequency(), initial_frequency };
+
+    for (uint32_t frequency : frequencies) {
+#if DEVICE_LPTICKER
+        const ticker_data_t *lp_ticker = get_lp_ticker_data();
+        const us_timestamp_t lp_start = ticker_read_us(lp_ticker);
+#endif
+        const us_timestamp_t start = ticker_read_us(us_ticker);
+        TEST_ASSERT_EQUAL_INT(0, hal_clock_set_core_frequency(frequency));
+        while (ticker_read_us(us_ticker) - start < DELAY_US);
+        const us_timestamp_t elapsed = ticker_read_us(us_ticker) - start;
+
+        TEST_ASSERT_UINT64_WITHIN(DELAY_US / 20, DELAY_US, elapsed);
+#if DEVICE_LPTICKER
+        const us_timestamp_t lp_elapsed = ticker_read_us(lp_ticker) - lp_start;
+        TEST_ASSERT_UINT64_WITHIN(DELAY_US / 20, lp_elapsed, elapsed);
+#endif
+    }
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    initial_frequency = SystemCoreClock;
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Clock notifier test", clock_notifier_test),
+    Case("Clock invalid frequency test", clock_invalid_frequency_test),
+    Case("Clock us ticker test", clock_ticker_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CLOCK_SCALING || !DEVICE_USTICKER
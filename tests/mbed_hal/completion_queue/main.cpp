@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/completion_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+#define ROUNDS 3
+
+/* Test that completions are popped in the order they were posted, and the
+ * positions wrap around the storage. */
+void completion_queue_order_test()
+{
+    static hal_completion_queue_t queue;
+    hal_completion_t completion;
+    uint32_t next_post = 0;
+    uint32_t next_pop = 0;
+
+    hal_completion_queue_init(&queue);
+    for (int round = 0; round < ROUNDS; round++) {
+        TEST_ASSERT_FALSE(hal_completion_pop(&queue, &completion));
+
+        for (int i = 0; i < MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE; i++) {
+            TEST_ASSERT_TRUE(hal_completion_post(&queue, HAL_COMPLETION_USER, next_post, next_post * 2));
+            next_post++;
+        }
+
+        while (hal_completion_pop(&queue, &completion)) {
+            TEST_ASSERT_EQUAL_UINT32(next_pop, completion.id);
+            TEST_ASSERT_EQUAL_UINT32(next_pop * 2, completion.events);
+            TEST_ASSERT_EQUAL_UINT8(HAL_COMPLETION_USER, completion.source);
+            next_pop++;
+        }
+        TEST_ASSERT_EQUAL_UINT32(next_post, next_pop);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, hal_completion_dropped(&queue));
+}
+
+/* Test that a full queue drops and counts the completions, and that draining
+ * stops at the size of the array. */
+void completion_queue_drain_test()
+{
+    static hal_completion_queue_t queue;
+    hal_completion_t completions[MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE];
+
+    hal_completion_queue_init(&queue);
+    for (int i = 0; i < MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(hal_completion_post(&queue, HAL_COMPLETION_USER, i, 0));
+    }
+    TEST_ASSERT_FALSE(hal_completion_post(&queue, HAL_COMPLETION_USER, 0, 0));
+    TEST_ASSERT_FALSE(hal_completion_post(&queue, HAL_COMPLETION_USER, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, hal_completion_dropped(&queue));
+
+    TEST_ASSERT_EQUAL_UINT(2, hal_completion_drain(&queue, completions, 2));
+    TEST_ASSERT_EQUAL_UINT32(1, completions[1].id);
+
+    const size_t count = hal_completion_drain(&queue, completions, MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE);
+    TEST_ASSERT_EQUAL_UINT(MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE - 2, count);
+    TEST_ASSERT_EQUAL_UINT32(2, completions[0].id);
+    TEST_ASSERT_EQUAL_UINT(0, hal_completion_drain(&queue, completions, MBED_CONF_TARGET_COMPLETION_QUEUE_SIZE));
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("completion queue order test", completion_queue_order_test),
+    Case("completion queue drain test", completion_queue_drain_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
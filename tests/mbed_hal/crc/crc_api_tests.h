@@ -92,6 +92,34 @@ void crc_reconfigure_test();
  */
 void crc_compute_partial_invalid_param_test();
 
+/** Test that computations in different contexts can be interleaved.
+ *
+ *  Given is platform with hardware CRC support.
+ *  When data is appended alternately to two contexts with different configurations,
+ *  synchronously and asynchronously.
+ *  Then hal_crc_ctx_get_result() returns the expected CRC value for each context.
+ *
+ */
+void crc_ctx_interleave_test();
+
+/** Test that the software CRC engine gives the expected result with every table size.
+ *
+ *  Given is a table built for each configuration with nibble, byte, slice-by-4 and slice-by-8 sizes.
+ *  When data is appended in several calls.
+ *  Then crc_sw_ctx_get_result() returns the expected CRC value.
+ *
+ */
+void crc_sw_calc_test();
+
+/** Test the throughput of the software CRC engine against the CRC module.
+ *
+ *  Given is a 4 KB buffer and the CRC-32 configuration.
+ *  When the CRC is computed in hardware, if supported, and with each software table size.
+ *  Then the time taken is reported and all results match.
+ *
+ */
+void crc_sw_benchmark_test();
+
 /** Test that hal_crc_is_supported() returns false if pointer to the config structure is undefined.
  *
  *  Given is platform with hardware CRC support.
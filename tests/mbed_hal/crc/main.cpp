@@ -22,6 +22,8 @@
 #include "greentea-custom_io/custom_io.h"
 #include "math.h"
 #include "crc_api.h"
+#include "crc_sw_api.h"
+#include "hal/us_ticker_api.h"
 
 #if !DEVICE_CRC
 #error [NOT_SUPPORTED] CRC not supported for this target
@@ -252,12 +254,121 @@ void crc_compute_partial_invalid_param_test()
     }
 }
 
+static void crc_ctx_async_handler(uint32_t id)
+{
+    (*(uint32_t *)id)++;
+}
+
+/* Test that computations in different contexts can be interleaved. */
+void crc_ctx_interleave_test()
+{
+    const size_t count = sizeof(test_cases) / sizeof(TEST_CASE);
+    const size_t length = strlen((const char *) input_data);
+
+    for (unsigned int i = 0; i < count; i++) {
+        const unsigned int j = (i + count / 2) % count;
+        if (!HAL_CRC_IS_SUPPORTED(test_cases[i].config_data.polynomial, test_cases[i].config_data.width) ||
+                !HAL_CRC_IS_SUPPORTED(test_cases[j].config_data.polynomial, test_cases[j].config_data.width)) {
+            continue;
+        }
+
+        hal_crc_ctx_t ctx_a;
+        hal_crc_ctx_t ctx_b;
+        hal_crc_ctx_start(&ctx_a, &test_cases[i].config_data);
+        hal_crc_ctx_start(&ctx_b, &test_cases[j].config_data);
+
+        /* Feed both contexts alternately, one byte at a time for the first one. */
+        for (size_t k = 0; k < length; k++) {
+            hal_crc_ctx_update(&ctx_a, input_data + k, 1);
+            if (k == 3) {
+                hal_crc_ctx_update(&ctx_b, input_data, 4);
+            }
+        }
+
+        volatile uint32_t calls = 0;
+        int ret = hal_crc_ctx_update_async(&ctx_b, input_data + 4, length - 4, crc_ctx_async_handler, (uint32_t) &calls);
+        TEST_ASSERT_EQUAL(0, ret);
+        while (calls == 0);
+        TEST_ASSERT_EQUAL(1, calls);
+
+        TEST_ASSERT_EQUAL(test_cases[i].expected_result, hal_crc_ctx_get_result(&ctx_a));
+        TEST_ASSERT_EQUAL(test_cases[j].expected_result, hal_crc_ctx_get_result(&ctx_b));
+    }
+}
+
+static const uint32_t sw_slices[] = { 0, 1, 4, 8 };
+
+static uint32_t sw_table[CRC_SW_TABLE_ENTRIES(8)];
+
+/* Test that every software table size gives the expected result, whether or not
+ * the polynomial is supported in hardware. */
+void crc_sw_calc_test()
+{
+    const size_t length = strlen((const char *) input_data);
+
+    for (unsigned int i = 0; i < (sizeof(test_cases) / sizeof(TEST_CASE)); i++) {
+        for (unsigned int m = 0; m < (sizeof(sw_slices) / sizeof(sw_slices[0])); m++) {
+            TEST_ASSERT_EQUAL(0, crc_sw_table_init(sw_table, sw_slices[m], &test_cases[i].config_data));
+
+            crc_sw_ctx_t ctx;
+            crc_sw_ctx_start(&ctx, &test_cases[i].config_data, sw_table, sw_slices[m]);
+            crc_sw_ctx_update(&ctx, input_data, 3);
+            crc_sw_ctx_update(&ctx, input_data + 3, length - 3);
+
+            TEST_ASSERT_EQUAL(test_cases[i].expected_result, crc_sw_ctx_get_result(&ctx));
+        }
+    }
+}
+
+#define BENCHMARK_SIZE 4096
+
+/* Compare the throughput of the software engine with the CRC module. */
+void crc_sw_benchmark_test()
+{
+    static uint8_t buffer[BENCHMARK_SIZE];
+    const crc_mbed_config_t config = {POLY_32BIT_ANSI, 32, 0xFFFFFFFF, 0xFFFFFFFF, true, true};
+    const ticker_data_t *const ticker = get_us_ticker_data();
+
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t) i;
+    }
+
+    uint32_t hw_crc = 0;
+    if (HAL_CRC_IS_SUPPORTED(config.polynomial, config.width)) {
+        const uint32_t start = ticker_read(ticker);
+        hal_crc_compute_partial_start(&config);
+        hal_crc_compute_partial(buffer, sizeof(buffer));
+        hw_crc = hal_crc_get_result();
+        const uint32_t elapsed = ticker_read(ticker) - start;
+        utest_printf("hardware: %lu us\r\n", elapsed);
+    }
+
+    for (unsigned int m = 0; m < (sizeof(sw_slices) / sizeof(sw_slices[0])); m++) {
+        TEST_ASSERT_EQUAL(0, crc_sw_table_init(sw_table, sw_slices[m], &config));
+
+        crc_sw_ctx_t ctx;
+        const uint32_t start = ticker_read(ticker);
+        crc_sw_ctx_start(&ctx, &config, sw_table, sw_slices[m]);
+        crc_sw_ctx_update(&ctx, buffer, sizeof(buffer));
+        const uint32_t sw_crc = crc_sw_ctx_get_result(&ctx);
+        const uint32_t elapsed = ticker_read(ticker) - start;
+        utest_printf("software, %lu slices: %lu us\r\n", sw_slices[m], elapsed);
+
+        if (HAL_CRC_IS_SUPPORTED(config.polynomial, config.width)) {
+            TEST_ASSERT_EQUAL(hw_crc, sw_crc);
+        }
+    }
+}
+
 Case cases[] = {
     Case("test: supported polynomials.", crc_is_supported_test),
     Case("test: CRC calculation - single input.", crc_calc_single_test),
     Case("test: CRC calculation - multi input.", crc_calc_multi_test),
     Case("test: re-configure without getting the result.", crc_reconfigure_test),
     Case("test: hal_crc_compute_partial() - invalid parameters.", crc_compute_partial_invalid_param_test),
+    Case("test: interleaved computations in contexts.", crc_ctx_interleave_test),
+    Case("test: software CRC calculation.", crc_sw_calc_test),
+    Case("test: software CRC benchmark.", crc_sw_benchmark_test),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
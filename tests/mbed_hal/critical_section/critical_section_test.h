@@ -48,6 +48,34 @@
 template <int N>
 void test_critical_section();
 
+/** Test critical section with a priority mask
+ *
+ * Given MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY set on an ARMv7-M or ARMv8-M mainline core
+ * When inside critical section
+ * Then BASEPRI masks the configured priority and PRIMASK is clear
+ * When BASEPRI already masks a higher priority before entering
+ * Then it is kept inside and after the critical section
+ */
+void test_critical_section_priority();
+
+/** Test sleep in critical section
+ *
+ * Given a critical section
+ * When hal_critical_section_sleep() calls the sleep function
+ * Then all interrupts are masked by PRIMASK, and none by BASEPRI
+ * When it returns
+ * Then the critical section masks are restored
+ */
+void test_critical_section_sleep();
+
+/** Test critical section statistics
+ *
+ * Given MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+ * When a critical section keeps interrupts masked for a known number of cycles
+ * Then the longest section recorded lasts at least that long and has a caller
+ */
+void test_critical_section_stats();
+
 /**@}*/
 /**@}*/
 
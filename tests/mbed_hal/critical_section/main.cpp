@@ -21,15 +21,27 @@
 #include "greentea-client/test_env.h"
 #include "mbed.h"
 #include "cmsis.h"
+#include "bootstrap/mbed_atomic.h"
+#include "bootstrap/mbed_critical.h"
+#include "hal/cycle_counter_api.h"
 #if defined(TARGET_NRF5x) // for all NRF5x targets
 #include "nrf_nvic.h" // for __NRF_NVIC_APP_IRQS_0 / __NRF_NVIC_APP_IRQS_1
 #endif
 
 using utest::v1::Case;
 
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY && \
+    ((__ARM_ARCH_7M__ == 1U) || (__ARM_ARCH_7EM__ == 1U) || \
+     (__ARM_ARCH_8M_MAIN__ == 1U) || (__ARM_ARCH_8_1M_MAIN__ == 1U))
+#define TEST_CRITICAL_SECTION_BASEPRI \
+    ((uint32_t)MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY << (8U - __NVIC_PRIO_BITS))
+#endif
+
 bool test_are_interrupts_enabled(void)
 {
-#if defined(__CORTEX_A9)
+#if defined(TEST_CRITICAL_SECTION_BASEPRI)
+    return (__get_BASEPRI() == 0);
+#elif defined(__CORTEX_A9)
     return ((__get_CPSR() & 0x80) == 0);
 #else
     return ((__get_PRIMASK() & 0x1) == 0);
@@ -57,9 +69,131 @@ void test_critical_section()
     TEST_ASSERT_TRUE(test_are_interrupts_enabled());
 }
 
+#if defined(TEST_CRITICAL_SECTION_BASEPRI)
+void test_critical_section_priority()
+{
+    hal_critical_section_enter();
+    TEST_ASSERT_EQUAL_UINT32(TEST_CRITICAL_SECTION_BASEPRI, __get_BASEPRI());
+    // Interrupts of higher priorities are still enabled
+    TEST_ASSERT_EQUAL_UINT32(0, __get_PRIMASK());
+
+    hal_critical_section_exit();
+    TEST_ASSERT_EQUAL_UINT32(0, __get_BASEPRI());
+
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY > 1
+    // A mask of higher priority set before entering is kept
+    const uint32_t higher_basepri = (uint32_t)(MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY - 1) << (8U - __NVIC_PRIO_BITS);
+    __set_BASEPRI(higher_basepri);
+    hal_critical_section_enter();
+    TEST_ASSERT_EQUAL_UINT32(higher_basepri, __get_BASEPRI());
+    hal_critical_section_exit();
+    TEST_ASSERT_EQUAL_UINT32(higher_basepri, __get_BASEPRI());
+    __set_BASEPRI(0);
+#endif
+}
+#endif
+
+static bool sleep_called;
+static bool sleep_primask;
+static bool sleep_interrupts_enabled;
+
+// Records the masks instead of sleeping
+static void test_sleep(void)
+{
+    sleep_called = true;
+#if defined(__CORTEX_A9)
+    sleep_primask = (__get_CPSR() & 0x80) != 0;
+#else
+    sleep_primask = (__get_PRIMASK() & 0x1) != 0;
+#endif
+    sleep_interrupts_enabled = test_are_interrupts_enabled();
+}
+
+void test_critical_section_sleep()
+{
+    sleep_called = false;
+
+    hal_critical_section_enter();
+    hal_critical_section_sleep(test_sleep);
+    TEST_ASSERT_TRUE(hal_in_critical_section());
+    TEST_ASSERT_FALSE(test_are_interrupts_enabled());
+#if defined(TEST_CRITICAL_SECTION_BASEPRI)
+    TEST_ASSERT_EQUAL_UINT32(TEST_CRITICAL_SECTION_BASEPRI, __get_BASEPRI());
+    TEST_ASSERT_EQUAL_UINT32(0, __get_PRIMASK());
+#endif
+    hal_critical_section_exit();
+
+    TEST_ASSERT_TRUE(sleep_called);
+    // All interrupts masked, and none of them masked by BASEPRI, so any wakes WFI
+    TEST_ASSERT_TRUE(sleep_primask);
+#if defined(TEST_CRITICAL_SECTION_BASEPRI)
+    TEST_ASSERT_TRUE(sleep_interrupts_enabled);
+#endif
+    TEST_ASSERT_TRUE(test_are_interrupts_enabled());
+}
+
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+#define BUSY_CYCLES 10000
+
+void test_critical_section_stats()
+{
+    mbed_critical_section_stats_t stats;
+
+    mbed_critical_section_stats_reset();
+    mbed_critical_section_stats_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+
+    core_util_critical_section_enter();
+    const uint32_t start = hal_cycle_counter_read();
+    while (hal_cycle_counter_read() - start < BUSY_CYCLES);
+    core_util_critical_section_exit();
+
+    // Interrupt handlers may have entered critical sections too
+    mbed_critical_section_stats_get(&stats);
+    TEST_ASSERT_TRUE(stats.count >= 1);
+    TEST_ASSERT_TRUE(stats.max_cycles >= BUSY_CYCLES);
+    TEST_ASSERT_NOT_NULL(stats.max_caller);
+
+    uint32_t total = 0;
+    for (int i = 0; i < MBED_CRITICAL_SECTION_STATS_BUCKETS; i++) {
+        total += stats.histogram[i];
+    }
+    TEST_ASSERT_EQUAL_UINT32(stats.count, total);
+}
+#endif
+
+/* On a single core, the spinlock is held until released, along with the
+ * critical section. */
+void test_spinlock()
+{
+    static core_util_spinlock_t lock = CORE_UTIL_SPINLOCK_INIT;
+
+    core_util_spin_lock(&lock);
+    TEST_ASSERT_TRUE(core_util_in_critical_section());
+    core_util_spin_unlock(&lock);
+    TEST_ASSERT_FALSE(core_util_in_critical_section());
+
+    TEST_ASSERT_TRUE(core_util_spin_trylock(&lock));
+#if MBED_EXCLUSIVE_ACCESS
+    TEST_ASSERT_FALSE(core_util_spin_trylock(&lock));
+    // A failed attempt leaves the critical section of the holder
+    TEST_ASSERT_TRUE(core_util_in_critical_section());
+#endif
+    core_util_spin_unlock(&lock);
+    TEST_ASSERT_FALSE(core_util_in_critical_section());
+}
+
 Case cases[] = {
     Case("Test critical section single lock", test_critical_section<1>),
-    Case("Test critical section nested lock", test_critical_section<10>)
+    Case("Test critical section nested lock", test_critical_section<10>),
+    Case("Test spinlock", test_spinlock),
+    Case("Test sleep in critical section", test_critical_section_sleep),
+#if defined(TEST_CRITICAL_SECTION_BASEPRI)
+    Case("Test critical section priority mask", test_critical_section_priority),
+#endif
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_STATS_ENABLED
+    Case("Test critical section statistics", test_critical_section_stats),
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -0,0 +1,173 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/cycle_counter_api.h"
+#include "hal/us_ticker_api.h"
+#include "mbed_boot_profile.h"
+#include "mbed_irq_profile.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !DEVICE_CYCLE_COUNTER || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define DELAY_US 10000
+
+/* Test that the counter increments while the core is running. */
+void cycle_counter_increment_test()
+{
+    hal_cycle_counter_init();
+
+    const uint32_t start = hal_cycle_counter_read();
+    for (volatile int i = 0; i < 100; i++) {
+    }
+    const uint32_t end = hal_cycle_counter_read();
+
+    TEST_ASSERT_TRUE((end - start) >= 100);
+}
+
+/* Test that calling init again does not reset the counter. */
+void cycle_counter_reinit_test()
+{
+    hal_cycle_counter_init();
+    const uint32_t start = hal_cycle_counter_read();
+
+    hal_cycle_counter_init();
+    const uint32_t end = hal_cycle_counter_read();
+
+    TEST_ASSERT_TRUE((end - start) < (SystemCoreClock / 1000));
+}
+
+/* Test that the counter runs at SystemCoreClock against the us ticker. */
+void cycle_counter_frequency_test()
+{
+    hal_cycle_counter_init();
+
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t us_start = ticker_read_us(us_ticker);
+    const uint32_t start = hal_cycle_counter_read();
+
+    while ((ticker_read_us(us_ticker) - us_start) < DELAY_US);
+
+    const uint32_t cycles = hal_cycle_counter_read() - start;
+    const uint32_t expected = (uint64_t) SystemCoreClock * DELAY_US / 1000000;
+
+    TEST_ASSERT_UINT32_WITHIN(expected / 10, expected, cycles);
+}
+
+#if MBED_CONF_TARGET_CUSTOM_TICKERS
+/* Test that the cycle counter ticker is widened and converted to us. */
+void cycle_counter_ticker_read_test()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const ticker_data_t *cycle_ticker = get_cycle_counter_ticker_data();
+
+    const us_timestamp_t cycle_start = ticker_read_us(cycle_ticker);
+    const us_timestamp_t us_start = ticker_read_us(us_ticker);
+
+    while ((ticker_read_us(us_ticker) - us_start) < DELAY_US);
+
+    const us_timestamp_t elapsed = ticker_read_us(cycle_ticker) - cycle_start;
+
+    TEST_ASSERT_UINT64_WITHIN(DELAY_US / 10, DELAY_US, elapsed);
+}
+#endif
+
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED
+/* Test that the boot stages are stamped in boot order. */
+void cycle_counter_boot_profile_test()
+{
+    uint32_t previous = 0;
+    for (int stage = MBED_BOOT_STAGE_RESET; stage < MBED_BOOT_STAGE_COUNT; stage++) {
+        const uint32_t cycles = mbed_boot_profile_cycles((mbed_boot_stage_t)stage);
+        printf("boot stage %d: %lu cycles\r\n", stage, (unsigned long)cycles);
+        TEST_ASSERT_TRUE(cycles >= previous);
+        previous = cycles;
+    }
+    TEST_ASSERT_TRUE(mbed_boot_profile_cycles(MBED_BOOT_STAGE_MAIN) > 0);
+    TEST_ASSERT_TRUE(hal_cycle_counter_read() > mbed_boot_profile_cycles(MBED_BOOT_STAGE_MAIN));
+}
+#endif
+
+#if MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED && defined(NVIC_RAM_VECTOR_ADDRESS)
+/* Test that the interrupt of a us ticker event is profiled. */
+void cycle_counter_irq_profile_test()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    ticker_event_t event;
+    mbed_irq_profile_t profile;
+
+    mbed_irq_profile_start();
+    mbed_irq_profile_reset();
+
+    const us_timestamp_t us_start = ticker_read_us(us_ticker);
+    ticker_insert_event_us(us_ticker, &event, us_start + DELAY_US / 2, 0);
+    while ((ticker_read_us(us_ticker) - us_start) < DELAY_US);
+    ticker_remove_event(us_ticker, &event);
+
+    mbed_irq_profile_stop();
+
+    uint32_t count = 0;
+    for (int irq = 0; irq < NVIC_NUM_VECTORS - NVIC_USER_IRQ_OFFSET; irq++) {
+        mbed_irq_profile_get((IRQn_Type)irq, &profile);
+        if (profile.count) {
+            printf("IRQ %d: %lu calls, %lu cycles max\r\n", irq,
+                   (unsigned long)profile.count, (unsigned long)profile.max_cycles);
+            TEST_ASSERT_TRUE(profile.max_cycles > 0);
+            TEST_ASSERT_TRUE(profile.total_cycles >= profile.max_cycles);
+        }
+        count += profile.count;
+    }
+    TEST_ASSERT_TRUE(count > 0);
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("cycle counter increment test", cycle_counter_increment_test),
+    Case("cycle counter re-init test", cycle_counter_reinit_test),
+    Case("cycle counter frequency test", cycle_counter_frequency_test),
+#if MBED_CONF_TARGET_CUSTOM_TICKERS
+    Case("cycle counter ticker read test", cycle_counter_ticker_read_test),
+#endif
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED
+    Case("cycle counter boot profile test", cycle_counter_boot_profile_test),
+#endif
+#if MBED_CONF_PLATFORM_IRQ_PROFILE_ENABLED && defined(NVIC_RAM_VECTOR_ADDRESS)
+    Case("cycle counter IRQ profile test", cycle_counter_irq_profile_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_CYCLE_COUNTER || !DEVICE_USTICKER
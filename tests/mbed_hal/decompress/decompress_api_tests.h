@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_decompress_tests */
+/** @{*/
+
+#ifndef DECOMPRESS_API_TESTS_H
+#define DECOMPRESS_API_TESTS_H
+
+#include "device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that compressed data is decompressed into memory.
+ *
+ *  Given is data with short and long literals and copies, compressed by pithy at each level.
+ *  When it is decompressed with hal_decompress().
+ *  Then the data given to the compressor is output.
+ */
+void decompress_test();
+
+/** Test that compressed data is decompressed into flash.
+ *
+ *  Given is data with copies reaching further back than the output buffer, compressed by pithy.
+ *  When it is decompressed into the last sectors of the flash with hal_decompress_to_flash().
+ *  Then the data given to the compressor is programmed, and the last page padded with the erase value.
+ */
+void decompress_to_flash_test();
+
+/** Test that invalid data is rejected.
+ *
+ *  Given is compressed data which is truncated, corrupted or larger than the output.
+ *  When it is decompressed.
+ *  Then -1 is returned.
+ */
+void decompress_invalid_test();
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/**@}*/
@@ -0,0 +1,254 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "decompress_api.h"
+#include "decompress_api_tests.h"
+#include "pithy.h"
+
+using namespace utest::v1;
+
+#define DATA_SIZE 6000
+#define COMPRESSED_SIZE 8192
+/* Small enough for the hash table pithy_Compress() allocates on the stack */
+#define PITHY_DATA_SIZE 256
+/* Offset of the flash test copies, further back than the output buffer */
+#define FAR_OFFSET (MBED_CONF_TARGET_DECOMPRESS_BUFFER_SIZE + 476)
+
+static uint8_t data[DATA_SIZE];
+static uint8_t compressed[COMPRESSED_SIZE];
+static uint8_t output[DATA_SIZE];
+
+/* Writer of compressed data, which builds the expected output alongside. */
+typedef struct {
+    uint8_t *out;
+    size_t size;
+} writer_t;
+
+static void put_le(writer_t *writer, uint32_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; i++) {
+        *writer->out++ = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void start_stream(writer_t *writer, uint32_t length)
+{
+    writer->out = compressed;
+    writer->size = 0;
+    do {
+        *writer->out++ = (uint8_t)((length & 0x7F) | (length > 0x7F ? 0x80 : 0));
+        length >>= 7;
+    } while (length > 0);
+}
+
+static void put_literal(writer_t *writer, uint32_t length)
+{
+    uint32_t seed = 0x12345678 + (uint32_t) writer->size;
+
+    if (length <= 60) {
+        *writer->out++ = (uint8_t)((length - 1) << 2);
+    } else {
+        const unsigned bytes = (length - 1) > 0xFF ? 2 : 1;
+        *writer->out++ = (uint8_t)((59 + bytes) << 2);
+        put_le(writer, length - 1, bytes);
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        seed = seed * 1664525 + 1013904223;
+        data[writer->size] = (uint8_t)(seed >> 24);
+        *writer->out++ = data[writer->size++];
+    }
+}
+
+/* Copy with offset_bytes 1 to 3, the length fields following the format */
+static void put_copy(writer_t *writer, uint32_t offset, uint32_t length, unsigned offset_bytes)
+{
+    if (offset_bytes == 1) {
+        *writer->out++ = (uint8_t)(1 | ((length - 4) << 2) | ((offset >> 8) << 5));
+        put_le(writer, offset & 0xFF, 1);
+    } else if (length < 63) {
+        *writer->out++ = (uint8_t)(offset_bytes | ((length - 1) << 2));
+        put_le(writer, offset, offset_bytes);
+    } else if (length < 63 + 256) {
+        *writer->out++ = (uint8_t)(offset_bytes | (62 << 2));
+        put_le(writer, offset, offset_bytes);
+        *writer->out++ = (uint8_t)(length - 63);
+    } else {
+        *writer->out++ = (uint8_t)(offset_bytes | (63 << 2));
+        put_le(writer, offset, offset_bytes);
+        put_le(writer, length, 2);
+    }
+    for (uint32_t i = 0; i < length; i++, writer->size++) {
+        data[writer->size] = data[writer->size - offset];
+    }
+}
+
+static size_t end_stream(writer_t *writer)
+{
+    return writer->out - compressed;
+}
+
+/* Every element form, with overlapping copies */
+static size_t write_elements(uint32_t length)
+{
+    writer_t writer;
+
+    start_stream(&writer, length);
+    put_literal(&writer, 1);
+    put_copy(&writer, 1, 11, 1);
+    put_literal(&writer, 60);
+    put_copy(&writer, 3, 4, 1);
+    put_copy(&writer, 70, 62, 2);
+    put_literal(&writer, 61);
+    put_copy(&writer, 5, 63, 2);
+    put_copy(&writer, 2, 318, 3);
+    put_literal(&writer, 300);
+    put_copy(&writer, 300, 319, 2);
+    put_copy(&writer, 1, 1000, 2);
+    put_copy(&writer, 2000, 7, 3);
+    return end_stream(&writer);
+}
+
+#define ELEMENTS_SIZE (1 + 11 + 60 + 4 + 62 + 61 + 63 + 318 + 300 + 319 + 1000 + 7)
+
+/* Test that compressed data is decompressed into memory. */
+void decompress_test()
+{
+    size_t length = 0;
+    size_t compressed_size = write_elements(ELEMENTS_SIZE);
+
+    TEST_ASSERT_EQUAL(0, hal_decompress_get_length(compressed, compressed_size, &length));
+    TEST_ASSERT_EQUAL(ELEMENTS_SIZE, length);
+    memset(output, 0, sizeof(output));
+    TEST_ASSERT_EQUAL(0, hal_decompress(compressed, compressed_size, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, output, ELEMENTS_SIZE);
+
+    // Output of the pithy compressor, of text then of noise
+    static const char text[] = "The quick brown fox jumps over the lazy dog. ";
+    static const int levels[] = { 0, 9 };
+    for (unsigned int l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        for (size_t i = 0; i < PITHY_DATA_SIZE; i++) {
+            data[i] = i < PITHY_DATA_SIZE / 2 ? text[i % (sizeof(text) - 1)] : (uint8_t)(i * 151 + (i >> 3));
+        }
+        compressed_size = pithy_Compress((const char *) data, PITHY_DATA_SIZE, (char *) compressed, sizeof(compressed), levels[l]);
+        TEST_ASSERT_NOT_EQUAL(0, compressed_size);
+
+        memset(output, 0, sizeof(output));
+        TEST_ASSERT_EQUAL(0, hal_decompress(compressed, compressed_size, output, sizeof(output)));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(data, output, PITHY_DATA_SIZE);
+    }
+}
+
+/* Test that compressed data is decompressed into flash. */
+void decompress_to_flash_test()
+{
+#if DEVICE_FLASH
+    flash_t flash;
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+
+    // The last sectors, covering the data and a page of padding
+    const uint32_t end = flash_get_start_address(&flash) + flash_get_size(&flash);
+    const uint32_t page = flash_get_page_size(&flash);
+    uint32_t address = end;
+    while (end - address < DATA_SIZE + page) {
+        address -= flash_get_sector_size(&flash, address - 1);
+    }
+
+    // Copies of the output programmed, and of the output in the buffer
+    const uint32_t length = DATA_SIZE - 1;
+    writer_t writer;
+    start_stream(&writer, length);
+    put_literal(&writer, FAR_OFFSET);
+    put_copy(&writer, FAR_OFFSET, 100, 2);
+    put_copy(&writer, 1, 900, 2);
+    put_copy(&writer, FAR_OFFSET, length - 2 * FAR_OFFSET, 2);
+    put_literal(&writer, length - writer.size);
+    size_t compressed_size = end_stream(&writer);
+
+    TEST_ASSERT_EQUAL(0, hal_decompress_to_flash(&flash, address, compressed, compressed_size));
+    memset(output, 0, sizeof(output));
+    TEST_ASSERT_EQUAL(0, flash_read(&flash, address, output, sizeof(output)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, output, length);
+    TEST_ASSERT_EQUAL_UINT8(flash_get_erase_value(&flash), output[length]);
+
+    // Over data already programmed
+    compressed_size = write_elements(ELEMENTS_SIZE);
+    TEST_ASSERT_EQUAL(0, hal_decompress_to_flash(&flash, address, compressed, compressed_size));
+    TEST_ASSERT_EQUAL(0, flash_read(&flash, address, output, ELEMENTS_SIZE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, output, ELEMENTS_SIZE);
+
+    // Not at the start of a sector, or past the end of the flash
+    TEST_ASSERT_EQUAL(-1, hal_decompress_to_flash(&flash, address + 1, compressed, compressed_size));
+    TEST_ASSERT_EQUAL(-1, hal_decompress_to_flash(&flash, end, compressed, compressed_size));
+
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+#else
+    TEST_IGNORE_MESSAGE("flash not supported for this target");
+#endif
+}
+
+/* Test that invalid data is rejected. */
+void decompress_invalid_test()
+{
+    // Length 4, then a copy of 4 bytes with an offset past the start of the output
+    static const uint8_t bad_offset[] = { 0x04, 0x01, 0x01 };
+    // Length 4, then a literal of 5 bytes
+    static const uint8_t long_literal[] = { 0x04, 0x10, 'a', 'b', 'c', 'd', 'e' };
+    // Length with a sixth byte
+    static const uint8_t bad_length[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+    size_t length;
+
+    TEST_ASSERT_EQUAL(-1, hal_decompress(bad_offset, sizeof(bad_offset), output, sizeof(output)));
+    TEST_ASSERT_EQUAL(-1, hal_decompress(long_literal, sizeof(long_literal), output, sizeof(output)));
+    TEST_ASSERT_EQUAL(-1, hal_decompress_get_length(bad_length, sizeof(bad_length), &length));
+    TEST_ASSERT_EQUAL(-1, hal_decompress_get_length(compressed, 0, &length));
+
+    const size_t compressed_size = write_elements(ELEMENTS_SIZE);
+    TEST_ASSERT_EQUAL(-1, hal_decompress(compressed, compressed_size - 1, output, sizeof(output)));
+    TEST_ASSERT_EQUAL(-1, hal_decompress(compressed, compressed_size, output, ELEMENTS_SIZE - 1));
+
+    // Corrupted bytes anywhere are rejected or decoded within the output
+    for (size_t i = 1; i < compressed_size; i += 7) {
+        compressed[i] ^= 0x5A;
+        hal_decompress(compressed, compressed_size, output, ELEMENTS_SIZE);
+        compressed[i] ^= 0x5A;
+    }
+    TEST_ASSERT_EQUAL(0, hal_decompress(compressed, compressed_size, output, ELEMENTS_SIZE));
+}
+
+Case cases[] = {
+    Case("test: decompression into memory.", decompress_test),
+    Case("test: decompression into flash.", decompress_to_flash_test),
+    Case("test: invalid compressed data.", decompress_invalid_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    greentea_init_custom_io();
+    Harness::run(specification);
+}
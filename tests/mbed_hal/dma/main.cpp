@@ -0,0 +1,248 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/dma_api.h"
+#include "hal/cache_api.h"
+#include "hal/cycle_counter_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if !DEVICE_DMA
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 2048
+#define PATTERN_ID  0x1234
+
+HAL_DMA_BUFFER(static, src_buffer, BUFFER_SIZE);
+HAL_DMA_BUFFER(static, dst_buffer, BUFFER_SIZE);
+
+static volatile uint32_t handler_calls;
+static volatile uint32_t handler_events;
+
+static void transfer_handler(uint32_t id, uint32_t events)
+{
+    TEST_ASSERT_EQUAL_UINT32(PATTERN_ID, id);
+    handler_events = events;
+    handler_calls++;
+}
+
+static void fill_buffers()
+{
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        src_buffer[i] = (uint8_t)(i * 7 + 1);
+    }
+    memset(dst_buffer, 0, sizeof(dst_buffer));
+}
+
+/* Run a transfer on a memory-to-memory channel and wait for the handler. */
+static void run_transfer(const dma_descriptor_t *list)
+{
+    const int channel = hal_dma_channel_allocate(DMA_REQUEST_MEMORY);
+    TEST_ASSERT_TRUE(channel >= 0);
+
+    handler_calls = 0;
+    handler_events = 0;
+    hal_dma_tx_prepare(src_buffer, sizeof(src_buffer));
+    hal_dma_rx_prepare(dst_buffer, sizeof(dst_buffer));
+    hal_dma_start(channel, list, transfer_handler, PATTERN_ID);
+    while (hal_dma_is_busy(channel));
+    hal_dma_rx_complete(dst_buffer, sizeof(dst_buffer));
+
+    TEST_ASSERT_EQUAL_UINT32(1, handler_calls);
+    TEST_ASSERT_EQUAL_UINT32(DMA_EVENT_COMPLETE, handler_events);
+    hal_dma_channel_free(channel);
+}
+
+/* Test that every channel is allocated once and can be allocated again once freed. */
+void dma_channel_allocate_test()
+{
+    const uint32_t mask = hal_dma_channel_mask(DMA_REQUEST_MEMORY);
+    int channels[DEVICE_DMA_CHANNEL_COUNT];
+    int count = 0;
+
+    TEST_ASSERT_NOT_EQUAL(0, mask);
+    for (;;) {
+        const int channel = hal_dma_channel_allocate(DMA_REQUEST_MEMORY);
+        if (channel < 0) {
+            break;
+        }
+        TEST_ASSERT_TRUE(channel < DEVICE_DMA_CHANNEL_COUNT);
+        TEST_ASSERT_TRUE((mask & (1UL << channel)) != 0);
+        for (int i = 0; i < count; i++) {
+            TEST_ASSERT_NOT_EQUAL(channels[i], channel);
+        }
+        channels[count++] = channel;
+    }
+    TEST_ASSERT_EQUAL_INT(__builtin_popcount(mask), count);
+
+    hal_dma_channel_free(channels[0]);
+    TEST_ASSERT_EQUAL_INT(channels[0], hal_dma_channel_allocate(DMA_REQUEST_MEMORY));
+
+    for (int i = 0; i < count; i++) {
+        hal_dma_channel_free(channels[i]);
+    }
+    hal_dma_channel_free(-1);
+}
+
+/* Test a memory-to-memory transfer of 32-bit items. */
+void dma_memory_transfer_test()
+{
+    fill_buffers();
+    const dma_descriptor_t descriptor = {
+        src_buffer, dst_buffer, BUFFER_SIZE / 4, DMA_WIDTH_32BIT, true, true, NULL
+    };
+
+    run_transfer(&descriptor);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src_buffer, dst_buffer, BUFFER_SIZE);
+}
+
+/* Test that the descriptors of a list are executed in order, including fixed addresses. */
+void dma_linked_list_test()
+{
+    fill_buffers();
+    // Gather the second half then the first half, then repeat one byte 16 times
+    const dma_descriptor_t repeat = {
+        &src_buffer[5], &dst_buffer[BUFFER_SIZE - 16], 16, DMA_WIDTH_8BIT, false, true, NULL
+    };
+    const dma_descriptor_t first_half = {
+        src_buffer, &dst_buffer[BUFFER_SIZE / 2], (BUFFER_SIZE / 2 - 16) / 2, DMA_WIDTH_16BIT, true, true, &repeat
+    };
+    const dma_descriptor_t second_half = {
+        &src_buffer[BUFFER_SIZE / 2], dst_buffer, BUFFER_SIZE / 2, DMA_WIDTH_8BIT, true, true, &first_half
+    };
+
+    run_transfer(&second_half);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&src_buffer[BUFFER_SIZE / 2], dst_buffer, BUFFER_SIZE / 2);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src_buffer, &dst_buffer[BUFFER_SIZE / 2], BUFFER_SIZE / 2 - 16);
+    for (int i = BUFFER_SIZE - 16; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_UINT8(src_buffer[5], dst_buffer[i]);
+    }
+}
+
+/* Test that hal_dma_memcpy copies exactly the given bytes, above and below the threshold. */
+void dma_memcpy_test()
+{
+    const size_t sizes[] = { 1, 13, MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD, BUFFER_SIZE - 3 };
+
+    for (size_t size : sizes) {
+        if (size >= BUFFER_SIZE) {
+            continue;
+        }
+        fill_buffers();
+        TEST_ASSERT_EQUAL_PTR(&dst_buffer[1], hal_dma_memcpy(&dst_buffer[1], src_buffer, size));
+        TEST_ASSERT_EQUAL_UINT8(0, dst_buffer[0]);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src_buffer, &dst_buffer[1], size);
+        TEST_ASSERT_EQUAL_UINT8(0, dst_buffer[size + 1]);
+    }
+}
+
+/* Test that hal_dma_memset fills exactly the given bytes. */
+void dma_memset_test()
+{
+    const size_t sizes[] = { 5, MBED_CONF_TARGET_DMA_MEMCPY_THRESHOLD, BUFFER_SIZE - 8, BUFFER_SIZE - 3 };
+
+    for (size_t size : sizes) {
+        fill_buffers();
+        TEST_ASSERT_EQUAL_PTR(&dst_buffer[1], hal_dma_memset(&dst_buffer[1], 0x1A5, size));
+        TEST_ASSERT_EQUAL_UINT8(0, dst_buffer[0]);
+        for (size_t i = 1; i <= size; i++) {
+            TEST_ASSERT_EQUAL_UINT8(0xA5, dst_buffer[i]);
+        }
+        TEST_ASSERT_EQUAL_UINT8(0, dst_buffer[size + 1]);
+    }
+}
+
+/* Test that an asynchronous copy calls the handler once, after the copy. */
+void dma_memcpy_async_test()
+{
+    const size_t sizes[] = { 16, BUFFER_SIZE };
+
+    for (size_t size : sizes) {
+        fill_buffers();
+        handler_calls = 0;
+        handler_events = 0;
+        hal_dma_memcpy_async(dst_buffer, src_buffer, size, transfer_handler, PATTERN_ID);
+        while (handler_calls == 0);
+
+        TEST_ASSERT_EQUAL_UINT32(1, handler_calls);
+        TEST_ASSERT_EQUAL_UINT32(DMA_EVENT_COMPLETE, handler_events);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src_buffer, dst_buffer, size);
+    }
+
+    // The channels used have been freed
+    const int channel = hal_dma_channel_allocate(DMA_REQUEST_MEMORY);
+    TEST_ASSERT_TRUE(channel >= 0);
+    hal_dma_channel_free(channel);
+}
+
+#if DEVICE_CYCLE_COUNTER
+/* Compare the cycles taken by memcpy and hal_dma_memcpy across sizes. */
+void dma_memcpy_benchmark_test()
+{
+    hal_cycle_counter_init();
+
+    for (size_t size = 64; size <= BUFFER_SIZE; size *= 2) {
+        uint32_t start = hal_cycle_counter_read();
+        memcpy(dst_buffer, src_buffer, size);
+        const uint32_t cpu_cycles = hal_cycle_counter_read() - start;
+
+        start = hal_cycle_counter_read();
+        hal_dma_memcpy(dst_buffer, src_buffer, size);
+        const uint32_t dma_cycles = hal_cycle_counter_read() - start;
+
+        printf("%u bytes: memcpy %lu cycles, hal_dma_memcpy %lu cycles\r\n", (unsigned)size,
+               (unsigned long)cpu_cycles, (unsigned long)dma_cycles);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src_buffer, dst_buffer, size);
+    }
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("DMA channel allocation test", dma_channel_allocate_test),
+    Case("DMA memory-to-memory transfer test", dma_memory_transfer_test),
+    Case("DMA linked list test", dma_linked_list_test),
+    Case("DMA memcpy test", dma_memcpy_test),
+    Case("DMA memset test", dma_memset_test),
+    Case("DMA asynchronous memcpy test", dma_memcpy_async_test),
+#if DEVICE_CYCLE_COUNTER
+    Case("DMA memcpy benchmark", dma_memcpy_benchmark_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_DMA
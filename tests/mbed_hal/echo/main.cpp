@@ -14,8 +14,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
+#include "hal/serial_api.h"
+#include "hal/us_ticker_api.h"
 #include "greentea-client/test_env.h"
 #include "greentea-custom_io/custom_io.h"
 #include "unity/unity.h"
@@ -23,6 +26,13 @@
 
 #define PAYLOAD_LENGTH 36
 
+// Round trips of the latency and throughput benchmarks
+#define BENCHMARK_COUNT 64
+
+// Bytes sent through the loopback for each baud rate and path
+#define LOOPBACK_LENGTH 256
+#define RESULT_LENGTH 64
+
 using namespace utest::v1;
 
 // Fill a buffer with a slice of the ASCII alphabet.
@@ -69,6 +79,283 @@ void test_case_echo_server_x()
     }
 }
 
+#if DEVICE_USTICKER
+/* Send a result to the host, which collects them to compare targets. */
+static void report(const char *name, unsigned long value)
+{
+    char result[RESULT_LENGTH];
+    snprintf(result, sizeof(result), "%s,%lu", name, value);
+    greentea_send_kv("echo_result", result);
+}
+
+// Echo a payload of the host, and get the round trip time
+static us_timestamp_t echo_round_trip(const char *payload, char *reply, size_t reply_size)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    char _key[11] = {};
+    const us_timestamp_t start = ticker_read_us(ticker);
+
+    greentea_send_kv("echo", payload);
+    do {
+        greentea_parse_kv(_key, reply, sizeof(_key), reply_size);
+    } while (strcmp("echo", _key));
+
+    return ticker_read_us(ticker) - start;
+}
+
+// Round trip latency of the console, with the smallest payload
+void test_case_echo_latency()
+{
+    char _rx_value[PAYLOAD_LENGTH + 1] = {};
+    unsigned long min_us = ULONG_MAX;
+    unsigned long max_us = 0;
+    us_timestamp_t total_us = 0;
+
+    for (int i = 0; i < BENCHMARK_COUNT; ++i) {
+        const unsigned long rtt_us = echo_round_trip("x", _rx_value, sizeof(_rx_value));
+        TEST_ASSERT_EQUAL_STRING("x", _rx_value);
+        min_us = rtt_us < min_us ? rtt_us : min_us;
+        max_us = rtt_us > max_us ? rtt_us : max_us;
+        total_us += rtt_us;
+    }
+
+    report("echo_latency_min_us", min_us);
+    report("echo_latency_avg_us", (unsigned long)(total_us / BENCHMARK_COUNT));
+    report("echo_latency_max_us", max_us);
+}
+
+// Sustained echo of full payloads through the console, in both directions
+void test_case_echo_throughput()
+{
+    char _tx_value[PAYLOAD_LENGTH + 1] = {};
+    char _rx_value[PAYLOAD_LENGTH + 1] = {};
+    us_timestamp_t total_us = 0;
+
+    for (int i = 0; i < BENCHMARK_COUNT; ++i) {
+        fill_buffer(_tx_value, PAYLOAD_LENGTH, i);
+        total_us += echo_round_trip(_tx_value, _rx_value, sizeof(_rx_value));
+        TEST_ASSERT(strncmp(_tx_value, _rx_value, PAYLOAD_LENGTH) == 0);
+    }
+
+    report("echo_throughput_bytes_per_s", (unsigned long)(2ULL * BENCHMARK_COUNT * (PAYLOAD_LENGTH - 1) * 1000000 / total_us));
+}
+
+#if defined(MBED_CONF_APP_ECHO_LOOPBACK_TX) && defined(MBED_CONF_APP_ECHO_LOOPBACK_RX)
+/* The loopback benchmarks need the TX and RX pins of a second serial port
+ * wired together, set through the application configuration:
+ * "echo-loopback-tx" and "echo-loopback-rx".
+ */
+static const int loopback_baud_rates[] = { 9600, 115200, 460800, 921600 };
+
+static serial_t loopback;
+static uint8_t loopback_tx[LOOPBACK_LENGTH];
+static uint8_t loopback_rx[LOOPBACK_LENGTH];
+static volatile uint32_t loopback_rx_count;
+
+// Loop iterations per millisecond of a CPU left alone, to get the CPU load
+static uint32_t idle_per_ms;
+
+/* Spin until every byte is received or the timeout expires, and return the
+ * loop iterations left to the CPU by the interrupts. */
+static uint32_t loopback_spin(us_timestamp_t timeout_us)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const us_timestamp_t end = ticker_read_us(ticker) + timeout_us;
+    uint32_t count = 0;
+
+    while (loopback_rx_count < LOOPBACK_LENGTH && ticker_read_us(ticker) < end) {
+        count++;
+    }
+    return count;
+}
+
+// Twice the time on the wire, 10 bits per byte
+static us_timestamp_t loopback_timeout_us(int baud)
+{
+    return 2ULL * LOOPBACK_LENGTH * 10 * 1000000 / baud + 10000;
+}
+
+static void loopback_report(const char *path, int baud, us_timestamp_t elapsed_us, uint32_t idle)
+{
+    char name[RESULT_LENGTH];
+
+    TEST_ASSERT_EQUAL_UINT32(LOOPBACK_LENGTH, loopback_rx_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(loopback_tx, loopback_rx, LOOPBACK_LENGTH);
+
+    snprintf(name, sizeof(name), "loopback_%s_%d_bytes_per_s", path, baud);
+    report(name, (unsigned long)(LOOPBACK_LENGTH * 1000000ULL / elapsed_us));
+
+    const uint64_t idle_expected = (uint64_t)idle_per_ms * elapsed_us / 1000;
+    const unsigned long load = idle >= idle_expected ? 0 : (unsigned long)(100 - idle * 100ULL / idle_expected);
+    snprintf(name, sizeof(name), "loopback_%s_%d_cpu_percent", path, baud);
+    report(name, load);
+}
+
+// Initialize the loopback, false if the baud rate is above the one of the peripheral
+static bool loopback_init(int baud)
+{
+    serial_capabilities_t cap;
+
+    serial_init(&loopback, MBED_CONF_APP_ECHO_LOOPBACK_TX, MBED_CONF_APP_ECHO_LOOPBACK_RX);
+    serial_get_capabilities(&loopback, &cap);
+    if (cap.baud_max != 0 && (uint32_t)baud > cap.baud_max) {
+        serial_free(&loopback);
+        return false;
+    }
+    serial_baud(&loopback, baud);
+    serial_format(&loopback, 8, ParityNone, 1);
+
+    for (int i = 0; i < LOOPBACK_LENGTH; i++) {
+        loopback_tx[i] = (uint8_t)(i * 7 + baud);
+    }
+    memset(loopback_rx, 0, sizeof(loopback_rx));
+    loopback_rx_count = 0;
+    return true;
+}
+
+static void loopback_calibrate()
+{
+    loopback_rx_count = 0;
+    idle_per_ms = loopback_spin(100000) / 100;
+    TEST_ASSERT_NOT_EQUAL(0, idle_per_ms);
+}
+
+// Blocking path: one byte at a time, the CPU waits for each of them
+void test_case_loopback_blocking()
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    char name[RESULT_LENGTH];
+
+    loopback_calibrate();
+
+    for (size_t b = 0; b < sizeof(loopback_baud_rates) / sizeof(loopback_baud_rates[0]); b++) {
+        const int baud = loopback_baud_rates[b];
+        if (!loopback_init(baud)) {
+            continue;
+        }
+        unsigned long min_us = ULONG_MAX;
+
+        const us_timestamp_t start = ticker_read_us(ticker);
+        for (int i = 0; i < LOOPBACK_LENGTH; i++) {
+            const us_timestamp_t sent = ticker_read_us(ticker);
+            serial_putc(&loopback, loopback_tx[i]);
+            // Do not hang if the pins are not wired together
+            while (!serial_readable(&loopback) && ticker_read_us(ticker) - sent < loopback_timeout_us(baud));
+            if (!serial_readable(&loopback)) {
+                break;
+            }
+            loopback_rx[i] = serial_getc(&loopback);
+            loopback_rx_count++;
+            const unsigned long latency_us = ticker_read_us(ticker) - sent;
+            min_us = latency_us < min_us ? latency_us : min_us;
+        }
+        const us_timestamp_t elapsed_us = ticker_read_us(ticker) - start;
+
+        serial_free(&loopback);
+        loopback_report("blocking", baud, elapsed_us, 0);
+        snprintf(name, sizeof(name), "loopback_blocking_%d_latency_us", baud);
+        report(name, min_us);
+    }
+}
+
+static void loopback_rx_irq(uint32_t id, SerialIrq event)
+{
+    if (event != RxIrq) {
+        return;
+    }
+    while (serial_readable(&loopback)) {
+        const int c = serial_getc(&loopback);
+        if (loopback_rx_count < LOOPBACK_LENGTH) {
+            loopback_rx[loopback_rx_count++] = (uint8_t)c;
+        }
+    }
+}
+
+// IRQ path: sent through the TX FIFO, received by the RX IRQ
+void test_case_loopback_irq()
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    serial_tx_fifo_t fifo;
+
+    loopback_calibrate();
+
+    for (size_t b = 0; b < sizeof(loopback_baud_rates) / sizeof(loopback_baud_rates[0]); b++) {
+        const int baud = loopback_baud_rates[b];
+        if (!loopback_init(baud)) {
+            continue;
+        }
+        serial_tx_fifo_init(&fifo, &loopback, loopback_rx_irq, 0);
+        serial_irq_set(&loopback, RxIrq, 1);
+
+        const us_timestamp_t end = ticker_read_us(ticker) + loopback_timeout_us(baud);
+        const us_timestamp_t start = ticker_read_us(ticker);
+        size_t queued = 0;
+        uint32_t idle = 0;
+        // Refill the FIFO as it drains, the rest of the time is left to the CPU
+        while (loopback_rx_count < LOOPBACK_LENGTH && ticker_read_us(ticker) < end) {
+            if (queued < LOOPBACK_LENGTH) {
+                queued += serial_tx_fifo_write(&fifo, &loopback_tx[queued], LOOPBACK_LENGTH - queued);
+            }
+            idle++;
+        }
+        const us_timestamp_t elapsed_us = ticker_read_us(ticker) - start;
+
+        serial_irq_set(&loopback, RxIrq, 0);
+        serial_tx_fifo_free(&fifo);
+        serial_free(&loopback);
+        loopback_report("irq", baud, elapsed_us, idle);
+    }
+}
+
+#if DEVICE_SERIAL_ASYNCH
+static uint8_t loopback_ring[LOOPBACK_LENGTH / 4];
+static size_t loopback_tail;
+
+static void loopback_asynch_irq()
+{
+    (void)serial_irq_handler_asynch(&loopback);
+}
+
+static void loopback_stream_handler(uint32_t id, size_t head, int event)
+{
+    while (loopback_tail != head) {
+        if (loopback_rx_count < LOOPBACK_LENGTH) {
+            loopback_rx[loopback_rx_count++] = loopback_ring[loopback_tail];
+        }
+        loopback_tail = (loopback_tail + 1) % sizeof(loopback_ring);
+    }
+}
+
+// Asynchronous path: sent in one transfer, received by the RX stream, DMA on the targets which have it
+void test_case_loopback_asynch()
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+
+    loopback_calibrate();
+
+    for (size_t b = 0; b < sizeof(loopback_baud_rates) / sizeof(loopback_baud_rates[0]); b++) {
+        const int baud = loopback_baud_rates[b];
+        if (!loopback_init(baud)) {
+            continue;
+        }
+        loopback_tail = 0;
+        TEST_ASSERT_EQUAL_INT(0, serial_rx_stream_start(&loopback, loopback_ring, sizeof(loopback_ring), loopback_stream_handler, 0));
+
+        const us_timestamp_t start = ticker_read_us(ticker);
+        serial_tx_asynch(&loopback, loopback_tx, LOOPBACK_LENGTH, 8, (uint32_t)loopback_asynch_irq, SERIAL_EVENT_TX_COMPLETE);
+        const uint32_t idle = loopback_spin(loopback_timeout_us(baud));
+        const us_timestamp_t elapsed_us = ticker_read_us(ticker) - start;
+
+        serial_tx_abort_asynch(&loopback);
+        serial_rx_stream_stop(&loopback);
+        serial_free(&loopback);
+        loopback_report("asynch", baud, elapsed_us, idle);
+    }
+}
+#endif // DEVICE_SERIAL_ASYNCH
+#endif // MBED_CONF_APP_ECHO_LOOPBACK_TX && MBED_CONF_APP_ECHO_LOOPBACK_RX
+#endif // DEVICE_USTICKER
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -77,12 +364,23 @@ utest::v1::status_t greentea_failure_handler(const Case *const source, const fai
 
 Case cases[] = {
     Case("Echo server: x16", test_case_echo_server_x<16>, greentea_failure_handler),
+#if DEVICE_USTICKER
+    Case("Echo latency", test_case_echo_latency, greentea_failure_handler),
+    Case("Echo throughput", test_case_echo_throughput, greentea_failure_handler),
+#if defined(MBED_CONF_APP_ECHO_LOOPBACK_TX) && defined(MBED_CONF_APP_ECHO_LOOPBACK_RX)
+    Case("Loopback blocking", test_case_loopback_blocking, greentea_failure_handler),
+    Case("Loopback IRQ", test_case_loopback_irq, greentea_failure_handler),
+#if DEVICE_SERIAL_ASYNCH
+    Case("Loopback asynch", test_case_loopback_asynch, greentea_failure_handler),
+#endif
+#endif
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
 {
     greentea_init_custom_io();
-    GREENTEA_SETUP(30, "device_echo");
+    GREENTEA_SETUP(60, "device_echo");
     return greentea_test_setup_handler(number_of_cases);
 }
 
@@ -0,0 +1,192 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "bootstrap/mbed_error.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !MBED_CONF_PLATFORM_ERROR_HIST_ENABLED || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define WRAP_WARNINGS 64
+#define THREAD_WARNINGS 20000
+#define ISR_PERIOD_US 100
+
+static ticker_event_t isr_event;
+static volatile uint32_t isr_warnings;
+
+static void check_ctx(const mbed_error_ctx *info, mbed_error_status_t status, uint32_t value, const char *filename, uint32_t line)
+{
+    TEST_ASSERT_EQUAL_HEX32(status, info->error_status);
+    TEST_ASSERT_EQUAL_UINT32(value, info->error_value);
+    TEST_ASSERT_EQUAL_STRING(filename, info->error_filename);
+    TEST_ASSERT_EQUAL_UINT32(line, info->error_line_number);
+}
+
+/* Test that the first and the last errors are recorded with their context. */
+void error_first_last_info_test()
+{
+    mbed_error_ctx info;
+
+    mbed_clear_all_errors();
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_first_error_info(&info));
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, info.error_status);
+
+    mbed_warning(MBED_ERROR_INVALID_ARGUMENT, NULL, 1, "first", 10);
+    mbed_warning(MBED_ERROR_TIME_OUT, NULL, 2, "middle", 20);
+    mbed_warning(MBED_ERROR_ITEM_NOT_FOUND, NULL, 3, "last", 30);
+
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, mbed_get_first_error());
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_first_error_info(&info));
+    check_ctx(&info, MBED_ERROR_INVALID_ARGUMENT, 1, "first", 10);
+
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_get_last_error());
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_last_error_info(&info));
+    check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 3, "last", 30);
+
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, mbed_get_first_error_info(NULL));
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, mbed_get_last_error_info(NULL));
+
+    mbed_clear_all_errors();
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_last_error_info(&info));
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, info.error_status);
+}
+
+/* Test that warnings repeated from the same place are counted in one entry,
+ * and that another value or another place makes a new entry. */
+void error_hist_repeat_test()
+{
+    mbed_error_ctx info;
+
+    mbed_clear_all_errors();
+    for (int i = 0; i < 5; i++) {
+        mbed_warning(MBED_ERROR_ITEM_NOT_FOUND, NULL, 7, "repeat", 40);
+    }
+    TEST_ASSERT_EQUAL_INT(1, mbed_get_error_hist_count());
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_error_hist_info(0, &info));
+    check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 7, "repeat", 40);
+    TEST_ASSERT_EQUAL_UINT32(5, info.error_repeat_count);
+
+    for (uint32_t value = 7; value < 9; value++) {
+        mbed_warning(MBED_ERROR_ITEM_NOT_FOUND, NULL, value, "repeat", 40);
+    }
+    TEST_ASSERT_EQUAL_INT(3, mbed_get_error_hist_count());
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_error_hist_info(1, &info));
+    check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 7, "repeat", 40);
+    TEST_ASSERT_EQUAL_UINT32(1, info.error_repeat_count);
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_error_hist_info(2, &info));
+    check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 8, "repeat", 40);
+
+    TEST_ASSERT_EQUAL_INT(7, mbed_get_error_count());
+}
+
+/* Test that the ring keeps the latest entries, oldest first, once it wraps. */
+void error_hist_wrap_test()
+{
+    mbed_error_ctx info;
+
+    mbed_clear_all_errors();
+    for (uint32_t value = 0; value < WRAP_WARNINGS; value++) {
+        mbed_warning(MBED_ERROR_ITEM_NOT_FOUND, NULL, value, "wrap", 50);
+    }
+
+    const int count = mbed_get_error_hist_count();
+    TEST_ASSERT_TRUE(count > 0 && count <= WRAP_WARNINGS);
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_error_hist_info(i, &info));
+        check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, WRAP_WARNINGS - count + i, "wrap", 50);
+        TEST_ASSERT_EQUAL_UINT32(1, info.error_repeat_count);
+    }
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, mbed_get_error_hist_info(count, &info));
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_ARGUMENT, mbed_get_error_hist_info(-1, &info));
+    TEST_ASSERT_EQUAL_INT(WRAP_WARNINGS, mbed_get_error_count());
+}
+
+static void isr_warning_handler(uint32_t id)
+{
+    (void)id;
+    mbed_warning(MBED_ERROR_TIME_OUT, NULL, 1, "isr", 60);
+    isr_warnings++;
+}
+
+/* Test that warnings raised by an interrupt while a thread raises its own
+ * are all counted, and that every entry is one of them, not a mix. */
+void error_hist_interrupt_test()
+{
+    const ticker_data_t *ticker = get_us_ticker_data();
+    mbed_error_ctx info;
+
+    mbed_clear_all_errors();
+    isr_warnings = 0;
+    ticker_set_handler(ticker, isr_warning_handler);
+    ticker_insert_periodic_event_us(ticker, &isr_event, ISR_PERIOD_US, 0);
+    for (uint32_t i = 0; i < THREAD_WARNINGS; i++) {
+        mbed_warning(MBED_ERROR_ITEM_NOT_FOUND, NULL, 0, "thread", 70);
+    }
+    ticker_remove_event(ticker, &isr_event);
+
+    TEST_ASSERT_TRUE(isr_warnings > 0);
+    TEST_ASSERT_EQUAL_INT(THREAD_WARNINGS + isr_warnings, mbed_get_error_count());
+
+    for (int i = 0; i < mbed_get_error_hist_count(); i++) {
+        TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_error_hist_info(i, &info));
+        if (info.error_status == MBED_ERROR_TIME_OUT) {
+            check_ctx(&info, MBED_ERROR_TIME_OUT, 1, "isr", 60);
+        } else {
+            check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 0, "thread", 70);
+        }
+        TEST_ASSERT_TRUE(info.error_repeat_count >= 1);
+    }
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_get_first_error_info(&info));
+    if (info.error_status == MBED_ERROR_TIME_OUT) {
+        check_ctx(&info, MBED_ERROR_TIME_OUT, 1, "isr", 60);
+    } else {
+        check_ctx(&info, MBED_ERROR_ITEM_NOT_FOUND, 0, "thread", 70);
+    }
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Error first and last info test", error_first_last_info_test),
+    Case("Error history repeat test", error_hist_repeat_test),
+    Case("Error history wrap test", error_hist_wrap_test),
+    Case("Error history interrupt test", error_hist_interrupt_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !MBED_CONF_PLATFORM_ERROR_HIST_ENABLED || !DEVICE_USTICKER
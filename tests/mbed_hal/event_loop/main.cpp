@@ -0,0 +1,122 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/event_loop_api.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+#define EVENT_COUNT 4
+#define PERIOD_US 10000
+
+static uint32_t order[EVENT_COUNT];
+static uint32_t runs;
+
+static void record(void *context)
+{
+    if (runs < EVENT_COUNT) {
+        order[runs] = (uint32_t)(uintptr_t)context;
+    }
+    runs++;
+}
+
+/* Test that the events posted run once, in the order they were posted. */
+void event_loop_call_test()
+{
+    runs = 0;
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        TEST_ASSERT_NOT_NULL(hal_event_call(record, (void *)(uintptr_t)i));
+    }
+
+    TEST_ASSERT_EQUAL_UINT(EVENT_COUNT, hal_event_dispatch());
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, order[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, hal_event_dispatch());
+}
+
+/* Test that cancelled events don't run and are released. */
+void event_loop_cancel_test()
+{
+    runs = 0;
+    for (int round = 0; round < 2 * MBED_CONF_TARGET_EVENT_LOOP_EVENTS; round++) {
+        hal_event_t *event = hal_event_call(record, NULL);
+        TEST_ASSERT_NOT_NULL(event);
+        hal_event_cancel(event);
+        TEST_ASSERT_EQUAL_UINT(0, hal_event_dispatch());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, runs);
+}
+
+#if DEVICE_USTICKER
+/* Test that timed events don't run before their time, and periodic ones
+ * run until cancelled. */
+void event_loop_timed_test()
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+
+    runs = 0;
+    hal_event_t *periodic = hal_event_call_every(PERIOD_US, record, NULL);
+    TEST_ASSERT_NOT_NULL(periodic);
+    TEST_ASSERT_NOT_NULL(hal_event_call_in(PERIOD_US * 5 / 2, record, NULL));
+
+    const us_timestamp_t start = ticker_read_us(ticker);
+    while (ticker_read_us(ticker) - start < PERIOD_US / 2) {
+        hal_event_dispatch();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, runs);
+
+    while (ticker_read_us(ticker) - start < PERIOD_US * 4) {
+        hal_event_dispatch();
+    }
+    hal_event_cancel(periodic);
+
+    // Periodic at 1, 2 and 3 periods, one shot at 2.5 periods
+    TEST_ASSERT_TRUE(runs >= 3 && runs <= 5);
+    const uint32_t cancelled_runs = runs;
+    while (ticker_read_us(ticker) - start < PERIOD_US * 6) {
+        hal_event_dispatch();
+    }
+    TEST_ASSERT_EQUAL_UINT32(cancelled_runs, runs);
+}
+#endif
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("event loop call test", event_loop_call_test),
+    Case("event loop cancel test", event_loop_cancel_test),
+#if DEVICE_USTICKER
+    Case("event loop timed test", event_loop_timed_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
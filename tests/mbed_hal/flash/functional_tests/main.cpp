@@ -153,6 +153,67 @@ void flash_mapping_alignment_test()
     TEST_ASSERT_EQUAL_INT32(0, ret);
 }
 
+// The layout must match the sector sizes reported sector by sector
+void flash_layout_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    const uint32_t flash_start = flash_get_start_address(&test_flash);
+    const uint32_t flash_size = flash_get_size(&test_flash);
+
+    const int32_t count = flash_get_layout(&test_flash, NULL, 0);
+    TEST_ASSERT_TRUE(count > 0);
+
+    flash_region_t *regions = new flash_region_t[count];
+    TEST_ASSERT_EQUAL_INT32(count, flash_get_layout(&test_flash, regions, count));
+
+    uint32_t address = flash_start;
+    for (int32_t i = 0; i < count; i++) {
+        // Regions cover the flash without gap
+        TEST_ASSERT_EQUAL_UINT32(address, regions[i].start);
+        TEST_ASSERT_NOT_EQUAL(0, regions[i].size);
+        TEST_ASSERT_EQUAL_UINT32(0, regions[i].size % regions[i].sector_size);
+        if (i > 0) {
+            TEST_ASSERT_NOT_EQUAL(regions[i - 1].sector_size, regions[i].sector_size);
+        }
+        TEST_ASSERT_EQUAL_UINT32(regions[i].sector_size, flash_get_sector_size(&test_flash, regions[i].start));
+        TEST_ASSERT_EQUAL_UINT32(regions[i].sector_size, flash_get_sector_size(&test_flash, regions[i].start + regions[i].size - 1));
+        address += regions[i].size;
+    }
+    TEST_ASSERT_EQUAL_UINT32(flash_start + flash_size, address);
+
+    delete[] regions;
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
+// Every address must be in a bank below the bank count
+void flash_bank_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    const uint32_t bank_count = flash_get_bank_count(&test_flash);
+    TEST_ASSERT_NOT_EQUAL(0, bank_count);
+
+    const uint32_t flash_start = flash_get_start_address(&test_flash);
+    const uint32_t flash_end = flash_start + flash_get_size(&test_flash);
+    for (uint32_t address = flash_start; address < flash_end; address += flash_get_sector_size(&test_flash, address)) {
+        TEST_ASSERT_TRUE(flash_get_bank(&test_flash, address) < bank_count);
+    }
+
+    // The banks are not swapped here, the test would run the other bank after a reset
+    if (bank_count == 1) {
+        TEST_ASSERT_EQUAL_INT32(-1, flash_bank_swap(&test_flash));
+    }
+
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
 void flash_erase_sector_test()
 {
     flash_t test_flash;
@@ -228,6 +289,192 @@ void flash_program_page_test()
     delete[] data_flashed;
 }
 
+// Check the last sector blank after an erase, and not blank once a byte is programmed
+void flash_is_blank_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    uint32_t addr_after_last = flash_get_start_address(&test_flash) + flash_get_size(&test_flash);
+    uint32_t sector_size = flash_get_sector_size(&test_flash, addr_after_last - 1);
+    uint32_t last_sector = addr_after_last - sector_size;
+    uint32_t page_size = flash_get_page_size(&test_flash);
+    TEST_SKIP_UNLESS_MESSAGE(last_sector >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+
+    erase_range(&test_flash, last_sector, sector_size);
+    TEST_ASSERT_EQUAL_INT32(1, flash_is_blank(&test_flash, last_sector, sector_size));
+    TEST_ASSERT_EQUAL_INT32(-1, flash_is_blank(&test_flash, last_sector, sector_size + 1));
+
+    // Program the last byte of the middle page of the sector
+    uint8_t *data = new uint8_t[page_size];
+    memset(data, flash_get_erase_value(&test_flash), page_size);
+    data[page_size - 1] = ~flash_get_erase_value(&test_flash);
+    uint32_t page = last_sector + ALIGN_DOWN(sector_size / 2, page_size);
+    ret = flash_program_page(&test_flash, page, data, page_size);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    flash_cache_invalidate(&test_flash);
+
+    TEST_ASSERT_EQUAL_INT32(0, flash_is_blank(&test_flash, last_sector, sector_size));
+    TEST_ASSERT_EQUAL_INT32(0, flash_is_blank(&test_flash, page + page_size - 1, 1));
+    // Unaligned ranges up to the programmed byte
+    TEST_ASSERT_EQUAL_INT32(1, flash_is_blank(&test_flash, last_sector + 1, page + page_size - 2 - last_sector));
+    TEST_ASSERT_EQUAL_INT32(0, flash_is_blank(&test_flash, last_sector + 1, page + page_size - last_sector - 1));
+
+    erase_range(&test_flash, last_sector, sector_size);
+    TEST_ASSERT_EQUAL_INT32(1, flash_is_blank(&test_flash, last_sector, sector_size));
+
+    delete[] data;
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
+// Program the last sector with blocks of increasing size and report the throughput
+void flash_program_throughput_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    const uint32_t page_size = flash_get_page_size(&test_flash);
+    const uint32_t end_address = flash_get_start_address(&test_flash) + flash_get_size(&test_flash);
+    const uint32_t sector_size = flash_get_sector_size(&test_flash, end_address - page_size);
+    const uint32_t sector_address = end_address - sector_size;
+    TEST_SKIP_UNLESS_MESSAGE(sector_address >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+
+    uint8_t *data = new uint8_t[sector_size];
+    uint8_t *data_flashed = new uint8_t[sector_size];
+    for (uint32_t i = 0; i < sector_size; i++) {
+        data[i] = (uint8_t)i;
+    }
+
+    for (uint32_t block_size = page_size; block_size <= sector_size; block_size *= 4) {
+        ret = flash_erase_sector(&test_flash, sector_address);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+
+        Timer timer;
+        timer.start();
+        for (uint32_t offset = 0; offset + block_size <= sector_size; offset += block_size) {
+            ret = flash_program(&test_flash, sector_address + offset, data + offset, block_size);
+            TEST_ASSERT_EQUAL_INT32(0, ret);
+        }
+        timer.stop();
+
+        const uint32_t written = sector_size - (sector_size % block_size);
+        const uint32_t elapsed_us = timer.read_us() > 0 ? timer.read_us() : 1;
+        utest_printf("block %lu bytes: %lu KB/s\n", block_size, (uint32_t)((uint64_t)written * 1000000 / 1024 / elapsed_us));
+
+        ret = flash_read(&test_flash, sector_address, data_flashed, written);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, written);
+    }
+
+    ret = flash_erase_sector(&test_flash, sector_address);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    delete[] data;
+    delete[] data_flashed;
+}
+
+#define ASYNC_TIMEOUT_MS 5000
+
+typedef struct {
+    uint32_t calls;
+    int32_t status;
+} flash_async_test_data_t;
+
+static void flash_async_test_handler(uint32_t id, int32_t status)
+{
+    flash_async_test_data_t *td = (flash_async_test_data_t *)id;
+    td->status = status;
+    td->calls++;
+}
+
+static void flash_async_wait(volatile flash_async_test_data_t *td)
+{
+    Timer timer;
+    timer.start();
+    while (td->calls == 0 && timer.read_ms() < ASYNC_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_UINT32(1, td->calls);
+    TEST_ASSERT_EQUAL_INT32(0, td->status);
+}
+
+// Erase sector and write one page with the asynchronous API
+void flash_async_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    uint32_t test_size = flash_get_page_size(&test_flash);
+    uint8_t *data = new uint8_t[test_size];
+    uint8_t *data_flashed = new uint8_t[test_size];
+    for (uint32_t i = 0; i < test_size; i++) {
+        data[i] = 0x5A;
+    }
+
+    // the one before the last page in the system
+    uint32_t address = flash_get_start_address(&test_flash) + flash_get_size(&test_flash) - (2 * test_size);
+    uint32_t erase_sector_boundary = ALIGN_DOWN(address, flash_get_sector_size(&test_flash, address));
+    TEST_SKIP_UNLESS_MESSAGE(erase_sector_boundary >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+
+    volatile flash_async_test_data_t td = { 0, -1 };
+    ret = flash_erase_sector_async(&test_flash, erase_sector_boundary, flash_async_test_handler, (uint32_t) &td);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    flash_async_wait(&td);
+    TEST_ASSERT_EQUAL_UINT32(0, flash_async_progress(&test_flash));
+
+    td.calls = 0;
+    td.status = -1;
+    ret = flash_program_page_async(&test_flash, address, data, test_size, flash_async_test_handler, (uint32_t) &td);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    flash_async_wait(&td);
+
+    ret = flash_read(&test_flash, address, data_flashed, test_size);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, test_size);
+
+    // Nothing to suspend once the operation completed
+    TEST_ASSERT_EQUAL_INT32(-1, flash_erase_suspend(&test_flash));
+
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    delete[] data;
+    delete[] data_flashed;
+}
+
+// Read back the accelerator settings and apply them again unchanged
+void flash_accel_config_test()
+{
+    flash_t test_flash;
+    int32_t ret = flash_init(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    flash_accel_config_t config;
+    ret = flash_get_accel_config(&test_flash, &config);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    utest_printf("wait states %lu, icache %d, dcache %d, prefetch %d\n",
+                 config.wait_states, config.icache, config.dcache, config.prefetch);
+    TEST_ASSERT_TRUE(config.wait_states >= flash_get_min_wait_states(&test_flash, SystemCoreClock));
+
+    if (flash_set_accel_config(&test_flash, &config) == 0) {
+        flash_accel_config_t readback;
+        ret = flash_get_accel_config(&test_flash, &readback);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+        TEST_ASSERT_EQUAL_UINT32(config.wait_states, readback.wait_states);
+        TEST_ASSERT_EQUAL(config.icache, readback.icache);
+        TEST_ASSERT_EQUAL(config.dcache, readback.dcache);
+        TEST_ASSERT_EQUAL(config.prefetch, readback.prefetch);
+    }
+
+    flash_cache_invalidate(&test_flash);
+
+    ret = flash_free(&test_flash);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
 // check the execution speed at the start and end of the test to make sure
 // cache settings weren't changed
 void flash_clock_and_cache_test()
@@ -240,8 +487,14 @@ void flash_clock_and_cache_test()
 Case cases[] = {
     Case("Flash - init", flash_init_test),
     Case("Flash - mapping alignment", flash_mapping_alignment_test),
+    Case("Flash - layout", flash_layout_test),
+    Case("Flash - banks", flash_bank_test),
     Case("Flash - erase sector", flash_erase_sector_test),
     Case("Flash - program page", flash_program_page_test),
+    Case("Flash - blank check", flash_is_blank_test),
+    Case("Flash - program throughput", flash_program_throughput_test),
+    Case("Flash - async erase and program", flash_async_test),
+    Case("Flash - accelerator configuration", flash_accel_config_test),
     Case("Flash - clock and cache test", flash_clock_and_cache_test),
 };
 
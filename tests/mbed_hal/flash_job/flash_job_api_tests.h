@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_flash_job_tests */
+/** @{*/
+
+#ifndef FLASH_JOB_API_TESTS_H
+#define FLASH_JOB_API_TESTS_H
+
+#include "device.h"
+
+#if DEVICE_FLASH
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that an erase job erases one sector per step.
+ *
+ *  Given is a programmed range of the last sectors of the flash.
+ *  When an erase job is stepped through.
+ *  Then each step but the last returns 1, and the range is blank once the job is done.
+ */
+void flash_job_erase_test();
+
+/** Test that a program job programs the data in chunks.
+ *
+ *  Given is an erased range of the last sectors of the flash.
+ *  When a program job is run with flash_job_run().
+ *  Then the data is programmed.
+ */
+void flash_job_program_test();
+
+/** Test that a job started on the event loop runs a chunk per dispatch.
+ *
+ *  Given is an erase job, then a program job, over several chunks.
+ *  When they are started with flash_job_start() and the events dispatched.
+ *  Then each dispatch runs one chunk, and the handler is called with 0 once done.
+ */
+void flash_job_event_loop_test();
+
+/** Test that invalid ranges are rejected.
+ *
+ *  Given is a flash.
+ *  When jobs are prepared for ranges not aligned to sectors, or to pages, or past the flash.
+ *  Then -1 is returned.
+ */
+void flash_job_invalid_test();
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
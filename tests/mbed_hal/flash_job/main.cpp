@@ -0,0 +1,221 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "flash_job_api.h"
+#include "flash_job_api_tests.h"
+#include "hal/event_loop_api.h"
+
+#if !DEVICE_FLASH
+#error [NOT_SUPPORTED] flash not supported for this target
+#else
+
+using namespace utest::v1;
+
+#define TEST_SECTORS 2
+#define PROGRAM_BUFFER_SIZE (4 * MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE)
+
+static flash_t flash;
+static uint8_t buffer[PROGRAM_BUFFER_SIZE];
+
+/* The last TEST_SECTORS sectors of the flash */
+static uint32_t test_range(uint32_t *size)
+{
+    const uint32_t end = flash_get_start_address(&flash) + flash_get_size(&flash);
+    uint32_t address = end;
+
+    for (int i = 0; i < TEST_SECTORS; i++) {
+        address -= flash_get_sector_size(&flash, address - 1);
+    }
+    *size = end - address;
+    return address;
+}
+
+/* At most the buffer size, in whole pages */
+static uint32_t program_size(uint32_t range_size)
+{
+    const uint32_t page_size = flash_get_page_size(&flash);
+    uint32_t size = sizeof(buffer) < range_size ? sizeof(buffer) : range_size;
+
+    size -= size % page_size;
+    TEST_ASSERT_TRUE(size > 0);
+    return size;
+}
+
+static void fill_buffer(uint8_t seed)
+{
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(seed + i * 13 + (i >> 8));
+    }
+}
+
+/* Test that an erase job erases one sector per step. */
+void flash_job_erase_test()
+{
+    uint32_t size;
+    const uint32_t address = test_range(&size);
+    flash_job_t job;
+
+    // Data in each sector
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+    for (uint32_t sector = address; sector < address + size; sector += flash_get_sector_size(&flash, sector)) {
+        TEST_ASSERT_EQUAL(0, flash_erase_sector(&flash, sector));
+        fill_buffer(0);
+        TEST_ASSERT_EQUAL(0, flash_program(&flash, sector, buffer, flash_get_page_size(&flash)));
+    }
+
+    TEST_ASSERT_EQUAL(0, flash_job_erase_init(&job, &flash, address, size));
+    for (int i = 0; i < TEST_SECTORS - 1; i++) {
+        TEST_ASSERT_EQUAL(1, flash_job_step(&job));
+    }
+    TEST_ASSERT_EQUAL(0, flash_job_step(&job));
+    TEST_ASSERT_EQUAL(0, flash_job_step(&job));
+    TEST_ASSERT_EQUAL(1, flash_is_blank(&flash, address, size));
+
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+}
+
+/* Test that a program job programs the data in chunks. */
+void flash_job_program_test()
+{
+    uint32_t range_size;
+    const uint32_t address = test_range(&range_size);
+    flash_job_t job;
+
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+    const uint32_t size = program_size(range_size);
+
+    TEST_ASSERT_EQUAL(0, flash_job_erase_init(&job, &flash, address, range_size));
+    TEST_ASSERT_EQUAL(0, flash_job_run(&job));
+
+    fill_buffer(1);
+    TEST_ASSERT_EQUAL(0, flash_job_program_init(&job, &flash, address, buffer, size));
+    TEST_ASSERT_EQUAL(0, flash_job_run(&job));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, (const uint8_t *) address, size);
+    TEST_ASSERT_EQUAL(1, flash_is_blank(&flash, address + size, range_size - size));
+
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+}
+
+static volatile int32_t job_status;
+static volatile int job_done;
+
+static void job_handler(flash_job_t *job, int32_t status)
+{
+    (void) job;
+    job_status = status;
+    job_done++;
+}
+
+/* Run the events until the job is done, returning the number of dispatches. */
+static int dispatch_job()
+{
+    int dispatches = 0;
+
+    while (job_done == 0) {
+        TEST_ASSERT_EQUAL(1, hal_event_dispatch());
+        dispatches++;
+    }
+    TEST_ASSERT_EQUAL(1, job_done);
+    TEST_ASSERT_EQUAL(0, job_status);
+    return dispatches;
+}
+
+/* Test that a job started on the event loop runs a chunk per dispatch. */
+void flash_job_event_loop_test()
+{
+    uint32_t range_size;
+    const uint32_t address = test_range(&range_size);
+    flash_job_t job;
+    int context;
+
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+    const uint32_t size = program_size(range_size);
+
+    job_done = 0;
+    TEST_ASSERT_EQUAL(0, flash_job_erase_init(&job, &flash, address, range_size));
+    TEST_ASSERT_EQUAL(0, flash_job_start(&job, job_handler, &context));
+    TEST_ASSERT_EQUAL_PTR(&context, job.context);
+    TEST_ASSERT_EQUAL(TEST_SECTORS, dispatch_job());
+
+    // One chunk per dispatch
+    const uint32_t page_size = flash_get_page_size(&flash);
+    uint32_t chunk = MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE - MBED_CONF_TARGET_FLASH_JOB_PROGRAM_CHUNK_SIZE % page_size;
+    if (chunk == 0) {
+        chunk = page_size;
+    }
+
+    job_done = 0;
+    fill_buffer(2);
+    TEST_ASSERT_EQUAL(0, flash_job_program_init(&job, &flash, address, buffer, size));
+    TEST_ASSERT_EQUAL(0, flash_job_start(&job, job_handler, NULL));
+    TEST_ASSERT_EQUAL((size + chunk - 1) / chunk, dispatch_job());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, (const uint8_t *) address, size);
+
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+}
+
+/* Test that invalid ranges are rejected. */
+void flash_job_invalid_test()
+{
+    uint32_t size;
+    const uint32_t address = test_range(&size);
+    const uint32_t end = address + size;
+    flash_job_t job;
+
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+    const uint32_t page_size = flash_get_page_size(&flash);
+
+    TEST_ASSERT_EQUAL(-1, flash_job_erase_init(&job, &flash, address + page_size, size - page_size));
+    TEST_ASSERT_EQUAL(-1, flash_job_erase_init(&job, &flash, address, size - page_size));
+    TEST_ASSERT_EQUAL(-1, flash_job_erase_init(&job, &flash, address, size + flash_get_sector_size(&flash, address)));
+    TEST_ASSERT_EQUAL(-1, flash_job_erase_init(&job, &flash, end, flash_get_sector_size(&flash, address)));
+
+    if (page_size > 1) {
+        TEST_ASSERT_EQUAL(-1, flash_job_program_init(&job, &flash, address + 1, buffer, page_size));
+        TEST_ASSERT_EQUAL(-1, flash_job_program_init(&job, &flash, address, buffer, page_size + 1));
+    }
+    TEST_ASSERT_EQUAL(-1, flash_job_program_init(&job, &flash, end, buffer, page_size));
+
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+}
+
+Case cases[] = {
+    Case("test: erase job steps.", flash_job_erase_test),
+    Case("test: program job run.", flash_job_program_test),
+    Case("test: jobs on the event loop.", flash_job_event_loop_test),
+    Case("test: invalid job ranges.", flash_job_invalid_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    greentea_init_custom_io();
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_FLASH
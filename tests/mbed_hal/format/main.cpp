@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_format.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdint.h>
+#include <string.h>
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 64
+
+static char buffer[BUFFER_SIZE];
+
+/* Check the output and the returned length of a format call. */
+#define TEST_ASSERT_FORMAT(expected, ...) \
+    do { \
+        TEST_ASSERT_EQUAL_INT(strlen(expected), mbed::format(buffer, sizeof(buffer), __VA_ARGS__)); \
+        TEST_ASSERT_EQUAL_STRING(expected, buffer); \
+    } while (0)
+
+/* Test integer conversions, with their length modifiers. */
+void format_integer_test()
+{
+    TEST_ASSERT_FORMAT("-42 7 ff FF", MBED_FORMAT_STRING("%d %u %x %X"), -42, 7u, 255, 255);
+    TEST_ASSERT_FORMAT("0 -2147483648 4294967295", MBED_FORMAT_STRING("%i %d %u"), 0, INT32_MIN, UINT32_MAX);
+    TEST_ASSERT_FORMAT("-1 255 -1", MBED_FORMAT_STRING("%hhd %hhu %hd"), 255, 255, 65535);
+    TEST_ASSERT_FORMAT("18446744073709551615 -9223372036854775808",
+                       MBED_FORMAT_STRING("%llu %lld"), UINT64_MAX, (long long)INT64_MIN);
+    TEST_ASSERT_FORMAT("12 3", MBED_FORMAT_STRING("%zu %td"), sizeof(uint32_t[3]), (ptrdiff_t)3);
+}
+
+/* Test character, string, pointer and %% conversions, and the precision of strings. */
+void format_text_test()
+{
+    TEST_ASSERT_FORMAT("100% a", MBED_FORMAT_STRING("%d%% %c"), 100, 'a');
+    TEST_ASSERT_FORMAT("abc ab a", MBED_FORMAT_STRING("%s %.2s %.*s"), "abc", "abc", 1, "abc");
+    TEST_ASSERT_FORMAT("0x1234", MBED_FORMAT_STRING("%p"), (void *)0x1234);
+    TEST_ASSERT_FORMAT("9 9", MBED_FORMAT_STRING("%5d %*d"), 9, 3, 9);
+}
+
+/* Test that the output is truncated and terminated, and the full length returned. */
+void format_truncation_test()
+{
+    char small[4];
+
+    TEST_ASSERT_EQUAL_INT(8, mbed::format(small, sizeof(small), MBED_FORMAT_STRING("%s-%d"), "abcdef", 5));
+    TEST_ASSERT_EQUAL_STRING("abc", small);
+    TEST_ASSERT_EQUAL_INT(5, mbed::format(NULL, 0, MBED_FORMAT_STRING("%d"), 12345));
+}
+
+/* Test that the output is the same as the one of minimal printf. */
+void format_snprintf_test()
+{
+    char expected[BUFFER_SIZE];
+
+    snprintf(expected, sizeof(expected), "x=%d y=%u z=%lx s=%s", -1, 1000000u, 0xDEADl, "end");
+    TEST_ASSERT_FORMAT(expected, MBED_FORMAT_STRING("x=%d y=%u z=%lx s=%s"), -1, 1000000u, 0xDEADl, "end");
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Format integer test", format_integer_test),
+    Case("Format text test", format_text_test),
+    Case("Format truncation test", format_truncation_test),
+    Case("Format snprintf test", format_snprintf_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
@@ -0,0 +1,153 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/gpio_api.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !DEVICE_INTERRUPTIN || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define DEBOUNCE_US 20000
+#define HANDLER_ID 7
+
+static gpio_irq_t irq;
+static gpio_irq_debounced_t debounced;
+static volatile unsigned int calls;
+static volatile gpio_irq_event last_event;
+
+static void debounced_handler(uint32_t id, gpio_irq_event event)
+{
+    TEST_ASSERT_EQUAL_UINT32(HANDLER_ID, id);
+    last_event = event;
+    calls++;
+}
+
+/* Initialize a debounced GPIO IRQ on the first pin of the GPIO IRQ pinmap.
+ * The edges are passed to the filter by the test, not by the pin. */
+static void debounced_init(uint32_t debounce_us)
+{
+    const PinMap *map = gpio_irq_pinmap();
+    TEST_ASSERT_TRUE(map->pin != NC);
+
+    calls = 0;
+    TEST_ASSERT_EQUAL_INT(0, gpio_irq_init_debounced(&debounced, &irq, map->pin, debounce_us, debounced_handler, HANDLER_ID));
+    gpio_irq_set_debounced(&debounced, IRQ_RISE, 1);
+}
+
+static void wait_debounce_time()
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    while ((ticker_read_us(us_ticker) - start) < 2 * DEBOUNCE_US);
+}
+
+/* Test that every edge is reported without a debounce time, which is not a hardware filter. */
+void debounce_disabled_test()
+{
+    debounced_init(0);
+    TEST_ASSERT_FALSE(gpio_irq_debounce_in_hardware(&debounced));
+
+    for (unsigned int i = 0; i < 3; i++) {
+        gpio_irq_debounce_edge(&debounced, IRQ_RISE);
+    }
+    TEST_ASSERT_EQUAL_UINT(3, calls);
+    TEST_ASSERT_FALSE(debounced.masked);
+
+    gpio_irq_free(&irq);
+}
+
+/* Test that the first edge is reported, the bounces after it are not, and
+ * the edges are enabled again after the debounce time. */
+void debounce_software_test()
+{
+    debounced_init(DEBOUNCE_US);
+    if (gpio_irq_debounce_in_hardware(&debounced)) {
+        gpio_irq_free(&irq);
+        TEST_IGNORE_MESSAGE("the pin has a hardware filter");
+    }
+
+    gpio_irq_debounce_edge(&debounced, IRQ_FALL);
+    TEST_ASSERT_EQUAL_UINT(1, calls);
+    TEST_ASSERT_EQUAL(IRQ_FALL, last_event);
+    TEST_ASSERT_TRUE(debounced.masked);
+
+    for (unsigned int i = 0; i < 3; i++) {
+        gpio_irq_debounce_edge(&debounced, IRQ_RISE);
+    }
+    TEST_ASSERT_EQUAL_UINT(1, calls);
+
+    // Enabled during the debounce time, the edge stays off until it ends
+    gpio_irq_set_debounced(&debounced, IRQ_FALL, 1);
+    TEST_ASSERT_TRUE(debounced.masked);
+
+    wait_debounce_time();
+    TEST_ASSERT_FALSE(debounced.masked);
+
+    gpio_irq_debounce_edge(&debounced, IRQ_RISE);
+    TEST_ASSERT_EQUAL_UINT(2, calls);
+    TEST_ASSERT_EQUAL(IRQ_RISE, last_event);
+
+    wait_debounce_time();
+    gpio_irq_free(&irq);
+}
+
+/* Test that the edges of a pin with a hardware filter are reported as they come. */
+void debounce_hardware_test()
+{
+    debounced_init(DEBOUNCE_US);
+    if (!gpio_irq_debounce_in_hardware(&debounced)) {
+        gpio_irq_free(&irq);
+        TEST_IGNORE_MESSAGE("the pin has no hardware filter");
+    }
+
+    for (unsigned int i = 0; i < 3; i++) {
+        gpio_irq_debounce_edge(&debounced, IRQ_RISE);
+    }
+    TEST_ASSERT_EQUAL_UINT(3, calls);
+    TEST_ASSERT_FALSE(debounced.masked);
+
+    gpio_irq_free(&irq);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("GPIO IRQ debounce disabled test", debounce_disabled_test),
+    Case("GPIO IRQ software debounce test", debounce_software_test),
+    Case("GPIO IRQ hardware debounce test", debounce_hardware_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_INTERRUPTIN || !DEVICE_USTICKER
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_hash_tests */
+/** @{*/
+
+#ifndef HASH_API_TESTS_H
+#define HASH_API_TESTS_H
+
+#include "device.h"
+
+#if DEVICE_HASH
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that HAL_HASH_IS_SUPPORTED() is true for SHA-256.
+ *
+ *  Given is platform with hardware hash support.
+ *  When HAL_HASH_IS_SUPPORTED() is evaluated for SHA-256.
+ *  Then it is true.
+ */
+void hash_is_supported_test();
+
+/** Test that the digests of the FIPS 180-4 examples are computed.
+ *
+ *  Given is platform with hardware hash support.
+ *  When the empty, one block and two block examples are hashed with each supported algorithm.
+ *  Then hal_hash_ctx_get_digest() returns the expected digest.
+ */
+void hash_calc_test();
+
+/** Test that data can be appended in several calls.
+ *
+ *  Given is platform with hardware hash support.
+ *  When data is appended one byte at a time, then in blocks around the block size.
+ *  Then hal_hash_ctx_get_digest() returns the expected digest after each call, without
+ *  modifying the context.
+ */
+void hash_calc_multi_test();
+
+/** Test that computations in different contexts can be interleaved.
+ *
+ *  Given is platform with hardware hash support.
+ *  When data is appended alternately to contexts with different algorithms,
+ *  synchronously and asynchronously.
+ *  Then hal_hash_ctx_get_digest() returns the expected digest for each context.
+ */
+void hash_ctx_interleave_test();
+
+/** Test the throughput of the hash module.
+ *
+ *  Given is a 4 KB buffer.
+ *  When its SHA-256 is computed.
+ *  Then the time taken is reported.
+ */
+void hash_benchmark_test();
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
@@ -0,0 +1,261 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "hash_api.h"
+#include "hash_api_tests.h"
+#include "hal/us_ticker_api.h"
+
+#if !DEVICE_HASH
+#error [NOT_SUPPORTED] hash not supported for this target
+#else
+
+using namespace utest::v1;
+
+static const char *const messages[] = {
+    "",
+    "abc",
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+};
+
+#define MESSAGE_COUNT (sizeof(messages) / sizeof(messages[0]))
+
+typedef struct {
+    hal_hash_algorithm_t algorithm;
+    uint8_t digests[MESSAGE_COUNT][HAL_HASH_MAX_DIGEST_SIZE];
+} TEST_CASE;
+
+static const TEST_CASE test_cases[] = {
+    {
+        HAL_HASH_SHA1, {
+            {
+                0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55, 0xbf, 0xef, 0x95, 0x60, 0x18, 0x90,
+                0xaf, 0xd8, 0x07, 0x09
+            },
+            {
+                0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+                0x9c, 0xd0, 0xd8, 0x9d
+            },
+            {
+                0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2, 0x6e, 0xba, 0xae, 0x4a, 0xa1, 0xf9, 0x51, 0x29, 0xe5,
+                0xe5, 0x46, 0x70, 0xf1
+            },
+        }
+    },
+    {
+        HAL_HASH_SHA224, {
+            {
+                0xd1, 0x4a, 0x02, 0x8c, 0x2a, 0x3a, 0x2b, 0xc9, 0x47, 0x61, 0x02, 0xbb, 0x28, 0x82, 0x34, 0xc4,
+                0x15, 0xa2, 0xb0, 0x1f, 0x82, 0x8e, 0xa6, 0x2a, 0xc5, 0xb3, 0xe4, 0x2f
+            },
+            {
+                0x23, 0x09, 0x7d, 0x22, 0x34, 0x05, 0xd8, 0x22, 0x86, 0x42, 0xa4, 0x77, 0xbd, 0xa2, 0x55, 0xb3,
+                0x2a, 0xad, 0xbc, 0xe4, 0xbd, 0xa0, 0xb3, 0xf7, 0xe3, 0x6c, 0x9d, 0xa7
+            },
+            {
+                0x75, 0x38, 0x8b, 0x16, 0x51, 0x27, 0x76, 0xcc, 0x5d, 0xba, 0x5d, 0xa1, 0xfd, 0x89, 0x01, 0x50,
+                0xb0, 0xc6, 0x45, 0x5c, 0xb4, 0xf5, 0x8b, 0x19, 0x52, 0x52, 0x25, 0x25
+            },
+        }
+    },
+    {
+        HAL_HASH_SHA256, {
+            {
+                0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+                0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+            },
+            {
+                0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+                0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+            },
+            {
+                0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+                0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+            },
+        }
+    },
+};
+
+#define TEST_CASE_COUNT (sizeof(test_cases) / sizeof(TEST_CASE))
+
+/* SHA-256 of 1000 'a' */
+static const uint8_t long_digest[] = {
+    0x41, 0xed, 0xec, 0xe4, 0x2d, 0x63, 0xe8, 0xd9, 0xbf, 0x51, 0x5a, 0x9b, 0xa6, 0x93, 0x2e, 0x1c,
+    0x20, 0xcb, 0xc9, 0xf5, 0xa5, 0xd1, 0x34, 0x64, 0x5a, 0xdb, 0x5d, 0xb1, 0xb9, 0x73, 0x7e, 0xa3
+};
+
+#define LONG_SIZE 1000
+
+/* Test that SHA-256 is supported. */
+void hash_is_supported_test()
+{
+    TEST_ASSERT_TRUE(HAL_HASH_IS_SUPPORTED(HAL_HASH_SHA256));
+}
+
+/* Test that the digests of the FIPS 180-4 examples are computed. */
+void hash_calc_test()
+{
+    for (unsigned int i = 0; i < TEST_CASE_COUNT; i++) {
+        if (!HAL_HASH_IS_SUPPORTED(test_cases[i].algorithm)) {
+            continue;
+        }
+
+        for (unsigned int m = 0; m < MESSAGE_COUNT; m++) {
+            hal_hash_ctx_t ctx;
+            uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+            hal_hash_ctx_start(&ctx, test_cases[i].algorithm);
+            hal_hash_ctx_update(&ctx, (const uint8_t *) messages[m], strlen(messages[m]));
+            hal_hash_ctx_get_digest(&ctx, digest);
+
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(test_cases[i].digests[m], digest, hal_hash_digest_size(test_cases[i].algorithm));
+        }
+    }
+}
+
+/* Test that data can be appended in several calls. */
+void hash_calc_multi_test()
+{
+    const TEST_CASE *const sha256 = &test_cases[TEST_CASE_COUNT - 1];
+    const size_t length = strlen(messages[2]);
+    hal_hash_ctx_t ctx;
+    uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+    // The second example starts with the first one
+    hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+    for (size_t k = 0; k < length; k++) {
+        hal_hash_ctx_update(&ctx, (const uint8_t *) messages[2] + k, 1);
+        if (k == 2) {
+            hal_hash_ctx_get_digest(&ctx, digest);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(sha256->digests[1], digest, sizeof(digest));
+        }
+    }
+    hal_hash_ctx_get_digest(&ctx, digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(sha256->digests[2], digest, sizeof(digest));
+
+    // Chunks ending before, on and after block boundaries
+    static const size_t chunks[] = { 63, 1, 64, 65, 127, 0, 200 };
+    static uint8_t data[LONG_SIZE];
+    memset(data, 'a', sizeof(data));
+    hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+    size_t offset = 0;
+    for (unsigned int c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        hal_hash_ctx_update(&ctx, data + offset, chunks[c]);
+        offset += chunks[c];
+    }
+    hal_hash_ctx_update(&ctx, data + offset, sizeof(data) - offset);
+    hal_hash_ctx_get_digest(&ctx, digest);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(long_digest, digest, sizeof(digest));
+}
+
+static void hash_ctx_async_handler(uint32_t id)
+{
+    (*(uint32_t *)id)++;
+}
+
+/* Test that computations in different contexts can be interleaved. */
+void hash_ctx_interleave_test()
+{
+    static uint8_t data[LONG_SIZE];
+    memset(data, 'a', sizeof(data));
+
+    for (unsigned int i = 0; i < TEST_CASE_COUNT; i++) {
+        if (!HAL_HASH_IS_SUPPORTED(test_cases[i].algorithm)) {
+            continue;
+        }
+
+        hal_hash_ctx_t ctx_a;
+        hal_hash_ctx_t ctx_b;
+        uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+        const size_t length = strlen(messages[2]);
+        hal_hash_ctx_start(&ctx_a, test_cases[i].algorithm);
+        hal_hash_ctx_start(&ctx_b, HAL_HASH_SHA256);
+
+        /* Feed both contexts alternately, one byte at a time for the first one. */
+        for (size_t k = 0; k < length; k++) {
+            hal_hash_ctx_update(&ctx_a, (const uint8_t *) messages[2] + k, 1);
+            if (k == 3) {
+                hal_hash_ctx_update(&ctx_b, data, 5);
+            }
+        }
+
+        /* Shorter than a block, so no block is hashed, then the rest. */
+        volatile uint32_t calls = 0;
+        int ret = hal_hash_ctx_update_async(&ctx_b, data + 5, 3, hash_ctx_async_handler, (uint32_t) &calls);
+        TEST_ASSERT_EQUAL(0, ret);
+        while (calls == 0);
+        ret = hal_hash_ctx_update_async(&ctx_b, data + 8, sizeof(data) - 8, hash_ctx_async_handler, (uint32_t) &calls);
+        TEST_ASSERT_EQUAL(0, ret);
+        while (calls == 1);
+        TEST_ASSERT_EQUAL(2, calls);
+
+        hal_hash_ctx_get_digest(&ctx_a, digest);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(test_cases[i].digests[2], digest, hal_hash_digest_size(test_cases[i].algorithm));
+        hal_hash_ctx_get_digest(&ctx_b, digest);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(long_digest, digest, sizeof(digest));
+    }
+}
+
+#define BENCHMARK_SIZE 4096
+
+/* Report the throughput of the hash module. */
+void hash_benchmark_test()
+{
+    static uint8_t buffer[BENCHMARK_SIZE];
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    hal_hash_ctx_t ctx;
+    uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t) i;
+    }
+
+    const uint32_t start = ticker_read(ticker);
+    hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+    hal_hash_ctx_update(&ctx, buffer, sizeof(buffer));
+    hal_hash_ctx_get_digest(&ctx, digest);
+    const uint32_t elapsed = ticker_read(ticker) - start;
+    utest_printf("SHA-256 of %u bytes: %lu us\r\n", BENCHMARK_SIZE, elapsed);
+}
+
+Case cases[] = {
+    Case("test: supported algorithms.", hash_is_supported_test),
+    Case("test: hash calculation - single input.", hash_calc_test),
+    Case("test: hash calculation - multi input.", hash_calc_multi_test),
+    Case("test: interleaved computations in contexts.", hash_ctx_interleave_test),
+    Case("test: hash benchmark.", hash_benchmark_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    greentea_init_custom_io();
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_HASH
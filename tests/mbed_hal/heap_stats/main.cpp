@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_heap_stats.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if !MBED_CONF_PLATFORM_HEAP_STATS_ENABLED
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define ALLOC_SIZE 100
+
+void heap_stats_alloc_free_test()
+{
+    mbed_stats_heap_t before;
+    mbed_stats_heap_t stats;
+
+    mbed_stats_heap_get(&before);
+
+    void *volatile data = malloc(ALLOC_SIZE);
+    TEST_ASSERT_NOT_NULL(data);
+
+    mbed_stats_heap_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(before.alloc_cnt + 1, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(before.total_alloc_cnt + 1, stats.total_alloc_cnt);
+    TEST_ASSERT_TRUE(stats.current_size >= before.current_size + ALLOC_SIZE);
+    TEST_ASSERT_TRUE(stats.max_size >= stats.current_size);
+    TEST_ASSERT_TRUE(stats.reserved_size > stats.current_size);
+
+    free(data);
+
+    mbed_stats_heap_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(before.alloc_cnt, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(before.current_size, stats.current_size);
+}
+
+void heap_stats_failure_test()
+{
+    mbed_stats_heap_t before;
+    mbed_stats_heap_t stats;
+
+    mbed_stats_heap_get(&before);
+    TEST_ASSERT_NULL(malloc(before.reserved_size));
+
+    mbed_stats_heap_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(before.alloc_fail_cnt + 1, stats.alloc_fail_cnt);
+    TEST_ASSERT_EQUAL_UINT32(before.alloc_cnt, stats.alloc_cnt);
+}
+
+void heap_stats_sites_test()
+{
+    mbed_stats_heap_site_t sites[MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES];
+    void *volatile data[2];
+
+    mbed_stats_heap_reset();
+    data[0] = malloc(ALLOC_SIZE);
+    data[1] = calloc(1, 4 * ALLOC_SIZE);
+
+    const size_t count = mbed_stats_heap_sites_get(sites, MBED_CONF_PLATFORM_HEAP_STATS_CALL_SITES);
+    free(data[0]);
+    free(data[1]);
+
+    // The calloc() call site allocated the most bytes
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL_UINT32(1, sites[0].alloc_cnt);
+    TEST_ASSERT_TRUE(sites[0].total_size >= 4 * ALLOC_SIZE);
+    TEST_ASSERT_TRUE(sites[1].total_size >= ALLOC_SIZE);
+    TEST_ASSERT_TRUE(sites[0].caller != sites[1].caller);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Heap stats alloc/free test", heap_stats_alloc_free_test),
+    Case("Heap stats failure test", heap_stats_failure_test),
+    Case("Heap stats call sites test", heap_stats_sites_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !MBED_CONF_PLATFORM_HEAP_STATS_ENABLED
@@ -0,0 +1,217 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/idle_api.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !DEVICE_SLEEP || !DEVICE_USTICKER || !DEVICE_LPTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define EVENT_ID 0x55
+#define SHORT_DELAY_US 200
+#define LONG_DELAY_US 50000
+
+static volatile uint32_t event_calls;
+static ticker_event_t event;
+
+static void event_handler(uint32_t id)
+{
+    TEST_ASSERT_EQUAL_UINT32(EVENT_ID, id);
+    event_calls++;
+}
+
+/* Insert a us ticker event, idle until it is dispatched and return the us ticker time at that point. */
+static us_timestamp_t idle_until_event(us_timestamp_t delay_us)
+{
+    const ticker_data_t *us_ticker = get_us_ticker_data();
+
+    event_calls = 0;
+    ticker_set_handler(us_ticker, event_handler);
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    ticker_insert_event_us(us_ticker, &event, start + delay_us, EVENT_ID);
+    while (event_calls == 0) {
+        hal_idle();
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, event_calls);
+    return ticker_read_us(us_ticker) - start;
+}
+
+/* Test that hal_idle returns for a close us ticker event, without deep sleep. */
+void idle_short_delay_test()
+{
+    const us_timestamp_t elapsed = idle_until_event(SHORT_DELAY_US);
+
+    TEST_ASSERT_TRUE(elapsed >= SHORT_DELAY_US);
+    TEST_ASSERT_UINT64_WITHIN(SHORT_DELAY_US, SHORT_DELAY_US, elapsed);
+}
+
+/* Test that the us ticker keeps time across deep sleep, against the lp ticker. */
+void idle_long_delay_test()
+{
+    const ticker_data_t *lp_ticker = get_lp_ticker_data();
+
+    const us_timestamp_t lp_start = ticker_read_us(lp_ticker);
+    const us_timestamp_t elapsed = idle_until_event(LONG_DELAY_US);
+    const us_timestamp_t lp_elapsed = ticker_read_us(lp_ticker) - lp_start;
+
+    const uint32_t tolerance = hal_idle_deep_sleep_latency_us() + LONG_DELAY_US / 20;
+    TEST_ASSERT_TRUE(elapsed >= LONG_DELAY_US);
+    TEST_ASSERT_UINT64_WITHIN(tolerance, LONG_DELAY_US, elapsed);
+    TEST_ASSERT_UINT64_WITHIN(tolerance, lp_elapsed, elapsed);
+}
+
+/* Test that hal_idle still returns for events while deep sleep is locked. */
+void idle_deep_sleep_lock_test()
+{
+    hal_idle_deep_sleep_lock();
+    const us_timestamp_t elapsed = idle_until_event(LONG_DELAY_US);
+    hal_idle_deep_sleep_unlock();
+
+    TEST_ASSERT_UINT64_WITHIN(LONG_DELAY_US / 20, LONG_DELAY_US, elapsed);
+}
+
+/* Test that deep sleeps are timed, and that the latency planned for covers the ones measured. */
+void idle_deep_sleep_stats_test()
+{
+    hal_idle_deep_sleep_stats_t stats;
+
+    hal_idle_deep_sleep_stats_reset();
+    hal_idle_deep_sleep_stats_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(MBED_CONF_TARGET_DEEP_SLEEP_LATENCY, hal_idle_deep_sleep_latency_us());
+
+    for (int i = 0; i < 4; i++) {
+        idle_until_event(LONG_DELAY_US);
+    }
+
+    hal_idle_deep_sleep_stats_get(&stats);
+    TEST_ASSERT_TRUE(stats.count > 0);
+    TEST_ASSERT_TRUE(stats.min_us <= stats.average_us);
+    TEST_ASSERT_TRUE(stats.average_us <= stats.max_us);
+    TEST_ASSERT_TRUE(hal_idle_deep_sleep_latency_us() >= stats.max_us);
+    // Only the first deep sleep, planned with the initial estimate, may be late
+    TEST_ASSERT_TRUE(stats.late <= 1);
+}
+
+/* Test that the locks and the time they are held are counted for their owner. */
+void idle_deep_sleep_owner_test()
+{
+    static hal_idle_deep_sleep_owner_t owner = HAL_IDLE_DEEP_SLEEP_OWNER_INIT("test");
+
+    hal_idle_deep_sleep_lock_owner(&owner);
+    hal_idle_deep_sleep_lock_owner(&owner);
+    hal_idle_deep_sleep_owners_reset();
+    TEST_ASSERT_EQUAL_UINT32(0, owner.lock_count);
+
+    hal_idle_deep_sleep_lock_owner(&owner);
+    hal_idle_deep_sleep_unlock_owner(&owner);
+    TEST_ASSERT_EQUAL_UINT32(1, owner.lock_count);
+    TEST_ASSERT_EQUAL_UINT16(2, owner.locks);
+
+    idle_until_event(LONG_DELAY_US);
+    hal_idle_deep_sleep_unlock_owner(&owner);
+    hal_idle_deep_sleep_unlock_owner(&owner);
+    TEST_ASSERT_EQUAL_UINT16(0, owner.locks);
+
+    const uint64_t held_us = hal_idle_deep_sleep_owner_held_us(&owner);
+    TEST_ASSERT_TRUE(held_us >= LONG_DELAY_US - LONG_DELAY_US / 20);
+
+    // Not held any more
+    idle_until_event(SHORT_DELAY_US);
+    TEST_ASSERT_EQUAL_UINT64(held_us, hal_idle_deep_sleep_owner_held_us(&owner));
+
+    bool listed = false;
+    for (const hal_idle_deep_sleep_owner_t *o = hal_idle_deep_sleep_owner_next(NULL); o; o = hal_idle_deep_sleep_owner_next(o)) {
+        listed |= (o == &owner);
+    }
+    TEST_ASSERT_TRUE(listed);
+}
+
+static uint32_t retention_calls[2][2];
+static uint32_t retention_sequence;
+
+static void retention_save(void *context)
+{
+    retention_calls[(uintptr_t)context][0] = ++retention_sequence;
+}
+
+static void retention_restore(void *context)
+{
+    retention_calls[(uintptr_t)context][1] = ++retention_sequence;
+}
+
+/* Test that the peripherals registered are saved before deep sleep and restored after it, in reverse order. */
+void idle_retention_test()
+{
+    static hal_idle_retention_t first;
+    static hal_idle_retention_t second;
+    hal_idle_deep_sleep_stats_t stats;
+
+    hal_idle_retention_register(&first, retention_save, retention_restore, (void *)0);
+    hal_idle_retention_register(&second, retention_save, retention_restore, (void *)1);
+    hal_idle_deep_sleep_stats_reset();
+    idle_until_event(LONG_DELAY_US);
+    hal_idle_retention_unregister(&first);
+    hal_idle_retention_unregister(&second);
+
+    hal_idle_deep_sleep_stats_get(&stats);
+    if (stats.count == 0) {
+        TEST_IGNORE_MESSAGE("No deep sleep");
+        return;
+    }
+    TEST_ASSERT_TRUE(retention_calls[0][0] < retention_calls[1][0]);
+    TEST_ASSERT_TRUE(retention_calls[1][0] < retention_calls[1][1]);
+    TEST_ASSERT_TRUE(retention_calls[1][1] < retention_calls[0][1]);
+
+    // Unregistered entries are not called any more
+    const uint32_t sequence = retention_sequence;
+    idle_until_event(LONG_DELAY_US);
+    TEST_ASSERT_EQUAL_UINT32(sequence, retention_sequence);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Idle short delay test", idle_short_delay_test),
+    Case("Idle long delay test", idle_long_delay_test),
+    Case("Idle deep sleep lock test", idle_deep_sleep_lock_test),
+    Case("Idle deep sleep statistics test", idle_deep_sleep_stats_test),
+    Case("Idle deep sleep owner test", idle_deep_sleep_owner_test),
+    Case("Idle retention test", idle_retention_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_SLEEP || !DEVICE_USTICKER || !DEVICE_LPTICKER
@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_image_verify_tests */
+/** @{*/
+
+#ifndef IMAGE_VERIFY_API_TESTS_H
+#define IMAGE_VERIFY_API_TESTS_H
+
+#include "device.h"
+
+#if DEVICE_HASH
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that the digest of an image is computed from any source.
+ *
+ *  Given is platform with hardware hash support.
+ *  When images of sizes around the chunk size are hashed in place and read
+ *  in chunks, and the start of the flash is hashed in place and with flash_read().
+ *  Then image_verify_digest() returns the digest of the whole data.
+ */
+void image_verify_digest_test();
+
+/** Test that an image is checked against its digest.
+ *
+ *  Given is platform with hardware hash support.
+ *  When an image is checked against its digest, then with one byte changed.
+ *  Then image_verify() returns 0, then -1.
+ */
+void image_verify_test();
+
+/** Test that read errors are reported.
+ *
+ *  Given is platform with hardware hash support.
+ *  When the read of the second chunk of an image fails.
+ *  Then image_verify_digest() and image_verify() return -1.
+ */
+void image_verify_read_error_test();
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "image_verify_api.h"
+#include "image_verify_api_tests.h"
+
+#if DEVICE_FLASH
+#include "flash_api.h"
+#endif
+
+#if !DEVICE_HASH
+#error [NOT_SUPPORTED] hash not supported for this target
+#else
+
+using namespace utest::v1;
+
+#define CHUNK_SIZE MBED_CONF_TARGET_IMAGE_VERIFY_CHUNK_SIZE
+#define IMAGE_SIZE (3 * CHUNK_SIZE + 100)
+#define FLASH_IMAGE_SIZE 4096
+
+/* SHA-256 of "abc" */
+static const uint8_t abc_digest[] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+
+static uint8_t image[IMAGE_SIZE];
+
+/* Image storage read with memcpy, at an offset from the image, failing from fail_address. */
+static uint32_t fail_address;
+
+static int32_t ram_read(void *obj, uint32_t address, uint8_t *data, uint32_t size)
+{
+    if (address + size > fail_address) {
+        return -1;
+    }
+    memcpy(data, (const uint8_t *) obj + address, size);
+    return 0;
+}
+
+static const image_verify_source_t mapped = { NULL, NULL };
+static const image_verify_source_t ram = { ram_read, image };
+
+static void fill_image()
+{
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    fail_address = UINT32_MAX;
+}
+
+static void reference_digest(const uint8_t *data, uint32_t size, uint8_t *digest)
+{
+    hal_hash_ctx_t ctx;
+
+    hal_hash_ctx_start(&ctx, HAL_HASH_SHA256);
+    hal_hash_ctx_update(&ctx, data, size);
+    hal_hash_ctx_get_digest(&ctx, digest);
+}
+
+/* Test that the digest of an image is computed from any source. */
+void image_verify_digest_test()
+{
+    static const uint32_t sizes[] = { 0, 1, 64, CHUNK_SIZE - 1, CHUNK_SIZE, CHUNK_SIZE + 1, 2 * CHUNK_SIZE, IMAGE_SIZE };
+    uint8_t expected[HAL_HASH_MAX_DIGEST_SIZE];
+    uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+    memcpy(image, "abc", 3);
+    fail_address = UINT32_MAX;
+    TEST_ASSERT_EQUAL(0, image_verify_digest(&ram, 0, 3, HAL_HASH_SHA256, digest));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(abc_digest, digest, sizeof(abc_digest));
+
+    fill_image();
+    for (unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        reference_digest(image, sizes[i], expected);
+
+        memset(digest, 0, sizeof(digest));
+        TEST_ASSERT_EQUAL(0, image_verify_digest(&mapped, (uint32_t) image, sizes[i], HAL_HASH_SHA256, digest));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(digest));
+
+        memset(digest, 0, sizeof(digest));
+        TEST_ASSERT_EQUAL(0, image_verify_digest(&ram, 0, sizes[i], HAL_HASH_SHA256, digest));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(digest));
+    }
+
+#if DEVICE_FLASH
+    flash_t flash;
+    TEST_ASSERT_EQUAL(0, flash_init(&flash));
+    const image_verify_source_t flash_source = { image_verify_flash_read, &flash };
+    const uint32_t start = flash_get_start_address(&flash);
+
+    TEST_ASSERT_EQUAL(0, image_verify_digest(&mapped, start, FLASH_IMAGE_SIZE, HAL_HASH_SHA256, expected));
+    TEST_ASSERT_EQUAL(0, image_verify_digest(&flash_source, start, FLASH_IMAGE_SIZE, HAL_HASH_SHA256, digest));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, sizeof(digest));
+    TEST_ASSERT_EQUAL(0, flash_free(&flash));
+#endif
+}
+
+/* Test that an image is checked against its digest. */
+void image_verify_test()
+{
+    uint8_t expected[HAL_HASH_MAX_DIGEST_SIZE];
+
+    fill_image();
+    reference_digest(image, sizeof(image), expected);
+    TEST_ASSERT_EQUAL(0, image_verify(&mapped, (uint32_t) image, sizeof(image), HAL_HASH_SHA256, expected));
+    TEST_ASSERT_EQUAL(0, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+
+    // In the last chunk, which the read source hashes after the last read
+    image[sizeof(image) - 1] ^= 1;
+    TEST_ASSERT_EQUAL(-1, image_verify(&mapped, (uint32_t) image, sizeof(image), HAL_HASH_SHA256, expected));
+    TEST_ASSERT_EQUAL(-1, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+    image[sizeof(image) - 1] ^= 1;
+
+    image[0] ^= 0x80;
+    TEST_ASSERT_EQUAL(-1, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+}
+
+/* Test that read errors are reported. */
+void image_verify_read_error_test()
+{
+    uint8_t expected[HAL_HASH_MAX_DIGEST_SIZE];
+    uint8_t digest[HAL_HASH_MAX_DIGEST_SIZE];
+
+    fill_image();
+    reference_digest(image, sizeof(image), expected);
+
+    fail_address = CHUNK_SIZE + 1;
+    TEST_ASSERT_EQUAL(-1, image_verify_digest(&ram, 0, sizeof(image), HAL_HASH_SHA256, digest));
+    TEST_ASSERT_EQUAL(-1, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+
+    fail_address = 0;
+    TEST_ASSERT_EQUAL(-1, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+
+    // The pipeline is left idle
+    fail_address = UINT32_MAX;
+    TEST_ASSERT_EQUAL(0, image_verify(&ram, 0, sizeof(image), HAL_HASH_SHA256, expected));
+}
+
+Case cases[] = {
+    Case("test: image digest from each source.", image_verify_digest_test),
+    Case("test: image check against its digest.", image_verify_test),
+    Case("test: image read errors.", image_verify_read_error_test),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    greentea_init_custom_io();
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_HASH
@@ -0,0 +1,100 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_lockfree_queue.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+using mbed::MPMCQueue;
+using mbed::SPSCQueue;
+
+#define QUEUE_SIZE 8
+#define ROUNDS 5
+
+/* Fill and drain a queue several times, so the positions wrap around the storage. */
+template<typename Queue>
+static void fill_drain(Queue &queue)
+{
+    uint32_t next_push = 0;
+    uint32_t next_pop = 0;
+    uint32_t item;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        TEST_ASSERT_TRUE(queue.empty());
+        TEST_ASSERT_FALSE(queue.pop(item));
+
+        for (int i = 0; i < QUEUE_SIZE; i++) {
+            TEST_ASSERT_TRUE(queue.push(next_push++));
+        }
+        TEST_ASSERT_EQUAL_UINT(QUEUE_SIZE, queue.size());
+        TEST_ASSERT_FALSE(queue.push(next_push));
+
+        // Take half out and put half back in
+        for (int i = 0; i < QUEUE_SIZE / 2; i++) {
+            TEST_ASSERT_TRUE(queue.pop(item));
+            TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+        }
+        for (int i = 0; i < QUEUE_SIZE / 2; i++) {
+            TEST_ASSERT_TRUE(queue.push(next_push++));
+        }
+
+        while (queue.pop(item)) {
+            TEST_ASSERT_EQUAL_UINT32(next_pop++, item);
+        }
+        TEST_ASSERT_EQUAL_UINT32(next_push, next_pop);
+    }
+}
+
+/* Test that the single producer single consumer queue is FIFO and bounded. */
+void spsc_queue_test()
+{
+    static SPSCQueue<uint32_t, QUEUE_SIZE> queue;
+
+    TEST_ASSERT_EQUAL_UINT(QUEUE_SIZE, queue.capacity());
+    fill_drain(queue);
+}
+
+/* Test that the multiple producer multiple consumer queue is FIFO and bounded. */
+void mpmc_queue_test()
+{
+    static MPMCQueue<uint32_t, QUEUE_SIZE> queue;
+
+    TEST_ASSERT_EQUAL_UINT(QUEUE_SIZE, queue.capacity());
+    fill_drain(queue);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("SPSC queue test", spsc_queue_test),
+    Case("MPMC queue test", mpmc_queue_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
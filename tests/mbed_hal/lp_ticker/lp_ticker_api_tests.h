@@ -36,6 +36,15 @@ extern "C" {
  */
 void lp_ticker_info_test(void);
 
+/** Test that the ticker interrupt only takes priorities masked by critical sections.
+ *
+ * Given ticker is available.
+ * When the ticker interrupt priority is set.
+ * Then priorities which are invalid or not masked by critical sections are rejected,
+ * and the lowest priority is applied if the target defines LP_TICKER_IRQn.
+ */
+void lp_ticker_irq_priority_test(void);
+
 /** Test that the ticker continues operating in deep sleep mode.
  *
  * Given ticker is available.
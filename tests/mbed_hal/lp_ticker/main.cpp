@@ -22,6 +22,7 @@
 #include "lp_ticker_api_tests.h"
 #include "hal/lp_ticker_api.h"
 #include "hal/us_ticker_api.h"
+#include "hal/utils/critical_section_api.h"
 
 #if !DEVICE_LPTICKER
 #error [NOT_SUPPORTED] Low power timer not supported for this target
@@ -116,6 +117,30 @@ void lp_ticker_info_test()
 
 }
 
+/* Test that the ticker interrupt only takes priorities masked by critical sections. */
+void lp_ticker_irq_priority_test()
+{
+#if defined(__NVIC_PRIO_BITS)
+    TEST_ASSERT_FALSE(lp_ticker_set_irq_priority(1UL << __NVIC_PRIO_BITS));
+#endif
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY
+    if (!hal_critical_section_masks_priority(MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY - 1)) {
+        TEST_ASSERT_FALSE(lp_ticker_set_irq_priority(MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY - 1));
+    }
+#endif
+
+#ifndef LP_TICKER_IRQn
+    TEST_IGNORE_MESSAGE("LP_TICKER_IRQn not defined for this platform");
+#else
+    const uint32_t previous_priority = NVIC_GetPriority(LP_TICKER_IRQn);
+    const uint32_t lowest_priority = (1UL << __NVIC_PRIO_BITS) - 1;
+
+    TEST_ASSERT_TRUE(lp_ticker_set_irq_priority(lowest_priority));
+    TEST_ASSERT_EQUAL_UINT32(lowest_priority, NVIC_GetPriority(LP_TICKER_IRQn));
+    NVIC_SetPriority(LP_TICKER_IRQn, previous_priority);
+#endif
+}
+
 #if DEVICE_SLEEP
 /* Test that the ticker continues operating in deep sleep mode. */
 void lp_ticker_deepsleep_test()
@@ -202,6 +227,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("lp ticker info test", lp_ticker_info_test),
+    Case("lp ticker irq priority test", lp_ticker_irq_priority_test),
 #if DEVICE_SLEEP
     Case("lp ticker sleep test", lp_ticker_deepsleep_test_setup_handler, lp_ticker_deepsleep_test, lp_ticker_deepsleep_test_teardown_handler),
 #endif
@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_mem_pool.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdint.h>
+
+using namespace utest::v1;
+
+#define BLOCK_COUNT 4
+
+MBED_MEM_POOL_DEFINE(default_pool, 3, BLOCK_COUNT);
+MBED_DTCM_POOL_DEFINE(dtcm_pool, 20, BLOCK_COUNT);
+MBED_DMA_POOL_DEFINE(dma_pool, 40, BLOCK_COUNT);
+
+#define LARGE_BLOCK_COUNT 40
+
+MBED_MEM_POOL_DEFINE(large_pool, 4, LARGE_BLOCK_COUNT);
+
+/* Allocate every block of a pool, check their alignment and that the pool is then exhausted. */
+static void allocate_all(mbed_mem_pool_t *pool, void *blocks[BLOCK_COUNT], size_t alignment)
+{
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        blocks[i] = mbed_mem_pool_alloc(pool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)blocks[i] % alignment);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(blocks[j], blocks[i]);
+        }
+    }
+    TEST_ASSERT_NULL(mbed_mem_pool_alloc(pool));
+}
+
+/* Test that a pool hands out each block once and reuses freed blocks. */
+void mem_pool_alloc_free_test()
+{
+    void *blocks[BLOCK_COUNT];
+
+    TEST_ASSERT_EQUAL_UINT(MBED_MEM_POOL_ALIGNMENT, default_pool.block_size);
+    allocate_all(&default_pool, blocks, MBED_MEM_POOL_ALIGNMENT);
+
+    mbed_mem_pool_free(&default_pool, blocks[1]);
+    mbed_mem_pool_free(&default_pool, blocks[3]);
+    mbed_mem_pool_free(&default_pool, NULL);
+    TEST_ASSERT_EQUAL_PTR(blocks[1], mbed_mem_pool_alloc(&default_pool));
+    TEST_ASSERT_EQUAL_PTR(blocks[3], mbed_mem_pool_alloc(&default_pool));
+    TEST_ASSERT_NULL(mbed_mem_pool_alloc(&default_pool));
+
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        mbed_mem_pool_free(&default_pool, blocks[i]);
+    }
+}
+
+/* Test that the blocks of each pool come from its own region with its alignment. */
+void mem_pool_region_test()
+{
+    void *blocks[BLOCK_COUNT];
+
+    TEST_ASSERT_EQUAL(MBED_MEM_REGION_DEFAULT, mbed_mem_pool_region(&default_pool));
+    TEST_ASSERT_EQUAL(MBED_MEM_REGION_DTCM, mbed_mem_pool_region(&dtcm_pool));
+    TEST_ASSERT_EQUAL(MBED_MEM_REGION_DMA, mbed_mem_pool_region(&dma_pool));
+
+    allocate_all(&dtcm_pool, blocks, MBED_MEM_POOL_ALIGNMENT);
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        TEST_ASSERT_TRUE((uint8_t *)blocks[i] >= dtcm_pool_storage);
+        TEST_ASSERT_TRUE((uint8_t *)blocks[i] < dtcm_pool_storage + sizeof(dtcm_pool_storage));
+        mbed_mem_pool_free(&dtcm_pool, blocks[i]);
+    }
+
+    // DMA blocks don't share cache lines
+    TEST_ASSERT_EQUAL_UINT(0, dma_pool.block_size % MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT);
+    allocate_all(&dma_pool, blocks, MBED_CONF_TARGET_DMA_BUFFER_ALIGNMENT);
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        TEST_ASSERT_TRUE((uint8_t *)blocks[i] >= dma_pool_storage);
+        TEST_ASSERT_TRUE((uint8_t *)blocks[i] < dma_pool_storage + sizeof(dma_pool_storage));
+        mbed_mem_pool_free(&dma_pool, blocks[i]);
+    }
+}
+
+/* Test that a pool with several bitmap words hands out exactly its blocks, also after frees. */
+void mem_pool_large_test()
+{
+    void *blocks[LARGE_BLOCK_COUNT];
+
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < LARGE_BLOCK_COUNT; i++) {
+            blocks[i] = mbed_mem_pool_alloc(&large_pool);
+            TEST_ASSERT_EQUAL_PTR(large_pool_storage + i * large_pool.block_size, blocks[i]);
+        }
+        TEST_ASSERT_NULL(mbed_mem_pool_alloc(&large_pool));
+        TEST_ASSERT_NULL(mbed_mem_pool_alloc(&large_pool));
+
+        mbed_mem_pool_free(&large_pool, blocks[LARGE_BLOCK_COUNT - 1]);
+        TEST_ASSERT_EQUAL_PTR(blocks[LARGE_BLOCK_COUNT - 1], mbed_mem_pool_alloc(&large_pool));
+
+        for (int i = 0; i < LARGE_BLOCK_COUNT; i++) {
+            mbed_mem_pool_free(&large_pool, blocks[i]);
+        }
+    }
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Memory pool alloc/free test", mem_pool_alloc_free_test),
+    Case("Memory pool region test", mem_pool_region_test),
+    Case("Memory pool large test", mem_pool_large_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
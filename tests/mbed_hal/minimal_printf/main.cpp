@@ -0,0 +1,217 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bootstrap/mbed_printf_implementation.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE 64
+#endif
+
+#define FLOATING_POINT_FAST (MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT && MBED_CONF_PLATFORM_MINIMAL_PRINTF_FLOATING_POINT_FAST)
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 64
+#define STREAM_BUFFER_SIZE MBED_CONF_PLATFORM_MINIMAL_PRINTF_STREAM_BUFFER_SIZE
+
+static char buffer[BUFFER_SIZE];
+
+static int minimal_snprintf(char *buffer, size_t length, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    const int result = mbed_minimal_formatted_string(buffer, length, format, arguments, NULL);
+    va_end(arguments);
+
+    return result;
+}
+
+/* Check the output and the returned length of a minimal printf call. */
+#define TEST_ASSERT_PRINTF(expected, ...) \
+    do { \
+        TEST_ASSERT_EQUAL_INT(strlen(expected), minimal_snprintf(buffer, sizeof(buffer), __VA_ARGS__)); \
+        TEST_ASSERT_EQUAL_STRING(expected, buffer); \
+    } while (0)
+
+/* Test 64 bit decimals around the largest 32 bit value, where the conversion
+ * switches to 32 bit arithmetic, and the largest 64 bit value. */
+void unsigned_64_bit_test()
+{
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+    TEST_ASSERT_PRINTF("4294967294 4294967295 4294967296", "%llu %llu %llu",
+                       (unsigned long long)UINT32_MAX - 1, (unsigned long long)UINT32_MAX, (unsigned long long)UINT32_MAX + 1);
+    TEST_ASSERT_PRINTF("9999999999 10000000000 42949672950", "%llu %llu %llu",
+                       9999999999ULL, 10000000000ULL, (unsigned long long)UINT32_MAX * 10);
+    TEST_ASSERT_PRINTF("18446744073709551614 18446744073709551615", "%llu %llu", UINT64_MAX - 1, UINT64_MAX);
+    TEST_ASSERT_PRINTF("-9223372036854775808 -4294967296", "%lld %lld", (long long)INT64_MIN, -4294967296LL);
+#else
+    TEST_IGNORE_MESSAGE("64 bit integers are not enabled");
+#endif
+}
+
+#ifdef _NEWLIB_VERSION
+static int minimal_fprintf(FILE *file, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+    const int result = mbed_minimal_formatted_string(NULL, INT_MAX, format, arguments, file);
+    va_end(arguments);
+
+    return result;
+}
+
+static char stream_data[4 * STREAM_BUFFER_SIZE];
+static char padding[3 * STREAM_BUFFER_SIZE];
+
+/* Test that the output written to a stream through the buffer is the output
+ * written to memory, with the end of the buffer inside a conversion or not. */
+void stream_flush_test()
+{
+    char expected[sizeof(stream_data)];
+
+    for (size_t index = 0; index < sizeof(padding) - 1; index++) {
+        padding[index] = 'a' + index % 26;
+    }
+
+    const int fills[] = {
+        0, STREAM_BUFFER_SIZE - 20, STREAM_BUFFER_SIZE - 11, STREAM_BUFFER_SIZE - 10, STREAM_BUFFER_SIZE - 5,
+        STREAM_BUFFER_SIZE - 1, STREAM_BUFFER_SIZE, STREAM_BUFFER_SIZE + 1, 2 * STREAM_BUFFER_SIZE - 3, 3 * STREAM_BUFFER_SIZE - 1
+    };
+    for (size_t index = 0; index < sizeof(fills) / sizeof(fills[0]); index++) {
+        const int size = minimal_snprintf(expected, sizeof(expected), "%.*s%u|%s", fills[index], padding, 1234567890u, "end");
+        TEST_ASSERT_EQUAL_INT(fills[index] + 14, size);
+
+        memset(stream_data, 0, sizeof(stream_data));
+        FILE *file = fmemopen(stream_data, sizeof(stream_data), "w");
+        TEST_ASSERT_NOT_NULL(file);
+        TEST_ASSERT_EQUAL_INT(size, minimal_fprintf(file, "%.*s%u|%s", fills[index], padding, 1234567890u, "end"));
+        TEST_ASSERT_EQUAL_INT(0, fclose(file));
+        TEST_ASSERT_EQUAL_STRING(expected, stream_data);
+    }
+}
+
+/* Test that a failed write, in the middle of the output or at its end, is returned as EOF. */
+void stream_error_test()
+{
+    for (int fill = 1; fill <= 2 * STREAM_BUFFER_SIZE; fill += STREAM_BUFFER_SIZE) {
+        FILE *file = fmemopen(stream_data, sizeof(stream_data), "r");
+        TEST_ASSERT_NOT_NULL(file);
+        TEST_ASSERT_EQUAL_INT(EOF, minimal_fprintf(file, "%.*s%d", fill, padding, 42));
+        TEST_ASSERT_EQUAL_INT(0, fclose(file));
+    }
+}
+#endif // _NEWLIB_VERSION
+
+#if FLOATING_POINT_FAST
+/* Test every precision of the fast path, and the configured one by default. */
+void float_precision_test()
+{
+    static const char *const expected[] = {
+        "3", "3.1", "3.14", "3.142", "3.1416", "3.14159", "3.141593", "3.1415927", "3.14159274", "3.141592741"
+    };
+
+    for (int precision = 0; precision <= 9; precision++) {
+        TEST_ASSERT_PRINTF(expected[precision], "%.*f", precision, 3.14159265f);
+    }
+    TEST_ASSERT_PRINTF(expected[MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS], "%f", 3.14159265f);
+    TEST_ASSERT_PRINTF("1.000", "%.3f", 0.9999999);
+}
+
+/* Test that ties are rounded to even, in the integer part and in the decimals. */
+void float_rounding_tie_test()
+{
+    TEST_ASSERT_PRINTF("0 2 2 -2", "%.0f %.0f %.0f %.0f", 0.5, 1.5, 2.5, -2.5);
+    TEST_ASSERT_PRINTF("0.12 0.38", "%.2f %.2f", 0.125, 0.375);
+    TEST_ASSERT_PRINTF("0.000976562", "%.9f", 1.0 / 1024);
+    TEST_ASSERT_PRINTF("0.000977", "%.6f", 1.0 / 1024);
+}
+
+/* Test that the sign of negative zero and of values rounded to zero is kept. */
+void float_negative_zero_test()
+{
+    TEST_ASSERT_PRINTF("-0.0", "%.1f", -0.0);
+    TEST_ASSERT_PRINTF("-0", "%.0f", -0.0);
+    TEST_ASSERT_PRINTF("-0.00", "%.2f", -0.001);
+    TEST_ASSERT_PRINTF("0.00", "%.2f", 0.0);
+}
+
+/* Test the values below 2^31, written by the fast path, and the values of
+ * 2^31 and above, written by the double path with the configured decimals. */
+void float_range_test()
+{
+    TEST_ASSERT_PRINTF("2147483520.0", "%.1f", 2147483520.0);
+    TEST_ASSERT_PRINTF("-2147483520.0", "%.1f", -2147483520.0);
+    TEST_ASSERT_PRINTF("1048576.500", "%.3f", 1048576.5);
+    // Values are rounded to the 24 bit mantissa of a float
+    TEST_ASSERT_PRINTF("1073741824.000", "%.3f", 1073741824.5);
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+    // 2^31 - 1 is rounded to 2^31 by the fast path, so the double path writes it
+    const double values[] = { 2147483647.0, 2147483648.0, 4294967296.0, -2147483648.0 };
+    const char *const integers[] = { "2147483647.", "2147483648.", "4294967296.", "-2147483648." };
+    for (size_t index = 0; index < sizeof(values) / sizeof(values[0]); index++) {
+        minimal_snprintf(buffer, sizeof(buffer), "%.1f", values[index]);
+        TEST_ASSERT_EQUAL_MEMORY(integers[index], buffer, strlen(integers[index]));
+    }
+#endif
+}
+#endif // FLOATING_POINT_FAST
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Minimal printf unsigned 64 bit test", unsigned_64_bit_test),
+#ifdef _NEWLIB_VERSION
+    Case("Minimal printf stream flush test", stream_flush_test),
+    Case("Minimal printf stream error test", stream_error_test),
+#endif
+#if FLOATING_POINT_FAST
+    Case("Minimal printf float precision test", float_precision_test),
+    Case("Minimal printf float rounding tie test", float_rounding_tie_test),
+    Case("Minimal printf float negative zero test", float_negative_zero_test),
+    Case("Minimal printf float range test", float_range_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
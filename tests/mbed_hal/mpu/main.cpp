@@ -19,9 +19,11 @@
 #include "greentea-client/test_env.h"
 
 #include "cmsis.h"
+#include "bootstrap/mbed_toolchain.h"
 #include <stdlib.h>
 
 #include "mpu_api.h"
+#include "cache_api.h"
 #include "mpu_test.h"
 
 #if !DEVICE_MPU
@@ -152,6 +154,125 @@ void mpu_fault_test_heap()
     free(heap_function);
 }
 
+// Addresses of the device areas, which the region tests configure but don't access
+#define UNUSED_REGION_BASE 0xA0000000UL
+
+void mpu_region_add_test()
+{
+    int ids[32];
+    int count = 0;
+
+    mbed_mpu_init();
+
+    // A base which is not aligned is not supported by any MPU
+    const mpu_region_t unaligned = {
+        UNUSED_REGION_BASE + 4, 32, MPU_ACCESS_READ_WRITE, MPU_CACHE_NONE, false, true
+    };
+    TEST_ASSERT_EQUAL(-1, mbed_mpu_region_add(&unaligned));
+
+    for (; count < 32; count++) {
+        const mpu_region_t region = {
+            UNUSED_REGION_BASE + count * 32UL, 32, MPU_ACCESS_READ_WRITE, MPU_CACHE_NONE, false, true
+        };
+        ids[count] = mbed_mpu_region_add(&region);
+        if (ids[count] == -1) {
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            TEST_ASSERT_NOT_EQUAL(ids[i], ids[count]);
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, count);
+    TEST_ASSERT_NOT_EQUAL(32, count);
+
+    // The region removed is the one added next
+    mbed_mpu_region_remove(ids[0]);
+    const mpu_region_t region = {
+        UNUSED_REGION_BASE, 32, MPU_ACCESS_READ_ONLY, MPU_CACHE_WRITE_THROUGH, true, true
+    };
+    TEST_ASSERT_EQUAL(ids[0], mbed_mpu_region_add(&region));
+
+    for (int i = 0; i < count; i++) {
+        mbed_mpu_region_remove(ids[i]);
+    }
+
+    mbed_mpu_free();
+}
+
+void mpu_region_set_test()
+{
+    mbed_mpu_init();
+
+    mpu_region_t region = {
+        UNUSED_REGION_BASE, 32, MPU_ACCESS_READ_WRITE, MPU_CACHE_WRITE_BACK, false, true
+    };
+    const int id = mbed_mpu_region_add(&region);
+    TEST_ASSERT_NOT_EQUAL(-1, id);
+
+    region.base = UNUSED_REGION_BASE + 256;
+    region.size = 256;
+    region.cache = MPU_CACHE_NONE;
+    TEST_ASSERT_EQUAL(0, mbed_mpu_region_set(id, &region));
+
+    region.base = UNUSED_REGION_BASE + 16;
+    TEST_ASSERT_EQUAL(-1, mbed_mpu_region_set(id, &region));
+
+    mbed_mpu_region_remove(id);
+
+    mbed_mpu_free();
+}
+
+static int guard_region;
+
+static void guard_fault_handler_test()
+{
+    fault_count++;
+    mbed_mpu_region_remove(guard_region);
+}
+
+void mpu_region_guard_test()
+{
+    MBED_ALIGN(32) static volatile uint32_t guarded[8];
+
+    mbed_mpu_init();
+
+    const mpu_region_t region = {
+        (uint32_t)guarded, sizeof(guarded), MPU_ACCESS_NONE, MPU_CACHE_WRITE_BACK, false, true
+    };
+    guard_region = mbed_mpu_region_add(&region);
+    TEST_ASSERT_NOT_EQUAL(-1, guard_region);
+
+    // The fault handler removes the region, so the read completes once retried
+    NVIC_SetVector(HARDFAULT_IRQn, (uint32_t)&guard_fault_handler_test);
+    NVIC_SetVector(MEMFAULT_IRQn, (uint32_t)&guard_fault_handler_test);
+    fault_count = 0;
+    (void)guarded[0];
+    TEST_ASSERT_EQUAL(1, fault_count);
+
+    mbed_mpu_free();
+}
+
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+void mpu_dma_ram_test()
+{
+    HAL_DMA_BUFFER(static volatile, buffer, HAL_DCACHE_LINE_SIZE);
+
+    mbed_mpu_init();
+    TEST_ASSERT_TRUE(hal_dma_ram_contains((const void *)buffer, sizeof(buffer)));
+
+    // Writes reach the memory without cleaning the cache
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)i;
+    }
+    SCB_InvalidateDCache_by_Addr((uint32_t *)buffer, sizeof(buffer));
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, buffer[i]);
+    }
+
+    mbed_mpu_free();
+}
+#endif
+
 utest::v1::status_t fault_override_setup(const Case *const source, const size_t index_of_case)
 {
     // Save old fault handlers and replace it with a new one
@@ -176,6 +297,11 @@ utest::v1::status_t fault_override_teardown(const Case *const source, const size
 Case cases[] = {
     Case("MPU - init", fault_override_setup, mpu_init_test, fault_override_teardown),
     Case("MPU - free", fault_override_setup, mpu_free_test, fault_override_teardown),
+    Case("MPU - region add", fault_override_setup, mpu_region_add_test, fault_override_teardown),
+    Case("MPU - region set", fault_override_setup, mpu_region_set_test, fault_override_teardown),
+#if HAL_DMA_RAM_NON_CACHEABLE || HAL_DMA_RAM_WRITE_THROUGH
+    Case("MPU - DMA RAM", fault_override_setup, mpu_dma_ram_test, fault_override_teardown),
+#endif
 #if !((__ARM_ARCH_8M_BASE__ == 1U) || \
       (__ARM_ARCH_8M_MAIN__ == 1U) || \
       (__ARM_ARCH_8_1M_MAIN__ == 1U) \
@@ -184,7 +310,8 @@ Case cases[] = {
     Case("MPU - data fault", fault_override_setup, mpu_fault_test_data, fault_override_teardown),
     Case("MPU - bss fault", fault_override_setup, mpu_fault_test_bss, fault_override_teardown),
     Case("MPU - stack fault", fault_override_setup, mpu_fault_test_stack, fault_override_teardown),
-    Case("MPU - heap fault", fault_override_setup, mpu_fault_test_heap, fault_override_teardown)
+    Case("MPU - heap fault", fault_override_setup, mpu_fault_test_heap, fault_override_teardown),
+    Case("MPU - region guard fault", fault_override_setup, mpu_region_guard_test, fault_override_teardown)
 #endif
 };
 
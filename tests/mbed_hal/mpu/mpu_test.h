@@ -81,6 +81,43 @@ void mpu_fault_test_stack(void);
  */
 void mpu_fault_test_heap(void);
 
+/** Test that regions are added until none is left
+ *
+ * Given board provides MPU.
+ * When regions are added with ::mbed_mpu_region_add.
+ * Then a different region is returned for each one, until -1 is returned
+ * because none is left, and removing a region makes it available again.
+ *
+ */
+void mpu_region_add_test(void);
+
+/** Test that regions are changed in place
+ *
+ * Given board provides MPU.
+ * When an added region is changed with ::mbed_mpu_region_set.
+ * Then the change succeeds when the MPU can configure it and fails otherwise.
+ *
+ */
+void mpu_region_set_test(void);
+
+/** Test that a region with no access guards memory
+ *
+ * Given board provides MPU.
+ * When a region with ::MPU_ACCESS_NONE is added over a RAM buffer.
+ * Then reading the buffer results in a fault.
+ *
+ */
+void mpu_region_guard_test(void);
+
+/** Test that the DMA RAM is not write-back
+ *
+ * Given board provides MPU and DMA RAM configured as non-cacheable or write-through.
+ * When ::mbed_mpu_init is called and a DMA buffer is written.
+ * Then the data is in memory without cleaning the data cache.
+ *
+ */
+void mpu_dma_ram_test(void);
+
 /**@}*/
 
 #ifdef __cplusplus
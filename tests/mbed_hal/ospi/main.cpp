@@ -367,6 +367,252 @@ void ospi_frequency_test(void)
 }
 
 
+void ospi_memory_mapped_test(void)
+{
+    ospi_status_t ret;
+    Ospi ospi;
+
+    ret = ospi_init(&ospi.handle, OPIN_0, OPIN_1, OPIN_2, OPIN_3, OPIN_4, OPIN_5, OPIN_6, OPIN_7, QSCK, QCSN, DQS, OSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8);
+    flash_init(ospi);
+
+    // leaves the written pattern in tx_buf
+    _ospi_write_read_test(ospi, WRITE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, OSPI_READ_1IO_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_CMD_READ_1IO);
+    ret = ospi_enable_memory_mapped(&ospi.handle, ospi.cmd.get());
+    ospi.cmd.set_dummy_cycles(0);
+    if (ret != OSPI_STATUS_OK) {
+        ospi_free(&ospi.handle);
+        TEST_SKIP_MESSAGE("memory-mapped mode not supported");
+    }
+
+    const uint8_t *mapped = (const uint8_t *)ospi_memory_mapped_base(&ospi.handle);
+    TEST_ASSERT_NOT_NULL(mapped);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, mapped + TEST_FLASH_ADDRESS, DATA_SIZE_256);
+
+    ret = ospi_disable_memory_mapped(&ospi.handle);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    TEST_ASSERT_NULL(ospi_memory_mapped_base(&ospi.handle));
+
+    // indirect transfers work again
+    _ospi_write_read_test(ospi, WRITE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    ospi_free(&ospi.handle);
+}
+
+
+void ospi_async_write_read_test(void)
+{
+    ospi_status_t ret;
+    Ospi ospi;
+    OspiAsync async;
+
+    ret = ospi_init(&ospi.handle, OPIN_0, OPIN_1, OPIN_2, OPIN_3, OPIN_4, OPIN_5, OPIN_6, OPIN_7, QSCK, QCSN, DQS, OSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8);
+    flash_init(ospi);
+
+    for (uint32_t i = 0; i < DATA_SIZE_256; i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+
+    ret = write_enable(ospi);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    ret = erase(SECTOR_ERASE, TEST_FLASH_ADDRESS, ospi);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    WAIT_FOR_ASYNC(SECTOR_ERASE_MAX_TIME, ospi);
+
+    ret = write_enable(ospi);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    async_reset(async);
+    ospi.cmd.build(OSPI_CMD_WRITE_1IO, TEST_FLASH_ADDRESS);
+    ret = ospi_write_async(&ospi.handle, ospi.cmd.get(), tx_buf, DATA_SIZE_256, async_handler, (uint32_t)&async);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL(sOK, async_wait(PAGE_PROG_MAX_TIME, async));
+    WAIT_FOR_ASYNC(PAGE_PROG_MAX_TIME, ospi);
+
+    memset(rx_buf, 0, sizeof(rx_buf));
+    async_reset(async);
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, OSPI_READ_1IO_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_CMD_READ_1IO, TEST_FLASH_ADDRESS);
+    ret = ospi_read_async(&ospi.handle, ospi.cmd.get(), rx_buf, DATA_SIZE_256, async_handler, (uint32_t)&async);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL(sOK, async_wait(PAGE_PROG_MAX_TIME, async));
+    ospi.cmd.set_dummy_cycles(0);
+    TEST_ASSERT_FALSE(ospi_async_active(&ospi.handle));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, rx_buf, DATA_SIZE_256);
+
+    ospi_free(&ospi.handle);
+}
+
+
+void ospi_calibration_test(void)
+{
+    ospi_status_t ret;
+    Ospi ospi;
+    ospi_capabilities_t cap;
+    ospi_calibration_t cal;
+
+    ret = ospi_init(&ospi.handle, OPIN_0, OPIN_1, OPIN_2, OPIN_3, OPIN_4, OPIN_5, OPIN_6, OPIN_7, QSCK, QCSN, DQS, OSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi_get_capabilities(&ospi.handle, &cap);
+    TEST_ASSERT_TRUE(cap.bus_widths & (1 << OSPI_CFG_BUS_SINGLE));
+    utest_printf("bus widths 0x%lx, octal DTR max %lu Hz, %lu sample delays, DQS %d\r\n",
+                 cap.bus_widths, cap.max_hz[OSPI_CFG_BUS_OCTA_DTR], cap.sample_delays, cap.dqs);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8);
+    flash_init(ospi);
+
+    // leaves the written pattern in tx_buf
+    _ospi_write_read_test(ospi, WRITE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, OSPI_READ_1IO_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_CMD_READ_1IO, TEST_FLASH_ADDRESS);
+    ret = ospi_calibrate(&ospi.handle, ospi.cmd.get(), tx_buf, OSPI_CALIBRATION_MAX_LENGTH, OSPI_MIN_FREQUENCY, &cal);
+    ospi.cmd.set_dummy_cycles(0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    TEST_ASSERT_TRUE(cal.hz >= OSPI_MIN_FREQUENCY);
+    utest_printf("calibrated at %lu Hz, sample delay %lu, DQS %d\r\n", cal.hz, cal.sample_delay, cal.dqs);
+
+    // check the memory works with the calibrated settings
+    _ospi_write_read_test(ospi, WRITE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    ospi_free(&ospi.handle);
+}
+
+
+void ospi_read_cache_test(void)
+{
+    ospi_status_t ret;
+    Ospi ospi;
+    ospi_read_cache_t cache;
+    uint8_t chunk[16];
+
+    ret = ospi_init(&ospi.handle, OPIN_0, OPIN_1, OPIN_2, OPIN_3, OPIN_4, OPIN_5, OPIN_6, OPIN_7, QSCK, QCSN, DQS, OSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8);
+    flash_init(ospi);
+
+    // Fills tx_buf and programs it at TEST_FLASH_ADDRESS
+    _ospi_write_read_test(ospi, WRITE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8, OSPI_READ_1IO_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_CMD_READ_1IO);
+    ospi_read_cache_init(&cache, &ospi.handle, ospi.cmd.get());
+
+    // Small reads, some of them across lines, several times over the same range
+    for (uint32_t i = 0; i < 64; i++) {
+        const uint32_t offset = (uint32_t)rand() % (DATA_SIZE_256 - sizeof(chunk));
+        ret = ospi_read_cache_read(&cache, TEST_FLASH_ADDRESS + offset, chunk, sizeof(chunk));
+        TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&tx_buf[offset], chunk, sizeof(chunk));
+    }
+
+    // The erase and the write through the cache invalidate the cached lines
+    ret = write_enable(ospi);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    ospi.cmd.configure(MODE_1_1_1, ADDR_SIZE_32, ALT_SIZE_8);
+    ospi.cmd.build(SECTOR_ERASE, TEST_FLASH_ADDRESS);
+    ret = ospi_read_cache_erase(&cache, ospi.cmd.get(), OSPI_SECTOR_SIZE);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    WAIT_FOR(SECTOR_ERASE_MAX_TIME, ospi);
+
+    ret = ospi_read_cache_read(&cache, TEST_FLASH_ADDRESS, chunk, sizeof(chunk));
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    for (uint32_t i = 0; i < sizeof(chunk); i++) {
+        TEST_ASSERT_EQUAL_UINT8(0xFF, chunk[i]);
+    }
+
+    for (uint32_t i = 0; i < sizeof(chunk); i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+    ret = write_enable(ospi);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    size_t length = sizeof(chunk);
+    ospi.cmd.build(OSPI_CMD_WRITE_1IO, TEST_FLASH_ADDRESS);
+    ret = ospi_read_cache_write(&cache, ospi.cmd.get(), tx_buf, &length);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    WAIT_FOR(PAGE_PROG_MAX_TIME, ospi);
+
+    ret = ospi_read_cache_read(&cache, TEST_FLASH_ADDRESS, chunk, sizeof(chunk));
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, chunk, sizeof(chunk));
+
+    ospi_free(&ospi.handle);
+}
+
+
+// Size of the PSRAM range of the bandwidth test, larger than the data cache
+#ifndef OSPI_PSRAM_TEST_SIZE
+#define OSPI_PSRAM_TEST_SIZE (64 * 1024)
+#endif
+
+void ospi_psram_bandwidth_test(void)
+{
+#if !defined(OSPI_PSRAM_CMD_READ) || !defined(OSPI_PSRAM_CMD_WRITE)
+    TEST_SKIP_MESSAGE("no PSRAM in the OSPI configuration");
+#else
+    ospi_status_t ret;
+    Ospi ospi;
+
+    ret = ospi_init(&ospi.handle, OPIN_0, OPIN_1, OPIN_2, OPIN_3, OPIN_4, OPIN_5, OPIN_6, OPIN_7, QSCK, QCSN, DQS, OSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi.cmd.configure(OSPI_PSRAM_MODE, ADDR_SIZE_32, ALT_SIZE_8, OSPI_PSRAM_READ_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_PSRAM_CMD_READ);
+    const ospi_command_t read_cmd = *ospi.cmd.get();
+    ospi.cmd.configure(OSPI_PSRAM_MODE, ADDR_SIZE_32, ALT_SIZE_8, OSPI_PSRAM_WRITE_DUMMY_CYCLE);
+    ospi.cmd.build(OSPI_PSRAM_CMD_WRITE);
+    ret = ospi_enable_memory_mapped_rw(&ospi.handle, &read_cmd, ospi.cmd.get());
+    ospi.cmd.set_dummy_cycles(0);
+    if (ret != OSPI_STATUS_OK) {
+        ospi_free(&ospi.handle);
+        TEST_SKIP_MESSAGE("memory-mapped writes not supported");
+    }
+
+    uint8_t *psram = (uint8_t *)ospi_memory_mapped_base(&ospi.handle);
+    TEST_ASSERT_NOT_NULL(psram);
+
+    for (uint32_t i = 0; i < DATA_SIZE_1024; i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    us_timestamp_t start = ticker_read_us(ticker);
+    for (uint32_t offset = 0; offset < OSPI_PSRAM_TEST_SIZE; offset += DATA_SIZE_1024) {
+        memcpy(psram + offset, tx_buf, DATA_SIZE_1024);
+    }
+    const uint32_t write_us = (uint32_t)(ticker_read_us(ticker) - start);
+
+    uint32_t read_us = 0;
+    for (uint32_t offset = 0; offset < OSPI_PSRAM_TEST_SIZE; offset += DATA_SIZE_1024) {
+        start = ticker_read_us(ticker);
+        memcpy(rx_buf, psram + offset, DATA_SIZE_1024);
+        read_us += (uint32_t)(ticker_read_us(ticker) - start);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, rx_buf, DATA_SIZE_1024);
+    }
+
+    // Bytes per millisecond are kilobytes per second
+    utest_printf("PSRAM write: %lu kB/s, read: %lu kB/s\r\n",
+                 (unsigned long)((uint64_t)OSPI_PSRAM_TEST_SIZE * 1000 / (write_us ? write_us : 1)),
+                 (unsigned long)((uint64_t)OSPI_PSRAM_TEST_SIZE * 1000 / (read_us ? read_us : 1)));
+
+    ret = ospi_disable_memory_mapped(&ospi.handle);
+    TEST_ASSERT_EQUAL(OSPI_STATUS_OK, ret);
+
+    ospi_free(&ospi.handle);
+#endif
+}
+
+
 void ospi_memory_id_test()
 {
     utest_printf("*** %s memory config loaded ***\r\n", OSPI_FLASH_CHIP_STRING);
@@ -377,6 +623,11 @@ Case cases[] = {
     Case("ospi memory id test", ospi_memory_id_test),
     Case("ospi init/free test", ospi_init_free_test),
     Case("ospi frequency setting test", ospi_frequency_test),
+    Case("ospi memory-mapped mode test", ospi_memory_mapped_test),
+    Case("ospi async write/read test", ospi_async_write_read_test),
+    Case("ospi calibration test", ospi_calibration_test),
+    Case("ospi read cache test", ospi_read_cache_test),
+    Case("ospi PSRAM bandwidth test", ospi_psram_bandwidth_test),
     //   read/x1 write/x1 - read/write block of data in single write/read operation
     //   read/x4 write/x4 - read/write block of data in adjacent locations in multiple write/read operations
     //   repeat/xN        - test repeat count (new data pattern each time)
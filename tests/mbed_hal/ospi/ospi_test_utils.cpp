@@ -147,6 +147,52 @@ OspiStatus flash_wait_for(uint32_t time_us, Ospi &ospi)
     return sUnknown;
 }
 
+void async_reset(OspiAsync &async)
+{
+    async.calls = 0;
+    async.status = OSPI_STATUS_ERROR;
+}
+
+void async_handler(uint32_t id, ospi_status_t status)
+{
+    OspiAsync *async = (OspiAsync *)id;
+    async->status = status;
+    async->calls++;
+}
+
+OspiStatus async_wait(uint32_t time_us, OspiAsync &async)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const uint32_t start = ticker_read(ticker);
+
+    while ((async.calls == 0) && ((ticker_read(ticker) - start) < time_us));
+
+    if (async.calls == 0) {
+        return sTimeout;
+    } else if ((async.calls == 1) && (async.status == OSPI_STATUS_OK)) {
+        return sOK;
+    }
+    return sError;
+}
+
+OspiStatus flash_wait_for_async(uint32_t time_us, Ospi &ospi)
+{
+    OspiAsync async;
+    async_reset(async);
+
+    ospi.cmd.build(STATUS_REG);
+    ospi_status_t ret = ospi_status_poll_async(&ospi.handle, ospi.cmd.get(), STATUS_BIT_WIP, 0, async_handler, (uint32_t)&async);
+    if (ret != OSPI_STATUS_OK) {
+        return sError;
+    }
+
+    OspiStatus status = async_wait(time_us, async);
+    if (status == sTimeout) {
+        ospi_abort_async(&ospi.handle);
+    }
+    return status;
+}
+
 void flash_init(Ospi &ospi)
 {
     uint8_t status[OSPI_STATUS_REG_SIZE];
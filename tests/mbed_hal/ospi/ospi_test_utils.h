@@ -159,6 +159,16 @@ ospi_status_t write_register(uint32_t cmd, uint8_t *buf, uint32_t size, Ospi &q)
 
 OspiStatus flash_wait_for(uint32_t time_us, Ospi &ospi);
 
+struct OspiAsync {
+    volatile uint32_t calls;
+    volatile ospi_status_t status;
+};
+
+void async_reset(OspiAsync &async);
+void async_handler(uint32_t id, ospi_status_t status);
+OspiStatus async_wait(uint32_t time_us, OspiAsync &async);
+OspiStatus flash_wait_for_async(uint32_t time_us, Ospi &ospi);
+
 void flash_init(Ospi &ospi);
 
 ospi_status_t write_enable(Ospi &ospi);
@@ -181,6 +191,7 @@ bool is_octa_mode(ospi_bus_width_t inst_width, ospi_bus_width_t addr_width, ospi
 bool is_octa_dtr_mode(ospi_bus_width_t inst_width, ospi_bus_width_t addr_width, ospi_bus_width_t data_width);
 
 #define  WAIT_FOR(timeout, q)   TEST_ASSERT_EQUAL_MESSAGE(sOK, flash_wait_for(timeout, q), "flash_wait_for failed!!!")
+#define  WAIT_FOR_ASYNC(timeout, q)   TEST_ASSERT_EQUAL_MESSAGE(sOK, flash_wait_for_async(timeout, q), "flash_wait_for_async failed!!!")
 
 
 #endif // MBED_OSPI_TEST_UTILS_H
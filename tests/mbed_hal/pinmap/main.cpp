@@ -74,6 +74,9 @@ const pinmap_info_t pinmap_functions[] = {
     PINMAP_TEST_ENTRY(serial_cts_pinmap),
     PINMAP_TEST_ENTRY(serial_rts_pinmap),
 #endif
+#if DEVICE_SERIAL_RS485
+    PINMAP_TEST_ENTRY(serial_de_pinmap),
+#endif
 #endif
 #if DEVICE_SPI
     PINMAP_TEST_ENTRY(spi_master_mosi_pinmap),
@@ -109,8 +112,97 @@ void pinmap_validation()
     }
 }
 
+static const PinMap solver_map_a[] = {
+    {(PinName)1, 0, 0}, {(PinName)2, 0, 0}, {(PinName)3, 1, 0}, {NC, (int) NC, 0}
+};
+static const PinMap solver_map_b[] = {
+    {(PinName)1, 0, 0}, {(PinName)2, 0, 0}, {(PinName)4, 0, 0}, {NC, (int) NC, 0}
+};
+static const PinMap solver_map_c[] = {
+    {(PinName)1, 0, 0}, {(PinName)5, 1, 0}, {NC, (int) NC, 0}
+};
+
+static bool count_combination(void *context)
+{
+    (*(uint32_t *)context)++;
+    return true;
+}
+
+void pinmap_find_peripheral_pins_test()
+{
+    const PinName whitelist_pins[] = {(PinName)1, (PinName)2, (PinName)3, (PinName)4, (PinName)5};
+    const PinName blacklist_pins[] = {(PinName)4};
+    const PinList whitelist = {sizeof(whitelist_pins) / sizeof(whitelist_pins[0]), whitelist_pins};
+    const PinList blacklist = {sizeof(blacklist_pins) / sizeof(blacklist_pins[0]), blacklist_pins};
+    const PinList no_pins = {0, NULL};
+    const PinMap *maps[] = {solver_map_a, solver_map_b, solver_map_c};
+    PinName a = NC;
+    PinName b = NC;
+    PinName c = NC;
+    PinName *pins[] = {&a, &b, &c};
+
+    // c can only be 1, which leaves 2 for a and b
+    TEST_ASSERT_FALSE(pinmap_find_peripheral_pins(&whitelist, &blacklist, 0, maps, pins, 3));
+    TEST_ASSERT_TRUE(pinmap_find_peripheral_pins(&whitelist, &no_pins, 0, maps, pins, 3));
+    TEST_ASSERT_EQUAL(2, a);
+    TEST_ASSERT_EQUAL(4, b);
+    TEST_ASSERT_EQUAL(1, c);
+
+    uint32_t calls = 0;
+    a = b = c = NC;
+    TEST_ASSERT_EQUAL(1, pinmap_find_all_peripheral_pins(&whitelist, &no_pins, 0, maps, pins, 3, count_combination, &calls));
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL(NC, a);
+
+    // without c, a and b take any two distinct pins of {1, 2} x {1, 2, 4}
+    calls = 0;
+    TEST_ASSERT_EQUAL(4, pinmap_find_all_peripheral_pins(&whitelist, &no_pins, 0, maps, pins, 2, count_combination, &calls));
+    TEST_ASSERT_EQUAL(4, calls);
+
+    // pins already set are kept and not reused
+    a = (PinName)2;
+    calls = 0;
+    TEST_ASSERT_EQUAL(2, pinmap_find_all_peripheral_pins(&whitelist, &no_pins, 0, maps, pins, 2, count_combination, &calls));
+    TEST_ASSERT_EQUAL(2, a);
+    TEST_ASSERT_EQUAL(NC, b);
+}
+
+void pinmap_index_find_test()
+{
+    static const PinMap map[] = {
+        {(PinName)3, 1, 0}, {(PinName)1, 0, 0}, {(PinName)1, 1, 1}, {(PinName)7, 2, 0}, {NC, (int) NC, 0}
+    };
+    static const PinMap sorted[] = {
+        {(PinName)1, 0, 0}, {(PinName)1, 1, 1}, {(PinName)3, 1, 0}, {(PinName)7, 2, 0}, {NC, (int) NC, 0}
+    };
+    const PinMapIndex index = {map, sorted, 4};
+
+    // equal pins resolve to the first one, as a linear scan of map does
+    TEST_ASSERT_EQUAL_PTR(&sorted[0], pinmap_index_find(&index, (PinName)1));
+    TEST_ASSERT_EQUAL_PTR(&sorted[2], pinmap_index_find(&index, (PinName)3));
+    TEST_ASSERT_EQUAL_PTR(&sorted[3], pinmap_index_find(&index, (PinName)7));
+    TEST_ASSERT_NULL(pinmap_index_find(&index, (PinName)0));
+    TEST_ASSERT_NULL(pinmap_index_find(&index, (PinName)2));
+    TEST_ASSERT_NULL(pinmap_index_find(&index, (PinName)8));
+
+    // target pin maps give the same results whether they are indexed or not
+    for (size_t i = 0; i < sizeof(pinmap_functions) / sizeof(pinmap_functions[0]) - 1; i++) {
+        const PinMap *target_map = pinmap_functions[i].function();
+        for (const PinMap *entry = target_map; entry->pin != NC; entry++) {
+            const PinMap *first = target_map;
+            while (first->pin != entry->pin) {
+                first++;
+            }
+            TEST_ASSERT_EQUAL(first->peripheral, pinmap_find_peripheral(entry->pin, target_map));
+            TEST_ASSERT_EQUAL(first->function, pinmap_find_function(entry->pin, target_map));
+        }
+    }
+}
+
 Case cases[] = {
-    Case("pinmap - validation", pinmap_validation)
+    Case("pinmap - validation", pinmap_validation),
+    Case("pinmap - find peripheral pins", pinmap_find_peripheral_pins_test),
+    Case("pinmap - sorted index lookup", pinmap_index_find_test)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -26,6 +26,7 @@
 
 #include "mbed.h"
 #include "qspi_api.h"
+#include "qspi_sfdp_api.h"
 #include "hal/us_ticker_api.h"
 
 
@@ -363,6 +364,252 @@ void qspi_frequency_test(void)
 }
 
 
+void qspi_memory_mapped_test(void)
+{
+    qspi_status_t ret;
+    Qspi qspi;
+
+    ret = qspi_init(&qspi.handle, QPIN_0, QPIN_1, QPIN_2, QPIN_3, QSCK, QCSN, QSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    flash_init(qspi);
+
+    // leaves the written pattern in tx_buf
+    _qspi_write_read_test(qspi, WRITE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, QSPI_READ_1IO_DUMMY_CYCLE);
+    qspi.cmd.build(QSPI_CMD_READ_1IO);
+    ret = qspi_enable_memory_mapped(&qspi.handle, qspi.cmd.get());
+    qspi.cmd.set_dummy_cycles(0);
+    if (ret != QSPI_STATUS_OK) {
+        qspi_free(&qspi.handle);
+        TEST_SKIP_MESSAGE("memory-mapped mode not supported");
+    }
+
+    const uint8_t *mapped = (const uint8_t *)qspi_memory_mapped_base(&qspi.handle);
+    TEST_ASSERT_NOT_NULL(mapped);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, mapped + TEST_FLASH_ADDRESS, DATA_SIZE_256);
+
+    ret = qspi_disable_memory_mapped(&qspi.handle);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    TEST_ASSERT_NULL(qspi_memory_mapped_base(&qspi.handle));
+
+    // indirect transfers work again
+    _qspi_write_read_test(qspi, WRITE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    qspi_free(&qspi.handle);
+}
+
+
+void qspi_async_write_read_test(void)
+{
+    qspi_status_t ret;
+    Qspi qspi;
+    QspiAsync async;
+
+    ret = qspi_init(&qspi.handle, QPIN_0, QPIN_1, QPIN_2, QPIN_3, QSCK, QCSN, QSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    flash_init(qspi);
+
+    for (uint32_t i = 0; i < DATA_SIZE_256; i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+
+    ret = write_enable(qspi);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    ret = erase(SECTOR_ERASE, TEST_FLASH_ADDRESS, qspi);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    WAIT_FOR_ASYNC(SECTOR_ERASE_MAX_TIME, qspi);
+
+    ret = write_enable(qspi);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    async_reset(async);
+    qspi.cmd.build(QSPI_CMD_WRITE_1IO, TEST_FLASH_ADDRESS);
+    ret = qspi_write_async(&qspi.handle, qspi.cmd.get(), tx_buf, DATA_SIZE_256, async_handler, (uint32_t)&async);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL(sOK, async_wait(PAGE_PROG_MAX_TIME, async));
+    WAIT_FOR_ASYNC(PAGE_PROG_MAX_TIME, qspi);
+
+    memset(rx_buf, 0, sizeof(rx_buf));
+    async_reset(async);
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, QSPI_READ_1IO_DUMMY_CYCLE);
+    qspi.cmd.build(QSPI_CMD_READ_1IO, TEST_FLASH_ADDRESS);
+    ret = qspi_read_async(&qspi.handle, qspi.cmd.get(), rx_buf, DATA_SIZE_256, async_handler, (uint32_t)&async);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL(sOK, async_wait(PAGE_PROG_MAX_TIME, async));
+    qspi.cmd.set_dummy_cycles(0);
+    TEST_ASSERT_FALSE(qspi_async_active(&qspi.handle));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, rx_buf, DATA_SIZE_256);
+
+    qspi_free(&qspi.handle);
+}
+
+
+void qspi_command_sequence_test(void)
+{
+    qspi_status_t ret;
+    Qspi qspi;
+
+    ret = qspi_init(&qspi.handle, QPIN_0, QPIN_1, QPIN_2, QPIN_3, QSCK, QCSN, QSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    flash_init(qspi);
+
+    for (uint32_t i = 0; i < DATA_SIZE_256; i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+
+    // Write enable, erase or program, then wait for the write-in-progress bit to clear
+    qspi_step_t steps[3] = {};
+    steps[0].type = QSPI_STEP_TRANSFER;
+    qspi.cmd.build(QSPI_CMD_WREN);
+    steps[0].command = *qspi.cmd.get();
+    steps[2].type = QSPI_STEP_POLL;
+    qspi.cmd.build(STATUS_REG);
+    steps[2].command = *qspi.cmd.get();
+    steps[2].poll_mask = STATUS_BIT_WIP;
+    steps[2].poll_match = 0;
+
+    steps[1].type = QSPI_STEP_TRANSFER;
+    qspi.cmd.build(SECTOR_ERASE, TEST_FLASH_ADDRESS);
+    steps[1].command = *qspi.cmd.get();
+    ret = qspi_command_sequence(&qspi.handle, steps, 3);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    steps[1].type = QSPI_STEP_WRITE;
+    qspi.cmd.build(QSPI_CMD_WRITE_1IO, TEST_FLASH_ADDRESS);
+    steps[1].command = *qspi.cmd.get();
+    steps[1].tx_data = tx_buf;
+    steps[1].tx_size = DATA_SIZE_256;
+    ret = qspi_command_sequence(&qspi.handle, steps, 3);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    memset(rx_buf, 0, sizeof(rx_buf));
+    qspi_step_t read_step = {};
+    read_step.type = QSPI_STEP_READ;
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, QSPI_READ_1IO_DUMMY_CYCLE);
+    qspi.cmd.build(QSPI_CMD_READ_1IO, TEST_FLASH_ADDRESS);
+    read_step.command = *qspi.cmd.get();
+    read_step.rx_data = rx_buf;
+    read_step.rx_size = DATA_SIZE_256;
+    ret = qspi_command_sequence(&qspi.handle, &read_step, 1);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    qspi.cmd.set_dummy_cycles(0);
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, rx_buf, DATA_SIZE_256);
+
+    qspi_free(&qspi.handle);
+}
+
+void qspi_read_cache_test(void)
+{
+    qspi_status_t ret;
+    Qspi qspi;
+    qspi_read_cache_t cache;
+    uint8_t chunk[16];
+
+    ret = qspi_init(&qspi.handle, QPIN_0, QPIN_1, QPIN_2, QPIN_3, QSCK, QCSN, QSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    flash_init(qspi);
+
+    // Fills tx_buf and programs it at TEST_FLASH_ADDRESS
+    _qspi_write_read_test(qspi, WRITE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, QSPI_READ_1IO_DUMMY_CYCLE);
+    qspi.cmd.build(QSPI_CMD_READ_1IO);
+    qspi_read_cache_init(&cache, &qspi.handle, qspi.cmd.get());
+
+    // Small reads, some of them across lines, several times over the same range
+    for (uint32_t i = 0; i < 64; i++) {
+        const uint32_t offset = (uint32_t)rand() % (DATA_SIZE_256 - sizeof(chunk));
+        ret = qspi_read_cache_read(&cache, TEST_FLASH_ADDRESS + offset, chunk, sizeof(chunk));
+        TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&tx_buf[offset], chunk, sizeof(chunk));
+    }
+
+    // The erase and the write through the cache invalidate the cached lines
+    ret = write_enable(qspi);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    qspi.cmd.build(SECTOR_ERASE, TEST_FLASH_ADDRESS);
+    ret = qspi_read_cache_erase(&cache, qspi.cmd.get(), QSPI_SECTOR_SIZE);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    WAIT_FOR(SECTOR_ERASE_MAX_TIME, qspi);
+
+    ret = qspi_read_cache_read(&cache, TEST_FLASH_ADDRESS, chunk, sizeof(chunk));
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    for (uint32_t i = 0; i < sizeof(chunk); i++) {
+        TEST_ASSERT_EQUAL_UINT8(0xFF, chunk[i]);
+    }
+
+    for (uint32_t i = 0; i < sizeof(chunk); i++) {
+        tx_buf[i] = (uint8_t)(rand() & 0xFF);
+    }
+    ret = write_enable(qspi);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    size_t length = sizeof(chunk);
+    qspi.cmd.build(QSPI_CMD_WRITE_1IO, TEST_FLASH_ADDRESS);
+    ret = qspi_read_cache_write(&cache, qspi.cmd.get(), tx_buf, &length);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    WAIT_FOR(PAGE_PROG_MAX_TIME, qspi);
+
+    ret = qspi_read_cache_read(&cache, TEST_FLASH_ADDRESS, chunk, sizeof(chunk));
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, chunk, sizeof(chunk));
+
+    qspi_free(&qspi.handle);
+}
+
+void qspi_sfdp_test(void)
+{
+    qspi_status_t ret;
+    Qspi qspi;
+    qspi_sfdp_params_t params;
+
+    ret = qspi_init(&qspi.handle, QPIN_0, QPIN_1, QPIN_2, QPIN_3, QSCK, QCSN, QSPI_COMMON_MAX_FREQUENCY, 0);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+
+    qspi.cmd.configure(MODE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8);
+    flash_init(qspi);
+
+    ret = qspi_sfdp_read_params(&qspi.handle, &params);
+    if (ret != QSPI_STATUS_OK) {
+        qspi_free(&qspi.handle);
+        TEST_SKIP_MESSAGE("flash without SFDP tables");
+    }
+
+    // The parameters match the ones of the flash configuration
+    TEST_ASSERT_EQUAL_UINT32(QSPI_PAGE_SIZE, params.page_size);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)QSPI_SECTOR_COUNT * QSPI_SECTOR_SIZE, params.size);
+    bool sector_erase = false;
+    for (int i = 0; i < QSPI_SFDP_ERASE_TYPES; i++) {
+        sector_erase |= params.erase[i].size == QSPI_SECTOR_SIZE;
+    }
+    TEST_ASSERT_TRUE(sector_erase);
+
+    // Fills tx_buf and programs it at TEST_FLASH_ADDRESS
+    _qspi_write_read_test(qspi, WRITE_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, WRITE_SINGLE, READ_1_1_1, ADDR_SIZE_24, ALT_SIZE_8, READ_SINGLE, TEST_REPEAT_SINGLE, DATA_SIZE_256, TEST_FLASH_ADDRESS);
+
+    // The fastest read mode reads the same data
+    ret = qspi_sfdp_enable_quad(&qspi.handle, &params);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    memset(rx_buf, 0, sizeof(rx_buf));
+    size_t length = DATA_SIZE_256;
+    params.read_cmd.address.value = TEST_FLASH_ADDRESS;
+    ret = qspi_read(&qspi.handle, &params.read_cmd, rx_buf, &length);
+    TEST_ASSERT_EQUAL(QSPI_STATUS_OK, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buf, rx_buf, DATA_SIZE_256);
+
+    qspi_free(&qspi.handle);
+}
+
 void qspi_memory_id_test()
 {
     utest_printf("*** %s memory config loaded ***\r\n", QSPI_FLASH_CHIP_STRING);
@@ -373,6 +620,11 @@ Case cases[] = {
     Case("qspi memory id test", qspi_memory_id_test),
     Case("qspi init/free test", qspi_init_free_test),
     Case("qspi frequency setting test", qspi_frequency_test),
+    Case("qspi memory-mapped mode test", qspi_memory_mapped_test),
+    Case("qspi async write/read test", qspi_async_write_read_test),
+    Case("qspi command sequence test", qspi_command_sequence_test),
+    Case("qspi read cache test", qspi_read_cache_test),
+    Case("qspi SFDP parameters test", qspi_sfdp_test),
     //   read/x1 write/x1 - read/write block of data in single write/read operation
     //   read/x4 write/x4 - read/write block of data in adjacent locations in multiple write/read operations
     //   repeat/xN        - test repeat count (new data pattern each time)
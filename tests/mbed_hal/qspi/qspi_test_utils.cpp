@@ -118,6 +118,52 @@ QspiStatus flash_wait_for(uint32_t time_us, Qspi &qspi)
     return sUnknown;
 }
 
+void async_reset(QspiAsync &async)
+{
+    async.calls = 0;
+    async.status = QSPI_STATUS_ERROR;
+}
+
+void async_handler(uint32_t id, qspi_status_t status)
+{
+    QspiAsync *async = (QspiAsync *)id;
+    async->status = status;
+    async->calls++;
+}
+
+QspiStatus async_wait(uint32_t time_us, QspiAsync &async)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const uint32_t start = ticker_read(ticker);
+
+    while ((async.calls == 0) && ((ticker_read(ticker) - start) < time_us));
+
+    if (async.calls == 0) {
+        return sTimeout;
+    } else if ((async.calls == 1) && (async.status == QSPI_STATUS_OK)) {
+        return sOK;
+    }
+    return sError;
+}
+
+QspiStatus flash_wait_for_async(uint32_t time_us, Qspi &qspi)
+{
+    QspiAsync async;
+    async_reset(async);
+
+    qspi.cmd.build(STATUS_REG);
+    qspi_status_t ret = qspi_status_poll_async(&qspi.handle, qspi.cmd.get(), STATUS_BIT_WIP, 0, async_handler, (uint32_t)&async);
+    if (ret != QSPI_STATUS_OK) {
+        return sError;
+    }
+
+    QspiStatus status = async_wait(time_us, async);
+    if (status == sTimeout) {
+        qspi_abort_async(&qspi.handle);
+    }
+    return status;
+}
+
 void flash_init(Qspi &qspi)
 {
     uint8_t status[QSPI_STATUS_REG_SIZE];
@@ -145,6 +145,16 @@ qspi_status_t write_register(uint32_t cmd, uint8_t *buf, uint32_t size, Qspi &q)
 
 QspiStatus flash_wait_for(uint32_t time_us, Qspi &qspi);
 
+struct QspiAsync {
+    volatile uint32_t calls;
+    volatile qspi_status_t status;
+};
+
+void async_reset(QspiAsync &async);
+void async_handler(uint32_t id, qspi_status_t status);
+QspiStatus async_wait(uint32_t time_us, QspiAsync &async);
+QspiStatus flash_wait_for_async(uint32_t time_us, Qspi &qspi);
+
 void flash_init(Qspi &qspi);
 
 qspi_status_t write_enable(Qspi &qspi);
@@ -165,6 +175,7 @@ bool is_dual_mode(qspi_bus_width_t inst_width, qspi_bus_width_t addr_width, qspi
 bool is_quad_mode(qspi_bus_width_t inst_width, qspi_bus_width_t addr_width, qspi_bus_width_t data_width);
 
 #define  WAIT_FOR(timeout, q)   TEST_ASSERT_EQUAL_MESSAGE(sOK, flash_wait_for(timeout, q), "flash_wait_for failed!!!")
+#define  WAIT_FOR_ASYNC(timeout, q)   TEST_ASSERT_EQUAL_MESSAGE(sOK, flash_wait_for_async(timeout, q), "flash_wait_for_async failed!!!")
 
 
 #endif // MBED_QSPI_TEST_UTILS_H
@@ -231,6 +231,81 @@ void rtc_enabled_test()
     RealTimeClock::free();
 }
 
+/* Test that ::rtc_read_subseconds returns the seconds and the sub-seconds read together. */
+void rtc_subseconds_test()
+{
+    RealTimeClock::init();
+    RealTimeClock::write(RealTimeClock::time_point(100s));
+
+    const uint32_t frequency = rtc_subsecond_frequency();
+    TEST_ASSERT_NOT_EQUAL(0, frequency);
+
+    time_t last_seconds;
+    uint32_t last_subseconds = rtc_read_subseconds(&last_seconds);
+    const time_t stop = last_seconds + 2;
+    while (last_seconds < stop) {
+        time_t seconds;
+        const uint32_t subseconds = rtc_read_subseconds(&seconds);
+
+        TEST_ASSERT(subseconds < frequency);
+        TEST_ASSERT(seconds > last_seconds || (seconds == last_seconds && subseconds >= last_subseconds));
+        last_seconds = seconds;
+        last_subseconds = subseconds;
+    }
+
+    RealTimeClock::free();
+}
+
+mstd::atomic_int alarm_count;
+
+void count_alarm(void)
+{
+    alarm_count++;
+}
+
+/* Test that ::rtc_set_alarm calls the handler at the time of the alarm. */
+void rtc_alarm_test()
+{
+    RealTimeClock::init();
+    RealTimeClock::write(RealTimeClock::time_point(100s));
+    alarm_count = 0;
+
+    /* The alarm is at half a second from a whole second, to check the sub-seconds. */
+    const uint32_t frequency = rtc_subsecond_frequency();
+    if (rtc_set_alarm(102, frequency / 2, count_alarm) != 0) {
+        RealTimeClock::free();
+        TEST_SKIP_MESSAGE("RTC alarm not supported");
+        return;
+    }
+
+    /* Deep sleep is allowed, only the alarm wakes the target up. Wait for
+     * the serial buffers to flush as in rtc_sleep_test_support(). */
+    ThisThread::sleep_for(10ms);
+    TEST_ASSERT(sleep_manager_can_deep_sleep_test_check());
+    while (alarm_count == 0) {
+        sleep();
+    }
+
+    time_t seconds;
+    const uint32_t subseconds = rtc_read_subseconds(&seconds);
+    TEST_ASSERT_EQUAL(1, alarm_count.load());
+    TEST_ASSERT_EQUAL(102, seconds);
+    TEST_ASSERT(subseconds >= frequency / 2);
+
+    /* A canceled alarm is not called. */
+    TEST_ASSERT_EQUAL(0, rtc_set_alarm(seconds + 1, 0, count_alarm));
+    rtc_cancel_alarm();
+    ThisThread::sleep_for(2s);
+    TEST_ASSERT_EQUAL(1, alarm_count.load());
+
+    /* An alarm in the past is called right away. */
+    TEST_ASSERT_EQUAL(0, rtc_set_alarm(1, 0, count_alarm));
+    wait_us(1000);
+    TEST_ASSERT_EQUAL(2, alarm_count.load());
+
+    RealTimeClock::free();
+}
+
 Case cases[] = {
     Case("RTC - init", rtc_init_test),
 #if DEVICE_LPTICKER
@@ -242,6 +317,8 @@ Case cases[] = {
     Case("RTC - accuracy", rtc_accuracy_test),
     Case("RTC - write/read", rtc_write_read_test),
     Case("RTC - enabled", rtc_enabled_test),
+    Case("RTC - subseconds", rtc_subseconds_test),
+    Case("RTC - alarm", rtc_alarm_test),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -102,6 +102,24 @@ void rtc_write_read_test(void);
  */
 void rtc_enabled_test(void);
 
+/** Test that ::rtc_read_subseconds returns the seconds and the sub-seconds read together.
+ *
+ *  Given platform provides Real Time Clock.
+ *  When the time is read with rtc_read_subseconds repeatedly for a few seconds.
+ *  Then the time never goes backwards and the sub-seconds are less than rtc_subsecond_frequency.
+ *
+ */
+void rtc_subseconds_test(void);
+
+/** Test that ::rtc_set_alarm calls the handler at the time of the alarm.
+ *
+ *  Given platform provides Real Time Clock with alarms.
+ *  When an alarm is set in the future and the target deep sleeps, or the alarm is canceled.
+ *  Then the handler is called once at the time of the alarm, or not at all when canceled.
+ *
+ */
+void rtc_alarm_test(void);
+
 /**@}*/
 
 #ifdef __cplusplus
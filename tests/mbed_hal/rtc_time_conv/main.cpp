@@ -33,7 +33,7 @@ using namespace utest::v1;
 static rtc_leap_year_support_t rtc_leap_year_support;
 
 /*
- * regular is_leap_year, see platform/mbed_mktime.c for the optimised version
+ * regular is_leap_year, see bootstrap/mbed_mktime.c for the optimised version
  */
 bool is_leap_year(int year)
 {
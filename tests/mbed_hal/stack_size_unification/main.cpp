@@ -18,6 +18,8 @@
 #include "greentea-client/test_env.h"
 #include "unity.h"
 #include "utest.h"
+#include "mbed_boot.h"
+#include "mbed_stack_stats.h"
 
 #ifdef TARGET_RENESAS
 #error [NOT_SUPPORTED] Cortex-A target not supported for this test
@@ -57,6 +59,37 @@ void stack_size_unification_test()
 #endif
 }
 
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+#define STACK_USE_SIZE 512
+
+MBED_NOINLINE static uint32_t use_stack()
+{
+    volatile uint8_t buffer[STACK_USE_SIZE];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)i;
+    }
+    return buffer[STACK_USE_SIZE - 1];
+}
+
+/* Test the high-water mark of the ISR stack follows its usage.
+ *
+ * The stack is painted again, so the mark starts from the current usage, then
+ * grows by at least the size of a buffer on the stack.
+ */
+void stack_high_water_test()
+{
+    mbed_stack_paint();
+    const uint32_t before = mbed_stack_high_water();
+    TEST_ASSERT_TRUE(before < mbed_stack_isr_size);
+
+    TEST_ASSERT_EQUAL_UINT32(STACK_USE_SIZE - 1, use_stack());
+    const uint32_t after = mbed_stack_high_water();
+    TEST_ASSERT_TRUE(after >= before + STACK_USE_SIZE);
+    TEST_ASSERT_TRUE(after <= mbed_stack_isr_size);
+    utest_printf("ISR stack high-water mark: %lu of %lu bytes\n", (unsigned long)after, (unsigned long)mbed_stack_isr_size);
+}
+#endif
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -64,7 +97,10 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 }
 
 Case cases[] = {
-    Case("Stack size unification test", stack_size_unification_test)
+    Case("Stack size unification test", stack_size_unification_test),
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+    Case("Stack high-water test", stack_high_water_test),
+#endif
 };
 
 Specification specification(test_setup, cases);
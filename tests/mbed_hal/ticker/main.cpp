@@ -16,6 +16,7 @@
 
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
 
 #include "utest/utest.h"
@@ -45,6 +46,8 @@ struct ticker_interface_stub_t {
     unsigned int set_interrupt_call;
     unsigned int fire_interrupt_call;
     unsigned int get_info_call;
+    timestamp_t channel_timestamps[TICKER_MAX_COMPARE_CHANNELS];
+    uint32_t channel_count;
 };
 
 static ticker_interface_stub_t interface_stub = { 0 };
@@ -79,6 +82,15 @@ static void ticker_interface_stub_set_interrupt(timestamp_t timestamp)
     interface_stub.interrupt_timestamp = timestamp;
 }
 
+static void ticker_interface_stub_set_interrupt_channels(const timestamp_t *timestamps, uint32_t count)
+{
+    TEST_ASSERT_TRUE(count <= interface_stub.interface.compare_channels);
+    for (uint32_t i = 0; i < count; ++i) {
+        interface_stub.channel_timestamps[i] = timestamps[i];
+    }
+    interface_stub.channel_count = count;
+}
+
 static void ticker_interface_stub_fire_interrupt()
 {
     ++interface_stub.fire_interrupt_call;
@@ -101,6 +113,8 @@ static void reset_ticker_interface_stub()
     interface_stub.interface.set_interrupt = ticker_interface_stub_set_interrupt;
     interface_stub.interface.fire_interrupt = ticker_interface_stub_fire_interrupt;
     interface_stub.interface.get_info = ticker_interface_stub_get_info;
+    interface_stub.interface.set_interrupt_channels = ticker_interface_stub_set_interrupt_channels;
+    interface_stub.interface.compare_channels = 0;
     interface_stub.initialized = false;
     interface_stub.interrupt_flag = false;
     interface_stub.timestamp = 0;
@@ -111,6 +125,7 @@ static void reset_ticker_interface_stub()
     interface_stub.clear_interrupt_call = 0;
     interface_stub.set_interrupt_call = 0;
     interface_stub.fire_interrupt_call = 0;
+    interface_stub.channel_count = 0;
 
     interface_info_stub.frequency = 1000000;
     interface_info_stub.bits = 32;
@@ -145,6 +160,7 @@ const uint32_t test_frequencies[] = {
     1,
     32768,      // 2^15
     1000000,
+    1500000,    // Neither ratio term is a power of 2
     0xFFFFFFFF  // 2^32 - 1
 };
 
@@ -344,6 +360,9 @@ static void test_ticker_read_overflow()
         TEST_ASSERT_EQUAL_UINT64(
             upper_bytes_begin + i, ticker_read_us(&ticker_stub) >> 32
         );
+
+        // The ticker interrupt updates the time before the counter wraps
+        ticker_irq_handler(&ticker_stub);
     }
 
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
@@ -1521,6 +1540,390 @@ static void test_remove_random()
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker.
+ * When many events are inserted in random order, some of them are removed
+ * and the time is moved past the last event.
+ * Then:
+ *    - The events still in the queue should be dispatched once, in timestamp
+ *      order.
+ *    - The removed events should not be dispatched.
+ *    - The queue should be empty.
+ *
+ * This test does not rely on the internal layout of the queue and applies to
+ * all the queue backends.
+ */
+static void test_insert_remove_dispatch_order()
+{
+    static const size_t event_count = 64;
+    static ticker_event_t events[event_count];
+    static bool dispatched[event_count];
+    static us_timestamp_t last_timestamp;
+    static size_t handler_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            TEST_ASSERT_FALSE(dispatched[id]);
+            TEST_ASSERT_TRUE(events[id].timestamp >= last_timestamp);
+            dispatched[id] = true;
+            last_timestamp = events[id].timestamp;
+            ++handler_called;
+        }
+    };
+
+    memset(events, 0, sizeof(events));
+    memset(dispatched, 0, sizeof(dispatched));
+    last_timestamp = 0;
+    handler_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    // Pseudo random timestamps with duplicates
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < event_count; ++i) {
+        seed = seed * 1664525 + 1013904223;
+        ticker_insert_event_us(&ticker_stub, &events[i], 100 + (seed >> 24), i);
+    }
+
+    // Remove every third event, including the head
+    size_t removed = 0;
+    for (size_t i = 0; i < event_count; i += 3) {
+        ticker_remove_event(&ticker_stub, &events[i]);
+        dispatched[i] = true;
+        ++removed;
+    }
+
+    interface_stub.timestamp = 100 + 0x100;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(event_count - removed, handler_called);
+    TEST_ASSERT_NULL(queue_stub.head);
+    for (size_t i = 0; i < event_count; ++i) {
+        TEST_ASSERT_TRUE(dispatched[i]);
+    }
+}
+
+/**
+ * Given an initialized ticker with events registered.
+ * When a batch of unordered events is inserted with ticker_insert_events_us.
+ * Then:
+ *    - The interrupt should be reprogrammed once.
+ *    - The interrupt timestamp should be the one of the earliest event.
+ *    - All the events should be dispatched in timestamp order.
+ */
+static void test_insert_events_us_batch()
+{
+    static const size_t event_count = 16;
+    static ticker_event_t events[event_count + 1];
+    static us_timestamp_t last_timestamp;
+    static size_t handler_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            TEST_ASSERT_TRUE(events[id].timestamp >= last_timestamp);
+            last_timestamp = events[id].timestamp;
+            ++handler_called;
+        }
+    };
+
+    memset(events, 0, sizeof(events));
+    last_timestamp = 0;
+    handler_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    // An event already in the queue, in the middle of the batch
+    ticker_insert_event_us(&ticker_stub, &events[event_count], 1000, event_count);
+
+    ticker_event_t *batch[event_count];
+    us_timestamp_t timestamps[event_count];
+    uint32_t ids[event_count];
+    for (size_t i = 0; i < event_count; ++i) {
+        batch[i] = &events[i];
+        // Interleave early and late timestamps
+        timestamps[i] = (i % 2) ? 2000 - i * 10 : 500 + i * 10;
+        ids[i] = i;
+    }
+
+    interface_stub.set_interrupt_call = 0;
+    ticker_insert_events_us(&ticker_stub, batch, timestamps, ids, event_count);
+
+    TEST_ASSERT_EQUAL(1, interface_stub.set_interrupt_call);
+    TEST_ASSERT_EQUAL_UINT32(500, interface_stub.interrupt_timestamp);
+    TEST_ASSERT_EQUAL_UINT64(500, queue_stub.head->timestamp);
+
+    interface_stub.timestamp = 2000;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(event_count + 1, handler_called);
+    TEST_ASSERT_NULL(queue_stub.head);
+}
+
+/**
+ * Given an initialized ticker.
+ * When events with overlapping slack windows are inserted with
+ * ticker_insert_event_us_slack.
+ * Then:
+ *    - The interrupt should be scheduled at the end of the common window if
+ *      slack support is enabled, at the timestamp of the head otherwise.
+ *    - A single interrupt should dispatch all the events of the window.
+ */
+static void test_insert_event_us_slack()
+{
+    static size_t handler_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            ++handler_called;
+        }
+    };
+    handler_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    ticker_event_t first_event = { 0 };
+    ticker_event_t second_event = { 0 };
+    ticker_event_t third_event = { 0 };
+
+    ticker_insert_event_us_slack(&ticker_stub, &first_event, 100, 50, 0);
+    ticker_insert_event_us_slack(&ticker_stub, &second_event, 120, 100, 1);
+    ticker_insert_event_us_slack(&ticker_stub, &third_event, 160, 0, 2);
+
+#if MBED_CONF_TARGET_TICKER_EVENT_SLACK
+    // Window of the first event, narrowed by the second event
+    const timestamp_t expected_interrupt = 150;
+    const size_t expected_dispatched = 2;
+#else
+    const timestamp_t expected_interrupt = 100;
+    const size_t expected_dispatched = 1;
+#endif
+    TEST_ASSERT_EQUAL_UINT32(expected_interrupt, interface_stub.interrupt_timestamp);
+
+    interface_stub.timestamp = expected_interrupt;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(expected_dispatched, handler_called);
+    TEST_ASSERT_EQUAL_PTR(expected_dispatched == 2 ? &third_event : &second_event, queue_stub.head);
+}
+
+#if MBED_CONF_TARGET_TICKER_STATS
+/**
+ * Given an initialized ticker.
+ * When events are inserted, removed and dispatched.
+ * Then:
+ *    - The statistics should count the operations on the queue.
+ *    - The maximum lateness should be the delay of the latest dispatch.
+ *    - ticker_reset_stats should clear the counters but not the depth.
+ */
+static void test_ticker_stats()
+{
+    ticker_event_t events[3] = { 0 };
+    ticker_stats_t stats;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+        }
+    };
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    ticker_insert_event_us(&ticker_stub, &events[0], 100, 0);
+    ticker_insert_event_us(&ticker_stub, &events[1], 200, 1);
+    ticker_insert_event_us(&ticker_stub, &events[2], 300, 2);
+    ticker_remove_event(&ticker_stub, &events[1]);
+
+    ticker_get_stats(&ticker_stub, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.max_depth);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.inserts);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.removes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dispatches);
+    TEST_ASSERT_EQUAL_UINT32(interface_stub.set_interrupt_call + interface_stub.fire_interrupt_call,
+                             stats.interrupts_scheduled);
+
+    interface_stub.timestamp = 150;
+    ticker_irq_handler(&ticker_stub);
+
+    ticker_get_stats(&ticker_stub, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dispatches);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.max_lateness_us);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.interrupts);
+
+    ticker_reset_stats(&ticker_stub);
+
+    ticker_get_stats(&ticker_stub, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.depth);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.max_depth);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.inserts);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dispatches);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max_lateness_us);
+
+    ticker_remove_event(&ticker_stub, &events[2]);
+}
+#endif
+
+#if MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH
+/**
+ * Given an initialized ticker with more expired events than a dispatch batch.
+ * When ticker_irq_handler is called.
+ * Then:
+ *    - The handlers should be called outside of a critical section.
+ *    - All the events should be dispatched in timestamp order.
+ */
+static void test_deferred_dispatch()
+{
+    static const size_t event_count = 2 * MBED_CONF_TARGET_TICKER_DISPATCH_BATCH + 1;
+    static ticker_event_t events[event_count];
+    static size_t handler_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            TEST_ASSERT_FALSE(core_util_in_critical_section());
+            TEST_ASSERT_EQUAL_UINT32(handler_called, id);
+            ++handler_called;
+        }
+    };
+
+    memset(events, 0, sizeof(events));
+    handler_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    for (size_t i = 0; i < event_count; ++i) {
+        ticker_insert_event_us(&ticker_stub, &events[i], 100 + i, i);
+    }
+
+    interface_stub.timestamp = 100 + event_count;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(event_count, handler_called);
+    TEST_ASSERT_NULL(queue_stub.head);
+    TEST_ASSERT_FALSE(queue_stub.dispatching);
+}
+#endif
+
+/**
+ * Given an initialized ticker with a one-shot event registered.
+ * When a periodic event is inserted with ticker_insert_periodic_event_us.
+ * Then:
+ *    - The event should be dispatched once per period, at multiples of the
+ *      period from the insertion time, including when the interrupt is late.
+ *    - The event should stay in the queue, ordered with the other events.
+ *    - The event should not be dispatched after it is removed by its handler.
+ */
+static void test_insert_periodic_event_us()
+{
+    static const uint32_t period = 100;
+    static ticker_event_t periodic_event;
+    static size_t periodic_called;
+    static size_t single_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            if (id == 0) {
+                ++periodic_called;
+                if (periodic_called == 5) {
+                    ticker_remove_event(&ticker_stub, &periodic_event);
+                }
+            } else {
+                ++single_called;
+            }
+        }
+    };
+    memset(&periodic_event, 0, sizeof(periodic_event));
+    periodic_called = 0;
+    single_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+    interface_stub.timestamp = 1000;
+
+    ticker_event_t single_event = { 0 };
+    ticker_insert_event_us(&ticker_stub, &single_event, 1150, 1);
+    ticker_insert_periodic_event_us(&ticker_stub, &periodic_event, period, 0);
+
+    TEST_ASSERT_EQUAL_PTR(&periodic_event, queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(1100, interface_stub.interrupt_timestamp);
+
+    interface_stub.timestamp = 1100;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(1, periodic_called);
+    TEST_ASSERT_EQUAL_UINT32(0, single_called);
+    TEST_ASSERT_EQUAL_PTR(&single_event, queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT64(1200, periodic_event.timestamp);
+
+    // Late by more than a period, no time is lost
+    interface_stub.timestamp = 1350;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(3, periodic_called);
+    TEST_ASSERT_EQUAL_UINT32(1, single_called);
+    TEST_ASSERT_EQUAL_PTR(&periodic_event, queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT64(1400, periodic_event.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(1400, interface_stub.interrupt_timestamp);
+
+    interface_stub.timestamp = 1600;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(5, periodic_called);
+    TEST_ASSERT_NULL(queue_stub.head);
+}
+
+/**
+ * Given an initialized ticker with two extra compare channels.
+ * When events are inserted and dispatched.
+ * Then:
+ *    - The interrupt should be set for the first event.
+ *    - The extra channels should be set for the following events, once for
+ *      events on the same tick, with the sorted list queue.
+ *    - The extra channels should be disabled when the queue is empty.
+ */
+static void test_compare_channels()
+{
+    ticker_set_handler(&ticker_stub, NULL);
+    interface_stub.interface.compare_channels = 2;
+
+    // The channels are set with the interrupt, when the head changes
+    ticker_event_t events[5] = { 0 };
+    ticker_insert_event_us(&ticker_stub, &events[0], 300, 0);
+    ticker_insert_event_us(&ticker_stub, &events[1], 150, 1);
+    ticker_insert_event_us(&ticker_stub, &events[2], 150, 2);
+    ticker_insert_event_us(&ticker_stub, &events[3], 200, 3);
+    ticker_insert_event_us(&ticker_stub, &events[4], 100, 4);
+
+    TEST_ASSERT_EQUAL_UINT32(100, interface_stub.interrupt_timestamp);
+#if MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+    TEST_ASSERT_EQUAL_UINT32(0, interface_stub.channel_count);
+#else
+    TEST_ASSERT_EQUAL_UINT32(2, interface_stub.channel_count);
+    TEST_ASSERT_EQUAL_UINT32(150, interface_stub.channel_timestamps[0]);
+    TEST_ASSERT_EQUAL_UINT32(200, interface_stub.channel_timestamps[1]);
+#endif
+
+    interface_stub.timestamp = 100;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(150, interface_stub.interrupt_timestamp);
+#if !MBED_CONF_TARGET_TICKER_QUEUE_HEAP
+    TEST_ASSERT_EQUAL_UINT32(2, interface_stub.channel_count);
+    TEST_ASSERT_EQUAL_UINT32(200, interface_stub.channel_timestamps[0]);
+    TEST_ASSERT_EQUAL_UINT32(300, interface_stub.channel_timestamps[1]);
+#endif
+
+    interface_stub.timestamp = 300;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_NULL(queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(0, interface_stub.channel_count);
+}
+
 /**
  * Given an initialized ticker without user registered events and a ticker
  * interface timestamp equal or bigger than the one registered by the overflow
@@ -2127,6 +2530,7 @@ void test_frequencies_and_masks(uint32_t frequency, uint32_t bits)
     interface_stub.timestamp = ticks & bitmask;
     TEST_ASSERT_EQUAL_UINT32(convert_to_us(ticks, frequency), ticker_read(&ticker_stub));
     TEST_ASSERT_EQUAL_UINT64(convert_to_us(ticks, frequency), ticker_read_us(&ticker_stub));
+    ticker_irq_handler(&ticker_stub);
 
     // Run until the loop before 64-bit overflow (worst case with frequency=1hz, bits=32)
     for (unsigned int k = 0; k < 4294; k++) {
@@ -2136,6 +2540,43 @@ void test_frequencies_and_masks(uint32_t frequency, uint32_t bits)
         interface_stub.timestamp = ticks & bitmask;
         TEST_ASSERT_EQUAL_UINT32(convert_to_us(ticks, frequency), ticker_read(&ticker_stub));
         TEST_ASSERT_EQUAL_UINT64(convert_to_us(ticks, frequency), ticker_read_us(&ticker_stub));
+
+        // The ticker interrupt updates the time before the counter wraps
+        ticker_irq_handler(&ticker_stub);
+    }
+}
+
+/**
+ * Given an uninitialized ticker instance and an interface of a
+ * certain frequency and bit width.
+ * When events are inserted at delays up to the largest delay of the ticker
+ * Then the interrupt should be scheduled at the delay rounded up to the next
+ * tick, as computed with a 64-bit division.
+ */
+void test_frequencies_round_up(uint32_t frequency, uint32_t bits)
+{
+    const uint64_t bitmask = ((uint64_t)1 << bits) - 1;
+    const uint64_t max_delta = TIMESTAMP_MAX_DELTA_BITS(bits);
+    const uint64_t max_delta_us = (max_delta * 1000000 + frequency - 1) / frequency;
+    uint64_t random = 0x9E3779B97F4A7C15;
+
+    ticker_set_handler(&ticker_stub, NULL);
+
+    for (unsigned int k = 0; k < 1000; k++) {
+        random = random * 6364136223846793005 + 1442695040888963407;
+        interface_stub.timestamp = (interface_stub.timestamp + (random >> 40)) & bitmask;
+        const us_timestamp_t now = ticker_read_us(&ticker_stub);
+
+        const uint64_t delta_us = 1 + (random >> 11) % max_delta_us;
+        uint64_t delta = (delta_us * frequency + 1000000 - 1) / 1000000;
+        if (delta > max_delta) {
+            delta = max_delta;
+        }
+
+        ticker_event_t event = { 0 };
+        ticker_insert_event_us(&ticker_stub, &event, now + delta_us, 0);
+        TEST_ASSERT_EQUAL_UINT32((interface_stub.timestamp + delta) & bitmask, interface_stub.interrupt_timestamp);
+        ticker_remove_event(&ticker_stub, &event);
     }
 }
 
@@ -2275,15 +2716,15 @@ static void test_suspend_resume()
     us_timestamp_t start = ticker_read_us(&ticker_stub);
     TEST_ASSERT_EQUAL(1000, start);
 
+    /* Suspend the ticker */
+    ticker_suspend(&ticker_stub);
+    const timestamp_t suspend_time = queue_stub.present_time;
+
     /* Reset call count */
     interface_stub.init_call = 0;
     interface_stub.read_call = 0;
     interface_stub.set_interrupt_call = 0;
 
-    /* Suspend the ticker */
-    ticker_suspend(&ticker_stub);
-    const timestamp_t suspend_time = queue_stub.present_time;
-
 
     /* Simulate time passing */
     interface_stub.timestamp = 1500;
@@ -2335,6 +2776,56 @@ static void test_suspend_resume()
     TEST_ASSERT_EQUAL(1, interface_stub.fire_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker with events registered.
+ * When the ticker is suspended, then resumed with ticker_resume_compensated
+ * after its counter was stopped.
+ * Then:
+ *    - The time should be advanced by the time given.
+ *    - The interrupt should be fired once, and all the events which became
+ *      due should be dispatched by a single interrupt.
+ */
+static void test_suspend_resume_compensated()
+{
+    static size_t handler_called;
+
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            ++handler_called;
+        }
+    };
+
+    ticker_event_t events[3] = { 0 };
+    handler_called = 0;
+
+    interface_stub.timestamp = 1000;
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+    const us_timestamp_t start = ticker_read_us(&ticker_stub);
+
+    ticker_insert_event_us(&ticker_stub, &events[0], start + 100, 0);
+    ticker_insert_event_us(&ticker_stub, &events[1], start + 200, 1);
+    ticker_insert_event_us(&ticker_stub, &events[2], start + 5000, 2);
+
+    ticker_suspend(&ticker_stub);
+
+    // The counter is stopped, then restarted from 0
+    interface_stub.timestamp = 0;
+    interface_stub.fire_interrupt_call = 0;
+    ticker_resume_compensated(&ticker_stub, 1000);
+
+    TEST_ASSERT_EQUAL_UINT64(start + 1000, ticker_read_us(&ticker_stub));
+    TEST_ASSERT_EQUAL(1, interface_stub.fire_interrupt_call);
+
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL(2, handler_called);
+    TEST_ASSERT_EQUAL_PTR(&events[2], queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(4000, interface_stub.interrupt_timestamp);
+
+    ticker_remove_event(&ticker_stub, &events[2]);
+}
+
 static const case_t cases[] = {
     MAKE_TEST_CASE("ticker initialization", test_ticker_initialization),
     MAKE_TEST_CASE(
@@ -2388,6 +2879,20 @@ static const case_t cases[] = {
     MAKE_TEST_CASE("test_remove_event_head", test_remove_event_head),
     MAKE_TEST_CASE("test_remove_event_invalid", test_remove_event_invalid),
     MAKE_TEST_CASE("test_remove_random", test_remove_random),
+    MAKE_TEST_CASE(
+        "test_insert_remove_dispatch_order",
+        test_insert_remove_dispatch_order
+    ),
+    MAKE_TEST_CASE("test_insert_events_us_batch", test_insert_events_us_batch),
+    MAKE_TEST_CASE("test_insert_event_us_slack", test_insert_event_us_slack),
+#if MBED_CONF_TARGET_TICKER_STATS
+    MAKE_TEST_CASE("test_ticker_stats", test_ticker_stats),
+#endif
+#if MBED_CONF_TARGET_TICKER_DEFERRED_DISPATCH
+    MAKE_TEST_CASE("test_deferred_dispatch", test_deferred_dispatch),
+#endif
+    MAKE_TEST_CASE("test_insert_periodic_event_us", test_insert_periodic_event_us),
+    MAKE_TEST_CASE("test_compare_channels", test_compare_channels),
     MAKE_TEST_CASE("update overflow guard", test_overflow_event_update),
     MAKE_TEST_CASE(
         "update overflow guard in case of spurious interrupt",
@@ -2432,6 +2937,10 @@ static const case_t cases[] = {
         "test_frequencies_and_masks",
         test_over_frequency_and_width<test_frequencies_and_masks>
     ),
+    MAKE_TEST_CASE(
+        "test_frequencies_round_up",
+        test_over_frequency_and_width<test_frequencies_round_up>
+    ),
     MAKE_TEST_CASE(
         "test_ticker_max_value",
         test_ticker_max_value
@@ -2447,6 +2956,10 @@ static const case_t cases[] = {
     MAKE_TEST_CASE(
         "test_suspend_resume",
         test_suspend_resume
+    ),
+    MAKE_TEST_CASE(
+        "test_suspend_resume_compensated",
+        test_suspend_resume_compensated
     )
 };
 
@@ -0,0 +1,135 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !DEVICE_USTICKER || MBED_CONF_TARGET_US_TICKER_CHANNELS < 2
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define DELAY_US 10000
+#define TOLERANCE_US 1000
+
+// Channel 0 is used by the test harness, the tests use channel 1
+static volatile us_timestamp_t dispatch_time[2];
+static volatile uint32_t dispatch_count[2];
+
+static void channel_handler(uint32_t id)
+{
+    dispatch_time[id] = ticker_read_us(get_us_ticker_channel_data(1));
+    dispatch_count[id]++;
+}
+
+static void setup_channel()
+{
+    dispatch_count[0] = 0;
+    dispatch_count[1] = 0;
+    ticker_set_handler(get_us_ticker_channel_data(1), channel_handler);
+}
+
+static void wait_for_dispatch(uint32_t count)
+{
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(ticker);
+    while ((dispatch_count[0] + dispatch_count[1]) < count &&
+            (ticker_read_us(ticker) - start) < 10 * DELAY_US);
+}
+
+/* Test that channel 0 is the us ticker and that each channel has its own queue. */
+void ticker_mux_data_test()
+{
+    TEST_ASSERT_EQUAL_PTR(get_us_ticker_data(), get_us_ticker_channel_data(0));
+    TEST_ASSERT_NOT_NULL(get_us_ticker_channel_data(1));
+    TEST_ASSERT_NOT_EQUAL(get_us_ticker_channel_data(0)->queue, get_us_ticker_channel_data(1)->queue);
+    TEST_ASSERT_NULL(get_us_ticker_channel_data(MBED_CONF_TARGET_US_TICKER_CHANNELS));
+}
+
+/* Test that the channel time follows the us ticker. */
+void ticker_mux_read_test()
+{
+    const us_timestamp_t us_start = ticker_read_us(get_us_ticker_data());
+    const us_timestamp_t start = ticker_read_us(get_us_ticker_channel_data(1));
+
+    while ((ticker_read_us(get_us_ticker_data()) - us_start) < DELAY_US);
+
+    const us_timestamp_t elapsed = ticker_read_us(get_us_ticker_channel_data(1)) - start;
+    TEST_ASSERT_UINT64_WITHIN(TOLERANCE_US, DELAY_US, elapsed);
+}
+
+/* Test that the events of a channel are dispatched on time, while the test
+ * harness uses channel 0. */
+void ticker_mux_dispatch_test()
+{
+    setup_channel();
+
+    ticker_event_t events[2];
+    const us_timestamp_t now = ticker_read_us(get_us_ticker_channel_data(1));
+    const us_timestamp_t timestamps[2] = { now + 2 * DELAY_US, now + DELAY_US };
+    ticker_insert_event_us(get_us_ticker_channel_data(1), &events[0], timestamps[0], 0);
+    ticker_insert_event_us(get_us_ticker_channel_data(1), &events[1], timestamps[1], 1);
+
+    wait_for_dispatch(2);
+
+    TEST_ASSERT_EQUAL_UINT32(1, dispatch_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, dispatch_count[1]);
+    TEST_ASSERT_UINT64_WITHIN(TOLERANCE_US, timestamps[0] + TOLERANCE_US / 2, dispatch_time[0]);
+    TEST_ASSERT_UINT64_WITHIN(TOLERANCE_US, timestamps[1] + TOLERANCE_US / 2, dispatch_time[1]);
+}
+
+/* Test that removing the only event of a channel disables its interrupt. */
+void ticker_mux_remove_test()
+{
+    setup_channel();
+
+    ticker_event_t event;
+    const us_timestamp_t now = ticker_read_us(get_us_ticker_channel_data(1));
+    ticker_insert_event_us(get_us_ticker_channel_data(1), &event, now + DELAY_US, 0);
+    ticker_remove_event(get_us_ticker_channel_data(1), &event);
+
+    wait_for_dispatch(1);
+
+    TEST_ASSERT_EQUAL_UINT32(0, dispatch_count[0]);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("ticker mux data test", ticker_mux_data_test),
+    Case("ticker mux read test", ticker_mux_read_test),
+    Case("ticker mux dispatch test", ticker_mux_dispatch_test),
+    Case("ticker mux remove test", ticker_mux_remove_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER || MBED_CONF_TARGET_US_TICKER_CHANNELS < 2
@@ -0,0 +1,194 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/cycle_counter_api.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !DEVICE_USTICKER || !DEVICE_CYCLE_COUNTER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+/* Lower on targets without the RAM for the events. */
+#ifndef TICKER_STRESS_EVENT_COUNT
+#define TICKER_STRESS_EVENT_COUNT   1024
+#endif
+
+/* Time from the start of the test to the first deadline, the events are all
+ * inserted by then. */
+#define START_DELAY_US      200000
+#define SPREAD_WINDOW_US    1000000
+#define BURST_WINDOW_US     1000
+#define TIMEOUT_US          1000000
+
+/* Bucket n counts the lateness in [2^(n-1), 2^n) us, and bucket 0 no lateness. */
+#define HISTOGRAM_BUCKETS   16
+
+static ticker_event_t events[TICKER_STRESS_EVENT_COUNT];
+static volatile uint32_t dispatched;
+static volatile uint32_t early;
+static volatile uint32_t max_lateness;
+static uint32_t histogram[HISTOGRAM_BUCKETS];
+
+static const ticker_data_t *ticker;
+
+/* Called in the ticker interrupt, with the queue in its critical section. */
+static void event_handler(uint32_t id)
+{
+    const us_timestamp_t now = ticker_read_us(ticker);
+    const us_timestamp_t deadline = events[id].timestamp;
+
+    if (now < deadline) {
+        early++;
+    } else {
+        const uint32_t lateness = (uint32_t)(now - deadline);
+        int bucket = lateness ? 32 - __builtin_clz(lateness) : 0;
+        if (bucket >= HISTOGRAM_BUCKETS) {
+            bucket = HISTOGRAM_BUCKETS - 1;
+        }
+        histogram[bucket]++;
+        if (lateness > max_lateness) {
+            max_lateness = lateness;
+        }
+    }
+    dispatched++;
+}
+
+static void print_histogram()
+{
+    printf("dispatch lateness:\r\n");
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        if (i == 0) {
+            printf("  0 us: %lu\r\n", (unsigned long)histogram[i]);
+        } else if (i == HISTOGRAM_BUCKETS - 1) {
+            printf("  >= %lu us: %lu\r\n", 1UL << (i - 1), (unsigned long)histogram[i]);
+        } else {
+            printf("  %lu-%lu us: %lu\r\n", 1UL << (i - 1), (1UL << i) - 1, (unsigned long)histogram[i]);
+        }
+    }
+    printf("  max: %lu us\r\n", (unsigned long)max_lateness);
+}
+
+/* Insert the events with random deadlines in the window, and check they are
+ * all dispatched, never before their deadline.
+ *
+ * While the events are dispatched, the longest time between two reads of the
+ * cycle counter by the test is the longest the ticker interrupt kept the core,
+ * which is the worst-case critical section of ticker_irq_handler.
+ */
+static void run_stress(uint32_t window_us)
+{
+    const unsigned int seed = us_ticker_read();
+    srand(seed);
+
+    hal_cycle_counter_init();
+    ticker = get_us_ticker_data();
+    ticker_set_handler(ticker, event_handler);
+    dispatched = 0;
+    early = 0;
+    max_lateness = 0;
+    memset(histogram, 0, sizeof(histogram));
+    memset(events, 0, sizeof(events));
+
+    // insert_event runs in the critical section of ticker_insert_event_us
+    uint32_t max_insert = 0;
+    uint64_t total_insert = 0;
+    const us_timestamp_t start = ticker_read_us(ticker) + START_DELAY_US;
+    for (uint32_t i = 0; i < TICKER_STRESS_EVENT_COUNT; i++) {
+        const us_timestamp_t deadline = start + ((uint32_t)rand() % window_us);
+        const uint32_t before = hal_cycle_counter_read();
+        ticker_insert_event_us(ticker, &events[i], deadline, i);
+        const uint32_t cycles = hal_cycle_counter_read() - before;
+        total_insert += cycles;
+        if (cycles > max_insert) {
+            max_insert = cycles;
+        }
+    }
+    TEST_ASSERT_TRUE_MESSAGE(ticker_read_us(ticker) < start, "events inserted after the first deadline");
+
+    uint32_t max_gap = 0;
+    uint32_t last = hal_cycle_counter_read();
+    const us_timestamp_t timeout = start + window_us + TIMEOUT_US;
+    while (dispatched < TICKER_STRESS_EVENT_COUNT && ticker_read_us(ticker) < timeout) {
+        const uint32_t now = hal_cycle_counter_read();
+        if (now - last > max_gap) {
+            max_gap = now - last;
+        }
+        last = now;
+    }
+
+    printf("%u events in %lu us, seed %u\r\n", (unsigned)TICKER_STRESS_EVENT_COUNT,
+           (unsigned long)window_us, seed);
+    printf("insert_event: max %lu cycles, mean %lu cycles\r\n", (unsigned long)max_insert,
+           (unsigned long)(total_insert / TICKER_STRESS_EVENT_COUNT));
+    printf("ticker_irq_handler: max %lu cycles\r\n", (unsigned long)max_gap);
+    print_histogram();
+
+    for (uint32_t i = 0; i < TICKER_STRESS_EVENT_COUNT; i++) {
+        ticker_remove_event(ticker, &events[i]);
+    }
+    ticker_set_handler(ticker, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(TICKER_STRESS_EVENT_COUNT, dispatched);
+    TEST_ASSERT_EQUAL_UINT32(0, early);
+}
+
+/* Test events spread over a second, mostly dispatched one per interrupt. */
+void ticker_stress_spread_test()
+{
+    run_stress(SPREAD_WINDOW_US);
+}
+
+/* Test events due within a millisecond, dispatched many per interrupt. */
+void ticker_stress_burst_test()
+{
+    run_stress(BURST_WINDOW_US);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Ticker stress test - spread events", ticker_stress_spread_test),
+    Case("Ticker stress test - burst of events", ticker_stress_burst_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER || !DEVICE_CYCLE_COUNTER
@@ -0,0 +1,286 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+// The trace library is built with tracing enabled, so the test uses the real functions
+#ifdef MBED_CONF_MBED_TRACE_ENABLE
+#undef MBED_CONF_MBED_TRACE_ENABLE
+#endif
+#define MBED_CONF_MBED_TRACE_ENABLE 1
+
+// The tr_* macros of the test trace warnings and errors only
+#define TRACE_GROUP "test"
+#define TRACE_GROUP_MAX_LEVEL TRACE_LEVEL_WARN
+
+#include "bootstrap/mbed_trace.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using namespace utest::v1;
+
+#define PRINTED_SIZE 256
+#define TMP_LENGTH 128
+#define ARRAY_SIZE 200
+
+static char printed[PRINTED_SIZE];
+static unsigned int prints;
+static const uint8_t bytes[] = { 0x01, 0xab, 0xff, 0x10 };
+static unsigned int evaluations;
+
+static void trace_print(const char *str)
+{
+    strncpy(printed, str, sizeof(printed) - 1);
+    prints++;
+}
+
+/* Initialize the traces with plain lines, all levels, and the given tmp buffer length. */
+static void trace_setup(int tmp_length)
+{
+    TEST_ASSERT_EQUAL_INT(0, mbed_trace_init());
+    mbed_trace_config_set(TRACE_MODE_PLAIN | TRACE_ACTIVE_LEVEL_ALL);
+    mbed_trace_print_function_set(trace_print);
+    mbed_trace_buffer_sizes(0, tmp_length);
+    memset(printed, 0, sizeof(printed));
+    prints = 0;
+}
+
+/* Test that an array is written in full when it fits in the tmp buffer, and
+ * that a '*' replaces the last character when it does not. */
+void trace_array_short_test()
+{
+    trace_setup(10);
+    mbed_tracef(TRACE_LEVEL_INFO, "test", "%s", mbed_trace_array(bytes, 3));
+    TEST_ASSERT_EQUAL_STRING("01:ab:ff", printed);
+    mbed_tracef(TRACE_LEVEL_INFO, "test", "%s", mbed_trace_array(bytes, 4));
+    TEST_ASSERT_EQUAL_STRING("01:ab:ff*", printed);
+
+    trace_setup(4);
+    mbed_tracef(TRACE_LEVEL_INFO, "test", "%s", mbed_trace_array(bytes, 2));
+    TEST_ASSERT_EQUAL_STRING("01*", printed);
+
+    // 3 bytes left don't fit a byte and its separator, nothing is written
+    trace_setup(3);
+    mbed_tracef(TRACE_LEVEL_INFO, "test", "[%s]", mbed_trace_array(bytes, 2));
+    TEST_ASSERT_EQUAL_STRING("[]", printed);
+
+    trace_setup(TMP_LENGTH);
+}
+
+/* Test that a hex dump is its label followed by the array, marked with a '*'
+ * when the tmp buffer is too short. */
+void trace_hexdump_short_test()
+{
+    trace_setup(TMP_LENGTH);
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "lbl ", bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL_STRING("lbl 01:ab:ff:10", printed);
+
+    trace_setup(10);
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "lbl ", bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL_STRING("lbl 01:ab:ff*", printed);
+
+    trace_setup(TMP_LENGTH);
+}
+
+/* Trace a line of the group and check whether it was printed. */
+static bool group_printed(const char *grp)
+{
+    const unsigned int before = prints;
+    mbed_tracef(TRACE_LEVEL_INFO, grp, "%s", grp);
+    return prints != before && strcmp(grp, printed) == 0;
+}
+
+/* Test that the groups of the exclude filter are skipped and the others
+ * printed, whole names only, long names included. */
+void trace_exclude_filter_test()
+{
+    char filters[] = "ab,cde network";
+
+    trace_setup(TMP_LENGTH);
+    mbed_trace_exclude_filters_set(filters);
+    TEST_ASSERT_FALSE(group_printed("ab"));
+    TEST_ASSERT_FALSE(group_printed("cde"));
+    TEST_ASSERT_FALSE(group_printed("network"));
+    TEST_ASSERT_TRUE(group_printed("a"));
+    TEST_ASSERT_TRUE(group_printed("abc"));
+    TEST_ASSERT_TRUE(group_printed("de"));
+    TEST_ASSERT_TRUE(group_printed("netw"));
+    TEST_ASSERT_TRUE(group_printed("networks"));
+
+    mbed_trace_exclude_filters_set(NULL);
+    TEST_ASSERT_TRUE(group_printed("ab"));
+    TEST_ASSERT_TRUE(group_printed("network"));
+}
+
+/* Test that only the groups of the include filter are printed, and that the
+ * exclude filter applies to them too. */
+void trace_include_filter_test()
+{
+    char include[] = "ab,cde,network";
+    char exclude[] = "cde";
+
+    trace_setup(TMP_LENGTH);
+    mbed_trace_include_filters_set(include);
+    TEST_ASSERT_TRUE(group_printed("ab"));
+    TEST_ASSERT_TRUE(group_printed("cde"));
+    TEST_ASSERT_TRUE(group_printed("network"));
+    TEST_ASSERT_FALSE(group_printed("abc"));
+    TEST_ASSERT_FALSE(group_printed("netw"));
+    TEST_ASSERT_FALSE(group_printed("other"));
+
+    mbed_trace_exclude_filters_set(exclude);
+    TEST_ASSERT_TRUE(group_printed("ab"));
+    TEST_ASSERT_FALSE(group_printed("cde"));
+
+    mbed_trace_exclude_filters_set(NULL);
+    mbed_trace_include_filters_set(NULL);
+    TEST_ASSERT_TRUE(group_printed("other"));
+}
+
+static int evaluate()
+{
+    evaluations++;
+    return 1;
+}
+
+/* Test that levels above TRACE_GROUP_MAX_LEVEL are compiled out, and that the
+ * inactive levels are skipped without evaluating their arguments. */
+void trace_level_filter_test()
+{
+    trace_setup(TMP_LENGTH);
+    evaluations = 0;
+    tr_debug("debug %d", evaluate());
+    tr_info("info %d", evaluate());
+    TEST_ASSERT_EQUAL_UINT(0, prints);
+    TEST_ASSERT_EQUAL_UINT(0, evaluations);
+
+    tr_warn("warn %d", evaluate());
+    TEST_ASSERT_EQUAL_STRING("warn 1", printed);
+    tr_err("err %d", evaluate());
+    TEST_ASSERT_EQUAL_STRING("err 1", printed);
+    TEST_ASSERT_EQUAL_UINT(2, prints);
+    TEST_ASSERT_EQUAL_UINT(2, evaluations);
+
+    mbed_trace_config_set(TRACE_MODE_PLAIN | TRACE_ACTIVE_LEVEL_ERROR);
+    TEST_ASSERT_FALSE(mbed_trace_level_active(TRACE_LEVEL_WARN));
+    TEST_ASSERT_TRUE(mbed_trace_level_active(TRACE_LEVEL_ERROR));
+    tr_warn("warn %d", evaluate());
+    mbed_tracef(TRACE_LEVEL_INFO, "test", "info");
+    TEST_ASSERT_EQUAL_UINT(2, prints);
+    TEST_ASSERT_EQUAL_UINT(2, evaluations);
+    tr_err("err %d", evaluate());
+    TEST_ASSERT_EQUAL_UINT(3, prints);
+
+    trace_setup(TMP_LENGTH);
+}
+
+#if MBED_CONF_MBED_TRACE_FEA_BINARY
+#define BINARY_BUFFER_SIZE 512
+
+static uint32_t binary_buffer[BINARY_BUFFER_SIZE / sizeof(uint32_t)];
+static uint32_t record_data[BINARY_BUFFER_SIZE / sizeof(uint32_t)];
+
+/* Test that a hex dump longer than a binary record is cut to the record and
+ * flagged as truncated, and that its bytes are kept as they are. */
+void trace_binary_array_truncated_test()
+{
+    uint8_t array[ARRAY_SIZE];
+    const mbed_trace_binary_record_t *record = (const mbed_trace_binary_record_t *)record_data;
+    uint32_t len;
+
+    for (unsigned int index = 0; index < sizeof(array); index++) {
+        array[index] = index;
+    }
+    trace_setup(TMP_LENGTH);
+    TEST_ASSERT_EQUAL_INT(0, mbed_trace_binary_buffer_set(binary_buffer, sizeof(binary_buffer)));
+
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "big:", array, sizeof(array));
+    TEST_ASSERT_EQUAL_UINT(0, prints);
+    TEST_ASSERT_TRUE(mbed_trace_binary_read(record_data, sizeof(record_data)) > 0);
+    TEST_ASSERT_EQUAL_HEX8(MBED_TRACE_BINARY_FLAG_ARRAY | MBED_TRACE_BINARY_FLAG_TRUNCATED, record->flags);
+    TEST_ASSERT_EQUAL_STRING("big:", record->fmt);
+
+    memcpy(&len, record + 1, sizeof(len));
+    TEST_ASSERT_EQUAL_UINT32(record->length - sizeof(*record) - sizeof(len), len);
+    TEST_ASSERT_TRUE(len < sizeof(array));
+    TEST_ASSERT_EQUAL_MEMORY(array, (const uint8_t *)(record + 1) + sizeof(len), len);
+
+    // The record is written to the whole tmp buffer when it is formatted, with a '*' at the end
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "big:", array, sizeof(array));
+    TEST_ASSERT_EQUAL_INT(1, mbed_trace_binary_drain());
+    TEST_ASSERT_EQUAL_UINT(1, prints);
+    TEST_ASSERT_EQUAL_INT(TMP_LENGTH - 1, strlen(printed));
+    TEST_ASSERT_EQUAL_MEMORY("big:00:01:02", printed, 12);
+    TEST_ASSERT_EQUAL('*', printed[TMP_LENGTH - 2]);
+
+    TEST_ASSERT_EQUAL_INT(0, mbed_trace_binary_buffer_set(NULL, 0));
+}
+
+/* Test that a recorded hex dump formatted to a short tmp buffer is marked
+ * with a '*', and that only the label is written when no byte fits. */
+void trace_binary_array_short_test()
+{
+    trace_setup(TMP_LENGTH);
+    TEST_ASSERT_EQUAL_INT(0, mbed_trace_binary_buffer_set(binary_buffer, sizeof(binary_buffer)));
+
+    mbed_trace_buffer_sizes(0, 10);
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "x:", bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL_INT(1, mbed_trace_binary_drain());
+    TEST_ASSERT_EQUAL_STRING("x:01:ab*", printed);
+
+    // 3 bytes left after the label don't fit a byte and its separator
+    mbed_trace_buffer_sizes(0, 6);
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "lbl", bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL_INT(1, mbed_trace_binary_drain());
+    TEST_ASSERT_EQUAL_STRING("lbl", printed);
+
+    mbed_trace_buffer_sizes(0, TMP_LENGTH);
+    mbed_trace_hexdump(TRACE_LEVEL_INFO, "test", "x:", bytes, sizeof(bytes));
+    TEST_ASSERT_EQUAL_INT(1, mbed_trace_binary_drain());
+    TEST_ASSERT_EQUAL_STRING("x:01:ab:ff:10", printed);
+
+    TEST_ASSERT_EQUAL_INT(0, mbed_trace_binary_buffer_set(NULL, 0));
+}
+#endif // MBED_CONF_MBED_TRACE_FEA_BINARY
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Trace array short buffer test", trace_array_short_test),
+    Case("Trace hexdump short buffer test", trace_hexdump_short_test),
+    Case("Trace exclude filter test", trace_exclude_filter_test),
+    Case("Trace include filter test", trace_include_filter_test),
+    Case("Trace level filter test", trace_level_filter_test),
+#if MBED_CONF_MBED_TRACE_FEA_BINARY
+    Case("Trace binary array truncated test", trace_binary_array_truncated_test),
+    Case("Trace binary array short buffer test", trace_binary_array_short_test),
+#endif
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
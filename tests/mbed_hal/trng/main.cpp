@@ -36,11 +36,12 @@
 * to ensure all characters will be transmitted correctly.
 */
 
+#include "greentea-base64/base64.h"
 #include "greentea-client/test_env.h"
 #include "unity/unity.h"
 #include "utest/utest.h"
 #include "hal/trng_api.h"
-#include "base64b.h"
+#include "hal/us_ticker_api.h"
 #include "pithy.h"
 #include <stdio.h>
 #include <string.h>
@@ -120,14 +121,14 @@ static void compress_and_compare(char *key, char *value)
     /*At the begining of step 2 load trng buffer from step 1*/
     if (strcmp(key, MSG_TRNG_TEST_STEP2) == 0) {
         /*Using base64 to decode data sent from host*/
-        uint32_t lengthWritten = 0;
-        uint32_t charsProcessed = 0;
-        result = trng_DecodeNBase64((const char *)value,
-                                    MSG_VALUE_LEN,
-                                    buffer,
-                                    BUFFER_LEN,
-                                    &lengthWritten,
-                                    &charsProcessed);
+        size_t lengthWritten = 0;
+        size_t charsProcessed = 0;
+        result = greentea_base64_decode((const char *)value,
+                                        MSG_VALUE_LEN,
+                                        buffer,
+                                        BUFFER_LEN,
+                                        &lengthWritten,
+                                        &charsProcessed);
         TEST_ASSERT_EQUAL(0, result);
         memcpy(input_buf, buffer, BUFFER_LEN);
     }
@@ -187,10 +188,10 @@ static void compress_and_compare(char *key, char *value)
     if (strcmp(key, MSG_TRNG_TEST_STEP1) == 0) {
         int result = 0;
         /*Using base64 to encode data sending from host*/
-        result = trng_EncodeBase64(buffer,
-                                   BUFFER_LEN,
-                                   (char *)out_comp_buf,
-                                   OUT_COMP_BUF_SIZE);
+        result = greentea_base64_encode(buffer,
+                                        BUFFER_LEN,
+                                        (char *)out_comp_buf,
+                                        OUT_COMP_BUF_SIZE);
         TEST_ASSERT_EQUAL(RESULT_SUCCESS, result);
 
         greentea_send_kv(MSG_TRNG_BUFFER, (const char *)out_comp_buf);
@@ -202,6 +203,78 @@ static void compress_and_compare(char *key, char *value)
     delete[] temp_buf;
 }
 
+#define POOL_FILL_TIMEOUT_US 1000000
+
+/*Fill an entropy pool, then check that pooled reads never block and do not repeat data*/
+void trng_pool_test()
+{
+    static trng_t trng_obj;
+    static trng_pool_t pool;
+    uint8_t first[MBED_CONF_TARGET_TRNG_POOL_SIZE];
+    uint8_t second[MBED_CONF_TARGET_TRNG_POOL_SIZE];
+    size_t output_length = 0;
+
+    trng_init(&trng_obj);
+    trng_pool_init(&pool, &trng_obj);
+
+    for (int round = 0; round < 2; round++) {
+        const ticker_data_t *const ticker = get_us_ticker_data();
+        const uint32_t start = ticker_read(ticker);
+        while ((trng_pool_count(&pool) < MBED_CONF_TARGET_TRNG_POOL_SIZE) &&
+                ((ticker_read(ticker) - start) < POOL_FILL_TIMEOUT_US)) {
+            if (!pool.irq) {
+                trng_pool_fill(&pool);
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(MBED_CONF_TARGET_TRNG_POOL_SIZE, trng_pool_count(&pool));
+
+        int trng_res = trng_get_bytes_pooled(&pool, round == 0 ? first : second, MBED_CONF_TARGET_TRNG_POOL_SIZE, &output_length);
+        TEST_ASSERT_EQUAL_INT(0, trng_res);
+        TEST_ASSERT_EQUAL_UINT32(MBED_CONF_TARGET_TRNG_POOL_SIZE, output_length);
+    }
+
+    TEST_ASSERT_TRUE(memcmp(first, second, sizeof(first)) != 0);
+
+    trng_pool_free(&pool);
+    TEST_ASSERT_EQUAL_UINT32(0, trng_pool_count(&pool));
+    trng_free(&trng_obj);
+}
+
+#define CONDITIONED_LEN 1024
+
+/*Check that the health tests catch a stuck source, then measure the conditioned output rate*/
+void trng_conditioned_test()
+{
+    static trng_t trng_obj;
+    static uint8_t buffer[CONDITIONED_LEN];
+    static uint8_t out_comp_buf[(CONDITIONED_LEN * 5) + 32];
+    trng_health_t health;
+    size_t output_length = 0;
+
+    trng_health_init(&health);
+    memset(buffer, 0xA5, MBED_CONF_TARGET_TRNG_RCT_CUTOFF);
+    TEST_ASSERT_EQUAL_INT(-1, trng_health_check(&health, buffer, MBED_CONF_TARGET_TRNG_RCT_CUTOFF));
+    TEST_ASSERT_EQUAL_INT(-1, trng_get_bytes_conditioned(&trng_obj, &health, buffer, 1, &output_length));
+    TEST_ASSERT_EQUAL_UINT32(0, output_length);
+
+    trng_init(&trng_obj);
+    trng_health_init(&health);
+
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const uint32_t start = ticker_read(ticker);
+    int trng_res = trng_get_bytes_conditioned(&trng_obj, &health, buffer, CONDITIONED_LEN, &output_length);
+    const uint32_t elapsed = ticker_read(ticker) - start;
+    trng_free(&trng_obj);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, trng_res, "trng_get_bytes_conditioned error!");
+    TEST_ASSERT_EQUAL_UINT32(CONDITIONED_LEN, output_length);
+    utest_printf("%u conditioned bytes in %lu us, %lu bytes/s\n", CONDITIONED_LEN, (unsigned long)elapsed,
+                 (unsigned long)(elapsed ? (uint64_t)CONDITIONED_LEN * 1000000 / elapsed : 0));
+
+    size_t comp_sz = pithy_Compress((char *)buffer, CONDITIONED_LEN, (char *)out_comp_buf, sizeof(out_comp_buf), 9);
+    TEST_ASSERT_MESSAGE(comp_sz > CONDITIONED_LEN, "conditioned output was able to compress thus not random");
+}
+
 /*This method call first and second steps, it directs by the key received from the host*/
 void trng_test()
 {
@@ -231,6 +304,8 @@ void trng_test()
 }
 
 Case cases[] = {
+    Case("TRNG: trng_pool_test", trng_pool_test),
+    Case("TRNG: trng_conditioned_test", trng_conditioned_test),
     Case("TRNG: trng_test", trng_test),
 };
 
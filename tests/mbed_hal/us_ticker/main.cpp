@@ -15,6 +15,7 @@
  */
 
 #include "hal/us_ticker_api.h"
+#include "hal/utils/critical_section_api.h"
 #include "us_ticker_api_tests.h"
 
 #include "greentea-client/test_env.h"
@@ -26,6 +27,10 @@
 #error [NOT_SUPPORTED] test not supported
 #else
 
+#ifdef US_TICKER_IRQn
+#include "cmsis.h"
+#endif
+
 using namespace utest::v1;
 
 /* Test that the ticker has the correct frequency and number of bits. */
@@ -53,6 +58,54 @@ void us_ticker_info_test()
 #endif
 }
 
+#ifdef US_TICKER_IRQn
+static volatile bool irq_priority_event_fired;
+
+static void irq_priority_event_handler(uint32_t id)
+{
+    (void)id;
+    irq_priority_event_fired = true;
+}
+#endif
+
+/* Test that the ticker interrupt only takes priorities masked by critical sections. */
+void us_ticker_irq_priority_test()
+{
+#if defined(__NVIC_PRIO_BITS)
+    TEST_ASSERT_FALSE(us_ticker_set_irq_priority(1UL << __NVIC_PRIO_BITS));
+#endif
+#if MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY
+    if (!hal_critical_section_masks_priority(MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY - 1)) {
+        TEST_ASSERT_FALSE(us_ticker_set_irq_priority(MBED_CONF_PLATFORM_CRITICAL_SECTION_PRIORITY - 1));
+    }
+#endif
+
+#ifndef US_TICKER_IRQn
+    TEST_IGNORE_MESSAGE("US_TICKER_IRQn not defined for this platform");
+#else
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const uint32_t previous_priority = NVIC_GetPriority(US_TICKER_IRQn);
+    const uint32_t lowest_priority = (1UL << __NVIC_PRIO_BITS) - 1;
+
+    TEST_ASSERT_TRUE(us_ticker_set_irq_priority(lowest_priority));
+    TEST_ASSERT_EQUAL_UINT32(lowest_priority, NVIC_GetPriority(US_TICKER_IRQn));
+
+    // Events are still dispatched at the lowest priority
+    const ticker_event_handler previous_handler = ticker->queue->event_handler;
+    ticker_event_t event = {};
+    irq_priority_event_fired = false;
+    ticker_set_handler(ticker, irq_priority_event_handler);
+    const us_timestamp_t start = ticker_read_us(ticker);
+    ticker_insert_event_us(ticker, &event, start + 1000, 0);
+    while (!irq_priority_event_fired && ticker_read_us(ticker) - start < 100000);
+    ticker_remove_event(ticker, &event);
+    ticker_set_handler(ticker, previous_handler);
+    NVIC_SetPriority(US_TICKER_IRQn, previous_priority);
+
+    TEST_ASSERT_TRUE(irq_priority_event_fired);
+#endif
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(20, "default_auto");
@@ -61,6 +114,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("us ticker info test", us_ticker_info_test),
+    Case("us ticker irq priority test", us_ticker_irq_priority_test),
 };
 
 Specification specification(test_setup, cases);
@@ -38,6 +38,16 @@ extern "C" {
  */
 void us_ticker_info_test(void);
 
+/** Test that the ticker interrupt only takes priorities masked by critical sections.
+ *
+ * Given ticker is available.
+ * When the ticker interrupt priority is set.
+ * Then priorities which are invalid or not masked by critical sections are rejected.
+ * When the target defines US_TICKER_IRQn and the lowest priority is set.
+ * Then the priority is applied and ticker events are still dispatched.
+ */
+void us_ticker_irq_priority_test(void);
+
 
 /**@}*/
 
@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bootstrap/mbed_warm_boot.h"
+#include "bootstrap/mbed_wait_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "device.h"
+
+#if DEVICE_RESET_REASON
+#include "hal/reset_reason_api.h"
+#endif
+
+#include <stdint.h>
+
+#if !MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+MBED_WARM_RETAINED static uint32_t retained[4];
+
+void warm_boot_reset_reason_test()
+{
+#if DEVICE_RESET_REASON
+    const reset_reason_t reason = hal_reset_reason_get();
+    if (reason != RESET_REASON_WATCHDOG && reason != RESET_REASON_SOFTWARE && reason != RESET_REASON_LOCKUP) {
+        TEST_ASSERT_FALSE(mbed_warm_boot_is_warm());
+    }
+#else
+    TEST_ASSERT_FALSE(mbed_warm_boot_is_warm());
+#endif
+}
+
+void warm_boot_retained_test()
+{
+    if (mbed_warm_boot_is_warm()) {
+        TEST_IGNORE_MESSAGE("The retained variables are only zeroed on a cold boot");
+    }
+    for (size_t i = 0; i < sizeof(retained) / sizeof(retained[0]); i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, retained[i]);
+    }
+}
+
+void warm_boot_wait_ns_test()
+{
+#if defined(__CORTEX_M)
+    uint32_t clock = 0;
+    uint32_t scaler = 0;
+
+    wait_ns_calibrate();
+#if DEVICE_CYCLE_COUNTER || DEVICE_USTICKER
+    TEST_ASSERT_TRUE(mbed_warm_boot_get(MBED_WARM_BOOT_WAIT_NS_CLOCK, &clock));
+    TEST_ASSERT_EQUAL_UINT32(SystemCoreClock, clock);
+    TEST_ASSERT_TRUE(mbed_warm_boot_get(MBED_WARM_BOOT_WAIT_NS_SCALER, &scaler));
+    TEST_ASSERT_NOT_EQUAL(0, scaler);
+
+    // A value read back is the last one set, the measured one is put back
+    uint32_t value = 0;
+    mbed_warm_boot_set(MBED_WARM_BOOT_WAIT_NS_SCALER, scaler + 1);
+    TEST_ASSERT_TRUE(mbed_warm_boot_get(MBED_WARM_BOOT_WAIT_NS_SCALER, &value));
+    mbed_warm_boot_set(MBED_WARM_BOOT_WAIT_NS_SCALER, scaler);
+    TEST_ASSERT_EQUAL_UINT32(scaler + 1, value);
+#endif
+    TEST_ASSERT_FALSE(mbed_warm_boot_get(MBED_WARM_BOOT_VALUES, &clock));
+#else
+    TEST_IGNORE_MESSAGE("wait_ns() is only measured on Cortex-M cores");
+#endif
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Warm boot reset reason test", warm_boot_reset_reason_test),
+    Case("Warm boot retained variables test", warm_boot_retained_test),
+    Case("Warm boot wait_ns calibration test", warm_boot_wait_ns_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !MBED_CONF_PLATFORM_WARM_BOOT_ENABLED
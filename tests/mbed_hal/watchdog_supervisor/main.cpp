@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/idle_api.h"
+#include "hal/us_ticker_api.h"
+#include "hal/watchdog_supervisor_api.h"
+
+#include "greentea-client/test_env.h"
+#include "greentea-custom_io/custom_io.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !DEVICE_WATCHDOG || !DEVICE_SLEEP || !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define WDG_TIMEOUT_MS 100UL
+
+static const watchdog_config_t config = { WDG_TIMEOUT_MS };
+
+// The supervised watchdog must be stopped before the test harness reports
+static bool can_stop_watchdog()
+{
+    return hal_watchdog_get_platform_features().disable_watchdog;
+}
+
+void watchdog_supervisor_check_in_test()
+{
+    if (!can_stop_watchdog()) {
+        TEST_IGNORE_MESSAGE("Disabling watchdog not supported for this platform");
+        return;
+    }
+
+    const int first = hal_watchdog_supervisor_register();
+    const int second = hal_watchdog_supervisor_register();
+    TEST_ASSERT_NOT_EQUAL(-1, first);
+    TEST_ASSERT_NOT_EQUAL(-1, second);
+    TEST_ASSERT_NOT_EQUAL(first, second);
+
+    TEST_ASSERT_FALSE(hal_watchdog_supervisor_service());
+    TEST_ASSERT_EQUAL(WATCHDOG_STATUS_OK, hal_watchdog_supervisor_start(&config));
+
+    // Every client must check in before each kick
+    TEST_ASSERT_FALSE(hal_watchdog_supervisor_service());
+    hal_watchdog_supervisor_check_in(first);
+    TEST_ASSERT_FALSE(hal_watchdog_supervisor_service());
+    hal_watchdog_supervisor_check_in(second);
+    TEST_ASSERT_TRUE(hal_watchdog_supervisor_service());
+    TEST_ASSERT_FALSE(hal_watchdog_supervisor_service());
+
+    // Unregistered clients are not waited for
+    hal_watchdog_supervisor_unregister(second);
+    hal_watchdog_supervisor_check_in(first);
+    TEST_ASSERT_TRUE(hal_watchdog_supervisor_service());
+
+    hal_watchdog_supervisor_unregister(first);
+    TEST_ASSERT_EQUAL(WATCHDOG_STATUS_OK, hal_watchdog_supervisor_stop());
+}
+
+void watchdog_supervisor_register_test()
+{
+    int clients[WATCHDOG_SUPERVISOR_MAX_CLIENTS];
+
+    for (int i = 0; i < WATCHDOG_SUPERVISOR_MAX_CLIENTS; i++) {
+        clients[i] = hal_watchdog_supervisor_register();
+        TEST_ASSERT_NOT_EQUAL(-1, clients[i]);
+    }
+    TEST_ASSERT_EQUAL(-1, hal_watchdog_supervisor_register());
+
+    for (int i = 0; i < WATCHDOG_SUPERVISOR_MAX_CLIENTS; i++) {
+        hal_watchdog_supervisor_unregister(clients[i]);
+    }
+}
+
+/* The core sleeps in hal_idle for several watchdog timeouts, with no other
+ * event to wake it up than the ones of the supervisor. */
+void watchdog_supervisor_idle_test()
+{
+    if (!can_stop_watchdog()) {
+        TEST_IGNORE_MESSAGE("Disabling watchdog not supported for this platform");
+        return;
+    }
+
+    const int client = hal_watchdog_supervisor_register();
+    TEST_ASSERT_EQUAL(WATCHDOG_STATUS_OK, hal_watchdog_supervisor_start(&config));
+
+    const ticker_data_t *const ticker = get_us_ticker_data();
+    const us_timestamp_t start = ticker_read_us(ticker);
+    uint32_t wakeups = 0;
+    while (ticker_read_us(ticker) - start < 5 * WDG_TIMEOUT_MS * 1000) {
+        hal_watchdog_supervisor_check_in(client);
+        hal_idle();
+        wakeups++;
+    }
+
+    TEST_ASSERT_EQUAL(WATCHDOG_STATUS_OK, hal_watchdog_supervisor_stop());
+    hal_watchdog_supervisor_unregister(client);
+
+    // Not reset, and woken up by the supervisor rather than busy looping
+    TEST_ASSERT_TRUE(wakeups < 1000);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("watchdog supervisor check-in test", watchdog_supervisor_check_in_test),
+    Case("watchdog supervisor register test", watchdog_supervisor_register_test),
+    Case("watchdog supervisor idle test", watchdog_supervisor_idle_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    greentea_init_custom_io();
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_WATCHDOG || !DEVICE_SLEEP || !DEVICE_USTICKER
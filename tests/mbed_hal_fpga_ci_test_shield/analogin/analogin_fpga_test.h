@@ -45,6 +45,35 @@ void fpga_analogin_init_test(PinName pin);
  */
 void fpga_analogin_test(PinName pin);
 
+/** Test that analogin scan fills the double buffer.
+ *
+ * Given board provides analogin support.
+ * When 3.3 V is provided to analogin pin and the scan is converted by software and by ::analogin_scan_start.
+ * Then the scan handler is called for each half of the buffer with samples close to 65535.
+ *
+ */
+void fpga_analogin_scan_test(PinName pin);
+
+/** Test that analogin conversions can be configured within the capabilities.
+ *
+ * Given board provides analogin support.
+ * When the highest hardware oversampling ratio is configured and 0.0/3.3 V is provided to analogin pin.
+ * Then analogin_read_u16 and analogin_read_average_u16 return 0/65535,
+ *      and a ratio above the capabilities is refused.
+ *
+ */
+void fpga_analogin_configure_test(PinName pin);
+
+/** Test that the analogin watchdog reports the crossing of its thresholds.
+ *
+ * Given board provides analogin support and the analog watchdog.
+ * When 3.3 V then 0.0 V is provided to analogin pin, out of the watchdog window.
+ * Then the watchdog handler is called once with the high then the low event,
+ *      and not at all while the input stays within the window.
+ *
+ */
+void fpga_analogin_watchdog_test(PinName pin);
+
 
 /**@}*/
 
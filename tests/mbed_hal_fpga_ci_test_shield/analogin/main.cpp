@@ -28,6 +28,7 @@
 #include "mbed.h"
 #include "pinmap.h"
 #include "hal/static_pinmap.h"
+#include "us_ticker_api.h"
 #include "test_utils.h"
 #include "MbedTester.h"
 #include "analogin_fpga_test.h"
@@ -84,12 +85,199 @@ void fpga_analogin_test(PinName pin)
     analogin_free(&analogin);
 }
 
+#define SCAN_FRAMES 4
+#define SCAN_RATE_HZ 1000
+#define SCAN_TIMEOUT_US (2 * 1000000 * SCAN_FRAMES / SCAN_RATE_HZ)
+
+typedef struct {
+    uint32_t calls;
+    uint32_t samples;
+    uint32_t high;
+} scan_test_data_t;
+
+static void test_scan_handler(uint32_t id, const uint16_t *samples, size_t count)
+{
+    scan_test_data_t *td = (scan_test_data_t *)id;
+    td->calls++;
+    for (size_t i = 0; i < count; i++) {
+        td->samples++;
+        if (samples[i] > 65535 - DELTA_U16) {
+            td->high++;
+        }
+    }
+}
+
+void fpga_analogin_scan_test(PinName pin)
+{
+    tester.reset();
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    analogin_t analogin;
+    analogin_init(&analogin, pin);
+    analogin_t *const channels[] = { &analogin };
+    uint16_t buffer[2 * SCAN_FRAMES];
+    volatile scan_test_data_t td = {};
+    analogin_scan_t scan;
+
+    TEST_ASSERT_EQUAL_INT(-1, analogin_scan_init(&scan, channels, 1, buffer, 2 * SCAN_FRAMES - 1, test_scan_handler, (uint32_t) &td));
+    TEST_ASSERT_EQUAL_INT(0, analogin_scan_init(&scan, channels, 1, buffer, 2 * SCAN_FRAMES, test_scan_handler, (uint32_t) &td));
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+
+    /* Software frames fill both halves of the buffer */
+    for (int i = 0; i < 2 * SCAN_FRAMES; i++) {
+        analogin_scan_frame(&scan);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, td.calls);
+    TEST_ASSERT_EQUAL_UINT32(2 * SCAN_FRAMES, td.samples);
+    TEST_ASSERT_EQUAL_UINT32(2 * SCAN_FRAMES, td.high);
+
+    /* Hardware triggered scan, if the target supports it */
+    td.calls = 0;
+    td.samples = 0;
+    td.high = 0;
+    if (analogin_scan_start(&scan, SCAN_RATE_HZ) == 0) {
+        const ticker_data_t *const us_ticker = get_us_ticker_data();
+        us_timestamp_t end_ts = ticker_read_us(us_ticker) + SCAN_TIMEOUT_US;
+        while (td.calls < 2 && ticker_read_us(us_ticker) <= end_ts);
+        analogin_scan_stop(&scan);
+
+        TEST_ASSERT_TRUE(td.calls >= 2);
+        TEST_ASSERT_EQUAL_UINT32(td.samples, td.high);
+    }
+
+    /* Set gpio back to Hi-Z */
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+
+    analogin_free(&analogin);
+}
+
+#define AVERAGE_COUNT 64
+
+void fpga_analogin_configure_test(PinName pin)
+{
+    tester.reset();
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    analogin_t analogin;
+    analogin_init(&analogin, pin);
+
+    analogin_capabilities_t cap;
+    analogin_get_capabilities(&analogin, &cap);
+    TEST_ASSERT_TRUE(cap.max_oversampling >= 1);
+    TEST_ASSERT_EQUAL_UINT16(0, cap.max_oversampling & (cap.max_oversampling - 1));
+
+    /* The default configuration is always accepted */
+    analogin_config_t config = { 0, 1, 0 };
+    TEST_ASSERT_EQUAL_INT(0, analogin_configure(&analogin, &config));
+
+    /* Hardware oversampling with the highest ratio and the longest sampling time */
+    config.oversampling = cap.max_oversampling;
+    config.sampling_time_ns = cap.max_sampling_time_ns;
+    TEST_ASSERT_EQUAL_INT(0, analogin_configure(&analogin, &config));
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+    TEST_ASSERT_UINT16_WITHIN(DELTA_U16, 65535, analogin_read_u16(&analogin));
+    TEST_ASSERT_UINT16_WITHIN(DELTA_U16, 65535, analogin_read_average_u16(&analogin, AVERAGE_COUNT));
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+    TEST_ASSERT_UINT16_WITHIN(DELTA_U16, 0, analogin_read_u16(&analogin));
+    TEST_ASSERT_UINT16_WITHIN(DELTA_U16, 0, analogin_read_average_u16(&analogin, AVERAGE_COUNT));
+
+    /* Ratios above the hardware oversampling are refused */
+    if (cap.max_oversampling < 0x8000) {
+        config.oversampling = cap.max_oversampling * 2;
+        TEST_ASSERT_EQUAL_INT(-1, analogin_configure(&analogin, &config));
+    }
+
+    /* Set gpio back to Hi-Z */
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+
+    analogin_free(&analogin);
+}
+
+#define WATCHDOG_TIMEOUT_US 10000
+
+typedef struct {
+    uint32_t calls;
+    analogin_watchdog_event_t event;
+    uint16_t value;
+} watchdog_test_data_t;
+
+static void test_watchdog_handler(uint32_t id, analogin_watchdog_event_t event, uint16_t value)
+{
+    watchdog_test_data_t *td = (watchdog_test_data_t *)id;
+    td->calls++;
+    td->event = event;
+    td->value = value;
+}
+
+/* Wait for the watchdog handler to be called once */
+static bool wait_watchdog(volatile watchdog_test_data_t *td)
+{
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+    const us_timestamp_t end_ts = ticker_read_us(us_ticker) + WATCHDOG_TIMEOUT_US;
+    while (td->calls == 0 && ticker_read_us(us_ticker) <= end_ts);
+    return td->calls != 0;
+}
+
+void fpga_analogin_watchdog_test(PinName pin)
+{
+    tester.reset();
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    analogin_t analogin;
+    analogin_init(&analogin, pin);
+    volatile watchdog_test_data_t td = {};
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+    if (analogin_watchdog_set(&analogin, DELTA_U16, 65535 - DELTA_U16, test_watchdog_handler, (uint32_t) &td) != 0) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+        analogin_free(&analogin);
+        TEST_IGNORE_MESSAGE("Analog watchdog not supported for this channel");
+        return;
+    }
+
+    /* The input is above the high threshold */
+    TEST_ASSERT_TRUE(wait_watchdog(&td));
+    TEST_ASSERT_EQUAL(ANALOGIN_WATCHDOG_HIGH, td.event);
+    TEST_ASSERT_TRUE(td.value > 65535 - DELTA_U16);
+
+    /* The watchdog stopped after reporting the crossing */
+    td.calls = 0;
+    TEST_ASSERT_FALSE(wait_watchdog(&td));
+
+    /* Rearmed, the input is below the low threshold */
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+    TEST_ASSERT_EQUAL_INT(0, analogin_watchdog_set(&analogin, DELTA_U16, 65535 - DELTA_U16, test_watchdog_handler, (uint32_t) &td));
+    TEST_ASSERT_TRUE(wait_watchdog(&td));
+    TEST_ASSERT_EQUAL(ANALOGIN_WATCHDOG_LOW, td.event);
+    TEST_ASSERT_TRUE(td.value < DELTA_U16);
+
+    /* No call within the window */
+    td.calls = 0;
+    TEST_ASSERT_EQUAL_INT(0, analogin_watchdog_set(&analogin, 0, 65535, test_watchdog_handler, (uint32_t) &td));
+    TEST_ASSERT_FALSE(wait_watchdog(&td));
+    analogin_watchdog_clear(&analogin);
+
+    /* Set gpio back to Hi-Z */
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+
+    analogin_free(&analogin);
+}
+
 Case cases[] = {
     // This will be run for all pins
     Case("AnalogIn - init test", all_ports<AnaloginPort, DefaultFormFactor, fpga_analogin_init_test>),
     // This will be run for single pin
     Case("AnalogIn - read test", all_ports<AnaloginPort, DefaultFormFactor, fpga_analogin_test<false>>),
     Case("AnalogIn (direct init) - read test", all_ports<AnaloginPort, DefaultFormFactor, fpga_analogin_test<true>>),
+    Case("AnalogIn - scan test", one_peripheral<AnaloginPort, DefaultFormFactor, fpga_analogin_scan_test>),
+    Case("AnalogIn - configure test", one_peripheral<AnaloginPort, DefaultFormFactor, fpga_analogin_configure_test>),
+    Case("AnalogIn - watchdog test", one_peripheral<AnaloginPort, DefaultFormFactor, fpga_analogin_watchdog_test>),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
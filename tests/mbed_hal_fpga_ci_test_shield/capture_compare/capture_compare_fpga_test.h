@@ -0,0 +1,79 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_capture_compare_tests */
+/** @{*/
+
+#ifndef MBED_FPGA_CAPTURE_COMPARE_TEST_H
+#define MBED_FPGA_CAPTURE_COMPARE_TEST_H
+
+#if DEVICE_CAPTURE || DEVICE_COMPARE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that the input capture can be initialized/de-initialized using all possible
+ *  capture pins.
+ *
+ * Given board provides input capture support.
+ * When input capture is initialized (and then de-initialized) using valid capture pin.
+ * Then the operation is successfull.
+ *
+ */
+void fpga_capture_init_free(PinName pin);
+
+/** Test that capture_start stores the counter values of the input edges.
+ *
+ * Given board provides input capture support.
+ * When the FPGA drives pulses of known widths on the input and they are captured with capture_start.
+ * Then the differences of the captured values match the pulse widths, the handler is called
+ * once when the buffer is full and capture_stop returns the buffer size.
+ *
+ */
+void fpga_capture_pulse_test(PinName pin);
+
+/** Test that the output compare can be initialized/de-initialized using all possible
+ *  compare pins.
+ *
+ * Given board provides output compare support.
+ * When output compare is initialized (and then de-initialized) using valid compare pin.
+ * Then the operation is successfull.
+ *
+ */
+void fpga_compare_init_free(PinName pin);
+
+/** Test that compare_start changes the output at the counter values of the buffer.
+ *
+ * Given board provides output compare support.
+ * When a sequence of toggles at regular counter values is started with compare_start.
+ * Then the FPGA measures pulses of the expected width and edge count, and the handler
+ * is called once after the last value.
+ *
+ */
+void fpga_compare_sequence_test(PinName pin);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
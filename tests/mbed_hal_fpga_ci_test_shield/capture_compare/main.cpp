@@ -0,0 +1,273 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !DEVICE_CAPTURE && !DEVICE_COMPARE
+#error [NOT_SUPPORTED] Input capture and output compare not supported for this target
+#elif !COMPONENT_FPGA_CI_TEST_SHIELD
+#error [NOT_SUPPORTED] FPGA CI Test Shield is needed to run this test
+#elif !(defined(TARGET_FF_ARDUINO) || defined(TARGET_FF_ARDUINO_UNO)) && !defined(MBED_CONF_TARGET_DEFAULT_FORM_FACTOR)
+#error [NOT_SUPPORTED] Test not supported for this form factor
+#else
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "MbedTester.h"
+#include "pinmap.h"
+#include "hal/capture_api.h"
+#include "hal/compare_api.h"
+#include "hal/static_pinmap.h"
+#include "test_utils.h"
+#include "capture_compare_fpga_test.h"
+
+using namespace utest::v1;
+
+#define US_PER_SEC                      1000000
+
+#define DELTA_FACTOR                    20 // 5% delta
+
+#define US_TO_TICKS(US, FREQ) ((uint32_t)((uint64_t)(US) * (FREQ) / US_PER_SEC))
+#define TICKS_TO_US(TICKS, FREQ) ((uint32_t)((uint64_t)(TICKS) * US_PER_SEC / (FREQ)))
+
+#define COUNTER_MASK(BITS) ((uint32_t)(((uint64_t)1 << (BITS)) - 1))
+
+#define NUM_OF_PULSES                   5
+#define PULSE_HIGH_US                   2000
+#define PULSE_LOW_US                    3000
+#define SEQUENCE_PULSE_US               1000
+
+
+MbedTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
+
+static void test_count_handler(uint32_t id)
+{
+    (*(volatile uint32_t *)id)++;
+}
+
+#if DEVICE_CAPTURE
+
+// The port types of the FPGA test utilities don't cover input capture
+struct CaptureMaps {
+    static const PinMap *maps[];
+    static const char *const pin_type_names[];
+    static const char *const name;
+};
+const PinMap *CaptureMaps::maps[] = { capture_pinmap() };
+const char *const CaptureMaps::pin_type_names[] = { "CAPTURE_IN" };
+const char *const CaptureMaps::name = "CAPTURE";
+typedef Port<1, CaptureMaps, DefaultFormFactor, TF1> CapturePort;
+
+static uint32_t capture_irq_count;
+static size_t capture_irq_values;
+
+static void test_capture_handler(uint32_t id, size_t count)
+{
+    test_count_handler(id);
+    capture_irq_values = count;
+}
+
+void fpga_capture_init_free(PinName pin)
+{
+    capture_t capture;
+
+    capture_init(&capture, pin);
+    capture_free(&capture);
+}
+
+void fpga_capture_pulse_test(PinName pin, bool init_direct)
+{
+    tester.reset();
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+
+    capture_t capture;
+
+    if (init_direct) {
+        const PinMap pinmap = get_capture_pinmap(pin);
+        capture_init_direct(&capture, &pinmap);
+    } else {
+        capture_init(&capture, pin);
+    }
+
+    const uint32_t frequency = capture_tick_frequency(&capture);
+    const uint32_t mask = COUNTER_MASK(capture_counter_bits(&capture));
+    if (US_TO_TICKS(PULSE_LOW_US, frequency) > mask) {
+        capture_free(&capture);
+        TEST_SKIP_MESSAGE("Capture counter wraps within a pulse");
+        return;
+    }
+
+    // One value per edge, and the rising edge ending the last low pulse
+    uint32_t buffer[2 * NUM_OF_PULSES + 1];
+    capture_irq_count = 0;
+    capture_irq_values = 0;
+    capture_start(&capture, CAPTURE_EDGE_BOTH, buffer, MBED_ARRAY_SIZE(buffer), test_capture_handler, (uint32_t) &capture_irq_count);
+
+    for (int i = 0; i < NUM_OF_PULSES; i++) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+        wait_us(PULSE_HIGH_US);
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+        wait_us(PULSE_LOW_US);
+    }
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+    wait_us(PULSE_HIGH_US);
+
+    TEST_ASSERT_EQUAL_UINT32(1, capture_irq_count);
+    TEST_ASSERT_EQUAL_UINT32(MBED_ARRAY_SIZE(buffer), capture_irq_values);
+    TEST_ASSERT_EQUAL_UINT32(MBED_ARRAY_SIZE(buffer), capture_stop(&capture));
+
+    for (int i = 0; i < NUM_OF_PULSES; i++) {
+        const uint32_t high_us = TICKS_TO_US((buffer[2 * i + 1] - buffer[2 * i]) & mask, frequency);
+        const uint32_t low_us = TICKS_TO_US((buffer[2 * i + 2] - buffer[2 * i + 1]) & mask, frequency);
+
+        TEST_ASSERT_UINT32_WITHIN(PULSE_HIGH_US / DELTA_FACTOR, PULSE_HIGH_US, high_us);
+        TEST_ASSERT_UINT32_WITHIN(PULSE_LOW_US / DELTA_FACTOR, PULSE_LOW_US, low_us);
+    }
+
+    capture_free(&capture);
+}
+
+template<bool init_direct>
+void fpga_capture_pulse_test(PinName pin)
+{
+    fpga_capture_pulse_test(pin, init_direct);
+}
+
+#endif // DEVICE_CAPTURE
+
+#if DEVICE_COMPARE
+
+// The port types of the FPGA test utilities don't cover output compare
+struct CompareMaps {
+    static const PinMap *maps[];
+    static const char *const pin_type_names[];
+    static const char *const name;
+};
+const PinMap *CompareMaps::maps[] = { compare_pinmap() };
+const char *const CompareMaps::pin_type_names[] = { "COMPARE_OUT" };
+const char *const CompareMaps::name = "COMPARE";
+typedef Port<1, CompareMaps, DefaultFormFactor, TF1> ComparePort;
+
+void fpga_compare_init_free(PinName pin)
+{
+    compare_t compare;
+
+    compare_init(&compare, pin);
+    compare_free(&compare);
+}
+
+void fpga_compare_sequence_test(PinName pin, bool init_direct)
+{
+    tester.reset();
+    MbedTester::LogicalPin logical_pin = (MbedTester::LogicalPin)(MbedTester::LogicalPinIOMetrics0);
+    tester.pin_map_set(pin, logical_pin);
+
+    compare_t compare;
+
+    if (init_direct) {
+        const PinMap pinmap = get_compare_pinmap(pin);
+        compare_init_direct(&compare, &pinmap);
+    } else {
+        compare_init(&compare, pin);
+    }
+    compare_write(&compare, 0);
+
+    // The values must be reached within half the counter range of each other
+    const uint32_t frequency = compare_tick_frequency(&compare);
+    const uint32_t mask = COUNTER_MASK(compare_counter_bits(&compare));
+    uint32_t pulse_ticks = US_TO_TICKS(SEQUENCE_PULSE_US, frequency);
+    if (pulse_ticks > mask / 4) {
+        pulse_ticks = mask / 4;
+    }
+    const uint32_t pulse_us = TICKS_TO_US(pulse_ticks, frequency);
+
+    uint32_t buffer[2 * NUM_OF_PULSES];
+    volatile uint32_t irq_count = 0;
+
+    tester.io_metrics_start();
+
+    core_util_critical_section_enter();
+    const uint32_t start = compare_read(&compare);
+    for (size_t i = 0; i < MBED_ARRAY_SIZE(buffer); i++) {
+        buffer[i] = (start + (i + 1) * pulse_ticks) & mask;
+    }
+    compare_start(&compare, COMPARE_ACTION_TOGGLE, buffer, MBED_ARRAY_SIZE(buffer), test_count_handler, (uint32_t) &irq_count);
+    core_util_critical_section_exit();
+
+    wait_us((MBED_ARRAY_SIZE(buffer) + 2) * pulse_us);
+
+    tester.io_metrics_stop();
+    compare_stop(&compare);
+
+    TEST_ASSERT_EQUAL_UINT32(1, irq_count);
+
+    TEST_ASSERT_EQUAL_UINT32(NUM_OF_PULSES, tester.io_metrics_rising_edges(logical_pin));
+    TEST_ASSERT_EQUAL_UINT32(NUM_OF_PULSES, tester.io_metrics_falling_edges(logical_pin));
+    TEST_ASSERT_UINT32_WITHIN(pulse_us / DELTA_FACTOR, pulse_us, tester.io_metrics_min_pulse_high(logical_pin) / 100);
+    TEST_ASSERT_UINT32_WITHIN(pulse_us / DELTA_FACTOR, pulse_us, tester.io_metrics_max_pulse_high(logical_pin) / 100);
+    TEST_ASSERT_UINT32_WITHIN(pulse_us / DELTA_FACTOR, pulse_us, tester.io_metrics_min_pulse_low(logical_pin) / 100);
+    TEST_ASSERT_UINT32_WITHIN(pulse_us / DELTA_FACTOR, pulse_us, tester.io_metrics_max_pulse_low(logical_pin) / 100);
+
+    compare_free(&compare);
+}
+
+template<bool init_direct>
+void fpga_compare_sequence_test(PinName pin)
+{
+    fpga_compare_sequence_test(pin, init_direct);
+}
+
+#endif // DEVICE_COMPARE
+
+Case cases[] = {
+#if DEVICE_CAPTURE
+    // This will be run for all pins
+    Case("Capture - init/free test", all_ports<CapturePort, DefaultFormFactor, fpga_capture_init_free>),
+
+    // This will be run for single pin
+    Case("Capture - pulse widths", one_peripheral<CapturePort, DefaultFormFactor, fpga_capture_pulse_test<false> >),
+    Case("Capture (direct init) - pulse widths", one_peripheral<CapturePort, DefaultFormFactor, fpga_capture_pulse_test<true> >),
+#endif
+#if DEVICE_COMPARE
+    // This will be run for all pins
+    Case("Compare - init/free test", all_ports<ComparePort, DefaultFormFactor, fpga_compare_init_free>),
+
+    // This will be run for single pin
+    Case("Compare - toggle sequence", one_peripheral<ComparePort, DefaultFormFactor, fpga_compare_sequence_test<false> >),
+    Case("Compare (direct init) - toggle sequence", one_peripheral<ComparePort, DefaultFormFactor, fpga_compare_sequence_test<true> >),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+#ifdef FPGA_FORCE_ALL_PORTS
+    GREENTEA_SETUP(300, "default_auto");
+#else
+    GREENTEA_SETUP(120, "default_auto");
+#endif
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif /* !DEVICE_CAPTURE && !DEVICE_COMPARE */
@@ -56,6 +56,30 @@ void fpga_test_explicit_input(PinName pin);
  */
 void fpga_test_explicit_output(PinName pin);
 
+/* Test output toggling.
+ *
+ * Given a GPIO instance initialized as an output,
+ * when the output is toggled,
+ * then the pin level is inverted each time.
+ */
+void fpga_test_toggle(PinName pin);
+
+/* Test the header-only fast path.
+ *
+ * Given a GPIO instance,
+ * when gpio_fast_read, gpio_fast_write and gpio_fast_toggle are used,
+ * then they behave as their regular counterparts.
+ */
+void fpga_test_fast_input_output(PinName pin);
+
+/* Benchmark the output toggle rate.
+ *
+ * Given a GPIO instance initialized as an output, and its port when supported,
+ * when it is toggled with gpio_write, gpio_toggle, gpio_fast_write, port_write and port_toggle_bits,
+ * then every pulse reaches the tester, which measures the peak and sustained toggle rates.
+ */
+void fpga_test_toggle_rate(PinName pin);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -28,6 +28,8 @@
 #include "pinmap.h"
 #include "test_utils.h"
 #include "gpio_fpga_test.h"
+#include "hal/gpio_fast_api.h"
+#include "hal/us_ticker_api.h"
 
 using namespace utest::v1;
 
@@ -36,6 +38,13 @@ using namespace utest::v1;
 // is not driven externally.
 #define HI_Z_READ_DELAY_US 5
 
+#define TOGGLE_PULSES 1000
+// The FPGA measures the pulses in 10 ns ticks
+#define FPGA_TICK_HZ 100000000
+#define FPGA_TICK_NS 10
+// Largest PortName searched for the port of a pin
+#define PORT_SEARCH_COUNT 16
+
 MbedTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
 
 /* Test basic input & output operations.
@@ -304,11 +313,237 @@ void fpga_test_explicit_output(PinName pin)
     }
 }
 
+void fpga_test_toggle(PinName pin)
+{
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_t gpio;
+    gpio_init_out_ex(&gpio, pin, 0);
+    TEST_ASSERT_EQUAL_INT(0, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+
+    // Toggle the output and check the level on each step.
+    for (int i = 1; i <= 4; i++) {
+        gpio_toggle(&gpio);
+        TEST_ASSERT_EQUAL_INT(i & 1, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    }
+    gpio_free(&gpio);
+}
+
+void fpga_test_fast_input_output(PinName pin)
+{
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_t gpio;
+    gpio_init_in(&gpio, pin);
+
+    // Test the fast path used as an input.
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 1, true);
+    TEST_ASSERT_EQUAL_INT(1, gpio_fast_read(&gpio));
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+    TEST_ASSERT_EQUAL_INT(0, gpio_fast_read(&gpio));
+
+    // Test the fast path used as an output.
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+    gpio_dir(&gpio, PIN_OUTPUT);
+    gpio_fast_write(&gpio, 1);
+    TEST_ASSERT_EQUAL_INT(1, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    gpio_fast_write(&gpio, 0);
+    TEST_ASSERT_EQUAL_INT(0, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    gpio_fast_toggle(&gpio);
+    TEST_ASSERT_EQUAL_INT(1, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    gpio_fast_toggle(&gpio);
+    TEST_ASSERT_EQUAL_INT(0, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+
+    gpio_free(&gpio);
+}
+
+/* Test output speeds and drive strengths.
+ *
+ * Given a GPIO output configured with each speed and drive strength it supports,
+ * when the output is written,
+ * then the tester reads the level written.
+ */
+void fpga_test_speed_drive(PinName pin)
+{
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_t gpio;
+    gpio_init_out_ex(&gpio, pin, 0);
+    gpio_capabilities_t gcap = {};
+    gpio_get_capabilities(&gpio, &gcap);
+
+    for (int speed = GPIO_SPEED_LOW; speed <= GPIO_SPEED_VERY_HIGH; speed++) {
+        if (!(gcap.speeds & (1 << speed))) {
+            continue;
+        }
+        gpio_speed(&gpio, (gpio_speed_t)speed);
+        gpio_write(&gpio, 1);
+        TEST_ASSERT_EQUAL_INT(1, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+        gpio_write(&gpio, 0);
+        TEST_ASSERT_EQUAL_INT(0, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    }
+    gpio_speed(&gpio, GPIO_SPEED_LOW);
+
+    for (int drive = GPIO_DRIVE_LOW; drive <= GPIO_DRIVE_VERY_HIGH; drive++) {
+        if (!(gcap.drives & (1 << drive))) {
+            continue;
+        }
+        gpio_drive(&gpio, (gpio_drive_t)drive);
+        gpio_write(&gpio, 1);
+        TEST_ASSERT_EQUAL_INT(1, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+        gpio_write(&gpio, 0);
+        TEST_ASSERT_EQUAL_INT(0, tester.gpio_read(MbedTester::LogicalPinGPIO0));
+    }
+
+    gpio_free(&gpio);
+}
+
+static us_timestamp_t toggle_rate_start()
+{
+    tester.io_metrics_start();
+    core_util_critical_section_enter();
+    return ticker_read_us(get_us_ticker_data());
+}
+
+/* Check that every pulse reached the pin, and report the rate of the
+ * fastest pulse and the rate sustained over all of them.
+ */
+static void toggle_rate_stop(const char *name, us_timestamp_t start)
+{
+    const us_timestamp_t elapsed_us = ticker_read_us(get_us_ticker_data()) - start;
+    core_util_critical_section_exit();
+    tester.io_metrics_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(TOGGLE_PULSES, tester.io_metrics_rising_edges(MbedTester::LogicalPinGPIO0));
+    const uint32_t min_period_ticks = tester.io_metrics_min_pulse_high(MbedTester::LogicalPinGPIO0) + tester.io_metrics_min_pulse_low(MbedTester::LogicalPinGPIO0);
+    const uint32_t max_period_ticks = tester.io_metrics_max_pulse_high(MbedTester::LogicalPinGPIO0) + tester.io_metrics_max_pulse_low(MbedTester::LogicalPinGPIO0);
+
+    utest_printf("\n%s: %lu Hz peak, %lu Hz sustained, longest period %lu ns", name,
+                 (unsigned long)(FPGA_TICK_HZ / min_period_ticks), (unsigned long)(TOGGLE_PULSES * 1000000ULL / elapsed_us),
+                 (unsigned long)(max_period_ticks * FPGA_TICK_NS));
+}
+
+#if DEVICE_PORTOUT
+/* Find the port of a pin, ports are numbered from 0 on targets. */
+static bool find_port(PinName pin, PortName *port, int *bit)
+{
+    for (int p = 0; p < PORT_SEARCH_COUNT; p++) {
+        for (int n = 0; n < 32; n++) {
+            if (port_pin((PortName)p, n) == pin) {
+                *port = (PortName)p;
+                *bit = n;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#endif
+
+/* Benchmark the output toggle rate.
+ *
+ * Given a GPIO output, and its port when supported,
+ * when it is toggled in a loop with each of the output functions,
+ * then the tester counts every pulse and measures the toggle rate.
+ */
+void fpga_test_toggle_rate(PinName pin)
+{
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_t gpio;
+    gpio_init_out_ex(&gpio, pin, 0);
+
+    us_timestamp_t start = toggle_rate_start();
+    for (int i = 0; i < TOGGLE_PULSES; i++) {
+        gpio_write(&gpio, 1);
+        gpio_write(&gpio, 0);
+    }
+    toggle_rate_stop("gpio_write", start);
+
+    start = toggle_rate_start();
+    for (int i = 0; i < TOGGLE_PULSES; i++) {
+        gpio_toggle(&gpio);
+        gpio_toggle(&gpio);
+    }
+    toggle_rate_stop("gpio_toggle", start);
+
+    start = toggle_rate_start();
+    for (int i = 0; i < TOGGLE_PULSES; i++) {
+        gpio_fast_write(&gpio, 1);
+        gpio_fast_write(&gpio, 0);
+    }
+    toggle_rate_stop("gpio_fast_write", start);
+
+    gpio_free(&gpio);
+
+#if DEVICE_PORTOUT
+    PortName port_name;
+    int bit;
+    if (!find_port(pin, &port_name, &bit)) {
+        utest_printf("\nskipped port_write, port not found");
+        return;
+    }
+
+    port_t port;
+    const int mask = 1 << bit;
+    port_init(&port, port_name, mask, PIN_OUTPUT);
+    port_write(&port, 0);
+
+    start = toggle_rate_start();
+    for (int i = 0; i < TOGGLE_PULSES; i++) {
+        port_write(&port, mask);
+        port_write(&port, 0);
+    }
+    toggle_rate_stop("port_write", start);
+
+    start = toggle_rate_start();
+    for (int i = 0; i < TOGGLE_PULSES; i++) {
+        port_toggle_bits(&port, mask);
+        port_toggle_bits(&port, mask);
+    }
+    toggle_rate_stop("port_toggle_bits", start);
+
+    port_dir(&port, PIN_INPUT);
+#endif
+}
+
 Case cases[] = {
     Case("basic input & output", all_ports<GPIOPort, DefaultFormFactor, fpga_test_basic_input_output>),
     Case("input pull modes", all_ports<GPIOPort, DefaultFormFactor, fpga_test_input_pull_modes>),
     Case("explicit init, input", all_ports<GPIOPort, DefaultFormFactor, fpga_test_explicit_input>),
     Case("explicit init, output", all_ports<GPIOPort, DefaultFormFactor, fpga_test_explicit_output>),
+    Case("toggle", all_ports<GPIOPort, DefaultFormFactor, fpga_test_toggle>),
+    Case("fast input & output", all_ports<GPIOPort, DefaultFormFactor, fpga_test_fast_input_output>),
+    Case("speed & drive strength", all_ports<GPIOPort, DefaultFormFactor, fpga_test_speed_drive>),
+    Case("toggle rate", one_peripheral<GPIOPort, DefaultFormFactor, fpga_test_toggle_rate>),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
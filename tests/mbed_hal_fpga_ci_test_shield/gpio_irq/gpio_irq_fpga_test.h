@@ -45,6 +45,24 @@ void fpga_gpio_irq_test(PinName pin);
  */
 void fpga_gpio_irq_init_free_test(PinName pin);
 
+/** Test that queued GPIO IRQ edges are timestamped in order.
+ *
+ * Given board provides interrupt-in feature.
+ * When gpio interrupt pushes edges to a queue.
+ * Then the edges are popped in order with non-decreasing timestamps and the queue counts overflowed edges.
+ *
+ */
+void fpga_gpio_irq_queue_test(PinName pin);
+
+/** Measure the latency from an edge to the gpio interrupt handler.
+ *
+ * Given board provides interrupt-in feature.
+ * When FPGA releases the line to its pull-up and the handler drives it low again.
+ * Then every edge calls the handler, and the distribution of the latencies measured by FPGA is reported.
+ *
+ */
+void fpga_gpio_irq_latency_test(PinName pin);
+
 /**@}*/
 
 #ifdef __cplusplus
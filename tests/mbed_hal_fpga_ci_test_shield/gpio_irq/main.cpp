@@ -261,9 +261,148 @@ void fpga_gpio_irq_init_free_test(PinName pin)
     gpio_irq_free(&gpio_irq);
 }
 
+void fpga_gpio_irq_queue_test(PinName pin)
+{
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_t gpio;
+    gpio_init_in(&gpio, pin);
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+    WAIT();
+
+    static gpio_irq_queue_t queue;
+    gpio_irq_queue_init(&queue);
+
+    gpio_irq_t gpio_irq;
+    gpio_irq_queued_t queued;
+    TEST_ASSERT_EQUAL(0, gpio_irq_init_queued(&queued, &gpio_irq, pin, &queue, 123));
+    gpio_irq_set(&gpio_irq, IRQ_RISE, true);
+    gpio_irq_set(&gpio_irq, IRQ_FALL, true);
+    gpio_irq_enable(&gpio_irq);
+
+    const uint32_t start = us_ticker_read();
+    const int edges = 8;
+    for (int i = 0; i < edges; i++) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, (i + 1) & 1, true);
+        WAIT();
+    }
+
+    gpio_irq_edge_t edge;
+    uint32_t last = start;
+    for (int i = 0; i < edges; i++) {
+        TEST_ASSERT_TRUE(gpio_irq_queue_pop(&queue, &edge));
+        TEST_ASSERT_EQUAL(123, edge.id);
+        TEST_ASSERT_EQUAL(i & 1 ? IRQ_FALL : IRQ_RISE, edge.event);
+        // edges are WAIT() apart, ticker wrap is handled by the unsigned difference
+        TEST_ASSERT_TRUE(edge.timestamp - last <= edge.timestamp - start);
+        last = edge.timestamp;
+    }
+    TEST_ASSERT_FALSE(gpio_irq_queue_pop(&queue, &edge));
+    TEST_ASSERT_EQUAL(0, gpio_irq_queue_dropped(&queue));
+
+    // overflow the queue
+    for (int i = 0; i < MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE + edges; i++) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, (i + 1) & 1, true);
+        WAIT();
+    }
+    int popped = 0;
+    while (gpio_irq_queue_pop(&queue, &edge)) {
+        popped++;
+    }
+    TEST_ASSERT_EQUAL(MBED_CONF_TARGET_GPIO_IRQ_QUEUE_SIZE, popped);
+    TEST_ASSERT_EQUAL(edges, gpio_irq_queue_dropped(&queue));
+
+    gpio_irq_free(&gpio_irq);
+}
+
+#define LATENCY_SAMPLES 64
+// The FPGA measures the pulses in 10 ns ticks
+#define FPGA_TICK_NS 10
+
+static gpio_t latency_gpio;
+
+// Driving the line low ends the high pulse measured by the FPGA
+static void latency_irq_handler(uint32_t id, gpio_irq_event event)
+{
+    gpio_write(&latency_gpio, 0);
+    gpio_dir(&latency_gpio, PIN_OUTPUT);
+}
+
+void fpga_gpio_irq_latency_test(PinName pin)
+{
+    uint32_t samples[LATENCY_SAMPLES];
+    uint64_t total = 0;
+
+    // Reset everything and set all tester pins to hi-Z.
+    tester.reset();
+
+    // Map pins for test.
+    tester.pin_map_set(pin, MbedTester::LogicalPinGPIO0);
+    tester.pin_set_pull(pin, MbedTester::PullUp);
+
+    // Select GPIO0.
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    gpio_init_in(&latency_gpio, pin);
+    gpio_mode(&latency_gpio, PullNone);
+
+    gpio_irq_t gpio_irq;
+    TEST_ASSERT_EQUAL(0, gpio_irq_init(&gpio_irq, pin, latency_irq_handler, 123));
+    gpio_irq_set(&gpio_irq, IRQ_RISE, true);
+    gpio_irq_enable(&gpio_irq);
+
+    // The tester releases the line, which its pull-up raises, and the handler
+    // drives it low again: the high pulse lasts from the edge to the handler.
+    for (int i = 0; i < LATENCY_SAMPLES; i++) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+        gpio_dir(&latency_gpio, PIN_INPUT);
+        WAIT();
+
+        tester.io_metrics_start();
+        tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, false);
+        WAIT();
+        tester.io_metrics_stop();
+
+        TEST_ASSERT_EQUAL_UINT32(1, tester.io_metrics_rising_edges(MbedTester::LogicalPinGPIO0));
+        TEST_ASSERT_EQUAL_UINT32(1, tester.io_metrics_falling_edges(MbedTester::LogicalPinGPIO0));
+        samples[i] = tester.io_metrics_max_pulse_high(MbedTester::LogicalPinGPIO0) * FPGA_TICK_NS;
+        total += samples[i];
+    }
+
+    gpio_irq_free(&gpio_irq);
+    gpio_dir(&latency_gpio, PIN_INPUT);
+    tester.reset();
+    tester.pin_set_pull(pin, MbedTester::PullNone);
+
+    // Sort the samples to report the distribution
+    for (int i = 1; i < LATENCY_SAMPLES; i++) {
+        const uint32_t sample = samples[i];
+        int j = i;
+        for (; j > 0 && samples[j - 1] > sample; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+
+    utest_printf("\nIRQ latency (ns): min %lu, avg %lu, median %lu, 90%% %lu, max %lu ... ",
+                 (unsigned long)samples[0], (unsigned long)(total / LATENCY_SAMPLES),
+                 (unsigned long)samples[LATENCY_SAMPLES / 2], (unsigned long)samples[LATENCY_SAMPLES * 9 / 10],
+                 (unsigned long)samples[LATENCY_SAMPLES - 1]);
+}
+
 Case cases[] = {
     Case("init/free", all_ports<GPIOIRQPort, DefaultFormFactor, fpga_gpio_irq_init_free_test>),
     Case("rising & falling edge", all_ports<GPIOIRQPort, DefaultFormFactor, fpga_gpio_irq_test>),
+    Case("timestamped edge queue", all_ports<GPIOIRQPort, DefaultFormFactor, fpga_gpio_irq_queue_test>),
+    Case("edge to handler latency", one_peripheral<GPIOIRQPort, DefaultFormFactor, fpga_gpio_irq_latency_test>),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -72,6 +72,24 @@ void fpga_i2c_test_read(PinName sda, PinName scl);
  */
 void fpga_i2c_test_write(PinName sda, PinName scl);
 
+/** Test that I2C master is able to access slave registers using i2c_mem_write and i2c_mem_read.
+ *
+ * Given board provides I2C master support.
+ * When I2C master writes and reads registers using i2c_mem_write and i2c_mem_read.
+ * Then the register address and the data are transferred in one transaction each.
+ *
+ */
+void fpga_i2c_test_mem(PinName sda, PinName scl);
+
+/** Test that the I2C master SCL timing conforms to the requested frequency and the I2C specification.
+ *
+ * Given board provides I2C master support.
+ * When I2C master writes data at a frequency of the Standard-mode or Fast-mode, measured by the FPGA.
+ * Then SCL is not faster than requested and its low and high times are not below the specification.
+ *
+ */
+void fpga_i2c_test_timing(PinName sda, PinName scl);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -30,6 +30,7 @@
 #include "pinmap.h"
 #include "hal/static_pinmap.h"
 #include "test_utils.h"
+#include "us_ticker_api.h"
 #include "I2CTester.h"
 #include "i2c_fpga_test.h"
 
@@ -41,6 +42,12 @@ using namespace utest::v1;
 #define I2C_DEV_ADDR 0x98//default i2c slave address on FPGA is 0x98 until modified
 const int TRANSFER_COUNT = 300;
 
+// The FPGA measures the pulses in 10 ns ticks
+#define FPGA_TICK_HZ 100000000
+#define FPGA_TICK_NS 10
+// Margin of the measured timing over the I2C specification
+#define TIMING_TOLERANCE_PERCENT 5
+
 I2CTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
 
 void fpga_test_i2c_init_free(PinName sda, PinName scl)
@@ -444,6 +451,167 @@ void fpga_i2c_test_byte_read(PinName sda, PinName scl)
     i2c_free(&i2c);
 }
 
+#define MEM_TRANSFER_COUNT 16
+#define MEM_ADDRESS 0x3B
+
+void fpga_i2c_test_mem(PinName sda, PinName scl)
+{
+    // Remap pins for test
+    tester.reset();
+    tester.pin_map_set(sda, MbedTester::LogicalPinI2CSda);
+    tester.pin_map_set(scl, MbedTester::LogicalPinI2CScl);
+
+    tester.pin_set_pull(sda, MbedTester::PullUp);
+    tester.pin_set_pull(scl, MbedTester::PullUp);
+
+    // Initialize mbed I2C pins
+    i2c_t i2c;
+    memset(&i2c, 0, sizeof(i2c));
+    i2c_init(&i2c, sda, scl);
+    i2c_frequency(&i2c, 100000);
+
+    uint8_t data_out[MEM_TRANSFER_COUNT];
+    uint8_t data_in[MEM_TRANSFER_COUNT] = {};
+    uint32_t checksum = MEM_ADDRESS;
+    for (int i = 0; i < MEM_TRANSFER_COUNT; i++) {
+        data_out[i] = i & 0xFF;
+        checksum += data_out[i];
+    }
+
+    // Register write: the register address and the data in one transaction
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralI2C);
+    TEST_ASSERT_EQUAL(0, i2c_mem_write(&i2c, I2C_DEV_ADDR, MEM_ADDRESS, 1, data_out, MEM_TRANSFER_COUNT));
+
+    TEST_ASSERT_EQUAL(1, tester.num_dev_addr_matches());
+    TEST_ASSERT_EQUAL(1, tester.num_starts());
+    TEST_ASSERT_EQUAL(1, tester.num_stops());
+    TEST_ASSERT_EQUAL(MEM_TRANSFER_COUNT + 1, tester.num_writes());
+    TEST_ASSERT_EQUAL(0, tester.num_reads());
+    TEST_ASSERT_EQUAL(checksum, tester.get_receive_checksum());
+    TEST_ASSERT_EQUAL(data_out[MEM_TRANSFER_COUNT - 1], tester.get_prev_to_slave_1());
+    TEST_ASSERT_EQUAL(0, tester.state_num());
+
+    // Register read: the register address, a repeated start and the data
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralI2C);
+    tester.set_next_from_slave(0);
+    TEST_ASSERT_EQUAL(0, i2c_mem_read(&i2c, I2C_DEV_ADDR, MEM_ADDRESS, 1, data_in, MEM_TRANSFER_COUNT));
+
+    checksum = 0;
+    for (int i = 0; i < MEM_TRANSFER_COUNT; i++) {
+        TEST_ASSERT_EQUAL(i & 0xFF, data_in[i]);
+        checksum += data_in[i];
+    }
+    TEST_ASSERT_EQUAL(2, tester.num_dev_addr_matches());
+    TEST_ASSERT_EQUAL(2, tester.num_starts());
+    TEST_ASSERT_EQUAL(1, tester.num_stops());
+    TEST_ASSERT_EQUAL(1, tester.num_writes());
+    TEST_ASSERT_EQUAL(MEM_TRANSFER_COUNT, tester.num_reads());
+    TEST_ASSERT_EQUAL(MEM_ADDRESS, tester.get_prev_to_slave_1());
+    TEST_ASSERT_EQUAL(checksum, tester.get_send_checksum());
+    TEST_ASSERT_EQUAL(0, tester.state_num());
+
+    tester.reset();
+    tester.pin_set_pull(sda, MbedTester::PullNone);
+    tester.pin_set_pull(scl, MbedTester::PullNone);
+    i2c_free(&i2c);
+}
+
+/* Shortest SCL low and high times of the I2C specification, in ns. */
+static void i2c_spec_timing(int frequency, uint32_t *low_ns, uint32_t *high_ns)
+{
+    if (frequency <= 100000) {
+        *low_ns = 4700;
+        *high_ns = 4000;
+    } else if (frequency <= 400000) {
+        *low_ns = 1300;
+        *high_ns = 600;
+    } else {
+        *low_ns = 500;
+        *high_ns = 260;
+    }
+}
+
+/* Measure the SCL timing of a write. The low pulses of SCL also span the
+ * gaps between bytes, the shortest one is the clock low time.
+ */
+template<int frequency>
+void fpga_i2c_test_timing(PinName sda, PinName scl)
+{
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+    i2c_capabilities_t capabilities;
+    uint32_t spec_low_ns;
+    uint32_t spec_high_ns;
+
+    // Remap pins for test
+    tester.reset();
+    tester.pin_map_set(sda, MbedTester::LogicalPinI2CSda);
+    tester.pin_map_set(scl, MbedTester::LogicalPinI2CScl);
+
+    tester.pin_set_pull(sda, MbedTester::PullUp);
+    tester.pin_set_pull(scl, MbedTester::PullUp);
+
+    i2c_t i2c;
+    memset(&i2c, 0, sizeof(i2c));
+    i2c_init(&i2c, sda, scl);
+    i2c_get_capabilities(&i2c, &capabilities);
+
+    if (frequency > (int)capabilities.maximum_frequency) {
+        utest_printf("\n<Specified frequency is not supported on this platform> skipped. ");
+        tester.reset();
+        tester.pin_set_pull(sda, MbedTester::PullNone);
+        tester.pin_set_pull(scl, MbedTester::PullNone);
+        i2c_free(&i2c);
+        return;
+    }
+    i2c_frequency(&i2c, frequency);
+    i2c_spec_timing(frequency, &spec_low_ns, &spec_high_ns);
+
+    // Reset tester stats and select I2C
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralI2C);
+
+    uint8_t data_out[TRANSFER_COUNT];
+    uint32_t checksum = 0;
+    for (int i = 0; i < TRANSFER_COUNT; i++) {
+        data_out[i] = i & 0xFF;
+        checksum += data_out[i];
+    }
+
+    tester.io_metrics_start();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    const int num_writes = i2c_write(&i2c, I2C_DEV_ADDR, (char *)data_out, TRANSFER_COUNT, true);
+    const us_timestamp_t elapsed_us = ticker_read_us(us_ticker) - start;
+    tester.io_metrics_stop();
+
+    TEST_ASSERT_EQUAL(TRANSFER_COUNT, num_writes);
+    TEST_ASSERT_EQUAL(checksum, tester.get_receive_checksum());
+    // Nine clocks for the address and for every byte
+    TEST_ASSERT_EQUAL_UINT32(9 * (TRANSFER_COUNT + 1), tester.io_metrics_rising_edges(MbedTester::LogicalPinI2CScl));
+
+    const uint32_t low_ticks = tester.io_metrics_min_pulse_low(MbedTester::LogicalPinI2CScl);
+    const uint32_t high_ticks = tester.io_metrics_min_pulse_high(MbedTester::LogicalPinI2CScl);
+    const uint32_t gap_ticks = tester.io_metrics_max_pulse_low(MbedTester::LogicalPinI2CScl) - low_ticks;
+    const uint32_t period_ticks = low_ticks + high_ticks;
+
+    TEST_ASSERT_MESSAGE(period_ticks + 2 >= (FPGA_TICK_HZ / frequency) * (100 - TIMING_TOLERANCE_PERCENT) / 100, "SCL faster than requested");
+    TEST_ASSERT_MESSAGE(low_ticks * FPGA_TICK_NS >= spec_low_ns * (100 - TIMING_TOLERANCE_PERCENT) / 100, "SCL low time below the I2C specification");
+    TEST_ASSERT_MESSAGE(high_ticks * FPGA_TICK_NS >= spec_high_ns * (100 - TIMING_TOLERANCE_PERCENT) / 100, "SCL high time below the I2C specification");
+
+    utest_printf("\nSCL %lu Hz (requested %lu Hz), low %lu ns, high %lu ns, byte gap %lu ns, %lu bytes/s (%lu%% of the bus rate) ",
+                 (unsigned long)(FPGA_TICK_HZ / period_ticks), (unsigned long)frequency,
+                 (unsigned long)(low_ticks * FPGA_TICK_NS), (unsigned long)(high_ticks * FPGA_TICK_NS),
+                 (unsigned long)(gap_ticks * FPGA_TICK_NS),
+                 (unsigned long)(TRANSFER_COUNT * 1000000ULL / elapsed_us),
+                 (unsigned long)(9ULL * (TRANSFER_COUNT + 1) * period_ticks * 100 / (elapsed_us * (FPGA_TICK_HZ / 1000000))));
+
+    tester.reset();
+    tester.pin_set_pull(sda, MbedTester::PullNone);
+    tester.pin_set_pull(scl, MbedTester::PullNone);
+    i2c_free(&i2c);
+}
+
 Case cases[] = {
     Case("i2c - init/free test all pins", all_ports<I2CPort, DefaultFormFactor, fpga_test_i2c_init_free>),
     Case("i2c - test write i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_write<false>>),
@@ -451,7 +619,10 @@ Case cases[] = {
     Case("i2c - test read i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_read<false>>),
     Case("i2c (direct init) - test read i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_read<true>>),
     Case("i2c - test single byte write i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_byte_write>),
-    Case("i2c - test single byte read i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_byte_read>)
+    Case("i2c - test single byte read i2c API", all_peripherals<I2CPort, DefaultFormFactor, fpga_i2c_test_byte_read>),
+    Case("i2c - test register read/write i2c API", one_peripheral<I2CPort, DefaultFormFactor, fpga_i2c_test_mem>),
+    Case("i2c - timing (100 kHz)", one_peripheral<I2CPort, DefaultFormFactor, fpga_i2c_test_timing<100000>>),
+    Case("i2c - timing (400 kHz)", one_peripheral<I2CPort, DefaultFormFactor, fpga_i2c_test_timing<400000>>)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
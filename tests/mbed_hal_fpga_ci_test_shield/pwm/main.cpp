@@ -42,7 +42,9 @@ typedef enum {
     PERIOD_US_WRITE,
     PERIOD_PULSEWIDTH,
     PERIOD_PULSEWIDTH_MS,
-    PERIOD_PULSEWIDTH_US
+    PERIOD_PULSEWIDTH_US,
+    PERIOD_TICKS_WRITE_U16,
+    PERIOD_TICKS_PULSEWIDTH_TICKS
 } pwm_api_test_t;
 
 #define NUM_OF_PERIODS                  10
@@ -57,6 +59,8 @@ typedef enum {
 #define FILL_FLOAT(PRC) ((float)(PRC) / 100)
 #define PULSE_HIGH_US(PERIOD_US, PRC) ((uint32_t)((PERIOD_US) * FILL_FLOAT(PRC)))
 #define PULSE_LOW_US(PERIOD_US, PRC) ((uint32_t)((PERIOD_US) * (1.0f - FILL_FLOAT(PRC))))
+#define FILL_U16(PRC) ((uint16_t)((PRC) * 0xFFFF / 100))
+#define US_TO_TICKS(US, FREQ) ((uint32_t)((uint64_t)(US) * (FREQ) / US_PER_SEC))
 
 
 MbedTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
@@ -124,6 +128,16 @@ void fpga_pwm_period_fill_test(PinName pin, uint32_t period_ms, uint32_t fill_pr
             pwmout_period(&pwm_out, PERIOD_FLOAT(period_ms));
             pwmout_pulsewidth_us(&pwm_out, (int)PULSE_HIGH_US(PERIOD_US(period_ms), fill_prc));
             break;
+
+        case PERIOD_TICKS_WRITE_U16:
+            pwmout_period_ticks(&pwm_out, US_TO_TICKS(PERIOD_US(period_ms), pwmout_tick_frequency(&pwm_out)));
+            pwmout_write_u16(&pwm_out, FILL_U16(fill_prc));
+            break;
+
+        case PERIOD_TICKS_PULSEWIDTH_TICKS:
+            pwmout_period_ticks(&pwm_out, US_TO_TICKS(PERIOD_US(period_ms), pwmout_tick_frequency(&pwm_out)));
+            pwmout_pulsewidth_ticks(&pwm_out, US_TO_TICKS(PULSE_HIGH_US(PERIOD_US(period_ms), fill_prc), pwmout_tick_frequency(&pwm_out)));
+            break;
     }
 
     // wait_us is safe to call as this test disable the IRQs on execution.
@@ -168,9 +182,53 @@ void fpga_pwm_period_fill_test(PinName pin)
 }
 
 
+#define IRQ_PERIOD_US 1000
+#define IRQ_PERIODS 20
+
+static void test_period_irq_handler(uint32_t id)
+{
+    (*(volatile uint32_t *)id)++;
+}
+
+void fpga_pwm_period_irq_test(PinName pin)
+{
+    tester.reset();
+    MbedTester::LogicalPin logical_pin = (MbedTester::LogicalPin)(MbedTester::LogicalPinIOMetrics0);
+    tester.pin_map_set(pin, logical_pin);
+
+    pwmout_t pwm_out;
+    pwmout_init(&pwm_out, pin);
+    pwmout_period_us(&pwm_out, IRQ_PERIOD_US);
+    pwmout_write(&pwm_out, 0.5f);
+
+    volatile uint32_t irq_count = 0;
+    if (pwmout_period_irq_set(&pwm_out, test_period_irq_handler, (uint32_t) &irq_count) != 0) {
+        pwmout_free(&pwm_out);
+        TEST_SKIP_MESSAGE("PWM period interrupt not supported");
+        return;
+    }
+
+    tester.io_metrics_start();
+    const uint32_t start_count = irq_count;
+    wait_us(IRQ_PERIODS * IRQ_PERIOD_US);
+    const uint32_t count = irq_count - start_count;
+    tester.io_metrics_stop();
+
+    TEST_ASSERT_EQUAL_INT(0, pwmout_period_irq_set(&pwm_out, NULL, 0));
+    const uint32_t stopped_count = irq_count;
+    wait_us(2 * IRQ_PERIOD_US);
+
+    TEST_ASSERT_UINT32_WITHIN(1, IRQ_PERIODS, count);
+    TEST_ASSERT_UINT32_WITHIN(1, tester.io_metrics_rising_edges(logical_pin), count);
+    TEST_ASSERT_EQUAL_UINT32(stopped_count, irq_count);
+
+    pwmout_free(&pwm_out);
+}
+
 Case cases[] = {
     // This will be run for all pins
     Case("PWM - init/free test", all_ports<PWMPort, DefaultFormFactor, fpga_pwm_init_free>),
+    Case("PWM - period interrupt test", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_irq_test>),
 
     // This will be run for single pin
     Case("PWM - period: 10 ms, fill: 10%, api: period/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_WRITE, false> >),
@@ -181,6 +239,8 @@ Case cases[] = {
     Case("PWM - period: 10 ms, fill: 10%, api: period/pulse_width", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_PULSEWIDTH, false> >),
     Case("PWM - period: 10 ms, fill: 10%, api: period/pulse_width_ms", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_PULSEWIDTH_MS, false> >),
     Case("PWM - period: 10 ms, fill: 10%, api: period/pulse_width_us", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_PULSEWIDTH_US, false> >),
+    Case("PWM - period: 10 ms, fill: 10%, api: period_ticks/write_u16", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_TICKS_WRITE_U16, false> >),
+    Case("PWM - period: 10 ms, fill: 10%, api: period_ticks/pulse_width_ticks", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 10, PERIOD_TICKS_PULSEWIDTH_TICKS, false> >),
 
     Case("PWM - period: 10 ms, fill: 50%, api: period/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_WRITE, false> >),
     Case("PWM - period: 10 ms, fill: 50%, api: period_ms/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_MS_WRITE, false> >),
@@ -188,6 +248,8 @@ Case cases[] = {
     Case("PWM - period: 10 ms, fill: 50%, api: period/pulse_width", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_PULSEWIDTH, false> >),
     Case("PWM - period: 10 ms, fill: 50%, api: period/pulse_width_ms", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_PULSEWIDTH_MS, false> >),
     Case("PWM - period: 10 ms, fill: 50%, api: period/pulse_width_us", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_PULSEWIDTH_US, false> >),
+    Case("PWM - period: 10 ms, fill: 50%, api: period_ticks/write_u16", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_TICKS_WRITE_U16, false> >),
+    Case("PWM - period: 10 ms, fill: 50%, api: period_ticks/pulse_width_ticks", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 50, PERIOD_TICKS_PULSEWIDTH_TICKS, false> >),
 
     Case("PWM - period: 10 ms, fill: 90%, api: period/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_WRITE, false> >),
     Case("PWM - period: 10 ms, fill: 90%, api: period_ms/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_MS_WRITE, false> >),
@@ -195,6 +257,8 @@ Case cases[] = {
     Case("PWM - period: 10 ms, fill: 90%, api: period/pulse_width", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_PULSEWIDTH, false> >),
     Case("PWM - period: 10 ms, fill: 90%, api: period/pulse_width_ms", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_PULSEWIDTH_MS, false> >),
     Case("PWM - period: 10 ms, fill: 90%, api: period/pulse_width_us", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_PULSEWIDTH_US, false> >),
+    Case("PWM - period: 10 ms, fill: 90%, api: period_ticks/write_u16", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_TICKS_WRITE_U16, false> >),
+    Case("PWM - period: 10 ms, fill: 90%, api: period_ticks/pulse_width_ticks", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<10, 90, PERIOD_TICKS_PULSEWIDTH_TICKS, false> >),
 
     Case("PWM - period: 30 ms, fill: 10%, api: period/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<30, 10, PERIOD_WRITE, false> >),
     Case("PWM - period: 30 ms, fill: 10%, api: period_ms/write", one_peripheral<PWMPort, DefaultFormFactor, fpga_pwm_period_fill_test<30, 10, PERIOD_MS_WRITE, false> >),
@@ -36,17 +36,26 @@ extern "C" {
  */
 void fpga_pwm_init_free(PinName pin);
 
-/** Test that pwmout_period, pwmout_period_ms, pwmout_period_us functions sets the
- * PWM period correctly and pwmout_write, pwmout_pulsewidth, pwmout_pulsewidth_ms,
- * pwmout_pulsewidth_us functions sets the pulse width correctly.
+/** Test that pwmout_period, pwmout_period_ms, pwmout_period_us, pwmout_period_ticks functions sets the
+ * PWM period correctly and pwmout_write, pwmout_write_u16, pwmout_pulsewidth, pwmout_pulsewidth_ms,
+ * pwmout_pulsewidth_us, pwmout_pulsewidth_ticks functions sets the pulse width correctly.
  *
  * Given board provides PWM support.
- * When PWM period/width is set using pwmout_period, pwmout_period_ms, pwmout_period_us/pwmout_write, pwmout_pulsewidth, pwmout_pulsewidth_ms, pwmout_pulsewidth_us
+ * When PWM period/width is set using pwmout_period, pwmout_period_ms, pwmout_period_us, pwmout_period_ticks/pwmout_write, pwmout_write_u16, pwmout_pulsewidth, pwmout_pulsewidth_ms, pwmout_pulsewidth_us, pwmout_pulsewidth_ticks
  * Then the valid PWM puswidth and period is on output.
  *
  */
 void fpga_pwm_period_fill_test(PinName pin);
 
+/** Test that pwmout_period_irq_set calls the handler once per PWM period.
+ *
+ * Given board provides PWM support with the period interrupt.
+ * When the period interrupt is enabled with pwmout_period_irq_set.
+ * Then the handler is called once for every PWM period until it is disabled.
+ *
+ */
+void fpga_pwm_period_irq_test(PinName pin);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,290 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !DEVICE_QEI
+#error [NOT_SUPPORTED] Quadrature encoder interface not supported for this target
+#elif !COMPONENT_FPGA_CI_TEST_SHIELD
+#error [NOT_SUPPORTED] FPGA CI Test Shield is needed to run this test
+#elif !(defined(TARGET_FF_ARDUINO) || defined(TARGET_FF_ARDUINO_UNO)) && !defined(MBED_CONF_TARGET_DEFAULT_FORM_FACTOR)
+#error [NOT_SUPPORTED] Test not supported for this form factor
+#else
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "mbed.h"
+#include "MbedTester.h"
+#include "pinmap.h"
+#include "hal/qei_api.h"
+#include "hal/static_pinmap.h"
+#include "test_utils.h"
+#include "qei_fpga_test.h"
+
+using namespace utest::v1;
+
+#define WAIT() wait_us(10)
+
+#define NUM_OF_CYCLES 10
+
+#define COUNTER_MASK(BITS) ((uint32_t)(((uint64_t)1 << (BITS)) - 1))
+
+// The port types of the FPGA test utilities don't cover the encoder interface
+struct QEIMaps {
+    static const PinMap *maps[];
+    static const char *const pin_type_names[];
+    static const char *const name;
+};
+const PinMap *QEIMaps::maps[] = { qei_a_pinmap(), qei_b_pinmap() };
+const char *const QEIMaps::pin_type_names[] = { "A", "B" };
+const char *const QEIMaps::name = "QEI";
+typedef Port<2, QEIMaps, DefaultFormFactor, TF2> QEIPort;
+
+struct QEIIndexMaps {
+    static const PinMap *maps[];
+    static const char *const pin_type_names[];
+    static const char *const name;
+};
+const PinMap *QEIIndexMaps::maps[] = { qei_a_pinmap(), qei_b_pinmap(), qei_index_pinmap() };
+const char *const QEIIndexMaps::pin_type_names[] = { "A", "B", "INDEX" };
+const char *const QEIIndexMaps::name = "QEI";
+typedef Port<3, QEIIndexMaps, DefaultFormFactor, TF3> QEIIndexPort;
+
+
+MbedTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
+
+static volatile uint32_t call_counter;
+static volatile uint32_t call_events;
+
+static void test_qei_irq_handler(uint32_t id, uint32_t events)
+{
+    call_counter++;
+    call_events |= events;
+}
+
+/* Levels of A and B over a quadrature cycle with A leading B */
+static const int quadrature_a[] = { 1, 1, 0, 0 };
+static const int quadrature_b[] = { 0, 1, 1, 0 };
+
+/* Drive one count of the encoder, up with A leading B */
+static void step(int *phase, bool up)
+{
+    *phase = (*phase + (up ? 1 : 3)) % 4;
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, quadrature_a[*phase], true);
+    tester.gpio_write(MbedTester::LogicalPinGPIO1, quadrature_b[*phase], true);
+    WAIT();
+}
+
+static void tester_setup(PinName a, PinName b, PinName index)
+{
+    tester.reset();
+    tester.pin_map_set(a, MbedTester::LogicalPinGPIO0);
+    tester.pin_map_set(b, MbedTester::LogicalPinGPIO1);
+    if (index != NC) {
+        tester.pin_map_set(index, MbedTester::LogicalPinGPIO2);
+    }
+    tester.select_peripheral(MbedTester::PeripheralGPIO);
+
+    // Start from the last phase of the cycle, both signals low.
+    tester.gpio_write(MbedTester::LogicalPinGPIO0, 0, true);
+    tester.gpio_write(MbedTester::LogicalPinGPIO1, 0, true);
+    if (index != NC) {
+        tester.gpio_write(MbedTester::LogicalPinGPIO2, 0, true);
+    }
+    WAIT();
+}
+
+void fpga_qei_init_free(PinName a, PinName b)
+{
+    qei_t qei;
+
+    qei_init(&qei, a, b, NC, QEI_MODE_X4);
+    qei_free(&qei);
+}
+
+void fpga_qei_count_test(PinName a, PinName b, qei_mode_t mode, bool init_direct)
+{
+    tester_setup(a, b, NC);
+
+    qei_t qei;
+
+    if (init_direct) {
+        const qei_pinmap_t pinmap = get_qei_pinmap(a, b, NC);
+        qei_init_direct(&qei, &pinmap, mode);
+    } else {
+        qei_init(&qei, a, b, NC, mode);
+    }
+
+    qei_capabilities_t cap;
+    qei_get_capabilities(&qei, &cap);
+    if (mode == QEI_MODE_X4 && !cap.x4) {
+        qei_free(&qei);
+        TEST_SKIP_MESSAGE("QEI_MODE_X4 not supported");
+        return;
+    }
+
+    const uint32_t counts_per_cycle = (mode == QEI_MODE_X4) ? 4 : 2;
+    int phase = 3;
+
+    TEST_ASSERT_EQUAL_UINT32(0, qei_read(&qei));
+
+    for (int i = 0; i < 4 * NUM_OF_CYCLES; i++) {
+        step(&phase, true);
+    }
+    TEST_ASSERT_EQUAL_UINT32(NUM_OF_CYCLES * counts_per_cycle, qei_read(&qei));
+    TEST_ASSERT_EQUAL(QEI_DIRECTION_UP, qei_direction(&qei));
+
+    for (int i = 0; i < 4 * NUM_OF_CYCLES; i++) {
+        step(&phase, false);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, qei_read(&qei));
+    TEST_ASSERT_EQUAL(QEI_DIRECTION_DOWN, qei_direction(&qei));
+
+    qei_write(&qei, 100);
+    TEST_ASSERT_EQUAL_UINT32(100, qei_read(&qei));
+
+    qei_free(&qei);
+}
+
+template<qei_mode_t mode, bool init_direct>
+void fpga_qei_count_test(PinName a, PinName b)
+{
+    fpga_qei_count_test(a, b, mode, init_direct);
+}
+
+void fpga_qei_overflow_test(PinName a, PinName b)
+{
+    tester_setup(a, b, NC);
+
+    qei_t qei;
+    qei_init(&qei, a, b, NC, QEI_MODE_X4);
+
+    qei_capabilities_t cap;
+    qei_get_capabilities(&qei, &cap);
+    const uint32_t events = QEI_EVENT_OVERFLOW | QEI_EVENT_UNDERFLOW;
+    if (!cap.x4 || (cap.events & events) != events) {
+        qei_free(&qei);
+        TEST_SKIP_MESSAGE("Overflow events not supported");
+        return;
+    }
+
+    const uint32_t max = COUNTER_MASK(cap.counter_bits);
+    int phase = 3;
+
+    call_counter = 0;
+    call_events = 0;
+    TEST_ASSERT_EQUAL(0, qei_irq_set(&qei, test_qei_irq_handler, 0, events));
+
+    qei_write(&qei, max);
+    step(&phase, true);
+    TEST_ASSERT_EQUAL_UINT32(0, qei_read(&qei));
+    TEST_ASSERT_EQUAL_UINT32(1, call_counter);
+    TEST_ASSERT_EQUAL_UINT32(QEI_EVENT_OVERFLOW, call_events);
+
+    call_events = 0;
+    step(&phase, false);
+    TEST_ASSERT_EQUAL_UINT32(max, qei_read(&qei));
+    TEST_ASSERT_EQUAL_UINT32(2, call_counter);
+    TEST_ASSERT_EQUAL_UINT32(QEI_EVENT_UNDERFLOW, call_events);
+
+    TEST_ASSERT_EQUAL(0, qei_irq_set(&qei, test_qei_irq_handler, 0, 0));
+    qei_write(&qei, max);
+    step(&phase, true);
+    TEST_ASSERT_EQUAL_UINT32(2, call_counter);
+
+    qei_free(&qei);
+}
+
+void fpga_qei_index_test(PinName a, PinName b, PinName index)
+{
+    tester_setup(a, b, index);
+
+    qei_t qei;
+    qei_init(&qei, a, b, index, QEI_MODE_X4);
+
+    qei_capabilities_t cap;
+    qei_get_capabilities(&qei, &cap);
+    if (!cap.x4 || !cap.index || !cap.index_reset) {
+        qei_free(&qei);
+        TEST_SKIP_MESSAGE("Index pulse not supported");
+        return;
+    }
+
+    int phase = 3;
+
+    call_counter = 0;
+    call_events = 0;
+    TEST_ASSERT_EQUAL(0, qei_irq_set(&qei, test_qei_irq_handler, 0, QEI_EVENT_INDEX));
+    TEST_ASSERT_EQUAL(0, qei_index_reset(&qei, true));
+
+    for (int i = 0; i < 4 * NUM_OF_CYCLES; i++) {
+        step(&phase, true);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4 * NUM_OF_CYCLES, qei_read(&qei));
+    TEST_ASSERT_EQUAL_UINT32(0, call_counter);
+
+    tester.gpio_write(MbedTester::LogicalPinGPIO2, 1, true);
+    WAIT();
+    tester.gpio_write(MbedTester::LogicalPinGPIO2, 0, true);
+    WAIT();
+
+    TEST_ASSERT_EQUAL_UINT32(0, qei_read(&qei));
+    TEST_ASSERT_EQUAL_UINT32(1, call_counter);
+    TEST_ASSERT_EQUAL_UINT32(QEI_EVENT_INDEX, call_events);
+
+    TEST_ASSERT_EQUAL(0, qei_index_reset(&qei, false));
+    step(&phase, true);
+    tester.gpio_write(MbedTester::LogicalPinGPIO2, 1, true);
+    WAIT();
+    tester.gpio_write(MbedTester::LogicalPinGPIO2, 0, true);
+    WAIT();
+
+    TEST_ASSERT_EQUAL_UINT32(1, qei_read(&qei));
+    TEST_ASSERT_EQUAL_UINT32(2, call_counter);
+
+    TEST_ASSERT_EQUAL(0, qei_irq_set(&qei, test_qei_irq_handler, 0, 0));
+    qei_free(&qei);
+}
+
+Case cases[] = {
+    // This will be run for all pins
+    Case("QEI - init/free test", all_ports<QEIPort, DefaultFormFactor, fpga_qei_init_free>),
+
+    // This will be run for single pin
+    Case("QEI - count test (X2)", one_peripheral<QEIPort, DefaultFormFactor, fpga_qei_count_test<QEI_MODE_X2, false> >),
+    Case("QEI - count test (X4)", one_peripheral<QEIPort, DefaultFormFactor, fpga_qei_count_test<QEI_MODE_X4, false> >),
+    Case("QEI (direct init) - count test (X4)", one_peripheral<QEIPort, DefaultFormFactor, fpga_qei_count_test<QEI_MODE_X4, true> >),
+    Case("QEI - overflow test", one_peripheral<QEIPort, DefaultFormFactor, fpga_qei_overflow_test>),
+    Case("QEI - index test", one_peripheral<QEIIndexPort, DefaultFormFactor, fpga_qei_index_test>)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+#ifdef FPGA_FORCE_ALL_PORTS
+    GREENTEA_SETUP(300, "default_auto");
+#else
+    GREENTEA_SETUP(120, "default_auto");
+#endif
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif /* !DEVICE_QEI */
@@ -0,0 +1,76 @@
+/* Copyright (c) 2021 Arm Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup hal_qei_tests */
+/** @{*/
+
+#ifndef MBED_FPGA_QEI_TEST_H
+#define MBED_FPGA_QEI_TEST_H
+
+#if DEVICE_QEI
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Test that the quadrature encoder interface can be initialized/de-initialized using all possible
+ *  A and B pins.
+ *
+ * Given board provides quadrature encoder interface support.
+ * When the interface is initialized (and then de-initialized) using valid A and B pins.
+ * Then the operation is successfull.
+ *
+ */
+void fpga_qei_init_free(PinName a, PinName b);
+
+/** Test that the counter follows the encoder signals in both directions.
+ *
+ * Given board provides quadrature encoder interface support.
+ * When the FPGA drives quadrature cycles with A leading B, then with B leading A.
+ * Then qei_read returns the number of counted edges of the mode and qei_direction the direction.
+ *
+ */
+void fpga_qei_count_test(PinName a, PinName b);
+
+/** Test that the overflow and underflow events are reported when the counter wraps.
+ *
+ * Given board provides quadrature encoder interface support with overflow events.
+ * When the counter is set to its maximum and counts up, then is set to 0 and counts down.
+ * Then the counter wraps and the handler is called with the overflow, then the underflow event.
+ *
+ */
+void fpga_qei_overflow_test(PinName a, PinName b);
+
+/** Test that the index pulse is reported and resets the counter.
+ *
+ * Given board provides quadrature encoder interface support with the index pulse.
+ * When the FPGA drives an index pulse with the index event and reset enabled.
+ * Then the handler is called with the index event and the counter is reset to 0.
+ *
+ */
+void fpga_qei_index_test(PinName a, PinName b, PinName index);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/**@}*/
@@ -30,6 +30,7 @@
 #include "pinmap.h"
 #include "hal/static_pinmap.h"
 #include "test_utils.h"
+#include "hal/us_ticker_api.h"
 #include "spi_fpga_test.h"
 
 using namespace utest::v1;
@@ -37,6 +38,7 @@ using namespace utest::v1;
 typedef enum {
     TRANSFER_SPI_MASTER_WRITE_SYNC,
     TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC,
+    TRANSFER_SPI_MASTER_BLOCK_WRITE_W_SYNC,
     TRANSFER_SPI_MASTER_TRANSFER_ASYNC
 } transfer_type_t;
 
@@ -62,6 +64,19 @@ typedef enum {
 
 #define TEST_CAPABILITY_BIT(MASK, CAP) ((1 << CAP) & (MASK))
 
+// The FPGA measures the pulses in 10 ns ticks
+#define FPGA_TICK_HZ  (100000000)
+#define FPGA_TICK_NS  (10)
+
+// Margin of the measured bus clock over the requested frequency
+#define TIMING_FREQ_TOLERANCE_PERCENT 5
+// Delays set with spi_cs_config, if the hardware chip select supports them
+#define TIMING_CS_DELAY_NS 1000
+// Longest gap allowed between two symbols of a transfer, in clock periods
+#ifndef TIMING_MAX_GAP_PERIODS
+#define TIMING_MAX_GAP_PERIODS 8
+#endif
+
 const int TRANSFER_COUNT = 300;
 SPIMasterTester tester(DefaultFormFactor::pins(), DefaultFormFactor::restricted_pins());
 
@@ -334,6 +349,28 @@ void fpga_spi_test_common(PinName mosi, PinName miso, PinName sclk, PinName ssel
             TEST_ASSERT_EQUAL(sym_count, result);
             break;
 
+        case TRANSFER_SPI_MASTER_BLOCK_WRITE_W_SYNC: {
+            uint16_t tx_words[TRANSFER_COUNT];
+            uint16_t rx_words[TRANSFER_COUNT];
+
+            for (int i = 0; i < TRANSFER_COUNT; i++) {
+                tx_words[i] = (0 - i) & sym_mask;
+                checksum += (0 - i) & sym_mask;
+                rx_words[i] = 0xAAAA;
+            }
+
+            handle_ss(ss, true);
+            result = spi_master_block_write_w(&spi, tx_words, rx_words, TRANSFER_COUNT, 16);
+            handle_ss(ss, false);
+
+            for (int i = 0; i < TRANSFER_COUNT; i++) {
+                TEST_ASSERT_EQUAL(i & sym_mask, rx_words[i]);
+            }
+
+            TEST_ASSERT_EQUAL(sym_count, result);
+            break;
+        }
+
 #if DEVICE_SPI_ASYNCH
         case TRANSFER_SPI_MASTER_TRANSFER_ASYNC:
             for (int i = 0; i < TRANSFER_COUNT; i++) {
@@ -384,6 +421,203 @@ void fpga_spi_test_common_no_ss(PinName mosi, PinName miso, PinName sclk)
     fpga_spi_test_common(mosi, miso, sclk, ssel, spi_mode, sym_size, transfer_type, frequency, test_buffers, auto_ss, init_direct);
 }
 
+/* Measure the bus timing of transfers with the chip select handled by hardware.
+ *
+ * In mode 0 the high pulses of the clock are half periods, and the low ones
+ * also span the gaps between symbols. The chip select setup and hold times
+ * are measured together, from a single symbol transfer.
+ */
+void fpga_spi_test_timing(PinName mosi, PinName miso, PinName sclk, PinName ssel, transfer_type_t transfer_type, uint32_t frequency, spi_cs_mode_t cs_mode)
+{
+    spi_capabilities_t capabilities;
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+
+    spi_get_capabilities(ssel, false, &capabilities);
+
+    if (check_capabilities(&capabilities, SPITester::Mode0, 8, transfer_type, frequency, BUFFERS_COMMON) == false) {
+        return;
+    }
+
+    if (!capabilities.hw_cs_handle || !TEST_CAPABILITY_BIT(capabilities.hw_cs_modes, cs_mode)) {
+        utest_printf("\n<Specified hardware chip select mode is not supported on this platform> skipped. ");
+        return;
+    }
+
+    const uint32_t cs_delay_ns = capabilities.hw_cs_delay_max_ns < TIMING_CS_DELAY_NS ? capabilities.hw_cs_delay_max_ns : TIMING_CS_DELAY_NS;
+    const spi_cs_config_t cs_config = { cs_mode, cs_delay_ns, cs_delay_ns, cs_delay_ns };
+    const uint32_t cs_delay_ticks = cs_delay_ns / FPGA_TICK_NS;
+
+    // Remap pins for test
+    tester.reset();
+    tester.pin_map_set(mosi, MbedTester::LogicalPinSPIMosi);
+    tester.pin_map_set(miso, MbedTester::LogicalPinSPIMiso);
+    tester.pin_map_set(sclk, MbedTester::LogicalPinSPISclk);
+    tester.pin_map_set(ssel, MbedTester::LogicalPinSPISsel);
+
+    spi_init(&spi, mosi, miso, sclk, ssel);
+    spi_format(&spi, 8, SPITester::Mode0, 0);
+    spi_frequency(&spi, frequency);
+    TEST_ASSERT_EQUAL(0, spi_cs_config(&spi, &cs_config));
+
+    // Configure spi_slave module
+    tester.set_mode(SPITester::Mode0);
+    tester.set_bit_order(SPITester::MSBFirst);
+    tester.set_sym_size(8);
+
+    // Reset tester stats and select SPI
+    tester.peripherals_reset();
+    tester.select_peripheral(SPITester::PeripheralSPI);
+
+    uint32_t checksum = 0;
+    uint8_t tx_buf[TRANSFER_COUNT];
+    uint8_t rx_buf[TRANSFER_COUNT];
+
+    for (int i = 0; i < TRANSFER_COUNT; i++) {
+        tx_buf[i] = (0 - i) & 0xFF;
+        checksum += tx_buf[i];
+        rx_buf[i] = 0xAA;
+    }
+
+    tester.io_metrics_start();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+
+    switch (transfer_type) {
+        case TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC:
+            TEST_ASSERT_EQUAL(TRANSFER_COUNT, spi_master_block_write(&spi, (const char *)tx_buf, TRANSFER_COUNT, (char *)rx_buf, TRANSFER_COUNT, 0xF5));
+            break;
+
+#if DEVICE_SPI_ASYNCH
+        case TRANSFER_SPI_MASTER_TRANSFER_ASYNC:
+            async_trasfer_done = false;
+            spi_master_transfer(&spi, tx_buf, TRANSFER_COUNT, rx_buf, TRANSFER_COUNT, 8, (uint32_t)spi_async_handler, SPI_EVENT_COMPLETE, DMA_USAGE_NEVER);
+            while (!async_trasfer_done);
+            break;
+#endif
+        default:
+            TEST_ASSERT_MESSAGE(0, "Unsupported transfer type.");
+            break;
+    }
+
+    const us_timestamp_t elapsed_us = ticker_read_us(us_ticker) - start;
+    tester.io_metrics_stop();
+
+    for (int i = 0; i < TRANSFER_COUNT; i++) {
+        TEST_ASSERT_EQUAL(i & 0xFF, rx_buf[i]);
+    }
+    TEST_ASSERT_EQUAL(TRANSFER_COUNT, tester.get_transfer_count());
+    TEST_ASSERT_EQUAL(checksum, tester.get_receive_checksum());
+    TEST_ASSERT_EQUAL_UINT32(TRANSFER_COUNT * 8, tester.io_metrics_rising_edges(MbedTester::LogicalPinSPISclk));
+
+    const uint32_t period_ticks = tester.io_metrics_max_pulse_high(MbedTester::LogicalPinSPISclk) + tester.io_metrics_min_pulse_low(MbedTester::LogicalPinSPISclk);
+    const uint32_t gap_ticks = tester.io_metrics_max_pulse_low(MbedTester::LogicalPinSPISclk) - tester.io_metrics_min_pulse_low(MbedTester::LogicalPinSPISclk);
+    const uint32_t requested_ticks = FPGA_TICK_HZ / frequency;
+
+    // Never faster than requested, and within a divider step of it; one tick of
+    // quantization on each pulse
+    TEST_ASSERT_MESSAGE(period_ticks + 2 >= requested_ticks * (100 - TIMING_FREQ_TOLERANCE_PERCENT) / 100, "Bus clock faster than requested");
+    TEST_ASSERT_MESSAGE(period_ticks <= 2 * requested_ticks + 2, "Bus clock slower than half the requested frequency");
+    TEST_ASSERT_MESSAGE(FPGA_TICK_HZ / period_ticks <= capabilities.maximum_frequency * (100 + TIMING_FREQ_TOLERANCE_PERCENT) / 100, "Bus clock above the maximum frequency of the capabilities");
+
+    // A pulsed chip select adds its delays to every gap
+    const uint32_t max_gap_ticks = TIMING_MAX_GAP_PERIODS * period_ticks + (cs_mode == SPI_CS_PULSE ? 3 * cs_delay_ticks : 0);
+    TEST_ASSERT_MESSAGE(gap_ticks <= max_gap_ticks, "Gap between symbols too long");
+
+    if (cs_mode == SPI_CS_PULSE) {
+        TEST_ASSERT_EQUAL_UINT32(TRANSFER_COUNT, tester.io_metrics_falling_edges(MbedTester::LogicalPinSPISsel));
+        TEST_ASSERT_TRUE(tester.io_metrics_min_pulse_high(MbedTester::LogicalPinSPISsel) + 1 >= cs_delay_ticks);
+    } else {
+        TEST_ASSERT_EQUAL_UINT32(1, tester.io_metrics_falling_edges(MbedTester::LogicalPinSPISsel));
+    }
+
+    // The chip select of a single symbol spans the setup, 7.5 clock periods and the hold
+    tester.peripherals_reset();
+    tester.io_metrics_start();
+    spi_master_write(&spi, 0x55);
+    tester.io_metrics_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(1, tester.io_metrics_falling_edges(MbedTester::LogicalPinSPISsel));
+    const uint32_t cs_low_ticks = tester.io_metrics_max_pulse_low(MbedTester::LogicalPinSPISsel);
+    const uint32_t clocked_ticks = 7 * period_ticks + period_ticks / 2;
+    const uint32_t cs_overhead_ticks = cs_low_ticks > clocked_ticks ? cs_low_ticks - clocked_ticks : 0;
+    // One tick of quantization on each of the eight clock pulses
+    TEST_ASSERT_MESSAGE(cs_overhead_ticks + 8 >= 2 * cs_delay_ticks, "Chip select setup and hold shorter than configured");
+
+    utest_printf("\nclock %lu Hz (requested %lu Hz), symbol gap %lu ns, cs setup+hold %lu ns, %lu bytes/s (%lu%% of the bus rate) ",
+                 (unsigned long)(FPGA_TICK_HZ / period_ticks), (unsigned long)frequency,
+                 (unsigned long)(gap_ticks * FPGA_TICK_NS), (unsigned long)(cs_overhead_ticks * FPGA_TICK_NS),
+                 (unsigned long)(TRANSFER_COUNT * 1000000ULL / elapsed_us),
+                 (unsigned long)(TRANSFER_COUNT * 8ULL * period_ticks * 100 / (elapsed_us * (FPGA_TICK_HZ / 1000000))));
+
+    spi_free(&spi);
+    tester.reset();
+}
+
+template<transfer_type_t transfer_type, uint32_t frequency, spi_cs_mode_t cs_mode>
+void fpga_spi_test_timing(PinName mosi, PinName miso, PinName sclk, PinName ssel)
+{
+    fpga_spi_test_timing(mosi, miso, sclk, ssel, transfer_type, frequency, cs_mode);
+}
+
+void fpga_spi_test_config_switch(PinName mosi, PinName miso, PinName sclk)
+{
+    const SPITester::SpiMode modes[2] = { SPITester::Mode0, SPITester::Mode3 };
+    const uint32_t sym_sizes[2] = { 8, 16 };
+    const int frequencies[2] = { FREQ_1_MHZ, FREQ_500_KHZ };
+    spi_device_config_t configs[2];
+    spi_capabilities_t capabilities;
+    PinName ssel = find_ss_pin(mosi, miso, sclk);
+
+    spi_get_capabilities(ssel, false, &capabilities);
+
+    for (int i = 0; i < 2; i++) {
+        if (check_capabilities(&capabilities, modes[i], sym_sizes[i], TRANSFER_SPI_MASTER_WRITE_SYNC, frequencies[i], BUFFERS_COMMON) == false) {
+            return;
+        }
+    }
+
+    tester.reset();
+    tester.pin_map_set(mosi, MbedTester::LogicalPinSPIMosi);
+    tester.pin_map_set(miso, MbedTester::LogicalPinSPIMiso);
+    tester.pin_map_set(sclk, MbedTester::LogicalPinSPISclk);
+    tester.pin_map_set(ssel, MbedTester::LogicalPinSPISsel);
+
+    DigitalOut ss(ssel, SS_DEASSERT);
+
+    spi_init(&spi, mosi, miso, sclk, NC);
+    for (int i = 0; i < 2; i++) {
+        spi_prepare_config(&spi, &configs[i], sym_sizes[i], modes[i], 0, frequencies[i]);
+    }
+
+    tester.set_bit_order(SPITester::MSBFirst);
+    tester.select_peripheral(SPITester::PeripheralSPI);
+
+    // Switch back and forth between the two devices
+    for (int n = 0; n < 4; n++) {
+        const int i = n % 2;
+        const uint32_t sym_mask = ((1 << sym_sizes[i]) - 1);
+        uint32_t checksum = 0;
+
+        spi_apply_config(&spi, &configs[i]);
+        tester.set_mode(modes[i]);
+        tester.set_sym_size(sym_sizes[i]);
+        tester.peripherals_reset();
+
+        ss = SS_ASSERT;
+        for (int j = 0; j < TRANSFER_COUNT; j++) {
+            uint32_t data = spi_master_write(&spi, (0 - j) & sym_mask);
+            TEST_ASSERT_EQUAL(j & sym_mask, data);
+            checksum += (0 - j) & sym_mask;
+        }
+        ss = SS_DEASSERT;
+
+        TEST_ASSERT_EQUAL(TRANSFER_COUNT, tester.get_transfer_count());
+        TEST_ASSERT_EQUAL(checksum, tester.get_receive_checksum());
+    }
+
+    spi_free(&spi);
+    tester.reset();
+}
+
 Case cases[] = {
     // This will be run for all pins
     Case("SPI - init/free test all pins", all_ports<SPIPort, DefaultFormFactor, fpga_spi_test_init_free>),
@@ -411,11 +645,17 @@ Case cases[] = {
     Case("SPI - frequency testing (capabilities max)", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_common_no_ss<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_WRITE_SYNC, FREQ_MAX, BUFFERS_COMMON, false, false> >),
     Case("SPI - block write", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_common_no_ss<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_1_MHZ, BUFFERS_COMMON, false, false> >),
     Case("SPI - block write(one sym)", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_common_no_ss<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_1_MHZ, BUFFERS_TX_ONE_SYM, false, false> >),
+    Case("SPI - block write (16-bit words)", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_common_no_ss<SPITester::Mode0, 16, TRANSFER_SPI_MASTER_BLOCK_WRITE_W_SYNC, FREQ_1_MHZ, BUFFERS_COMMON, false, false> >),
+    Case("SPI - device configuration switching", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_config_switch>),
     Case("SPI - hardware ss handling", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_common<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_WRITE_SYNC, FREQ_1_MHZ, BUFFERS_COMMON, true, false> >),
     Case("SPI - hardware ss handling(block)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_common<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_1_MHZ, BUFFERS_COMMON, true, false> >),
+    Case("SPI - timing (block, 1 MHz, cs hold)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_timing<TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_1_MHZ, SPI_CS_HOLD> >),
+    Case("SPI - timing (block, 2 MHz, cs hold)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_timing<TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_2_MHZ, SPI_CS_HOLD> >),
+    Case("SPI - timing (block, 1 MHz, cs pulse)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_timing<TRANSFER_SPI_MASTER_BLOCK_WRITE_SYNC, FREQ_1_MHZ, SPI_CS_PULSE> >),
 #if DEVICE_SPI_ASYNCH
     Case("SPI - async mode (sw ss)", one_peripheral<SPINoCSPort, DefaultFormFactor, fpga_spi_test_common_no_ss<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_TRANSFER_ASYNC, FREQ_500_KHZ, BUFFERS_COMMON, false, false> >),
-    Case("SPI - async mode (hw ss)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_common<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_TRANSFER_ASYNC, FREQ_500_KHZ, BUFFERS_COMMON, true, false> >)
+    Case("SPI - async mode (hw ss)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_common<SPITester::Mode0, 8, TRANSFER_SPI_MASTER_TRANSFER_ASYNC, FREQ_500_KHZ, BUFFERS_COMMON, true, false> >),
+    Case("SPI - timing (async, 1 MHz, cs hold)", one_peripheral<SPIPort, DefaultFormFactor, fpga_spi_test_timing<TRANSFER_SPI_MASTER_TRANSFER_ASYNC, FREQ_1_MHZ, SPI_CS_HOLD> >)
 #endif
 };
 
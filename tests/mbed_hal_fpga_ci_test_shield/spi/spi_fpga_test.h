@@ -54,6 +54,25 @@ void fpga_spi_test_common(PinName mosi, PinName miso, PinName sclk, PinName ssel
  */
 void fpga_spi_test_common_no_ss(PinName mosi, PinName miso, PinName sclk);
 
+/** Test that the SPI-Master switches between prepared device configurations.
+ *
+ * Given board provides SPI-Master support.
+ * When configurations with different formats and frequencies are prepared and applied in turn.
+ * Then data is successfully transferred with each of them.
+ *
+ */
+void fpga_spi_test_config_switch(PinName mosi, PinName miso, PinName sclk);
+
+/** Test that the SPI-Master bus timing conforms to the requested frequency and chip select configuration.
+ *
+ * Given board provides SPI-Master support with hardware chip select.
+ * When block or asynchronous transfers are measured by the FPGA.
+ * Then the bus clock is within a divider step below the requested frequency, the gaps between symbols
+ * are bounded, and the chip select follows the mode and delays given to spi_cs_config.
+ *
+ */
+void fpga_spi_test_timing(PinName mosi, PinName miso, PinName sclk, PinName ssel);
+
 /**@}*/
 
 #ifdef __cplusplus
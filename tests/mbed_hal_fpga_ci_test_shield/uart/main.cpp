@@ -27,6 +27,7 @@
 #include "greentea-client/test_env.h"
 #include "platform/mbed_critical.h"
 #include <stdlib.h>
+#include <string.h>
 #include "hal/serial_api.h"
 #include "UARTTester.h"
 #include "pinmap.h"
@@ -345,6 +346,347 @@ void fpga_uart_test_common_no_fc(PinName tx, PinName rx)
     uart_test_common(BAUDRATE, DATA_BITS, PARITY, STOP_BITS, INIT_DIRECT, tx, rx);
 }
 
+#define TX_FIFO_REPS 48
+
+void fpga_uart_tx_fifo_test(PinName tx, PinName rx)
+{
+    const int baudrate = 115200;
+    // start_bit + data_bits + stop_bits
+    us_timestamp_t packet_tx_time = 1000000 * 10 / baudrate;
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+
+    tester.reset();
+    tester.pin_map_set(tx, MbedTester::LogicalPinUARTRx);
+    tester.pin_map_set(rx, MbedTester::LogicalPinUARTTx);
+
+    serial_t serial;
+    serial_init(&serial, tx, rx);
+    serial_baud(&serial, baudrate);
+    serial_format(&serial, 8, ParityNone, 1);
+
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralUART);
+    tester.set_baud((uint32_t)baudrate);
+    tester.set_bits(8);
+    tester.set_stops(1);
+    tester.set_parity(false, false);
+
+    static serial_tx_fifo_t fifo;
+    serial_tx_fifo_init(&fifo, &serial, NULL, 0);
+
+    uint8_t tx_buff[TX_FIFO_REPS];
+    uint32_t checksum = 0;
+    for (int i = 0; i < TX_FIFO_REPS; i++) {
+        tx_buff[i] = rand() % 256;
+        checksum += tx_buff[i];
+    }
+    size_t expected = TX_FIFO_REPS < MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE ? TX_FIFO_REPS : MBED_CONF_TARGET_SERIAL_TX_FIFO_SIZE;
+
+    tester.rx_start();
+    // The write returns before the data is sent.
+    TEST_ASSERT_EQUAL_UINT32(expected, serial_tx_fifo_write(&fifo, tx_buff, expected));
+    TEST_ASSERT_NOT_EQUAL(0, serial_tx_fifo_count(&fifo));
+    us_timestamp_t end_ts = ticker_read_us(us_ticker) + 2 * expected * packet_tx_time;
+    while (tester.rx_get_count() != expected && ticker_read_us(us_ticker) <= end_ts) {
+        // Wait for the TX IRQ to drain the FIFO and the FPGA to receive the data.
+    }
+    tester.rx_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(0, serial_tx_fifo_count(&fifo));
+    TEST_ASSERT_EQUAL_UINT32(expected, serial_tx_fifo_high_water(&fifo));
+    TEST_ASSERT_EQUAL_UINT32(expected, tester.rx_get_count());
+    TEST_ASSERT_EQUAL(0, tester.rx_get_framing_errors());
+    if (expected == TX_FIFO_REPS) {
+        TEST_ASSERT_EQUAL_UINT32(checksum, tester.rx_get_checksum());
+    }
+    TEST_ASSERT_EQUAL(tx_buff[expected - 1], tester.rx_get_data());
+
+    // Cleanup
+    serial_tx_fifo_free(&fifo);
+    serial_free(&serial);
+    tester.reset();
+}
+
+#define THRESHOLD_REPS 48
+
+typedef struct {
+    serial_t *ser;
+    uint8_t rx_buff[THRESHOLD_REPS];
+    uint32_t rx_cnt;
+    uint32_t irq_cnt;
+} threshold_test_data_t;
+
+static void test_threshold_irq_handler(uint32_t id, SerialIrq event)
+{
+    threshold_test_data_t *td = (threshold_test_data_t *)id;
+    if (event != RxIrq) {
+        return;
+    }
+    td->irq_cnt++;
+    while (serial_readable(td->ser)) {
+        uint8_t c = (uint8_t)serial_getc(td->ser);
+        if (td->rx_cnt < THRESHOLD_REPS) {
+            td->rx_buff[td->rx_cnt] = c;
+            td->rx_cnt++;
+        }
+    }
+}
+
+void fpga_uart_rx_threshold_test(PinName tx, PinName rx)
+{
+    const int baudrate = 115200;
+    // start_bit + data_bits + stop_bits
+    us_timestamp_t packet_tx_time = 1000000 * 10 / baudrate;
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+
+    tester.reset();
+    tester.pin_map_set(tx, MbedTester::LogicalPinUARTRx);
+    tester.pin_map_set(rx, MbedTester::LogicalPinUARTTx);
+
+    serial_t serial;
+    serial_init(&serial, tx, rx);
+    serial_baud(&serial, baudrate);
+    serial_format(&serial, 8, ParityNone, 1);
+
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralUART);
+    tester.set_baud((uint32_t)baudrate);
+    tester.set_bits(8);
+    tester.set_stops(1);
+    tester.set_parity(false, false);
+
+    serial_capabilities_t cap;
+    serial_get_capabilities(&serial, &cap);
+    TEST_ASSERT_NOT_EQUAL(0, cap.rx_fifo_size);
+    TEST_ASSERT_NOT_EQUAL(0, cap.tx_fifo_size);
+
+    // Without timeout, the bytes below the threshold are never reported
+    size_t level = 1;
+    if (cap.rx_timeout && serial_rx_timeout_set(&serial, cap.rx_timeout_max < 4 ? cap.rx_timeout_max : 4) == 0) {
+        level = serial_rx_threshold_set(&serial, cap.rx_fifo_size / 2);
+    }
+    TEST_ASSERT_TRUE(level >= 1 && level <= cap.rx_fifo_size);
+    size_t tx_level = serial_tx_threshold_set(&serial, cap.tx_fifo_size);
+    TEST_ASSERT_TRUE(tx_level >= 1 && tx_level <= cap.tx_fifo_size);
+
+    volatile threshold_test_data_t td = {};
+    td.ser = &serial;
+    serial_irq_handler(&serial, test_threshold_irq_handler, (uint32_t) &td);
+    serial_irq_set(&serial, RxIrq, 1);
+
+    uint8_t tester_buff = rand() % (256 - THRESHOLD_REPS);
+    tester.tx_set_next(tester_buff);
+    tester.tx_set_count(THRESHOLD_REPS);
+    tester.tx_set_delay(TX_START_DELAY_NS);
+    tester.tx_start(false);
+
+    us_timestamp_t end_ts = ticker_read_us(us_ticker) + TX_START_DELAY_NS / 1000 + 2 * THRESHOLD_REPS * packet_tx_time;
+    while (core_util_atomic_load_u32(&td.rx_cnt) != THRESHOLD_REPS && ticker_read_us(us_ticker) <= end_ts) {
+        // Wait until all the bytes are read by the IRQ handler.
+    }
+    serial_irq_set(&serial, RxIrq, 0);
+    tester.tx_stop();
+
+    // Every byte is received, in fewer interrupts than bytes with a threshold
+    TEST_ASSERT_EQUAL_UINT32(THRESHOLD_REPS, td.rx_cnt);
+    for (int i = 0; i < THRESHOLD_REPS; tester_buff++, i++) {
+        TEST_ASSERT_EQUAL(tester_buff, td.rx_buff[i]);
+    }
+    if (level > 1) {
+        TEST_ASSERT_TRUE(td.irq_cnt < THRESHOLD_REPS);
+    }
+
+    // Cleanup
+    serial_free(&serial);
+    tester.reset();
+}
+
+#define TIMING_REPS 64
+// The FPGA measures the pulses in 10 ns ticks
+#define FPGA_TICK_HZ 100000000
+// Largest baud rate error, above which the bits of a frame drift by half a bit
+#define TIMING_BAUD_TOLERANCE_PERCENT 2
+// Longest idle time allowed between two frames of a write, in bits
+#ifndef TIMING_MAX_GAP_BITS
+#define TIMING_MAX_GAP_BITS 2
+#endif
+
+/* Measure the TX line timing while sending 0x55 frames.
+ *
+ * In 8N1, a 0x55 frame is one bit pulses only, but for the stop bit which
+ * merges with the idle time up to the next start bit. The longest high
+ * pulse is then the stop bit plus the longest gap between frames.
+ */
+template<int BAUDRATE, bool USE_FIFO>
+void fpga_uart_timing_test(PinName tx, PinName rx)
+{
+    us_timestamp_t packet_tx_time = 1000000 * 10 / BAUDRATE;
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+
+    tester.reset();
+    tester.pin_map_set(tx, MbedTester::LogicalPinUARTRx);
+    tester.pin_map_set(rx, MbedTester::LogicalPinUARTTx);
+
+    serial_t serial;
+    serial_init(&serial, tx, rx);
+    serial_baud(&serial, BAUDRATE);
+    serial_format(&serial, 8, ParityNone, 1);
+
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralUART);
+    tester.set_baud((uint32_t)BAUDRATE);
+    tester.set_bits(8);
+    tester.set_stops(1);
+    tester.set_parity(false, false);
+
+    static serial_tx_fifo_t fifo;
+    if (USE_FIFO) {
+        serial_tx_fifo_init(&fifo, &serial, NULL, 0);
+    }
+
+    uint8_t tx_buff[TIMING_REPS];
+    memset(tx_buff, 0x55, sizeof(tx_buff));
+
+    tester.rx_start();
+    tester.io_metrics_start();
+    const us_timestamp_t start = ticker_read_us(us_ticker);
+    if (USE_FIFO) {
+        size_t sent = 0;
+        while (sent < TIMING_REPS) {
+            sent += serial_tx_fifo_write(&fifo, tx_buff + sent, TIMING_REPS - sent);
+        }
+    } else {
+        for (int i = 0; i < TIMING_REPS; i++) {
+            serial_putc(&serial, tx_buff[i]);
+        }
+    }
+    us_timestamp_t end_ts = ticker_read_us(us_ticker) + 2 * TIMING_REPS * packet_tx_time;
+    while (tester.rx_get_count() != TIMING_REPS && ticker_read_us(us_ticker) <= end_ts) {
+        // Wait for the FPGA to receive the last frame.
+    }
+    const us_timestamp_t elapsed_us = ticker_read_us(us_ticker) - start;
+    tester.io_metrics_stop();
+    tester.rx_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(TIMING_REPS, tester.rx_get_count());
+    TEST_ASSERT_EQUAL(0, tester.rx_get_framing_errors());
+    TEST_ASSERT_EQUAL(0x55, tester.rx_get_data());
+    // The start bit and four data bits of every frame
+    TEST_ASSERT_EQUAL_UINT32(5 * TIMING_REPS, tester.io_metrics_falling_edges(MbedTester::LogicalPinUARTRx));
+
+    const uint32_t bit_ticks = (tester.io_metrics_min_pulse_low(MbedTester::LogicalPinUARTRx) + tester.io_metrics_max_pulse_low(MbedTester::LogicalPinUARTRx)) / 2;
+    const uint32_t max_high_ticks = tester.io_metrics_max_pulse_high(MbedTester::LogicalPinUARTRx);
+    const uint32_t gap_ticks = max_high_ticks > bit_ticks ? max_high_ticks - bit_ticks : 0;
+    const uint32_t measured_baud = FPGA_TICK_HZ / bit_ticks;
+
+    TEST_ASSERT_UINT32_WITHIN(BAUDRATE * TIMING_BAUD_TOLERANCE_PERCENT / 100, BAUDRATE, measured_baud);
+    TEST_ASSERT_MESSAGE(gap_ticks <= TIMING_MAX_GAP_BITS * bit_ticks, "Gap between frames too long");
+
+    utest_printf("\nbaud %lu (requested %lu), frame gap %lu ns, %lu bytes/s (%lu%% of the line rate) ... ",
+                 (unsigned long)measured_baud, (unsigned long)BAUDRATE,
+                 (unsigned long)(gap_ticks * (1000000000 / FPGA_TICK_HZ)),
+                 (unsigned long)(TIMING_REPS * 1000000ULL / elapsed_us),
+                 (unsigned long)(TIMING_REPS * packet_tx_time * 100 / elapsed_us));
+
+    // Cleanup
+    if (USE_FIFO) {
+        serial_tx_fifo_free(&fifo);
+    }
+    serial_free(&serial);
+    tester.reset();
+}
+
+#if DEVICE_SERIAL_ASYNCH
+#define STREAM_RING_SIZE 32
+#define STREAM_REPS 48
+
+typedef struct {
+    uint8_t *ring;
+    size_t tail;
+    uint8_t rx_buff[STREAM_REPS];
+    uint32_t rx_cnt;
+    uint32_t idle_cnt;
+    uint32_t error_cnt;
+} stream_test_data_t;
+
+static void test_stream_handler(uint32_t id, size_t head, int event)
+{
+    stream_test_data_t *td = (stream_test_data_t *)id;
+    while (td->tail != head) {
+        if (td->rx_cnt < STREAM_REPS) {
+            td->rx_buff[td->rx_cnt] = td->ring[td->tail];
+            td->rx_cnt++;
+        }
+        td->tail = (td->tail + 1) % STREAM_RING_SIZE;
+    }
+    if (event & SERIAL_EVENT_RX_IDLE) {
+        td->idle_cnt++;
+    }
+    if (event & (SERIAL_EVENT_RX_OVERRUN_ERROR | SERIAL_EVENT_RX_FRAMING_ERROR | SERIAL_EVENT_RX_PARITY_ERROR)) {
+        td->error_cnt++;
+    }
+}
+
+void fpga_uart_rx_stream_test(PinName tx, PinName rx)
+{
+    const int baudrate = 115200;
+    // start_bit + data_bits + stop_bits
+    us_timestamp_t packet_tx_time = 1000000 * 10 / baudrate;
+    const ticker_data_t *const us_ticker = get_us_ticker_data();
+
+    tester.reset();
+    tester.pin_map_set(tx, MbedTester::LogicalPinUARTRx);
+    tester.pin_map_set(rx, MbedTester::LogicalPinUARTTx);
+
+    serial_t serial;
+    serial_init(&serial, tx, rx);
+    serial_baud(&serial, baudrate);
+    serial_format(&serial, 8, ParityNone, 1);
+
+    tester.peripherals_reset();
+    tester.select_peripheral(MbedTester::PeripheralUART);
+    tester.set_baud((uint32_t)baudrate);
+    tester.set_bits(8);
+    tester.set_stops(1);
+    tester.set_parity(false, false);
+
+    uint8_t ring[STREAM_RING_SIZE];
+    volatile stream_test_data_t td = {};
+    td.ring = ring;
+
+    // Send more bytes than the ring holds, so the stream has to wrap around.
+    uint8_t tester_buff = rand() % (256 - STREAM_REPS);
+    tester.tx_set_next(tester_buff);
+    tester.tx_set_count(STREAM_REPS);
+    tester.tx_set_delay(TX_START_DELAY_NS);
+    TEST_ASSERT_EQUAL_INT(0, serial_rx_stream_start(&serial, ring, sizeof(ring), test_stream_handler, (uint32_t) &td));
+    tester.tx_start(false);
+
+    us_timestamp_t end_ts = ticker_read_us(us_ticker) + TX_START_DELAY_NS / 1000 + 2 * STREAM_REPS * packet_tx_time;
+    while (core_util_atomic_load_u32(&td.rx_cnt) != STREAM_REPS && ticker_read_us(us_ticker) <= end_ts) {
+        // Wait until all the bytes are handed over by the stream handler.
+    }
+    end_ts = ticker_read_us(us_ticker) + 2 * packet_tx_time;
+    while (core_util_atomic_load_u32(&td.idle_cnt) == 0 && ticker_read_us(us_ticker) <= end_ts) {
+        // Wait (no longer than twice the time of one packet transfer) for the idle line event.
+    }
+    serial_rx_stream_stop(&serial);
+    tester.tx_stop();
+
+    TEST_ASSERT_EQUAL_UINT32(STREAM_REPS, td.rx_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, td.idle_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, td.error_cnt);
+    TEST_ASSERT_EQUAL_UINT32(STREAM_REPS % STREAM_RING_SIZE, serial_rx_stream_head(&serial));
+    for (int i = 0; i < STREAM_REPS; tester_buff++, i++) {
+        TEST_ASSERT_EQUAL(tester_buff, td.rx_buff[i]);
+    }
+
+    // Cleanup
+    serial_free(&serial);
+    tester.reset();
+}
+#endif
+
 Case cases[] = {
     // Every set of pins from every peripheral.
     Case("init/free, FC off", all_ports<UARTNoFCPort, DefaultFormFactor, fpga_uart_init_free_test_no_fc>),
@@ -366,6 +708,17 @@ Case cases[] = {
 #if !defined(UART_TWO_STOP_BITS_NOT_SUPPORTED)
     Case("9600, 8N2, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_test_common_no_fc<9600, 8, ParityNone, 2, false> >),
 #endif
+    // TX FIFO
+    Case("tx fifo, 115200, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_tx_fifo_test>),
+    Case("rx threshold, 115200, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_rx_threshold_test>),
+    // Line timing and throughput
+    Case("timing, 9600, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_timing_test<9600, false> >),
+    Case("timing, 115200, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_timing_test<115200, false> >),
+    Case("timing (tx fifo), 115200, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_timing_test<115200, true> >),
+#if DEVICE_SERIAL_ASYNCH
+    // RX stream
+    Case("rx stream, 115200, 8N1, FC off", one_peripheral<UARTNoFCPort, DefaultFormFactor, fpga_uart_rx_stream_test>),
+#endif
 
 #if DEVICE_SERIAL_FC
     // Every set of pins from every peripheral.
@@ -64,6 +64,42 @@ void fpga_uart_test_common(PinName tx, PinName rx, PinName cts = NC, PinName rts
  */
 void fpga_uart_test_common_no_fc(PinName tx, PinName rx);
 
+/** Test that the uart TX FIFO sends the queued data.
+ *
+ * Given board provides uart support.
+ * When data is queued with serial_tx_fifo_write.
+ * Then the write returns before the data is sent and the TX IRQ sends all of it to the FPGA.
+ *
+ */
+void fpga_uart_tx_fifo_test(PinName tx, PinName rx);
+
+/** Test that the uart RX hardware FIFO threshold and timeout lose no data.
+ *
+ * Given board provides uart support.
+ * When FPGA sends data with the RX threshold at half the hardware FIFO and the RX timeout enabled, when supported.
+ * Then all the data is received, in fewer RX IRQs than bytes when the threshold is above one byte.
+ *
+ */
+void fpga_uart_rx_threshold_test(PinName tx, PinName rx);
+
+/** Test that the uart TX line timing conforms to the requested baud rate.
+ *
+ * Given board provides uart support.
+ * When data is sent with serial_putc or the TX FIFO, measured by the FPGA.
+ * Then the baud rate is within 2% of the requested one and the gaps between frames are bounded.
+ *
+ */
+void fpga_uart_timing_test(PinName tx, PinName rx);
+
+/** Test that the uart can receive continuously into a ring buffer.
+ *
+ * Given board provides asynchronous uart support.
+ * When FPGA sends more data than the ring buffer holds to the stream started with serial_rx_stream_start.
+ * Then the stream wraps around, the data is received in order and the idle line event is reported.
+ *
+ */
+void fpga_uart_rx_stream_test(PinName tx, PinName rx);
+
 /* Common test function. */
 static void uart_test_common(int baudrate, int data_bits, SerialParity parity, int stop_bits, bool init_direct, PinName tx, PinName rx, PinName cts = NC, PinName rts = NC);
 
@@ -13,7 +13,10 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-set(MBED_CONFIG_PATH ${CMAKE_CURRENT_BINARY_DIR} CACHE INTERNAL "")
+# Tests added to the same build tree share the configuration of the first one
+if(NOT DEFINED MBED_CONFIG_PATH)
+    set(MBED_CONFIG_PATH ${CMAKE_CURRENT_BINARY_DIR} CACHE INTERNAL "")
+endif()
 
 include(${CMAKE_CURRENT_LIST_DIR}/app.cmake)
 
@@ -23,6 +26,13 @@ include(${CMAKE_CURRENT_LIST_DIR}/app.cmake)
 # TEST_INCLUDE_DIRS - Test suite include directories for the test
 # TEST_SOURCES - Test suite sources
 # TEST_REQUIRED_LIBS - Test suite required libraries
+# TEST_LABELS - CTest labels of the test, in addition to greentea and the target name
+# TEST_RESOURCE - CTest resource the test needs one slot of, boards by default
+# TEST_RESOURCE_LOCKS - CTest resource locks, for tests which must not run in
+#                       parallel with others holding the same lock
+# TEST_TIMEOUT - CTest timeout in seconds, 600 by default
+# BENCHMARK - The test suite is a benchmark, its results are checked against
+#             the target baselines by the benchmark_regression host test
 # 
 # calling the macro:
 # mbed_greentea_add_test(
@@ -30,15 +40,27 @@ include(${CMAKE_CURRENT_LIST_DIR}/app.cmake)
 #    TEST_INCLUDE_DIRS mbed_store
 #    TEST_SOURCES foo.cpp bar.cpp
 #    TEST_REQUIRED_LIBS mbed-kvstore mbed-xyz
+#    TEST_LABELS storage
 # )
+#
+# The HAL is added to the build tree by the first test, and linked by the tests
+# added after it, so a project adding several test directories builds it once.
+# It is built with the configuration of the first test: a later test with a
+# configuration of its own which differs from it is an error.
 
 macro(mbed_greentea_add_test)
-    set(options)
-    set(singleValueArgs TEST_NAME)
+    set(options BENCHMARK)
+    set(singleValueArgs
+        TEST_NAME
+        TEST_RESOURCE
+        TEST_TIMEOUT
+    )
     set(multipleValueArgs
         TEST_INCLUDE_DIRS
         TEST_SOURCES
         TEST_REQUIRED_LIBS
+        TEST_LABELS
+        TEST_RESOURCE_LOCKS
     )
     cmake_parse_arguments(MBED_GREENTEA
         "${options}"
@@ -49,7 +71,11 @@ macro(mbed_greentea_add_test)
 
     set(TEST_NAME ${MBED_GREENTEA_TEST_NAME})
 
-    add_subdirectory(${MBED_PATH} build)
+    if(NOT TARGET mbed-core)
+        add_subdirectory(${MBED_PATH} ${CMAKE_BINARY_DIR}/build)
+    else()
+        mbed_greentea_check_config()
+    endif()
 
     add_executable(${TEST_NAME})
 
@@ -88,11 +114,91 @@ macro(mbed_greentea_add_test)
             ${MBED_GREENTEA_TEST_REQUIRED_LIBS}
     )
 
+    if(MBED_GREENTEA_BENCHMARK)
+        target_compile_definitions(${TEST_NAME}
+            PRIVATE
+                MBED_GREENTEA_BENCHMARK=1
+        )
+    endif()
+
     mbed_set_post_build(${TEST_NAME})
 
+    mbed_greentea_add_ctest()
+
     option(VERBOSE_BUILD "Have a verbose build process")
     if(VERBOSE_BUILD)
         set(CMAKE_VERBOSE_MAKEFILE ON)
     endif()
 
 endmacro()
+
+# Fail if the test directory has a configuration which differs from the one the
+# shared HAL is built with, rather than silently building the test with the latter
+function(mbed_greentea_check_config)
+    if("${MBED_TOOLCHAIN}" STREQUAL "ARM")
+        set(config_file mbed_config_arm.cmake)
+    else()
+        set(config_file mbed_config_gcc.cmake)
+    endif()
+
+    set(test_config ${CMAKE_CURRENT_BINARY_DIR}/${config_file})
+    if(NOT EXISTS ${test_config} OR "${CMAKE_CURRENT_BINARY_DIR}" STREQUAL "${MBED_CONFIG_PATH}")
+        return()
+    endif()
+
+    file(SHA256 ${MBED_CONFIG_PATH}/${config_file} shared_config_hash)
+    file(SHA256 ${test_config} test_config_hash)
+    if(NOT test_config_hash STREQUAL shared_config_hash)
+        message(FATAL_ERROR
+            "${TEST_NAME} is configured by ${test_config}, which differs from the "
+            "configuration in ${MBED_CONFIG_PATH} the HAL of this build tree is built with. "
+            "Build tests with different configurations in separate build trees."
+        )
+    endif()
+endfunction()
+
+# Run the test with mbedhtrun on a board given by CTest. With a resource spec
+# file listing the boards, `ctest -j` runs the tests on several boards at once.
+macro(mbed_greentea_add_ctest)
+    enable_testing()
+
+    if(NOT MBED_GREENTEA_TEST_RESOURCE)
+        set(MBED_GREENTEA_TEST_RESOURCE boards)
+    endif()
+    if(NOT MBED_GREENTEA_TEST_TIMEOUT)
+        set(MBED_GREENTEA_TEST_TIMEOUT 600)
+    endif()
+
+    set(MBED_GREENTEA_RUN_ARGS
+        --binary ${CMAKE_CURRENT_BINARY_DIR}/${TEST_NAME}.bin
+        --platform ${MBED_TARGET}
+        --host-tests ${MBED_PATH}/tests/host_tests
+        --resource ${MBED_GREENTEA_TEST_RESOURCE}
+    )
+    if(GREENTEA_CUSTOM_IO_BAUD_RATE)
+        list(APPEND MBED_GREENTEA_RUN_ARGS --baud-rate ${GREENTEA_CUSTOM_IO_BAUD_RATE})
+    endif()
+
+    set(MBED_GREENTEA_LABELS greentea ${MBED_TARGET} ${MBED_GREENTEA_TEST_LABELS})
+
+    add_test(
+        NAME
+            ${TEST_NAME}
+        COMMAND
+            ${Python3_EXECUTABLE} ${MBED_PATH}/tools/greentea_run/greentea_run.py run ${MBED_GREENTEA_RUN_ARGS}
+    )
+
+    set_tests_properties(${TEST_NAME}
+        PROPERTIES
+            LABELS "${MBED_GREENTEA_LABELS}"
+            RESOURCE_GROUPS "${MBED_GREENTEA_TEST_RESOURCE}:1"
+            TIMEOUT ${MBED_GREENTEA_TEST_TIMEOUT}
+    )
+
+    if(MBED_GREENTEA_TEST_RESOURCE_LOCKS)
+        set_tests_properties(${TEST_NAME}
+            PROPERTIES
+                RESOURCE_LOCK "${MBED_GREENTEA_TEST_RESOURCE_LOCKS}"
+        )
+    endif()
+endmacro()
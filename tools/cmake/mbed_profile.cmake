@@ -20,14 +20,14 @@ if(NOT CMAKE_BUILD_TYPE)
    )
 endif()
 
-set(MBED_BUILD_TYPES Debug Release Develop)
+set(MBED_BUILD_TYPES Debug Release Develop LTO Performance PGO)
 
 # Force the build types to be case-insensitive for checking
 set(LOWERCASE_MBED_BUILD_TYPES ${MBED_BUILD_TYPES})
 list(TRANSFORM LOWERCASE_MBED_BUILD_TYPES TOLOWER)
 string(TOLOWER ${CMAKE_BUILD_TYPE} LOWERCASE_CMAKE_BUILD_TYPE)
 
-# Mapping CMAKE_BUILD_TYPE into MBED_BUILD_TYPES, as we understand only 3 profiles
+# Mapping CMAKE_BUILD_TYPE into MBED_BUILD_TYPES, as we understand only these profiles
 get_property(multi_config GLOBAL PROPERTY GENERATOR_IS_MULTI_CONFIG)
 if(multi_config)
     # Provide only a list as multi configuration generators do not support build type
@@ -42,3 +42,20 @@ else()
 endif()
 
 include(profiles/${LOWERCASE_CMAKE_BUILD_TYPE})
+
+# Builds the sources a profile lists in MBED_PROFILE_SIZE_SOURCES and
+# MBED_PROFILE_SPEED_SOURCES with MBED_PROFILE_SIZE_OPTIONS and
+# MBED_PROFILE_SPEED_OPTIONS, after the profile options. The HAL sources are
+# compiled by each target linking the HAL, so this is called for each of them.
+function(mbed_set_profile_source_options target)
+    foreach(level SIZE SPEED)
+        if(MBED_PROFILE_${level}_SOURCES)
+            set_source_files_properties(${MBED_PROFILE_${level}_SOURCES}
+                TARGET_DIRECTORY
+                    ${target}
+                PROPERTIES
+                    COMPILE_OPTIONS "${MBED_PROFILE_${level}_OPTIONS}"
+            )
+        endif()
+    endforeach()
+endfunction()
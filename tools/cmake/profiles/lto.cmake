@@ -0,0 +1,133 @@
+# Copyright (c) 2020-2021 Arm Limited
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# The release profile with link time optimization, so that small HAL functions
+# such as gpio_write() are inlined into the application.
+#
+# GCC_ARM: the main(), exit(), atexit() and printf wrappers of the bootstrap are
+# only referenced through the linker --wrap options, which the LTO plugin
+# handles from binutils 2.35. They are marked used so they are kept.
+#
+# ARM: armlink only patches main() with $Sub$$main if main() is in an ELF
+# object, so the file defining main() must be compiled with -fno-lto.
+if(NOT DEFINED MBED_TOOLCHAIN OR "${MBED_TOOLCHAIN}" STREQUAL "GCC_ARM")
+    # The archives of LTO objects need the symbol index built by the plugin
+    set(CMAKE_AR "arm-none-eabi-gcc-ar")
+    set(CMAKE_RANLIB "arm-none-eabi-gcc-ranlib")
+
+    execute_process(
+        COMMAND arm-none-eabi-ld --version
+        OUTPUT_VARIABLE ld_version_output
+        ERROR_QUIET
+    )
+    if(ld_version_output MATCHES "([0-9]+\\.[0-9]+)")
+        if(CMAKE_MATCH_1 VERSION_LESS 2.35)
+            message(WARNING "The LTO profile needs binutils 2.35 or later for the --wrap options, found ${CMAKE_MATCH_1}")
+        endif()
+    endif()
+endif()
+
+# Sets profile options
+function(mbed_set_profile_options target mbed_toolchain)
+    set(profile_link_options "")
+
+    if(${mbed_toolchain} STREQUAL "GCC_ARM")
+        list(APPEND profile_c_compile_options
+            "-c"
+            "-Os"
+            "-flto"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:C>:${profile_c_compile_options}>
+        )
+
+        list(APPEND profile_cxx_compile_options
+            "-c"
+            "-fno-rtti"
+            "-Wvla"
+            "-Os"
+            "-flto"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:CXX>:${profile_cxx_compile_options}>
+        )
+
+        list(APPEND profile_asm_compile_options
+            "-c"
+            "-x" "assembler-with-cpp"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:ASM>:${profile_asm_compile_options}>
+        )
+
+        # The code is generated at link time, with the link options
+        list(APPEND profile_link_options
+            "-Os"
+            "-flto"
+            "-Wl,--gc-sections"
+            "-Wl,--wrap,main"
+            "-Wl,--wrap,exit"
+            "-Wl,--wrap,atexit"
+            "-Wl,-n"
+        )
+    elseif(${mbed_toolchain} STREQUAL "ARM")
+        list(APPEND profile_c_compile_options
+            "-Oz"
+            "-flto"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:C>:${profile_c_compile_options}>
+        )
+
+        list(APPEND profile_cxx_compile_options
+            "-fno-rtti"
+            "-fno-c++-static-destructors"
+            "-Oz"
+            "-flto"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:CXX>:${profile_cxx_compile_options}>
+        )
+
+        list(APPEND profile_link_options
+            "--lto"
+            "--show_full_path"
+            "--legacyalign"
+            "--inline"
+            "--any_contingency"
+            "--keep=os_cb_sections"
+        )
+
+        target_compile_definitions(${target}
+            INTERFACE
+                __ASSERT_MSG
+        )
+    endif()
+
+    target_compile_definitions(${target}
+        INTERFACE
+            NDEBUG
+    )
+
+    target_link_options(${target}
+        INTERFACE
+            ${profile_link_options}
+    )
+endfunction()
@@ -0,0 +1,140 @@
+# Copyright (c) 2020-2021 Arm Limited
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# The release profile optimized for speed rather than size. The sources in
+# MBED_PERFORMANCE_SIZE_SOURCES are still built for size, as in the release
+# profile, and the ones in MBED_PERFORMANCE_SPEED_SOURCES are built at -O3.
+# Relative paths are relative to the MCU-Driver-HAL directory; target driver
+# sources can be added with their absolute path.
+set(MBED_PERFORMANCE_SIZE_SOURCES
+    bootstrap/mbed_assert.c
+    bootstrap/mbed_error.c
+    bootstrap/mbed_printf_armlink_overrides.c
+    bootstrap/mbed_printf_implementation.c
+    bootstrap/mbed_printf_wrapper.c
+    bootstrap/mbed_trace.c
+    CACHE STRING "Sources the performance profile builds for size"
+)
+
+set(MBED_PERFORMANCE_SPEED_SOURCES
+    bootstrap/mbed_critical.c
+    bootstrap/mbed_mktime.c
+    hal/source/mbed_critical_section_api.c
+    hal/source/mbed_ticker_api.c
+    hal/source/mbed_ticker_mux.c
+    hal/source/mbed_us_ticker_api.c
+    CACHE STRING "Sources the performance profile builds at -O3"
+)
+
+get_filename_component(mbed_hal_dir ${CMAKE_CURRENT_LIST_DIR}/../../.. ABSOLUTE)
+foreach(level SIZE SPEED)
+    set(MBED_PROFILE_${level}_SOURCES "")
+    foreach(source ${MBED_PERFORMANCE_${level}_SOURCES})
+        get_filename_component(source ${source} ABSOLUTE BASE_DIR ${mbed_hal_dir})
+        list(APPEND MBED_PROFILE_${level}_SOURCES ${source})
+    endforeach()
+endforeach()
+
+if(NOT DEFINED MBED_TOOLCHAIN OR "${MBED_TOOLCHAIN}" STREQUAL "GCC_ARM")
+    set(MBED_PROFILE_SIZE_OPTIONS "-Os")
+elseif("${MBED_TOOLCHAIN}" STREQUAL "ARM")
+    set(MBED_PROFILE_SIZE_OPTIONS "-Oz")
+endif()
+set(MBED_PROFILE_SPEED_OPTIONS "-O3")
+
+# Sets profile options
+function(mbed_set_profile_options target mbed_toolchain)
+    set(profile_link_options "")
+
+    if(${mbed_toolchain} STREQUAL "GCC_ARM")
+        list(APPEND profile_c_compile_options
+            "-c"
+            "-O2"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:C>:${profile_c_compile_options}>
+        )
+
+        list(APPEND profile_cxx_compile_options
+            "-c"
+            "-fno-rtti"
+            "-Wvla"
+            "-O2"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:CXX>:${profile_cxx_compile_options}>
+        )
+
+        list(APPEND profile_asm_compile_options
+            "-c"
+            "-x" "assembler-with-cpp"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:ASM>:${profile_asm_compile_options}>
+        )
+
+        list(APPEND profile_link_options
+            "-Wl,--gc-sections"
+            "-Wl,--wrap,main"
+            "-Wl,--wrap,exit"
+            "-Wl,--wrap,atexit"
+            "-Wl,-n"
+        )
+    elseif(${mbed_toolchain} STREQUAL "ARM")
+        list(APPEND profile_c_compile_options
+            "-O2"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:C>:${profile_c_compile_options}>
+        )
+
+        list(APPEND profile_cxx_compile_options
+            "-fno-rtti"
+            "-fno-c++-static-destructors"
+            "-O2"
+        )
+        target_compile_options(${target}
+            INTERFACE
+                $<$<COMPILE_LANGUAGE:CXX>:${profile_cxx_compile_options}>
+        )
+
+        list(APPEND profile_link_options
+            "--show_full_path"
+            "--legacyalign"
+            "--inline"
+            "--any_contingency"
+            "--keep=os_cb_sections"
+        )
+
+        target_compile_definitions(${target}
+            INTERFACE
+                __ASSERT_MSG
+        )
+    endif()
+
+    target_compile_definitions(${target}
+        INTERFACE
+            NDEBUG
+    )
+
+    target_link_options(${target}
+        INTERFACE
+            ${profile_link_options}
+    )
+endfunction()
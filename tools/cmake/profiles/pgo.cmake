@@ -0,0 +1,117 @@
+# Copyright (c) 2020-2021 Arm Limited
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# The release profile at -O2 with profile-guided optimization, in two stages
+# selected by MBED_PGO_STAGE:
+#
+# generate: the image is instrumented. mbed_pgo_dump() sends the counters on
+# the console, it is called on exit and can be called by the application at the
+# end of its workload. tools/pgo_collect/pgo_collect.py writes them in .gcda
+# files next to the objects.
+#
+# use: the same build directory is built again with the counters.
+#
+# The counters are dumped with __gcov_info_to_gcda() rather than the libgcov
+# file I/O, which needs GCC 12 or later.
+if(DEFINED MBED_TOOLCHAIN AND NOT "${MBED_TOOLCHAIN}" STREQUAL "GCC_ARM")
+    message(FATAL_ERROR "The PGO profile is only supported with the GCC_ARM toolchain")
+endif()
+
+set(MBED_PGO_STAGE "generate" CACHE STRING "Profile-guided optimization stage, generate or use")
+set_property(CACHE MBED_PGO_STAGE PROPERTY STRINGS generate use)
+
+# Sets profile options
+function(mbed_set_profile_options target mbed_toolchain)
+    set(profile_link_options "")
+
+    if(CMAKE_C_COMPILER_VERSION VERSION_LESS 12)
+        message(FATAL_ERROR "The PGO profile needs GCC 12 or later, found ${CMAKE_C_COMPILER_VERSION}")
+    endif()
+
+    if(MBED_PGO_STAGE STREQUAL "generate")
+        # The gcov_info pointers are collected in a section with a C identifier
+        # as name, the linker provides its __start_ and __stop_ symbols
+        set(profile_pgo_options
+            "-fprofile-generate"
+            "-fprofile-info-section=mbed_gcov_info"
+        )
+        list(APPEND profile_link_options
+            "-fprofile-generate"
+        )
+        target_compile_definitions(${target}
+            INTERFACE
+                MBED_PGO_GENERATE=1
+        )
+    elseif(MBED_PGO_STAGE STREQUAL "use")
+        # Code the workload did not run is optimized as without counters, not for size
+        set(profile_pgo_options
+            "-fprofile-use"
+            "-fprofile-correction"
+            "-fprofile-partial-training"
+            "-Wno-missing-profile"
+        )
+    else()
+        message(FATAL_ERROR "Invalid MBED_PGO_STAGE '${MBED_PGO_STAGE}'. Possible values:\n generate use")
+    endif()
+
+    list(APPEND profile_c_compile_options
+        "-c"
+        "-O2"
+        ${profile_pgo_options}
+    )
+    target_compile_options(${target}
+        INTERFACE
+            $<$<COMPILE_LANGUAGE:C>:${profile_c_compile_options}>
+    )
+
+    list(APPEND profile_cxx_compile_options
+        "-c"
+        "-fno-rtti"
+        "-Wvla"
+        "-O2"
+        ${profile_pgo_options}
+    )
+    target_compile_options(${target}
+        INTERFACE
+            $<$<COMPILE_LANGUAGE:CXX>:${profile_cxx_compile_options}>
+    )
+
+    list(APPEND profile_asm_compile_options
+        "-c"
+        "-x" "assembler-with-cpp"
+    )
+    target_compile_options(${target}
+        INTERFACE
+            $<$<COMPILE_LANGUAGE:ASM>:${profile_asm_compile_options}>
+    )
+
+    list(APPEND profile_link_options
+        "-Wl,--gc-sections"
+        "-Wl,--wrap,main"
+        "-Wl,--wrap,exit"
+        "-Wl,--wrap,atexit"
+        "-Wl,-n"
+    )
+
+    target_compile_definitions(${target}
+        INTERFACE
+            NDEBUG
+    )
+
+    target_link_options(${target}
+        INTERFACE
+            ${profile_link_options}
+    )
+endfunction()
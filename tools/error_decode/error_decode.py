@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Decode an error recorded with MBED_CONF_PLATFORM_ERROR_COMPACT.
+
+The image records the error status and the address of the caller only, for
+instance in the error_status and error_address fields of the crash record.
+This gives the name of the error, from bootstrap/mbed_error.h, and the
+function, file and line of the caller, from the ELF of the image with the
+addr2line tool of the toolchain.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from enum import Enum
+
+ERROR_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "bootstrap", "mbed_error.h")
+
+SYSTEM_ERROR_BASE = 256
+CUSTOM_ERROR_BASE = 4096
+ERROR_TYPES = ["system", "custom", "reserved", "posix"]
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def parse_error_header(text):
+    """Names of the error codes and of the modules defined in mbed_error.h."""
+    codes = {}
+    for match in re.finditer(r"MBED_DEFINE_(SYSTEM|CUSTOM)_ERROR\(\s*(\w+)\s*,\s*(\d+)\s*\)", text):
+        base = SYSTEM_ERROR_BASE if match.group(1) == "SYSTEM" else CUSTOM_ERROR_BASE
+        codes[base + int(match.group(3))] = match.group(2)
+
+    modules = {}
+    enum = re.search(r"typedef enum _mbed_module_type \{(.*?)\}", text, re.S)
+    if enum:
+        value = 0
+        for match in re.finditer(r"^\s*(MBED_MODULE_\w+)\s*(?:=\s*(\d+))?\s*,", enum.group(1), re.M):
+            if match.group(2) is not None:
+                value = int(match.group(2))
+            modules.setdefault(value, match.group(1)[len("MBED_MODULE_"):])
+            value += 1
+    return codes, modules
+
+
+def decode_status(status, codes, modules):
+    """Description of an error status."""
+    status &= 0xFFFFFFFF
+    error_type = (status >> 29) & 0x3
+    if error_type == 3:
+        # POSIX errors are the negated errno
+        return "POSIX error {}".format(0x100000000 - status)
+    code = status & 0xFFFF
+    module = (status >> 16) & 0xFF
+    return "{} error {} ({}), module {} ({})".format(
+        ERROR_TYPES[error_type], codes.get(code, "unknown"), code, modules.get(module, "unknown"), module
+    )
+
+
+def call_address(address):
+    """Address of the call instruction, from the return address recorded."""
+    # The Thumb bit is cleared, and the address moved into the call
+    return (address & ~1) - 2
+
+
+def locate(addr2line, elf, address):
+    """Function, file and line of an address of the image."""
+    output = subprocess.run(
+        [addr2line, "-f", "-C", "-e", elf, "0x{:x}".format(address)],
+        check=True,
+        stdout=subprocess.PIPE,
+        universal_newlines=True,
+    ).stdout.splitlines()
+    return "{} at {}".format(output[0], output[1]) if len(output) >= 2 else "unknown"
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="Compact error decoder",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("elf", help="ELF of the image.")
+    parser.add_argument("status", type=lambda value: int(value, 0), help="Error status recorded.")
+    parser.add_argument("address", type=lambda value: int(value, 0), help="Error address recorded.")
+    parser.add_argument("-a", "--addr2line", default="arm-none-eabi-addr2line", help="addr2line tool.")
+    parser.add_argument("--header", default=ERROR_HEADER, help="mbed_error.h of the image.")
+
+    return parser.parse_args()
+
+
+def run_error_decode():
+    """Application main algorithm."""
+    args = parse_args()
+
+    with open(args.header) as header:
+        codes, modules = parse_error_header(header.read())
+    print(decode_status(args.status, codes, modules))
+    print("called from {}".format(locate(args.addr2line, args.elf, call_address(args.address))))
+    return ReturnCode.SUCCESS.value
+
+
+def _main():
+    """Run error_decode."""
+    try:
+        return run_error_decode()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
@@ -0,0 +1,41 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+from error_decode import *
+
+
+def test_parse_error_header():
+    with open(ERROR_HEADER) as header:
+        codes, modules = parse_error_header(header.read())
+
+    assert codes[324] == "ASSERTION_FAILED"
+    assert modules[0] == "APPLICATION"
+    assert modules[4] == "HAL"
+    assert modules[255] == "UNKNOWN"
+
+
+def test_decode_status():
+    codes = {324: "ASSERTION_FAILED"}
+    modules = {4: "HAL", 255: "UNKNOWN"}
+
+    assert decode_status(0x80FF0144, codes, modules) == "system error ASSERTION_FAILED (324), module UNKNOWN (255)"
+    assert decode_status(-0x7FFB0001 & 0xFFFFFFFF, codes, modules).endswith("module HAL (4)")
+    assert decode_status(-5, codes, modules) == "POSIX error 5"
+
+
+def test_call_address():
+    assert call_address(0x08000125) == 0x08000122
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef GREENTEA_BASE64_H_
+#define GREENTEA_BASE64_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    GREENTEA_BASE64_SUCCESS = 0,
+    GREENTEA_BASE64_INVALID_PARAMETER = 1,
+    GREENTEA_BASE64_BUFFER_TOO_SMALL = 2,
+    GREENTEA_BASE64_ERROR = 3,
+} greentea_base64_result_t;
+
+/* Size of the string encoding size bytes, including the terminating null
+ * character. */
+#define GREENTEA_BASE64_ENCODED_SIZE(size) ((((size) + 2) / 3) * 4 + 1)
+
+/* Encode binary data, padded with '=', to send it to the host in a
+ * key-value message. The string is null terminated. Nothing is encoded if the
+ * string is shorter than GREENTEA_BASE64_ENCODED_SIZE(size). */
+greentea_base64_result_t greentea_base64_encode(const void *buffer, size_t size, char *string, size_t string_size);
+
+/* Decode a string received from the host, up to its null character or
+ * string_max_size characters. The last block may be unpadded.
+ * length_written and chars_processed, which may be NULL, are set to the
+ * number of bytes decoded and characters consumed, also on errors.
+ * GREENTEA_BASE64_BUFFER_TOO_SMALL is returned if characters are left to
+ * decode when the buffer is full. */
+greentea_base64_result_t greentea_base64_decode(const char *string, size_t string_max_size, void *buffer, size_t buffer_size,
+                                                size_t *length_written, size_t *chars_processed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GREENTEA_BASE64_H_
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "greentea-base64/base64.h"
+
+#include <stdint.h>
+
+static const char encode_table[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+/* Sextet of each ASCII character; the two upper bits flag the padding and
+ * invalid characters, so one test on four sextets or'ed together finds them.
+ */
+#define XX 0xC0
+#define PD 0x40
+
+static const uint8_t decode_table[128] = {
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, 62, XX, XX, XX, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, XX, XX, XX, PD, XX, XX,
+    XX,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, XX, XX, XX, XX, XX,
+    XX, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, XX, XX, XX, XX, XX,
+};
+
+static uint8_t decode_char(char c)
+{
+    return ((uint8_t)c < sizeof(decode_table)) ? decode_table[(uint8_t)c] : XX;
+}
+
+greentea_base64_result_t greentea_base64_encode(const void *buffer, size_t size, char *string, size_t string_size)
+{
+    const uint8_t *in = (const uint8_t *)buffer;
+    size_t pos = 0;
+
+    if ((string == NULL) || (string_size == 0) || ((buffer == NULL) && (size > 0))) {
+        return GREENTEA_BASE64_INVALID_PARAMETER;
+    }
+    if (string_size < GREENTEA_BASE64_ENCODED_SIZE(size)) {
+        string[0] = 0;
+        return GREENTEA_BASE64_BUFFER_TOO_SMALL;
+    }
+
+    for (; size >= 3; size -= 3, in += 3) {
+        const uint32_t word = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+        string[pos++] = encode_table[word >> 18];
+        string[pos++] = encode_table[(word >> 12) & 0x3F];
+        string[pos++] = encode_table[(word >> 6) & 0x3F];
+        string[pos++] = encode_table[word & 0x3F];
+    }
+
+    if (size > 0) {
+        const uint32_t word = ((uint32_t)in[0] << 16) | ((size > 1) ? ((uint32_t)in[1] << 8) : 0);
+        string[pos++] = encode_table[word >> 18];
+        string[pos++] = encode_table[(word >> 12) & 0x3F];
+        string[pos++] = (size > 1) ? encode_table[(word >> 6) & 0x3F] : '=';
+        string[pos++] = '=';
+    }
+    string[pos] = 0;
+
+    return GREENTEA_BASE64_SUCCESS;
+}
+
+greentea_base64_result_t greentea_base64_decode(const char *string, size_t string_max_size, void *buffer, size_t buffer_size,
+                                                size_t *length_written, size_t *chars_processed)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    greentea_base64_result_t result = GREENTEA_BASE64_SUCCESS;
+    size_t length = 0;
+    size_t pos = 0;
+    size_t written = 0;
+
+    if ((string == NULL) || (buffer == NULL)) {
+        return GREENTEA_BASE64_INVALID_PARAMETER;
+    }
+
+    while ((length < string_max_size) && (string[length] != 0)) {
+        length++;
+    }
+
+    // Whole blocks of four characters without padding
+    while (length - pos >= 4) {
+        const uint8_t a = decode_char(string[pos]);
+        const uint8_t b = decode_char(string[pos + 1]);
+        const uint8_t c = decode_char(string[pos + 2]);
+        const uint8_t d = decode_char(string[pos + 3]);
+        if ((a | b | c | d) & XX) {
+            break;
+        }
+        if (buffer_size - written < 3) {
+            result = GREENTEA_BASE64_BUFFER_TOO_SMALL;
+            break;
+        }
+        const uint32_t word = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | d;
+        out[written++] = (uint8_t)(word >> 16);
+        out[written++] = (uint8_t)(word >> 8);
+        out[written++] = (uint8_t)word;
+        pos += 4;
+    }
+
+    // Last block, padded or not
+    if ((result == GREENTEA_BASE64_SUCCESS) && (pos < length)) {
+        uint32_t word = 0;
+        size_t count = 0;
+        while ((count < 3) && (pos + count < length)) {
+            const uint8_t sextet = decode_char(string[pos + count]);
+            if (sextet & XX) {
+                break;
+            }
+            word = (word << 6) | sextet;
+            count++;
+        }
+
+        if (count < 2) {
+            result = GREENTEA_BASE64_ERROR;
+        } else if (buffer_size - written < count - 1) {
+            result = GREENTEA_BASE64_BUFFER_TOO_SMALL;
+        } else {
+            word <<= 6 * (4 - count);
+            out[written++] = (uint8_t)(word >> 16);
+            if (count == 3) {
+                out[written++] = (uint8_t)(word >> 8);
+            }
+            pos += count;
+            for (size_t pad = count; (pad < 4) && (pos < length) && (string[pos] == '='); pad++) {
+                pos++;
+            }
+            if (pos < length) {
+                result = GREENTEA_BASE64_ERROR;
+            }
+        }
+    }
+
+    if (length_written != NULL) {
+        *length_written = written;
+    }
+    if (chars_processed != NULL) {
+        *chars_processed = pos;
+    }
+    return result;
+}
@@ -6,12 +6,27 @@
 #ifndef GREENTEA_CUSTOM_IO_H_
 #define GREENTEA_CUSTOM_IO_H_
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void greentea_init_custom_io(void);
 
+/* Wait for the output to the host to be sent, when it is buffered with
+ * GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE. Call it before writing to the console
+ * directly, as printf() does. The buffered output must not be written from
+ * interrupt handlers. */
+void greentea_custom_io_flush(void);
+
+/* Send binary data to the host in a frame, for bulk data, instead of encoding
+ * it in key-value messages. The data and its CRC-32, little endian, are COBS
+ * encoded and delimited by null bytes, so the host skips the frame when it
+ * looks for key-value messages, and finds it in a log of the serial port with
+ * the decoder of tests/host_tests/binary_frames.py. */
+void greentea_send_frame(const void *data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,29 +5,187 @@
 
 #include "greentea-client/test_io.h"
 #include "greentea-custom_io/custom_io.h"
+#include "hal/crc_api.h"
+#include "hal/crc_sw_api.h"
 #include "hal/serial_api.h"
+#include "hal/sleep_api.h"
+#include "hal/utils/critical_section_api.h"
+#include "mbed_critical.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef GREENTEA_CUSTOM_IO_BAUD_RATE
+#define GREENTEA_CUSTOM_IO_BAUD_RATE MBED_CONF_PLATFORM_STDIO_BAUD_RATE
+#endif
+
+#ifndef GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE
+#define GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE 0
+#endif
+
+#define GREENTEA_CUSTOM_IO_BUFFERED (GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE > 0 && DEVICE_SERIAL_ASYNCH)
 
 extern serial_t stdio_uart;
 
+#if GREENTEA_CUSTOM_IO_BUFFERED
+/* One buffer is filled while the other is sent. A buffer is sent when it is
+ * full, at the end of each line, and before reading from the host, so that
+ * the key-value messages reach the host without waiting for the next ones.
+ */
+static uint8_t tx_buffers[2][GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE];
+static size_t tx_length;
+static uint8_t tx_fill;
+static volatile bool tx_busy;
+
+static void tx_irq_handler(void)
+{
+    if (serial_irq_handler_asynch(&stdio_uart) & SERIAL_EVENT_TX_COMPLETE) {
+        tx_busy = false;
+    }
+}
+
+static void wait_for_tx(void)
+{
+#if DEVICE_SLEEP
+    core_util_critical_section_enter();
+    while (tx_busy) {
+        hal_critical_section_sleep(hal_sleep);
+    }
+    core_util_critical_section_exit();
+#else
+    while (tx_busy);
+#endif
+}
+
+static void tx_flush(void)
+{
+    if (tx_length == 0) {
+        return;
+    }
+
+    wait_for_tx();
+    tx_busy = true;
+    serial_tx_asynch(&stdio_uart, tx_buffers[tx_fill], tx_length, 8,
+                     (uint32_t)tx_irq_handler, SERIAL_EVENT_TX_COMPLETE);
+    tx_fill ^= 1;
+    tx_length = 0;
+}
+
+static void tx_put(int c)
+{
+    tx_buffers[tx_fill][tx_length++] = (uint8_t)c;
+    if (c == '\n' || tx_length == GREENTEA_CUSTOM_IO_TX_BUFFER_SIZE) {
+        tx_flush();
+    }
+}
+#endif // GREENTEA_CUSTOM_IO_BUFFERED
+
 void greentea_init_custom_io(void)
 {
     serial_init(&stdio_uart, CONSOLE_TX, CONSOLE_RX);
-    serial_baud(&stdio_uart, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
+    serial_baud(&stdio_uart, GREENTEA_CUSTOM_IO_BAUD_RATE);
 }
 
 int greentea_getc(void)
 {
+#if GREENTEA_CUSTOM_IO_BUFFERED
+    // The host answers messages it has received
+    tx_flush();
+#endif
     return serial_getc(&stdio_uart);
 }
 
 void greentea_putc(int c)
 {
+#if GREENTEA_CUSTOM_IO_BUFFERED
+    tx_put(c);
+#else
     serial_putc(&stdio_uart, c);
+#endif
 }
 
 void greentea_write_string(const char *str)
 {
     while (*str != '\0') {
+#if GREENTEA_CUSTOM_IO_BUFFERED
+        tx_put(*str++);
+#else
         serial_putc(&stdio_uart, *str++);
+#endif
+    }
+}
+
+void greentea_custom_io_flush(void)
+{
+#if GREENTEA_CUSTOM_IO_BUFFERED
+    tx_flush();
+    wait_for_tx();
+#endif
+}
+
+/* COBS block being encoded, its code byte first */
+static uint8_t frame_block[255];
+static size_t frame_fill;
+
+static void frame_put(uint8_t byte)
+{
+    if (byte != 0) {
+        frame_block[frame_fill++] = byte;
+    }
+    // The code of a full block has no implicit null byte after it
+    if (byte == 0 || frame_fill == sizeof(frame_block)) {
+        frame_block[0] = (uint8_t)frame_fill;
+        for (size_t i = 0; i < frame_fill; i++) {
+            greentea_putc(frame_block[i]);
+        }
+        frame_fill = 1;
+    }
+}
+
+static const crc_mbed_config_t frame_crc_config = {
+    POLY_32BIT_ANSI, 32, 0xFFFFFFFF, 0xFFFFFFFF, true, true
+};
+
+static uint32_t frame_crc(const void *data, size_t size)
+{
+#if DEVICE_CRC
+    if (HAL_CRC_IS_SUPPORTED(POLY_32BIT_ANSI, 32)) {
+        hal_crc_ctx_t ctx;
+        hal_crc_ctx_start(&ctx, &frame_crc_config);
+        hal_crc_ctx_update(&ctx, (const uint8_t *)data, size);
+        return hal_crc_ctx_get_result(&ctx);
+    }
+#endif
+    static uint32_t table[CRC_SW_TABLE_ENTRIES(1)];
+    static bool table_ready;
+    crc_sw_ctx_t ctx;
+
+    if (!table_ready) {
+        crc_sw_table_init(table, 1, &frame_crc_config);
+        table_ready = true;
+    }
+    crc_sw_ctx_start(&ctx, &frame_crc_config, table, 1);
+    crc_sw_ctx_update(&ctx, (const uint8_t *)data, size);
+    return crc_sw_ctx_get_result(&ctx);
+}
+
+void greentea_send_frame(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    const uint32_t crc = frame_crc(data, size);
+
+    // Ends the text before the frame for the host
+    greentea_putc(0);
+    frame_fill = 1;
+    for (size_t i = 0; i < size; i++) {
+        frame_put(bytes[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        frame_put((uint8_t)(crc >> (8 * i)));
     }
+    // Last block, its implicit null byte is not part of the frame
+    frame_put(0);
+    greentea_putc(0);
+    greentea_custom_io_flush();
 }
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Run greentea tests from CTest on the boards attached to the host.
+
+The resources command prints a CTest resource spec file listing the attached
+boards of a platform, by target id. The run command flashes and runs a test
+binary with mbedhtrun, on the board CTest allocated to the test, so that
+`ctest --resource-spec-file <file> -j <boards>` runs a test per board at once.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+from enum import Enum
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def list_boards():
+    """List the attached boards with mbedls."""
+    try:
+        from mbed_os_tools.detect import create
+    except ImportError:
+        from mbed_lstools import create
+    return create().list_mbeds()
+
+
+def platform_boards(boards, platform):
+    """Boards of a platform, mounted and with a serial port."""
+    return [
+        board
+        for board in boards
+        if board.get("platform_name") == platform
+        and board.get("mount_point")
+        and board.get("serial_port")
+    ]
+
+
+def resource_spec(boards, platform, resource):
+    """CTest resource spec with a slot for each board of a platform."""
+    return {
+        "version": {"major": 1, "minor": 0},
+        "local": [
+            {
+                resource: [
+                    {"id": board["target_id"], "slots": 1}
+                    for board in platform_boards(boards, platform)
+                ]
+            }
+        ],
+    }
+
+
+def allocated_board_id(environ, resource):
+    """Target id of the board CTest allocated to the test, None if CTest did not allocate one."""
+    if int(environ.get("CTEST_RESOURCE_GROUP_COUNT", "0")) == 0:
+        return None
+
+    allocation = environ.get("CTEST_RESOURCE_GROUP_0_{}".format(resource.upper()), "")
+    # The allocation is a list of id:<id>,slots:<slots> separated by semicolons
+    for field in allocation.split(";")[0].split(","):
+        key, _, value = field.partition(":")
+        if key == "id":
+            return value
+    raise ValueError("no {} allocated to the test by CTest".format(resource))
+
+
+def find_board(boards, platform, target_id):
+    """Board to run the test on, the first of the platform without an id."""
+    candidates = platform_boards(boards, platform)
+    if target_id is not None:
+        candidates = [board for board in candidates if board["target_id"] == target_id]
+    if not candidates:
+        raise ValueError(
+            "no {} board attached{}".format(
+                platform, " with target id " + target_id if target_id else ""
+            )
+        )
+    return candidates[0]
+
+
+def htrun_command(args, board):
+    """Command running the test on a board."""
+    return [
+        "mbedhtrun",
+        "--image-path",
+        args.binary,
+        "--disk",
+        board["mount_point"],
+        "--port",
+        "{}:{}".format(board["serial_port"], args.baud_rate),
+        "--micro",
+        args.platform,
+        "--target-id",
+        board["target_id"],
+        "--enum-host-tests",
+        args.host_tests,
+        "--copy",
+        "shell",
+        "--sync",
+        "5",
+    ]
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="Greentea test runner for CTest",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    resources = subparsers.add_parser(
+        "resources", help="Print the CTest resource spec file of the attached boards"
+    )
+    resources.add_argument("-m", "--platform", required=True, help="Platform name of the boards.")
+    resources.add_argument("-r", "--resource", default="boards", help="CTest resource type of the boards.")
+
+    run = subparsers.add_parser("run", help="Run a test on the board allocated by CTest")
+    run.add_argument("-f", "--binary", required=True, help="Path to the test binary.")
+    run.add_argument("-m", "--platform", required=True, help="Platform name of the board.")
+    run.add_argument("-e", "--host-tests", required=True, help="Directory of the host tests.")
+    run.add_argument("-r", "--resource", default="boards", help="CTest resource type of the boards.")
+    run.add_argument("-b", "--baud-rate", default=9600, type=int, help="Baud rate of the board serial port.")
+
+    return parser.parse_args()
+
+
+def run_greentea_run():
+    """Application main algorithm."""
+    args = parse_args()
+    boards = list_boards()
+
+    if args.command == "resources":
+        print(json.dumps(resource_spec(boards, args.platform, args.resource), indent=4))
+        return ReturnCode.SUCCESS.value
+
+    board = find_board(boards, args.platform, allocated_board_id(os.environ, args.resource))
+    return subprocess.call(htrun_command(args, board))
+
+
+def _main():
+    """Run greentea_run."""
+    try:
+        return run_greentea_run()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
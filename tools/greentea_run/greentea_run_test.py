@@ -0,0 +1,53 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+from greentea_run import *
+
+@pytest.fixture
+def boards():
+    return [
+        {"platform_name": "K64F", "target_id": "0240A", "mount_point": "/media/a", "serial_port": "/dev/ttyACM0"},
+        {"platform_name": "NUCLEO_F429ZI", "target_id": "0796B", "mount_point": "/media/b", "serial_port": "/dev/ttyACM1"},
+        {"platform_name": "K64F", "target_id": "0240C", "mount_point": "/media/c", "serial_port": "/dev/ttyACM2"},
+        {"platform_name": "K64F", "target_id": "0240D", "mount_point": None, "serial_port": "/dev/ttyACM3"},
+    ]
+
+def test_resource_spec(boards):
+    spec = resource_spec(boards, "K64F", "boards")
+
+    assert spec["version"] == {"major": 1, "minor": 0}
+    assert spec["local"] == [{"boards": [{"id": "0240A", "slots": 1}, {"id": "0240C", "slots": 1}]}]
+
+def test_allocated_board_id():
+    environ = {
+        "CTEST_RESOURCE_GROUP_COUNT": "1",
+        "CTEST_RESOURCE_GROUP_0": "fpga_shield_boards",
+        "CTEST_RESOURCE_GROUP_0_FPGA_SHIELD_BOARDS": "id:0240C,slots:1",
+    }
+
+    assert allocated_board_id(environ, "fpga_shield_boards") == "0240C"
+    assert allocated_board_id({}, "boards") is None
+    with pytest.raises(ValueError):
+        allocated_board_id(environ, "boards")
+
+def test_find_board(boards):
+    assert find_board(boards, "K64F", None)["target_id"] == "0240A"
+    assert find_board(boards, "K64F", "0240C")["mount_point"] == "/media/c"
+    with pytest.raises(ValueError):
+        find_board(boards, "K64F", "0240D")
+    with pytest.raises(ValueError):
+        find_board(boards, "NRF52840_DK", None)
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Report the flash and RAM used by each HAL module of an image.
+
+This reads the map file written by the GNU Arm Embedded linker or by armlink,
+sums the sizes of the input sections of each object, and groups the objects
+into modules from their file names. A budget, in JSON, gives the largest
+flash and RAM sizes of modules:
+
+    {"ticker": {"flash": 4096, "ram": 256}, "printf": {"flash": 2048}}
+
+The report fails if a module of the budget exceeds it.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from enum import Enum
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+# Modules of the objects, tried in order on the object file names
+MODULES = [
+    ("toolchain", re.compile(r"^lib(c|g|gcc|m|nosys|stdc\+\+|supc\+\+)(_nano)?\.a\(|^(c_|fz_|h_|m_)\w+\.l\(")),
+    ("ticker", re.compile(r"ticker")),
+    ("trace", re.compile(r"trace|itm|swo")),
+    ("printf", re.compile(r"printf")),
+    ("error", re.compile(r"mbed_error|mbed_assert|fault")),
+    ("pinmap", re.compile(r"pinmap|PeripheralPins")),
+]
+
+# Prefix and suffix stripped from the names of the other HAL objects
+HAL_OBJECT = re.compile(r"^mbed_(\w+?)(_api)?\.(c|cpp|S)(\.obj|\.o)?$")
+
+GNU_SECTION = re.compile(r"^ (\.\S+|COMMON)(\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(.+))?$")
+GNU_CONTINUATION = re.compile(r"^\s+0x[0-9a-fA-F]+\s+0x([0-9a-fA-F]+)\s+(.+)$")
+ARM_COMPONENT = re.compile(r"^\s*(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\S+)\s*$")
+
+
+def object_module(name):
+    """Module of an object, from its path in a map file."""
+    name = os.path.basename(name.strip())
+    # Archive members are given as path/libname.a(member)
+    member = re.search(r"\(([^()]+)\)$", name)
+    for module, pattern in MODULES:
+        if pattern.search(name):
+            return module
+    match = HAL_OBJECT.match(member.group(1) if member else name)
+    if match:
+        return match.group(1)
+    return "other"
+
+
+def add_size(modules, name, flash, ram):
+    """Add the sizes of an object to its module."""
+    sizes = modules.setdefault(object_module(name), {"flash": 0, "ram": 0})
+    sizes["flash"] += flash
+    sizes["ram"] += ram
+
+
+def section_sizes(section, size):
+    """Flash and RAM used by an input section of the GNU linker."""
+    if section.startswith((".data", ".ramfunc")):
+        return size, size
+    if section.startswith((".bss", ".noinit", ".heap", ".stack")) or section == "COMMON":
+        return 0, size
+    if section.startswith((".text", ".rodata", ".ARM.exidx", ".ARM.extab", ".isr_vector", ".init_array", ".fini_array")):
+        return size, 0
+    return 0, 0
+
+
+def parse_gnu_map(lines):
+    """Sizes of each module in a map file of the GNU linker."""
+    modules = {}
+    in_map = False
+    pending = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("Linker script and memory map"):
+            in_map = True
+            continue
+        if not in_map:
+            # Discarded input sections come first
+            continue
+        if pending is not None:
+            match = GNU_CONTINUATION.match(line)
+            if match:
+                flash, ram = section_sizes(pending, int(match.group(1), 16))
+                add_size(modules, match.group(2), flash, ram)
+            pending = None
+            continue
+        match = GNU_SECTION.match(line)
+        if not match:
+            continue
+        if match.group(2) is None:
+            # Long section names are followed by their address on the next line
+            pending = match.group(1)
+            continue
+        flash, ram = section_sizes(match.group(1), int(match.group(3), 16))
+        add_size(modules, match.group(4), flash, ram)
+    return modules
+
+
+def parse_arm_map(lines):
+    """Sizes of each module in a map file of armlink."""
+    modules = {}
+    in_sizes = False
+    for line in lines:
+        if "Image component sizes" in line:
+            in_sizes = True
+            continue
+        if not in_sizes:
+            continue
+        match = ARM_COMPONENT.match(line)
+        if match:
+            code, _, ro_data, rw_data, zi_data, _, name = match.groups()
+            add_size(modules, name, int(code) + int(ro_data) + int(rw_data), int(rw_data) + int(zi_data))
+    return modules
+
+
+def parse_map(lines):
+    """Sizes of each module in a map file of either linker."""
+    lines = list(lines)
+    if any("Image component sizes" in line for line in lines):
+        return parse_arm_map(lines)
+    return parse_gnu_map(lines)
+
+
+def check_budget(modules, budget):
+    """Messages for the modules exceeding their budget."""
+    overruns = []
+    for module, limits in sorted(budget.items()):
+        sizes = modules.get(module, {"flash": 0, "ram": 0})
+        for memory in ("flash", "ram"):
+            if memory in limits and sizes[memory] > limits[memory]:
+                overruns.append(
+                    "{} {}: {} bytes, budget {} bytes".format(module, memory, sizes[memory], limits[memory])
+                )
+    return overruns
+
+
+def print_report(modules):
+    """Print the sizes of the modules, largest flash first."""
+    print("{:<24} {:>10} {:>10}".format("Module", "Flash", "RAM"))
+    for module, sizes in sorted(modules.items(), key=lambda item: (-item[1]["flash"], item[0])):
+        print("{:<24} {:>10} {:>10}".format(module, sizes["flash"], sizes["ram"]))
+    print(
+        "{:<24} {:>10} {:>10}".format(
+            "Total", sum(sizes["flash"] for sizes in modules.values()), sum(sizes["ram"] for sizes in modules.values())
+        )
+    )
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="HAL module footprint report",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("map", type=argparse.FileType("r"), help="Map file of the image.")
+    parser.add_argument("-b", "--budget", type=argparse.FileType("r"), help="JSON budget of the modules.")
+
+    return parser.parse_args()
+
+
+def run_hal_footprint():
+    """Application main algorithm."""
+    args = parse_args()
+
+    modules = parse_map(args.map)
+    print_report(modules)
+    if args.budget:
+        overruns = check_budget(modules, json.load(args.budget))
+        for overrun in overruns:
+            print("over budget: {}".format(overrun))
+        if overruns:
+            return ReturnCode.ERROR.value
+    return ReturnCode.SUCCESS.value
+
+
+def _main():
+    """Run hal_footprint."""
+    try:
+        return run_hal_footprint()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
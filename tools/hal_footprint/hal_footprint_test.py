@@ -0,0 +1,83 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+from hal_footprint import *
+
+GNU_MAP = """Discarded input sections
+
+ .text          0x00000000       0x40 hal/libmbed-hal.a(mbed_ticker_api.c.obj)
+
+Linker script and memory map
+
+ .text          0x08000400       0x5c hal/libmbed-hal.a(mbed_ticker_api.c.obj)
+ .text.ticker_irq_handler
+                0x0800045c      0x100 hal/libmbed-hal.a(mbed_ticker_api.c.obj)
+ *fill*         0x0800055c        0x4 
+ .rodata.str1.4
+                0x08000560       0x20 hal/libmbed-hal.a(mbed_printf_implementation.c.obj)
+ .text.hal_crc_compute
+                0x08000580       0x30 hal/libmbed-hal.a(mbed_crc_api.c.obj)
+ .text.memcpy   0x080005b0       0x10 /gcc/lib/thumb/libc_nano.a(lib_a-memcpy.o)
+ .data.err      0x20000000        0x8 bootstrap/libmbed-bootstrap.a(mbed_error.c.obj)
+ .bss.queue     0x20000008       0x40 CMakeFiles/app.dir/main.cpp.obj
+ COMMON         0x20000048       0x10 targets/PeripheralPins.c.obj
+"""
+
+ARM_MAP = """    Image component sizes
+
+
+      Code (inc. data)   RO Data    RW Data    ZI Data      Debug   Object Name
+
+       356         12          0          0         40       1532   mbed_ticker_api.o
+        48          0         16          8          0        312   mbed_error.o
+
+    ----------------------------------------------------------------------
+       404         12         16          8         40       1844   Object Totals
+"""
+
+
+def test_object_module():
+    assert object_module("hal/libmbed-hal.a(mbed_us_ticker_api.c.obj)") == "ticker"
+    assert object_module("hal/libmbed-hal.a(mbed_tracepoint.c.obj)") == "trace"
+    assert object_module("hal/libmbed-hal.a(mbed_crc_api.c.obj)") == "crc"
+    assert object_module("/gcc/lib/libc_nano.a(lib_a-memcpy.o)") == "toolchain"
+    assert object_module("CMakeFiles/app.dir/main.cpp.obj") == "other"
+
+
+def test_parse_gnu_map():
+    modules = parse_map(GNU_MAP.splitlines(True))
+
+    assert modules["ticker"] == {"flash": 0x15C, "ram": 0}
+    assert modules["printf"] == {"flash": 0x20, "ram": 0}
+    assert modules["crc"] == {"flash": 0x30, "ram": 0}
+    assert modules["toolchain"] == {"flash": 0x10, "ram": 0}
+    assert modules["error"] == {"flash": 0x8, "ram": 0x8}
+    assert modules["other"] == {"flash": 0, "ram": 0x40}
+    assert modules["pinmap"] == {"flash": 0, "ram": 0x10}
+
+
+def test_parse_arm_map():
+    modules = parse_map(ARM_MAP.splitlines(True))
+
+    assert modules == {"ticker": {"flash": 356, "ram": 40}, "error": {"flash": 72, "ram": 8}}
+
+
+def test_check_budget():
+    modules = {"ticker": {"flash": 356, "ram": 40}}
+
+    assert check_budget(modules, {"ticker": {"flash": 400, "ram": 40}, "printf": {"flash": 100}}) == []
+    assert check_budget(modules, {"ticker": {"flash": 300}}) == ["ticker flash: 356 bytes, budget 300 bytes"]
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Collect the profile-guided optimization counters of an instrumented image.
+
+The image built with the PGO profile in its generate stage sends its counters
+on the console with mbed_pgo_dump(). This reads them from a serial port, or
+from a log of the console, and writes the .gcda files next to the objects of
+the build directory, replacing the ones of a previous run.
+"""
+
+import argparse
+import sys
+from enum import Enum
+
+PGO_PREFIX = "#pgo "
+PGO_BEGIN = "#pgo begin"
+PGO_END = "#pgo end"
+PGO_FILE = "#pgo file "
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def parse_dump(lines):
+    """Content of each .gcda file of the first complete dump in console lines."""
+    files = None
+    content = None
+    for line in lines:
+        line = line.strip()
+        if line == PGO_BEGIN:
+            files = {}
+            content = None
+        elif files is None:
+            continue
+        elif line == PGO_END:
+            return {name: bytes(data) for name, data in files.items()}
+        elif line.startswith(PGO_FILE) or line == PGO_FILE.strip():
+            name = line[len(PGO_FILE):]
+            # Data without a file name is not written
+            content = files.setdefault(name, bytearray()) if name else bytearray()
+        elif line.startswith(PGO_PREFIX) and content is not None:
+            content += bytes.fromhex(line[len(PGO_PREFIX):])
+    raise ValueError("no complete counters dump found")
+
+
+def serial_lines(port, baud_rate, timeout):
+    """Lines received on a serial port, until the timeout expires without data."""
+    import serial
+
+    with serial.Serial(port, baud_rate, timeout=timeout) as connection:
+        while True:
+            line = connection.readline()
+            if not line:
+                return
+            yield line.decode("ascii", errors="replace")
+
+
+def write_files(files, prefix_map):
+    """Write the .gcda files, with the paths mapped as given by --prefix-map."""
+    for name, data in files.items():
+        for old, new in prefix_map:
+            if name.startswith(old):
+                name = new + name[len(old):]
+                break
+        with open(name, "wb") as gcda:
+            gcda.write(data)
+        print("written: {}".format(name))
+
+
+def prefix_mapping(value):
+    """Argument type of --prefix-map, old=new."""
+    old, separator, new = value.partition("=")
+    if not separator:
+        raise argparse.ArgumentTypeError("expected old=new, got '{}'".format(value))
+    return (old, new)
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="PGO counters collector",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("-p", "--port", help="Serial port of the board console.")
+    source.add_argument("-l", "--log", type=argparse.FileType("r"), help="Log of the board console.")
+    parser.add_argument("-b", "--baud-rate", default=9600, type=int, help="Baud rate of the board console.")
+    parser.add_argument("-t", "--timeout", default=60, type=float, help="Seconds to wait for the console data.")
+    parser.add_argument(
+        "-m",
+        "--prefix-map",
+        action="append",
+        default=[],
+        type=prefix_mapping,
+        help="Write the files whose path starts with old under new, if the image was built on another host.",
+        metavar="OLD=NEW",
+    )
+
+    return parser.parse_args()
+
+
+def run_pgo_collect():
+    """Application main algorithm."""
+    args = parse_args()
+
+    lines = args.log if args.log else serial_lines(args.port, args.baud_rate, args.timeout)
+    write_files(parse_dump(lines), args.prefix_map)
+    return ReturnCode.SUCCESS.value
+
+
+def _main():
+    """Run pgo_collect."""
+    try:
+        return run_pgo_collect()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
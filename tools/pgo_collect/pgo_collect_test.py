@@ -0,0 +1,55 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+from pgo_collect import *
+
+def test_parse_dump():
+    lines = [
+        "{{__sync;0}}\n",
+        "#pgo begin\n",
+        "#pgo file /build/a.c.gcda\n",
+        "#pgo 67636461\n",
+        "some trace\n",
+        "#pgo 00ff\n",
+        "#pgo file /build/b.c.gcda\n",
+        "#pgo 01\n",
+        "#pgo file \n",
+        "#pgo 02\n",
+        "#pgo end\n",
+        "#pgo begin\n",
+        "#pgo file /build/a.c.gcda\n",
+        "#pgo 03\n",
+        "#pgo end\n",
+    ]
+
+    assert parse_dump(lines) == {"/build/a.c.gcda": b"\x67\x63\x64\x61\x00\xff", "/build/b.c.gcda": b"\x01"}
+
+def test_parse_dump_incomplete():
+    with pytest.raises(ValueError):
+        parse_dump(["#pgo begin\n", "#pgo file /build/a.c.gcda\n", "#pgo 67636461\n"])
+    with pytest.raises(ValueError):
+        parse_dump(["#pgo file /build/a.c.gcda\n", "#pgo 67636461\n", "#pgo end\n"])
+
+def test_write_files(tmp_path):
+    write_files({"/build/a.c.gcda": b"\x01\x02"}, [("/build", str(tmp_path))])
+
+    assert (tmp_path / "a.c.gcda").read_bytes() == b"\x01\x02"
+
+def test_prefix_mapping():
+    assert prefix_mapping("/old=/new") == ("/old", "/new")
+    with pytest.raises(argparse.ArgumentTypeError):
+        prefix_mapping("/old")
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Generate sorted PinMap indexes for a target.
+
+The generated C file defines pinmap_index() so that pinmap_pinout(),
+pinmap_find_peripheral() and pinmap_find_function() binary search the pin
+maps instead of scanning them. The sort order comes from the pin values in
+PinNames.h and is checked by the compiler with static assertions.
+"""
+
+import argparse
+import pathlib
+import re
+import sys
+from enum import Enum
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def strip_comments(content):
+    """Remove C and C++ comments."""
+    content = re.sub(r"/\*.*?\*/", " ", content, flags=re.DOTALL)
+    return re.sub(r"//[^\n]*", "", content)
+
+
+def evaluate(expression, values):
+    """Evaluate a C integer constant expression, None if it can't be."""
+    expression = re.sub(r"\(\s*(?:int|uint32_t|PinName)\s*\)", "", expression)
+    expression = re.sub(r"\b(0[xX][0-9a-fA-F]+|[0-9]+)[uUlL]+\b", r"\1", expression)
+
+    def replace(match):
+        name = match.group(0)
+        if re.match(r"0[xX]|[0-9]", name):
+            return name
+        if name not in values:
+            raise KeyError(name)
+        return "({})".format(values[name])
+
+    try:
+        expression = re.sub(r"\b[A-Za-z_0-9]+\b", replace, expression)
+    except KeyError:
+        return None
+    if not re.match(r"^[0-9a-fA-Fx\s+\-*/%()|&<>~^]+$", expression):
+        return None
+    try:
+        value = int(eval(expression.replace("/", "//"), {"__builtins__": {}}))
+    except (SyntaxError, TypeError, ValueError, ZeroDivisionError):
+        return None
+    # PinName values are ints
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def pin_values(pin_names_content):
+    """Map each name of the PinName enum, and pin aliases, to its value."""
+    content = strip_comments(pin_names_content)
+    values = dict()
+
+    for name, value in re.findall(
+        r"^[ \t]*#define[ \t]+([A-Za-z0-9_]+)[ \t]+(\S.*)$", content, re.MULTILINE
+    ):
+        value = evaluate(value, values)
+        if value is not None:
+            values[name] = value
+
+    enum_match = re.search(r"typedef\s+enum\s*\{([^}]*)\}\s*PinName\s*;", content)
+    if not enum_match:
+        return values
+
+    body = "\n".join(
+        line for line in enum_match.group(1).splitlines()
+        if not line.strip().startswith("#")
+    )
+    next_value = 0
+    for entry in body.split(","):
+        entry = entry.strip()
+        if not entry:
+            continue
+        name, _, expression = entry.partition("=")
+        name = name.strip()
+        value = evaluate(expression, values) if expression else next_value
+        if value is None:
+            next_value = None
+            continue
+        values[name] = value
+        next_value = value + 1
+
+    # aliases defined before their target pin
+    for name, value in re.findall(
+        r"^[ \t]*#define[ \t]+([A-Za-z0-9_]+)[ \t]+(\S.*)$", content, re.MULTILINE
+    ):
+        if name not in values:
+            value = evaluate(value, values)
+            if value is not None:
+                values[name] = value
+
+    return values
+
+
+def split_entries(body):
+    """Split the body of a PinMap initializer into its brace-enclosed entries."""
+    entries = []
+    depth = 0
+    start = None
+    for index, char in enumerate(body):
+        if char == "{":
+            if depth == 0:
+                start = index
+            depth += 1
+        elif char == "}":
+            depth -= 1
+            if depth == 0:
+                entries.append(body[start:index + 1])
+    return entries
+
+
+def entry_pin(entry):
+    """Get the pin of a PinMap entry."""
+    return re.match(r"\{\s*([^,]+?)\s*,", entry).group(1)
+
+
+def find_pinmaps(source_content):
+    """Find the PinMap tables of a source file.
+
+    Returns a list of (name, entries) and a list of (name, reason) for the
+    tables that can't be indexed.
+    """
+    content = strip_comments(source_content)
+    pinmaps = []
+    skipped = []
+
+    for match in re.finditer(
+        r"^([ \t]*(?:static\s+)?(?:[A-Z_0-9]+\s+)?const\s+PinMap\s+([A-Za-z0-9_]+)\s*\[\s*\]\s*=\s*)\{",
+        content,
+        re.MULTILINE,
+    ):
+        name = match.group(2)
+        depth = 0
+        for end in range(match.end() - 1, len(content)):
+            if content[end] == "{":
+                depth += 1
+            elif content[end] == "}":
+                depth -= 1
+                if depth == 0:
+                    break
+        body = content[match.end():end]
+
+        if re.search(r"\bstatic\b", match.group(1)):
+            skipped.append((name, "static tables have an address per translation unit"))
+            continue
+        if re.search(r"^\s*#", body, re.MULTILINE):
+            skipped.append((name, "preprocessor conditionals in the table"))
+            continue
+
+        entries = []
+        for entry in split_entries(body):
+            if entry_pin(entry) == "NC":
+                break
+            entries.append(entry)
+        pinmaps.append((name, entries))
+
+    return pinmaps, skipped
+
+
+def sort_pinmap(entries, values):
+    """Sort entries by pin value, keeping equal pins in order. None if a pin has no known value."""
+    try:
+        return sorted(entries, key=lambda entry: values[entry_pin(entry)])
+    except KeyError:
+        return None
+
+
+def include_lines(source_content):
+    """Get the #include and #define lines of a source file, needed by its PinMap entries."""
+    return re.findall(
+        r"^[ \t]*#(?:include[ \t]+[\"<][^\">]+[\">]|define[ \t].*)$",
+        strip_comments(source_content),
+        re.MULTILINE,
+    )
+
+
+def generate(pin_names_content, sources, source_names=()):
+    """Generate the C file defining pinmap_index() for the given sources.
+
+    Returns the file content and a list of warnings.
+    """
+    values = pin_values(pin_names_content)
+    warnings = []
+    includes = []
+    indexes = []
+
+    for source in sources:
+        for line in include_lines(source):
+            line = line.strip()
+            if line not in includes:
+                includes.append(line)
+        pinmaps, skipped = find_pinmaps(source)
+        for name, reason in skipped:
+            warnings.append("{}: skipped, {}".format(name, reason))
+        for name, entries in pinmaps:
+            sorted_entries = sort_pinmap(entries, values)
+            if sorted_entries is None:
+                warnings.append("{}: skipped, pin values not found in PinNames.h".format(name))
+                continue
+            indexes.append((name, sorted_entries))
+
+    lines = [
+        "/* Generated by tools/pinmap_index/pinmap_index.py{}, do not edit */".format(
+            " from " + ", ".join(source_names) if source_names else ""
+        ),
+        "",
+        '#include "hal/pinmap.h"',
+        "#include <assert.h>",
+        "#include <stddef.h>",
+    ]
+    lines += [line for line in includes if line not in ('#include "hal/pinmap.h"', '#include "pinmap.h"')]
+    lines.append("")
+
+    for name, entries in indexes:
+        lines.append("extern const PinMap {}[];".format(name))
+        lines.append("")
+        lines.append("static const PinMap {}_sorted[] = {{".format(name))
+        lines += ["    {},".format(" ".join(entry.split())) for entry in entries]
+        lines.append("    {NC, 0, 0}")
+        lines.append("};")
+        previous = None
+        for entry in entries:
+            pin = entry_pin(entry)
+            if previous is not None and pin != previous:
+                lines.append(
+                    'static_assert((int){} <= (int){}, "{}_sorted is not sorted");'.format(previous, pin, name)
+                )
+            previous = pin
+        lines.append("")
+
+    lines.append("static const PinMapIndex pinmap_indexes[] = {")
+    lines += [
+        "    {{{0}, {0}_sorted, {1}}},".format(name, len(entries))
+        for name, entries in indexes
+    ]
+    if not indexes:
+        lines.append("    {NULL, NULL, 0}")
+    lines += [
+        "};",
+        "",
+        "const PinMapIndex *pinmap_index(const PinMap *map)",
+        "{",
+        "    for (size_t i = 0; i < sizeof(pinmap_indexes) / sizeof(pinmap_indexes[0]); i++) {",
+        "        if (pinmap_indexes[i].map == map) {",
+        "            return &pinmap_indexes[i];",
+        "        }",
+        "    }",
+        "    return NULL;",
+        "}",
+        "",
+    ]
+    return "\n".join(lines), warnings
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="Sorted pin map index generation",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+
+    parser.add_argument(
+        "-p",
+        "--pin_names",
+        required=True,
+        help="Path to the target PinNames.h file.",
+    )
+
+    parser.add_argument(
+        "-s",
+        "--sources",
+        required=True,
+        help="Path to the files defining the PinMap tables, such as PeripheralPins.c. Use comma to seperate multiple paths.",
+    )
+
+    parser.add_argument(
+        "-w",
+        "--output_file",
+        help="File to write the generated C file to, instead of printing to stdout",
+    )
+
+    return parser.parse_args()
+
+
+def run_pinmap_index():
+    """Application main algorithm."""
+    args = parse_args()
+
+    pin_names_content = pathlib.Path(args.pin_names).read_text()
+    source_paths = [pathlib.Path(path.strip()) for path in args.sources.split(",")]
+    sources = [path.read_text() for path in source_paths]
+
+    content, warnings = generate(
+        pin_names_content, sources, [path.name for path in source_paths]
+    )
+    for warning in warnings:
+        print("WARNING: " + warning, file=sys.stderr)
+
+    if args.output_file:
+        pathlib.Path(args.output_file).write_text(content)
+    else:
+        print(content)
+
+
+def _main():
+    """Run pinmap_index."""
+    try:
+        run_pinmap_index()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+    else:
+        return ReturnCode.SUCCESS.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
@@ -0,0 +1,81 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+from pinmap_index import *
+
+@pytest.fixture
+def pin_names_content():
+    pin_names_file = open("./test_files/PinNames.h")
+    return pin_names_file.read()
+
+@pytest.fixture
+def peripheral_pins_content():
+    peripheral_pins_file = open("./test_files/PeripheralPins.c")
+    return peripheral_pins_file.read()
+
+def test_pin_values(pin_names_content):
+    expect = {
+        "PORT_SHIFT": 4,
+        "P0_0": 0,
+        "P0_1": 1,
+        "P0_2": 2,
+        "P0_3": 3,
+        "P1_0": 16,
+        "P1_1": 17,
+        "P1_2": 18,
+        "LED1": 17,
+        "NC": -1,
+        "BUTTON1": 3,
+    }
+
+    assert pin_values(pin_names_content) == expect
+
+def test_find_pinmaps(peripheral_pins_content):
+    pinmaps, skipped = find_pinmaps(peripheral_pins_content)
+
+    assert [(name, [entry_pin(entry) for entry in entries]) for name, entries in pinmaps] == [
+        ("PinMap_PWM", ["P1_2", "P0_1", "BUTTON1", "P0_1", "LED1"]),
+    ]
+    assert [name for name, reason in skipped] == ["PinMap_UART_TX", "PinMap_UART_RX"]
+
+def test_sort_pinmap(pin_names_content, peripheral_pins_content):
+    pinmaps, skipped = find_pinmaps(peripheral_pins_content)
+    sorted_entries = sort_pinmap(pinmaps[0][1], pin_values(pin_names_content))
+
+    # equal pins keep their order so lookups find the same entry as a linear scan
+    assert [" ".join(entry.split()) for entry in sorted_entries] == [
+        "{P0_1, PWM_1, PIN_DATA(1, 0)}",
+        "{P0_1, PWM_2, PIN_DATA(4, 0)}",
+        "{BUTTON1, PWM_1, PIN_DATA(2, 0)}",
+        "{LED1, PWM_2, PIN_DATA(5, 0)}",
+        "{P1_2, PWM_2, PIN_DATA(3, 0)}",
+    ]
+    assert sort_pinmap(["{P9_9, PWM_1, 0}"], pin_values(pin_names_content)) is None
+
+def test_generate(pin_names_content, peripheral_pins_content):
+    content, warnings = generate(pin_names_content, [peripheral_pins_content])
+
+    assert '#include "PeripheralPins.h"' in content
+    assert "#define PIN_DATA(function, mode) (((mode) << 8) | (function))" in content
+    assert "static const PinMap PinMap_PWM_sorted[] = {" in content
+    assert 'static_assert((int)P0_1 <= (int)BUTTON1, "PinMap_PWM_sorted is not sorted");' in content
+    assert "    {PinMap_PWM, PinMap_PWM_sorted, 5}," in content
+    assert "PinMap_UART_TX_sorted" not in content
+    assert warnings == [
+        "PinMap_UART_TX: skipped, preprocessor conditionals in the table",
+        "PinMap_UART_RX: skipped, static tables have an address per translation unit",
+    ]
@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PeripheralPins.h"
+
+#define PIN_DATA(function, mode) (((mode) << 8) | (function))
+
+//*** PWM ***
+const PinMap PinMap_PWM[] = {
+    {P1_2,    PWM_2, PIN_DATA(3, 0)},
+    {P0_1,    PWM_1, PIN_DATA(1, 0)},  // {P0_1, PWM_1, 1}
+    {BUTTON1, PWM_1, PIN_DATA(2, 0)},
+    {P0_1,    PWM_2, PIN_DATA(4, 0)},
+    {LED1,    PWM_2, PIN_DATA(5, 0)},
+    {NC,      0,     0}
+};
+
+//*** UART ***
+const PinMap PinMap_UART_TX[] = {
+#if TARGET_FEATURE
+    {P0_2,    UART_1, 1},
+#endif
+    {NC,      0,      0}
+};
+
+static const PinMap PinMap_UART_RX[] = {
+    {P0_3,    UART_1, 1},
+    {NC,      0,      0}
+};
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021 Arm Limited
+/* Copyright (c) 2021 ARM Limited
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -14,19 +14,22 @@
  * limitations under the License.
  */
 
-#include <stdint.h>
-#include <stdlib.h>
-#include <string>
+#ifndef MBED_PERIPHERALPINS_H
+#define MBED_PERIPHERALPINS_H
+
+#include "pinmap.h"
+
+typedef enum {
+    PWM_1 = 1,
+    PWM_2,
+} PWMName;
 
 typedef enum {
-    BASE64_SUCCESS = 0,
-    BASE64_INVALID_PARAMETER = 1,
-    BASE64_BUFFER_TOO_SMALL = 2,
-    BASE64_ERROR = 3,
-} base64_result_e;
+    UART_1 = 1,
+} UARTName;
 
-base64_result_e trng_EncodeBase64(const void *buffer, uint32_t bufferSize, char *string, uint32_t stringSize);
-base64_result_e trng_DecodeNBase64(const char *string, uint32_t stringMaxSize, void *buffer, uint32_t bufferSize,
-                                   uint32_t *lengthWritten, uint32_t *charsProcessed);
 
+extern const PinMap PinMap_PWM[];
+extern const PinMap PinMap_UART_TX[];
 
+#endif
@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_PINNAMES_H
+#define MBED_PINNAMES_H
+
+#define PORT_SHIFT 4
+
+typedef enum {
+    P0_0 = (0 << PORT_SHIFT),
+    P0_1,
+    P0_2,
+    P0_3,
+    P1_0 = (1 << PORT_SHIFT) | 0,
+    P1_1,
+    P1_2 = 0x12,
+
+    LED1 = P1_1, // aliases keep the pin value
+
+    NC = (int)0xFFFFFFFF
+} PinName;
+
+#define BUTTON1 P0_3
+
+typedef enum {
+    PullNone = 0,
+} PinMode;
+
+#endif
@@ -15,7 +15,10 @@ limitations under the License.
 """
 
 import argparse
+import concurrent.futures
+import functools
 import json
+import os
 import pathlib
 import hashlib
 import re
@@ -258,14 +261,20 @@ def check_duplicate_markers(test_mode=False):
     return errors
 
 
-def target_has_arduino_form_factor(target_name):
-    """Check if the target has the Arduino form factor."""
+@functools.lru_cache(maxsize=None)
+def load_targets_json():
+    """Load targets.json once per process."""
     mbed_os_root = pathlib.Path(__file__).absolute().parents[3]
 
     with (
         mbed_os_root.joinpath("targets", "targets.json")
     ).open() as targets_json_file:
-        target_data = json.load(targets_json_file)
+        return json.load(targets_json_file)
+
+
+def target_has_arduino_form_factor(target_name):
+    """Check if the target has the Arduino form factor."""
+    target_data = load_targets_json()
 
     if target_name in target_data:
         if "supported_form_factors" in target_data[target_name]:
@@ -687,6 +696,101 @@ test_cases = [
 ]
 
 
+def run_test_cases(pin_name_content, suites, arduino_support):
+    """Run the test cases on the content of a PinNames.h file."""
+    pin_name_dict = pin_name_to_dict(pin_name_content)
+
+    results = []
+    for case in test_cases:
+        if suites:
+            if case["suite_name"] not in suites:
+                continue
+        else:
+            if not arduino_support and case["suite_name"] == "arduino_uno":
+                continue
+
+        if case["case_input"] == "dict":
+            case_input = pin_name_dict
+        elif case["case_input"] == "content":
+            case_input = pin_name_content
+
+        case_output = case["case_function"](case_input)
+
+        results.append(
+            {
+                "suite_name": case["suite_name"],
+                "case_name": case["case_name"],
+                "result": "FAILED" if case_output else "PASSED",
+                "errors": case_output,
+            }
+        )
+
+    return results
+
+
+def content_hash(*contents):
+    """Hash file contents and options into a cache key."""
+    digest = hashlib.sha256()
+    for content in contents:
+        digest.update(content.encode("utf-8"))
+        digest.update(b"\0")
+    return digest.hexdigest()
+
+
+def tool_hash():
+    """Hash of this script, a change of the checks invalidates the cache."""
+    return content_hash(pathlib.Path(__file__).read_text())
+
+
+def load_cache(cache_file):
+    """Load the results cached per target, empty if the cache is missing or stale."""
+    try:
+        with open(cache_file) as cache:
+            data = json.load(cache)
+    except (OSError, ValueError):
+        return dict()
+
+    if not isinstance(data, dict) or data.get("tool") != tool_hash():
+        return dict()
+
+    return data.get("targets", dict())
+
+
+def save_cache(cache_file, entries):
+    """Save the results of every target."""
+    with open(cache_file, "w") as cache:
+        json.dump({"tool": tool_hash(), "targets": entries}, cache)
+
+
+def pinmap_index_sources(pin_names_path):
+    """Find the files defining the PinMap tables of a target, next to its PinNames.h."""
+    return sorted(pathlib.Path(pin_names_path).parent.glob("PeripheralPins*.c"))
+
+
+def validate_target(pin_name_content, suites, arduino_support, index_sources=(), index_file=None):
+    """Validate a target, and generate its pinmap index from the same content if index_file is set.
+
+    Runs in a worker process when validating in parallel.
+    """
+    results = run_test_cases(pin_name_content, suites, arduino_support)
+
+    warnings = []
+    if index_file:
+        tools_dir = pathlib.Path(__file__).absolute().parents[1]
+        if str(tools_dir / "pinmap_index") not in sys.path:
+            sys.path.append(str(tools_dir / "pinmap_index"))
+        import pinmap_index
+
+        content, warnings = pinmap_index.generate(
+            pin_name_content,
+            [path.read_text() for path in index_sources],
+            [path.name for path in index_sources],
+        )
+        pathlib.Path(index_file).write_text(content)
+
+    return results, warnings
+
+
 def validate_pin_names(args):
     """Entry point for validating the Pin names."""
     suites = []
@@ -710,45 +814,68 @@ def validate_pin_names(args):
         check_duplicate_markers()
         return
 
-    report = []
+    cache = load_cache(args.cache) if args.cache else dict()
+    entries = dict()
+    jobs = []
+
+    # Only the targets whose files changed since the cached run are validated
     for target, path in targets.items():
         pin_name_content = open(path).read()
+        arduino_support = target_has_arduino_form_factor(target)
+        entry = {
+            "hash": content_hash(pin_name_content, ",".join(suites), str(arduino_support)),
+        }
+
+        index_sources = ()
+        index_file = None
+        if args.pinmap_index_dir:
+            index_sources = pinmap_index_sources(path)
+            index_file = str(pathlib.Path(args.pinmap_index_dir, target + "_pinmap_index.c"))
+            entry["index_hash"] = content_hash(
+                pin_name_content, *[source.read_text() for source in index_sources]
+            )
 
-        pin_name_dict = pin_name_to_dict(pin_name_content)
+        cached = cache.get(target)
+        if (
+            cached
+            and cached.get("hash") == entry["hash"]
+            and (
+                not index_file
+                or (cached.get("index_hash") == entry["index_hash"] and os.path.exists(index_file))
+            )
+        ):
+            entries[target] = cached
+            continue
 
-        arduino_support = target_has_arduino_form_factor(target)
+        entries[target] = entry
+        jobs.append((target, (pin_name_content, suites, arduino_support, index_sources, index_file)))
 
-        for case in test_cases:
-            if suites:
-                if case["suite_name"] not in suites:
-                    continue
-            else:
-                if not arduino_support and case["suite_name"] == "arduino_uno":
-                    continue
+    if args.pinmap_index_dir:
+        pathlib.Path(args.pinmap_index_dir).mkdir(parents=True, exist_ok=True)
 
-            if case["case_input"] == "dict":
-                case_input = pin_name_dict
-            elif case["case_input"] == "content":
-                case_input = pin_name_content
+    if args.jobs > 1 and len(jobs) > 1:
+        with concurrent.futures.ProcessPoolExecutor(max_workers=args.jobs) as executor:
+            outputs = list(executor.map(validate_target, *zip(*[job for _, job in jobs])))
+    else:
+        outputs = [validate_target(*job) for _, job in jobs]
 
-            case_output = case["case_function"](case_input)
+    for (target, _), (results, warnings) in zip(jobs, outputs):
+        entries[target]["results"] = results
+        for warning in warnings:
+            print("WARNING: " + target + ": " + warning, file=sys.stderr)
 
-            case_result = "FAILED" if case_output else "PASSED"
+    if args.cache:
+        save_cache(args.cache, {**cache, **entries})
 
-            platform_name = target
-            if not args.full_name and args.output_format == "prettytext":
-                if len(platform_name) > 40:
-                    platform_name = "..." + platform_name[-40:]
+    report = []
+    for target in targets:
+        platform_name = target
+        if not args.full_name and args.output_format == "prettytext":
+            if len(platform_name) > 40:
+                platform_name = "..." + platform_name[-40:]
 
-            report.append(
-                {
-                    "platform_name": platform_name,
-                    "suite_name": case["suite_name"],
-                    "case_name": case["case_name"],
-                    "result": case_result,
-                    "errors": case_output,
-                }
-            )
+        for result in entries[target]["results"]:
+            report.append({"platform_name": platform_name, **result})
 
     generate_output(report, args.output_format, args.verbose, args.output_file)
 
@@ -826,6 +953,32 @@ def parse_args():
         help="File to write output to, instead of printing to stdout",
     )
 
+    parser.add_argument(
+        "-c",
+        "--cache",
+        help=(
+            "Cache file of the results. Targets whose PinNames.h is"
+            " unchanged since the cached run are not validated again"
+        ),
+    )
+
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=os.cpu_count() or 1,
+        help="Number of targets validated in parallel",
+    )
+
+    parser.add_argument(
+        "-i",
+        "--pinmap_index_dir",
+        help=(
+            "Directory to write the sorted pinmap index of each target to,"
+            " generated from the PeripheralPins*.c files next to its PinNames.h"
+        ),
+    )
+
     group = parser.add_mutually_exclusive_group(required=True)
 
     group.add_argument(
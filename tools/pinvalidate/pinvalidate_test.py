@@ -204,3 +204,26 @@ def test_arduino_nc_assignment_check(pin_name_dict):
         {'key': 'ARDUINO_UNO_D11', 'val': 'NC', 'message': 'cannot be NC'},
     ]
     assert arduino_nc_assignment_check(pin_name_dict) == expected_errors
+
+def test_run_test_cases(pin_name_content):
+    results = run_test_cases(pin_name_content, [], False)
+    assert [result["case_name"] for result in results] == ["identity", "nc", "duplicate", "legacy", "uart"]
+    assert results[3]["result"] == "FAILED"
+    assert results[3]["errors"] == legacy_assignment_check(pin_name_content)
+
+def test_cache(tmp_path):
+    cache_file = tmp_path / "cache.json"
+    entries = {"TARGET": {"hash": content_hash("content"), "results": []}}
+    assert load_cache(cache_file) == dict()
+    save_cache(cache_file, entries)
+    assert load_cache(cache_file) == entries
+
+    # a cache written by another version of the tool is discarded
+    cache_file.write_text('{"tool": "0", "targets": {"TARGET": {}}}')
+    assert load_cache(cache_file) == dict()
+
+def test_validate_target_pinmap_index(pin_name_content, tmp_path):
+    index_file = tmp_path / "TARGET_pinmap_index.c"
+    results, warnings = validate_target(pin_name_content, ["generic"], False, [], str(index_file))
+    assert results == run_test_cases(pin_name_content, ["generic"], False)
+    assert "pinmap_index" in index_file.read_text()
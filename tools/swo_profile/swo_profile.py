@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Profile an image from the PC samples of its SWO stream.
+
+The image started PC sampling with mbed_itm_pc_sampling_start(). This reads
+the raw SWO stream captured by the debug probe, with the TPIU formatter
+bypassed, and counts the samples in each function of the ELF file, using the
+symbols listed by nm.
+"""
+
+import argparse
+import bisect
+import subprocess
+import sys
+from collections import Counter
+from enum import Enum
+
+# Discriminator of the DWT PC sample packets
+PC_SAMPLE_ID = 2
+GLOBAL_TIMESTAMPS = (0x94, 0xB4)
+SLEEP = "<sleep>"
+UNKNOWN = "<unknown>"
+FUNCTION_TYPES = "tTwW"
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def pc_samples(stream):
+    """PC of each sample of an ITM stream, None for the samples of a sleeping core."""
+    index = 0
+    while index < len(stream):
+        header = stream[index]
+        index += 1
+        size = (1, 2, 4)[(header & 0x3) - 1] if header & 0x3 else 0
+        if size:
+            payload = stream[index:index + size]
+            index += size
+            # Hardware source packets have bit 2 set, their discriminator above
+            if header & 0x4 and header >> 3 == PC_SAMPLE_ID and len(payload) == size:
+                yield int.from_bytes(payload, "little") if size == 4 else None
+        elif (header & 0xCF) == 0xC0 or (header & 0x8B) == 0x88 or header in GLOBAL_TIMESTAMPS:
+            # Timestamp and extension packets continue while bit 7 is set
+            while index < len(stream) and stream[index] & 0x80:
+                index += 1
+            index += 1
+        # Synchronization, overflow and single byte timestamp packets carry no payload
+
+
+def parse_symbols(lines):
+    """Sorted start addresses, sizes and names of the functions in nm -S output."""
+    symbols = []
+    for line in lines:
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in FUNCTION_TYPES:
+            # Thumb function addresses have bit 0 set
+            symbols.append((int(fields[0], 16) & ~1, int(fields[1], 16), fields[3].strip()))
+    return sorted(symbols)
+
+
+def read_symbols(elf, nm):
+    """Functions of an ELF file."""
+    output = subprocess.run([nm, "-S", "-C", "--defined-only", elf], check=True, stdout=subprocess.PIPE)
+    return parse_symbols(output.stdout.decode().splitlines())
+
+
+def profile(samples, symbols):
+    """Number of samples in each function."""
+    starts = [start for start, _, _ in symbols]
+    counts = Counter()
+    for pc in samples:
+        if pc is None:
+            counts[SLEEP] += 1
+            continue
+        index = bisect.bisect_right(starts, pc) - 1
+        if index >= 0 and pc < symbols[index][0] + symbols[index][1]:
+            counts[symbols[index][2]] += 1
+        else:
+            counts[UNKNOWN] += 1
+    return counts
+
+
+def print_profile(counts, limit):
+    """Print the functions with the most samples."""
+    total = sum(counts.values())
+    print("{} samples".format(total))
+    for name, count in counts.most_common(limit or None):
+        print("{:6.2f}% {:8} {}".format(100.0 * count / total, count, name))
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="SWO PC sampling profiler",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument("elf", help="ELF file of the image.")
+    parser.add_argument("swo", type=argparse.FileType("rb"), help="Raw SWO stream captured from the board.")
+    parser.add_argument("-n", "--nm", default="arm-none-eabi-nm", help="nm tool of the toolchain.")
+    parser.add_argument("-l", "--limit", default=20, type=int, help="Number of functions printed, 0 for all.")
+
+    return parser.parse_args()
+
+
+def run_swo_profile():
+    """Application main algorithm."""
+    args = parse_args()
+
+    counts = profile(pc_samples(args.swo.read()), read_symbols(args.elf, args.nm))
+    if not counts:
+        raise ValueError("no PC samples found")
+    print_profile(counts, args.limit)
+    return ReturnCode.SUCCESS.value
+
+
+def _main():
+    """Run swo_profile."""
+    try:
+        return run_swo_profile()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
@@ -0,0 +1,49 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+
+import pytest
+from swo_profile import *
+
+def test_pc_samples():
+    stream = bytes([
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x80,  # synchronization
+        0x17, 0x01, 0x10, 0x00, 0x08,        # PC sample
+        0x09, 0x41,                          # ITM port 1, one byte
+        0x15, 0x00,                          # sleep sample
+        0xC0, 0x81, 0x01,                    # timestamp
+        0x70,                                # overflow
+        0x47, 0x00, 0x00, 0x00, 0x00,        # DWT data trace, not a sample
+        0x17, 0x04, 0x20,                    # truncated PC sample
+    ])
+
+    assert list(pc_samples(stream)) == [0x08001001, None]
+
+def test_parse_symbols():
+    lines = [
+        "08001001 00000010 T main\n",
+        "08000201 00000008 t helper(int)\n",
+        "20000000 00000004 B counter\n",
+        "08000000 U undefined\n",
+    ]
+
+    assert parse_symbols(lines) == [(0x08000200, 8, "helper(int)"), (0x08001000, 0x10, "main")]
+
+def test_profile():
+    symbols = [(0x08000200, 8, "helper"), (0x08001000, 0x10, "main")]
+    samples = [0x08001000, 0x0800100E, 0x08000204, None, 0x08000208, 0x08000100]
+
+    assert profile(samples, symbols) == {"main": 2, "helper": 1, SLEEP: 1, UNKNOWN: 2}
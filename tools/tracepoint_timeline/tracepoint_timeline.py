@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Convert the HAL tracepoint records of an image to a timeline.
+
+The records are printed on the console by hal_tracepoint_dump(), or streamed
+over an ITM stimulus port with MBED_CONF_TARGET_TRACEPOINTS_ITM_PORT. This
+reads them from a log of the console or from a raw SWO capture, and writes a
+JSON trace for the Chrome trace viewer (chrome://tracing) or Perfetto
+(ui.perfetto.dev).
+"""
+
+import argparse
+import json
+import struct
+import sys
+from enum import Enum
+
+TRACEPOINT_PREFIX = "#tracepoint "
+TRACEPOINT_BEGIN = "#tracepoint begin "
+TRACEPOINT_END = "#tracepoint end"
+
+# Layout of hal_tracepoint_record_t
+RECORD = struct.Struct("<IHHII")
+
+# Events of hal_tracepoint_id_t: name, then the phase of the trace event, a
+# slice beginning or ending on the track of the driver, or an instant
+EVENTS = {
+    1: ("ticker insert", "i"),
+    2: ("ticker dispatch", "i"),
+    3: ("sleep", "B"),
+    4: ("sleep", "E"),
+    5: ("spi", "B"),
+    6: ("spi", "E"),
+    7: ("i2c", "B"),
+    8: ("i2c", "E"),
+    9: ("serial tx", "B"),
+    10: ("serial tx", "E"),
+    11: ("serial rx", "B"),
+    12: ("serial rx", "E"),
+    13: ("flash program", "B"),
+    14: ("flash program", "E"),
+    15: ("flash erase", "B"),
+    16: ("flash erase", "E"),
+}
+USER_EVENT = 0x8000
+# Slices whose first argument is the driver object, with a track per object
+OBJECT_EVENTS = ("spi", "i2c", "serial tx", "serial rx")
+
+
+class ReturnCode(Enum):
+    """Return codes."""
+
+    SUCCESS = 0
+    ERROR = 1
+    INVALID_OPTIONS = 2
+
+
+class ArgumentParserWithDefaultHelp(argparse.ArgumentParser):
+    """Subclass that always shows the help message on invalid arguments."""
+
+    def error(self, message):
+        """Error handler."""
+        sys.stderr.write("error: {}\n".format(message))
+        self.print_help()
+        raise SystemExit(ReturnCode.INVALID_OPTIONS.value)
+
+
+def parse_records(data):
+    """Records of the bytes of consecutive hal_tracepoint_record_t, a partial last one is dropped."""
+    count = len(data) // RECORD.size
+    return [RECORD.unpack_from(data, i * RECORD.size) for i in range(count)]
+
+
+def parse_dump(lines):
+    """Frequency and records of the first complete dump in console lines."""
+    frequency = None
+    data = bytearray()
+    for line in lines:
+        line = line.strip()
+        if line.startswith(TRACEPOINT_BEGIN):
+            frequency = int(line[len(TRACEPOINT_BEGIN):])
+            data = bytearray()
+        elif frequency is None:
+            continue
+        elif line == TRACEPOINT_END:
+            return frequency, parse_records(data)
+        elif line.startswith(TRACEPOINT_PREFIX):
+            data += bytes.fromhex(line[len(TRACEPOINT_PREFIX):])
+    raise ValueError("no complete tracepoint dump found")
+
+
+def itm_port_data(stream, port):
+    """Payload sent on an ITM stimulus port in a raw SWO capture."""
+    data = bytearray()
+    index = 0
+    while index < len(stream):
+        header = stream[index]
+        index += 1
+        if header & 0x3:
+            size = (1, 2, 4)[(header & 0x3) - 1]
+            # Instrumentation packets have bit 2 clear, the port above
+            if not header & 0x4 and header >> 3 == port:
+                data += stream[index:index + size]
+            index += size
+        elif (header & 0xCF) == 0xC0 or (header & 0x8B) == 0x88 or header in (0x94, 0xB4):
+            # Timestamp and extension packets continue while bit 7 is set
+            while index < len(stream) and stream[index] & 0x80:
+                index += 1
+            index += 1
+    return bytes(data)
+
+
+def context_name(context):
+    """Track of the events recorded by an exception number."""
+    if context == 0:
+        return "thread"
+    if context >= 16:
+        return "IRQ {}".format(context - 16)
+    return "exception {}".format(context)
+
+
+def timeline(records, frequency):
+    """Chrome trace events of the records."""
+    events = []
+    high = 0
+    previous = None
+    for timestamp, event, context, arg0, arg1 in records:
+        # The 32-bit timestamps of the records in time order roll over
+        if previous is not None and timestamp < previous:
+            high += 1 << 32
+        previous = timestamp
+        if event >= USER_EVENT:
+            name, phase = "user {}".format(event - USER_EVENT), "i"
+        else:
+            name, phase = EVENTS.get(event, ("event {}".format(event), "i"))
+        if phase == "i":
+            track = context_name(context)
+        elif name in OBJECT_EVENTS:
+            track = "{} 0x{:08x}".format(name, arg0)
+        elif name.startswith("flash"):
+            track = "flash"
+        else:
+            # Sleeps and deep sleeps on one track
+            track = name
+            if arg0:
+                name = "deep sleep"
+        trace_event = {
+            "name": name,
+            "ph": phase,
+            "ts": (high + timestamp) * 1e6 / frequency,
+            "pid": 0,
+            "tid": track,
+            "args": {"arg0": "0x{:08x}".format(arg0), "arg1": "0x{:08x}".format(arg1), "context": context_name(context)},
+        }
+        if phase == "i":
+            trace_event["s"] = "t"
+        events.append(trace_event)
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def parse_args():
+    """Parse the command line args."""
+    parser = ArgumentParserWithDefaultHelp(
+        description="HAL tracepoint timeline converter",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("-l", "--log", type=argparse.FileType("r"), help="Log of the board console.")
+    source.add_argument("-s", "--swo", type=argparse.FileType("rb"), help="Raw SWO capture of the ITM stream.")
+    parser.add_argument("-p", "--port", default=5, type=int, help="ITM stimulus port of the records in the SWO capture.")
+    parser.add_argument("-f", "--frequency", type=int, help="Frequency of the timestamps in the SWO capture, in Hz.")
+    parser.add_argument("-o", "--output", default="timeline.json", help="JSON trace written.")
+
+    args = parser.parse_args()
+    if args.swo and not args.frequency:
+        parser.error("--frequency is required with --swo")
+    return args
+
+
+def run_tracepoint_timeline():
+    """Application main algorithm."""
+    args = parse_args()
+
+    if args.log:
+        frequency, records = parse_dump(args.log)
+    else:
+        frequency, records = args.frequency, parse_records(itm_port_data(args.swo.read(), args.port))
+    with open(args.output, "w") as output:
+        json.dump(timeline(records, frequency), output)
+    print("written: {}, {} records".format(args.output, len(records)))
+    return ReturnCode.SUCCESS.value
+
+
+def _main():
+    """Run tracepoint_timeline."""
+    try:
+        return run_tracepoint_timeline()
+    except Exception as error:
+        print(error)
+        return ReturnCode.ERROR.value
+
+
+if __name__ == "__main__":
+    sys.exit(_main())
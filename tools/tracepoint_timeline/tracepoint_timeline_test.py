@@ -0,0 +1,71 @@
+"""
+Copyright (c) 2021 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+
+import pytest
+from tracepoint_timeline import *
+
+def record(timestamp, event, context, arg0=0, arg1=0):
+    return RECORD.pack(timestamp, event, context, arg0, arg1)
+
+def test_parse_dump():
+    lines = [
+        "{{__sync;0}}\n",
+        "#tracepoint begin 1000000\n",
+        "#tracepoint " + record(10, 5, 0, 0x20000000, 0x00040004).hex() + "\n",
+        "some trace\n",
+        "#tracepoint " + record(20, 6, 31, 0x20000000, 1).hex() + "\n",
+        "#tracepoint end\n",
+    ]
+
+    assert parse_dump(lines) == (1000000, [(10, 5, 0, 0x20000000, 0x00040004), (20, 6, 31, 0x20000000, 1)])
+
+def test_parse_dump_incomplete():
+    with pytest.raises(ValueError):
+        parse_dump(["#tracepoint begin 1000\n", "#tracepoint " + record(1, 1, 0).hex() + "\n"])
+
+def test_itm_port_data():
+    data = record(1, 3, 0, 1)
+    stream = bytearray([0x00, 0x00, 0x00, 0x00, 0x00, 0x80])
+    for i in range(0, len(data), 4):
+        stream += bytes([0x2B]) + data[i:i + 4]  # port 5, words
+        stream += bytes([0x09, 0x41])            # port 1, other output
+    stream += bytes([0x17, 0x00, 0x10, 0x00, 0x08])  # PC sample
+
+    assert parse_records(itm_port_data(bytes(stream), 5)) == [(1, 3, 0, 1, 0)]
+
+def test_timeline():
+    records = [
+        (0xFFFFFF00, 3, 0, 1, 0),
+        (0x00000100, 4, 0, 1, 0),
+        (0x00000200, 5, 0, 0x20000000, 0),
+        (0x00000300, 2, 17, 7, 3),
+        (0x00000400, 6, 51, 0x20000000, 1),
+        (0x00000500, USER_EVENT + 2, 0, 0, 0),
+    ]
+
+    events = timeline(records, 1000000)["traceEvents"]
+
+    assert [(e["name"], e["ph"], e["tid"]) for e in events] == [
+        ("deep sleep", "B", "sleep"),
+        ("deep sleep", "E", "sleep"),
+        ("spi", "B", "spi 0x20000000"),
+        ("ticker dispatch", "i", "IRQ 1"),
+        ("spi", "E", "spi 0x20000000"),
+        ("user 2", "i", "thread"),
+    ]
+    # The timestamps roll over between the first two records
+    assert events[1]["ts"] - events[0]["ts"] == 0x200
@@ -508,6 +508,76 @@ void UnityAssertEqualNumber(const _U_SINT expected,
     UnityAddMsgIfSpecified(msg);           \
     UNITY_FAIL_AND_BAIL; }
 
+/* Pointer sized words, read from buffers of any type */
+#if defined(__GNUC__)
+typedef _UP __attribute__((__may_alias__)) UnityWord;
+#else
+typedef _UP UnityWord;
+#endif
+
+/* Compare two buffers word by word when they are aligned alike, so the
+ * assertions only go through their element by element path on a mismatch,
+ * to report it. */
+static int UnityMemoryMatches(UNITY_INTERNAL_PTR expected, UNITY_INTERNAL_PTR actual, _UU32 bytes);
+static int UnityMemoryMatches(UNITY_INTERNAL_PTR expected, UNITY_INTERNAL_PTR actual, _UU32 bytes)
+{
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_exp = (UNITY_PTR_ATTRIBUTE const unsigned char*)expected;
+    UNITY_PTR_ATTRIBUTE const unsigned char* ptr_act = (UNITY_PTR_ATTRIBUTE const unsigned char*)actual;
+
+    if ((((_UP)ptr_exp ^ (_UP)ptr_act) & (sizeof(UnityWord) - 1)) == 0)
+    {
+        while ((bytes > 0) && (((_UP)ptr_exp & (sizeof(UnityWord) - 1)) != 0))
+        {
+            if (*ptr_exp++ != *ptr_act++)
+                return 0;
+            bytes--;
+        }
+        while (bytes >= 4 * sizeof(UnityWord))
+        {
+            UNITY_PTR_ATTRIBUTE const UnityWord* word_exp = (UNITY_PTR_ATTRIBUTE const UnityWord*)ptr_exp;
+            UNITY_PTR_ATTRIBUTE const UnityWord* word_act = (UNITY_PTR_ATTRIBUTE const UnityWord*)ptr_act;
+            if (((word_exp[0] ^ word_act[0]) | (word_exp[1] ^ word_act[1]) |
+                 (word_exp[2] ^ word_act[2]) | (word_exp[3] ^ word_act[3])) != 0)
+                return 0;
+            ptr_exp += 4 * sizeof(UnityWord);
+            ptr_act += 4 * sizeof(UnityWord);
+            bytes -= 4 * sizeof(UnityWord);
+        }
+    }
+    while (bytes > 0)
+    {
+        if (*ptr_exp++ != *ptr_act++)
+            return 0;
+        bytes--;
+    }
+    return 1;
+}
+
+/* Size of the elements of an integer array assertion */
+static _UU32 UnityIntArrayElementSize(const UNITY_DISPLAY_STYLE_T style);
+static _UU32 UnityIntArrayElementSize(const UNITY_DISPLAY_STYLE_T style)
+{
+    switch(style & (UNITY_DISPLAY_STYLE_T)(~UNITY_DISPLAY_RANGE_AUTO))
+    {
+        case UNITY_DISPLAY_STYLE_HEX8:
+        case UNITY_DISPLAY_STYLE_INT8:
+        case UNITY_DISPLAY_STYLE_UINT8:
+            return 1;
+        case UNITY_DISPLAY_STYLE_HEX16:
+        case UNITY_DISPLAY_STYLE_INT16:
+        case UNITY_DISPLAY_STYLE_UINT16:
+            return 2;
+#ifdef UNITY_SUPPORT_64
+        case UNITY_DISPLAY_STYLE_HEX64:
+        case UNITY_DISPLAY_STYLE_INT64:
+        case UNITY_DISPLAY_STYLE_UINT64:
+            return 8;
+#endif
+        default:
+            return 4;
+    }
+}
+
 /*-----------------------------------------------*/
 void UnityAssertEqualIntArray(UNITY_INTERNAL_PTR expected,
                               UNITY_INTERNAL_PTR actual,
@@ -530,6 +600,10 @@ void UnityAssertEqualIntArray(UNITY_INTERNAL_PTR expected,
     if (UnityCheckArraysForNull((UNITY_INTERNAL_PTR)expected, (UNITY_INTERNAL_PTR)actual, lineNumber, msg) == 1)
         return;
 
+    if ((elements <= (_UU32)-1 / 8) &&
+        UnityMemoryMatches(ptr_exp, ptr_act, elements * UnityIntArrayElementSize(style)))
+        return;
+
     /* If style is UNITY_DISPLAY_STYLE_INT, we'll fall into the default case rather than the INT16 or INT32 (etc) case
      * as UNITY_DISPLAY_STYLE_INT includes a flag for UNITY_DISPLAY_RANGE_AUTO, which the width-specific
      * variants do not. Therefore remove this flag. */
@@ -1145,6 +1219,10 @@ void UnityAssertEqualMemory( UNITY_INTERNAL_PTR expected,
     if (UnityCheckArraysForNull((UNITY_INTERNAL_PTR)expected, (UNITY_INTERNAL_PTR)actual, lineNumber, msg) == 1)
         return;
 
+    if ((elements <= (_UU32)-1 / length) &&
+        UnityMemoryMatches(expected, actual, elements * length))
+        return;
+
     while (elements--)
     {
         /* /////////////////////////////////// */
@@ -22,8 +22,50 @@
 #include "utest/utest_stack_trace.h"
 #include "utest/utest_print.h"
 
+#include "mbed_stack_stats.h"
+
+#if UTEST_CASE_TIMING
+#include "hal/cycle_counter_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
 using namespace utest::v1;
 
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+#define TEST_ENV_TESTCASE_STACK "__testcase_stack"
+#endif
+
+#if UTEST_CASE_TIMING && DEVICE_USTICKER
+#define TEST_ENV_TESTCASE_TIME "__testcase_time"
+
+// Taken after the start of the case is sent, so the timing only covers the case
+static us_timestamp_t case_start_us;
+#if DEVICE_CYCLE_COUNTER
+static uint32_t case_start_cycles;
+#endif
+
+static void case_timing_start()
+{
+#if DEVICE_CYCLE_COUNTER
+    hal_cycle_counter_init();
+    case_start_cycles = hal_cycle_counter_read();
+#endif
+    case_start_us = ticker_read_us(get_us_ticker_data());
+}
+
+static void case_timing_send(const Case *const source)
+{
+    const us_timestamp_t elapsed_us = ticker_read_us(get_us_ticker_data()) - case_start_us;
+#if DEVICE_CYCLE_COUNTER
+    // The cycles roll over every 2^32, the host reads them as unsigned
+    const uint32_t elapsed_cycles = hal_cycle_counter_read() - case_start_cycles;
+    greentea_send_kv(TEST_ENV_TESTCASE_TIME, source->get_description(), (int)elapsed_us, (int)elapsed_cycles);
+#else
+    greentea_send_kv(TEST_ENV_TESTCASE_TIME, source->get_description(), (int)elapsed_us);
+#endif
+}
+#endif
+
 static void selftest_failure_handler(const failure_t);
 static void test_failure_handler(const failure_t);
 
@@ -123,12 +165,24 @@ utest::v1::status_t utest::v1::greentea_case_setup_handler(const Case *const sou
     UTEST_LOG_FUNCTION();
     utest::v1::status_t status = verbose_case_setup_handler(source, index_of_case);
     greentea_send_kv(TEST_ENV_TESTCASE_START, source->get_description());
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+    mbed_stack_paint();
+#endif
+#if UTEST_CASE_TIMING && DEVICE_USTICKER
+    case_timing_start();
+#endif
     return status;
 }
 
 utest::v1::status_t utest::v1::greentea_case_teardown_handler(const Case *const source, const size_t passed, const size_t failed, const failure_t failure)
 {
     UTEST_LOG_FUNCTION();
+#if UTEST_CASE_TIMING && DEVICE_USTICKER
+    case_timing_send(source);
+#endif
+#if MBED_CONF_PLATFORM_STACK_STATS_ENABLED
+    greentea_send_kv(TEST_ENV_TESTCASE_STACK, source->get_description(), (int)mbed_stack_high_water());
+#endif
     greentea_send_kv(TEST_ENV_TESTCASE_FINISH, source->get_description(), passed, failed);
     return verbose_case_teardown_handler(source, passed, failed, failure);
 }
@@ -18,6 +18,144 @@
 
 #include "utest/utest_shim.h"
 #include "utest/utest_stack_trace.h"
+#include "hal/sleep_api.h"
+#include "hal/us_ticker_api.h"
+#include "hal/utils/critical_section_api.h"
+
+#include <string.h>
+
+#if DEVICE_USTICKER
+
+/* Callbacks which can be pending at once. The harness posts the timeout of
+ * the current case and the callback which ends it. */
+#ifndef UTEST_SHIM_SCHEDULER_CALLBACKS
+#define UTEST_SHIM_SCHEDULER_CALLBACKS 4
+#endif
+
+typedef struct {
+    ticker_event_t event;
+    volatile utest_v1_harness_callback_t callback;
+    volatile uint32_t ready;        // order the callback became due in, 0 if not due
+    uint32_t generation;            // distinguishes the posts which used this slot
+} utest_ticker_slot_t;
+
+static utest_ticker_slot_t ticker_slots[UTEST_SHIM_SCHEDULER_CALLBACKS];
+static uint32_t ticker_ready_count;
+
+static void ticker_slot_ready(utest_ticker_slot_t *slot)
+{
+    // Never 0, which marks a callback not due yet
+    ticker_ready_count = ticker_ready_count + 1 ? ticker_ready_count + 1 : 1;
+    slot->ready = ticker_ready_count;
+}
+
+static void utest_ticker_handler(uint32_t id)
+{
+    if (id < UTEST_SHIM_SCHEDULER_CALLBACKS && ticker_slots[id].callback) {
+        ticker_slot_ready(&ticker_slots[id]);
+    }
+}
+
+static int32_t utest_ticker_init(void)
+{
+    UTEST_LOG_FUNCTION();
+    memset(ticker_slots, 0, sizeof(ticker_slots));
+    ticker_ready_count = 0;
+    ticker_set_handler(get_us_ticker_data(), utest_ticker_handler);
+    return 0;
+}
+
+/* May be called from an interrupt handler, by Harness::validate_callback. */
+static void *utest_ticker_post(const utest_v1_harness_callback_t callback, timestamp_t delay_ms)
+{
+    UTEST_LOG_FUNCTION();
+    void *handle = NULL;
+
+    UTEST_ENTER_CRITICAL_SECTION;
+    for (uint32_t i = 0; i < UTEST_SHIM_SCHEDULER_CALLBACKS; i++) {
+        utest_ticker_slot_t *slot = &ticker_slots[i];
+        if (slot->callback) {
+            continue;
+        }
+
+        slot->callback = callback;
+        slot->ready = 0;
+        slot->generation++;
+        if (delay_ms) {
+            const ticker_data_t *const ticker = get_us_ticker_data();
+            // A test may have set its own handler on the us ticker
+            ticker_set_handler(ticker, utest_ticker_handler);
+            ticker_insert_event_us(ticker, &slot->event, ticker_read_us(ticker) + delay_ms * 1000ULL, i);
+        } else {
+            ticker_slot_ready(slot);
+        }
+        handle = (void *)(uintptr_t)(slot->generation * UTEST_SHIM_SCHEDULER_CALLBACKS + i + 1);
+        break;
+    }
+    UTEST_LEAVE_CRITICAL_SECTION;
+
+    return handle;
+}
+
+static int32_t utest_ticker_cancel(void *handle)
+{
+    UTEST_LOG_FUNCTION();
+    const uint32_t value = (uint32_t)(uintptr_t)handle - 1;
+    const uint32_t index = value % UTEST_SHIM_SCHEDULER_CALLBACKS;
+    int32_t status = -1;
+
+    if (handle == NULL) {
+        return status;
+    }
+
+    UTEST_ENTER_CRITICAL_SECTION;
+    utest_ticker_slot_t *slot = &ticker_slots[index];
+    // The callback may already have run, and its slot used by a later post
+    if (slot->callback && slot->generation == value / UTEST_SHIM_SCHEDULER_CALLBACKS) {
+        ticker_remove_event(get_us_ticker_data(), &slot->event);
+        slot->callback = NULL;
+        slot->ready = 0;
+        status = 0;
+    }
+    UTEST_LEAVE_CRITICAL_SECTION;
+
+    return status;
+}
+
+static int32_t utest_ticker_run(void)
+{
+    UTEST_LOG_FUNCTION();
+    while (1) {
+        utest_v1_harness_callback_t callback = NULL;
+
+        UTEST_ENTER_CRITICAL_SECTION;
+        utest_ticker_slot_t *next = NULL;
+        for (uint32_t i = 0; i < UTEST_SHIM_SCHEDULER_CALLBACKS; i++) {
+            utest_ticker_slot_t *slot = &ticker_slots[i];
+            // Oldest first, comparing the difference to handle the wrap around
+            if (slot->ready && (!next || (int32_t)(slot->ready - next->ready) < 0)) {
+                next = slot;
+            }
+        }
+        if (next) {
+            callback = next->callback;
+            next->callback = NULL;
+            next->ready = 0;
+        } else {
+#if DEVICE_SLEEP
+            hal_critical_section_sleep(hal_sleep);
+#endif
+        }
+        UTEST_LEAVE_CRITICAL_SECTION;
+
+        if (callback) {
+            callback();
+        }
+    }
+    return 0;
+}
+
+#else // DEVICE_USTICKER
 
 // only one callback is active at any given time
 static volatile utest_v1_harness_callback_t minimal_callback;
@@ -67,8 +205,19 @@ static int32_t utest_minimal_run(void)
     return 0;
 }
 
+#endif // DEVICE_USTICKER
+
 extern "C" {
 
+#if DEVICE_USTICKER
+static const utest_v1_scheduler_t utest_ticker_scheduler =
+{
+    utest_ticker_init,
+    utest_ticker_post,
+    utest_ticker_cancel,
+    utest_ticker_run
+};
+#else
 static const utest_v1_scheduler_t utest_minimal_scheduler =
 {
     utest_minimal_init,
@@ -76,11 +225,16 @@ static const utest_v1_scheduler_t utest_minimal_scheduler =
     utest_minimal_cancel,
     utest_minimal_run
 };
+#endif
 
 utest_v1_scheduler_t utest_v1_get_scheduler()
 {
     UTEST_LOG_FUNCTION();
+#if DEVICE_USTICKER
+    return utest_ticker_scheduler;
+#else
     return utest_minimal_scheduler;
+#endif
 }
 
 }